@@ -99,6 +99,9 @@ const std::string CONTINUE_SESSION_FLAG = "dataContinue";
 const std::string TIME_STAMP_US = "timeStampUs";
 const std::string FRAME_TYPE = "frameType";
 const std::string INDEX = "index";
+const std::string TEMPORAL_LAYER = "temporalLayer";
+const std::string ENCODE_WIDTH = "encodeWidth";
+const std::string ENCODE_HEIGHT = "encodeHeight";
 const std::string START_ENCODE_TIME_US = "startEncodeT";
 const std::string FINISH_ENCODE_TIME_US = "finishEncodeT";
 const std::string SEND_TIME_US = "sendT";
@@ -124,6 +127,7 @@ const std::string CAMERA_SURFACE_FORMAT = "CAMERA_SURFACE_FORMAT";
 const std::string HDF_DCAMERA_EXT_SERVICE = "distributed_camera_provider_service";
 const std::string CAMERA_SUPPORT_MODE = "Mode";
 constexpr static int8_t FRAME_HEAD = 0;
+constexpr static int32_t TEMPORAL_BASE_LAYER = 0;
 
 const int32_t VALID_OS_TYPE = 10;
 const int32_t INVALID_OS_TYPE = -1;
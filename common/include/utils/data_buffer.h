@@ -16,6 +16,7 @@
 #ifndef OHOS_DATA_BUFFER_H
 #define OHOS_DATA_BUFFER_H
 
+#include <functional>
 #include <map>
 #include <string>
 #include <cstddef>
@@ -28,12 +29,15 @@ namespace DistributedHardware {
 class DataBuffer : public IFeedableData {
 public:
     explicit DataBuffer(size_t capacity);
+    /* Borrow external memory without copying; releaser is invoked once the buffer is destroyed. */
+    DataBuffer(uint8_t *data, size_t size, std::function<void()> releaser);
 
     size_t Size() const;
     size_t Offset() const;
     size_t Capacity() const;
     uint8_t *Data() const;
     int32_t SetRange(size_t offset, size_t size);
+    bool IsBorrowed() const;
 
     void SetInt32(const std::string name, int32_t value);
     void SetInt64(const std::string name, int64_t value);
@@ -50,6 +54,7 @@ private:
     size_t rangeOffset_ = 0;
     size_t rangeLength_ = 0;
     uint8_t *data_ = nullptr;
+    std::function<void()> releaser_ = nullptr;
 
     std::map<std::string, int32_t> int32Map_;
     std::map<std::string, int64_t> int64Map_;
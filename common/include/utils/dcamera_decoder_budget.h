@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_DECODER_BUDGET_H
+#define OHOS_DCAMERA_DECODER_BUDGET_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+const std::string DCAMERA_DECODER_BACKEND_PARA = "persist.dcamera.decoder.backend";
+const std::string DCAMERA_DECODER_HW_MAX_PARA = "persist.dcamera.decoder.hw.max";
+const std::string DCAMERA_DECODER_SW_CORES_PARA = "persist.dcamera.decoder.sw.cores";
+const std::string DCAMERA_DECODER_SW_THREADS_PARA = "persist.dcamera.decoder.sw.threads";
+const std::string DCAMERA_DECODER_SW_THREADING_PARA = "persist.dcamera.decoder.sw.threading";
+
+typedef enum {
+    DCAMERA_DECODER_AUTO = 0,
+    DCAMERA_DECODER_HARDWARE = 1,
+    DCAMERA_DECODER_SOFTWARE = 2,
+} DCameraDecoderBackend;
+
+/*
+ * AUTO tries the platform decoder first and falls back to software when it can not be created or
+ * hardwareMax decoders are already running, a zero hardwareMax leaves the platform limit as the only one.
+ * Software streams are admitted while their estimated decode time fits softwareCores.
+ */
+struct DCameraDecoderConfig {
+    DCameraDecoderBackend backend = DCAMERA_DECODER_AUTO;
+    int32_t hardwareMax = 0;
+    int32_t softwareCores = 2;
+    int32_t softwareThreads = 2;
+    bool frameThreading = false;
+};
+
+class DCameraDecoderBudget {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraDecoderBudget);
+
+public:
+    DCameraDecoderConfig GetConfig();
+    void SetConfig(const DCameraDecoderConfig& config);
+    bool AcquireHardware();
+    void ReleaseHardware();
+    // Returns the reserved load in core microseconds per second, or -1 when the stream does not fit
+    int64_t AcquireSoftware(const std::string& mime, int32_t width, int32_t height, int32_t fps);
+    void ReleaseSoftware(int64_t load);
+    // One decoded frame, busyUs is the wall time of the decode call times the threads it may have used
+    void AddSoftwareSample(const std::string& mime, int32_t width, int32_t height, int64_t wallUs, int64_t busyUs);
+    int64_t GetSoftwareFrameCost(const std::string& mime, int32_t width, int32_t height);
+    void Dump(std::string& result);
+
+private:
+    struct ThroughputStats {
+        std::string mime;
+        int32_t width = 0;
+        int32_t height = 0;
+        int64_t frames = 0;
+        int64_t wallUs = 0;
+        int64_t busyUs = 0;
+    };
+
+    explicit DCameraDecoderBudget();
+    ~DCameraDecoderBudget() = default;
+    int64_t GetFrameCostLocked(const std::string& mime, int32_t width, int32_t height);
+    static std::string GetStatsKey(const std::string& mime, int32_t width, int32_t height);
+
+    static constexpr int64_t US_PER_SECOND = 1000000;
+    // Frames a resolution needs before its measured cost replaces the model
+    static constexpr int64_t MIN_SAMPLE_FRAMES = 30;
+    static constexpr int32_t DEFAULT_FPS = 30;
+
+    std::mutex mutex_;
+    DCameraDecoderConfig config_;
+    int32_t hardwareCount_ = 0;
+    int32_t softwareCount_ = 0;
+    int64_t softwareLoad_ = 0;
+    std::map<std::string, ThroughputStats> stats_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_DECODER_BUDGET_H
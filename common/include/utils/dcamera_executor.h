@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_EXECUTOR_H
+#define OHOS_DCAMERA_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+const std::string DCAMERA_EXECUTOR_THREADS_PARA = "persist.dcamera.executor.threads";
+
+/*
+ * Serial task queue on top of the shared executor. Tasks of one strand run one at a time in post
+ * order, possibly on different workers, while different strands run in parallel.
+ * A dedicated strand runs on a thread of its own instead, for tasks that block on the network and
+ * would hold a shared worker away from every other camera. It has to be stopped to end that thread.
+ */
+class DCameraStrand : public std::enable_shared_from_this<DCameraStrand> {
+public:
+    DCameraStrand(const std::string& name, bool isDedicated);
+    ~DCameraStrand();
+
+    int32_t Post(std::function<void()> task);
+    // Drops the pending tasks, the running one is left alone
+    void Clear();
+    // Drops the pending tasks, refuses new ones and waits for the running task unless called from it
+    void Stop();
+    bool IsIdle();
+    const std::string& GetName() const;
+
+private:
+    friend class DCameraExecutor;
+    void RunOne();
+    void StartThread();
+    void ThreadLoop();
+
+    std::string name_;
+    bool isDedicated_ = false;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> tasks_;
+    // Set while the strand sits in the ready queue or runs on a worker, it is never there twice
+    bool scheduled_ = false;
+    bool running_ = false;
+    bool stopped_ = false;
+    std::thread::id runningThread_;
+};
+
+class DCameraExecutor {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraExecutor);
+
+public:
+    std::shared_ptr<DCameraStrand> CreateStrand(const std::string& name, bool isDedicated = false);
+    size_t GetThreadNum();
+
+private:
+    friend class DCameraStrand;
+
+    explicit DCameraExecutor();
+    ~DCameraExecutor();
+    void Schedule(const std::shared_ptr<DCameraStrand>& strand);
+    void WorkerLoop();
+
+    static constexpr int32_t MIN_THREAD_NUM = 4;
+    static constexpr int32_t MAX_THREAD_NUM = 16;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::shared_ptr<DCameraStrand>> readyStrands_;
+    std::vector<std::thread> workers_;
+    bool isRunning_ = true;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_EXECUTOR_H
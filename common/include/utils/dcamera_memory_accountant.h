@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_MEMORY_ACCOUNTANT_H
+#define OHOS_DCAMERA_MEMORY_ACCOUNTANT_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+const std::string DCAMERA_MEMORY_BUDGET_PARA = "persist.dcamera.memory.budget.mb";
+
+/*
+ * Bytes currently held by one frame queue. Updates are relaxed atomics and also move the process
+ * wide total, whatever is still held when the queue goes away is given back by the destructor.
+ */
+class DCameraQueueMemory {
+public:
+    DCameraQueueMemory(const std::string& owner, const std::string& queueName);
+    ~DCameraQueueMemory();
+
+    void Add(size_t bytes);
+    void Sub(size_t bytes);
+    void Clear();
+    // A queue may always hold MIN_QUEUE_DEPTH frames, past that only while the budget has room
+    bool CanQueue(size_t depth, size_t frameBytes, size_t maxDepth);
+
+    static constexpr size_t MIN_QUEUE_DEPTH = 2;
+
+private:
+    friend class DCameraMemoryAccountant;
+
+    std::string owner_;
+    std::string queueName_;
+    std::atomic<int64_t> bytes_ { 0 };
+    std::atomic<int64_t> peak_ { 0 };
+};
+
+class DCameraMemoryAccountant {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraMemoryAccountant);
+
+public:
+    // Reserves the fixed buffers of an owner, fails when they do not fit next to the other reservations
+    int32_t Reserve(const std::string& owner, int64_t bytes);
+    void Unreserve(const std::string& owner);
+    std::shared_ptr<DCameraQueueMemory> RegisterQueue(const std::string& owner, const std::string& queueName);
+    void SetBudget(int64_t bytes);
+    int64_t GetBudget();
+    int64_t GetUsedBytes();
+    int64_t GetPeakBytes();
+    void Dump(std::string& result);
+
+    static int64_t GetFrameBytes(int32_t width, int32_t height);
+
+private:
+    friend class DCameraQueueMemory;
+
+    explicit DCameraMemoryAccountant();
+    ~DCameraMemoryAccountant() = default;
+    void AddQueued(int64_t bytes);
+    void UpdatePeak();
+
+    static constexpr int64_t DEFAULT_BUDGET_MB = 256;
+    static constexpr int64_t BYTES_PER_MB = 1024 * 1024;
+
+    std::atomic<int64_t> budget_ { DEFAULT_BUDGET_MB * BYTES_PER_MB };
+    std::atomic<int64_t> reservedBytes_ { 0 };
+    std::atomic<int64_t> queuedBytes_ { 0 };
+    std::atomic<int64_t> peakBytes_ { 0 };
+
+    std::mutex mutex_;
+    std::map<std::string, int64_t> reservations_;
+    std::map<std::string, int64_t> reservationPeaks_;
+    std::vector<std::weak_ptr<DCameraQueueMemory>> queues_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_MEMORY_ACCOUNTANT_H
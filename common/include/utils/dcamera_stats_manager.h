@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_STATS_MANAGER_H
+#define OHOS_DCAMERA_STATS_MANAGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+typedef enum {
+    DCAMERA_DROP_BUSY = 0,
+    DCAMERA_DROP_FPS_CONTROL = 1,
+    DCAMERA_DROP_EXPIRED = 2,
+    DCAMERA_DROP_SMOOTHER = 3,
+    DCAMERA_DROP_REASON_MAX = 4,
+} DCameraDropReason;
+
+/*
+ * Counters of one pipeline node of one stream. Every update is a relaxed atomic so the frame path
+ * never takes a lock, the queue names are fixed at construction.
+ */
+class DCameraNodeStats {
+public:
+    DCameraNodeStats(const std::string& streamName, const std::string& nodeName,
+        const std::vector<std::string>& queueNames);
+
+    void AddInput(size_t bytes);
+    void AddOutput(size_t bytes);
+    void AddDrop(DCameraDropReason reason, uint64_t num = 1);
+    void SetQueueDepth(size_t queueIndex, size_t depth);
+    void SetInFlight(int32_t num);
+
+private:
+    friend class DCameraStatsManager;
+
+    struct QueueStats {
+        std::string name;
+        std::atomic<uint64_t> depth { 0 };
+        std::atomic<uint64_t> peak { 0 };
+    };
+    // Last values seen by the dumper, rates are computed against them
+    struct Snapshot {
+        int64_t timeUs = 0;
+        uint64_t inFrames = 0;
+        uint64_t outFrames = 0;
+        uint64_t inBytes = 0;
+    };
+
+    std::string streamName_;
+    std::string nodeName_;
+    std::vector<std::unique_ptr<QueueStats>> queues_;
+    std::atomic<uint64_t> inFrames_ { 0 };
+    std::atomic<uint64_t> inBytes_ { 0 };
+    std::atomic<uint64_t> outFrames_ { 0 };
+    std::atomic<uint64_t> outBytes_ { 0 };
+    std::atomic<int32_t> inFlight_ { 0 };
+    std::atomic<uint64_t> drops_[DCAMERA_DROP_REASON_MAX];
+    Snapshot snapshot_;
+};
+
+class DCameraStatsManager {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraStatsManager);
+
+public:
+    std::shared_ptr<DCameraNodeStats> Register(const std::string& streamName, const std::string& nodeName,
+        const std::vector<std::string>& queueNames = {});
+    void Dump(std::string& result);
+    int32_t StartWatch();
+    int32_t StopWatch();
+
+private:
+    explicit DCameraStatsManager() = default;
+    ~DCameraStatsManager();
+    void WatchLoop();
+    void DumpNode(DCameraNodeStats& stats, int64_t nowUs, std::string& result);
+
+    static constexpr int64_t WATCH_INTERVAL_MS = 1000;
+
+    std::mutex statsMutex_;
+    std::vector<std::weak_ptr<DCameraNodeStats>> nodes_;
+
+    // Serializes start and stop, watchMutex_ only guards the flag the loop waits on
+    std::mutex watchCtrlMutex_;
+    std::mutex watchMutex_;
+    std::condition_variable watchCond_;
+    std::thread watchThread_;
+    bool isWatching_ = false;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_STATS_MANAGER_H
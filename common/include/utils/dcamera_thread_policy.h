@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_THREAD_POLICY_H
+#define OHOS_DCAMERA_THREAD_POLICY_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+const std::string DCAMERA_THREAD_POLICY_PARA_PREFIX = "persist.dcamera.thread.";
+
+typedef enum {
+    DCAMERA_THREAD_SOFTBUS_CALLBACK = 0,
+    DCAMERA_THREAD_SESSION_EVENT = 1,
+    DCAMERA_THREAD_DECODE_OUTPUT = 2,
+    DCAMERA_THREAD_SYNC_VIDEO = 3,
+    DCAMERA_THREAD_EXECUTOR = 4,
+    DCAMERA_THREAD_CAPTURE_SETUP = 5,
+    DCAMERA_THREAD_ROLE_MAX = 6,
+} DCameraThreadRole;
+
+/*
+ * Scheduling of one thread role. A zero nice, rtPriority or cpuMask leaves that attribute as
+ * inherited on the first apply, a positive rtPriority switches the thread to SCHED_FIFO and the nice
+ * value is then ignored. When the policy changes, a thread is moved back to SCHED_OTHER with the
+ * configured nice value and any CPU. ffrtQos only applies to roles running as ffrt tasks.
+ */
+struct DCameraThreadConfig {
+    int32_t nice = 0;
+    int32_t rtPriority = 0;
+    uint64_t cpuMask = 0;
+    int32_t ffrtQos = 0;
+};
+
+struct DCameraWakeupResult {
+    int32_t applyRet = 0;
+    int64_t avgUs = 0;
+    int64_t p99Us = 0;
+    int64_t maxUs = 0;
+};
+
+class DCameraThreadPolicy {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraThreadPolicy);
+
+public:
+    // Cheap after the first call from a thread, the policy is only applied again when it changed
+    int32_t ApplyToCurrentThread(DCameraThreadRole role);
+    DCameraThreadConfig GetConfig(DCameraThreadRole role);
+    void SetConfig(DCameraThreadRole role, const DCameraThreadConfig& config);
+    int32_t GetFfrtQos(DCameraThreadRole role);
+    // Runs a periodic sleeper under the role policy and measures how late it wakes up
+    int32_t RunWakeupTest(DCameraThreadRole role, int32_t iterations, DCameraWakeupResult& result);
+    void Dump(std::string& result, bool withWakeupTest);
+
+    static std::string GetRoleName(DCameraThreadRole role);
+    static bool ParseConfig(const std::string& value, DCameraThreadConfig& config);
+
+private:
+    explicit DCameraThreadPolicy();
+    ~DCameraThreadPolicy() = default;
+    int32_t Apply(DCameraThreadRole role, const DCameraThreadConfig& config, bool reset);
+
+    static constexpr int32_t WAKEUP_TEST_ITERATIONS = 200;
+    static constexpr int64_t WAKEUP_TEST_PERIOD_US = 1000;
+
+    std::mutex mutex_;
+    DCameraThreadConfig configs_[DCAMERA_THREAD_ROLE_MAX];
+    // Bumped on every change so threads that already applied a role pick up the new policy
+    std::atomic<uint32_t> generation_ { 1 };
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_THREAD_POLICY_H
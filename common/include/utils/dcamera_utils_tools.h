@@ -43,6 +43,8 @@ std::string Base64Decode(const std::string& basicString);
 void DumpBufferToFile(const std::string& dumpPath, const std::string& fileName, uint8_t *buffer, size_t bufSize);
 bool IsBase64(unsigned char c);
 int32_t IsUnderDumpMaxSize(const std::string& dumpPath, const std::string& fileName);
+template <typename T>
+bool GetSysPara(const char *key, T &value);
 
 #ifdef DCAMERA_MMAP_RESERVE
 class ConverterHandle {
@@ -17,6 +17,8 @@
 #include "distributed_camera_errno.h"
 #include "distributed_camera_constants.h"
 
+#include <utility>
+
 namespace OHOS {
 namespace DistributedHardware {
 DataBuffer::DataBuffer(size_t capacity)
@@ -30,6 +32,16 @@ DataBuffer::DataBuffer(size_t capacity)
     }
 }
 
+DataBuffer::DataBuffer(uint8_t *data, size_t size, std::function<void()> releaser)
+{
+    if (data != nullptr && size != 0) {
+        data_ = data;
+        capacity_ = size;
+        rangeLength_ = size;
+    }
+    releaser_ = std::move(releaser);
+}
+
 size_t DataBuffer::Capacity() const
 {
     return capacity_;
@@ -50,6 +62,11 @@ uint8_t *DataBuffer::Data() const
     return data_ + rangeOffset_;
 }
 
+bool DataBuffer::IsBorrowed() const
+{
+    return releaser_ != nullptr;
+}
+
 int32_t DataBuffer::SetRange(size_t offset, size_t size)
 {
     if (!(offset <= capacity_) || !(offset + size <= capacity_)) {
@@ -116,6 +133,12 @@ int64_t DataBuffer::GetTimeStamp()
 
 DataBuffer::~DataBuffer()
 {
+    if (releaser_ != nullptr) {
+        releaser_();
+        releaser_ = nullptr;
+        data_ = nullptr;
+        return;
+    }
     if (data_ != nullptr) {
         delete[] data_;
         data_ = nullptr;
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_decoder_budget.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "dcamera_utils_tools.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+IMPLEMENT_SINGLE_INSTANCE(DCameraDecoderBudget);
+
+namespace {
+const std::string BACKEND_NAMES[] = { "auto", "hardware", "software" };
+const std::string MIME_HEVC = "video/hevc";
+const std::string THREADING_FRAME = "frame";
+// Conservative single core decode speed, only used until a resolution has been measured at runtime
+constexpr int64_t MODEL_AVC_PIXELS_PER_US = 120;
+constexpr int64_t MODEL_HEVC_PIXELS_PER_US = 70;
+constexpr int64_t PERCENT = 100;
+constexpr int32_t MAX_SOFTWARE_THREADS = 16;
+}
+
+DCameraDecoderBudget::DCameraDecoderBudget()
+{
+    std::string backend;
+    if (GetSysPara(DCAMERA_DECODER_BACKEND_PARA.c_str(), backend)) {
+        if (backend == BACKEND_NAMES[DCAMERA_DECODER_HARDWARE]) {
+            config_.backend = DCAMERA_DECODER_HARDWARE;
+        } else if (backend == BACKEND_NAMES[DCAMERA_DECODER_SOFTWARE]) {
+            config_.backend = DCAMERA_DECODER_SOFTWARE;
+        }
+    }
+    int32_t value = 0;
+    if (GetSysPara(DCAMERA_DECODER_HW_MAX_PARA.c_str(), value) && value >= 0) {
+        config_.hardwareMax = value;
+    }
+    if (GetSysPara(DCAMERA_DECODER_SW_CORES_PARA.c_str(), value) && value >= 0) {
+        config_.softwareCores = value;
+    }
+    if (GetSysPara(DCAMERA_DECODER_SW_THREADS_PARA.c_str(), value) && value > 0) {
+        config_.softwareThreads = std::min(value, MAX_SOFTWARE_THREADS);
+    }
+    std::string threading;
+    if (GetSysPara(DCAMERA_DECODER_SW_THREADING_PARA.c_str(), threading)) {
+        config_.frameThreading = (threading == THREADING_FRAME);
+    }
+    DHLOGI("decoder budget backend %{public}s, hardware max %{public}d, software cores %{public}d, threads "
+        "%{public}d, frame threading %{public}d", BACKEND_NAMES[config_.backend].c_str(), config_.hardwareMax,
+        config_.softwareCores, config_.softwareThreads, config_.frameThreading);
+}
+
+DCameraDecoderConfig DCameraDecoderBudget::GetConfig()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+void DCameraDecoderBudget::SetConfig(const DCameraDecoderConfig& config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+bool DCameraDecoderBudget::AcquireHardware()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (config_.hardwareMax > 0 && hardwareCount_ >= config_.hardwareMax) {
+        DHLOGI("hardware decoders at limit %{public}d", config_.hardwareMax);
+        return false;
+    }
+    hardwareCount_++;
+    return true;
+}
+
+void DCameraDecoderBudget::ReleaseHardware()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hardwareCount_ > 0) {
+        hardwareCount_--;
+    }
+}
+
+int64_t DCameraDecoderBudget::AcquireSoftware(const std::string& mime, int32_t width, int32_t height, int32_t fps)
+{
+    if (width <= 0 || height <= 0) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t load = GetFrameCostLocked(mime, width, height) * ((fps > 0) ? fps : DEFAULT_FPS);
+    int64_t budget = static_cast<int64_t>(config_.softwareCores) * US_PER_SECOND;
+    if (softwareLoad_ + load > budget) {
+        DHLOGI("software decode of %{public}dx%{public}d needs %{public}" PRId64 " us/s, in use %{public}" PRId64
+            " of %{public}" PRId64, width, height, load, softwareLoad_, budget);
+        return -1;
+    }
+    softwareLoad_ += load;
+    softwareCount_++;
+    return load;
+}
+
+void DCameraDecoderBudget::ReleaseSoftware(int64_t load)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    softwareLoad_ = std::max(softwareLoad_ - load, static_cast<int64_t>(0));
+    if (softwareCount_ > 0) {
+        softwareCount_--;
+    }
+}
+
+void DCameraDecoderBudget::AddSoftwareSample(const std::string& mime, int32_t width, int32_t height, int64_t wallUs,
+    int64_t busyUs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ThroughputStats& stats = stats_[GetStatsKey(mime, width, height)];
+    if (stats.frames == 0) {
+        stats.mime = mime;
+        stats.width = width;
+        stats.height = height;
+    }
+    stats.frames++;
+    stats.wallUs += wallUs;
+    stats.busyUs += busyUs;
+}
+
+int64_t DCameraDecoderBudget::GetSoftwareFrameCost(const std::string& mime, int32_t width, int32_t height)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetFrameCostLocked(mime, width, height);
+}
+
+int64_t DCameraDecoderBudget::GetFrameCostLocked(const std::string& mime, int32_t width, int32_t height)
+{
+    auto iter = stats_.find(GetStatsKey(mime, width, height));
+    if (iter != stats_.end() && iter->second.frames >= MIN_SAMPLE_FRAMES) {
+        return std::max(iter->second.busyUs / iter->second.frames, static_cast<int64_t>(1));
+    }
+    int64_t pixelsPerUs = (mime == MIME_HEVC) ? MODEL_HEVC_PIXELS_PER_US : MODEL_AVC_PIXELS_PER_US;
+    return std::max(static_cast<int64_t>(width) * height / pixelsPerUs, static_cast<int64_t>(1));
+}
+
+std::string DCameraDecoderBudget::GetStatsKey(const std::string& mime, int32_t width, int32_t height)
+{
+    return mime + "/" + std::to_string(width) + "x" + std::to_string(height);
+}
+
+void DCameraDecoderBudget::Dump(std::string& result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t budget = static_cast<int64_t>(config_.softwareCores) * US_PER_SECOND;
+    result.append("Backend: ").append(BACKEND_NAMES[config_.backend])
+        .append(", hardware: ").append(std::to_string(hardwareCount_)).append("/")
+        .append((config_.hardwareMax > 0) ? std::to_string(config_.hardwareMax) : "unlimited")
+        .append(", software: ").append(std::to_string(softwareCount_))
+        .append(" streams, load ").append(std::to_string(softwareLoad_ * PERCENT / US_PER_SECOND))
+        .append("%/").append(std::to_string(budget * PERCENT / US_PER_SECOND))
+        .append("%, threads ").append(std::to_string(config_.softwareThreads))
+        .append(config_.frameThreading ? " frame" : " slice").append("\n");
+    // Streams is how many streams of that resolution the software core budget sustains at 30 fps
+    result.append("Codec\tResolution\tFrames\tWall(us)\tBusy(us)\tFps/core\tStreams@")
+        .append(std::to_string(DEFAULT_FPS)).append("fps\n");
+    for (const auto& item : stats_) {
+        const ThroughputStats& stats = item.second;
+        int64_t wall = stats.wallUs / stats.frames;
+        int64_t busy = std::max(stats.busyUs / stats.frames, static_cast<int64_t>(1));
+        result.append(stats.mime).append("\t").append(std::to_string(stats.width)).append("x")
+            .append(std::to_string(stats.height)).append("\t").append(std::to_string(stats.frames)).append("\t")
+            .append(std::to_string(wall)).append("\t").append(std::to_string(busy)).append("\t")
+            .append(std::to_string(US_PER_SECOND / busy)).append("\t")
+            .append(std::to_string(budget / (busy * DEFAULT_FPS))).append("\n");
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
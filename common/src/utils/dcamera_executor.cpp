@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_executor.h"
+
+#include <algorithm>
+#include <sys/prctl.h>
+
+#include "dcamera_thread_policy.h"
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+IMPLEMENT_SINGLE_INSTANCE(DCameraExecutor);
+
+namespace {
+const std::string EXECUTOR_THREAD_NAME = "DCameraExecutor";
+const std::string STRAND_THREAD_NAME = "DCameraStrand";
+}
+
+DCameraStrand::DCameraStrand(const std::string& name, bool isDedicated) : name_(name), isDedicated_(isDedicated)
+{
+}
+
+DCameraStrand::~DCameraStrand()
+{
+    if (!thread_.joinable()) {
+        return;
+    }
+    // The thread holds the strand until it leaves its loop, so only that thread can release it here
+    if (thread_.get_id() == std::this_thread::get_id()) {
+        thread_.detach();
+        return;
+    }
+    thread_.join();
+}
+
+int32_t DCameraStrand::Post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            DHLOGD("strand %{public}s stopped, drop task", name_.c_str());
+            return DCAMERA_WRONG_STATE;
+        }
+        tasks_.push_back(std::move(task));
+        if (isDedicated_) {
+            cond_.notify_all();
+            return DCAMERA_OK;
+        }
+        if (scheduled_) {
+            return DCAMERA_OK;
+        }
+        scheduled_ = true;
+    }
+    DCameraExecutor::GetInstance().Schedule(shared_from_this());
+    return DCAMERA_OK;
+}
+
+void DCameraStrand::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.clear();
+}
+
+void DCameraStrand::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stopped_ = true;
+        tasks_.clear();
+        cond_.notify_all();
+        if (runningThread_ == std::this_thread::get_id()) {
+            return;
+        }
+        cond_.wait(lock, [this] { return !running_; });
+    }
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+    }
+}
+
+bool DCameraStrand::IsIdle()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.empty() && !running_;
+}
+
+const std::string& DCameraStrand::GetName() const
+{
+    return name_;
+}
+
+void DCameraStrand::RunOne()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) {
+            scheduled_ = false;
+            return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        running_ = true;
+        runningThread_ = std::this_thread::get_id();
+    }
+    task();
+    bool hasMore = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        runningThread_ = std::thread::id();
+        hasMore = !tasks_.empty();
+        scheduled_ = hasMore;
+    }
+    cond_.notify_all();
+    // Requeue behind the other ready strands so a busy camera cannot starve the rest
+    if (hasMore) {
+        DCameraExecutor::GetInstance().Schedule(shared_from_this());
+    }
+}
+
+void DCameraStrand::StartThread()
+{
+    std::shared_ptr<DCameraStrand> self = shared_from_this();
+    thread_ = std::thread([self]() { self->ThreadLoop(); });
+}
+
+void DCameraStrand::ThreadLoop()
+{
+    prctl(PR_SET_NAME, STRAND_THREAD_NAME.c_str());
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+            if (stopped_) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            running_ = true;
+            runningThread_ = std::this_thread::get_id();
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+            runningThread_ = std::thread::id();
+        }
+        cond_.notify_all();
+    }
+}
+
+DCameraExecutor::DCameraExecutor()
+{
+    int32_t threadNum = std::clamp(static_cast<int32_t>(std::thread::hardware_concurrency()),
+        MIN_THREAD_NUM, MAX_THREAD_NUM);
+    int32_t paraNum = 0;
+    if (GetSysPara(DCAMERA_EXECUTOR_THREADS_PARA.c_str(), paraNum) && paraNum > 0) {
+        threadNum = std::min(paraNum, MAX_THREAD_NUM);
+    }
+    DHLOGI("executor start %{public}d threads", threadNum);
+    for (int32_t i = 0; i < threadNum; i++) {
+        workers_.emplace_back([this]() { this->WorkerLoop(); });
+    }
+}
+
+DCameraExecutor::~DCameraExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isRunning_ = false;
+        readyStrands_.clear();
+    }
+    cond_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+std::shared_ptr<DCameraStrand> DCameraExecutor::CreateStrand(const std::string& name, bool isDedicated)
+{
+    auto strand = std::make_shared<DCameraStrand>(name, isDedicated);
+    if (isDedicated) {
+        strand->StartThread();
+    }
+    return strand;
+}
+
+size_t DCameraExecutor::GetThreadNum()
+{
+    return workers_.size();
+}
+
+void DCameraExecutor::Schedule(const std::shared_ptr<DCameraStrand>& strand)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!isRunning_) {
+            return;
+        }
+        readyStrands_.push_back(strand);
+    }
+    cond_.notify_one();
+}
+
+void DCameraExecutor::WorkerLoop()
+{
+    prctl(PR_SET_NAME, EXECUTOR_THREAD_NAME.c_str());
+    DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_EXECUTOR);
+    while (true) {
+        std::shared_ptr<DCameraStrand> strand = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this] { return !isRunning_ || !readyStrands_.empty(); });
+            if (!isRunning_) {
+                return;
+            }
+            strand = std::move(readyStrands_.front());
+            readyStrands_.pop_front();
+        }
+        strand->RunOne();
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_memory_accountant.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+IMPLEMENT_SINGLE_INSTANCE(DCameraMemoryAccountant);
+
+namespace {
+constexpr int64_t BYTES_PER_KB = 1024;
+// NV12 and YUV420P both hold one and a half bytes per pixel
+constexpr int64_t YUV_BYTES_NUMERATOR = 3;
+constexpr int64_t YUV_BYTES_DENOMINATOR = 2;
+
+void UpdateMax(std::atomic<int64_t>& peak, int64_t value)
+{
+    int64_t cur = peak.load(std::memory_order_relaxed);
+    while (value > cur && !peak.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+    }
+}
+}
+
+DCameraQueueMemory::DCameraQueueMemory(const std::string& owner, const std::string& queueName)
+    : owner_(owner), queueName_(queueName)
+{
+}
+
+DCameraQueueMemory::~DCameraQueueMemory()
+{
+    Clear();
+}
+
+void DCameraQueueMemory::Add(size_t bytes)
+{
+    int64_t held = bytes_.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+        static_cast<int64_t>(bytes);
+    UpdateMax(peak_, held);
+    DCameraMemoryAccountant::GetInstance().AddQueued(static_cast<int64_t>(bytes));
+}
+
+void DCameraQueueMemory::Sub(size_t bytes)
+{
+    bytes_.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    DCameraMemoryAccountant::GetInstance().AddQueued(-static_cast<int64_t>(bytes));
+}
+
+void DCameraQueueMemory::Clear()
+{
+    int64_t held = bytes_.exchange(0, std::memory_order_relaxed);
+    if (held != 0) {
+        DCameraMemoryAccountant::GetInstance().AddQueued(-held);
+    }
+}
+
+bool DCameraQueueMemory::CanQueue(size_t depth, size_t frameBytes, size_t maxDepth)
+{
+    if (depth >= maxDepth) {
+        return false;
+    }
+    if (depth < MIN_QUEUE_DEPTH) {
+        return true;
+    }
+    DCameraMemoryAccountant& accountant = DCameraMemoryAccountant::GetInstance();
+    return accountant.GetUsedBytes() + static_cast<int64_t>(frameBytes) <= accountant.GetBudget();
+}
+
+DCameraMemoryAccountant::DCameraMemoryAccountant()
+{
+    int64_t budgetMb = 0;
+    if (GetSysPara(DCAMERA_MEMORY_BUDGET_PARA.c_str(), budgetMb) && budgetMb > 0) {
+        budget_.store(budgetMb * BYTES_PER_MB, std::memory_order_relaxed);
+    }
+    DHLOGI("memory budget %{public}" PRId64 " MB", budget_.load(std::memory_order_relaxed) / BYTES_PER_MB);
+}
+
+int32_t DCameraMemoryAccountant::Reserve(const std::string& owner, int64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = reservations_.find(owner);
+    int64_t old = (iter != reservations_.end()) ? iter->second : 0;
+    // Only what the other cameras reserved counts, their queues move from frame to frame
+    int64_t otherBytes = reservedBytes_.load(std::memory_order_relaxed) - old;
+    int64_t budget = budget_.load(std::memory_order_relaxed);
+    if (otherBytes + bytes > budget) {
+        DHLOGE("memory reserve %{public}s rejected, need %{public}" PRId64 " KB, reserved %{public}" PRId64
+            " KB, budget %{public}" PRId64 " KB", owner.c_str(), bytes / BYTES_PER_KB, otherBytes / BYTES_PER_KB,
+            budget / BYTES_PER_KB);
+        return DCAMERA_ALLOC_ERROR;
+    }
+    reservations_[owner] = bytes;
+    reservationPeaks_[owner] = std::max(reservationPeaks_[owner], bytes);
+    reservedBytes_.fetch_add(bytes - old, std::memory_order_relaxed);
+    UpdatePeak();
+    return DCAMERA_OK;
+}
+
+void DCameraMemoryAccountant::Unreserve(const std::string& owner)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = reservations_.find(owner);
+    if (iter == reservations_.end()) {
+        return;
+    }
+    reservedBytes_.fetch_sub(iter->second, std::memory_order_relaxed);
+    reservations_.erase(iter);
+}
+
+std::shared_ptr<DCameraQueueMemory> DCameraMemoryAccountant::RegisterQueue(const std::string& owner,
+    const std::string& queueName)
+{
+    auto queue = std::make_shared<DCameraQueueMemory>(owner, queueName);
+    std::lock_guard<std::mutex> lock(mutex_);
+    queues_.erase(std::remove_if(queues_.begin(), queues_.end(),
+        [](const std::weak_ptr<DCameraQueueMemory>& item) { return item.expired(); }), queues_.end());
+    queues_.push_back(queue);
+    return queue;
+}
+
+void DCameraMemoryAccountant::SetBudget(int64_t bytes)
+{
+    budget_.store(bytes, std::memory_order_relaxed);
+}
+
+int64_t DCameraMemoryAccountant::GetBudget()
+{
+    return budget_.load(std::memory_order_relaxed);
+}
+
+int64_t DCameraMemoryAccountant::GetUsedBytes()
+{
+    return reservedBytes_.load(std::memory_order_relaxed) + queuedBytes_.load(std::memory_order_relaxed);
+}
+
+int64_t DCameraMemoryAccountant::GetPeakBytes()
+{
+    return peakBytes_.load(std::memory_order_relaxed);
+}
+
+void DCameraMemoryAccountant::Dump(std::string& result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.append("Budget: ").append(std::to_string(GetBudget() / BYTES_PER_KB)).append(" KB\n")
+        .append("Used: ").append(std::to_string(GetUsedBytes() / BYTES_PER_KB)).append(" KB, peak ")
+        .append(std::to_string(GetPeakBytes() / BYTES_PER_KB)).append(" KB\n")
+        .append("Owner\tReserved(KB)\tPeak(KB)\n");
+    for (const auto& peak : reservationPeaks_) {
+        auto iter = reservations_.find(peak.first);
+        int64_t reserved = (iter != reservations_.end()) ? iter->second : 0;
+        result.append(peak.first).append("\t").append(std::to_string(reserved / BYTES_PER_KB)).append("\t")
+            .append(std::to_string(peak.second / BYTES_PER_KB)).append("\n");
+    }
+    result.append("Owner\tQueue\tHeld(KB)\tPeak(KB)\n");
+    for (const auto& item : queues_) {
+        std::shared_ptr<DCameraQueueMemory> queue = item.lock();
+        if (queue == nullptr) {
+            continue;
+        }
+        result.append(queue->owner_).append("\t").append(queue->queueName_).append("\t")
+            .append(std::to_string(queue->bytes_.load(std::memory_order_relaxed) / BYTES_PER_KB)).append("\t")
+            .append(std::to_string(queue->peak_.load(std::memory_order_relaxed) / BYTES_PER_KB)).append("\n");
+    }
+}
+
+int64_t DCameraMemoryAccountant::GetFrameBytes(int32_t width, int32_t height)
+{
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(width) * height * YUV_BYTES_NUMERATOR / YUV_BYTES_DENOMINATOR;
+}
+
+void DCameraMemoryAccountant::AddQueued(int64_t bytes)
+{
+    queuedBytes_.fetch_add(bytes, std::memory_order_relaxed);
+    if (bytes > 0) {
+        UpdatePeak();
+    }
+}
+
+void DCameraMemoryAccountant::UpdatePeak()
+{
+    UpdateMax(peakBytes_, GetUsedBytes());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
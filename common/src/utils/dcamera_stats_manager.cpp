@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_stats_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+IMPLEMENT_SINGLE_INSTANCE(DCameraStatsManager);
+
+namespace {
+const std::string DROP_REASON_NAMES[DCAMERA_DROP_REASON_MAX] = { "busy", "fps", "expired", "smoother" };
+constexpr double US_PER_S = 1000000.0;
+constexpr double BITS_PER_KBYTE = 8.0 / 1000.0;
+constexpr int32_t RATE_PRECISION = 1;
+}
+
+DCameraNodeStats::DCameraNodeStats(const std::string& streamName, const std::string& nodeName,
+    const std::vector<std::string>& queueNames) : streamName_(streamName), nodeName_(nodeName)
+{
+    for (const auto& name : queueNames) {
+        auto queue = std::make_unique<QueueStats>();
+        queue->name = name;
+        queues_.push_back(std::move(queue));
+    }
+    for (auto& drop : drops_) {
+        drop.store(0, std::memory_order_relaxed);
+    }
+}
+
+void DCameraNodeStats::AddInput(size_t bytes)
+{
+    inFrames_.fetch_add(1, std::memory_order_relaxed);
+    inBytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void DCameraNodeStats::AddOutput(size_t bytes)
+{
+    outFrames_.fetch_add(1, std::memory_order_relaxed);
+    outBytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void DCameraNodeStats::AddDrop(DCameraDropReason reason, uint64_t num)
+{
+    if (reason < DCAMERA_DROP_BUSY || reason >= DCAMERA_DROP_REASON_MAX) {
+        return;
+    }
+    drops_[reason].fetch_add(num, std::memory_order_relaxed);
+}
+
+void DCameraNodeStats::SetQueueDepth(size_t queueIndex, size_t depth)
+{
+    if (queueIndex >= queues_.size()) {
+        return;
+    }
+    QueueStats& queue = *queues_[queueIndex];
+    queue.depth.store(depth, std::memory_order_relaxed);
+    uint64_t peak = queue.peak.load(std::memory_order_relaxed);
+    while (depth > peak && !queue.peak.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+    }
+}
+
+void DCameraNodeStats::SetInFlight(int32_t num)
+{
+    inFlight_.store(num, std::memory_order_relaxed);
+}
+
+DCameraStatsManager::~DCameraStatsManager()
+{
+    StopWatch();
+}
+
+std::shared_ptr<DCameraNodeStats> DCameraStatsManager::Register(const std::string& streamName,
+    const std::string& nodeName, const std::vector<std::string>& queueNames)
+{
+    auto stats = std::make_shared<DCameraNodeStats>(streamName, nodeName, queueNames);
+    stats->snapshot_.timeUs = GetNowTimeStampUs();
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    nodes_.erase(std::remove_if(nodes_.begin(), nodes_.end(),
+        [](const std::weak_ptr<DCameraNodeStats>& node) { return node.expired(); }), nodes_.end());
+    nodes_.push_back(stats);
+    return stats;
+}
+
+void DCameraStatsManager::Dump(std::string& result)
+{
+    int64_t nowUs = GetNowTimeStampUs();
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    result.append("Stream\tNode\tStats\n");
+    for (const auto& node : nodes_) {
+        std::shared_ptr<DCameraNodeStats> stats = node.lock();
+        if (stats != nullptr) {
+            DumpNode(*stats, nowUs, result);
+        }
+    }
+}
+
+void DCameraStatsManager::DumpNode(DCameraNodeStats& stats, int64_t nowUs, std::string& result)
+{
+    uint64_t inFrames = stats.inFrames_.load(std::memory_order_relaxed);
+    uint64_t outFrames = stats.outFrames_.load(std::memory_order_relaxed);
+    uint64_t inBytes = stats.inBytes_.load(std::memory_order_relaxed);
+    double seconds = static_cast<double>(nowUs - stats.snapshot_.timeUs) / US_PER_S;
+    double inFps = 0.0;
+    double outFps = 0.0;
+    double kbps = 0.0;
+    if (seconds > 0.0) {
+        inFps = static_cast<double>(inFrames - stats.snapshot_.inFrames) / seconds;
+        outFps = static_cast<double>(outFrames - stats.snapshot_.outFrames) / seconds;
+        kbps = static_cast<double>(inBytes - stats.snapshot_.inBytes) * BITS_PER_KBYTE / seconds;
+    }
+    stats.snapshot_ = { nowUs, inFrames, outFrames, inBytes };
+
+    std::ostringstream line;
+    line.setf(std::ios::fixed);
+    line.precision(RATE_PRECISION);
+    line << stats.streamName_ << "\t" << stats.nodeName_ << "\tin " << inFrames << " (" << inFps << " fps) out "
+        << outFrames << " (" << outFps << " fps) " << kbps << " kbps inflight "
+        << stats.inFlight_.load(std::memory_order_relaxed);
+    for (const auto& queue : stats.queues_) {
+        line << " " << queue->name << " " << queue->depth.load(std::memory_order_relaxed) << "/"
+            << queue->peak.load(std::memory_order_relaxed);
+    }
+    line << " drop";
+    for (int32_t reason = DCAMERA_DROP_BUSY; reason < DCAMERA_DROP_REASON_MAX; reason++) {
+        line << " " << DROP_REASON_NAMES[reason] << " " << stats.drops_[reason].load(std::memory_order_relaxed);
+    }
+    result.append(line.str()).append("\n");
+}
+
+int32_t DCameraStatsManager::StartWatch()
+{
+    std::lock_guard<std::mutex> ctrlLock(watchCtrlMutex_);
+    if (watchThread_.joinable()) {
+        return DCAMERA_OK;
+    }
+    DHLOGI("start stats watch");
+    {
+        std::lock_guard<std::mutex> lock(watchMutex_);
+        isWatching_ = true;
+    }
+    watchThread_ = std::thread([this]() { this->WatchLoop(); });
+    return DCAMERA_OK;
+}
+
+int32_t DCameraStatsManager::StopWatch()
+{
+    std::lock_guard<std::mutex> ctrlLock(watchCtrlMutex_);
+    if (!watchThread_.joinable()) {
+        return DCAMERA_OK;
+    }
+    DHLOGI("stop stats watch");
+    {
+        std::lock_guard<std::mutex> lock(watchMutex_);
+        isWatching_ = false;
+    }
+    watchCond_.notify_all();
+    watchThread_.join();
+    return DCAMERA_OK;
+}
+
+void DCameraStatsManager::WatchLoop()
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(watchMutex_);
+            watchCond_.wait_for(lock, std::chrono::milliseconds(WATCH_INTERVAL_MS), [this] { return !isWatching_; });
+            if (!isWatching_) {
+                return;
+            }
+        }
+        std::string result;
+        Dump(result);
+        std::istringstream lines(result);
+        std::string line;
+        while (std::getline(lines, line)) {
+            DHLOGI("stats %{public}s", line.c_str());
+        }
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
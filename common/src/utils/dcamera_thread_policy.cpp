@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_thread_policy.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <sched.h>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+#include "ffrt_inner.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+IMPLEMENT_SINGLE_INSTANCE(DCameraThreadPolicy);
+
+namespace {
+const std::string ROLE_NAMES[DCAMERA_THREAD_ROLE_MAX] = {
+    "softbus_callback", "session_event", "decode_output", "sync_video", "executor", "capture_setup"
+};
+constexpr int32_t HOT_THREAD_NICE = -8;
+constexpr int32_t PACING_THREAD_NICE = -10;
+constexpr size_t CONFIG_FIELD_NUM = 4;
+constexpr size_t FIELD_NICE = 0;
+constexpr size_t FIELD_RT_PRIORITY = 1;
+constexpr size_t FIELD_CPU_MASK = 2;
+constexpr size_t FIELD_FFRT_QOS = 3;
+constexpr int32_t CPU_MASK_BITS = 64;
+constexpr int32_t PERCENTILE = 99;
+constexpr int32_t PERCENT = 100;
+constexpr char CONFIG_SEPARATOR = ',';
+
+thread_local int32_t g_appliedRole = -1;
+thread_local uint32_t g_appliedGeneration = 0;
+
+bool ParseInt(const std::string& item, int32_t& number)
+{
+    char *endPtr = nullptr;
+    errno = 0;
+    long parsed = strtol(item.c_str(), &endPtr, 0);
+    if (item.empty() || *endPtr != '\0' || errno != 0 || parsed < INT32_MIN || parsed > INT32_MAX) {
+        return false;
+    }
+    number = static_cast<int32_t>(parsed);
+    return true;
+}
+
+bool ParseMask(const std::string& item, uint64_t& mask)
+{
+    char *endPtr = nullptr;
+    errno = 0;
+    unsigned long long parsed = strtoull(item.c_str(), &endPtr, 0);
+    if (item.empty() || item[0] == '-' || *endPtr != '\0' || errno != 0) {
+        return false;
+    }
+    mask = static_cast<uint64_t>(parsed);
+    return true;
+}
+}
+
+DCameraThreadPolicy::DCameraThreadPolicy()
+{
+    // Softbus owns its callback threads, they keep their scheduling unless configured
+    configs_[DCAMERA_THREAD_SESSION_EVENT].nice = HOT_THREAD_NICE;
+    configs_[DCAMERA_THREAD_DECODE_OUTPUT].nice = HOT_THREAD_NICE;
+    configs_[DCAMERA_THREAD_SYNC_VIDEO].nice = PACING_THREAD_NICE;
+    configs_[DCAMERA_THREAD_EXECUTOR].nice = HOT_THREAD_NICE;
+    configs_[DCAMERA_THREAD_CAPTURE_SETUP].ffrtQos = static_cast<int32_t>(ffrt::qos_user_initiated);
+    for (int32_t role = 0; role < DCAMERA_THREAD_ROLE_MAX; role++) {
+        std::string value;
+        std::string key = DCAMERA_THREAD_POLICY_PARA_PREFIX + ROLE_NAMES[role];
+        if (!GetSysPara(key.c_str(), value) || value.empty()) {
+            continue;
+        }
+        if (!ParseConfig(value, configs_[role])) {
+            DHLOGE("thread policy %{public}s invalid: %{public}s", ROLE_NAMES[role].c_str(), value.c_str());
+            continue;
+        }
+        DHLOGI("thread policy %{public}s configured: %{public}s", ROLE_NAMES[role].c_str(), value.c_str());
+    }
+}
+
+int32_t DCameraThreadPolicy::ApplyToCurrentThread(DCameraThreadRole role)
+{
+    if (role < DCAMERA_THREAD_SOFTBUS_CALLBACK || role >= DCAMERA_THREAD_ROLE_MAX) {
+        return DCAMERA_BAD_VALUE;
+    }
+    uint32_t generation = generation_.load(std::memory_order_acquire);
+    if (g_appliedRole == role && g_appliedGeneration == generation) {
+        return DCAMERA_OK;
+    }
+    // A thread that applied an earlier policy has to be put back explicitly, zero fields do not undo it
+    bool reset = g_appliedRole >= 0;
+    g_appliedRole = role;
+    g_appliedGeneration = generation;
+    return Apply(role, GetConfig(role), reset);
+}
+
+DCameraThreadConfig DCameraThreadPolicy::GetConfig(DCameraThreadRole role)
+{
+    if (role < DCAMERA_THREAD_SOFTBUS_CALLBACK || role >= DCAMERA_THREAD_ROLE_MAX) {
+        return DCameraThreadConfig();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return configs_[role];
+}
+
+void DCameraThreadPolicy::SetConfig(DCameraThreadRole role, const DCameraThreadConfig& config)
+{
+    if (role < DCAMERA_THREAD_SOFTBUS_CALLBACK || role >= DCAMERA_THREAD_ROLE_MAX) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    configs_[role] = config;
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+int32_t DCameraThreadPolicy::GetFfrtQos(DCameraThreadRole role)
+{
+    return GetConfig(role).ffrtQos;
+}
+
+int32_t DCameraThreadPolicy::Apply(DCameraThreadRole role, const DCameraThreadConfig& config, bool reset)
+{
+    int32_t ret = DCAMERA_OK;
+    if (config.cpuMask != 0 || reset) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (int32_t cpu = 0; cpu < CPU_MASK_BITS; cpu++) {
+            if (config.cpuMask == 0 || ((config.cpuMask >> cpu) & 1)) {
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+        if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+            DHLOGE("thread policy %{public}s set affinity 0x%{public}" PRIx64 " failed, errno: %{public}d",
+                ROLE_NAMES[role].c_str(), config.cpuMask, errno);
+            ret = DCAMERA_BAD_OPERATE;
+        }
+    }
+    if (config.rtPriority > 0) {
+        sched_param param = {};
+        param.sched_priority = config.rtPriority;
+        if (sched_setscheduler(0, SCHED_FIFO, &param) != 0) {
+            DHLOGE("thread policy %{public}s set rt priority %{public}d failed, errno: %{public}d",
+                ROLE_NAMES[role].c_str(), config.rtPriority, errno);
+            ret = DCAMERA_BAD_OPERATE;
+        }
+    } else if (config.nice != 0 || reset) {
+        sched_param param = {};
+        if (sched_setscheduler(0, SCHED_OTHER, &param) != 0) {
+            DHLOGE("thread policy %{public}s set normal scheduling failed, errno: %{public}d",
+                ROLE_NAMES[role].c_str(), errno);
+            ret = DCAMERA_BAD_OPERATE;
+        }
+        // Linux keeps the nice value per thread, so this only touches the calling thread
+        id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, tid, config.nice) != 0) {
+            DHLOGE("thread policy %{public}s set nice %{public}d failed, errno: %{public}d",
+                ROLE_NAMES[role].c_str(), config.nice, errno);
+            ret = DCAMERA_BAD_OPERATE;
+        }
+    }
+    return ret;
+}
+
+int32_t DCameraThreadPolicy::RunWakeupTest(DCameraThreadRole role, int32_t iterations, DCameraWakeupResult& result)
+{
+    if (role < DCAMERA_THREAD_SOFTBUS_CALLBACK || role >= DCAMERA_THREAD_ROLE_MAX || iterations <= 0) {
+        return DCAMERA_BAD_VALUE;
+    }
+    std::vector<int64_t> lateness;
+    lateness.reserve(static_cast<size_t>(iterations));
+    DCameraThreadConfig config = GetConfig(role);
+    // A fresh thread so the caller keeps its own scheduling
+    std::thread tester([this, role, iterations, &config, &lateness, &result]() {
+        result.applyRet = Apply(role, config, false);
+        auto next = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < iterations; i++) {
+            next += std::chrono::microseconds(WAKEUP_TEST_PERIOD_US);
+            std::this_thread::sleep_until(next);
+            auto late = std::chrono::steady_clock::now() - next;
+            lateness.push_back(std::chrono::duration_cast<std::chrono::microseconds>(late).count());
+        }
+    });
+    tester.join();
+
+    std::sort(lateness.begin(), lateness.end());
+    int64_t total = 0;
+    for (int64_t value : lateness) {
+        total += value;
+    }
+    result.avgUs = total / static_cast<int64_t>(lateness.size());
+    result.p99Us = lateness[lateness.size() * PERCENTILE / PERCENT];
+    result.maxUs = lateness.back();
+    return result.applyRet;
+}
+
+void DCameraThreadPolicy::Dump(std::string& result, bool withWakeupTest)
+{
+    result.append("Role\tNice\tRtPrio\tCpuMask\tFfrtQos");
+    result.append(withWakeupTest ? "\tApply\tWakeAvg(us)\tWakeP99(us)\tWakeMax(us)\n" : "\n");
+    for (int32_t role = 0; role < DCAMERA_THREAD_ROLE_MAX; role++) {
+        DCameraThreadRole threadRole = static_cast<DCameraThreadRole>(role);
+        DCameraThreadConfig config = GetConfig(threadRole);
+        std::ostringstream mask;
+        mask << "0x" << std::hex << config.cpuMask;
+        result.append(ROLE_NAMES[role]).append("\t").append(std::to_string(config.nice)).append("\t")
+            .append(std::to_string(config.rtPriority)).append("\t").append(mask.str()).append("\t")
+            .append(std::to_string(config.ffrtQos));
+        if (withWakeupTest) {
+            DCameraWakeupResult wakeup;
+            RunWakeupTest(threadRole, WAKEUP_TEST_ITERATIONS, wakeup);
+            result.append("\t").append(wakeup.applyRet == DCAMERA_OK ? "ok" : "failed").append("\t")
+                .append(std::to_string(wakeup.avgUs)).append("\t").append(std::to_string(wakeup.p99Us))
+                .append("\t").append(std::to_string(wakeup.maxUs));
+        }
+        result.append("\n");
+    }
+}
+
+std::string DCameraThreadPolicy::GetRoleName(DCameraThreadRole role)
+{
+    if (role < DCAMERA_THREAD_SOFTBUS_CALLBACK || role >= DCAMERA_THREAD_ROLE_MAX) {
+        return "";
+    }
+    return ROLE_NAMES[role];
+}
+
+bool DCameraThreadPolicy::ParseConfig(const std::string& value, DCameraThreadConfig& config)
+{
+    // "nice,rtPriority,cpuMask,ffrtQos", trailing fields may be left out and keep their value
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (true) {
+        size_t end = value.find(CONFIG_SEPARATOR, start);
+        items.push_back(value.substr(start, (end == std::string::npos) ? std::string::npos : end - start));
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    if (items.size() > CONFIG_FIELD_NUM) {
+        return false;
+    }
+    DCameraThreadConfig parsed = config;
+    bool ok = ParseInt(items[FIELD_NICE], parsed.nice) &&
+        (items.size() <= FIELD_RT_PRIORITY || ParseInt(items[FIELD_RT_PRIORITY], parsed.rtPriority)) &&
+        (items.size() <= FIELD_CPU_MASK || ParseMask(items[FIELD_CPU_MASK], parsed.cpuMask)) &&
+        (items.size() <= FIELD_FFRT_QOS || ParseInt(items[FIELD_FFRT_QOS], parsed.ffrtQos));
+    if (ok) {
+        config = parsed;
+    }
+    return ok;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
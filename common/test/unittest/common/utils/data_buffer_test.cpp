@@ -132,5 +132,26 @@ HWTEST_F(DataBufferTest, FindString_001, TestSize.Level1)
     ret = dataBuffer_->FindString(name, value);
     EXPECT_EQ(false, ret);
 }
+
+/**
+ * @tc.name: BorrowedBuffer_001
+ * @tc.desc: Verify the borrowed buffer uses external memory and calls the releaser on destruction.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DataBufferTest, BorrowedBuffer_001, TestSize.Level1)
+{
+    uint8_t memory[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int32_t releaseCount = 0;
+    auto buffer = std::make_shared<DataBuffer>(memory, sizeof(memory), [&releaseCount]() { releaseCount++; });
+    EXPECT_EQ(true, buffer->IsBorrowed());
+    EXPECT_EQ(memory, buffer->Data());
+    EXPECT_EQ(sizeof(memory), buffer->Size());
+    EXPECT_EQ(DCAMERA_OK, buffer->SetRange(2, 4));
+    EXPECT_EQ(memory + 2, buffer->Data());
+    EXPECT_EQ(false, dataBuffer_->IsBorrowed());
+    buffer = nullptr;
+    EXPECT_EQ(1, releaseCount);
+}
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dcamera_decoder_budget.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraDecoderBudgetTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    DCameraDecoderConfig oldConfig_;
+};
+
+namespace {
+const std::string TEST_MIME = "video/avc";
+const int32_t TEST_WIDTH = 1920;
+const int32_t TEST_HEIGHT = 1080;
+const int32_t TEST_FPS = 30;
+const int32_t TEST_FRAMES = 30;
+const int64_t TEST_FRAME_WALL_US = 5000;
+const int64_t TEST_FRAME_BUSY_US = 10000;
+}
+
+void DCameraDecoderBudgetTest::SetUpTestCase(void)
+{
+}
+
+void DCameraDecoderBudgetTest::TearDownTestCase(void)
+{
+}
+
+void DCameraDecoderBudgetTest::SetUp(void)
+{
+    oldConfig_ = DCameraDecoderBudget::GetInstance().GetConfig();
+}
+
+void DCameraDecoderBudgetTest::TearDown(void)
+{
+    DCameraDecoderBudget::GetInstance().SetConfig(oldConfig_);
+}
+
+/**
+ * @tc.name: dcamera_decoder_budget_test_001
+ * @tc.desc: Verify hardware decoders are limited by the configured maximum.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraDecoderBudgetTest, dcamera_decoder_budget_test_001, TestSize.Level1)
+{
+    DCameraDecoderBudget& budget = DCameraDecoderBudget::GetInstance();
+    DCameraDecoderConfig config = oldConfig_;
+    config.hardwareMax = 1;
+    budget.SetConfig(config);
+    EXPECT_TRUE(budget.AcquireHardware());
+    EXPECT_FALSE(budget.AcquireHardware());
+    budget.ReleaseHardware();
+    EXPECT_TRUE(budget.AcquireHardware());
+    budget.ReleaseHardware();
+
+    config.hardwareMax = 0;
+    budget.SetConfig(config);
+    EXPECT_TRUE(budget.AcquireHardware());
+    EXPECT_TRUE(budget.AcquireHardware());
+    budget.ReleaseHardware();
+    budget.ReleaseHardware();
+}
+
+/**
+ * @tc.name: dcamera_decoder_budget_test_002
+ * @tc.desc: Verify software streams are admitted by their measured cost within the core budget.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraDecoderBudgetTest, dcamera_decoder_budget_test_002, TestSize.Level1)
+{
+    DCameraDecoderBudget& budget = DCameraDecoderBudget::GetInstance();
+    DCameraDecoderConfig config = oldConfig_;
+    config.softwareCores = 1;
+    budget.SetConfig(config);
+    EXPECT_EQ(-1, budget.AcquireSoftware(TEST_MIME, 0, TEST_HEIGHT, TEST_FPS));
+    int64_t modelCost = budget.GetSoftwareFrameCost(TEST_MIME, TEST_WIDTH, TEST_HEIGHT);
+    EXPECT_GT(modelCost, 0);
+
+    // 10 ms of busy time per frame, a core holds 3 streams at 30 fps
+    for (int32_t i = 0; i < TEST_FRAMES; i++) {
+        budget.AddSoftwareSample(TEST_MIME, TEST_WIDTH, TEST_HEIGHT, TEST_FRAME_WALL_US, TEST_FRAME_BUSY_US);
+    }
+    EXPECT_EQ(TEST_FRAME_BUSY_US, budget.GetSoftwareFrameCost(TEST_MIME, TEST_WIDTH, TEST_HEIGHT));
+    int64_t loads[3] = { 0 };
+    for (int64_t& load : loads) {
+        load = budget.AcquireSoftware(TEST_MIME, TEST_WIDTH, TEST_HEIGHT, TEST_FPS);
+        EXPECT_EQ(TEST_FRAME_BUSY_US * TEST_FPS, load);
+    }
+    EXPECT_EQ(-1, budget.AcquireSoftware(TEST_MIME, TEST_WIDTH, TEST_HEIGHT, TEST_FPS));
+
+    std::string dump;
+    budget.Dump(dump);
+    EXPECT_NE(std::string::npos, dump.find("software: 3 streams, load 90%/100%"));
+    EXPECT_NE(std::string::npos, dump.find(TEST_MIME + "\t1920x1080\t30\t5000\t10000\t100\t3\n"));
+
+    for (int64_t load : loads) {
+        budget.ReleaseSoftware(load);
+    }
+    int64_t load = budget.AcquireSoftware(TEST_MIME, TEST_WIDTH, TEST_HEIGHT, TEST_FPS);
+    EXPECT_GT(load, 0);
+    budget.ReleaseSoftware(load);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
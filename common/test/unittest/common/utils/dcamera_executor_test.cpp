@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <future>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "dcamera_executor.h"
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraExecutorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const int32_t TEST_TASK_NUM = 100;
+const int32_t TEST_FRAME_NUM = 60;
+const int64_t TEST_FRAME_INTERVAL_US = 2000;
+const int64_t TEST_FRAME_WORK_US = 200;
+const int32_t TEST_WAIT_MS = 5000;
+const int32_t TEST_PERCENTILE = 99;
+const int32_t TEST_PERCENT = 100;
+// Loose enough for a loaded single core gate, a strand starved behind the others takes far longer
+const int64_t TEST_P99_BOUND_US = 10000;
+const size_t TEST_CAMERA_NUMS[] = { 1, 4, 8, 16 };
+
+void BusyWait(int64_t us)
+{
+    int64_t endUs = GetNowTimeStampUs() + us;
+    while (GetNowTimeStampUs() < endUs) {
+    }
+}
+
+bool WaitIdle(const std::vector<std::shared_ptr<DCameraStrand>>& strands)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAIT_MS);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (std::all_of(strands.begin(), strands.end(),
+            [](const std::shared_ptr<DCameraStrand>& strand) { return strand->IsIdle(); })) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+}
+
+void DCameraExecutorTest::SetUpTestCase(void)
+{
+}
+
+void DCameraExecutorTest::TearDownTestCase(void)
+{
+}
+
+void DCameraExecutorTest::SetUp(void)
+{
+}
+
+void DCameraExecutorTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: dcamera_executor_test_001
+ * @tc.desc: Verify a strand runs its tasks one at a time in post order and drops them once stopped.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraExecutorTest, dcamera_executor_test_001, TestSize.Level1)
+{
+    std::shared_ptr<DCameraStrand> strand = DCameraExecutor::GetInstance().CreateStrand("test");
+    std::vector<int32_t> order;
+    std::atomic<int32_t> active { 0 };
+    bool overlapped = false;
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_EQ(DCAMERA_OK, strand->Post([&order, &active, &overlapped, i]() {
+            overlapped = overlapped || (active.fetch_add(1) != 0);
+            order.push_back(i);
+            active.fetch_sub(1);
+        }));
+    }
+    EXPECT_TRUE(WaitIdle({ strand }));
+    EXPECT_FALSE(overlapped);
+    ASSERT_EQ(static_cast<size_t>(TEST_TASK_NUM), order.size());
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+
+    // Stop from inside a task must not wait for itself
+    EXPECT_EQ(DCAMERA_OK, strand->Post([strand]() { strand->Stop(); }));
+    EXPECT_TRUE(WaitIdle({ strand }));
+    EXPECT_EQ(DCAMERA_WRONG_STATE, strand->Post([]() {}));
+}
+
+/**
+ * @tc.name: dcamera_executor_test_002
+ * @tc.desc: Verify the post to run latency of N mock cameras sharing the executor stays bounded.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraExecutorTest, dcamera_executor_test_002, TestSize.Level1)
+{
+    DCameraExecutor& executor = DCameraExecutor::GetInstance();
+    for (size_t cameraNum : TEST_CAMERA_NUMS) {
+        std::vector<std::shared_ptr<DCameraStrand>> strands;
+        std::vector<std::vector<int64_t>> latencies(cameraNum);
+        std::mutex threadMutex;
+        std::set<std::thread::id> threads;
+        for (size_t i = 0; i < cameraNum; i++) {
+            strands.push_back(executor.CreateStrand("camera" + std::to_string(i)));
+        }
+        for (int32_t frame = 0; frame < TEST_FRAME_NUM; frame++) {
+            for (size_t i = 0; i < cameraNum; i++) {
+                int64_t postUs = GetNowTimeStampUs();
+                strands[i]->Post([&latencies, &threadMutex, &threads, i, postUs]() {
+                    latencies[i].push_back(GetNowTimeStampUs() - postUs);
+                    {
+                        std::lock_guard<std::mutex> lock(threadMutex);
+                        threads.insert(std::this_thread::get_id());
+                    }
+                    BusyWait(TEST_FRAME_WORK_US);
+                });
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(TEST_FRAME_INTERVAL_US));
+        }
+        EXPECT_TRUE(WaitIdle(strands));
+
+        std::vector<int64_t> all;
+        for (const auto& item : latencies) {
+            EXPECT_EQ(static_cast<size_t>(TEST_FRAME_NUM), item.size());
+            all.insert(all.end(), item.begin(), item.end());
+        }
+        std::sort(all.begin(), all.end());
+        int64_t p99 = all[all.size() * TEST_PERCENTILE / TEST_PERCENT];
+        EXPECT_LE(threads.size(), executor.GetThreadNum());
+        // Only bounded while the frames fit in half of the cores the pool can use
+        size_t coreNum = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), executor.GetThreadNum());
+        if (static_cast<int64_t>(cameraNum) * TEST_FRAME_WORK_US * 2 <= TEST_FRAME_INTERVAL_US *
+            static_cast<int64_t>(coreNum)) {
+            EXPECT_LE(p99, TEST_P99_BOUND_US);
+        }
+        DHLOGI("executor benchmark cameras: %{public}zu, threads used: %{public}zu, pool: %{public}zu, p99 latency: "
+            "%{public}" PRId64 " us", cameraNum, threads.size(), executor.GetThreadNum(), p99);
+    }
+}
+
+/**
+ * @tc.name: dcamera_executor_test_003
+ * @tc.desc: Verify dedicated strands block on their own threads and keep the shared workers free.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraExecutorTest, dcamera_executor_test_003, TestSize.Level1)
+{
+    DCameraExecutor& executor = DCameraExecutor::GetInstance();
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::vector<std::shared_ptr<DCameraStrand>> blockedStrands;
+    for (size_t i = 0; i <= executor.GetThreadNum(); i++) {
+        std::shared_ptr<DCameraStrand> strand = executor.CreateStrand("blocked" + std::to_string(i), true);
+        EXPECT_EQ(DCAMERA_OK, strand->Post([released]() { released.wait(); }));
+        blockedStrands.push_back(strand);
+    }
+
+    std::shared_ptr<DCameraStrand> strand = executor.CreateStrand("shared");
+    std::promise<void> ran;
+    std::future<void> isRan = ran.get_future();
+    EXPECT_EQ(DCAMERA_OK, strand->Post([&ran]() { ran.set_value(); }));
+    EXPECT_EQ(std::future_status::ready, isRan.wait_for(std::chrono::milliseconds(TEST_WAIT_MS)));
+    EXPECT_FALSE(blockedStrands[0]->IsIdle());
+
+    release.set_value();
+    EXPECT_TRUE(WaitIdle(blockedStrands));
+    for (const auto& item : blockedStrands) {
+        item->Stop();
+        EXPECT_EQ(DCAMERA_WRONG_STATE, item->Post([]() {}));
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
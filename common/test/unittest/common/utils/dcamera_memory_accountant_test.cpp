@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dcamera_memory_accountant.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraMemoryAccountantTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    int64_t oldBudget_ = 0;
+};
+
+namespace {
+const int64_t TEST_BUDGET = 1000;
+const size_t TEST_FRAME_BYTES = 100;
+const size_t TEST_MAX_DEPTH = 30;
+}
+
+void DCameraMemoryAccountantTest::SetUpTestCase(void)
+{
+}
+
+void DCameraMemoryAccountantTest::TearDownTestCase(void)
+{
+}
+
+void DCameraMemoryAccountantTest::SetUp(void)
+{
+    oldBudget_ = DCameraMemoryAccountant::GetInstance().GetBudget();
+    DCameraMemoryAccountant::GetInstance().SetBudget(TEST_BUDGET);
+}
+
+void DCameraMemoryAccountantTest::TearDown(void)
+{
+    DCameraMemoryAccountant::GetInstance().SetBudget(oldBudget_);
+}
+
+/**
+ * @tc.name: dcamera_memory_accountant_test_001
+ * @tc.desc: Verify reservations are granted or rejected against the other reservations.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraMemoryAccountantTest, dcamera_memory_accountant_test_001, TestSize.Level1)
+{
+    DCameraMemoryAccountant& accountant = DCameraMemoryAccountant::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, accountant.Reserve("cam_a", 600));
+    EXPECT_EQ(600, accountant.GetUsedBytes());
+    EXPECT_EQ(DCAMERA_ALLOC_ERROR, accountant.Reserve("cam_b", 600));
+    EXPECT_EQ(600, accountant.GetUsedBytes());
+    EXPECT_EQ(DCAMERA_OK, accountant.Reserve("cam_b", 300));
+    EXPECT_EQ(900, accountant.GetUsedBytes());
+    // Reconfiguring an owner replaces its own reservation
+    EXPECT_EQ(DCAMERA_OK, accountant.Reserve("cam_a", 700));
+    EXPECT_EQ(1000, accountant.GetUsedBytes());
+
+    accountant.Unreserve("cam_a");
+    accountant.Unreserve("cam_b");
+    EXPECT_EQ(0, accountant.GetUsedBytes());
+    EXPECT_GE(accountant.GetPeakBytes(), 1000);
+
+    std::string result;
+    accountant.Dump(result);
+    EXPECT_NE(std::string::npos, result.find("cam_a\t0\t0"));
+}
+
+/**
+ * @tc.name: dcamera_memory_accountant_test_002
+ * @tc.desc: Verify queue depth adapts to the remaining budget and queued bytes are given back.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraMemoryAccountantTest, dcamera_memory_accountant_test_002, TestSize.Level1)
+{
+    DCameraMemoryAccountant& accountant = DCameraMemoryAccountant::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, accountant.Reserve("cam_q", 800));
+    std::shared_ptr<DCameraQueueMemory> queue = accountant.RegisterQueue("cam_q", "input");
+    size_t depth = 0;
+    while (queue->CanQueue(depth, TEST_FRAME_BYTES, TEST_MAX_DEPTH)) {
+        queue->Add(TEST_FRAME_BYTES);
+        depth++;
+    }
+    EXPECT_EQ(2u, depth);
+    EXPECT_EQ(1000, accountant.GetUsedBytes());
+
+    // Below the minimum depth a queue keeps working even over budget
+    accountant.SetBudget(0);
+    EXPECT_TRUE(queue->CanQueue(1, TEST_FRAME_BYTES, TEST_MAX_DEPTH));
+    EXPECT_FALSE(queue->CanQueue(depth, TEST_FRAME_BYTES, TEST_MAX_DEPTH));
+
+    queue->Sub(TEST_FRAME_BYTES);
+    EXPECT_EQ(900, accountant.GetUsedBytes());
+    queue = nullptr;
+    EXPECT_EQ(800, accountant.GetUsedBytes());
+    accountant.Unreserve("cam_q");
+}
+
+/**
+ * @tc.name: dcamera_memory_accountant_test_003
+ * @tc.desc: Verify frames queued by other cameras do not decide admission.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraMemoryAccountantTest, dcamera_memory_accountant_test_003, TestSize.Level1)
+{
+    DCameraMemoryAccountant& accountant = DCameraMemoryAccountant::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, accountant.Reserve("cam_a", 500));
+    std::shared_ptr<DCameraQueueMemory> queue = accountant.RegisterQueue("cam_a", "input");
+    queue->Add(TEST_FRAME_BYTES * 4);
+    EXPECT_EQ(900, accountant.GetUsedBytes());
+    EXPECT_EQ(DCAMERA_OK, accountant.Reserve("cam_b", 500));
+    EXPECT_EQ(DCAMERA_ALLOC_ERROR, accountant.Reserve("cam_c", TEST_FRAME_BYTES));
+
+    queue = nullptr;
+    accountant.Unreserve("cam_a");
+    accountant.Unreserve("cam_b");
+    EXPECT_EQ(0, accountant.GetUsedBytes());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
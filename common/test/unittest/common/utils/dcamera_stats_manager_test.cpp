@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dcamera_stats_manager.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraStatsManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void DCameraStatsManagerTest::SetUpTestCase(void)
+{
+}
+
+void DCameraStatsManagerTest::TearDownTestCase(void)
+{
+}
+
+void DCameraStatsManagerTest::SetUp(void)
+{
+}
+
+void DCameraStatsManagerTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: dcamera_stats_manager_test_001
+ * @tc.desc: Verify node counters, queue peaks and drops show up in the dump.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraStatsManagerTest, dcamera_stats_manager_test_001, TestSize.Level1)
+{
+    std::shared_ptr<DCameraNodeStats> stats =
+        DCameraStatsManager::GetInstance().Register("stats_test_001", "decode", { "input", "codec" });
+    stats->AddInput(100);
+    stats->AddInput(100);
+    stats->AddOutput(300);
+    stats->SetQueueDepth(0, 5);
+    stats->SetQueueDepth(0, 2);
+    stats->SetQueueDepth(1, 3);
+    stats->SetQueueDepth(2, 9);
+    stats->SetInFlight(4);
+    stats->AddDrop(DCAMERA_DROP_BUSY);
+    stats->AddDrop(DCAMERA_DROP_EXPIRED, 2);
+    stats->AddDrop(DCAMERA_DROP_REASON_MAX);
+
+    std::string result;
+    DCameraStatsManager::GetInstance().Dump(result);
+    size_t pos = result.find("stats_test_001\tdecode\tin 2 ");
+    ASSERT_NE(std::string::npos, pos);
+    std::string line = result.substr(pos, result.find('\n', pos) - pos);
+    EXPECT_NE(std::string::npos, line.find(" out 1 "));
+    EXPECT_NE(std::string::npos, line.find("inflight 4"));
+    EXPECT_NE(std::string::npos, line.find("input 2/5 codec 3/3"));
+    EXPECT_NE(std::string::npos, line.find("drop busy 1 fps 0 expired 2 smoother 0"));
+}
+
+/**
+ * @tc.name: dcamera_stats_manager_test_002
+ * @tc.desc: Verify released nodes leave the dump and watch can be restarted.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraStatsManagerTest, dcamera_stats_manager_test_002, TestSize.Level1)
+{
+    std::shared_ptr<DCameraNodeStats> stats = DCameraStatsManager::GetInstance().Register("stats_test_002", "scale");
+    std::string result;
+    DCameraStatsManager::GetInstance().Dump(result);
+    EXPECT_NE(std::string::npos, result.find("stats_test_002"));
+    stats = nullptr;
+    result.clear();
+    DCameraStatsManager::GetInstance().Dump(result);
+    EXPECT_EQ(std::string::npos, result.find("stats_test_002"));
+
+    EXPECT_EQ(DCAMERA_OK, DCameraStatsManager::GetInstance().StartWatch());
+    EXPECT_EQ(DCAMERA_OK, DCameraStatsManager::GetInstance().StartWatch());
+    EXPECT_EQ(DCAMERA_OK, DCameraStatsManager::GetInstance().StopWatch());
+    EXPECT_EQ(DCAMERA_OK, DCameraStatsManager::GetInstance().StartWatch());
+    EXPECT_EQ(DCAMERA_OK, DCameraStatsManager::GetInstance().StopWatch());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+#include "dcamera_thread_policy.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraThreadPolicyTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    DCameraThreadConfig oldConfig_;
+};
+
+namespace {
+const DCameraThreadRole TEST_ROLE = DCAMERA_THREAD_SYNC_VIDEO;
+// Raising the nice value needs no privilege
+const int32_t TEST_NICE = 5;
+const int32_t TEST_CHANGED_NICE = 7;
+const int32_t TEST_ITERATIONS = 20;
+}
+
+void DCameraThreadPolicyTest::SetUpTestCase(void)
+{
+}
+
+void DCameraThreadPolicyTest::TearDownTestCase(void)
+{
+}
+
+void DCameraThreadPolicyTest::SetUp(void)
+{
+    oldConfig_ = DCameraThreadPolicy::GetInstance().GetConfig(TEST_ROLE);
+}
+
+void DCameraThreadPolicyTest::TearDown(void)
+{
+    DCameraThreadPolicy::GetInstance().SetConfig(TEST_ROLE, oldConfig_);
+}
+
+/**
+ * @tc.name: dcamera_thread_policy_test_001
+ * @tc.desc: Verify role configs are parsed from the system parameter format.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadPolicyTest, dcamera_thread_policy_test_001, TestSize.Level1)
+{
+    DCameraThreadConfig config;
+    EXPECT_TRUE(DCameraThreadPolicy::ParseConfig("-10,0,0xf0,5", config));
+    EXPECT_EQ(-10, config.nice);
+    EXPECT_EQ(0, config.rtPriority);
+    EXPECT_EQ(0xf0u, config.cpuMask);
+    EXPECT_EQ(5, config.ffrtQos);
+
+    // Trailing fields keep their value
+    EXPECT_TRUE(DCameraThreadPolicy::ParseConfig("0,2", config));
+    EXPECT_EQ(0, config.nice);
+    EXPECT_EQ(2, config.rtPriority);
+    EXPECT_EQ(0xf0u, config.cpuMask);
+
+    EXPECT_FALSE(DCameraThreadPolicy::ParseConfig("", config));
+    EXPECT_FALSE(DCameraThreadPolicy::ParseConfig("1,,3", config));
+    EXPECT_FALSE(DCameraThreadPolicy::ParseConfig("1,2,-3", config));
+    EXPECT_FALSE(DCameraThreadPolicy::ParseConfig("1,2,3,4,5", config));
+    EXPECT_FALSE(DCameraThreadPolicy::ParseConfig("abc", config));
+    EXPECT_EQ(2, config.rtPriority);
+}
+
+/**
+ * @tc.name: dcamera_thread_policy_test_002
+ * @tc.desc: Verify a role policy reaches the calling thread and the wakeup self-test runs under it.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadPolicyTest, dcamera_thread_policy_test_002, TestSize.Level1)
+{
+    DCameraThreadPolicy& policy = DCameraThreadPolicy::GetInstance();
+    DCameraThreadConfig config;
+    config.nice = TEST_NICE;
+    policy.SetConfig(TEST_ROLE, config);
+
+    int32_t ret = DCAMERA_BAD_VALUE;
+    int32_t nice = 0;
+    std::thread worker([&policy, &ret, &nice]() {
+        ret = policy.ApplyToCurrentThread(TEST_ROLE);
+        nice = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    });
+    worker.join();
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(TEST_NICE, nice);
+    EXPECT_EQ(DCAMERA_BAD_VALUE, policy.ApplyToCurrentThread(DCAMERA_THREAD_ROLE_MAX));
+
+    DCameraWakeupResult result;
+    EXPECT_EQ(DCAMERA_OK, policy.RunWakeupTest(TEST_ROLE, TEST_ITERATIONS, result));
+    EXPECT_GE(result.avgUs, 0);
+    EXPECT_GE(result.maxUs, result.p99Us);
+    EXPECT_EQ(DCAMERA_BAD_VALUE, policy.RunWakeupTest(TEST_ROLE, 0, result));
+
+    std::string dump;
+    policy.Dump(dump, false);
+    EXPECT_NE(std::string::npos, dump.find(DCameraThreadPolicy::GetRoleName(TEST_ROLE) + "\t5\t0\t0x0"));
+}
+
+/**
+ * @tc.name: dcamera_thread_policy_test_003
+ * @tc.desc: Verify a policy change puts an applied thread back on SCHED_OTHER with the new nice value.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadPolicyTest, dcamera_thread_policy_test_003, TestSize.Level1)
+{
+    DCameraThreadPolicy& policy = DCameraThreadPolicy::GetInstance();
+    DCameraThreadConfig config;
+    config.nice = TEST_NICE;
+    policy.SetConfig(TEST_ROLE, config);
+
+    int32_t ret = DCAMERA_BAD_VALUE;
+    int32_t nice = 0;
+    int32_t schedPolicy = -1;
+    std::thread worker([&policy, &config, &ret, &nice, &schedPolicy]() {
+        policy.ApplyToCurrentThread(TEST_ROLE);
+        config.nice = TEST_CHANGED_NICE;
+        policy.SetConfig(TEST_ROLE, config);
+        ret = policy.ApplyToCurrentThread(TEST_ROLE);
+        nice = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+        schedPolicy = sched_getscheduler(0);
+    });
+    worker.join();
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(TEST_CHANGED_NICE, nice);
+    EXPECT_EQ(SCHED_OTHER, schedPolicy);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -25,6 +25,7 @@
 #include <functional>
 
 #include "data_buffer.h"
+#include "dcamera_network_emulator.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -54,6 +55,7 @@ struct FaultInjectionStats {
     uint64_t packetsDropped;
     uint64_t packetsDelayed;
     uint64_t packetsCorrupted;
+    uint64_t packetsReordered;
     uint64_t memoryLeakSimulations;
     uint64_t threadBlockSimulations;
     uint64_t resourceExhaustionSimulations;
@@ -74,6 +76,20 @@ public:
     // 注入故障到數據包
     std::shared_ptr<DataBuffer> InjectFault(const std::shared_ptr<DataBuffer>& originalBuffer);
 
+    // 設置網絡模擬配置（限速、突發丟包、亂序、抖動）
+    void SetNetworkEmulationProfile(const NetworkEmulationProfile& profile);
+
+    // 網絡模擬是否生效
+    bool IsNetworkEmulationEnabled() const;
+
+    // 經網絡模擬發送一個包，deliver 在計劃送達時間於時間輪線程上調用，不阻塞調用方
+    // 未生效時返回 false 且不調用 deliver，由調用方直接發送
+    bool EmulateTransmit(uint32_t packetSize, std::function<void()> deliver);
+
+    // 獲取/導出每個包的命運記錄
+    std::vector<PacketFateRecord> GetPacketFates() const;
+    bool DumpPacketFates(const std::string& filePath) const;
+
     // 模擬記憶體洩漏
     void SimulateMemoryLeak(size_t leakSize = 1024);
 
@@ -110,6 +126,8 @@ private:
 
     std::random_device rd_;
     std::mt19937 gen_;
+
+    DCameraNetworkEmulator networkEmulator_;
 };
 
 } // namespace DistributedHardware
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_NETWORK_EMULATOR_H
+#define OHOS_DCAMERA_NETWORK_EMULATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dcamera_timer_wheel.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+
+// 抖動分佈
+enum class JitterDistribution {
+    NONE = 0,       // 無抖動
+    UNIFORM = 1,    // 均勻分佈 [-jitterMs, jitterMs]
+    NORMAL = 2,     // 正態分佈，標準差為 jitterMs
+    PARETO = 3      // 帕累托分佈（長尾），尺度為 jitterMs
+};
+
+// 網絡模擬配置
+struct NetworkEmulationProfile {
+    bool enabled = false;              // 是否啟用
+    uint32_t seed = 1;                 // 隨機種子，相同種子與發包序列得到相同結果
+
+    // 令牌桶限速
+    uint64_t bandwidthBps = 0;         // 帶寬（bit/s），0 表示不限速
+    uint32_t bucketBytes = 64 * 1024;  // 桶容量（允許的突發字節數）
+    uint32_t queueLimitMs = 200;       // 排隊時延上限，超出則尾丟棄
+
+    // Gilbert-Elliott 兩狀態丟包
+    float goodToBadProbability = 0.0f; // 每包 GOOD -> BAD 的轉移概率
+    float badToGoodProbability = 1.0f; // 每包 BAD -> GOOD 的轉移概率
+    float goodLossProbability = 0.0f;  // GOOD 狀態下的丟包率
+    float badLossProbability = 1.0f;   // BAD 狀態下的丟包率
+
+    // 時延與抖動
+    uint32_t baseDelayMs = 0;          // 固定傳播時延
+    uint32_t jitterMs = 0;             // 抖動幅度
+    JitterDistribution jitterDistribution = JitterDistribution::NONE;
+
+    // 亂序
+    float reorderProbability = 0.0f;   // 被後續包超越的概率
+    uint32_t reorderDelayMs = 0;       // 亂序包額外滯後的時間（亂序窗口）
+};
+
+// 每個包的命運
+enum class PacketFate {
+    DELIVERED = 0,      // 按序送達
+    REORDERED = 1,      // 送達但被後續包超越
+    LOST = 2,           // Gilbert-Elliott 丟包
+    QUEUE_DROPPED = 3   // 限速隊列溢出丟包
+};
+
+struct PacketFateRecord {
+    uint64_t sequence;     // 提交順序
+    uint32_t size;         // 包大小（字節）
+    int64_t sendUs;        // 提交時間，相對模擬開始
+    int64_t deliverUs;     // 計劃送達時間，相對模擬開始，丟包為 -1
+    PacketFate fate;
+    bool badState;         // 提交時 Gilbert-Elliott 是否處於 BAD 狀態
+};
+
+/**
+ * 網絡損傷模擬器
+ * 每個包依次經過令牌桶限速、Gilbert-Elliott 丟包、時延抖動與亂序，
+ * 計算出送達時間後交給時間輪投遞，發送方不會被阻塞。
+ * 所有隨機決策只取決於種子和包序列，每個包消耗固定數量的隨機數。
+ */
+class DCameraNetworkEmulator {
+public:
+    using DeliverCallback = std::function<void()>;
+    // 返回微秒時間，限速與排隊丟包都按它計算
+    using Clock = std::function<int64_t()>;
+
+    DCameraNetworkEmulator();
+    ~DCameraNetworkEmulator();
+
+    // 設置配置並重置狀態與記錄，enabled 為 false 時停止模擬
+    void SetProfile(const NetworkEmulationProfile& profile);
+    NetworkEmulationProfile GetProfile() const;
+    bool IsEnabled() const;
+
+    // 提交一個包，送達時在時間輪線程上調用 deliver；未啟用時返回 false，且不會調用 deliver
+    bool Submit(uint32_t packetSize, DeliverCallback deliver, PacketFate& fate);
+
+    // 停止模擬，未送達的包被丟棄
+    void Stop();
+
+    // 替換時鐘，測試中用假時鐘讓排隊丟包的決策與牆上時間無關；在 SetProfile 之前設置
+    void SetClock(Clock clock);
+
+    std::vector<PacketFateRecord> GetPacketFates() const;
+    // 以 CSV 格式導出每個包的命運，用於對比多次運行
+    bool DumpPacketFates(const std::string& filePath) const;
+
+private:
+    void ResetState();
+    bool UpdateLossState(double transitionDraw);
+    int64_t ShapeBandwidth(int64_t nowUs, uint32_t packetSize);
+    int64_t SampleJitterUs(double firstDraw, double secondDraw) const;
+    void AddFateRecord(const PacketFateRecord& record);
+
+    // 串行化 SetProfile/Stop 對時間輪的啟停，停止時會等待投遞線程退出，不能持有 emulatorMutex_
+    std::mutex controlMutex_;
+    mutable std::mutex emulatorMutex_;
+    NetworkEmulationProfile profile_;
+    Clock clock_;
+    DCameraTimerWheel timerWheel_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+
+    int64_t startUs_ = 0;
+    bool badState_ = false;
+    double tokens_ = 0.0;
+    int64_t lastRefillUs_ = 0;
+    int64_t lastDepartureUs_ = 0;
+    int64_t lastDeliverUs_ = 0;
+    uint64_t nextSequence_ = 0;
+    std::vector<PacketFateRecord> fates_;
+};
+
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // OHOS_DCAMERA_NETWORK_EMULATOR_H
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_TIMER_WHEEL_H
+#define OHOS_DCAMERA_TIMER_WHEEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace DistributedHardware {
+
+// 單層時間輪：按 tick 推進，超出一圈的任務留在槽內等待後續輪次
+class DCameraTimerWheel {
+public:
+    using Task = std::function<void()>;
+
+    DCameraTimerWheel(uint32_t tickUs = 1000, uint32_t slotNum = 512);
+    ~DCameraTimerWheel();
+
+    // 啟動/停止調度線程，停止時丟棄未到期的任務
+    void Start();
+    void Stop();
+    bool IsRunning() const;
+
+    // 當前時間（微秒，steady clock）
+    static int64_t NowUs();
+
+    // 在絕對時間 expireUs 執行任務；同一 tick 內按 expireUs、再按提交順序執行
+    void ScheduleAt(int64_t expireUs, Task task);
+
+    // 尚未執行的任務數
+    size_t PendingCount() const;
+
+private:
+    struct TimerEntry {
+        int64_t expireUs;
+        int64_t tick;
+        uint64_t order;
+        Task task;
+    };
+
+    void Run();
+    void CollectExpired(int64_t tick, std::vector<TimerEntry>& expired);
+
+    const uint32_t tickUs_;
+    const uint32_t slotMask_;
+    std::vector<std::vector<TimerEntry>> slots_;
+
+    mutable std::mutex wheelMutex_;
+    std::condition_variable wheelCond_;
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    int64_t currentTick_ = 0;
+    uint64_t nextOrder_ = 0;
+    size_t pendingCount_ = 0;
+};
+
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // OHOS_DCAMERA_TIMER_WHEEL_H
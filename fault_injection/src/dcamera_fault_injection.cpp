@@ -17,6 +17,8 @@
 #include "distributed_hardware_log.h"
 
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <thread>
 #include <vector>
 
@@ -30,6 +32,7 @@ DCameraFaultInjection::DCameraFaultInjection() : gen_(rd_())
     stats_.packetsDropped = 0;
     stats_.packetsDelayed = 0;
     stats_.packetsCorrupted = 0;
+    stats_.packetsReordered = 0;
     stats_.memoryLeakSimulations = 0;
     stats_.threadBlockSimulations = 0;
     stats_.resourceExhaustionSimulations = 0;
@@ -104,6 +107,43 @@ std::shared_ptr<DataBuffer> DCameraFaultInjection::InjectFault(const std::shared
     return currentBuffer;
 }
 
+void DCameraFaultInjection::SetNetworkEmulationProfile(const NetworkEmulationProfile& profile)
+{
+    networkEmulator_.SetProfile(profile);
+}
+
+bool DCameraFaultInjection::IsNetworkEmulationEnabled() const
+{
+    return enabled_.load() && networkEmulator_.IsEnabled();
+}
+
+bool DCameraFaultInjection::EmulateTransmit(uint32_t packetSize, std::function<void()> deliver)
+{
+    PacketFate fate = PacketFate::DELIVERED;
+    if (!enabled_.load() || !networkEmulator_.Submit(packetSize, std::move(deliver), fate)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.totalPacketsProcessed++;
+    if (fate == PacketFate::LOST || fate == PacketFate::QUEUE_DROPPED) {
+        stats_.packetsDropped++;
+    } else if (fate == PacketFate::REORDERED) {
+        stats_.packetsReordered++;
+    }
+    return true;
+}
+
+std::vector<PacketFateRecord> DCameraFaultInjection::GetPacketFates() const
+{
+    return networkEmulator_.GetPacketFates();
+}
+
+bool DCameraFaultInjection::DumpPacketFates(const std::string& filePath) const
+{
+    return networkEmulator_.DumpPacketFates(filePath);
+}
+
 void DCameraFaultInjection::SimulateMemoryLeak(size_t leakSize)
 {
     if (!enabled_.load()) {
@@ -158,7 +198,7 @@ void DCameraFaultInjection::Enable(bool enabled)
     DHLOGI("Fault injection %s", enabled ? "enabled" : "disabled");
 }
 
-DCameraFaultInjection::FaultInjectionStats DCameraFaultInjection::GetStatistics() const
+FaultInjectionStats DCameraFaultInjection::GetStatistics() const
 {
     std::lock_guard<std::mutex> lock(statsMutex_);
     return stats_;
@@ -171,6 +211,7 @@ void DCameraFaultInjection::ResetStatistics()
     stats_.packetsDropped = 0;
     stats_.packetsDelayed = 0;
     stats_.packetsCorrupted = 0;
+    stats_.packetsReordered = 0;
     stats_.memoryLeakSimulations = 0;
     stats_.threadBlockSimulations = 0;
     stats_.resourceExhaustionSimulations = 0;
@@ -207,7 +248,7 @@ std::shared_ptr<DataBuffer> DCameraFaultInjection::InjectFormatCorruption(const
     }
 
     // 隨機損壞一些字節
-    uint8_t* data = corruptedBuffer->GetMutableData();
+    uint8_t* data = corruptedBuffer->Data();
     size_t size = corruptedBuffer->Size();
 
     // 損壞前幾個字節（通常是協議頭）
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_network_emulator.h"
+#include "distributed_hardware_log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+namespace OHOS {
+namespace DistributedHardware {
+
+namespace {
+constexpr int64_t US_PER_MS = 1000;
+constexpr double US_PER_SECOND = 1000000.0;
+constexpr double BITS_PER_BYTE = 8.0;
+constexpr double PARETO_SHAPE = 2.5;
+constexpr double TWO_PI = 6.283185307179586;
+// 記錄上限，約 32MB，長時間運行時超出部分不再記錄
+constexpr size_t MAX_FATE_RECORDS = 1 << 20;
+
+const char* PacketFateToString(PacketFate fate)
+{
+    switch (fate) {
+        case PacketFate::DELIVERED:
+            return "DELIVERED";
+        case PacketFate::REORDERED:
+            return "REORDERED";
+        case PacketFate::LOST:
+            return "LOST";
+        case PacketFate::QUEUE_DROPPED:
+            return "QUEUE_DROPPED";
+        default:
+            return "UNKNOWN";
+    }
+}
+}
+
+DCameraNetworkEmulator::DCameraNetworkEmulator() : clock_(&DCameraTimerWheel::NowUs)
+{
+    ResetState();
+}
+
+DCameraNetworkEmulator::~DCameraNetworkEmulator()
+{
+    Stop();
+}
+
+void DCameraNetworkEmulator::SetProfile(const NetworkEmulationProfile& profile)
+{
+    std::lock_guard<std::mutex> controlLock(controlMutex_);
+    if (profile.enabled) {
+        // 先啟動時間輪再開放提交，啟用後提交的包都能被調度
+        timerWheel_.Start();
+    }
+    {
+        std::lock_guard<std::mutex> lock(emulatorMutex_);
+        profile_ = profile;
+        ResetState();
+    }
+    // 投遞回調會取發送方的鎖，而發送方持鎖提交時要取 emulatorMutex_，所以等待投遞線程退出時不能持有它
+    if (!profile.enabled) {
+        timerWheel_.Stop();
+    }
+    DHLOGI("Set network emulation, enabled: %s, seed: %u, bandwidth: %" PRIu64 " bps, delay: %u ms, jitter: %u ms",
+           profile.enabled ? "true" : "false", profile.seed, profile.bandwidthBps, profile.baseDelayMs,
+           profile.jitterMs);
+}
+
+NetworkEmulationProfile DCameraNetworkEmulator::GetProfile() const
+{
+    std::lock_guard<std::mutex> lock(emulatorMutex_);
+    return profile_;
+}
+
+bool DCameraNetworkEmulator::IsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(emulatorMutex_);
+    return profile_.enabled;
+}
+
+void DCameraNetworkEmulator::Stop()
+{
+    std::lock_guard<std::mutex> controlLock(controlMutex_);
+    {
+        std::lock_guard<std::mutex> lock(emulatorMutex_);
+        profile_.enabled = false;
+    }
+    timerWheel_.Stop();
+}
+
+void DCameraNetworkEmulator::SetClock(Clock clock)
+{
+    std::lock_guard<std::mutex> lock(emulatorMutex_);
+    clock_ = clock ? std::move(clock) : Clock(&DCameraTimerWheel::NowUs);
+    ResetState();
+}
+
+void DCameraNetworkEmulator::ResetState()
+{
+    gen_.seed(profile_.seed);
+    uniform_.reset();
+    startUs_ = clock_();
+    badState_ = false;
+    tokens_ = profile_.bucketBytes;
+    lastRefillUs_ = startUs_;
+    lastDepartureUs_ = startUs_;
+    lastDeliverUs_ = startUs_;
+    nextSequence_ = 0;
+    fates_.clear();
+}
+
+bool DCameraNetworkEmulator::Submit(uint32_t packetSize, DeliverCallback deliver, PacketFate& fate)
+{
+    std::lock_guard<std::mutex> lock(emulatorMutex_);
+    if (!profile_.enabled) {
+        return false;
+    }
+
+    // 每個包固定消耗 5 個隨機數，保證同一種子下的決策序列與包序列一一對應
+    double transitionDraw = uniform_(gen_);
+    double lossDraw = uniform_(gen_);
+    double jitterFirstDraw = uniform_(gen_);
+    double jitterSecondDraw = uniform_(gen_);
+    double reorderDraw = uniform_(gen_);
+
+    int64_t nowUs = clock_();
+    PacketFateRecord record = { nextSequence_++, packetSize, nowUs - startUs_, -1, PacketFate::DELIVERED,
+        UpdateLossState(transitionDraw) };
+
+    int64_t departureUs = ShapeBandwidth(nowUs, packetSize);
+    if (departureUs < 0) {
+        fate = record.fate = PacketFate::QUEUE_DROPPED;
+        AddFateRecord(record);
+        return true;
+    }
+    float lossProbability = record.badState ? profile_.badLossProbability : profile_.goodLossProbability;
+    if (lossDraw < lossProbability) {
+        fate = record.fate = PacketFate::LOST;
+        AddFateRecord(record);
+        return true;
+    }
+
+    int64_t deliverUs = departureUs + std::max<int64_t>(0,
+        profile_.baseDelayMs * US_PER_MS + SampleJitterUs(jitterFirstDraw, jitterSecondDraw));
+    if (reorderDraw < profile_.reorderProbability) {
+        // 亂序包額外滯後，不影響後續包的送達順序
+        deliverUs += profile_.reorderDelayMs * US_PER_MS;
+        record.fate = PacketFate::REORDERED;
+    } else {
+        // 鏈路先進先出，抖動不會讓正常包互相超越
+        deliverUs = std::max(deliverUs, lastDeliverUs_);
+        lastDeliverUs_ = deliverUs;
+    }
+    record.deliverUs = deliverUs - startUs_;
+    AddFateRecord(record);
+    // 時間輪按真實時間推進，只換算延遲，時鐘被替換時也在相同的延遲後投遞
+    timerWheel_.ScheduleAt(DCameraTimerWheel::NowUs() + (deliverUs - nowUs), std::move(deliver));
+    fate = record.fate;
+    return true;
+}
+
+bool DCameraNetworkEmulator::UpdateLossState(double transitionDraw)
+{
+    if (badState_) {
+        badState_ = !(transitionDraw < profile_.badToGoodProbability);
+    } else {
+        badState_ = transitionDraw < profile_.goodToBadProbability;
+    }
+    return badState_;
+}
+
+int64_t DCameraNetworkEmulator::ShapeBandwidth(int64_t nowUs, uint32_t packetSize)
+{
+    if (profile_.bandwidthBps == 0) {
+        return nowUs;
+    }
+    double bytesPerUs = static_cast<double>(profile_.bandwidthBps) / BITS_PER_BYTE / US_PER_SECOND;
+    // 令牌桶按發送順序出隊，包不能早於前一個包離開
+    int64_t startUs = std::max(nowUs, lastDepartureUs_);
+    double tokens = std::min(static_cast<double>(profile_.bucketBytes),
+        tokens_ + static_cast<double>(startUs - lastRefillUs_) * bytesPerUs);
+    int64_t departureUs = startUs;
+    if (tokens < packetSize) {
+        departureUs += static_cast<int64_t>(std::ceil((packetSize - tokens) / bytesPerUs));
+        tokens = 0.0;
+    } else {
+        tokens -= packetSize;
+    }
+    if (departureUs - nowUs > static_cast<int64_t>(profile_.queueLimitMs) * US_PER_MS) {
+        return -1;
+    }
+    tokens_ = tokens;
+    lastRefillUs_ = departureUs;
+    lastDepartureUs_ = departureUs;
+    return departureUs;
+}
+
+int64_t DCameraNetworkEmulator::SampleJitterUs(double firstDraw, double secondDraw) const
+{
+    double jitterUs = static_cast<double>(profile_.jitterMs) * US_PER_MS;
+    switch (profile_.jitterDistribution) {
+        case JitterDistribution::UNIFORM:
+            return static_cast<int64_t>((firstDraw * 2.0 - 1.0) * jitterUs);
+        case JitterDistribution::NORMAL:
+            // Box-Muller，固定消耗兩個均勻隨機數
+            return static_cast<int64_t>(std::sqrt(-2.0 * std::log(1.0 - firstDraw)) *
+                std::cos(TWO_PI * secondDraw) * jitterUs);
+        case JitterDistribution::PARETO:
+            return static_cast<int64_t>(jitterUs / std::pow(1.0 - firstDraw, 1.0 / PARETO_SHAPE) - jitterUs);
+        default:
+            return 0;
+    }
+}
+
+void DCameraNetworkEmulator::AddFateRecord(const PacketFateRecord& record)
+{
+    if (fates_.size() >= MAX_FATE_RECORDS) {
+        return;
+    }
+    fates_.push_back(record);
+    if (fates_.size() == MAX_FATE_RECORDS) {
+        DHLOGW("Packet fate records reach limit %zu, stop recording", MAX_FATE_RECORDS);
+    }
+}
+
+std::vector<PacketFateRecord> DCameraNetworkEmulator::GetPacketFates() const
+{
+    std::lock_guard<std::mutex> lock(emulatorMutex_);
+    return fates_;
+}
+
+bool DCameraNetworkEmulator::DumpPacketFates(const std::string& filePath) const
+{
+    std::lock_guard<std::mutex> lock(emulatorMutex_);
+    FILE* file = fopen(filePath.c_str(), "w");
+    if (file == nullptr) {
+        DHLOGE("Open packet fate file %s failed", filePath.c_str());
+        return false;
+    }
+    fprintf(file, "sequence,size,sendUs,deliverUs,fate,badState\n");
+    for (const auto& record : fates_) {
+        fprintf(file, "%" PRIu64 ",%u,%" PRId64 ",%" PRId64 ",%s,%d\n", record.sequence, record.size,
+            record.sendUs, record.deliverUs, PacketFateToString(record.fate), record.badState ? 1 : 0);
+    }
+    fclose(file);
+    DHLOGI("Dump %zu packet fates to %s", fates_.size(), filePath.c_str());
+    return true;
+}
+
+} // namespace DistributedHardware
+} // namespace OHOS
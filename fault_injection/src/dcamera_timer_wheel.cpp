@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_timer_wheel.h"
+#include "distributed_hardware_log.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace OHOS {
+namespace DistributedHardware {
+
+namespace {
+uint32_t RoundUpPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+}
+
+DCameraTimerWheel::DCameraTimerWheel(uint32_t tickUs, uint32_t slotNum)
+    : tickUs_(tickUs == 0 ? 1 : tickUs), slotMask_(RoundUpPowerOfTwo(slotNum == 0 ? 1 : slotNum) - 1),
+      slots_(slotMask_ + 1)
+{
+}
+
+DCameraTimerWheel::~DCameraTimerWheel()
+{
+    Stop();
+}
+
+void DCameraTimerWheel::Start()
+{
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+    if (running_.load()) {
+        return;
+    }
+    currentTick_ = NowUs() / tickUs_;
+    running_.store(true);
+    worker_ = std::thread(&DCameraTimerWheel::Run, this);
+    DHLOGI("Timer wheel started, tick: %u us, slots: %u", tickUs_, slotMask_ + 1);
+}
+
+void DCameraTimerWheel::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(wheelMutex_);
+        if (!running_.load()) {
+            return;
+        }
+        running_.store(false);
+    }
+    wheelCond_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+    for (auto& slot : slots_) {
+        slot.clear();
+    }
+    DHLOGI("Timer wheel stopped, dropped %zu pending tasks", pendingCount_);
+    pendingCount_ = 0;
+}
+
+bool DCameraTimerWheel::IsRunning() const
+{
+    return running_.load();
+}
+
+int64_t DCameraTimerWheel::NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void DCameraTimerWheel::ScheduleAt(int64_t expireUs, Task task)
+{
+    if (!task) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wheelMutex_);
+        if (!running_.load()) {
+            return;
+        }
+        if (pendingCount_ == 0) {
+            // 空閒期間 currentTick_ 不推進，先對齊到當前時間
+            currentTick_ = std::max(currentTick_, NowUs() / tickUs_);
+        }
+        // 已過期的任務放入當前槽，下一次推進即執行
+        int64_t tick = std::max(expireUs / tickUs_, currentTick_);
+        slots_[static_cast<size_t>(tick) & slotMask_].push_back({ expireUs, tick, nextOrder_++, std::move(task) });
+        pendingCount_++;
+    }
+    wheelCond_.notify_one();
+}
+
+size_t DCameraTimerWheel::PendingCount() const
+{
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+    return pendingCount_;
+}
+
+void DCameraTimerWheel::CollectExpired(int64_t tick, std::vector<TimerEntry>& expired)
+{
+    auto& slot = slots_[static_cast<size_t>(tick) & slotMask_];
+    auto it = std::partition(slot.begin(), slot.end(), [tick](const TimerEntry& entry) {
+        return entry.tick > tick;
+    });
+    for (auto expiredIt = it; expiredIt != slot.end(); ++expiredIt) {
+        expired.push_back(std::move(*expiredIt));
+    }
+    pendingCount_ -= static_cast<size_t>(slot.end() - it);
+    slot.erase(it, slot.end());
+}
+
+void DCameraTimerWheel::Run()
+{
+    std::vector<TimerEntry> expired;
+    std::unique_lock<std::mutex> lock(wheelMutex_);
+    while (running_.load()) {
+        if (pendingCount_ == 0) {
+            wheelCond_.wait(lock, [this] { return !running_.load() || pendingCount_ > 0; });
+            continue;
+        }
+        int64_t nowTick = NowUs() / tickUs_;
+        if (currentTick_ > nowTick) {
+            wheelCond_.wait_until(lock, std::chrono::steady_clock::time_point(
+                std::chrono::microseconds(currentTick_ * tickUs_)));
+            continue;
+        }
+        for (; currentTick_ <= nowTick && pendingCount_ > 0; currentTick_++) {
+            CollectExpired(currentTick_, expired);
+        }
+        if (expired.empty()) {
+            continue;
+        }
+        std::sort(expired.begin(), expired.end(), [](const TimerEntry& lhs, const TimerEntry& rhs) {
+            return lhs.expireUs != rhs.expireUs ? lhs.expireUs < rhs.expireUs : lhs.order < rhs.order;
+        });
+        lock.unlock();
+        for (auto& entry : expired) {
+            entry.task();
+        }
+        expired.clear();
+        lock.lock();
+    }
+}
+
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "dcamera_network_emulator.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraNetworkEmulatorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    std::vector<PacketFateRecord> RunLossyProfile(uint32_t seed);
+
+    int64_t fakeNowUs_ = 0;
+};
+
+namespace {
+const uint32_t TEST_PACKET_SIZE = 1000;
+const uint32_t TEST_PACKET_NUM = 200;
+const uint64_t TEST_BANDWIDTH_BPS = 8000;
+const uint32_t TEST_QUEUE_LIMIT_MS = 100;
+const int64_t TEST_FRAME_INTERVAL_US = 33000;
+const int64_t TEST_ONE_SECOND_US = 1000000;
+const int64_t TEST_START_US = 5000000;
+}
+
+void DCameraNetworkEmulatorTest::SetUpTestCase(void)
+{
+}
+
+void DCameraNetworkEmulatorTest::TearDownTestCase(void)
+{
+}
+
+void DCameraNetworkEmulatorTest::SetUp(void)
+{
+    fakeNowUs_ = TEST_START_US;
+}
+
+void DCameraNetworkEmulatorTest::TearDown(void)
+{
+}
+
+std::vector<PacketFateRecord> DCameraNetworkEmulatorTest::RunLossyProfile(uint32_t seed)
+{
+    fakeNowUs_ = TEST_START_US;
+    DCameraNetworkEmulator emulator;
+    emulator.SetClock([this]() { return fakeNowUs_; });
+    NetworkEmulationProfile profile;
+    profile.enabled = true;
+    profile.seed = seed;
+    profile.goodToBadProbability = 0.1f;
+    profile.badToGoodProbability = 0.3f;
+    profile.goodLossProbability = 0.02f;
+    profile.badLossProbability = 0.5f;
+    profile.jitterMs = 5;
+    profile.jitterDistribution = JitterDistribution::NORMAL;
+    emulator.SetProfile(profile);
+    for (uint32_t i = 0; i < TEST_PACKET_NUM; i++) {
+        PacketFate fate;
+        emulator.Submit(TEST_PACKET_SIZE, nullptr, fate);
+        fakeNowUs_ += TEST_FRAME_INTERVAL_US;
+    }
+    std::vector<PacketFateRecord> fates = emulator.GetPacketFates();
+    emulator.Stop();
+    return fates;
+}
+
+/**
+ * @tc.name: dcamera_network_emulator_test_001
+ * @tc.desc: Verify one seed and one clock give the same fate for every packet.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraNetworkEmulatorTest, dcamera_network_emulator_test_001, TestSize.Level1)
+{
+    std::vector<PacketFateRecord> first = RunLossyProfile(1);
+    std::vector<PacketFateRecord> second = RunLossyProfile(1);
+    std::vector<PacketFateRecord> other = RunLossyProfile(2);
+    ASSERT_EQ(TEST_PACKET_NUM, first.size());
+    ASSERT_EQ(first.size(), second.size());
+    ASSERT_EQ(first.size(), other.size());
+    size_t lostNum = 0;
+    size_t diffNum = 0;
+    for (size_t i = 0; i < first.size(); i++) {
+        EXPECT_EQ(first[i].fate, second[i].fate);
+        EXPECT_EQ(first[i].sendUs, second[i].sendUs);
+        EXPECT_EQ(first[i].deliverUs, second[i].deliverUs);
+        lostNum += (first[i].fate == PacketFate::LOST) ? 1 : 0;
+        diffNum += (first[i].fate != other[i].fate || first[i].deliverUs != other[i].deliverUs) ? 1 : 0;
+    }
+    EXPECT_GT(lostNum, 0);
+    EXPECT_LT(lostNum, first.size());
+    EXPECT_GT(diffNum, 0);
+}
+
+/**
+ * @tc.name: dcamera_network_emulator_test_002
+ * @tc.desc: Verify the token bucket drops by the injected clock, not by wall time.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraNetworkEmulatorTest, dcamera_network_emulator_test_002, TestSize.Level1)
+{
+    DCameraNetworkEmulator emulator;
+    emulator.SetClock([this]() { return fakeNowUs_; });
+    NetworkEmulationProfile profile;
+    profile.enabled = true;
+    profile.bandwidthBps = TEST_BANDWIDTH_BPS;
+    profile.bucketBytes = TEST_PACKET_SIZE;
+    profile.queueLimitMs = TEST_QUEUE_LIMIT_MS;
+    emulator.SetProfile(profile);
+
+    // The bucket holds one packet, the next needs a full second at 1000 bytes/s
+    PacketFate fate;
+    EXPECT_TRUE(emulator.Submit(TEST_PACKET_SIZE, nullptr, fate));
+    EXPECT_EQ(PacketFate::DELIVERED, fate);
+    EXPECT_TRUE(emulator.Submit(TEST_PACKET_SIZE, nullptr, fate));
+    EXPECT_EQ(PacketFate::QUEUE_DROPPED, fate);
+    fakeNowUs_ += TEST_ONE_SECOND_US;
+    EXPECT_TRUE(emulator.Submit(TEST_PACKET_SIZE, nullptr, fate));
+    EXPECT_EQ(PacketFate::DELIVERED, fate);
+
+    std::vector<PacketFateRecord> fates = emulator.GetPacketFates();
+    ASSERT_EQ(3, fates.size());
+    EXPECT_EQ(0, fates[0].sendUs);
+    EXPECT_EQ(-1, fates[1].deliverUs);
+    EXPECT_EQ(TEST_ONE_SECOND_US, fates[2].sendUs);
+
+    emulator.Stop();
+    EXPECT_FALSE(emulator.Submit(TEST_PACKET_SIZE, nullptr, fate));
+}
+
+/**
+ * @tc.name: dcamera_network_emulator_test_003
+ * @tc.desc: Verify Stop does not deadlock with a sender that holds the lock its delivery needs.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraNetworkEmulatorTest, dcamera_network_emulator_test_003, TestSize.Level1)
+{
+    DCameraNetworkEmulator emulator;
+    NetworkEmulationProfile profile;
+    profile.enabled = true;
+    emulator.SetProfile(profile);
+
+    // senderMutex plays the socket lock the mock holds while it submits and takes again to deliver
+    std::mutex senderMutex;
+    std::mutex stateMutex;
+    std::condition_variable stateCond;
+    bool isDelivering = false;
+    std::atomic<int32_t> deliverNum = 0;
+    std::unique_lock<std::mutex> senderLock(senderMutex);
+    PacketFate fate;
+    EXPECT_TRUE(emulator.Submit(TEST_PACKET_SIZE, [&]() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            isDelivering = true;
+        }
+        stateCond.notify_all();
+        std::lock_guard<std::mutex> lock(senderMutex);
+        deliverNum++;
+    }, fate));
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        stateCond.wait(lock, [&]() { return isDelivering; });
+    }
+    std::thread stopThread([&emulator]() { emulator.Stop(); });
+    // Submitting while Stop waits for the blocked delivery must return instead of waiting on Stop
+    emulator.Submit(TEST_PACKET_SIZE, nullptr, fate);
+    senderLock.unlock();
+    stopThread.join();
+    EXPECT_EQ(1, deliverNum.load());
+    EXPECT_FALSE(emulator.IsEnabled());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * dcamera_logscan: 無界面的 DHLOG 日誌掃描工具
+ *
+ * 用法:
+ *   dcamera_logscan [-j threads] [--clock-offset-us N] [--index-out file] [--from time] [--to time]
+ *                   <sink.log> [source.log]
+ *
+ * 只給一個文件時，sink 與 source 的日誌視為寫在同一個文件中（本地測試環境）。
+ * --from/--to 的時間格式與日誌行首一致（"MM-DD HH:MM:SS.mmm" 或 "HH:MM:SS"），
+ * 掃描前按時間索引定位窗口所在的字節範圍，只掃描這一段。
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logscanner.h"
+
+namespace {
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+constexpr double MS_PER_SECOND = 1000.0;
+
+struct ScanOptions {
+    unsigned threadNum = 0;
+    int64_t clockOffsetUs = 0;
+    int64_t fromUs = std::numeric_limits<int64_t>::min();
+    int64_t toUs = std::numeric_limits<int64_t>::max();
+    std::string indexOut;
+    std::vector<std::string> files;
+};
+
+void printUsage(const char* prog)
+{
+    fprintf(stderr, "Usage: %s [-j threads] [--clock-offset-us N] [--index-out file] [--from time] [--to time]"
+        " <sink.log> [source.log]\n"
+        "  -j                 number of scan threads, default is hardware concurrency\n"
+        "  --clock-offset-us  source clock minus sink clock, applied to cross-device latency\n"
+        "  --index-out        write the time index (timeUs offset) of every scanned file\n"
+        "  --from, --to       only scan the lines logged in this window, in the log time format\n"
+        "                     (\"MM-DD HH:MM:SS.mmm\" or \"HH:MM:SS\"), located through the time index\n", prog);
+}
+
+bool parseTime(const char* arg, int64_t& timeUs)
+{
+    return LogScanner::parseTimestamp(arg, arg + strlen(arg), timeUs);
+}
+
+bool parseArgs(int argc, char* argv[], ScanOptions& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            options.threadNum = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--clock-offset-us" && i + 1 < argc) {
+            options.clockOffsetUs = strtoll(argv[++i], nullptr, 10);
+        } else if (arg == "--index-out" && i + 1 < argc) {
+            options.indexOut = argv[++i];
+        } else if (arg == "--from" && i + 1 < argc) {
+            if (!parseTime(argv[++i], options.fromUs)) {
+                return false;
+            }
+        } else if (arg == "--to" && i + 1 < argc) {
+            if (!parseTime(argv[++i], options.toUs)) {
+                return false;
+            }
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    if (options.threadNum == 0) {
+        options.threadNum = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return !options.files.empty() && options.files.size() <= 2 && options.fromUs <= options.toUs;
+}
+
+bool scanFile(const std::string& path, const ScanOptions& options, ScanResult& result)
+{
+    LogScanner scanner;
+    if (!scanner.open(path)) {
+        fprintf(stderr, "open %s failed\n", path.c_str());
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    result = scanner.scan(options.threadNum, options.fromUs, options.toUs);
+    double costMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double sizeMb = static_cast<double>(result.fileSize) / BYTES_PER_MB;
+    double scannedMb = static_cast<double>(result.scannedBytes) / BYTES_PER_MB;
+    printf("%s: %.1f MB, scanned %.1f MB, %" PRIu64 " lines, %u threads, %.1f ms (%.0f MB/s)\n", path.c_str(),
+        sizeMb, scannedMb, result.totalLines, options.threadNum, costMs,
+        costMs > 0 ? scannedMb * MS_PER_SECOND / costMs : 0.0);
+    printf("  events: encode %zu, send %zu, recv %zu, decode %zu, feed %zu, time index %zu\n",
+        result.events[static_cast<size_t>(FrameStage::ENCODE)].size(),
+        result.events[static_cast<size_t>(FrameStage::SEND)].size(),
+        result.events[static_cast<size_t>(FrameStage::RECV)].size(),
+        result.events[static_cast<size_t>(FrameStage::DECODE)].size(),
+        result.events[static_cast<size_t>(FrameStage::FEED)].size(), result.timeIndex.size());
+    return true;
+}
+
+void writeIndex(FILE* out, const std::string& path, const ScanResult& result)
+{
+    fprintf(out, "# %s\n", path.c_str());
+    for (const auto& entry : result.timeIndex) {
+        fprintf(out, "%" PRId64 " %" PRIu64 "\n", entry.timeUs, entry.offset);
+    }
+}
+}
+
+int main(int argc, char* argv[])
+{
+    ScanOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<ScanResult> results(options.files.size());
+    for (size_t i = 0; i < options.files.size(); i++) {
+        if (!scanFile(options.files[i], options, results[i])) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!options.indexOut.empty()) {
+        FILE* out = fopen(options.indexOut.c_str(), "w");
+        if (out == nullptr) {
+            fprintf(stderr, "open %s failed\n", options.indexOut.c_str());
+            return EXIT_FAILURE;
+        }
+        for (size_t i = 0; i < options.files.size(); i++) {
+            writeIndex(out, options.files[i], results[i]);
+        }
+        fclose(out);
+    }
+
+    FrameLatencyJoiner joiner;
+    joiner.addSinkResult(results.front());
+    joiner.addSourceResult(results.back());
+    std::vector<LatencyStats> allStats = joiner.compute(options.clockOffsetUs);
+    printf("frames: %zu\n", joiner.frameCount());
+    printf("%-14s %10s %10s %10s %10s %10s\n", "latency(us)", "count", "p50", "p90", "p99", "max");
+    for (const auto& stats : allStats) {
+        printf("%-14s %10zu %10" PRId64 " %10" PRId64 " %10" PRId64 " %10" PRId64 "\n", stats.name.c_str(),
+            stats.count, stats.p50, stats.p90, stats.p99, stats.max);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logscanner.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+const char VIDEO_PTS_KEY[] = "videoPts=";
+const char SMOOTH_KEY[] = "OnSmoothFinished rawTime: ";
+const char SEND_PREFIX[] = "send ";
+const char GET_PREFIX[] = "get ";
+const char FROM_SOFTBUS[] = " from softbus";
+const char FROM_DECODER[] = " from decoder";
+const char FROM_ENCODER[] = " from encoder";
+const char TO_SOFTBUS[] = " to softbus";
+
+// 時間戳只會出現在行首，限制查找範圍避免誤匹配消息體
+constexpr size_t TIMESTAMP_SEARCH_LEN = 48;
+constexpr size_t TIME_INDEX_STEP = 1024 * 1024;
+constexpr size_t MIN_CHUNK_SIZE = 4 * 1024 * 1024;
+constexpr int64_t US_PER_SECOND = 1000000;
+constexpr int64_t SECONDS_PER_MINUTE = 60;
+constexpr int64_t MINUTES_PER_HOUR = 60;
+constexpr int64_t HOURS_PER_DAY = 24;
+constexpr int64_t DAYS_PER_MONTH = 31;
+constexpr int32_t PERCENT_50 = 50;
+constexpr int32_t PERCENT_90 = 90;
+constexpr int32_t PERCENT_99 = 99;
+constexpr int32_t PERCENT_100 = 100;
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline int32_t twoDigits(const char* p)
+{
+    return (p[0] - '0') * 10 + (p[1] - '0');
+}
+
+inline bool hasPrefixBefore(const char* lineBegin, const char* match, const char* prefix, size_t prefixLen)
+{
+    return static_cast<size_t>(match - lineBegin) >= prefixLen && memcmp(match - prefixLen, prefix, prefixLen) == 0;
+}
+
+inline bool hasSuffix(const char* pos, const char* lineEnd, const char* suffix, size_t suffixLen)
+{
+    return static_cast<size_t>(lineEnd - pos) >= suffixLen && memcmp(pos, suffix, suffixLen) == 0;
+}
+
+bool parseInt64(const char*& pos, const char* end, int64_t& value)
+{
+    bool negative = false;
+    if (pos < end && *pos == '-') {
+        negative = true;
+        pos++;
+    }
+    const char* start = pos;
+    int64_t result = 0;
+    while (pos < end && isDigit(*pos)) {
+        result = result * 10 + (*pos - '0');
+        pos++;
+    }
+    if (pos == start) {
+        return false;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+int64_t percentile(std::vector<int64_t>& values, int32_t percent)
+{
+    size_t pos = (values.size() - 1) * static_cast<size_t>(percent) / PERCENT_100;
+    std::nth_element(values.begin(), values.begin() + pos, values.end());
+    return values[pos];
+}
+}
+
+LogScanner::~LogScanner()
+{
+    close();
+}
+
+bool LogScanner::open(const std::string& filePath)
+{
+    close();
+    fd_ = ::open(filePath.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || st.st_size <= 0) {
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (addr == MAP_FAILED) {
+        size_ = 0;
+        close();
+        return false;
+    }
+    // 順序掃描，提示內核預讀
+    madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(addr);
+    return true;
+}
+
+void LogScanner::close()
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+ScanResult LogScanner::scan(unsigned threadNum, int64_t fromUs, int64_t toUs) const
+{
+    ScanResult merged;
+    merged.fileSize = size_;
+    if (data_ == nullptr) {
+        return merged;
+    }
+
+    size_t rangeBegin = 0;
+    size_t rangeEnd = size_;
+    const bool hasWindow = fromUs != std::numeric_limits<int64_t>::min() ||
+        toUs != std::numeric_limits<int64_t>::max();
+    if (hasWindow) {
+        // 索引每 MiB 只讀一行，建立索引只觸及很少的頁
+        buildTimeIndex(0, size_, merged);
+        seekWindow(merged.timeIndex, fromUs, toUs, rangeBegin, rangeEnd);
+    }
+    merged.scannedBytes = rangeEnd - rangeBegin;
+
+    // 匹配表只構建一次，由所有線程只讀共享
+    const std::vector<Matcher> matchers = {
+        { VIDEO_PTS_KEY, sizeof(VIDEO_PTS_KEY) - 1, true },
+        { SMOOTH_KEY, sizeof(SMOOTH_KEY) - 1, false },
+    };
+
+    size_t rangeSize = rangeEnd - rangeBegin;
+    size_t maxChunks = std::max<size_t>(1, rangeSize / MIN_CHUNK_SIZE);
+    size_t chunkNum = std::min<size_t>(std::max(1u, threadNum), maxChunks);
+    std::vector<size_t> bounds;
+    bounds.push_back(rangeBegin);
+    for (size_t i = 1; i < chunkNum; i++) {
+        size_t pos = std::max(rangeBegin + rangeSize * i / chunkNum, bounds.back());
+        const void* nl = memchr(data_ + pos, '\n', rangeEnd - pos);
+        size_t next = (nl == nullptr) ? rangeEnd : static_cast<size_t>(static_cast<const char*>(nl) - data_) + 1;
+        bounds.push_back(next);
+    }
+    bounds.push_back(rangeEnd);
+
+    std::vector<ScanResult> partial(bounds.size() - 1);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i + 1 < bounds.size(); i++) {
+        workers.emplace_back([this, &bounds, &matchers, &partial, i]() {
+            scanChunk(bounds[i], bounds[i + 1], matchers, partial[i]);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // 各塊按文件順序合併，時間索引保持有序
+    for (auto& part : partial) {
+        merged.totalLines += part.totalLines;
+        for (size_t stage = 0; stage < FRAME_STAGE_NUM; stage++) {
+            merged.events[stage].insert(merged.events[stage].end(), part.events[stage].begin(),
+                part.events[stage].end());
+        }
+        if (!hasWindow) {
+            merged.timeIndex.insert(merged.timeIndex.end(), part.timeIndex.begin(), part.timeIndex.end());
+        }
+    }
+    if (hasWindow) {
+        // 索引粒度為 MiB，範圍兩端的行可能在窗口外
+        for (auto& events : merged.events) {
+            events.erase(std::remove_if(events.begin(), events.end(), [fromUs, toUs](const FrameEvent& event) {
+                return event.timeUs < fromUs || event.timeUs > toUs;
+            }), events.end());
+        }
+    }
+    return merged;
+}
+
+void LogScanner::seekWindow(const std::vector<TimeIndexEntry>& timeIndex, int64_t fromUs, int64_t toUs,
+    size_t& begin, size_t& end) const
+{
+    // 日誌按時間順序寫入，索引按時間有序
+    auto first = std::partition_point(timeIndex.begin(), timeIndex.end(),
+        [fromUs](const TimeIndexEntry& entry) { return entry.timeUs < fromUs; });
+    // 前一個索引點之後的行可能已在窗口內
+    begin = (first == timeIndex.begin()) ? 0 : static_cast<size_t>(std::prev(first)->offset);
+    auto last = std::partition_point(first, timeIndex.end(),
+        [toUs](const TimeIndexEntry& entry) { return entry.timeUs <= toUs; });
+    end = (last == timeIndex.end()) ? size_ : static_cast<size_t>(last->offset);
+}
+
+void LogScanner::scanChunk(size_t begin, size_t end, const std::vector<Matcher>& matchers,
+    ScanResult& result) const
+{
+    result.totalLines = static_cast<uint64_t>(std::count(data_ + begin, data_ + end, '\n'));
+    if (end > begin && data_[end - 1] != '\n') {
+        result.totalLines++;
+    }
+    for (const auto& matcher : matchers) {
+        scanNeedle(begin, end, matcher, result);
+    }
+    buildTimeIndex(begin, end, result);
+}
+
+void LogScanner::scanNeedle(size_t begin, size_t end, const Matcher& matcher, ScanResult& result) const
+{
+    // 直接在整塊內查找關鍵字，不命中的行不做任何解析
+    const char* pos = data_ + begin;
+    const char* chunkEnd = data_ + end;
+    while (pos < chunkEnd) {
+        const void* found = memmem(pos, static_cast<size_t>(chunkEnd - pos), matcher.needle, matcher.needleLen);
+        if (found == nullptr) {
+            break;
+        }
+        const char* match = static_cast<const char*>(found);
+        const char* lineBegin = match;
+        while (lineBegin > data_ + begin && lineBegin[-1] != '\n') {
+            lineBegin--;
+        }
+        const void* nl = memchr(match, '\n', static_cast<size_t>(chunkEnd - match));
+        const char* lineEnd = (nl == nullptr) ? chunkEnd : static_cast<const char*>(nl);
+        if (matcher.isVideoPts) {
+            classifyVideoPts(lineBegin, match, lineEnd, result);
+        } else {
+            classifySmooth(lineBegin, match, lineEnd, result);
+        }
+        pos = lineEnd;
+    }
+}
+
+void LogScanner::buildTimeIndex(size_t begin, size_t end, ScanResult& result) const
+{
+    // 每 TIME_INDEX_STEP 字節記錄一個 (時間, 偏移)，用於按時間定位大文件
+    for (size_t offset = begin; offset < end; offset += TIME_INDEX_STEP) {
+        const char* lineBegin = data_ + offset;
+        if (offset != begin) {
+            const void* nl = memchr(lineBegin, '\n', end - offset);
+            if (nl == nullptr) {
+                break;
+            }
+            lineBegin = static_cast<const char*>(nl) + 1;
+        }
+        const char* chunkEnd = data_ + end;
+        if (lineBegin >= chunkEnd) {
+            break;
+        }
+        const void* nl = memchr(lineBegin, '\n', static_cast<size_t>(chunkEnd - lineBegin));
+        const char* lineEnd = (nl == nullptr) ? chunkEnd : static_cast<const char*>(nl);
+        int64_t timeUs = 0;
+        if (parseTimestamp(lineBegin, lineEnd, timeUs)) {
+            result.timeIndex.push_back({ timeUs, static_cast<uint64_t>(lineBegin - data_) });
+        }
+    }
+}
+
+void LogScanner::classifyVideoPts(const char* lineBegin, const char* match, const char* lineEnd,
+    ScanResult& result) const
+{
+    const char* pos = match + sizeof(VIDEO_PTS_KEY) - 1;
+    int64_t pts = 0;
+    if (!parseInt64(pos, lineEnd, pts)) {
+        return;
+    }
+    FrameStage stage;
+    if (hasPrefixBefore(lineBegin, match, SEND_PREFIX, sizeof(SEND_PREFIX) - 1)) {
+        if (!hasSuffix(pos, lineEnd, TO_SOFTBUS, sizeof(TO_SOFTBUS) - 1)) {
+            return;
+        }
+        stage = FrameStage::SEND;
+    } else if (hasPrefixBefore(lineBegin, match, GET_PREFIX, sizeof(GET_PREFIX) - 1)) {
+        if (hasSuffix(pos, lineEnd, FROM_SOFTBUS, sizeof(FROM_SOFTBUS) - 1)) {
+            stage = FrameStage::RECV;
+        } else if (hasSuffix(pos, lineEnd, FROM_DECODER, sizeof(FROM_DECODER) - 1)) {
+            stage = FrameStage::DECODE;
+        } else if (hasSuffix(pos, lineEnd, FROM_ENCODER, sizeof(FROM_ENCODER) - 1)) {
+            stage = FrameStage::ENCODE;
+        } else {
+            return;
+        }
+    } else {
+        return;
+    }
+    int64_t timeUs = 0;
+    if (!parseTimestamp(lineBegin, lineEnd, timeUs)) {
+        return;
+    }
+    result.events[static_cast<size_t>(stage)].push_back({ pts, timeUs });
+}
+
+void LogScanner::classifySmooth(const char* lineBegin, const char* match, const char* lineEnd,
+    ScanResult& result) const
+{
+    const char* pos = match + sizeof(SMOOTH_KEY) - 1;
+    int64_t pts = 0;
+    int64_t timeUs = 0;
+    if (!parseInt64(pos, lineEnd, pts) || !parseTimestamp(lineBegin, lineEnd, timeUs)) {
+        return;
+    }
+    result.events[static_cast<size_t>(FrameStage::FEED)].push_back({ pts, timeUs });
+}
+
+bool LogScanner::parseTimestamp(const char* line, const char* lineEnd, int64_t& timeUs)
+{
+    const char* searchEnd = std::min(lineEnd, line + TIMESTAMP_SEARCH_LEN);
+    // 查找 "HH:MM:SS"
+    const char* p = line;
+    for (; p + 8 <= searchEnd; p++) {
+        if (isDigit(p[0]) && isDigit(p[1]) && p[2] == ':' && isDigit(p[3]) && isDigit(p[4]) && p[5] == ':' &&
+            isDigit(p[6]) && isDigit(p[7])) {
+            break;
+        }
+    }
+    if (p + 8 > searchEnd) {
+        return false;
+    }
+    int64_t day = 0;
+    // 前面緊跟 "MM-DD " 時把日期計入，保證跨天的日誌仍然單調
+    if (p - line >= 6 && isDigit(p[-6]) && isDigit(p[-5]) && p[-4] == '-' && isDigit(p[-3]) && isDigit(p[-2])) {
+        day = twoDigits(p - 6) * DAYS_PER_MONTH + twoDigits(p - 3);
+    }
+    int64_t seconds = ((day * HOURS_PER_DAY + twoDigits(p)) * MINUTES_PER_HOUR + twoDigits(p + 3)) *
+        SECONDS_PER_MINUTE + twoDigits(p + 6);
+    int64_t fracUs = 0;
+    const char* frac = p + 8;
+    if (frac < lineEnd && *frac == '.') {
+        frac++;
+        int64_t scale = US_PER_SECOND;
+        while (frac < lineEnd && isDigit(*frac) && scale > 1) {
+            scale /= 10;
+            fracUs += (*frac - '0') * scale;
+            frac++;
+        }
+    }
+    timeUs = seconds * US_PER_SECOND + fracUs;
+    return true;
+}
+
+void FrameLatencyJoiner::addEvents(const ScanResult& result, FrameStage stage)
+{
+    const size_t idx = static_cast<size_t>(stage);
+    for (const auto& event : result.events[idx]) {
+        auto iter = frames_.find(event.pts);
+        if (iter == frames_.end()) {
+            std::array<int64_t, FRAME_STAGE_NUM> stages;
+            stages.fill(-1);
+            iter = frames_.emplace(event.pts, stages).first;
+        }
+        // 同一 pts 多次出現時保留第一次
+        if (iter->second[idx] < 0) {
+            iter->second[idx] = event.timeUs;
+        }
+    }
+}
+
+void FrameLatencyJoiner::addSinkResult(const ScanResult& result)
+{
+    addEvents(result, FrameStage::ENCODE);
+    addEvents(result, FrameStage::SEND);
+}
+
+void FrameLatencyJoiner::addSourceResult(const ScanResult& result)
+{
+    addEvents(result, FrameStage::RECV);
+    addEvents(result, FrameStage::DECODE);
+    addEvents(result, FrameStage::FEED);
+}
+
+LatencyStats FrameLatencyJoiner::makeStats(const std::string& name, std::vector<int64_t>& values)
+{
+    LatencyStats stats;
+    stats.name = name;
+    stats.count = values.size();
+    if (values.empty()) {
+        return stats;
+    }
+    stats.p50 = percentile(values, PERCENT_50);
+    stats.p90 = percentile(values, PERCENT_90);
+    stats.p99 = percentile(values, PERCENT_99);
+    stats.max = *std::max_element(values.begin(), values.end());
+    return stats;
+}
+
+std::vector<LatencyStats> FrameLatencyJoiner::compute(int64_t clockOffsetUs) const
+{
+    struct Segment {
+        const char* name;
+        FrameStage from;
+        FrameStage to;
+        bool crossDevice;
+    };
+    const Segment segments[] = {
+        { "encode->send", FrameStage::ENCODE, FrameStage::SEND, false },
+        { "send->recv", FrameStage::SEND, FrameStage::RECV, true },
+        { "recv->decode", FrameStage::RECV, FrameStage::DECODE, false },
+        { "decode->feed", FrameStage::DECODE, FrameStage::FEED, false },
+        { "send->feed", FrameStage::SEND, FrameStage::FEED, true },
+    };
+    std::vector<LatencyStats> allStats;
+    for (const auto& segment : segments) {
+        std::vector<int64_t> values;
+        values.reserve(frames_.size());
+        for (const auto& frame : frames_) {
+            int64_t from = frame.second[static_cast<size_t>(segment.from)];
+            int64_t to = frame.second[static_cast<size_t>(segment.to)];
+            if (from < 0 || to < 0) {
+                continue;
+            }
+            values.push_back(to - from - (segment.crossDevice ? clockOffsetUs : 0));
+        }
+        allStats.push_back(makeStats(segment.name, values));
+    }
+    return allStats;
+}
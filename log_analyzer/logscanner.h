@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOGSCANNER_H
+#define LOGSCANNER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 每幀在日誌中可追蹤的處理階段，按 pts 關聯
+enum class FrameStage : uint32_t {
+    ENCODE = 0,     // sink: get videoPts=... from encoder
+    SEND,           // sink: send videoPts=... to softbus
+    RECV,           // source: get videoPts=... from softbus
+    DECODE,         // source: get videoPts=... from decoder
+    FEED,           // source: OnSmoothFinished rawTime: ...
+    STAGE_COUNT,
+};
+
+constexpr size_t FRAME_STAGE_NUM = static_cast<size_t>(FrameStage::STAGE_COUNT);
+
+struct FrameEvent {
+    int64_t pts;
+    int64_t timeUs;
+};
+
+struct TimeIndexEntry {
+    int64_t timeUs;
+    uint64_t offset;
+};
+
+struct ScanResult {
+    uint64_t fileSize = 0;
+    uint64_t scannedBytes = 0;
+    uint64_t totalLines = 0;
+    std::array<std::vector<FrameEvent>, FRAME_STAGE_NUM> events;
+    std::vector<TimeIndexEntry> timeIndex;
+};
+
+struct LatencyStats {
+    std::string name;
+    size_t count = 0;
+    int64_t p50 = 0;
+    int64_t p90 = 0;
+    int64_t p99 = 0;
+    int64_t max = 0;
+};
+
+/**
+ * DHLOG 日誌離線掃描器
+ * 以 mmap 映射整個日誌文件，按行邊界切分為多個塊並行掃描，
+ * 只對命中關鍵字的行解析時間戳，同時為文件建立按時間的索引。
+ */
+class LogScanner {
+public:
+    LogScanner() = default;
+    ~LogScanner();
+
+    // 映射日誌文件
+    bool open(const std::string& filePath);
+
+    // 解除映射
+    void close();
+
+    // 使用 threadNum 個線程並行掃描 [fromUs, toUs] 時間窗口內的日誌，缺省掃描整個文件
+    // 給定窗口時先建立時間索引，只映射窗口所在的字節範圍，窗口外的事件被丟棄
+    ScanResult scan(unsigned threadNum, int64_t fromUs = std::numeric_limits<int64_t>::min(),
+        int64_t toUs = std::numeric_limits<int64_t>::max()) const;
+
+    // 解析行首時間戳，支持 hilog 的 "MM-DD HH:MM:SS.mmm" 與 "[YYYY-MM-DD HH:MM:SS]" 格式
+    static bool parseTimestamp(const char* line, const char* lineEnd, int64_t& timeUs);
+
+private:
+    struct Matcher {
+        const char* needle;
+        size_t needleLen;
+        bool isVideoPts;
+    };
+
+    void scanChunk(size_t begin, size_t end, const std::vector<Matcher>& matchers, ScanResult& result) const;
+    void scanNeedle(size_t begin, size_t end, const Matcher& matcher, ScanResult& result) const;
+    void buildTimeIndex(size_t begin, size_t end, ScanResult& result) const;
+    void seekWindow(const std::vector<TimeIndexEntry>& timeIndex, int64_t fromUs, int64_t toUs,
+        size_t& begin, size_t& end) const;
+    void classifyVideoPts(const char* lineBegin, const char* match, const char* lineEnd,
+        ScanResult& result) const;
+    void classifySmooth(const char* lineBegin, const char* match, const char* lineEnd, ScanResult& result) const;
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    int fd_ = -1;
+};
+
+/**
+ * 跨 sink/source 日誌按 pts 關聯每一幀的各階段時間，輸出各段延遲分位數。
+ * clockOffsetUs 為 source 時鐘減去 sink 時鐘的差值，用於修正跨設備的時間。
+ */
+class FrameLatencyJoiner {
+public:
+    void addSinkResult(const ScanResult& result);
+    void addSourceResult(const ScanResult& result);
+    std::vector<LatencyStats> compute(int64_t clockOffsetUs) const;
+    size_t frameCount() const { return frames_.size(); }
+
+private:
+    void addEvents(const ScanResult& result, FrameStage stage);
+    static LatencyStats makeStats(const std::string& name, std::vector<int64_t>& values);
+
+    std::unordered_map<int64_t, std::array<int64_t, FRAME_STAGE_NUM>> frames_;
+};
+
+#endif // LOGSCANNER_H
@@ -22,9 +22,12 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <thread>
 #include <vector>
 
+#include "dcamera_fault_injection.h"
+
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
@@ -162,6 +165,9 @@ public:
     const Statistics& GetStatistics() const;
     void ResetStatistics();
 
+    // 设置故障注入，启用网络模拟后发送数据经时间轮延后投递，为空时直接发送
+    void SetFaultInjection(std::shared_ptr<DCameraFaultInjection> faultInjection);
+
 private:
     SoftbusMock();
     ~SoftbusMock();
@@ -184,6 +190,9 @@ private:
 
     // 数据收发处理
     int32_t SendDataPacket(int32_t socket, const void* data, uint32_t len, uint32_t dataType);
+    int32_t SendStreamPacket(int32_t socket, const StreamPacketHeader& header, const void* data, uint32_t len);
+    bool EmulateDataPacket(int32_t socket, const void* data, uint32_t len, uint32_t dataType);
+    bool EmulateStreamPacket(int32_t socket, const StreamPacketHeader& header, const void* data, uint32_t len);
     int32_t ReceiveDataPacket(int32_t socket, std::vector<uint8_t>& buffer);
     void DispatchData(int32_t socket, const std::vector<uint8_t>& data);
 
@@ -227,6 +236,9 @@ private:
     Statistics statistics_;
     std::mutex statsMutex_;
 
+    // 故障注入（网络模拟），受socketMutex_保护
+    std::shared_ptr<DCameraFaultInjection> faultInjection_;
+
     // 端口管理
     std::mutex portMutex_;
     std::set<uint16_t> usedPorts_;
@@ -318,6 +318,9 @@ int32_t SoftbusMock::SendBytes(int32_t socket, const void* data, uint32_t len) {
         return -1;
     }
 
+    if (EmulateDataPacket(socket, data, len, 1)) {
+        return len;
+    }
     return SendDataPacket(socket, data, len, 1);  // dataType = 1 for Bytes
 }
 
@@ -340,6 +343,9 @@ int32_t SoftbusMock::SendMessage(int32_t socket, const void* data, uint32_t len)
         return -1;
     }
 
+    if (EmulateDataPacket(socket, data, len, 0)) {
+        return len;
+    }
     return SendDataPacket(socket, data, len, 0);  // dataType = 0 for Message
 }
 
@@ -384,41 +390,10 @@ int32_t SoftbusMock::SendStream(int32_t socket, const StreamData* data, const St
         streamHeader.base.checksum = CalculateChecksum(data->buf, data->bufLen);
     }
 
-    // 发送流包头
-    int bytesSent = send(socketInfo->tcpSocket,
-                         reinterpret_cast<const char*>(&streamHeader),
-                         sizeof(StreamPacketHeader), 0);
-
-    if (bytesSent != sizeof(StreamPacketHeader)) {
-        DHLOGE("Failed to send stream header");
-        {
-            std::lock_guard<std::mutex> statsLock(statsMutex_);
-            statistics_.sendErrors++;
-        }
-        return -1;
-    }
-
-    // 发送流数据
-    if (data && data->buf && data->bufLen > 0) {
-        bytesSent = send(socketInfo->tcpSocket, data->buf, data->bufLen, 0);
-        if (bytesSent != data->bufLen) {
-            DHLOGE("Failed to send stream data");
-            {
-                std::lock_guard<std::mutex> statsLock(statsMutex_);
-                statistics_.sendErrors++;
-            }
-            return -1;
-        }
-    }
-
-    // 更新统计信息
-    {
-        std::lock_guard<std::mutex> statsLock(statsMutex_);
-        statistics_.totalBytesSent += sizeof(StreamPacketHeader) + (data ? data->bufLen : 0);
-        statistics_.totalPacketsSent++;
+    if (EmulateStreamPacket(socket, streamHeader, data->buf, data->bufLen)) {
+        return 0;
     }
-
-    return 0;
+    return SendStreamPacket(socket, streamHeader, data->buf, data->bufLen);
 }
 
 void SoftbusMock::Shutdown(int32_t socket) {
@@ -522,6 +497,11 @@ void SoftbusMock::ResetStatistics() {
     std::memset(&statistics_, 0, sizeof(Statistics));
 }
 
+void SoftbusMock::SetFaultInjection(std::shared_ptr<DCameraFaultInjection> faultInjection) {
+    std::lock_guard<std::mutex> lock(socketMutex_);
+    faultInjection_ = faultInjection;
+}
+
 // 私有方法实现
 
 int32_t SoftbusMock::GenerateSocketId() {
@@ -725,6 +705,84 @@ int32_t SoftbusMock::SendDataPacket(int32_t socket, const void* data, uint32_t l
     return len;
 }
 
+int32_t SoftbusMock::SendStreamPacket(int32_t socket, const StreamPacketHeader& header, const void* data,
+                                      uint32_t len) {
+    auto socketInfo = sockets_[socket];
+
+    // 发送流包头
+    int bytesSent = send(socketInfo->tcpSocket,
+                         reinterpret_cast<const char*>(&header),
+                         sizeof(StreamPacketHeader), 0);
+
+    if (bytesSent != sizeof(StreamPacketHeader)) {
+        DHLOGE("Failed to send stream header");
+        {
+            std::lock_guard<std::mutex> statsLock(statsMutex_);
+            statistics_.sendErrors++;
+        }
+        return -1;
+    }
+
+    // 发送流数据
+    if (data && len > 0) {
+        bytesSent = send(socketInfo->tcpSocket, static_cast<const char*>(data), len, 0);
+        if (bytesSent != len) {
+            DHLOGE("Failed to send stream data");
+            {
+                std::lock_guard<std::mutex> statsLock(statsMutex_);
+                statistics_.sendErrors++;
+            }
+            return -1;
+        }
+    }
+
+    // 更新统计信息
+    {
+        std::lock_guard<std::mutex> statsLock(statsMutex_);
+        statistics_.totalBytesSent += sizeof(StreamPacketHeader) + len;
+        statistics_.totalPacketsSent++;
+    }
+
+    return 0;
+}
+
+bool SoftbusMock::EmulateDataPacket(int32_t socket, const void* data, uint32_t len, uint32_t dataType) {
+    if (faultInjection_ == nullptr || !faultInjection_->IsNetworkEmulationEnabled()) {
+        return false;
+    }
+    // 调用方的数据在返回后失效，先拷贝再交给时间轮
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    auto payload = std::make_shared<std::vector<uint8_t>>(bytes, bytes + len);
+    return faultInjection_->EmulateTransmit(sizeof(DataPacketHeader) + len, [this, socket, payload, dataType]() {
+        std::lock_guard<std::mutex> lock(socketMutex_);
+        if (!IsSocketIdValid(socket)) {
+            DHLOGW("Socket %d closed before emulated delivery", socket);
+            return;
+        }
+        SendDataPacket(socket, payload->data(), static_cast<uint32_t>(payload->size()), dataType);
+    });
+}
+
+bool SoftbusMock::EmulateStreamPacket(int32_t socket, const StreamPacketHeader& header, const void* data,
+                                      uint32_t len) {
+    if (faultInjection_ == nullptr || !faultInjection_->IsNetworkEmulationEnabled()) {
+        return false;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    auto payload = std::make_shared<std::vector<uint8_t>>();
+    if (bytes != nullptr) {
+        payload->assign(bytes, bytes + len);
+    }
+    return faultInjection_->EmulateTransmit(sizeof(StreamPacketHeader) + len, [this, socket, header, payload]() {
+        std::lock_guard<std::mutex> lock(socketMutex_);
+        if (!IsSocketIdValid(socket)) {
+            DHLOGW("Socket %d closed before emulated delivery", socket);
+            return;
+        }
+        SendStreamPacket(socket, header, payload->data(), static_cast<uint32_t>(payload->size()));
+    });
+}
+
 int32_t SoftbusMock::ReceiveDataPacket(int32_t socket, std::vector<uint8_t>& buffer) {
     auto socketInfo = sockets_[socket];
 
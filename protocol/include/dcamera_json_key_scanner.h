@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_JSON_KEY_SCANNER_H
+#define OHOS_DCAMERA_JSON_KEY_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace OHOS {
+namespace DistributedHardware {
+
+// 指向原始數據的字符串片段，不持有內存
+struct DCameraStringRef {
+    const char* data = nullptr;
+    size_t length = 0;
+
+    bool Empty() const
+    {
+        return length == 0;
+    }
+
+    bool Equals(const char* str, size_t len) const
+    {
+        return length == len && (len == 0 || memcmp(data, str, len) == 0);
+    }
+
+    std::string ToString() const
+    {
+        return (data == nullptr) ? std::string() : std::string(data, length);
+    }
+};
+
+// 待提取的頂層字段
+struct DCameraJsonKey {
+    const char* name;
+    size_t length;
+};
+
+/**
+ * 流式 JSON 鍵掃描器
+ * 只遍歷頂層對象，提取指定鍵的字符串值，不構建 DOM、不分配內存。
+ * 始終掃描到對象結尾，截斷、括號不匹配、非法字面量或尾部多餘數據均視為格式錯誤。
+ * 返回的值為引號內的原始內容，不處理轉義。
+ */
+class DCameraJsonKeyScanner {
+public:
+    // values[i] 對應 keys[i]，未出現或不是字符串的鍵保持為空；格式錯誤時返回 false
+    static bool Scan(const char* data, size_t size, const DCameraJsonKey* keys, size_t keyNum,
+        DCameraStringRef* values);
+
+private:
+    static const char* SkipWhitespace(const char* pos, const char* end);
+    static const char* ScanString(const char* pos, const char* end, DCameraStringRef& value);
+    static const char* SkipValue(const char* pos, const char* end);
+    static const char* SkipLiteral(const char* pos, const char* end);
+};
+
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // OHOS_DCAMERA_JSON_KEY_SCANNER_H
@@ -24,6 +24,7 @@
 #include <functional>
 
 #include "data_buffer.h"
+#include "dcamera_json_key_scanner.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -80,9 +81,13 @@ public:
     // 啟用/禁用嗅探器
     void Enable(bool enabled);
 
+    // 設置採樣間隔，每 sampleInterval 個包校驗一個，0 和 1 表示全部校驗
+    void SetSamplingInterval(uint32_t sampleInterval);
+
     // 獲取統計信息
     struct Statistics {
         uint64_t totalPackets;
+        uint64_t sampledPackets;
         uint64_t validPackets;
         uint64_t invalidPackets;
         uint64_t consistencyErrors;
@@ -93,20 +98,37 @@ public:
     Statistics GetStatistics() const;
 
 private:
-    // 解析DCameraCmdPack
-    bool ParseDCameraCmdPack(const std::shared_ptr<DataBuffer>& buffer, DCameraCmdPack& pack);
+    // 從數據包中提取的字段，指向原始數據
+    struct DCameraCmdFields {
+        DCameraStringRef type;
+        DCameraStringRef dhId;
+        DCameraStringRef command;
+        DCameraStringRef version;
+    };
+
+    // 校驗一個數據包，未被採樣時直接返回 true
+    bool MonitorPacket(const std::shared_ptr<DataBuffer>& buffer, const char* direction);
+
+    // 是否校驗當前包
+    bool ShouldSample();
+
+    // 流式提取 Type/dhId/Command，不構建 JSON DOM
+    bool ParseDCameraCmdFields(const std::shared_ptr<DataBuffer>& buffer, DCameraCmdFields& fields);
+
+    // 驗證提取出的字段
+    bool ValidateCmdFields(const DCameraCmdFields& fields);
 
     // 驗證協議類型
-    bool ValidateProtocolType(const std::string& type);
+    static bool ValidateProtocolType(const DCameraStringRef& type);
 
-    // 驗證命令類型
-    bool ValidateCommandType(const std::string& command);
+    // 驗證命令類型（完美哈希查表）
+    static bool ValidateCommandType(const DCameraStringRef& command);
 
     // 驗證協議版本
-    bool ValidateProtocolVersion(const std::string& version);
+    static bool ValidateProtocolVersion(const DCameraStringRef& version);
 
     // 驗證DHID格式
-    bool ValidateDhId(const std::string& dhId);
+    static bool ValidateDhId(const DCameraStringRef& dhId);
 
     // 處理協議錯誤
     void HandleProtocolError(const std::string& errorType, const std::string& details);
@@ -115,17 +137,18 @@ private:
     mutable std::mutex callbackMutex_;
 
     std::atomic<bool> enabled_{true};
-    mutable std::mutex statsMutex_;
-    Statistics stats_;
-
-    // 支持的協議版本
-    static const std::vector<std::string> SUPPORTED_PROTOCOL_VERSIONS;
-
-    // 支持的協議類型
-    static const std::vector<std::string> SUPPORTED_PROTOCOL_TYPES;
-
-    // 支持的命令類型
-    static const std::vector<std::string> SUPPORTED_COMMAND_TYPES;
+    std::atomic<uint32_t> sampleInterval_{1};
+    std::atomic<uint64_t> sampleCounter_{0};
+
+    // 統計計數，各字段獨立原子更新
+    std::atomic<uint64_t> totalPackets_{0};
+    std::atomic<uint64_t> sampledPackets_{0};
+    std::atomic<uint64_t> validPackets_{0};
+    std::atomic<uint64_t> invalidPackets_{0};
+    std::atomic<uint64_t> consistencyErrors_{0};
+    std::atomic<uint64_t> formatErrors_{0};
+    std::atomic<uint64_t> versionMismatches_{0};
+    std::atomic<uint64_t> unknownCommands_{0};
 };
 
 } // namespace DistributedHardware
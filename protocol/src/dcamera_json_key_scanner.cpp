@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_json_key_scanner.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+
+namespace {
+// 嵌套層數上限，防止惡意數據，不超過 SkipValue 中位棧的寬度
+constexpr size_t MAX_NESTING_DEPTH = 64;
+}
+
+bool DCameraJsonKeyScanner::Scan(const char* data, size_t size, const DCameraJsonKey* keys, size_t keyNum,
+    DCameraStringRef* values)
+{
+    if (data == nullptr || size == 0 || (keyNum > 0 && (keys == nullptr || values == nullptr))) {
+        return false;
+    }
+    for (size_t i = 0; i < keyNum; i++) {
+        values[i] = DCameraStringRef();
+    }
+
+    const char* end = data + size;
+    const char* pos = SkipWhitespace(data, end);
+    if (pos == end || *pos != '{') {
+        return false;
+    }
+    pos = SkipWhitespace(pos + 1, end);
+    if (pos != end && *pos == '}') {
+        return SkipWhitespace(pos + 1, end) == end;
+    }
+
+    while (pos != end) {
+        DCameraStringRef key;
+        if (*pos != '"' || (pos = ScanString(pos, end, key)) == nullptr) {
+            return false;
+        }
+        pos = SkipWhitespace(pos, end);
+        if (pos == end || *pos != ':') {
+            return false;
+        }
+        pos = SkipWhitespace(pos + 1, end);
+        if (pos == end) {
+            return false;
+        }
+
+        size_t keyIndex = keyNum;
+        for (size_t i = 0; i < keyNum; i++) {
+            if (values[i].data == nullptr && key.Equals(keys[i].name, keys[i].length)) {
+                keyIndex = i;
+                break;
+            }
+        }
+        if (keyIndex < keyNum && *pos == '"') {
+            if ((pos = ScanString(pos, end, values[keyIndex])) == nullptr) {
+                return false;
+            }
+        } else if ((pos = SkipValue(pos, end)) == nullptr) {
+            return false;
+        }
+
+        pos = SkipWhitespace(pos, end);
+        if (pos == end) {
+            return false;
+        }
+        if (*pos == '}') {
+            // 對象之後只允許空白
+            return SkipWhitespace(pos + 1, end) == end;
+        }
+        if (*pos != ',') {
+            return false;
+        }
+        pos = SkipWhitespace(pos + 1, end);
+    }
+    return false;
+}
+
+const char* DCameraJsonKeyScanner::SkipWhitespace(const char* pos, const char* end)
+{
+    while (pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) {
+        pos++;
+    }
+    return pos;
+}
+
+const char* DCameraJsonKeyScanner::ScanString(const char* pos, const char* end, DCameraStringRef& value)
+{
+    // pos 指向起始引號
+    const char* begin = ++pos;
+    while (pos != end) {
+        if (*pos == '\\') {
+            if (++pos == end) {
+                return nullptr;
+            }
+        } else if (*pos == '"') {
+            value.data = begin;
+            value.length = static_cast<size_t>(pos - begin);
+            return pos + 1;
+        }
+        pos++;
+    }
+    return nullptr;
+}
+
+const char* DCameraJsonKeyScanner::SkipValue(const char* pos, const char* end)
+{
+    DCameraStringRef ignored;
+    if (*pos == '"') {
+        return ScanString(pos, end, ignored);
+    }
+    if (*pos != '{' && *pos != '[') {
+        return SkipLiteral(pos, end);
+    }
+
+    // 每層一位記錄括號類型，1 為對象，0 為數組
+    uint64_t containerBits = 0;
+    size_t depth = 0;
+    while (pos != end) {
+        if (*pos == '"') {
+            if ((pos = ScanString(pos, end, ignored)) == nullptr) {
+                return nullptr;
+            }
+            continue;
+        }
+        if (*pos == '{' || *pos == '[') {
+            if (depth == MAX_NESTING_DEPTH) {
+                return nullptr;
+            }
+            containerBits = (containerBits << 1) | ((*pos == '{') ? 1 : 0);
+            depth++;
+        } else if (*pos == '}' || *pos == ']') {
+            if (((containerBits & 1) != 0) != (*pos == '}')) {
+                return nullptr;
+            }
+            containerBits >>= 1;
+            if (--depth == 0) {
+                return pos + 1;
+            }
+        }
+        pos++;
+    }
+    return nullptr;
+}
+
+const char* DCameraJsonKeyScanner::SkipLiteral(const char* pos, const char* end)
+{
+    // 數字、true/false/null，掃描到分隔符為止
+    const char* begin = pos;
+    while (pos != end && *pos != ',' && *pos != '}' && *pos != ']' && *pos != ' ' && *pos != '\t' &&
+        *pos != '\n' && *pos != '\r') {
+        pos++;
+    }
+    size_t length = static_cast<size_t>(pos - begin);
+    if (length == 0) {
+        return nullptr;
+    }
+    if (*begin == '-' || (*begin >= '0' && *begin <= '9')) {
+        for (const char* cur = begin; cur != pos; cur++) {
+            if (strchr("0123456789+-.eE", *cur) == nullptr) {
+                return nullptr;
+            }
+        }
+        return pos;
+    }
+    DCameraStringRef literal;
+    literal.data = begin;
+    literal.length = length;
+    if (literal.Equals("true", sizeof("true") - 1) || literal.Equals("false", sizeof("false") - 1) ||
+        literal.Equals("null", sizeof("null") - 1)) {
+        return pos;
+    }
+    return nullptr;
+}
+
+} // namespace DistributedHardware
+} // namespace OHOS
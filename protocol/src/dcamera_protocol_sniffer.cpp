@@ -15,39 +15,97 @@
 
 #include "dcamera_protocol_sniffer.h"
 #include "distributed_hardware_log.h"
-#include "cJSON.h"
 
 #include <cstring>
-#include <chrono>
 
 namespace OHOS {
 namespace DistributedHardware {
 
-// 靜態常量定義
-const std::vector<std::string> DCameraProtocolSniffer::SUPPORTED_PROTOCOL_VERSIONS = {
-    "1.0", "1.1", "2.0"
+namespace {
+constexpr DCameraJsonKey CMD_KEY_TYPE = { "Type", sizeof("Type") - 1 };
+constexpr DCameraJsonKey CMD_KEY_DHID = { "dhId", sizeof("dhId") - 1 };
+constexpr DCameraJsonKey CMD_KEY_COMMAND = { "Command", sizeof("Command") - 1 };
+constexpr DCameraJsonKey CMD_KEYS[] = { CMD_KEY_TYPE, CMD_KEY_DHID, CMD_KEY_COMMAND };
+constexpr size_t CMD_KEY_NUM = sizeof(CMD_KEYS) / sizeof(CMD_KEYS[0]);
+
+// 缺省的協議類型與本地協議版本
+constexpr DCameraJsonKey DEFAULT_PROTOCOL_TYPE = { "OPERATION", sizeof("OPERATION") - 1 };
+constexpr DCameraJsonKey LOCAL_PROTOCOL_VERSION = { "1.0", sizeof("1.0") - 1 };
+constexpr size_t MAX_DHID_LENGTH = 256;
+
+// 支持的協議版本
+const DCameraJsonKey SUPPORTED_PROTOCOL_VERSIONS[] = {
+    { "1.0", 3 }, { "1.1", 3 }, { "2.0", 3 }
 };
 
-const std::vector<std::string> DCameraProtocolSniffer::SUPPORTED_PROTOCOL_TYPES = {
-    "MESSAGE", "OPERATION"
+// 支持的協議類型
+const DCameraJsonKey SUPPORTED_PROTOCOL_TYPES[] = {
+    { "MESSAGE", 7 }, { "OPERATION", 9 }
 };
 
-const std::vector<std::string> DCameraProtocolSniffer::SUPPORTED_COMMAND_TYPES = {
-    "GET_INFO", "CHAN_NEG", "UPDATE_METADATA", "METADATA_RESULT",
+// 支持的命令類型
+// 與 dcamera_protocol.h 中的 DCAMERA_PROTOCOL_CMD_* 保持一致
+const char* const SUPPORTED_COMMAND_TYPES[] = {
+    "GET_INFO", "CHANNEL_NEG", "UPDATE_METADATA", "METADATA_RESULT",
     "STATE_NOTIFY", "CAPTURE", "STOP_CAPTURE", "OPEN_CHANNEL",
-    "CLOSE_CHANNEL"
+    "CLOSE_CHANNEL", "REQUEST_KEYFRAME", "TIME_SYNC"
 };
 
+// 命令表的完美哈希：(長度 + 首字符 + 2 * 尾字符) & 31，對上面的命令集合無衝突
+constexpr size_t COMMAND_HASH_SIZE = 32;
+
+size_t CommandHash(const char* data, size_t length)
+{
+    return (length + static_cast<unsigned char>(data[0]) +
+        2 * static_cast<unsigned char>(data[length - 1])) & (COMMAND_HASH_SIZE - 1);
+}
+
+struct CommandHashTable {
+    const char* commands[COMMAND_HASH_SIZE] = {};
+    size_t lengths[COMMAND_HASH_SIZE] = {};
+
+    CommandHashTable()
+    {
+        for (const char* command : SUPPORTED_COMMAND_TYPES) {
+            size_t length = strlen(command);
+            size_t slot = CommandHash(command, length);
+            if (commands[slot] != nullptr) {
+                DHLOGE("Command hash collision: %s and %s", commands[slot], command);
+            }
+            commands[slot] = command;
+            lengths[slot] = length;
+        }
+    }
+};
+
+const CommandHashTable& GetCommandHashTable()
+{
+    static const CommandHashTable table;
+    return table;
+}
+
+bool MatchAny(const DCameraStringRef& value, const DCameraJsonKey* candidates, size_t candidateNum)
+{
+    for (size_t i = 0; i < candidateNum; i++) {
+        if (value.Equals(candidates[i].name, candidates[i].length)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+DCameraStringRef MakeStringRef(const std::string& str)
+{
+    DCameraStringRef ref;
+    ref.data = str.data();
+    ref.length = str.size();
+    return ref;
+}
+}
+
 DCameraProtocolSniffer::DCameraProtocolSniffer()
 {
-    // 初始化統計信息
-    stats_.totalPackets = 0;
-    stats_.validPackets = 0;
-    stats_.invalidPackets = 0;
-    stats_.consistencyErrors = 0;
-    stats_.formatErrors = 0;
-    stats_.versionMismatches = 0;
-    stats_.unknownCommands = 0;
+    GetCommandHashTable();
 }
 
 DCameraProtocolSniffer::~DCameraProtocolSniffer()
@@ -62,81 +120,91 @@ void DCameraProtocolSniffer::SetCallback(std::shared_ptr<IProtocolSnifferCallbac
 
 bool DCameraProtocolSniffer::MonitorIncomingPacket(const std::shared_ptr<DataBuffer>& buffer)
 {
-    if (!enabled_.load() || !buffer) {
-        return false;
-    }
-
-    stats_.totalPackets++;
-
-    DCameraCmdPack pack;
-    if (!ParseDCameraCmdPack(buffer, pack)) {
-        stats_.invalidPackets++;
-        HandleProtocolError("FORMAT_ERROR", "Failed to parse incoming packet");
-        return false;
-    }
-
-    if (!ValidateProtocolConsistency(pack)) {
-        stats_.consistencyErrors++;
-        return false;
-    }
-
-    stats_.validPackets++;
-    DHLOGD("Incoming packet validated successfully, command: %s", pack.command.c_str());
-    return true;
+    return MonitorPacket(buffer, "incoming");
 }
 
 bool DCameraProtocolSniffer::MonitorOutgoingPacket(const std::shared_ptr<DataBuffer>& buffer)
 {
-    if (!enabled_.load() || !buffer) {
+    return MonitorPacket(buffer, "outgoing");
+}
+
+bool DCameraProtocolSniffer::MonitorPacket(const std::shared_ptr<DataBuffer>& buffer, const char* direction)
+{
+    if (!enabled_.load(std::memory_order_relaxed) || !buffer) {
         return false;
     }
 
-    stats_.totalPackets++;
+    totalPackets_.fetch_add(1, std::memory_order_relaxed);
+    if (!ShouldSample()) {
+        return true;
+    }
+    sampledPackets_.fetch_add(1, std::memory_order_relaxed);
 
-    DCameraCmdPack pack;
-    if (!ParseDCameraCmdPack(buffer, pack)) {
-        stats_.invalidPackets++;
-        HandleProtocolError("FORMAT_ERROR", "Failed to parse outgoing packet");
+    DCameraCmdFields fields;
+    if (!ParseDCameraCmdFields(buffer, fields)) {
+        invalidPackets_.fetch_add(1, std::memory_order_relaxed);
+        formatErrors_.fetch_add(1, std::memory_order_relaxed);
+        HandleProtocolError("FORMAT_ERROR", std::string("Failed to parse ") + direction + " packet");
         return false;
     }
 
-    if (!ValidateProtocolConsistency(pack)) {
-        stats_.consistencyErrors++;
+    if (!ValidateCmdFields(fields)) {
+        consistencyErrors_.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
-    stats_.validPackets++;
-    DHLOGD("Outgoing packet validated successfully, command: %s", pack.command.c_str());
+    validPackets_.fetch_add(1, std::memory_order_relaxed);
+    DHLOGD("%s packet validated successfully, command: %.*s", direction,
+           static_cast<int>(fields.command.length), fields.command.data);
     return true;
 }
 
+bool DCameraProtocolSniffer::ShouldSample()
+{
+    uint32_t interval = sampleInterval_.load(std::memory_order_relaxed);
+    if (interval <= 1) {
+        return true;
+    }
+    return sampleCounter_.fetch_add(1, std::memory_order_relaxed) % interval == 0;
+}
+
 bool DCameraProtocolSniffer::ValidateProtocolConsistency(const DCameraCmdPack& pack)
+{
+    DCameraCmdFields fields;
+    fields.type = MakeStringRef(pack.type);
+    fields.dhId = MakeStringRef(pack.dhId);
+    fields.command = MakeStringRef(pack.command);
+    fields.version = MakeStringRef(pack.version);
+    return ValidateCmdFields(fields);
+}
+
+bool DCameraProtocolSniffer::ValidateCmdFields(const DCameraCmdFields& fields)
 {
     bool isValid = true;
 
     // 驗證協議類型
-    if (!ValidateProtocolType(pack.type)) {
-        HandleProtocolError("UNKNOWN_PROTOCOL_TYPE", pack.type);
+    if (!ValidateProtocolType(fields.type)) {
+        HandleProtocolError("UNKNOWN_PROTOCOL_TYPE", fields.type.ToString());
         isValid = false;
     }
 
     // 驗證命令類型
-    if (!ValidateCommandType(pack.command)) {
-        HandleProtocolError("UNKNOWN_COMMAND", pack.command);
-        stats_.unknownCommands++;
+    if (!ValidateCommandType(fields.command)) {
+        HandleProtocolError("UNKNOWN_COMMAND", fields.command.ToString());
+        unknownCommands_.fetch_add(1, std::memory_order_relaxed);
         isValid = false;
     }
 
     // 驗證協議版本
-    if (!ValidateProtocolVersion(pack.version)) {
-        HandleProtocolError("VERSION_MISMATCH", pack.version);
-        stats_.versionMismatches++;
+    if (!ValidateProtocolVersion(fields.version)) {
+        HandleProtocolError("VERSION_MISMATCH", fields.version.ToString());
+        versionMismatches_.fetch_add(1, std::memory_order_relaxed);
         isValid = false;
     }
 
     // 驗證DHID格式
-    if (!ValidateDhId(pack.dhId)) {
-        HandleProtocolError("INVALID_DHID", pack.dhId);
+    if (!ValidateDhId(fields.dhId)) {
+        HandleProtocolError("INVALID_DHID", fields.dhId.ToString());
         isValid = false;
     }
 
@@ -149,94 +217,84 @@ void DCameraProtocolSniffer::Enable(bool enabled)
     DHLOGI("Protocol sniffer %s", enabled ? "enabled" : "disabled");
 }
 
+void DCameraProtocolSniffer::SetSamplingInterval(uint32_t sampleInterval)
+{
+    sampleInterval_.store(sampleInterval);
+    DHLOGI("Protocol sniffer sampling interval: %u", sampleInterval);
+}
+
 DCameraProtocolSniffer::Statistics DCameraProtocolSniffer::GetStatistics() const
 {
-    std::lock_guard<std::mutex> lock(statsMutex_);
-    return stats_;
+    Statistics stats;
+    stats.totalPackets = totalPackets_.load(std::memory_order_relaxed);
+    stats.sampledPackets = sampledPackets_.load(std::memory_order_relaxed);
+    stats.validPackets = validPackets_.load(std::memory_order_relaxed);
+    stats.invalidPackets = invalidPackets_.load(std::memory_order_relaxed);
+    stats.consistencyErrors = consistencyErrors_.load(std::memory_order_relaxed);
+    stats.formatErrors = formatErrors_.load(std::memory_order_relaxed);
+    stats.versionMismatches = versionMismatches_.load(std::memory_order_relaxed);
+    stats.unknownCommands = unknownCommands_.load(std::memory_order_relaxed);
+    return stats;
 }
 
-bool DCameraProtocolSniffer::ParseDCameraCmdPack(const std::shared_ptr<DataBuffer>& buffer, DCameraCmdPack& pack)
+bool DCameraProtocolSniffer::ParseDCameraCmdFields(const std::shared_ptr<DataBuffer>& buffer,
+    DCameraCmdFields& fields)
 {
     if (!buffer || buffer->Size() == 0) {
         return false;
     }
 
-    // 假設數據是JSON格式（基於現有代碼結構）
-    std::string jsonString(reinterpret_cast<const char*>(buffer->GetData()), buffer->Size());
-
-    cJSON* root = cJSON_Parse(jsonString.c_str());
-    if (!root) {
-        DHLOGE("Failed to parse JSON");
-        return false;
-    }
-
-    // 解析各個字段
-    cJSON* type = cJSON_GetObjectItemCaseSensitive(root, "Type");
-    if (type && cJSON_IsString(type)) {
-        pack.type = type->valuestring;
-    } else {
-        pack.type = "OPERATION"; // 默認值
+    // 控制器發送的命令帶有字符串結尾的 '\0'
+    size_t size = buffer->Size();
+    while (size > 0 && buffer->Data()[size - 1] == '\0') {
+        size--;
     }
-
-    cJSON* dhId = cJSON_GetObjectItemCaseSensitive(root, "dhId");
-    if (dhId && cJSON_IsString(dhId)) {
-        pack.dhId = dhId->valuestring;
+    DCameraStringRef values[CMD_KEY_NUM];
+    if (!DCameraJsonKeyScanner::Scan(reinterpret_cast<const char*>(buffer->Data()), size,
+        CMD_KEYS, CMD_KEY_NUM, values)) {
+        DHLOGE("Failed to scan protocol packet");
+        return false;
     }
 
-    cJSON* command = cJSON_GetObjectItemCaseSensitive(root, "Command");
-    if (command && cJSON_IsString(command)) {
-        pack.command = command->valuestring;
+    fields.type = values[0];
+    if (fields.type.data == nullptr) {
+        fields.type.data = DEFAULT_PROTOCOL_TYPE.name;
+        fields.type.length = DEFAULT_PROTOCOL_TYPE.length;
     }
-
-    // 序列號和時間戳使用當前時間
-    pack.sequence = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count());
-    pack.timestamp = pack.sequence;
-
-    // 版本默認為1.0
-    pack.version = "1.0";
-
-    // 值字段保持原始JSON字符串
-    pack.value = jsonString;
-
-    cJSON_Delete(root);
+    fields.dhId = values[1];
+    fields.command = values[2];
+    // 協議中沒有版本字段，使用本地版本
+    fields.version.data = LOCAL_PROTOCOL_VERSION.name;
+    fields.version.length = LOCAL_PROTOCOL_VERSION.length;
     return true;
 }
 
-bool DCameraProtocolSniffer::ValidateProtocolType(const std::string& type)
+bool DCameraProtocolSniffer::ValidateProtocolType(const DCameraStringRef& type)
 {
-    for (const auto& supportedType : SUPPORTED_PROTOCOL_TYPES) {
-        if (supportedType == type) {
-            return true;
-        }
-    }
-    return false;
+    return MatchAny(type, SUPPORTED_PROTOCOL_TYPES,
+        sizeof(SUPPORTED_PROTOCOL_TYPES) / sizeof(SUPPORTED_PROTOCOL_TYPES[0]));
 }
 
-bool DCameraProtocolSniffer::ValidateCommandType(const std::string& command)
+bool DCameraProtocolSniffer::ValidateCommandType(const DCameraStringRef& command)
 {
-    for (const auto& supportedCommand : SUPPORTED_COMMAND_TYPES) {
-        if (supportedCommand == command) {
-            return true;
-        }
+    if (command.Empty()) {
+        return false;
     }
-    return false;
+    const CommandHashTable& table = GetCommandHashTable();
+    size_t slot = CommandHash(command.data, command.length);
+    return table.commands[slot] != nullptr && command.Equals(table.commands[slot], table.lengths[slot]);
 }
 
-bool DCameraProtocolSniffer::ValidateProtocolVersion(const std::string& version)
+bool DCameraProtocolSniffer::ValidateProtocolVersion(const DCameraStringRef& version)
 {
-    for (const auto& supportedVersion : SUPPORTED_PROTOCOL_VERSIONS) {
-        if (supportedVersion == version) {
-            return true;
-        }
-    }
-    return false;
+    return MatchAny(version, SUPPORTED_PROTOCOL_VERSIONS,
+        sizeof(SUPPORTED_PROTOCOL_VERSIONS) / sizeof(SUPPORTED_PROTOCOL_VERSIONS[0]));
 }
 
-bool DCameraProtocolSniffer::ValidateDhId(const std::string& dhId)
+bool DCameraProtocolSniffer::ValidateDhId(const DCameraStringRef& dhId)
 {
     // 簡單的DHID驗證：非空且長度合理
-    return !dhId.empty() && dhId.length() <= 256;
+    return !dhId.Empty() && dhId.length <= MAX_DHID_LENGTH;
 }
 
 void DCameraProtocolSniffer::HandleProtocolError(const std::string& errorType, const std::string& details)
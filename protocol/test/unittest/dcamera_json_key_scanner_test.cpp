@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "dcamera_json_key_scanner.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraJsonKeyScannerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    static bool Scan(const std::string& json);
+
+    DCameraStringRef values_[3];
+};
+
+namespace {
+const DCameraJsonKey TEST_KEYS[] = {
+    { "Type", sizeof("Type") - 1 }, { "dhId", sizeof("dhId") - 1 }, { "Command", sizeof("Command") - 1 }
+};
+const size_t TEST_KEY_NUM = sizeof(TEST_KEYS) / sizeof(TEST_KEYS[0]);
+const std::string TEST_VALID_JSON = R"({
+    "Type": "OPERATION",
+    "dhId": "camera_0",
+    "Command": "CAPTURE",
+    "Value": [{"Width": 1920, "Height": 1080, "IsCapture": true, "Ratio": -1.5e2, "Extra": null}]
+})";
+}
+
+void DCameraJsonKeyScannerTest::SetUpTestCase(void)
+{
+}
+
+void DCameraJsonKeyScannerTest::TearDownTestCase(void)
+{
+}
+
+void DCameraJsonKeyScannerTest::SetUp(void)
+{
+}
+
+void DCameraJsonKeyScannerTest::TearDown(void)
+{
+}
+
+bool DCameraJsonKeyScannerTest::Scan(const std::string& json)
+{
+    DCameraStringRef values[TEST_KEY_NUM];
+    return DCameraJsonKeyScanner::Scan(json.data(), json.size(), TEST_KEYS, TEST_KEY_NUM, values);
+}
+
+/**
+ * @tc.name: dcamera_json_key_scanner_test_001
+ * @tc.desc: Verify the Scan function extracts the keys of a valid packet.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraJsonKeyScannerTest, dcamera_json_key_scanner_test_001, TestSize.Level1)
+{
+    EXPECT_TRUE(DCameraJsonKeyScanner::Scan(TEST_VALID_JSON.data(), TEST_VALID_JSON.size(), TEST_KEYS,
+        TEST_KEY_NUM, values_));
+    EXPECT_EQ("OPERATION", values_[0].ToString());
+    EXPECT_EQ("camera_0", values_[1].ToString());
+    EXPECT_EQ("CAPTURE", values_[2].ToString());
+
+    std::string json = R"({"Command": "GET_INFO", "Value": {"a": [1, 2, {"b": "c\"}"}]}})";
+    EXPECT_TRUE(DCameraJsonKeyScanner::Scan(json.data(), json.size(), TEST_KEYS, TEST_KEY_NUM, values_));
+    EXPECT_TRUE(values_[0].Empty());
+    EXPECT_TRUE(values_[1].Empty());
+    EXPECT_EQ("GET_INFO", values_[2].ToString());
+
+    EXPECT_TRUE(Scan("{}"));
+    EXPECT_TRUE(Scan(" { } \n"));
+}
+
+/**
+ * @tc.name: dcamera_json_key_scanner_test_002
+ * @tc.desc: Verify the Scan function rejects a truncated packet, even after all keys were found.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraJsonKeyScannerTest, dcamera_json_key_scanner_test_002, TestSize.Level1)
+{
+    for (size_t length = 1; length < TEST_VALID_JSON.size(); length++) {
+        std::string truncated = TEST_VALID_JSON.substr(0, length);
+        EXPECT_FALSE(Scan(truncated)) << truncated;
+    }
+    EXPECT_FALSE(Scan(R"({"Type": "OPERATION)"));
+    EXPECT_FALSE(Scan(R"({"Type": "OPERATION", "dhId": "camera_0", "Command": "CAPTURE")"));
+    EXPECT_FALSE(DCameraJsonKeyScanner::Scan(nullptr, 0, TEST_KEYS, TEST_KEY_NUM, values_));
+}
+
+/**
+ * @tc.name: dcamera_json_key_scanner_test_003
+ * @tc.desc: Verify the Scan function rejects malformed content after the wanted keys.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraJsonKeyScannerTest, dcamera_json_key_scanner_test_003, TestSize.Level1)
+{
+    const std::string prefix = R"({"Type": "OPERATION", "dhId": "camera_0", "Command": "CAPTURE", )";
+    EXPECT_TRUE(Scan(prefix + R"("Value": {"a": [1]}})"));
+    EXPECT_FALSE(Scan(prefix + R"("Value": {"a": [1}]})"));
+    EXPECT_FALSE(Scan(prefix + R"("Value": xyz})"));
+    EXPECT_FALSE(Scan(prefix + R"("Value": 12a})"));
+    EXPECT_FALSE(Scan(prefix + R"("Value" 1})"));
+    EXPECT_FALSE(Scan(prefix + R"("Value": 1 "Next": 2})"));
+    EXPECT_FALSE(Scan(prefix + R"(Value: 1})"));
+    EXPECT_FALSE(Scan(prefix + R"("Value": 1}})"));
+    EXPECT_FALSE(Scan(prefix + R"("Value": 1} trailing)"));
+    EXPECT_FALSE(Scan("[]"));
+    EXPECT_FALSE(Scan(R"({"Type": "OPERATION",})"));
+
+    std::string deep = prefix + R"("Value": )" + std::string(65, '[') + std::string(65, ']') + "}";
+    EXPECT_FALSE(Scan(deep));
+    deep = prefix + R"("Value": )" + std::string(64, '[') + std::string(64, ']') + "}";
+    EXPECT_TRUE(Scan(deep));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
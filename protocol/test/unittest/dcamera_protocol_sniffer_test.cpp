@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "data_buffer.h"
+#include "dcamera_protocol.h"
+#include "dcamera_protocol_sniffer.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraProtocolSnifferTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    std::shared_ptr<DCameraProtocolSniffer> sniffer_;
+};
+
+namespace {
+const std::string TEST_VALID_PACKET =
+    R"({"Type": "OPERATION", "dhId": "camera_0", "Command": "CAPTURE", "Value": [{"Width": 1920}]})";
+const std::string TEST_TRUNCATED_PACKET =
+    R"({"Type": "OPERATION", "dhId": "camera_0", "Command": "CAPTURE", "Value": [{"Width": 19)";
+const std::string TEST_MALFORMED_PACKET =
+    R"({"Type": "OPERATION", "dhId": "camera_0", "Command": "CAPTURE", "Value": [{"Width": 1920]}})";
+const std::string TEST_UNKNOWN_COMMAND_PACKET =
+    R"({"Type": "OPERATION", "dhId": "camera_0", "Command": "REBOOT"})";
+
+class TestSnifferCallback : public IProtocolSnifferCallback {
+public:
+    void OnProtocolInconsistency(const std::string& message, const std::string& expected,
+        const std::string& actual) override
+    {
+        inconsistencies++;
+    }
+
+    void OnInvalidProtocolFormat(const std::string& message, const std::string& error) override
+    {
+        formatErrors++;
+    }
+
+    void OnProtocolVersionMismatch(const std::string& localVersion, const std::string& remoteVersion) override
+    {
+        versionMismatches++;
+    }
+
+    void OnUnknownProtocolCommand(const std::string& command) override
+    {
+        unknownCommand = command;
+    }
+
+    int32_t inconsistencies = 0;
+    int32_t formatErrors = 0;
+    int32_t versionMismatches = 0;
+    std::string unknownCommand;
+};
+
+std::shared_ptr<DataBuffer> MakePacket(const std::string& json)
+{
+    auto buffer = std::make_shared<DataBuffer>(json.size());
+    memcpy(buffer->Data(), json.data(), json.size());
+    return buffer;
+}
+
+// Built the way the source and sink controllers send a command, the buffer keeps the string terminator
+std::shared_ptr<DataBuffer> MakeCommandPacket(const std::string& type, const std::string& command)
+{
+    std::string json = "{\"Type\":\"" + type + "\",\"dhId\":\"camera_0\",\"Command\":\"" + command +
+        "\",\"Value\":{}}";
+    auto buffer = std::make_shared<DataBuffer>(json.size() + 1);
+    memcpy(buffer->Data(), json.data(), json.size());
+    return buffer;
+}
+}
+
+void DCameraProtocolSnifferTest::SetUpTestCase(void)
+{
+}
+
+void DCameraProtocolSnifferTest::TearDownTestCase(void)
+{
+}
+
+void DCameraProtocolSnifferTest::SetUp(void)
+{
+    sniffer_ = std::make_shared<DCameraProtocolSniffer>();
+}
+
+void DCameraProtocolSnifferTest::TearDown(void)
+{
+    sniffer_ = nullptr;
+}
+
+/**
+ * @tc.name: dcamera_protocol_sniffer_test_001
+ * @tc.desc: Verify a valid packet passes and updates the statistics.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraProtocolSnifferTest, dcamera_protocol_sniffer_test_001, TestSize.Level1)
+{
+    auto callback = std::make_shared<TestSnifferCallback>();
+    sniffer_->SetCallback(callback);
+    EXPECT_TRUE(sniffer_->MonitorIncomingPacket(MakePacket(TEST_VALID_PACKET)));
+    EXPECT_TRUE(sniffer_->MonitorOutgoingPacket(MakePacket(TEST_VALID_PACKET)));
+
+    DCameraProtocolSniffer::Statistics stats = sniffer_->GetStatistics();
+    EXPECT_EQ(2, stats.totalPackets);
+    EXPECT_EQ(2, stats.validPackets);
+    EXPECT_EQ(0, stats.formatErrors);
+    EXPECT_EQ(0, callback->formatErrors);
+}
+
+/**
+ * @tc.name: dcamera_protocol_sniffer_test_002
+ * @tc.desc: Verify truncated and malformed packets are reported as FORMAT_ERROR.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraProtocolSnifferTest, dcamera_protocol_sniffer_test_002, TestSize.Level1)
+{
+    auto callback = std::make_shared<TestSnifferCallback>();
+    sniffer_->SetCallback(callback);
+    EXPECT_FALSE(sniffer_->MonitorIncomingPacket(MakePacket(TEST_TRUNCATED_PACKET)));
+    EXPECT_FALSE(sniffer_->MonitorIncomingPacket(MakePacket(TEST_MALFORMED_PACKET)));
+    EXPECT_FALSE(sniffer_->MonitorIncomingPacket(MakePacket(TEST_VALID_PACKET + "}")));
+
+    DCameraProtocolSniffer::Statistics stats = sniffer_->GetStatistics();
+    EXPECT_EQ(3, stats.invalidPackets);
+    EXPECT_EQ(3, stats.formatErrors);
+    EXPECT_EQ(0, stats.validPackets);
+    EXPECT_EQ(3, callback->formatErrors);
+}
+
+/**
+ * @tc.name: dcamera_protocol_sniffer_test_003
+ * @tc.desc: Verify unknown commands and sampling.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraProtocolSnifferTest, dcamera_protocol_sniffer_test_003, TestSize.Level1)
+{
+    auto callback = std::make_shared<TestSnifferCallback>();
+    sniffer_->SetCallback(callback);
+    EXPECT_FALSE(sniffer_->MonitorIncomingPacket(MakePacket(TEST_UNKNOWN_COMMAND_PACKET)));
+    EXPECT_EQ("REBOOT", callback->unknownCommand);
+    EXPECT_EQ(1, sniffer_->GetStatistics().unknownCommands);
+
+    const uint32_t sampleInterval = 4;
+    sniffer_->SetSamplingInterval(sampleInterval);
+    for (uint32_t i = 0; i < sampleInterval * 2; i++) {
+        sniffer_->MonitorIncomingPacket(MakePacket(TEST_MALFORMED_PACKET));
+    }
+    EXPECT_EQ(2, sniffer_->GetStatistics().formatErrors);
+
+    sniffer_->Enable(false);
+    EXPECT_FALSE(sniffer_->MonitorIncomingPacket(MakePacket(TEST_VALID_PACKET)));
+    EXPECT_FALSE(sniffer_->MonitorIncomingPacket(nullptr));
+}
+
+/**
+ * @tc.name: dcamera_protocol_sniffer_test_004
+ * @tc.desc: Verify every command the source and sink send passes validation.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraProtocolSnifferTest, dcamera_protocol_sniffer_test_004, TestSize.Level1)
+{
+    auto callback = std::make_shared<TestSnifferCallback>();
+    sniffer_->SetCallback(callback);
+    const std::vector<std::string> commands = {
+        DCAMERA_PROTOCOL_CMD_GET_INFO, DCAMERA_PROTOCOL_CMD_CHAN_NEG, DCAMERA_PROTOCOL_CMD_UPDATE_METADATA,
+        DCAMERA_PROTOCOL_CMD_METADATA_RESULT, DCAMERA_PROTOCOL_CMD_STATE_NOTIFY, DCAMERA_PROTOCOL_CMD_CAPTURE,
+        DCAMERA_PROTOCOL_CMD_STOP_CAPTURE, DCAMERA_PROTOCOL_CMD_OPEN_CHANNEL, DCAMERA_PROTOCOL_CMD_CLOSE_CHANNEL,
+        DCAMERA_PROTOCOL_CMD_REQUEST_KEYFRAME, DCAMERA_PROTOCOL_CMD_TIME_SYNC,
+    };
+    for (const std::string& command : commands) {
+        EXPECT_TRUE(sniffer_->MonitorIncomingPacket(MakeCommandPacket(DCAMERA_PROTOCOL_TYPE_MESSAGE, command)))
+            << command;
+        EXPECT_TRUE(sniffer_->MonitorOutgoingPacket(MakeCommandPacket(DCAMERA_PROTOCOL_TYPE_OPERATION, command)))
+            << command;
+    }
+    DCameraProtocolSniffer::Statistics stats = sniffer_->GetStatistics();
+    EXPECT_EQ(commands.size() * 2, stats.validPackets);
+    EXPECT_EQ(0, stats.unknownCommands);
+    EXPECT_EQ(0, stats.formatErrors);
+    EXPECT_TRUE(callback->unknownCommand.empty());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
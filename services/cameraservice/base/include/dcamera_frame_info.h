@@ -36,9 +36,17 @@ struct DCameraFrameInfo {
     int8_t type = 0;
     std::string ver = "";
     int32_t index = 0;
+    int32_t seq = -1;
+    int32_t layer = 0;
+    int32_t width = 0;
+    int32_t height = 0;
     int32_t offset = 0;
     int64_t pts = 0;
     int64_t rawTime = 0;
+    int32_t fecIndex = -1;
+    int32_t fecDataNum = 0;
+    int32_t fecParityNum = 0;
+    int32_t fecLen = 0;
     DCameraFrameProcessTimePoint timePonit {0};
 };
 } // namespace DistributedHardware
@@ -23,27 +23,44 @@ namespace DistributedHardware {
 class DCameraSinkFrameInfo {
 public:
     DCameraSinkFrameInfo()
-        : type_(-1), index_(-1), pts_(0), startEncodeT_(0), finishEncodeT_(0), sendT_(0), ver_("1.0")
+        : type_(-1), index_(-1), seq_(-1), layer_(0), width_(0), height_(0), pts_(0), startEncodeT_(0), finishEncodeT_(0),
+          sendT_(0), fecIndex_(-1), fecDataNum_(0), fecParityNum_(0), fecLen_(0), ver_("1.0")
     {}
     ~DCameraSinkFrameInfo() = default;
     int8_t type_;
     int32_t index_;
+    int32_t seq_;
+    int32_t layer_;
+    int32_t width_;
+    int32_t height_;
     int64_t pts_;
     int64_t startEncodeT_;
     int64_t finishEncodeT_;
     int64_t sendT_;
+    int32_t fecIndex_;
+    int32_t fecDataNum_;
+    int32_t fecParityNum_;
+    int32_t fecLen_;
     std::string ver_;
     std::string rawTime_;
 
 public:
     const std::string FRAME_INFO_TYPE = "type";
     const std::string FRAME_INFO_INDEX = "index";
+    const std::string FRAME_INFO_SEQ = "seq";
+    const std::string FRAME_INFO_LAYER = "layer";
+    const std::string FRAME_INFO_WIDTH = "width";
+    const std::string FRAME_INFO_HEIGHT = "height";
     const std::string FRAME_INFO_PTS = "pts";
     const std::string FRAME_INFO_START_ENCODE = "startEncodeT";
     const std::string FRAME_INFO_FINISH_ENCODE = "finishEncodeT";
     const std::string FRAME_INFO_ENCODET = "encodeT";
     const std::string FRAME_INFO_SENDT = "sendT";
     const std::string FRAME_INFO_VERSION = "ver";
+    const std::string FRAME_INFO_FEC_INDEX = "fecIdx";
+    const std::string FRAME_INFO_FEC_DATA_NUM = "fecK";
+    const std::string FRAME_INFO_FEC_PARITY_NUM = "fecM";
+    const std::string FRAME_INFO_FEC_LEN = "fecLen";
     const std::string RAW_TIME = "rawTime";
 
 public:
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_TIME_SYNC_CMD_H
+#define OHOS_DCAMERA_TIME_SYNC_CMD_H
+
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Clock ping on the control channel. The source sends originUs, the sink answers with the same
+ * command carrying originUs back together with its own receive and send times.
+ */
+class DCameraTimeSyncCmd {
+public:
+    std::string type_;
+    std::string dhId_;
+    std::string command_;
+    int64_t originUs_ = 0;
+    int64_t receiveUs_ = 0;
+    int64_t transmitUs_ = 0;
+
+public:
+    int32_t Marshal(std::string& jsonStr);
+    int32_t Unmarshal(const std::string& jsonStr);
+    bool IsReply() const;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_TIME_SYNC_CMD_H
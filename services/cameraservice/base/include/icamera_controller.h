@@ -36,6 +36,7 @@ public:
     virtual int32_t ChannelNeg(std::shared_ptr<DCameraChannelInfo>& info) = 0;
     virtual int32_t DCameraNotify(std::shared_ptr<DCameraEvent>& events) = 0;
     virtual int32_t UpdateSettings(std::vector<std::shared_ptr<DCameraSettings>>& settings) = 0;
+    virtual int32_t RequestKeyFrame() = 0;
     virtual int32_t GetCameraInfo(std::shared_ptr<DCameraInfo>& camInfo) = 0;
     virtual int32_t OpenChannel(std::shared_ptr<DCameraOpenInfo>& openInfo) = 0;
     virtual int32_t CloseChannel() = 0;
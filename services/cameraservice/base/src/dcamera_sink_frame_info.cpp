@@ -28,10 +28,24 @@ void DCameraSinkFrameInfo::Marshal(std::string& jsonStr)
     }
     cJSON_AddNumberToObject(frameInfo, FRAME_INFO_TYPE.c_str(), type_);
     cJSON_AddNumberToObject(frameInfo, FRAME_INFO_INDEX.c_str(), index_);
+    if (seq_ >= 0) {
+        cJSON_AddNumberToObject(frameInfo, FRAME_INFO_SEQ.c_str(), seq_);
+    }
+    cJSON_AddNumberToObject(frameInfo, FRAME_INFO_LAYER.c_str(), layer_);
+    if (width_ > 0 && height_ > 0) {
+        cJSON_AddNumberToObject(frameInfo, FRAME_INFO_WIDTH.c_str(), width_);
+        cJSON_AddNumberToObject(frameInfo, FRAME_INFO_HEIGHT.c_str(), height_);
+    }
     cJSON_AddNumberToObject(frameInfo, FRAME_INFO_PTS.c_str(), pts_);
     cJSON_AddNumberToObject(frameInfo, FRAME_INFO_START_ENCODE.c_str(), startEncodeT_);
     cJSON_AddNumberToObject(frameInfo, FRAME_INFO_FINISH_ENCODE.c_str(), finishEncodeT_);
     cJSON_AddNumberToObject(frameInfo, FRAME_INFO_SENDT.c_str(), sendT_);
+    if (fecParityNum_ > 0) {
+        cJSON_AddNumberToObject(frameInfo, FRAME_INFO_FEC_INDEX.c_str(), fecIndex_);
+        cJSON_AddNumberToObject(frameInfo, FRAME_INFO_FEC_DATA_NUM.c_str(), fecDataNum_);
+        cJSON_AddNumberToObject(frameInfo, FRAME_INFO_FEC_PARITY_NUM.c_str(), fecParityNum_);
+        cJSON_AddNumberToObject(frameInfo, FRAME_INFO_FEC_LEN.c_str(), fecLen_);
+    }
     cJSON_AddStringToObject(frameInfo, FRAME_INFO_VERSION.c_str(), ver_.c_str());
     cJSON_AddStringToObject(frameInfo, RAW_TIME.c_str(), rawTime_.c_str());
 
@@ -60,6 +74,20 @@ int32_t DCameraSinkFrameInfo::Unmarshal(const std::string& jsonStr)
         DCAMERA_BAD_VALUE, rootValue, "index parse fail.");
     index_ = static_cast<int32_t>(index->valueint);
 
+    // Older sinks do not number the sent frames, the source then detects gaps on the encoder index
+    cJSON *seq = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_SEQ.c_str());
+    seq_ = (seq != nullptr && cJSON_IsNumber(seq)) ? static_cast<int32_t>(seq->valueint) : -1;
+
+    // Older sinks do not send the temporal layer, all of their frames are in the base layer
+    cJSON *layer = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_LAYER.c_str());
+    layer_ = (layer != nullptr && cJSON_IsNumber(layer)) ? static_cast<int32_t>(layer->valueint) : 0;
+
+    // Only sent after the sink switched the encode resolution, 0 keeps the configured resolution
+    cJSON *width = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_WIDTH.c_str());
+    width_ = (width != nullptr && cJSON_IsNumber(width)) ? static_cast<int32_t>(width->valueint) : 0;
+    cJSON *height = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_HEIGHT.c_str());
+    height_ = (height != nullptr && cJSON_IsNumber(height)) ? static_cast<int32_t>(height->valueint) : 0;
+
     cJSON *pts = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_PTS.c_str());
     CHECK_AND_FREE_RETURN_RET_LOG((pts == nullptr || !cJSON_IsNumber(pts)),
         DCAMERA_BAD_VALUE, rootValue, "pts parse fail.");
@@ -80,6 +108,22 @@ int32_t DCameraSinkFrameInfo::Unmarshal(const std::string& jsonStr)
         DCAMERA_BAD_VALUE, rootValue, "sendT parse fail.");
     sendT_ = static_cast<int64_t>(sendT->valueint);
 
+    // Only sent for a shard of a frame protected by FEC, the payload is then one shard of the frame
+    cJSON *fecParityNum = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_FEC_PARITY_NUM.c_str());
+    fecParityNum_ = (fecParityNum != nullptr && cJSON_IsNumber(fecParityNum)) ?
+        static_cast<int32_t>(fecParityNum->valueint) : 0;
+    if (fecParityNum_ > 0) {
+        cJSON *fecIndex = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_FEC_INDEX.c_str());
+        cJSON *fecDataNum = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_FEC_DATA_NUM.c_str());
+        cJSON *fecLen = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_FEC_LEN.c_str());
+        CHECK_AND_FREE_RETURN_RET_LOG((fecIndex == nullptr || !cJSON_IsNumber(fecIndex) || fecDataNum == nullptr ||
+            !cJSON_IsNumber(fecDataNum) || fecLen == nullptr || !cJSON_IsNumber(fecLen)),
+            DCAMERA_BAD_VALUE, rootValue, "fec parse fail.");
+        fecIndex_ = static_cast<int32_t>(fecIndex->valueint);
+        fecDataNum_ = static_cast<int32_t>(fecDataNum->valueint);
+        fecLen_ = static_cast<int32_t>(fecLen->valueint);
+    }
+
     cJSON *ver = cJSON_GetObjectItemCaseSensitive(rootValue, FRAME_INFO_VERSION.c_str());
     CHECK_AND_FREE_RETURN_RET_LOG((ver == nullptr || !cJSON_IsString(ver)),
         DCAMERA_BAD_VALUE, rootValue, "ver parse fail.");
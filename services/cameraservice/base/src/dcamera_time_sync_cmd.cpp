@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_time_sync_cmd.h"
+#include "cJSON.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+// Microsecond timestamps need more than the int range of valueint, doubles hold them exactly
+int64_t GetTimeValue(cJSON *root, const char *key, bool& isValid)
+{
+    cJSON *item = cJSON_GetObjectItemCaseSensitive(root, key);
+    if (item == nullptr || !cJSON_IsNumber(item)) {
+        isValid = false;
+        return 0;
+    }
+    return static_cast<int64_t>(item->valuedouble);
+}
+}
+
+int32_t DCameraTimeSyncCmd::Marshal(std::string& jsonStr)
+{
+    cJSON *rootValue = cJSON_CreateObject();
+    if (rootValue == nullptr) {
+        return DCAMERA_BAD_VALUE;
+    }
+    cJSON_AddStringToObject(rootValue, "Type", type_.c_str());
+    cJSON_AddStringToObject(rootValue, "dhId", dhId_.c_str());
+    cJSON_AddStringToObject(rootValue, "Command", command_.c_str());
+
+    cJSON *timeValue = cJSON_CreateObject();
+    if (timeValue == nullptr) {
+        cJSON_Delete(rootValue);
+        return DCAMERA_BAD_VALUE;
+    }
+    cJSON_AddNumberToObject(timeValue, "OriginUs", static_cast<double>(originUs_));
+    cJSON_AddNumberToObject(timeValue, "ReceiveUs", static_cast<double>(receiveUs_));
+    cJSON_AddNumberToObject(timeValue, "TransmitUs", static_cast<double>(transmitUs_));
+    cJSON_AddItemToObject(rootValue, "Value", timeValue);
+
+    char *data = cJSON_PrintUnformatted(rootValue);
+    if (data == nullptr) {
+        cJSON_Delete(rootValue);
+        return DCAMERA_BAD_VALUE;
+    }
+    jsonStr = std::string(data);
+    cJSON_Delete(rootValue);
+    cJSON_free(data);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraTimeSyncCmd::Unmarshal(const std::string& jsonStr)
+{
+    cJSON *rootValue = cJSON_Parse(jsonStr.c_str());
+    if (rootValue == nullptr) {
+        return DCAMERA_BAD_VALUE;
+    }
+    cJSON *type = cJSON_GetObjectItemCaseSensitive(rootValue, "Type");
+    cJSON *dhId = cJSON_GetObjectItemCaseSensitive(rootValue, "dhId");
+    cJSON *command = cJSON_GetObjectItemCaseSensitive(rootValue, "Command");
+    if (type == nullptr || !cJSON_IsString(type) || (type->valuestring == nullptr) ||
+        dhId == nullptr || !cJSON_IsString(dhId) || (dhId->valuestring == nullptr) ||
+        command == nullptr || !cJSON_IsString(command) || (command->valuestring == nullptr)) {
+        cJSON_Delete(rootValue);
+        return DCAMERA_BAD_VALUE;
+    }
+    cJSON *timeValue = cJSON_GetObjectItemCaseSensitive(rootValue, "Value");
+    if (timeValue == nullptr || !cJSON_IsObject(timeValue)) {
+        cJSON_Delete(rootValue);
+        return DCAMERA_BAD_VALUE;
+    }
+    bool isValid = true;
+    int64_t originUs = GetTimeValue(timeValue, "OriginUs", isValid);
+    int64_t receiveUs = GetTimeValue(timeValue, "ReceiveUs", isValid);
+    int64_t transmitUs = GetTimeValue(timeValue, "TransmitUs", isValid);
+    if (!isValid) {
+        cJSON_Delete(rootValue);
+        return DCAMERA_BAD_VALUE;
+    }
+    type_ = type->valuestring;
+    dhId_ = dhId->valuestring;
+    command_ = command->valuestring;
+    originUs_ = originUs;
+    receiveUs_ = receiveUs;
+    transmitUs_ = transmitUs;
+    cJSON_Delete(rootValue);
+    return DCAMERA_OK;
+}
+
+bool DCameraTimeSyncCmd::IsReply() const
+{
+    return receiveUs_ > 0 && transmitUs_ > 0;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
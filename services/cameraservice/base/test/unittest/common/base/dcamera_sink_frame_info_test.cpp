@@ -190,5 +190,81 @@ HWTEST_F(DCameraSinkFrameInfoTest, dcamera_sink_frame_info_test_001, TestSize.Le
     ret = frame.Unmarshal(TEST_SINK_FRAME_INFO_JSON);
     EXPECT_EQ(DCAMERA_BAD_VALUE, ret);
 }
+
+/**
+ * @tc.name: dcamera_sink_frame_info_test_002.
+ * @tc.desc: Verify the temporal layer is carried and defaults to the base layer.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraSinkFrameInfoTest, dcamera_sink_frame_info_test_002, TestSize.Level1)
+{
+    DCameraSinkFrameInfo frame;
+    int32_t ret = frame.Unmarshal(TEST_SINK_FRAME_INFO_JSON_SENDT2);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(0, frame.layer_);
+
+    DCameraSinkFrameInfo sinkFrame;
+    sinkFrame.type_ = 0;
+    sinkFrame.index_ = 1;
+    sinkFrame.layer_ = 2;
+    std::string jsonStr;
+    sinkFrame.Marshal(jsonStr);
+    ret = frame.Unmarshal(jsonStr);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(sinkFrame.layer_, frame.layer_);
+}
+
+/**
+ * @tc.name: dcamera_sink_frame_info_test_003.
+ * @tc.desc: Verify the encode resolution is carried only after a switch.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraSinkFrameInfoTest, dcamera_sink_frame_info_test_003, TestSize.Level1)
+{
+    DCameraSinkFrameInfo frame;
+    int32_t ret = frame.Unmarshal(TEST_SINK_FRAME_INFO_JSON_SENDT2);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(0, frame.width_);
+    EXPECT_EQ(0, frame.height_);
+
+    DCameraSinkFrameInfo sinkFrame;
+    sinkFrame.type_ = 0;
+    sinkFrame.index_ = 1;
+    sinkFrame.width_ = 960;
+    sinkFrame.height_ = 540;
+    std::string jsonStr;
+    sinkFrame.Marshal(jsonStr);
+    ret = frame.Unmarshal(jsonStr);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(sinkFrame.width_, frame.width_);
+    EXPECT_EQ(sinkFrame.height_, frame.height_);
+}
+
+/**
+ * @tc.name: dcamera_sink_frame_info_test_004.
+ * @tc.desc: Verify the send sequence is optional.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraSinkFrameInfoTest, dcamera_sink_frame_info_test_004, TestSize.Level1)
+{
+    DCameraSinkFrameInfo frame;
+    int32_t ret = frame.Unmarshal(TEST_SINK_FRAME_INFO_JSON_SENDT2);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(-1, frame.seq_);
+
+    DCameraSinkFrameInfo sinkFrame;
+    sinkFrame.type_ = 0;
+    sinkFrame.index_ = 10;
+    sinkFrame.seq_ = 7;
+    std::string jsonStr;
+    sinkFrame.Marshal(jsonStr);
+    ret = frame.Unmarshal(jsonStr);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(sinkFrame.index_, frame.index_);
+    EXPECT_EQ(sinkFrame.seq_, frame.seq_);
+}
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "dcamera_protocol.h"
+#include "dcamera_time_sync_cmd.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraTimeSyncCmdTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void DCameraTimeSyncCmdTest::SetUpTestCase(void)
+{
+}
+
+void DCameraTimeSyncCmdTest::TearDownTestCase(void)
+{
+}
+
+void DCameraTimeSyncCmdTest::SetUp(void)
+{
+}
+
+void DCameraTimeSyncCmdTest::TearDown(void)
+{
+}
+
+static const std::string TEST_TIME_SYNC_CMD_JSON_LACK_VALUE = R"({
+    "Type": "OPERATION",
+    "dhId": "camrea_0",
+    "Command": "TIME_SYNC"
+})";
+
+static const std::string TEST_TIME_SYNC_CMD_JSON_VALUE_EXCEPTION = R"({
+    "Type": "OPERATION",
+    "dhId": "camrea_0",
+    "Command": "TIME_SYNC",
+    "Value": {"OriginUs": "0", "ReceiveUs": 0, "TransmitUs": 0}
+})";
+
+static const std::string TEST_TIME_SYNC_CMD_JSON_LACK_DHID = R"({
+    "Type": "OPERATION",
+    "Command": "TIME_SYNC",
+    "Value": {"OriginUs": 0, "ReceiveUs": 0, "TransmitUs": 0}
+})";
+
+/**
+ * @tc.name: dcamera_time_sync_cmd_001.
+ * @tc.desc: Verify TimeSyncCmd keeps microsecond timestamps across a round trip.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraTimeSyncCmdTest, dcamera_time_sync_cmd_001, TestSize.Level1)
+{
+    DCameraTimeSyncCmd cmd;
+    cmd.type_ = DCAMERA_PROTOCOL_TYPE_OPERATION;
+    cmd.dhId_ = "camrea_0";
+    cmd.command_ = DCAMERA_PROTOCOL_CMD_TIME_SYNC;
+    cmd.originUs_ = 1790000000123456;
+    EXPECT_FALSE(cmd.IsReply());
+    cmd.receiveUs_ = 1790000000223457;
+    cmd.transmitUs_ = 1790000000223501;
+
+    std::string jsonStr;
+    int32_t ret = cmd.Marshal(jsonStr);
+    EXPECT_EQ(DCAMERA_OK, ret);
+
+    DCameraTimeSyncCmd reply;
+    ret = reply.Unmarshal(jsonStr);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(cmd.command_, reply.command_);
+    EXPECT_EQ(cmd.originUs_, reply.originUs_);
+    EXPECT_EQ(cmd.receiveUs_, reply.receiveUs_);
+    EXPECT_EQ(cmd.transmitUs_, reply.transmitUs_);
+    EXPECT_TRUE(reply.IsReply());
+}
+
+/**
+ * @tc.name: dcamera_time_sync_cmd_002.
+ * @tc.desc: Verify TimeSyncCmd rejects malformed json.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraTimeSyncCmdTest, dcamera_time_sync_cmd_002, TestSize.Level1)
+{
+    DCameraTimeSyncCmd cmd;
+    std::string str = "0";
+    int32_t ret = cmd.Unmarshal(str);
+    EXPECT_EQ(DCAMERA_BAD_VALUE, ret);
+
+    ret = cmd.Unmarshal(TEST_TIME_SYNC_CMD_JSON_LACK_VALUE);
+    EXPECT_EQ(DCAMERA_BAD_VALUE, ret);
+
+    ret = cmd.Unmarshal(TEST_TIME_SYNC_CMD_JSON_VALUE_EXCEPTION);
+    EXPECT_EQ(DCAMERA_BAD_VALUE, ret);
+
+    ret = cmd.Unmarshal(TEST_TIME_SYNC_CMD_JSON_LACK_DHID);
+    EXPECT_EQ(DCAMERA_BAD_VALUE, ret);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
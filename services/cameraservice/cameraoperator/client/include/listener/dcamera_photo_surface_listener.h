@@ -17,6 +17,7 @@
 #define OHOS_DCAMERA_PHOTO_SURFACE_LISTENER_H
 
 #include "surface.h"
+#include "data_buffer.h"
 #include "icamera_operator.h"
 #include "iconsumer_surface.h"
 
@@ -29,6 +30,8 @@ public:
     void OnBufferAvailable() override;
 
 private:
+    std::shared_ptr<DataBuffer> WrapSurfaceBuffer(const sptr<SurfaceBuffer>& buffer, char *address, int32_t size);
+
     sptr<IConsumerSurface> surface_;
     std::shared_ptr<ResultCallback> callback_;
     const int32_t SURFACE_BUFFER_MAX_SIZE = 50 * 1024 * 1024;
@@ -15,7 +15,7 @@
 
 #include "dcamera_photo_surface_listener.h"
 
-#include <securec.h>
+#include <cinttypes>
 
 #include "data_buffer.h"
 #include "dcamera_hidumper.h"
@@ -49,33 +49,41 @@ void DCameraPhotoSurfaceListener::OnBufferAvailable()
         return;
     }
 
-    do {
-        char *address = static_cast<char *>(buffer->GetVirAddr());
-        int32_t size = -1;
-        buffer->GetExtraData()->ExtraGet("dataSize", size);
-        if (size <= 0) {
-            size = static_cast<int32_t>(buffer->GetSize());
-        }
-        if ((address == nullptr) || (size <= 0) || (size > SURFACE_BUFFER_MAX_SIZE)) {
-            DHLOGE("DCameraPhotoSurfaceListener invalid params, size: %{public}d", size);
-            break;
-        }
-        DHLOGI("DCameraPhotoSurfaceListener size: %{public}d", size);
-        std::shared_ptr<DataBuffer> dataBuffer = std::make_shared<DataBuffer>(size);
-        int32_t ret = memcpy_s(dataBuffer->Data(), dataBuffer->Capacity(), address, size);
-        if (ret != EOK) {
-            DHLOGE("DCameraPhotoSurfaceListener Memory Copy failed, ret: %{public}d", ret);
-            break;
-        }
+    char *address = static_cast<char *>(buffer->GetVirAddr());
+    int32_t size = -1;
+    buffer->GetExtraData()->ExtraGet("dataSize", size);
+    if (size <= 0) {
+        size = static_cast<int32_t>(buffer->GetSize());
+    }
+    if ((address == nullptr) || (size <= 0) || (size > SURFACE_BUFFER_MAX_SIZE)) {
+        DHLOGE("DCameraPhotoSurfaceListener invalid params, size: %{public}d", size);
+        surface_->ReleaseBuffer(buffer, -1);
+        return;
+    }
+    DHLOGI("DCameraPhotoSurfaceListener size: %{public}d", size);
+    std::shared_ptr<DataBuffer> dataBuffer = WrapSurfaceBuffer(buffer, address, size);
 #ifdef DUMP_DCAMERA_FILE
-        std::string name = std::to_string(photoCount_++) + SINK_PHOTO;
-        if (DcameraHidumper::GetInstance().GetDumpFlag() && (IsUnderDumpMaxSize(DUMP_PHOTO_PATH, name) == DCAMERA_OK)) {
-            DumpBufferToFile(DUMP_PHOTO_PATH, name, dataBuffer->Data(), dataBuffer->Size());
-        }
+    std::string name = std::to_string(photoCount_++) + SINK_PHOTO;
+    if (DcameraHidumper::GetInstance().GetDumpFlag() && (IsUnderDumpMaxSize(DUMP_PHOTO_PATH, name) == DCAMERA_OK)) {
+        DumpBufferToFile(DUMP_PHOTO_PATH, name, dataBuffer->Data(), dataBuffer->Size());
+    }
 #endif
-        callback_->OnPhotoResult(dataBuffer);
-    } while (0);
-    surface_->ReleaseBuffer(buffer, -1);
+    callback_->OnPhotoResult(dataBuffer);
+}
+
+std::shared_ptr<DataBuffer> DCameraPhotoSurfaceListener::WrapSurfaceBuffer(const sptr<SurfaceBuffer>& buffer,
+    char *address, int32_t size)
+{
+    // The surface buffer is held by the DataBuffer and returned to the surface once the last reference,
+    // normally the channel after sending the final fragment, is dropped.
+    sptr<IConsumerSurface> surface = surface_;
+    int64_t acquireTime = GetNowTimeStampUs();
+    auto releaser = [surface, buffer, acquireTime, size]() {
+        DHLOGI("DCameraPhotoSurfaceListener release photo buffer, size: %{public}d, held: %{public}" PRId64" us",
+            size, GetNowTimeStampUs() - acquireTime);
+        surface->ReleaseBuffer(buffer, -1);
+    };
+    return std::make_shared<DataBuffer>(reinterpret_cast<uint8_t *>(address), static_cast<size_t>(size), releaser);
 }
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
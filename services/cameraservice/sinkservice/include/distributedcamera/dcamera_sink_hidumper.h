@@ -33,6 +33,8 @@ enum class HidumpFlag {
     GET_VERSION_INFO,
     START_DUMP,
     STOP_DUMP,
+    GET_THREAD_POLICY,
+    RUN_THREAD_TEST,
 };
 
 struct CameraDumpInfo {
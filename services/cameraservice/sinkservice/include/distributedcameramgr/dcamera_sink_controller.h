@@ -25,6 +25,7 @@
 #include "icamera_sink_output.h"
 #include <mutex>
 #include <atomic>
+#include <set>
 #include "device_manager.h"
 #include "device_manager_callback.h"
 #include "property_carrier.h"
@@ -51,6 +52,7 @@ public:
     int32_t ChannelNeg(std::shared_ptr<DCameraChannelInfo>& info) override;
     int32_t DCameraNotify(std::shared_ptr<DCameraEvent>& events) override;
     int32_t UpdateSettings(std::vector<std::shared_ptr<DCameraSettings>>& settings) override;
+    int32_t RequestKeyFrame() override;
     int32_t GetCameraInfo(std::shared_ptr<DCameraInfo>& camInfo) override;
     int32_t OpenChannel(std::shared_ptr<DCameraOpenInfo>& openInfo) override;
     int32_t CloseChannel() override;
@@ -87,6 +89,7 @@ private:
     int32_t StartCaptureInner(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
     int32_t DCameraNotifyInner(int32_t type, int32_t result, std::string content);
     int32_t HandleReceivedData(std::shared_ptr<DataBuffer>& dataBuffer);
+    int32_t HandleTimeSync(const std::string& jsonStr, int64_t recvUs);
     void PostAuthorization(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
     bool CheckDeviceSecurityLevel(const std::string &srcDeviceId, const std::string &dstDeviceId);
     int32_t GetDeviceSecurityLevel(const std::string &udid);
@@ -95,6 +98,8 @@ private:
     void ProcessFrameTrigger(const AppExecFwk::InnerEvent::Pointer &event);
     void ProcessPostAuthorization(const AppExecFwk::InnerEvent::Pointer &event);
     int32_t CreateCtrlSession();
+    int32_t AddVideoSubscriber(std::shared_ptr<DCameraChannelInfo>& info);
+    void RemoveVideoSubscribers();
     int32_t CheckSensitive();
     bool CheckAclRight();
     bool IsIdenticalAccount(const std::string &networkId);
@@ -121,6 +126,8 @@ private:
     std::mutex channelLock_;
     std::string dhId_;
     std::string srcDevId_;
+    // Source devices that only watch the continuous stream opened by srcDevId_
+    std::set<std::string> videoSubscribers_;
     std::shared_ptr<DCameraSinkContrEventHandler> sinkCotrEventHandler_;
     std::shared_ptr<ICameraChannel> channel_;
     std::shared_ptr<ICameraOperator> operator_;
@@ -16,15 +16,15 @@
 #ifndef OHOS_DCAMERA_SINK_DATA_PROCESS_H
 #define OHOS_DCAMERA_SINK_DATA_PROCESS_H
 
-#include <condition_variable>
+#include <atomic>
+#include <deque>
 #include <mutex>
-#include <thread>
 
-#include "event_handler.h"
 #include "icamera_channel.h"
 #include "icamera_sink_data_process.h"
 #include "idata_process_pipeline.h"
 #include "image_common_type.h"
+#include "dcamera_executor.h"
 #include "dcamera_utils_tools.h"
 
 namespace OHOS {
@@ -44,27 +44,62 @@ public:
     void OnError(DataProcessErrorType errorType);
 
     int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) override;
+    int32_t RequestKeyFrame() override;
 
 private:
+    // Preview frames sent while photos are in flight, used to report the impact of a burst on the video stream
+    struct PreviewImpactStats {
+        std::atomic<int32_t> photosInFlight { 0 };
+        std::atomic<int64_t> lastFrameUs { 0 };
+        std::atomic<uint64_t> frames { 0 };
+        std::atomic<uint64_t> busyDrops { 0 };
+        std::atomic<int64_t> totalIntervalUs { 0 };
+        std::atomic<int64_t> maxIntervalUs { 0 };
+
+        void Reset();
+        void Record(bool sent);
+    };
+
+    struct WaitingSnapshot {
+        std::shared_ptr<DataBuffer> buffer;
+        int64_t feedUs;
+    };
+
     int32_t FeedStreamInner(std::shared_ptr<DataBuffer>& dataBuffer);
     VideoCodecType GetPipelineCodecType(DCEncodeType encodeType);
     Videoformat GetPipelineFormat(int32_t format);
-    void StartEventHandler();
     void SendDataAsync(const std::shared_ptr<DataBuffer>& buffer);
+    int32_t FeedSnapshot(const std::shared_ptr<DataBuffer>& buffer);
+    void PostSnapshotLocked(const std::shared_ptr<DataBuffer>& buffer);
+    void OnSnapshotSent(uint64_t bufferSize, int64_t sendCostUs);
+    void ResetSnapshotQueue();
     int32_t GetMaxFrameRate(std::shared_ptr<DCameraCaptureInfo>& captureInfo);
 
     const uint32_t DCAMERA_FPS_SIZE = 2;
+    const uint32_t DCAMERA_SNAPSHOT_MAX_PENDING = 4;
+    const uint32_t DCAMERA_SNAPSHOT_MAX_WAITING = 4;
+    const int64_t DCAMERA_SNAPSHOT_WAIT_MS = 3000;
+    const int64_t DCAMERA_US_PER_MS = 1000;
+    const int64_t DCAMERA_US_PER_S = 1000000;
 
     std::string dhId_;
     std::shared_ptr<DCameraCaptureInfo> captureInfo_;
     std::shared_ptr<ICameraChannel> channel_;
     std::shared_ptr<IDataProcessPipeline> pipeline_;
 
-    std::mutex eventMutex_;
-    std::thread eventThread_;
-    std::condition_variable eventCon_;
-    std::shared_ptr<AppExecFwk::EventHandler> eventHandler_;
+    std::shared_ptr<DCameraStrand> sendStrand_;
     FILE *dumpFile_ = nullptr;
+
+    std::mutex snapshotMutex_;
+    std::deque<WaitingSnapshot> waitingSnapshots_;
+    uint32_t pendingSnapshots_ = 0;
+    uint32_t burstShots_ = 0;
+    uint32_t droppedSnapshots_ = 0;
+    uint64_t burstBytes_ = 0;
+    int64_t burstStartUs_ = 0;
+    int64_t burstSendCostUs_ = 0;
+    bool snapshotStopped_ = false;
+    PreviewImpactStats previewImpact_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -48,6 +48,10 @@ public:
     void OnDataReceived(DCStreamType type, std::vector<std::shared_ptr<DataBuffer>>& dataBuffers);
 
     int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) override;
+    int32_t RequestKeyFrame() override;
+
+    int32_t AddVideoSubscriber(std::shared_ptr<DCameraChannelInfo>& info) override;
+    int32_t RemoveVideoSubscriber(const std::string& devId) override;
 
 private:
     void InitInner(DCStreamType type);
@@ -36,6 +36,7 @@ public:
     virtual int32_t FeedStream(std::shared_ptr<DataBuffer>& dataBuffer) = 0;
     virtual void Init() = 0;
     virtual int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) = 0;
+    virtual int32_t RequestKeyFrame() = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "dcamera_capture_info_cmd.h"
@@ -38,6 +39,9 @@ public:
     virtual int32_t OpenChannel(std::shared_ptr<DCameraChannelInfo>& info) = 0;
     virtual int32_t CloseChannel() = 0;
     virtual int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) = 0;
+    virtual int32_t RequestKeyFrame() = 0;
+    virtual int32_t AddVideoSubscriber(std::shared_ptr<DCameraChannelInfo>& info) = 0;
+    virtual int32_t RemoveVideoSubscriber(const std::string& devId) = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #include "dcamera_sink_hidumper.h"
 
 #include "dcamera_hidumper.h"
+#include "dcamera_thread_policy.h"
 #include "distributed_camera_errno.h"
 #include "distributed_camera_sink_service.h"
 #include "distributed_hardware_log.h"
@@ -31,6 +32,8 @@ const std::string ARGS_CAMERA_INFO = "--camNum";
 const std::string ARGS_START_DUMP = "--startdump";
 const std::string ARGS_STOP_DUMP = "--stopdump";
 const std::string ARGS_OPENED_INFO = "--opened";
+const std::string ARGS_THREAD_POLICY = "--threads";
+const std::string ARGS_THREAD_TEST = "--threadtest";
 
 const std::map<std::string, HidumpFlag> ARGS_MAP = {
     { ARGS_HELP, HidumpFlag::GET_HELP },
@@ -39,6 +42,8 @@ const std::map<std::string, HidumpFlag> ARGS_MAP = {
     { ARGS_VERSION_INFO, HidumpFlag::GET_VERSION_INFO },
     { ARGS_START_DUMP, HidumpFlag::START_DUMP },
     { ARGS_STOP_DUMP, HidumpFlag::STOP_DUMP },
+    { ARGS_THREAD_POLICY, HidumpFlag::GET_THREAD_POLICY },
+    { ARGS_THREAD_TEST, HidumpFlag::RUN_THREAD_TEST },
 };
 }
 
@@ -113,6 +118,16 @@ int32_t DcameraSinkHidumper::ProcessDump(const std::string& args, std::string& r
             result.append("Send stop dump order ok\n");
             break;
         }
+        case HidumpFlag::GET_THREAD_POLICY: {
+            DCameraThreadPolicy::GetInstance().Dump(result, false);
+            ret = DCAMERA_OK;
+            break;
+        }
+        case HidumpFlag::RUN_THREAD_TEST: {
+            DCameraThreadPolicy::GetInstance().Dump(result, true);
+            ret = DCAMERA_OK;
+            break;
+        }
         default: {
             ret = ShowIllegalInfomation(result);
             break;
@@ -166,7 +181,11 @@ void DcameraSinkHidumper::ShowHelp(std::string& result)
         .append("--startdump  ")
         .append(": dump camera data in /data/data/dcamera\n")
         .append("--stopdump   ")
-        .append(": stop dump camera data\n");
+        .append(": stop dump camera data\n")
+        .append("--threads    ")
+        .append(": dump the scheduling policy of each hot thread role\n")
+        .append("--threadtest ")
+        .append(": run the wakeup latency self-test of each hot thread role\n");
 }
 
 int32_t DcameraSinkHidumper::ShowIllegalInfomation(std::string& result)
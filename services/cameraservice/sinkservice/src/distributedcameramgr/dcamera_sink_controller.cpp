@@ -24,6 +24,8 @@
 #include "dcamera_client.h"
 #include "dcamera_metadata_setting_cmd.h"
 #include "dcamera_protocol.h"
+#include "dcamera_thread_policy.h"
+#include "dcamera_time_sync_cmd.h"
 #include "dcamera_utils_tools.h"
 
 #include "dcamera_sink_access_control.h"
@@ -154,6 +156,10 @@ int32_t DCameraSinkController::StopCapture()
 int32_t DCameraSinkController::ChannelNeg(std::shared_ptr<DCameraChannelInfo>& info)
 {
     DHLOGI("ChannelNeg dhId: %{public}s", GetAnonyString(dhId_).c_str());
+    CHECK_AND_RETURN_RET_LOG(info == nullptr, DCAMERA_BAD_VALUE, "ChannelNeg info is null");
+    if (!srcDevId_.empty() && !info->sourceDevId_.empty() && info->sourceDevId_ != srcDevId_) {
+        return AddVideoSubscriber(info);
+    }
     int32_t ret = output_->OpenChannel(info);
     if (ret != DCAMERA_OK) {
         DHLOGE("channel negotiate failed, dhId: %{public}s, ret: %{public}d", GetAnonyString(dhId_).c_str(), ret);
@@ -164,6 +170,33 @@ int32_t DCameraSinkController::ChannelNeg(std::shared_ptr<DCameraChannelInfo>& i
     return DCAMERA_OK;
 }
 
+int32_t DCameraSinkController::AddVideoSubscriber(std::shared_ptr<DCameraChannelInfo>& info)
+{
+    // The camera is already opened by another source, share its continuous stream instead of reopening it
+    DHLOGI("AddVideoSubscriber dhId: %{public}s, devId: %{public}s", GetAnonyString(dhId_).c_str(),
+        GetAnonyString(info->sourceDevId_).c_str());
+    std::lock_guard<std::mutex> autoLock(channelLock_);
+    int32_t ret = output_->AddVideoSubscriber(info);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("add video subscriber failed, dhId: %{public}s, ret: %{public}d", GetAnonyString(dhId_).c_str(), ret);
+        return ret;
+    }
+    videoSubscribers_.insert(info->sourceDevId_);
+    return DCAMERA_OK;
+}
+
+void DCameraSinkController::RemoveVideoSubscribers()
+{
+    for (auto& devId : videoSubscribers_) {
+        int32_t ret = output_->RemoveVideoSubscriber(devId);
+        if (ret != DCAMERA_OK) {
+            DHLOGE("remove video subscriber failed, devId: %{public}s, ret: %{public}d",
+                GetAnonyString(devId).c_str(), ret);
+        }
+    }
+    videoSubscribers_.clear();
+}
+
 int32_t DCameraSinkController::DCameraNotify(std::shared_ptr<DCameraEvent>& events)
 {
     DHLOGI("DCameraNotify dhId: %{public}s", GetAnonyString(dhId_).c_str());
@@ -230,6 +263,17 @@ int32_t DCameraSinkController::UpdateSettings(std::vector<std::shared_ptr<DCamer
     return DCAMERA_OK;
 }
 
+int32_t DCameraSinkController::RequestKeyFrame()
+{
+    DHLOGI("RequestKeyFrame dhId: %{public}s", GetAnonyString(dhId_).c_str());
+    CHECK_AND_RETURN_RET_LOG(output_ == nullptr, DCAMERA_BAD_VALUE, "output_ is null.");
+    int32_t ret = output_->RequestKeyFrame();
+    if (ret != DCAMERA_OK) {
+        DHLOGE("RequestKeyFrame failed, dhId: %{public}s, ret: %{public}d", GetAnonyString(dhId_).c_str(), ret);
+    }
+    return ret;
+}
+
 int32_t DCameraSinkController::GetCameraInfo(std::shared_ptr<DCameraInfo>& camInfo)
 {
     DHLOGI("GetCameraInfo dhId: %{public}s, session state: %{public}d", GetAnonyString(dhId_).c_str(), sessionState_);
@@ -325,6 +369,9 @@ int32_t DCameraSinkController::CloseChannel()
 {
     DHLOGI("DCameraSinkController CloseChannel Start, dhId: %{public}s", GetAnonyString(dhId_).c_str());
     std::lock_guard<std::mutex> autoLock(channelLock_);
+    if (output_ != nullptr) {
+        RemoveVideoSubscribers();
+    }
     if (!ManageSelectChannel::GetInstance().GetSinkConnect()) {
         DCameraSinkServiceIpc::GetInstance().DeleteSourceRemoteCamSrv(srcDevId_);
         if (channel_ == nullptr) {
@@ -752,6 +799,7 @@ int32_t DCameraSinkController::StartCaptureInner(std::vector<std::shared_ptr<DCa
     cameraResult_ = DCAMERA_OK;
     preparedSurface_ = nullptr;
     captureInfosCache_ = captureInfos;
+    int32_t captureSetupQos = DCameraThreadPolicy::GetInstance().GetFfrtQos(DCAMERA_THREAD_CAPTURE_SETUP);
     ffrt::submit([this]() {
         DHLOGI("Output initialization task start.");
         int32_t ret = output_->StartCapture(captureInfosCache_);
@@ -768,7 +816,7 @@ int32_t DCameraSinkController::StartCaptureInner(std::vector<std::shared_ptr<DCa
         AppExecFwk::InnerEvent::Pointer event = AppExecFwk::InnerEvent::Get(
             DCameraSinkContrEventHandler::EVENT_ENCODER_PREPARED, holder);
         sinkCotrEventHandler_->SendEvent(event);
-        }, {}, ffrt::task_attr().name("DCamSinkOutput").qos(ffrt::qos_user_initiated));
+        }, {}, ffrt::task_attr().name("DCamSinkOutput").qos(captureSetupQos));
 
     ffrt::submit([this]() {
         DHLOGI("Operator preparation task start.");
@@ -776,7 +824,7 @@ int32_t DCameraSinkController::StartCaptureInner(std::vector<std::shared_ptr<DCa
         AppExecFwk::InnerEvent::Pointer event = AppExecFwk::InnerEvent::Get(
             DCameraSinkContrEventHandler::EVENT_CAMERA_PREPARED, ret);
         sinkCotrEventHandler_->SendEvent(event);
-        }, {}, ffrt::task_attr().name("DCamOpPrepare").qos(ffrt::qos_user_initiated));
+        }, {}, ffrt::task_attr().name("DCamOpPrepare").qos(captureSetupQos));
 
     DHLOGI("StartCaptureInner has dispatched parallel tasks.");
     return DCAMERA_OK;
@@ -793,6 +841,7 @@ int32_t DCameraSinkController::DCameraNotifyInner(int32_t type, int32_t result,
 
 int32_t DCameraSinkController::HandleReceivedData(std::shared_ptr<DataBuffer>& dataBuffer)
 {
+    int64_t recvUs = GetNowTimeStampUs();
     DHLOGI("DCameraSinkController::HandleReceivedData dhId: %{public}s", GetAnonyString(dhId_).c_str());
     uint8_t *data = dataBuffer->Data();
     std::string jsonStr(reinterpret_cast<const char *>(data), dataBuffer->Capacity());
@@ -839,10 +888,37 @@ int32_t DCameraSinkController::HandleReceivedData(std::shared_ptr<DataBuffer>& d
         return UpdateSettings(metadataSettingCmd.value_);
     } else if ((!command.empty()) && (command.compare(DCAMERA_PROTOCOL_CMD_STOP_CAPTURE) == 0)) {
         return StopCapture();
+    } else if ((!command.empty()) && (command.compare(DCAMERA_PROTOCOL_CMD_REQUEST_KEYFRAME) == 0)) {
+        return RequestKeyFrame();
+    } else if ((!command.empty()) && (command.compare(DCAMERA_PROTOCOL_CMD_TIME_SYNC) == 0)) {
+        return HandleTimeSync(jsonStr, recvUs);
     }
     return DCAMERA_BAD_VALUE;
 }
 
+int32_t DCameraSinkController::HandleTimeSync(const std::string& jsonStr, int64_t recvUs)
+{
+    DCameraTimeSyncCmd timeSyncCmd;
+    int32_t ret = timeSyncCmd.Unmarshal(jsonStr);
+    CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "Time sync Unmarshal failed, ret: %{public}d", ret);
+    CHECK_AND_RETURN_RET_LOG(channel_ == nullptr, DCAMERA_BAD_VALUE, "channel_ is null.");
+    timeSyncCmd.dhId_ = dhId_;
+    timeSyncCmd.receiveUs_ = recvUs;
+    timeSyncCmd.transmitUs_ = GetNowTimeStampUs();
+    std::string replyStr = "";
+    ret = timeSyncCmd.Marshal(replyStr);
+    CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "Time sync Marshal failed, ret: %{public}d", ret);
+    std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(replyStr.length() + 1);
+    ret = memcpy_s(buffer->Data(), buffer->Capacity(),
+        reinterpret_cast<uint8_t *>(const_cast<char *>(replyStr.c_str())), replyStr.length());
+    CHECK_AND_RETURN_RET_LOG(ret != EOK, DCAMERA_BAD_VALUE, "Time sync memcpy_s failed, ret: %{public}d", ret);
+    ret = channel_->SendData(buffer);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("Time sync reply send failed, dhId: %{public}s ret: %{public}d", GetAnonyString(dhId_).c_str(), ret);
+    }
+    return ret;
+}
+
 bool DCameraSinkController::CheckAclRight()
 {
     if (userId_ == -1) {
@@ -17,6 +17,7 @@
 
 #include "anonymous_string.h"
 #include "dcamera_channel_sink_impl.h"
+#include "dcamera_executor.h"
 #include "dcamera_pipeline_sink.h"
 #include "dcamera_sink_data_process_listener.h"
 #include "dcamera_hidumper.h"
@@ -24,12 +25,12 @@
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 #include "metadata_utils.h"
-#include <sys/prctl.h>
 
 namespace OHOS {
 namespace DistributedHardware {
+
 DCameraSinkDataProcess::DCameraSinkDataProcess(const std::string& dhId, std::shared_ptr<ICameraChannel>& channel)
-    : dhId_(dhId), channel_(channel), eventHandler_(nullptr)
+    : dhId_(dhId), channel_(channel), sendStrand_(nullptr)
 {
     DHLOGI("DCameraSinkDataProcess Constructor dhId: %{public}s", GetAnonyString(dhId_).c_str());
 }
@@ -38,35 +39,18 @@ DCameraSinkDataProcess::~DCameraSinkDataProcess()
 {
     DHLOGI("DCameraSinkDataProcess delete dhId: %{public}s", GetAnonyString(dhId_).c_str());
     DumpFileUtil::CloseDumpFile(&dumpFile_);
-    if ((eventHandler_ != nullptr) && (eventHandler_->GetEventRunner() != nullptr)) {
-        eventHandler_->GetEventRunner()->Stop();
-    }
-    if (eventThread_.joinable()) {
-        eventThread_.join();
+    ResetSnapshotQueue();
+    if (sendStrand_ != nullptr) {
+        sendStrand_->Stop();
     }
-    eventHandler_ = nullptr;
+    sendStrand_ = nullptr;
 }
 
 void DCameraSinkDataProcess::Init()
 {
     DHLOGI("DCameraSinkDataProcess Init dhId: %{public}s", GetAnonyString(dhId_).c_str());
-    eventThread_ = std::thread([this]() { this->StartEventHandler(); });
-    std::unique_lock<std::mutex> lock(eventMutex_);
-    eventCon_.wait(lock, [this] {
-        return eventHandler_ != nullptr;
-    });
-}
-
-void DCameraSinkDataProcess::StartEventHandler()
-{
-    prctl(PR_SET_NAME, SINK_START_EVENT.c_str());
-    auto runner = AppExecFwk::EventRunner::Create(false);
-    {
-        std::lock_guard<std::mutex> lock(eventMutex_);
-        eventHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
-    }
-    eventCon_.notify_one();
-    runner->Run();
+    // SendData blocks on the channel and photos are paced on it, keep it off the shared workers
+    sendStrand_ = DCameraExecutor::GetInstance().CreateStrand(GetAnonyString(dhId_) + "/send", true);
 }
 
 int32_t DCameraSinkDataProcess::StartCapture(std::shared_ptr<DCameraCaptureInfo>& captureInfo)
@@ -77,6 +61,10 @@ int32_t DCameraSinkDataProcess::StartCapture(std::shared_ptr<DCameraCaptureInfo>
         captureInfo->format_, captureInfo->streamType_, captureInfo->encodeType_);
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, DUMP_DCAMERA_AFTER_ENC_FILENAME, &dumpFile_);
     captureInfo_ = captureInfo;
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        snapshotStopped_ = false;
+    }
     if (pipeline_ != nullptr) {
         DHLOGI("StartCapture %{public}s pipeline already exits", GetAnonyString(dhId_).c_str());
         return DCAMERA_OK;
@@ -116,9 +104,11 @@ int32_t DCameraSinkDataProcess::StopCapture()
         pipeline_->DestroyDataProcessPipeline();
         pipeline_ = nullptr;
     }
-    if (eventHandler_ != nullptr) {
+    // Stop the snapshot queue first, a send finishing now must not post waiting photos after the clear
+    ResetSnapshotQueue();
+    if (sendStrand_ != nullptr) {
         DHLOGI("StopCapture dhId: %{public}s, remove all events", GetAnonyString(dhId_).c_str());
-        eventHandler_->RemoveAllEvents();
+        sendStrand_->Clear();
     }
     return DCAMERA_OK;
 }
@@ -138,8 +128,7 @@ int32_t DCameraSinkDataProcess::FeedStream(std::shared_ptr<DataBuffer>& dataBuff
             break;
         }
         case SNAPSHOT_FRAME: {
-            SendDataAsync(dataBuffer);
-            break;
+            return FeedSnapshot(dataBuffer);
         }
         default: {
             DHLOGE("FeedStream %{public}s unknown stream type: %{public}d", GetAnonyString(dhId_).c_str(), type);
@@ -158,11 +147,141 @@ void DCameraSinkDataProcess::SendDataAsync(const std::shared_ptr<DataBuffer>& bu
         DHLOGD("SendData type: %{public}d output data ret: %{public}d, dhId: %{public}s, bufferSize: %{public}" PRIu64,
             captureInfo_->streamType_, ret, GetAnonyString(dhId_).c_str(), buffersSize);
     };
-    if (eventHandler_ != nullptr) {
-        eventHandler_->PostTask(sendFunc);
+    if (sendStrand_ != nullptr) {
+        sendStrand_->Post(sendFunc);
+    }
+}
+
+void DCameraSinkDataProcess::PreviewImpactStats::Reset()
+{
+    frames = 0;
+    busyDrops = 0;
+    totalIntervalUs = 0;
+    maxIntervalUs = 0;
+}
+
+void DCameraSinkDataProcess::PreviewImpactStats::Record(bool sent)
+{
+    int64_t nowUs = GetNowTimeStampUs();
+    int64_t lastUs = lastFrameUs.exchange(nowUs);
+    if (photosInFlight.load() <= 0) {
+        return;
+    }
+    if (!sent) {
+        busyDrops++;
+        return;
+    }
+    if (lastUs > 0) {
+        int64_t intervalUs = nowUs - lastUs;
+        frames++;
+        totalIntervalUs += intervalUs;
+        int64_t prev = maxIntervalUs.load();
+        while (intervalUs > prev && !maxIntervalUs.compare_exchange_weak(prev, intervalUs)) {
+        }
     }
 }
 
+int32_t DCameraSinkDataProcess::FeedSnapshot(const std::shared_ptr<DataBuffer>& buffer)
+{
+    CHECK_AND_RETURN_RET_LOG(sendStrand_ == nullptr, DCAMERA_BAD_VALUE, "sendStrand_ is uninit");
+    // Never block the photo listener, photos wait here while the channel is behind
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (snapshotStopped_) {
+        return DCAMERA_BAD_OPERATE;
+    }
+    if (pendingSnapshots_ < DCAMERA_SNAPSHOT_MAX_PENDING) {
+        PostSnapshotLocked(buffer);
+        return DCAMERA_OK;
+    }
+    if (waitingSnapshots_.size() < DCAMERA_SNAPSHOT_MAX_WAITING) {
+        waitingSnapshots_.push_back({ buffer, GetNowTimeStampUs() });
+        return DCAMERA_OK;
+    }
+    droppedSnapshots_++;
+    DHLOGE("FeedSnapshot %{public}s channel busy, drop photo, pending: %{public}u, dropped: %{public}u",
+        GetAnonyString(dhId_).c_str(), pendingSnapshots_, droppedSnapshots_);
+    return DCAMERA_TRANS_BUSY;
+}
+
+void DCameraSinkDataProcess::PostSnapshotLocked(const std::shared_ptr<DataBuffer>& buffer)
+{
+    if (pendingSnapshots_ == 0 && burstShots_ == 0) {
+        burstStartUs_ = GetNowTimeStampUs();
+        previewImpact_.Reset();
+    }
+    pendingSnapshots_++;
+    previewImpact_.photosInFlight++;
+
+    auto sendFunc = [this, buffer]() mutable {
+        std::shared_ptr<DataBuffer> sendBuffer = buffer;
+        int64_t startUs = GetNowTimeStampUs();
+        int32_t ret = channel_->SendData(sendBuffer);
+        int64_t costUs = GetNowTimeStampUs() - startUs;
+        DHLOGD("SendData snapshot ret: %{public}d, dhId: %{public}s, size: %{public}zu, cost: %{public}" PRId64" us",
+            ret, GetAnonyString(dhId_).c_str(), buffer->Size(), costUs);
+        OnSnapshotSent(static_cast<uint64_t>(buffer->Size()), costUs);
+    };
+    sendStrand_->Post(sendFunc);
+}
+
+void DCameraSinkDataProcess::OnSnapshotSent(uint64_t bufferSize, int64_t sendCostUs)
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (snapshotStopped_ || pendingSnapshots_ == 0) {
+        return;
+    }
+    pendingSnapshots_--;
+    previewImpact_.photosInFlight--;
+    burstShots_++;
+    burstBytes_ += bufferSize;
+    burstSendCostUs_ += sendCostUs;
+    int64_t nowUs = GetNowTimeStampUs();
+    while (!waitingSnapshots_.empty() && pendingSnapshots_ < DCAMERA_SNAPSHOT_MAX_PENDING) {
+        WaitingSnapshot waiting = waitingSnapshots_.front();
+        waitingSnapshots_.pop_front();
+        if (nowUs - waiting.feedUs > DCAMERA_SNAPSHOT_WAIT_MS * DCAMERA_US_PER_MS) {
+            droppedSnapshots_++;
+            DHLOGE("OnSnapshotSent %{public}s photo waited too long, drop it, dropped: %{public}u",
+                GetAnonyString(dhId_).c_str(), droppedSnapshots_);
+            continue;
+        }
+        PostSnapshotLocked(waiting.buffer);
+    }
+    if (pendingSnapshots_ != 0) {
+        return;
+    }
+
+    int64_t durationUs = std::max<int64_t>(GetNowTimeStampUs() - burstStartUs_, 1);
+    uint64_t previewFrames = previewImpact_.frames.load();
+    int64_t avgIntervalUs = (previewFrames == 0) ? 0 :
+        previewImpact_.totalIntervalUs.load() / static_cast<int64_t>(previewFrames);
+    DHLOGI("snapshot burst end dhId: %{public}s, shots: %{public}u, dropped: %{public}u, bytes: %{public}" PRIu64
+        ", duration: %{public}" PRId64" ms, shots/s: %{public}.2f, avg send: %{public}" PRId64" ms, preview frames: "
+        "%{public}" PRIu64", avg interval: %{public}" PRId64" us, max interval: %{public}" PRId64" us, preview busy "
+        "drops: %{public}" PRIu64, GetAnonyString(dhId_).c_str(), burstShots_, droppedSnapshots_, burstBytes_,
+        durationUs / DCAMERA_US_PER_MS, burstShots_ * static_cast<double>(DCAMERA_US_PER_S) / durationUs,
+        burstSendCostUs_ / burstShots_ / DCAMERA_US_PER_MS, previewFrames, avgIntervalUs,
+        previewImpact_.maxIntervalUs.load(), previewImpact_.busyDrops.load());
+    burstShots_ = 0;
+    droppedSnapshots_ = 0;
+    burstBytes_ = 0;
+    burstSendCostUs_ = 0;
+}
+
+void DCameraSinkDataProcess::ResetSnapshotQueue()
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    snapshotStopped_ = true;
+    // Tasks removed from the send strand never report back
+    previewImpact_.photosInFlight -= static_cast<int32_t>(pendingSnapshots_);
+    pendingSnapshots_ = 0;
+    waitingSnapshots_.clear();
+    burstShots_ = 0;
+    droppedSnapshots_ = 0;
+    burstBytes_ = 0;
+    burstSendCostUs_ = 0;
+}
+
 int32_t DCameraSinkDataProcess::OnProcessedVideoBuffer(const std::shared_ptr<DataBuffer>& videoResult)
 {
 #ifdef DUMP_DCAMERA_FILE
@@ -171,11 +290,13 @@ int32_t DCameraSinkDataProcess::OnProcessedVideoBuffer(const std::shared_ptr<Dat
     }
 #endif
     DumpFileUtil::WriteDumpFile(dumpFile_, static_cast<void *>(videoResult->Data()), videoResult->Size());
-    if (eventHandler_ == nullptr) {
-        DHLOGE("eventHandler_ is uninit");
+    if (sendStrand_ == nullptr) {
+        DHLOGE("sendStrand_ is uninit");
         return DCAMERA_TRANS_BUSY;
     }
-    if (eventHandler_->IsIdle()) {
+    bool idle = sendStrand_->IsIdle() && !channel_->IsSendBusy();
+    previewImpact_.Record(idle);
+    if (idle) {
         SendDataAsync(videoResult);
         return DCAMERA_OK;
     } else {
@@ -245,6 +366,14 @@ int32_t DCameraSinkDataProcess::GetProperty(const std::string& propertyName, Pro
     return pipeline_->GetProperty(propertyName, propertyCarrier);
 }
 
+int32_t DCameraSinkDataProcess::RequestKeyFrame()
+{
+    std::shared_ptr<IDataProcessPipeline> pipeline = pipeline_;
+    CHECK_AND_RETURN_RET_LOG(pipeline == nullptr, DCAMERA_BAD_OPERATE, "RequestKeyFrame pipeline is null.");
+    DHLOGI("RequestKeyFrame dhId: %{public}s", GetAnonyString(dhId_).c_str());
+    return pipeline->RequestKeyFrame();
+}
+
 int32_t DCameraSinkDataProcess::GetMaxFrameRate(std::shared_ptr<DCameraCaptureInfo>& captureInfo)
 {
     int32_t maxFps = 0;
@@ -16,6 +16,7 @@
 #include "dcamera_sink_output.h"
 
 #include "anonymous_string.h"
+#include "dcamera_channel_sink_fanout.h"
 #include "dcamera_channel_sink_impl.h"
 #include "dcamera_client.h"
 #include "dcamera_sink_data_process.h"
@@ -58,9 +59,24 @@ int32_t DCameraSinkOutput::Init()
 
 void DCameraSinkOutput::InitInner(DCStreamType type)
 {
-    std::shared_ptr<ICameraChannel> channel = std::make_shared<DCameraChannelSinkImpl>();
+    std::shared_ptr<ICameraChannel> channel = nullptr;
+    std::shared_ptr<DCameraChannelSinkFanout> fanout = nullptr;
+    if (type == CONTINUOUS_FRAME) {
+        // One encoded stream is shared by every source device viewing this camera
+        fanout = std::make_shared<DCameraChannelSinkFanout>();
+        channel = fanout;
+    } else {
+        channel = std::make_shared<DCameraChannelSinkImpl>();
+    }
     std::shared_ptr<ICameraSinkDataProcess> dataProcess = std::make_shared<DCameraSinkDataProcess>(dhId_, channel);
     dataProcess->Init();
+    if (fanout != nullptr) {
+        std::weak_ptr<ICameraSinkDataProcess> weakProcess = dataProcess;
+        fanout->SetKeyFrameRequester([weakProcess]() {
+            std::shared_ptr<ICameraSinkDataProcess> process = weakProcess.lock();
+            return (process == nullptr) ? DCAMERA_BAD_OPERATE : process->RequestKeyFrame();
+        });
+    }
     dataProcesses_.emplace(type, dataProcess);
     channels_.emplace(type, channel);
     sessionState_.emplace(type, DCAMERA_CHANNEL_STATE_DISCONNECTED);
@@ -256,6 +272,40 @@ void DCameraSinkOutput::OnDataReceived(DCStreamType type, std::vector<std::share
 {
 }
 
+int32_t DCameraSinkOutput::AddVideoSubscriber(std::shared_ptr<DCameraChannelInfo>& info)
+{
+    CHECK_AND_RETURN_RET_LOG(info == nullptr, DCAMERA_BAD_VALUE, "AddVideoSubscriber info is null");
+    DHLOGI("AddVideoSubscriber dhId: %{public}s, devId: %{public}s", GetAnonyString(dhId_).c_str(),
+        GetAnonyString(info->sourceDevId_).c_str());
+    auto iterCh = channels_.find(CONTINUOUS_FRAME);
+    CHECK_AND_RETURN_RET_LOG(iterCh == channels_.end(), DCAMERA_BAD_OPERATE, "AddVideoSubscriber has no channel");
+    std::shared_ptr<DCameraChannelSinkFanout> fanout =
+        std::dynamic_pointer_cast<DCameraChannelSinkFanout>(iterCh->second);
+    CHECK_AND_RETURN_RET_LOG(fanout == nullptr, DCAMERA_BAD_OPERATE, "AddVideoSubscriber channel is not fan-out");
+    for (auto& detail : info->detail_) {
+        if (detail.streamType_ != CONTINUOUS_FRAME) {
+            continue;
+        }
+        std::vector<DCameraIndex> indexs;
+        indexs.push_back(DCameraIndex(info->sourceDevId_, dhId_));
+        return fanout->AddSubscriberSession(indexs, detail.dataSessionFlag_);
+    }
+    DHLOGE("AddVideoSubscriber %{public}s has no continuous session detail", GetAnonyString(dhId_).c_str());
+    return DCAMERA_BAD_VALUE;
+}
+
+int32_t DCameraSinkOutput::RemoveVideoSubscriber(const std::string& devId)
+{
+    DHLOGI("RemoveVideoSubscriber dhId: %{public}s, devId: %{public}s", GetAnonyString(dhId_).c_str(),
+        GetAnonyString(devId).c_str());
+    auto iterCh = channels_.find(CONTINUOUS_FRAME);
+    CHECK_AND_RETURN_RET_LOG(iterCh == channels_.end(), DCAMERA_BAD_OPERATE, "RemoveVideoSubscriber has no channel");
+    std::shared_ptr<DCameraChannelSinkFanout> fanout =
+        std::dynamic_pointer_cast<DCameraChannelSinkFanout>(iterCh->second);
+    CHECK_AND_RETURN_RET_LOG(fanout == nullptr, DCAMERA_BAD_OPERATE, "RemoveVideoSubscriber channel is not fan-out");
+    return fanout->RemoveSubscriber(devId);
+}
+
 int32_t DCameraSinkOutput::GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier)
 {
     if (dataProcesses_[CONTINUOUS_FRAME] == nullptr) {
@@ -264,5 +314,14 @@ int32_t DCameraSinkOutput::GetProperty(const std::string& propertyName, Property
     }
     return dataProcesses_[CONTINUOUS_FRAME]->GetProperty(propertyName, propertyCarrier);
 }
+
+int32_t DCameraSinkOutput::RequestKeyFrame()
+{
+    if (dataProcesses_[CONTINUOUS_FRAME] == nullptr) {
+        DHLOGD("RequestKeyFrame: continuous frame is nullptr.");
+        return DCAMERA_BAD_VALUE;
+    }
+    return dataProcesses_[CONTINUOUS_FRAME]->RequestKeyFrame();
+}
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
@@ -263,6 +263,28 @@ HWTEST_F(DCameraSinkControllerTest, dcamera_sink_controller_test_003, TestSize.L
     EXPECT_EQ(DCAMERA_OK, ret);
 }
 
+/**
+ * @tc.name: dcamera_sink_controller_test_channel_neg_001
+ * @tc.desc: Verify ChannelNeg from a second source shares the video stream until the channel closes.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSinkControllerTest, dcamera_sink_controller_test_channel_neg_001, TestSize.Level1)
+{
+    DCameraChannelInfoCmd cmd;
+    cmd.Unmarshal(TEST_CHANNEL_INFO_CMD_CONTINUE_JSON);
+    g_outputStr = "test_add_video_subscriber_failed";
+    EXPECT_EQ(DCAMERA_BAD_OPERATE, controller_->ChannelNeg(cmd.value_));
+    EXPECT_TRUE(controller_->videoSubscribers_.empty());
+
+    g_outputStr = "";
+    EXPECT_EQ(DCAMERA_OK, controller_->ChannelNeg(cmd.value_));
+    EXPECT_EQ(1u, controller_->videoSubscribers_.count(cmd.value_->sourceDevId_));
+
+    EXPECT_EQ(DCAMERA_OK, controller_->CloseChannel());
+    EXPECT_TRUE(controller_->videoSubscribers_.empty());
+}
+
 /**
  * @tc.name: dcamera_sink_controller_test_004
  * @tc.desc: Verify the StartCapture function.
@@ -253,6 +253,57 @@ HWTEST_F(DCameraSinkDataProcessTest, dcamera_sink_data_process_test_010, TestSiz
     int32_t ret = dataProcess_->GetProperty(propertyName, propertyCarrier);
     EXPECT_EQ(DCAMERA_OK, ret);
 }
+
+/**
+ * @tc.name: dcamera_sink_data_process_test_011
+ * @tc.desc: Verify the snapshot queue is released after StopCapture.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSinkDataProcessTest, dcamera_sink_data_process_test_011, TestSize.Level1)
+{
+    int32_t ret = dataProcess_->StartCapture(g_testCaptureInfoSnapshot);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    ret = dataProcess_->FeedStream(g_testDataBuffer);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+    EXPECT_EQ(0u, dataProcess_->pendingSnapshots_);
+
+    dataProcess_->StopCapture();
+    ret = dataProcess_->FeedStream(g_testDataBuffer);
+    EXPECT_EQ(DCAMERA_BAD_OPERATE, ret);
+}
+
+/**
+ * @tc.name: dcamera_sink_data_process_test_012
+ * @tc.desc: Verify FeedSnapshot queues or drops photos without blocking while the channel is behind.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSinkDataProcessTest, dcamera_sink_data_process_test_012, TestSize.Level1)
+{
+    int32_t ret = dataProcess_->StartCapture(g_testCaptureInfoSnapshot);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    {
+        std::lock_guard<std::mutex> lock(dataProcess_->snapshotMutex_);
+        dataProcess_->pendingSnapshots_ = dataProcess_->DCAMERA_SNAPSHOT_MAX_PENDING;
+        dataProcess_->previewImpact_.photosInFlight = static_cast<int32_t>(dataProcess_->pendingSnapshots_);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < dataProcess_->DCAMERA_SNAPSHOT_MAX_WAITING; i++) {
+        EXPECT_EQ(DCAMERA_OK, dataProcess_->FeedStream(g_testDataBuffer));
+    }
+    EXPECT_EQ(DCAMERA_TRANS_BUSY, dataProcess_->FeedStream(g_testDataBuffer));
+    auto costMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(costMs, dataProcess_->DCAMERA_SNAPSHOT_WAIT_MS);
+    EXPECT_EQ(dataProcess_->DCAMERA_SNAPSHOT_MAX_WAITING, dataProcess_->waitingSnapshots_.size());
+
+    dataProcess_->StopCapture();
+    EXPECT_TRUE(dataProcess_->waitingSnapshots_.empty());
+    EXPECT_EQ(0u, dataProcess_->pendingSnapshots_);
+    EXPECT_EQ(0, dataProcess_->previewImpact_.photosInFlight.load());
+}
 #endif
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
@@ -59,6 +59,11 @@ public:
     {
         return DCAMERA_OK;
     }
+
+    int32_t RequestKeyFrame()
+    {
+        return DCAMERA_OK;
+    }
 };
 } // namespace DistributedHardware
 } // namespace OHOS
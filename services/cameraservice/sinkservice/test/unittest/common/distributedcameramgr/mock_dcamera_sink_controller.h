@@ -55,6 +55,10 @@ public:
     {
         return DCAMERA_OK;
     }
+    int32_t RequestKeyFrame()
+    {
+        return DCAMERA_OK;
+    }
     int32_t GetCameraInfo(std::shared_ptr<DCameraInfo>& camInfo)
     {
         if (g_sinkCtrlStr == "test_004") {
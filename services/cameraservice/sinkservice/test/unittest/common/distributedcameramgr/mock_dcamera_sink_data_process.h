@@ -67,6 +67,10 @@ public:
     {
         return DCAMERA_OK;
     }
+    int32_t RequestKeyFrame()
+    {
+        return DCAMERA_OK;
+    }
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -90,6 +90,24 @@ public:
         return DCAMERA_OK;
     }
 
+    int32_t RequestKeyFrame() override
+    {
+        return DCAMERA_OK;
+    }
+
+    int32_t AddVideoSubscriber(std::shared_ptr<DCameraChannelInfo>& info) override
+    {
+        if (g_outputStr == "test_add_video_subscriber_failed") {
+            return DCAMERA_BAD_OPERATE;
+        }
+        return DCAMERA_OK;
+    }
+
+    int32_t RemoveVideoSubscriber(const std::string& devId) override
+    {
+        return DCAMERA_OK;
+    }
+
     std::string dhId_;
     std::shared_ptr<ICameraOperator> operator_;
 };
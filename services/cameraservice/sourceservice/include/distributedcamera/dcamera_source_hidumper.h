@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "dcamera_settings_coalescer.h"
 #include "single_instance.h"
 
 namespace OHOS {
@@ -33,6 +34,16 @@ enum class HidumpFlag {
     GET_VERSION_INFO,
     START_DUMP,
     STOP_DUMP,
+    START_RECORD,
+    STOP_RECORD,
+    GET_STATS,
+    START_WATCH,
+    STOP_WATCH,
+    GET_MEMORY_INFO,
+    GET_THREAD_POLICY,
+    RUN_THREAD_TEST,
+    GET_DECODER_INFO,
+    GET_SETTINGS_INFO,
 };
 
 typedef enum {
@@ -47,6 +58,7 @@ struct CameraDumpInfo {
     std::string version;
     int32_t regNumber;
     std::map<std::string, int32_t> curState;
+    std::map<std::string, DCameraSettingsStats> settingsStats;
 };
 
 class DcameraSourceHidumper {
@@ -66,6 +78,7 @@ private:
     int32_t GetRegisteredInfo(std::string& result);
     int32_t GetCurrentStateInfo(std::string& result);
     int32_t GetVersionInfo(std::string& result);
+    int32_t GetSettingsInfo(std::string& result);
 
 private:
     CameraDumpInfo camDumpInfo_;
@@ -19,6 +19,7 @@
 #include <set>
 
 #include "dcamera_index.h"
+#include "dcamera_settings_coalescer.h"
 #include "dcamera_source_event.h"
 #include "dcamera_source_state_machine.h"
 #include "event_handler.h"
@@ -42,6 +43,8 @@ const uint32_t EVENT_SOURCE_DEV_PROCESS = 0;
 const uint32_t EVENT_HICOLLIE = 1;
 const uint32_t EVENT_PROCESS_HDF_NOTIFY = 2;
 const uint32_t EVENT_DCAMERA_FORCE_SWITCH = 4;
+const uint32_t EVENT_REQUEST_KEY_FRAME = 5;
+const uint32_t EVENT_UPDATE_SETTINGS = 6;
 class DCameraSourceDev : public std::enable_shared_from_this<DCameraSourceDev> {
 public:
     explicit DCameraSourceDev(std::string devId, std::string dhId, std::shared_ptr<ICameraStateListener>& stateLisener);
@@ -72,6 +75,8 @@ public:
     int32_t GetFullCaps();
     void SetTokenId(uint64_t token);
     int32_t UpdateDCameraWorkMode(const WorkModeParam& param);
+    int32_t RequestKeyFrame();
+    DCameraSettingsStats GetSettingsStats();
 
     class DCameraSourceDevEventHandler : public AppExecFwk::EventHandler {
         public:
@@ -109,6 +114,8 @@ private:
     void DoProcessData(const AppExecFwk::InnerEvent::Pointer &event);
     void DoProcesHDFEvent(const AppExecFwk::InnerEvent::Pointer &event);
     void DoHicollieProcess();
+    void DoRequestKeyFrame();
+    void DoUpdateSettings(const AppExecFwk::InnerEvent::Pointer &event);
 
 private:
     std::string devId_;
@@ -124,6 +131,7 @@ private:
     sptr<IDCameraProviderCallback> hdiCallback_;
     int32_t sceneMode_ = 0;
     uint64_t tokenId_ = 0;
+    DCameraSettingsCoalescer settingsCoalescer_;
 
     std::map<uint32_t, DCameraNotifyFunc> memberFuncMap_;
     std::map<uint32_t, DCameraEventResult> eventResultMap_;
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_SETTINGS_COALESCER_H
+#define OHOS_DCAMERA_SETTINGS_COALESCER_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "v1_1/dcamera_types.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+using namespace OHOS::HDI::DistributedCamera::V1_1;
+
+struct DCameraSettingsStats {
+    // Settings batches handed over by the hal
+    uint64_t requestNum = 0;
+    // Merged batches actually executed
+    uint64_t dispatchNum = 0;
+    // Pending entries dropped by close or unregister
+    uint64_t dropNum = 0;
+    // Metadata tags plus other setting types waiting for the next dispatch
+    uint32_t pendingDepth = 0;
+    uint32_t maxPendingDepth = 0;
+};
+
+/*
+ * Collects settings updates while a dispatch is already queued on the source dev event handler.
+ * UPDATE_METADATA payloads are merged per metadata tag and every other setting type per type, the
+ * latest value always wins, so a burst of updates from the hal reaches the sink as one command.
+ * Any other command queued behind a batch seals it, later updates open a new batch behind that
+ * command, so settings never overtake or fall behind the commands the hal sent around them.
+ */
+class DCameraSettingsCoalescer {
+public:
+    // Returns true when a new batch was opened and the caller has to post a dispatch for batchId
+    bool Submit(const std::vector<std::shared_ptr<DCameraSettings>>& settings, uint64_t& batchId);
+    // Called before a non-settings command is queued, later submits go into a new batch
+    void Seal();
+    // Called by the queued dispatch, returns nothing if the batch has been dropped
+    std::vector<std::shared_ptr<DCameraSettings>> Take(uint64_t batchId);
+    // Called before stop, close or unregister is queued, the queued dispatches then run empty
+    void Drop();
+    DCameraSettingsStats GetStats();
+
+private:
+    struct TagEntry {
+        uint8_t dataType = 0;
+        uint32_t count = 0;
+        std::vector<uint8_t> data;
+    };
+    struct PendingSetting {
+        uint64_t seq = 0;
+        std::shared_ptr<DCameraSettings> setting;
+    };
+    struct Batch {
+        uint64_t id = 0;
+        uint64_t metadataSeq = 0;
+        std::map<uint32_t, TagEntry> metadataTags;
+        std::map<DCSettingsType, PendingSetting> typedSettings;
+        // Payloads that could not be decoded are forwarded untouched and in order
+        std::vector<PendingSetting> rawSettings;
+    };
+
+    static bool MergeMetadata(Batch& batch, const std::string& value);
+    static std::shared_ptr<DCameraSettings> BuildMetadataSetting(const Batch& batch);
+    static uint32_t GetBatchDepth(const Batch& batch);
+    void UpdatePendingDepth();
+
+    std::mutex mutex_;
+    bool isOpen_ = false;
+    uint64_t nextSeq_ = 0;
+    uint64_t nextBatchId_ = 0;
+    std::deque<Batch> batches_;
+    DCameraSettingsStats stats_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_SETTINGS_COALESCER_H
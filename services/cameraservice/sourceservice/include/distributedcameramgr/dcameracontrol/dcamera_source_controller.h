@@ -42,6 +42,7 @@ public:
     int32_t ChannelNeg(std::shared_ptr<DCameraChannelInfo>& info) override;
     int32_t DCameraNotify(std::shared_ptr<DCameraEvent>& events) override;
     int32_t UpdateSettings(std::vector<std::shared_ptr<DCameraSettings>>& settings) override;
+    int32_t RequestKeyFrame() override;
     int32_t GetCameraInfo(std::shared_ptr<DCameraInfo>& camInfo) override;
     int32_t OpenChannel(std::shared_ptr<DCameraOpenInfo>& openInfo) override;
     int32_t CloseChannel() override;
@@ -61,6 +62,11 @@ private:
     void PostChannelDisconnectedEvent();
     int32_t PublishEnableLatencyMsg(const std::string& devId);
     void HandleReceivedData(std::shared_ptr<DataBuffer> &dataBuffer);
+    void HandleTimeSyncReply(const std::string& jsonStr, int64_t recvUs);
+    void StartTimeSyncPing();
+    void StopTimeSyncPing();
+    void PostTimeSyncPing(int64_t delayMs);
+    void SendTimeSyncPing();
     bool CheckAclRight();
     bool GetOsAccountInfo();
     int32_t CheckOsType(const std::string &networkId, bool &isInvalid);
@@ -108,6 +114,15 @@ private:
     int32_t userId_ = -1;
     std::string srcDevId_ = "";
     uint64_t tokenId_ = 0;
+
+    // Clock pings on the control channel for the offset and drift estimate of the sink clock
+    static constexpr int64_t TIME_SYNC_INTERVAL_MS = 1000;
+    const std::string TIME_SYNC_TASK = "DCameraSourceController:TimeSync";
+    std::mutex timeSyncMtx_;
+    std::shared_ptr<AppExecFwk::EventHandler> timeSyncHandler_;
+    // Taken in Init under timeSyncMtx_, the ping task never reads indexs_ or channel_ directly
+    std::string timeSyncDhId_;
+    std::shared_ptr<ICameraChannel> timeSyncChannel_;
 };
 
 class DeviceInitCallback : public DmInitCallback {
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_FRAME_LOSS_DETECTOR_H
+#define OHOS_DCAMERA_FRAME_LOSS_DETECTOR_H
+
+#include <cstdint>
+#include <mutex>
+
+#include "dcamera_frame_info.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Decides when the source asks the sink for a sync frame. A gap in the send sequence of the
+ * continuous stream, or a frame dropped before decoding, leaves the decoder without a reference
+ * until the next sync frame. The sink numbers only the frames it hands to the socket, so frames it
+ * sheds on purpose never show up as a gap. Requests are coalesced while one is outstanding and
+ * repeated only if no sync frame arrives within the retry interval.
+ */
+class DCameraFrameLossDetector {
+public:
+    DCameraFrameLossDetector() = default;
+    ~DCameraFrameLossDetector() = default;
+
+    bool OnFrameReceived(const DCameraFrameInfo& frameInfo, int64_t nowUs);
+    bool OnFrameLost(int64_t nowUs);
+    void Reset();
+    uint64_t GetLostFrameNum();
+    uint64_t GetRequestNum();
+
+private:
+    bool TryRequest(int64_t nowUs);
+
+    // Same value as AVCODEC_BUFFER_FLAG_NONE, any other frame type restarts decoding
+    static constexpr int8_t FRAME_TYPE_NONE = 0;
+    static constexpr int64_t MIN_REQUEST_INTERVAL_US = 100000;
+    static constexpr int64_t RETRY_INTERVAL_US = 500000;
+
+    std::mutex mutex_;
+    int32_t lastSeq_ = -1;
+    bool isWaitingSyncFrame_ = false;
+    bool isRequestPending_ = false;
+    int64_t lastRequestUs_ = 0;
+    uint64_t lostFrameNum_ = 0;
+    uint64_t requestNum_ = 0;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_FRAME_LOSS_DETECTOR_H
@@ -42,6 +42,7 @@ public:
     void GetAllStreamIds(std::vector<int32_t>& streamIds) override;
     int32_t UpdateProducerWorkMode(std::vector<int32_t>& streamIds, const WorkModeParam& param) override;
     int32_t UpdateSettings(const std::vector<std::shared_ptr<DCameraSettings>>& settings) override;
+    void SetFrameLostCallback(FrameLostCallback callback) override;
 
 private:
     void DestroyPipeline();
@@ -54,6 +55,7 @@ private:
     std::string dhId_;
     DCStreamType streamType_;
     bool isFirstContStream_;
+    FrameLostCallback frameLostCallback_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -21,6 +21,9 @@
 #include "icamera_input.h"
 #include "icamera_source_data_process.h"
 
+#include "dcamera_clock_estimator.h"
+#include "dcamera_executor.h"
+#include "dcamera_frame_loss_detector.h"
 #include "dcamera_source_dev.h"
 #include "distributed_camera_errno.h"
 
@@ -52,9 +55,13 @@ public:
 private:
     void FinshFrameAsyncTrace(DCStreamType streamType);
     void PostChannelDisconnectedEvent();
+    void OnDecodeFrameLost();
+    void RequestKeyFrame();
     int32_t EstablishContinuousFrameSession(std::vector<DCameraIndex>& indexs);
     int32_t EstablishSnapshotFrameSession(std::vector<DCameraIndex>& indexs);
     int32_t WaitForOpenChannelCompletion(bool needWait);
+    int32_t ReserveStreamMemory(const std::vector<std::shared_ptr<DCStreamInfo>>& continueStreams,
+        const std::vector<std::shared_ptr<DCStreamInfo>>& snapStreams);
 
 private:
     std::map<DCStreamType, std::shared_ptr<ICameraChannel>> channels_;
@@ -64,9 +71,14 @@ private:
     std::string devId_;
     std::string dhId_;
     std::weak_ptr<DCameraSourceDev> camDev_;
+    DCameraFrameLossDetector lossDetector_;
+    std::shared_ptr<DCameraClockEstimator> clockEstimator_;
 
     bool isInit = false;
 
+    // Decoder output, scale output and queued frames held per configured stream
+    static constexpr int64_t CONTINUOUS_RESERVED_FRAMES = 8;
+    static constexpr int64_t SNAPSHOT_RESERVED_FRAMES = 2;
     static constexpr uint8_t CHANNEL_REL_SECONDS = 5;
     std::atomic<bool> isChannelConnected_ = false;
     std::mutex channelMtx_;
@@ -78,8 +90,7 @@ private:
     std::condition_variable isOpenChannelCond_;
     std::atomic<int32_t> continuousFrameResult_ = DCAMERA_OK;
     std::atomic<int32_t> snapshotFrameResult_ = DCAMERA_OK;
-    std::shared_ptr<AppExecFwk::EventRunner> runner_ = AppExecFwk::EventRunner::Create(true);
-    std::shared_ptr<AppExecFwk::EventHandler> handler_ = std::make_shared<AppExecFwk::EventHandler>(runner_);
+    std::shared_ptr<DCameraStrand> openStrand_ = nullptr;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
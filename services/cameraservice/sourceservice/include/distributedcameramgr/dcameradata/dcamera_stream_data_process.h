@@ -47,6 +47,7 @@ public:
     void DestroyPipeline();
     int32_t UpdateProducerWorkMode(std::vector<int32_t>& streamIds, const WorkModeParam& param);
     int32_t UpdateSettings(const std::vector<std::shared_ptr<DCameraSettings>>& settings);
+    void SetFrameLostCallback(ICameraSourceDataProcess::FrameLostCallback callback);
 
 private:
     void FeedStreamToSnapShot(const std::shared_ptr<DataBuffer>& buffer);
@@ -69,6 +70,7 @@ private:
     std::shared_ptr<IDataProcessPipeline> pipeline_;
     std::shared_ptr<DataProcessListener> listener_;
     std::map<uint32_t, std::shared_ptr<DCameraStreamDataProcessProducer>> producers_;
+    ICameraSourceDataProcess::FrameLostCallback frameLostCallback_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
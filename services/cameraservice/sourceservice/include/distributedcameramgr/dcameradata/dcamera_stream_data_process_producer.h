@@ -26,9 +26,11 @@
 #include <ashmem.h>
 
 #include "data_buffer.h"
-#include "event_handler.h"
 #include "v1_1/id_camera_provider.h"
+#include "dcamera_executor.h"
 #include "dcamera_feeding_smoother.h"
+#include "dcamera_memory_accountant.h"
+#include "dcamera_stats_manager.h"
 #include "idistributed_camera_source.h"
 
 namespace OHOS {
@@ -63,8 +65,10 @@ public:
     void UpdateProducerWorkMode(const WorkModeParam& param);
 
 private:
-    void StartEvent();
     void LooperSnapShot();
+    bool WaitSnapShot(std::shared_ptr<DataBuffer>& buffer);
+    int32_t FeedSnapShotToDriver(const DHBase& dhBase, const std::shared_ptr<DataBuffer>& buffer);
+    void OnSnapShotDelivered(const std::shared_ptr<DataBuffer>& buffer, uint32_t retries);
     int32_t FeedStreamToDriver(const DHBase& dhBase, const std::shared_ptr<DataBuffer>& buffer);
     int32_t CheckSharedMemory(const DCameraBuffer& sharedMemory, const std::shared_ptr<DataBuffer>& buffer);
     void WritePtsAndAddBuffer(const std::shared_ptr<DataBuffer>& buffer);
@@ -74,22 +78,25 @@ private:
     void UpdateVideoClock(uint64_t videoPtsUs);
 
     const uint32_t DCAMERA_PRODUCER_MAX_BUFFER_SIZE = 30;
+    const uint32_t DCAMERA_PRODUCER_MAX_SNAPSHOT_SIZE = 8;
+    const uint32_t DCAMERA_PRODUCER_RETRY_MIN_MS = 5;
     const uint32_t DCAMERA_PRODUCER_RETRY_SLEEP_MS = 500;
     const uint32_t DCAMERA_MAX_SYNC_BUFFER_SIZE = 10;
     const uint32_t DCAMERA_SYNC_WATERMARK = 1;
     const uint32_t DCAMERA_SYNC_TIME_INTERVAL = 33;
     const uint32_t DCAMERA_NS_TO_MS = 1000000;
     const uint32_t DCAMERA_US_TO_MS = 1000;
+    const uint32_t DCAMERA_US_TO_S = 1000000;
     const uint32_t DCAMERA_TIME_DIFF_MAX = 5;
     const int32_t DCAMERA_TIME_DIFF_MIN = -100;
+    static constexpr size_t STATS_QUEUE_BUFFERS = 0;
+    static constexpr size_t STATS_QUEUE_SYNC = 1;
 
 private:
     std::string devId_;
     std::string dhId_;
 
-    std::thread eventThread_;
     std::thread producerThread_;
-    std::condition_variable eventCon_;
     std::condition_variable producerCon_;
     std::mutex bufferMutex_;
     std::mutex eventMutex_;
@@ -99,7 +106,8 @@ private:
     uint32_t photoCount_;
     int32_t streamId_;
     DCStreamType streamType_;
-    std::shared_ptr<AppExecFwk::EventHandler> eventHandler_;
+    // Feeds the driver in smoother order, shared executor instead of a thread per stream
+    std::shared_ptr<DCameraStrand> feedStrand_;
 
     sptr<IDCameraProvider> camHdiProvider_;
     std::unique_ptr<IFeedingSmoother> smoother_ = nullptr;
@@ -115,6 +123,17 @@ private:
     WorkModeParam workModeParam_; // Audio-video synchronization fwk transfer structure
     std::mutex workModeParamMtx_;
     sptr<Ashmem> syncMem_ = nullptr; // Shared memory
+    std::string statsName_;
+    std::shared_ptr<DCameraNodeStats> nodeStats_ = nullptr;
+    std::shared_ptr<DCameraQueueMemory> buffersMemory_ = nullptr;
+    std::shared_ptr<DCameraQueueMemory> syncMemory_ = nullptr;
+
+    // Snapshot burst statistics, accessed under bufferMutex_
+    uint32_t burstShots_ = 0;
+    uint32_t burstRetries_ = 0;
+    uint32_t burstDropped_ = 0;
+    int64_t burstStartUs_ = 0;
+    bool snapshotInFlight_ = false;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -21,6 +21,7 @@
 #include <queue>
 #include <thread>
 #include <memory>
+#include "dcamera_stats_manager.h"
 #include "feeding_smoother_listener.h"
 #include "ifeedable_data.h"
 #include "time_statistician.h"
@@ -55,6 +56,7 @@ public:
     void SetAdjustSleepFactor(const float factor);
     void SetWaitClockFactor(const float factor);
     void SetTrackClockFactor(const float factor);
+    void SetNodeStats(const std::shared_ptr<DCameraNodeStats>& nodeStats);
     int64_t GetBufferTime();
     int64_t GetClockTime();
 
@@ -75,6 +77,9 @@ protected:
     std::shared_ptr<FeedingSmootherListener> listener_ = nullptr;
 
 private:
+    static constexpr size_t STATS_QUEUE_SMOOTH = 0;
+    // Feedable data carries no size, only frames and queue depth are counted here
+    std::shared_ptr<DCameraNodeStats> nodeStats_ = nullptr;
     SmoothState state_ = SMOOTH_STOP;
     std::thread smoothThread_;
     std::condition_variable smoothCon_;
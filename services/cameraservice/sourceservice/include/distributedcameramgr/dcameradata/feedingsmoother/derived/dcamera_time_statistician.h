@@ -47,6 +47,7 @@ public:
 
 private:
     int32_t frameIndex_ = -1;
+    int64_t recvFrameNum_ = 0;
     int64_t averEncodeTime_ = 0;
     int64_t encodeTimeSum_ = 0;
     int64_t averTransTime_ = 0;
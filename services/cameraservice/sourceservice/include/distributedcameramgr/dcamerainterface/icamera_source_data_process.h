@@ -16,6 +16,7 @@
 #ifndef OHOS_ICAMERA_SOURCE_DATA_PROCESS_H
 #define OHOS_ICAMERA_SOURCE_DATA_PROCESS_H
 
+#include <functional>
 #include <vector>
 
 #include "idistributed_camera_source.h"
@@ -55,6 +56,8 @@ public:
 
 class ICameraSourceDataProcess {
 public:
+    using FrameLostCallback = std::function<void()>;
+
     virtual ~ICameraSourceDataProcess() = default;
 
     virtual int32_t FeedStream(std::vector<std::shared_ptr<DataBuffer>>& buffers) = 0;
@@ -66,6 +69,7 @@ public:
     virtual void GetAllStreamIds(std::vector<int32_t>& streamIds) = 0;
     virtual int32_t UpdateProducerWorkMode(std::vector<int32_t>& streamIds, const WorkModeParam& param) = 0;
     virtual int32_t UpdateSettings(const std::vector<std::shared_ptr<DCameraSettings>>& settings) = 0;
+    virtual void SetFrameLostCallback(FrameLostCallback callback) = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -15,7 +15,13 @@
 
 #include "dcamera_source_hidumper.h"
 
+#include "dcamera_channel_recorder.h"
+#include "dcamera_decoder_budget.h"
 #include "dcamera_hidumper.h"
+#include "dcamera_memory_accountant.h"
+#include "dcamera_stats_manager.h"
+#include "dcamera_thread_policy.h"
+#include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_camera_source_service.h"
 #include "distributed_hardware_log.h"
@@ -31,6 +37,16 @@ const std::string ARGS_REGISTERED_INFO = "--registered";
 const std::string ARGS_CURRENTSTATE_INFO = "--curState";
 const std::string ARGS_START_DUMP = "--startdump";
 const std::string ARGS_STOP_DUMP = "--stopdump";
+const std::string ARGS_START_RECORD = "--startrecord";
+const std::string ARGS_STOP_RECORD = "--stoprecord";
+const std::string ARGS_STATS = "--stats";
+const std::string ARGS_START_WATCH = "--watch";
+const std::string ARGS_STOP_WATCH = "--stopwatch";
+const std::string ARGS_MEMORY_INFO = "--memory";
+const std::string ARGS_THREAD_POLICY = "--threads";
+const std::string ARGS_THREAD_TEST = "--threadtest";
+const std::string ARGS_DECODER_INFO = "--decoders";
+const std::string ARGS_SETTINGS_INFO = "--settings";
 const std::string STATE_INT = "Init";
 const std::string STATE_REGISTERED = "Registered";
 const std::string STATE_OPENED = "Opened";
@@ -44,6 +60,16 @@ const std::map<std::string, HidumpFlag> ARGS_MAP = {
     { ARGS_VERSION_INFO, HidumpFlag::GET_VERSION_INFO },
     { ARGS_START_DUMP, HidumpFlag::START_DUMP },
     { ARGS_STOP_DUMP, HidumpFlag::STOP_DUMP },
+    { ARGS_START_RECORD, HidumpFlag::START_RECORD },
+    { ARGS_STOP_RECORD, HidumpFlag::STOP_RECORD },
+    { ARGS_STATS, HidumpFlag::GET_STATS },
+    { ARGS_START_WATCH, HidumpFlag::START_WATCH },
+    { ARGS_STOP_WATCH, HidumpFlag::STOP_WATCH },
+    { ARGS_MEMORY_INFO, HidumpFlag::GET_MEMORY_INFO },
+    { ARGS_THREAD_POLICY, HidumpFlag::GET_THREAD_POLICY },
+    { ARGS_THREAD_TEST, HidumpFlag::RUN_THREAD_TEST },
+    { ARGS_DECODER_INFO, HidumpFlag::GET_DECODER_INFO },
+    { ARGS_SETTINGS_INFO, HidumpFlag::GET_SETTINGS_INFO },
 };
 
 const std::map<int32_t, std::string> STATE_MAP = {
@@ -126,6 +152,56 @@ int32_t DcameraSourceHidumper::ProcessDump(const std::string& args, std::string&
             result.append("Send stop dump order ok\n");
             break;
         }
+        case HidumpFlag::START_RECORD: {
+            ret = DCameraChannelRecorder::GetInstance().StartRecord(DUMP_PATH + "/" + DCAMERA_RECORD_FILE,
+                DUMP_PATH + "/" + DCAMERA_RECORD_INDEX_FILE);
+            result.append(ret == DCAMERA_OK ? "Start channel record ok\n" : "Start channel record failed\n");
+            break;
+        }
+        case HidumpFlag::STOP_RECORD: {
+            ret = DCameraChannelRecorder::GetInstance().StopRecord();
+            result.append("Stop channel record ok\n");
+            break;
+        }
+        case HidumpFlag::GET_STATS: {
+            DCameraStatsManager::GetInstance().Dump(result);
+            ret = DCAMERA_OK;
+            break;
+        }
+        case HidumpFlag::START_WATCH: {
+            ret = DCameraStatsManager::GetInstance().StartWatch();
+            result.append("Start stats watch ok, see hilog\n");
+            break;
+        }
+        case HidumpFlag::STOP_WATCH: {
+            ret = DCameraStatsManager::GetInstance().StopWatch();
+            result.append("Stop stats watch ok\n");
+            break;
+        }
+        case HidumpFlag::GET_MEMORY_INFO: {
+            DCameraMemoryAccountant::GetInstance().Dump(result);
+            ret = DCAMERA_OK;
+            break;
+        }
+        case HidumpFlag::GET_THREAD_POLICY: {
+            DCameraThreadPolicy::GetInstance().Dump(result, false);
+            ret = DCAMERA_OK;
+            break;
+        }
+        case HidumpFlag::RUN_THREAD_TEST: {
+            DCameraThreadPolicy::GetInstance().Dump(result, true);
+            ret = DCAMERA_OK;
+            break;
+        }
+        case HidumpFlag::GET_DECODER_INFO: {
+            DCameraDecoderBudget::GetInstance().Dump(result);
+            ret = DCAMERA_OK;
+            break;
+        }
+        case HidumpFlag::GET_SETTINGS_INFO: {
+            ret = GetSettingsInfo(result);
+            break;
+        }
         default: {
             ret = ShowIllegalInfomation(result);
             break;
@@ -175,6 +251,35 @@ int32_t DcameraSourceHidumper::GetVersionInfo(std::string& result)
     return DCAMERA_OK;
 }
 
+int32_t DcameraSourceHidumper::GetSettingsInfo(std::string& result)
+{
+    DHLOGI("GetSettingsInfo Dump.");
+    result.append("CameraId\tRequests\tDispatches\tDropped\tPending\tMaxPending\tCoalescingRatio\n");
+    for (const auto& item : camDumpInfo_.settingsStats) {
+        const DCameraSettingsStats& stats = item.second;
+        // Hal requests per command actually sent to the sink
+        std::string ratio = "-";
+        if (stats.dispatchNum > 0) {
+            ratio = std::to_string(static_cast<double>(stats.requestNum) / stats.dispatchNum);
+        }
+        result.append(item.first)
+              .append("\t")
+              .append(std::to_string(stats.requestNum))
+              .append("\t")
+              .append(std::to_string(stats.dispatchNum))
+              .append("\t")
+              .append(std::to_string(stats.dropNum))
+              .append("\t")
+              .append(std::to_string(stats.pendingDepth))
+              .append("\t")
+              .append(std::to_string(stats.maxPendingDepth))
+              .append("\t")
+              .append(ratio)
+              .append("\n");
+    }
+    return DCAMERA_OK;
+}
+
 void DcameraSourceHidumper::ShowHelp(std::string& result)
 {
     DHLOGI("ShowHelp Dump.");
@@ -191,7 +296,27 @@ void DcameraSourceHidumper::ShowHelp(std::string& result)
         .append("--startdump  ")
         .append(": dump camera data in /data/data/dcamera\n")
         .append("--stopdump   ")
-        .append(": stop dump camera data\n");
+        .append(": stop dump camera data\n")
+        .append("--startrecord")
+        .append(": record received channel data in /data/data/dcamera\n")
+        .append("--stoprecord ")
+        .append(": stop record channel data\n")
+        .append("--stats      ")
+        .append(": dump per stream pipeline node statistics\n")
+        .append("--watch      ")
+        .append(": log pipeline node statistics every second\n")
+        .append("--stopwatch  ")
+        .append(": stop logging pipeline node statistics\n")
+        .append("--memory     ")
+        .append(": dump frame memory budget, usage and high-water marks\n")
+        .append("--threads    ")
+        .append(": dump the scheduling policy of each hot thread role\n")
+        .append("--threadtest ")
+        .append(": run the wakeup latency self-test of each hot thread role\n")
+        .append("--decoders   ")
+        .append(": dump decoder backends in use and measured software decode throughput\n")
+        .append("--settings   ")
+        .append(": dump queued settings depth and coalescing ratio of each camera\n");
 }
 
 int32_t DcameraSourceHidumper::ShowIllegalInfomation(std::string& result)
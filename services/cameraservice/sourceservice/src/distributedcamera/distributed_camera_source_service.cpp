@@ -396,6 +396,7 @@ void DistributedCameraSourceService::GetDumpInfo(CameraDumpInfo& camDump)
         deviceId.append(cam.dhId_);
         int32_t devState = camSourceDev->GetStateInfo();
         curState[deviceId] = devState;
+        camDump.settingsStats[deviceId] = camSourceDev->GetSettingsStats();
     }
     camDump.curState = curState;
 }
@@ -113,6 +113,7 @@ int32_t DCameraSourceDev::RegisterDistributedHardware(const std::string& devId,
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(EVENT_SOURCE_DEV_PROCESS, eventParam, 0);
+    settingsCoalescer_.Seal();
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     return DCAMERA_OK;
 }
@@ -126,6 +127,7 @@ int32_t DCameraSourceDev::UnRegisterDistributedHardware(const std::string devId,
     std::string sourceAttrs;
     std::shared_ptr<DCameraRegistParam> regParam = std::make_shared<DCameraRegistParam>(devId, dhId, reqId, sinkAttrs,
         sourceAttrs);
+    settingsCoalescer_.Drop();
     DCameraSourceEvent event(DCAMERA_EVENT_UNREGIST, regParam);
     std::shared_ptr<DCameraSourceEvent> eventParam = std::make_shared<DCameraSourceEvent>(event);
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
@@ -152,6 +154,7 @@ int32_t DCameraSourceDev::DCameraNotify(std::string& eventStr)
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(EVENT_SOURCE_DEV_PROCESS, eventParam, 0);
+    settingsCoalescer_.Seal();
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     return DCAMERA_OK;
 }
@@ -165,6 +168,7 @@ int32_t DCameraSourceDev::OpenSession(DCameraIndex& camIndex)
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(EVENT_SOURCE_DEV_PROCESS, eventParam, 0);
+    settingsCoalescer_.Seal();
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     return DCAMERA_OK;
 }
@@ -173,6 +177,7 @@ int32_t DCameraSourceDev::CloseSession(DCameraIndex& camIndex)
 {
     DHLOGI("DCameraSourceDev PostTask CloseSession devId %{public}s dhId %{public}s", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str());
+    settingsCoalescer_.Drop();
     DCameraSourceEvent event(DCAMERA_EVENT_CLOSE, camIndex);
     std::shared_ptr<DCameraSourceEvent> eventParam = std::make_shared<DCameraSourceEvent>(event);
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
@@ -191,6 +196,7 @@ int32_t DCameraSourceDev::ConfigCameraStreams(const std::vector<std::shared_ptr<
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(EVENT_SOURCE_DEV_PROCESS, eventParam, 0);
+    settingsCoalescer_.Seal();
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     CHECK_AND_RETURN_RET_LOG(stateListener_ == nullptr, DCAMERA_BAD_VALUE, "stateListener_ is nullptr.");
     stateListener_->OnHardwareStateChanged(devId_, dhId_, DcameraBusinessState::RUNNING);
@@ -206,6 +212,7 @@ int32_t DCameraSourceDev::ReleaseCameraStreams(const std::vector<int>& streamIds
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(EVENT_SOURCE_DEV_PROCESS, eventParam, 0);
+    settingsCoalescer_.Seal();
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     return DCAMERA_OK;
 }
@@ -219,6 +226,7 @@ int32_t DCameraSourceDev::StartCameraCapture(const std::vector<std::shared_ptr<D
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(EVENT_SOURCE_DEV_PROCESS, eventParam, 0);
+    settingsCoalescer_.Seal();
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     return DCAMERA_OK;
 }
@@ -227,6 +235,7 @@ int32_t DCameraSourceDev::StopCameraCapture(const std::vector<int>& streamIds)
 {
     DHLOGI("DCameraSourceDev PostTask StopCapture devId %{public}s dhId %{public}s", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str());
+    settingsCoalescer_.Drop();
     DCameraSourceEvent event(DCAMERA_EVENT_STOP_CAPTURE, streamIds);
     std::shared_ptr<DCameraSourceEvent> eventParam = std::make_shared<DCameraSourceEvent>(event);
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
@@ -240,11 +249,15 @@ int32_t DCameraSourceDev::UpdateCameraSettings(const std::vector<std::shared_ptr
 {
     DHLOGI("DCameraSourceDev PostTask UpdateCameraSettings devId %{public}s dhId %{public}s",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
-    DCameraSourceEvent event(DCAMERA_EVENT_UPDATE_SETTINGS, settings);
-    std::shared_ptr<DCameraSourceEvent> eventParam = std::make_shared<DCameraSourceEvent>(event);
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
+    // Merged into the batch already queued, if no other command has been queued behind it
+    uint64_t batchId = 0;
+    if (!settingsCoalescer_.Submit(settings, batchId)) {
+        return DCAMERA_OK;
+    }
+    // Same priority as the other commands to keep the hal order, stop and close flush the batch instead
     AppExecFwk::InnerEvent::Pointer msgEvent =
-        AppExecFwk::InnerEvent::Get(EVENT_SOURCE_DEV_PROCESS, eventParam, 0);
+        AppExecFwk::InnerEvent::Get(EVENT_UPDATE_SETTINGS, static_cast<int64_t>(batchId));
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     return DCAMERA_OK;
 }
@@ -262,6 +275,7 @@ int32_t DCameraSourceDev::ProcessHDFEvent(const DCameraHDFEvent& event)
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(EVENT_PROCESS_HDF_NOTIFY, eventParam, 0);
+    settingsCoalescer_.Seal();
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     return DCAMERA_OK;
 }
@@ -295,6 +309,30 @@ void DCameraSourceDev::DoProcessData(const AppExecFwk::InnerEvent::Pointer &even
     NotifyResult((*eventParam).GetEventType(), (*eventParam), ret);
 }
 
+void DCameraSourceDev::DoUpdateSettings(const AppExecFwk::InnerEvent::Pointer &event)
+{
+    uint64_t batchId = static_cast<uint64_t>(event->GetParam());
+    std::vector<std::shared_ptr<DCameraSettings>> settings = settingsCoalescer_.Take(batchId);
+    if (settings.empty()) {
+        DHLOGI("DCameraSourceDev pending settings dropped, devId: %{public}s dhId: %{public}s",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+        return;
+    }
+    DCameraSourceEvent event(DCAMERA_EVENT_UPDATE_SETTINGS, settings);
+    CHECK_AND_RETURN_LOG(stateMachine_ == nullptr, "stateMachine_ is nullptr.");
+    int32_t ret = stateMachine_->Execute(event.GetEventType(), event);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSourceDev Execute failed, ret: %{public}d, devId: %{public}s dhId: %{public}s", ret,
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+    }
+    NotifyResult(event.GetEventType(), event, ret);
+}
+
+DCameraSettingsStats DCameraSourceDev::GetSettingsStats()
+{
+    return settingsCoalescer_.GetStats();
+}
+
 void DCameraSourceDev::DoProcesHDFEvent(const AppExecFwk::InnerEvent::Pointer &event)
 {
     std::shared_ptr<DCameraSourceEvent> eventParam = event->GetSharedObject<DCameraSourceEvent>();
@@ -333,6 +371,12 @@ void DCameraSourceDev::DCameraSourceDevEventHandler::ProcessEvent(const AppExecF
         case EVENT_PROCESS_HDF_NOTIFY:
             srcDevPtr->DoProcesHDFEvent(event);
             break;
+        case EVENT_REQUEST_KEY_FRAME:
+            srcDevPtr->DoRequestKeyFrame();
+            break;
+        case EVENT_UPDATE_SETTINGS:
+            srcDevPtr->DoUpdateSettings(event);
+            break;
         default:
             DHLOGE("event is undefined, id is %d", eventId);
             break;
@@ -845,6 +889,7 @@ int32_t DCameraSourceDev::OnChannelConnectedEvent()
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(EVENT_SOURCE_DEV_PROCESS, eventParam, 0);
+    settingsCoalescer_.Seal();
     srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     return DCAMERA_OK;
 }
@@ -853,6 +898,7 @@ int32_t DCameraSourceDev::OnChannelDisconnectedEvent()
 {
     DCameraIndex camIndex(devId_, dhId_);
     std::shared_ptr<DCameraIndex> index = std::make_shared<DCameraIndex>(camIndex);
+    settingsCoalescer_.Drop();
     DCameraSourceEvent event(DCAMERA_EVENT_CLOSE, camIndex);
     std::shared_ptr<DCameraSourceEvent> eventParam = std::make_shared<DCameraSourceEvent>(event);
     CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
@@ -877,6 +923,24 @@ int32_t DCameraSourceDev::PostHicollieEvent()
     return DCAMERA_OK;
 }
 
+int32_t DCameraSourceDev::RequestKeyFrame()
+{
+    CHECK_AND_RETURN_RET_LOG(srcDevEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "srcDevEventHandler_ is nullptr.");
+    AppExecFwk::InnerEvent::Pointer msgEvent = AppExecFwk::InnerEvent::Get(EVENT_REQUEST_KEY_FRAME);
+    srcDevEventHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+    return DCAMERA_OK;
+}
+
+void DCameraSourceDev::DoRequestKeyFrame()
+{
+    CHECK_AND_RETURN_LOG(controller_ == nullptr, "controller_ is nullptr.");
+    int32_t ret = controller_->RequestKeyFrame();
+    if (ret != DCAMERA_OK) {
+        DHLOGE("RequestKeyFrame failed, ret: %{public}d, devId: %{public}s, dhId: %{public}s", ret,
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+    }
+}
+
 void DCameraSourceDev::SetHicollieFlag(bool flag)
 {
     hicollieFlag_.store(flag);
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_settings_coalescer.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "dcamera_utils_tools.h"
+#include "distributed_hardware_log.h"
+#include "metadata_utils.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+size_t GetMetadataTypeSize(uint8_t dataType)
+{
+    switch (dataType) {
+        case META_TYPE_BYTE:
+            return sizeof(uint8_t);
+        case META_TYPE_INT32:
+        case META_TYPE_UINT32:
+        case META_TYPE_FLOAT:
+            return sizeof(int32_t);
+        case META_TYPE_INT64:
+        case META_TYPE_DOUBLE:
+        case META_TYPE_RATIONAL:
+            return sizeof(int64_t);
+        default:
+            return 0;
+    }
+}
+}
+
+bool DCameraSettingsCoalescer::Submit(const std::vector<std::shared_ptr<DCameraSettings>>& settings,
+    uint64_t& batchId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.requestNum++;
+    bool isNewBatch = !isOpen_ || batches_.empty();
+    if (isNewBatch) {
+        Batch batch;
+        batch.id = nextBatchId_++;
+        batches_.push_back(std::move(batch));
+        isOpen_ = true;
+    }
+    Batch& batch = batches_.back();
+    batchId = batch.id;
+    for (const auto& setting : settings) {
+        if (setting == nullptr) {
+            continue;
+        }
+        uint64_t seq = nextSeq_++;
+        if (setting->type_ == DCSettingsType::UPDATE_METADATA) {
+            if (MergeMetadata(batch, setting->value_)) {
+                batch.metadataSeq = seq;
+                continue;
+            }
+            DHLOGW("settings coalescer forward undecodable metadata");
+            batch.rawSettings.push_back({ seq, std::make_shared<DCameraSettings>(*setting) });
+            continue;
+        }
+        batch.typedSettings[setting->type_] = { seq, std::make_shared<DCameraSettings>(*setting) };
+    }
+    UpdatePendingDepth();
+    return isNewBatch;
+}
+
+void DCameraSettingsCoalescer::Seal()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isOpen_ = false;
+}
+
+std::vector<std::shared_ptr<DCameraSettings>> DCameraSettingsCoalescer::Take(uint64_t batchId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<DCameraSettings>> settings;
+    // Dispatches run in the order they were queued, a missing front means the batch was dropped
+    if (batches_.empty() || batches_.front().id != batchId) {
+        return settings;
+    }
+    Batch batch = std::move(batches_.front());
+    batches_.pop_front();
+    if (batches_.empty()) {
+        isOpen_ = false;
+    }
+    UpdatePendingDepth();
+    std::vector<PendingSetting> pending = batch.rawSettings;
+    for (const auto& typed : batch.typedSettings) {
+        pending.push_back(typed.second);
+    }
+    if (!batch.metadataTags.empty()) {
+        std::shared_ptr<DCameraSettings> setting = BuildMetadataSetting(batch);
+        if (setting != nullptr) {
+            pending.push_back({ batch.metadataSeq, setting });
+        }
+    }
+    // Keep the order the hal sent them in, an enable followed by a disable must stay that way
+    std::sort(pending.begin(), pending.end(), [](const PendingSetting& lhs, const PendingSetting& rhs) {
+        return lhs.seq < rhs.seq;
+    });
+    for (const auto& item : pending) {
+        settings.push_back(item.setting);
+    }
+    if (!settings.empty()) {
+        stats_.dispatchNum++;
+        DHLOGD("settings coalescer dispatch %{public}zu settings, requests %{public}" PRIu64 " dispatches "
+            "%{public}" PRIu64, settings.size(), stats_.requestNum, stats_.dispatchNum);
+    }
+    return settings;
+}
+
+void DCameraSettingsCoalescer::Drop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isOpen_ = false;
+    uint32_t depth = stats_.pendingDepth;
+    batches_.clear();
+    UpdatePendingDepth();
+    if (depth == 0) {
+        return;
+    }
+    DHLOGI("settings coalescer drop %{public}u pending settings", depth);
+    stats_.dropNum += depth;
+}
+
+DCameraSettingsStats DCameraSettingsCoalescer::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool DCameraSettingsCoalescer::MergeMetadata(Batch& batch, const std::string& value)
+{
+    std::shared_ptr<Camera::CameraMetadata> metadata = Camera::MetadataUtils::DecodeFromString(Base64Decode(value));
+    if (metadata == nullptr || metadata->get() == nullptr) {
+        return false;
+    }
+    uint32_t itemCount = Camera::GetCameraMetadataItemCount(metadata->get());
+    std::map<uint32_t, TagEntry> entries;
+    for (uint32_t index = 0; index < itemCount; index++) {
+        camera_metadata_item_t item;
+        if (Camera::GetCameraMetadataItem(metadata->get(), index, &item) != CAM_META_SUCCESS) {
+            return false;
+        }
+        size_t typeSize = GetMetadataTypeSize(item.data_type);
+        if (typeSize == 0) {
+            return false;
+        }
+        TagEntry entry;
+        entry.dataType = item.data_type;
+        entry.count = item.count;
+        entry.data.assign(item.data.u8, item.data.u8 + typeSize * item.count);
+        entries[item.item] = std::move(entry);
+    }
+    for (auto& entry : entries) {
+        batch.metadataTags[entry.first] = std::move(entry.second);
+    }
+    return true;
+}
+
+std::shared_ptr<DCameraSettings> DCameraSettingsCoalescer::BuildMetadataSetting(const Batch& batch)
+{
+    size_t dataSize = 0;
+    for (const auto& tag : batch.metadataTags) {
+        dataSize += tag.second.data.size();
+    }
+    auto metadata = std::make_shared<Camera::CameraMetadata>(batch.metadataTags.size(), dataSize);
+    for (const auto& tag : batch.metadataTags) {
+        if (!metadata->addEntry(tag.first, tag.second.data.data(), tag.second.count)) {
+            DHLOGE("settings coalescer add tag %{public}u failed", tag.first);
+            return nullptr;
+        }
+    }
+    std::string metadataStr = Camera::MetadataUtils::EncodeToString(metadata);
+    auto setting = std::make_shared<DCameraSettings>();
+    setting->type_ = DCSettingsType::UPDATE_METADATA;
+    setting->value_ = Base64Encode(reinterpret_cast<const unsigned char *>(metadataStr.c_str()),
+        metadataStr.length());
+    return setting;
+}
+
+uint32_t DCameraSettingsCoalescer::GetBatchDepth(const Batch& batch)
+{
+    return static_cast<uint32_t>(batch.metadataTags.size() + batch.typedSettings.size() + batch.rawSettings.size());
+}
+
+void DCameraSettingsCoalescer::UpdatePendingDepth()
+{
+    uint32_t depth = 0;
+    for (const auto& batch : batches_) {
+        depth += GetBatchDepth(batch);
+    }
+    stats_.pendingDepth = depth;
+    stats_.maxPendingDepth = std::max(stats_.maxPendingDepth, depth);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -31,6 +31,7 @@
 #include "dcamera_softbus_latency.h"
 #include "dcamera_source_controller_channel_listener.h"
 #include "dcamera_source_service_ipc.h"
+#include "dcamera_time_sync_cmd.h"
 #include "dcamera_utils_tools.h"
 #include "dcamera_hisysevent_adapter.h"
 
@@ -298,6 +299,43 @@ int32_t DCameraSourceController::UpdateSettings(std::vector<std::shared_ptr<DCam
     return DCAMERA_OK;
 }
 
+int32_t DCameraSourceController::RequestKeyFrame()
+{
+    if (indexs_.empty() || indexs_.size() > DCAMERA_MAX_NUM) {
+        DHLOGE("RequestKeyFrame not support operate %{public}zu camera", indexs_.size());
+        return DCAMERA_BAD_OPERATE;
+    }
+    std::string dhId = indexs_.begin()->dhId_;
+    std::string devId = indexs_.begin()->devId_;
+    cJSON *rootValue = cJSON_CreateObject();
+    CHECK_AND_RETURN_RET_LOG(rootValue == nullptr, DCAMERA_BAD_VALUE, "RequestKeyFrame create json failed.");
+    cJSON_AddStringToObject(rootValue, "Type", DCAMERA_PROTOCOL_TYPE_MESSAGE.c_str());
+    cJSON_AddStringToObject(rootValue, "dhId", dhId.c_str());
+    cJSON_AddStringToObject(rootValue, "Command", DCAMERA_PROTOCOL_CMD_REQUEST_KEYFRAME.c_str());
+    char *data = cJSON_PrintUnformatted(rootValue);
+    if (data == nullptr) {
+        cJSON_Delete(rootValue);
+        return DCAMERA_BAD_VALUE;
+    }
+    std::string jsonStr = std::string(data);
+    cJSON_Delete(rootValue);
+    cJSON_free(data);
+    std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(jsonStr.length() + 1);
+    int32_t ret = memcpy_s(buffer->Data(), buffer->Capacity(),
+        reinterpret_cast<uint8_t *>(const_cast<char *>(jsonStr.c_str())), jsonStr.length());
+    CHECK_AND_RETURN_RET_LOG(ret != EOK, ret, "RequestKeyFrame memcpy_s failed ret: %{public}d", ret);
+    CHECK_AND_RETURN_RET_LOG(channel_ == nullptr, DCAMERA_BAD_VALUE, "channel_ is null.");
+    ret = channel_->SendData(buffer);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("RequestKeyFrame SendData failed %{public}d, devId: %{public}s, dhId: %{public}s", ret,
+            GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
+        return ret;
+    }
+    DHLOGI("RequestKeyFrame devId: %{public}s, dhId: %{public}s success", GetAnonyString(devId).c_str(),
+        GetAnonyString(dhId).c_str());
+    return DCAMERA_OK;
+}
+
 int32_t DCameraSourceController::GetCameraInfo(std::shared_ptr<DCameraInfo>& camInfo)
 {
     if (!ManageSelectChannel::GetInstance().GetSrcConnect()) {
@@ -477,6 +515,7 @@ int32_t DCameraSourceController::CloseChannel()
     }
     cameraServiceRecipient_ = nullptr;
     DCameraLowLatency::GetInstance().DisableLowLatency();
+    StopTimeSyncPing();
     DCameraSoftbusLatency::GetInstance().StopSoftbusTimeSync(devId_);
     std::string dhId = indexs_.begin()->dhId_;
     std::string devId = indexs_.begin()->devId_;
@@ -530,6 +569,11 @@ int32_t DCameraSourceController::Init(std::vector<DCameraIndex>& indexs)
     controller_ = std::shared_ptr<DCameraSourceController>(shared_from_this());
     listener_ = std::make_shared<DCameraSourceControllerChannelListener>(controller_);
     channel_ = std::make_shared<DCameraChannelSourceImpl>();
+    {
+        std::lock_guard<std::mutex> lock(timeSyncMtx_);
+        timeSyncDhId_ = dhId;
+        timeSyncChannel_ = channel_;
+    }
     DHLOGI("DCameraSourceController Init GetProvider end devId: %{public}s, dhId: %{public}s",
         GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
     isInit = true;
@@ -539,9 +583,15 @@ int32_t DCameraSourceController::Init(std::vector<DCameraIndex>& indexs)
 int32_t DCameraSourceController::UnInit()
 {
     DHLOGI("DCameraSourceController UnInit");
+    isChannelConnected_.store(false);
+    StopTimeSyncPing();
+    {
+        std::lock_guard<std::mutex> lock(timeSyncMtx_);
+        timeSyncDhId_.clear();
+        timeSyncChannel_ = nullptr;
+    }
     indexs_.clear();
     isInit = false;
-    isChannelConnected_.store(false);
     if (remote_ != nullptr) {
         remote_->RemoveDeathRecipient(cameraHdiRecipient_);
     }
@@ -556,6 +606,7 @@ void DCameraSourceController::OnSessionState(int32_t state, std::string networkI
         case DCAMERA_CHANNEL_STATE_CONNECTED: {
             DcameraFinishAsyncTrace(DCAMERA_OPEN_CHANNEL_CONTROL, DCAMERA_OPEN_CHANNEL_TASKID);
             isChannelConnected_.store(true);
+            StartTimeSyncPing();
             CHECK_AND_RETURN_LOG(stateMachine_ == nullptr, "stateMachine_ is nullptr");
             stateMachine_->UpdateState(DCAMERA_STATE_OPENED);
             std::shared_ptr<DCameraSourceDev> camDev = camDev_.lock();
@@ -571,6 +622,7 @@ void DCameraSourceController::OnSessionState(int32_t state, std::string networkI
             DHLOGI("DCameraSourceDev PostTask Controller CloseSession OnClose devId %{public}s dhId %{public}s",
                 GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
             isChannelConnected_.store(false);
+            StopTimeSyncPing();
             PostChannelDisconnectedEvent();
             break;
         }
@@ -601,6 +653,7 @@ void DCameraSourceController::OnDataReceived(std::vector<std::shared_ptr<DataBuf
 
 void DCameraSourceController::HandleReceivedData(std::shared_ptr<DataBuffer>& dataBuffer)
 {
+    int64_t recvUs = GetNowTimeStampUs();
     CHECK_AND_RETURN_LOG(dataBuffer == nullptr, "dataBuffer is nullptr");
     DHLOGI("DCameraSourceController::HandleReceivedData dhId: %{public}s", GetAnonyString(dhId_).c_str());
     uint8_t *data = dataBuffer->Data();
@@ -628,6 +681,84 @@ void DCameraSourceController::HandleReceivedData(std::shared_ptr<DataBuffer>& da
             return;
         }
         DCameraNotify(cmd.value_);
+    } else if ((!command.empty()) && (command.compare(DCAMERA_PROTOCOL_CMD_TIME_SYNC) == 0)) {
+        HandleTimeSyncReply(jsonStr, recvUs);
+    }
+}
+
+void DCameraSourceController::HandleTimeSyncReply(const std::string& jsonStr, int64_t recvUs)
+{
+    DCameraTimeSyncCmd cmd;
+    int32_t ret = cmd.Unmarshal(jsonStr);
+    if (ret != DCAMERA_OK || !cmd.IsReply()) {
+        DHLOGE("DCameraSourceController time sync reply invalid, ret: %{public}d", ret);
+        return;
+    }
+    DCameraSoftbusLatency::GetInstance().AddTimeSyncSample(devId_, cmd.originUs_, cmd.receiveUs_, cmd.transmitUs_,
+        recvUs);
+}
+
+void DCameraSourceController::StartTimeSyncPing()
+{
+    std::lock_guard<std::mutex> lock(timeSyncMtx_);
+    CHECK_AND_RETURN_LOG(timeSyncChannel_ == nullptr, "time sync is not initialized");
+    if (timeSyncHandler_ == nullptr) {
+        timeSyncHandler_ = std::make_shared<AppExecFwk::EventHandler>(AppExecFwk::EventRunner::Create(true));
+    }
+    timeSyncHandler_->RemoveTask(TIME_SYNC_TASK);
+    PostTimeSyncPing(0);
+}
+
+void DCameraSourceController::StopTimeSyncPing()
+{
+    std::lock_guard<std::mutex> lock(timeSyncMtx_);
+    if (timeSyncHandler_ != nullptr) {
+        timeSyncHandler_->RemoveTask(TIME_SYNC_TASK);
+    }
+}
+
+void DCameraSourceController::PostTimeSyncPing(int64_t delayMs)
+{
+    std::weak_ptr<DCameraSourceController> weakController = shared_from_this();
+    auto task = [weakController]() {
+        std::shared_ptr<DCameraSourceController> controller = weakController.lock();
+        CHECK_AND_RETURN_LOG(controller == nullptr, "time sync controller is released");
+        controller->SendTimeSyncPing();
+    };
+    timeSyncHandler_->PostTask(task, TIME_SYNC_TASK, delayMs);
+}
+
+void DCameraSourceController::SendTimeSyncPing()
+{
+    std::string dhId;
+    std::shared_ptr<ICameraChannel> channel = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(timeSyncMtx_);
+        dhId = timeSyncDhId_;
+        channel = timeSyncChannel_;
+    }
+    if (!isChannelConnected_.load() || channel == nullptr || dhId.empty()) {
+        return;
+    }
+    DCameraTimeSyncCmd cmd;
+    cmd.type_ = DCAMERA_PROTOCOL_TYPE_MESSAGE;
+    cmd.dhId_ = dhId;
+    cmd.command_ = DCAMERA_PROTOCOL_CMD_TIME_SYNC;
+    cmd.originUs_ = GetNowTimeStampUs();
+    std::string jsonStr = "";
+    int32_t ret = cmd.Marshal(jsonStr);
+    if (ret == DCAMERA_OK) {
+        std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(jsonStr.length() + 1);
+        ret = memcpy_s(buffer->Data(), buffer->Capacity(),
+            reinterpret_cast<uint8_t *>(const_cast<char *>(jsonStr.c_str())), jsonStr.length());
+        ret = (ret == EOK) ? channel->SendData(buffer) : DCAMERA_BAD_VALUE;
+    }
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSourceController send time sync ping failed, ret: %{public}d", ret);
+    }
+    std::lock_guard<std::mutex> lock(timeSyncMtx_);
+    if (timeSyncHandler_ != nullptr && timeSyncChannel_ != nullptr && isChannelConnected_.load()) {
+        PostTimeSyncPing(TIME_SYNC_INTERVAL_MS);
     }
 }
 
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_frame_loss_detector.h"
+
+#include <cinttypes>
+
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+bool DCameraFrameLossDetector::OnFrameReceived(const DCameraFrameInfo& frameInfo, int64_t nowUs)
+{
+    // Older sinks do not send the sequence, their encoder index only skips frames up to a sync frame
+    int32_t seq = (frameInfo.seq >= 0) ? frameInfo.seq : frameInfo.index;
+    std::lock_guard<std::mutex> autoLock(mutex_);
+    int32_t lastSeq = lastSeq_;
+    lastSeq_ = seq;
+    if (frameInfo.type != FRAME_TYPE_NONE) {
+        isWaitingSyncFrame_ = false;
+        isRequestPending_ = false;
+        return false;
+    }
+    // A smaller sequence means the sink restarted numbering, there is nothing to compare with
+    if (lastSeq >= 0 && seq > lastSeq + 1) {
+        uint64_t lostNum = static_cast<uint64_t>(seq - lastSeq - 1);
+        lostFrameNum_ += lostNum;
+        isWaitingSyncFrame_ = true;
+        DHLOGI("Frame gap %{public}d -> %{public}d, lost %{public}" PRIu64 " frames.", lastSeq, seq, lostNum);
+    }
+    if (!isWaitingSyncFrame_) {
+        return false;
+    }
+    return TryRequest(nowUs);
+}
+
+bool DCameraFrameLossDetector::OnFrameLost(int64_t nowUs)
+{
+    std::lock_guard<std::mutex> autoLock(mutex_);
+    lostFrameNum_++;
+    isWaitingSyncFrame_ = true;
+    return TryRequest(nowUs);
+}
+
+void DCameraFrameLossDetector::Reset()
+{
+    std::lock_guard<std::mutex> autoLock(mutex_);
+    lastSeq_ = -1;
+    isWaitingSyncFrame_ = false;
+    isRequestPending_ = false;
+    lastRequestUs_ = 0;
+}
+
+uint64_t DCameraFrameLossDetector::GetLostFrameNum()
+{
+    std::lock_guard<std::mutex> autoLock(mutex_);
+    return lostFrameNum_;
+}
+
+uint64_t DCameraFrameLossDetector::GetRequestNum()
+{
+    std::lock_guard<std::mutex> autoLock(mutex_);
+    return requestNum_;
+}
+
+bool DCameraFrameLossDetector::TryRequest(int64_t nowUs)
+{
+    int64_t waitUs = isRequestPending_ ? RETRY_INTERVAL_US : MIN_REQUEST_INTERVAL_US;
+    if (lastRequestUs_ != 0 && nowUs - lastRequestUs_ < waitUs) {
+        return false;
+    }
+    lastRequestUs_ = nowUs;
+    isRequestPending_ = true;
+    requestNum_++;
+    return true;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -106,6 +106,7 @@ int32_t DCameraSourceDataProcess::ConfigStreams(std::vector<std::shared_ptr<DCSt
 
         std::shared_ptr<DCameraStreamDataProcess> streamProcess =
             std::make_shared<DCameraStreamDataProcess>(devId_, dhId_, streamType_);
+        streamProcess->SetFrameLostCallback(frameLostCallback_);
         std::shared_ptr<DCameraStreamConfig> streamConfig =
             std::make_shared<DCameraStreamConfig>(iter->first.width_, iter->first.height_, iter->first.format_,
             iter->first.dataspace_, iter->first.encodeType_, iter->first.type_);
@@ -240,5 +241,14 @@ int32_t DCameraSourceDataProcess::UpdateSettings(const std::vector<std::shared_p
     }
     return DCAMERA_OK;
 }
+
+void DCameraSourceDataProcess::SetFrameLostCallback(FrameLostCallback callback)
+{
+    std::lock_guard<std::mutex> autoLock(streamMutex_);
+    frameLostCallback_ = callback;
+    for (auto iter = streamProcess_.begin(); iter != streamProcess_.end(); iter++) {
+        (*iter)->SetFrameLostCallback(frameLostCallback_);
+    }
+}
 } // namespace DistributedHardware
 } // namespace OHOS
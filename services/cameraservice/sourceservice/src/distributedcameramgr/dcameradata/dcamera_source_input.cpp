@@ -15,12 +15,15 @@
 
 #include "anonymous_string.h"
 #include "dcamera_channel_source_impl.h"
+#include "dcamera_executor.h"
 #include "dcamera_hitrace_adapter.h"
 #include "dcamera_frame_info.h"
+#include "dcamera_memory_accountant.h"
 #include "dcamera_source_data_process.h"
 #include "dcamera_source_event.h"
 #include "dcamera_source_input.h"
 #include "dcamera_source_input_channel_listener.h"
+#include "dcamera_utils_tools.h"
 #include "dcamera_softbus_latency.h"
 #include "distributed_camera_constants.h"
 #include "distributed_hardware_log.h"
@@ -32,6 +35,9 @@ DCameraSourceInput::DCameraSourceInput(std::string devId, std::string dhId, std:
 {
     DHLOGI("DCameraSourceInput Constructor devId %{public}s dhId %{public}s", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str());
+    // CreateSession blocks on softbus, keep it off the shared workers
+    openStrand_ = DCameraExecutor::GetInstance().CreateStrand(GetAnonyString(devId_) + "/" +
+        GetAnonyString(dhId_) + "/openChannel", true);
 }
 
 DCameraSourceInput::~DCameraSourceInput()
@@ -41,6 +47,9 @@ DCameraSourceInput::~DCameraSourceInput()
     if (isInit) {
         UnInit();
     }
+    if (openStrand_ != nullptr) {
+        openStrand_->Stop();
+    }
 }
 
 int32_t DCameraSourceInput::ConfigStreams(std::vector<std::shared_ptr<DCStreamInfo>>& streamInfos)
@@ -77,6 +86,10 @@ int32_t DCameraSourceInput::ConfigStreams(std::vector<std::shared_ptr<DCStreamIn
             snapStreams.push_back(streamInfo);
         }
     }
+    ret = ReserveStreamMemory(continueStreams, snapStreams);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
     do {
         ret = dataProcess_[CONTINUOUS_FRAME]->ConfigStreams(continueStreams);
         if (ret != DCAMERA_OK) {
@@ -124,10 +137,32 @@ int32_t DCameraSourceInput::ReleaseStreams(std::vector<int>& streamIds, bool& is
     dataProcess_[SNAPSHOT_FRAME]->GetAllStreamIds(snapStreamIds);
     if (continueStreamIds.empty() && snapStreamIds.empty()) {
         isAllRelease = true;
+        DCameraMemoryAccountant::GetInstance().Unreserve(GetAnonyString(devId_) + "/" + GetAnonyString(dhId_));
     }
     return DCAMERA_OK;
 }
 
+int32_t DCameraSourceInput::ReserveStreamMemory(const std::vector<std::shared_ptr<DCStreamInfo>>& continueStreams,
+    const std::vector<std::shared_ptr<DCStreamInfo>>& snapStreams)
+{
+    int64_t bytes = 0;
+    for (const auto& streamInfo : continueStreams) {
+        bytes += DCameraMemoryAccountant::GetFrameBytes(streamInfo->width_, streamInfo->height_) *
+            CONTINUOUS_RESERVED_FRAMES;
+    }
+    for (const auto& streamInfo : snapStreams) {
+        bytes += DCameraMemoryAccountant::GetFrameBytes(streamInfo->width_, streamInfo->height_) *
+            SNAPSHOT_RESERVED_FRAMES;
+    }
+    int32_t ret = DCameraMemoryAccountant::GetInstance().Reserve(GetAnonyString(devId_) + "/" +
+        GetAnonyString(dhId_), bytes);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSourceInput ConfigStreams over memory budget devId %{public}s dhId %{public}s",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+    }
+    return ret;
+}
+
 int32_t DCameraSourceInput::StartCapture(std::vector<std::shared_ptr<DCCaptureInfo>>& captureInfos)
 {
     DHLOGI("DCameraSourceInput StartCapture devId %{public}s dhId %{public}s", GetAnonyString(devId_).c_str(),
@@ -231,24 +266,28 @@ int32_t DCameraSourceInput::OpenChannel(std::vector<DCameraIndex>& indexs)
     if (continuousNeeded) {
         needWait = true;
         DHLOGI("openChannel starting continuous frame session establishment");
-        auto task = [&]() {
+        // The wait below gives up after a timeout, so the task must not refer to the caller's stack
+        std::weak_ptr<DCameraSourceInput> weakInput = shared_from_this();
+        auto task = [weakInput, indexs]() mutable {
+            std::shared_ptr<DCameraSourceInput> input = weakInput.lock();
+            CHECK_AND_RETURN_LOG(input == nullptr, "openChannel continuous frame task input released");
             DHLOGI("openChannel continuous frame task started");
-            int32_t ret = EstablishContinuousFrameSession(indexs);
-            continuousFrameResult_.store(ret);
+            int32_t ret = input->EstablishContinuousFrameSession(indexs);
+            input->continuousFrameResult_.store(ret);
             if (ret != DCAMERA_OK) {
                 DHLOGE("esdablish continuous frame failed ret: %{public}d, devId: %{public}s, dhId: %{public}s", ret,
-                    GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+                    GetAnonyString(input->devId_).c_str(), GetAnonyString(input->dhId_).c_str());
             }
             {
-                std::unique_lock<std::mutex> lock(isOpenChannelMtx_);
-                isOpenChannelFinished_.store(true);
+                std::unique_lock<std::mutex> lock(input->isOpenChannelMtx_);
+                input->isOpenChannelFinished_.store(true);
             }
-            isOpenChannelCond_.notify_one();
+            input->isOpenChannelCond_.notify_one();
             DHLOGI("openChannel continuous frame task completed");
         };
-        CHECK_AND_RETURN_RET_LOG(handler_ == nullptr, DCAMERA_BAD_VALUE,
-            "DCameraSourceInput OpenChannel handler is nullptr");
-        handler_->PostTask(task, "DCameraSourceInput:OpenChannel", 0, AppExecFwk::EventQueue::Priority::HIGH);
+        CHECK_AND_RETURN_RET_LOG(openStrand_ == nullptr, DCAMERA_BAD_VALUE,
+            "DCameraSourceInput OpenChannel strand is nullptr");
+        openStrand_->Post(task);
     }
     if (snapshotNeeded) {
         DHLOGI("openChannel starting snapshot frame session establishment");
@@ -306,8 +345,16 @@ int32_t DCameraSourceInput::Init()
     DHLOGI("DCameraSourceInput Init devId %{public}s dhId %{public}s", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str());
     auto input = std::shared_ptr<DCameraSourceInput>(shared_from_this());
+    clockEstimator_ = DCameraSoftbusLatency::GetInstance().GetClockEstimator(devId_);
     std::shared_ptr<ICameraSourceDataProcess> conDataProcess = std::make_shared<DCameraSourceDataProcess>(devId_, dhId_,
         CONTINUOUS_FRAME);
+    std::weak_ptr<DCameraSourceInput> weakInput = input;
+    conDataProcess->SetFrameLostCallback([weakInput]() {
+        std::shared_ptr<DCameraSourceInput> sourceInput = weakInput.lock();
+        if (sourceInput != nullptr) {
+            sourceInput->OnDecodeFrameLost();
+        }
+    });
     std::shared_ptr<ICameraChannel> continueCh = std::make_shared<DCameraChannelSourceImpl>();
     std::shared_ptr<ICameraChannelListener> conListener =
         std::make_shared<DCameraSourceInputChannelListener>(input, CONTINUOUS_FRAME);
@@ -403,7 +450,12 @@ void DCameraSourceInput::OnDataReceived(DCStreamType streamType, std::vector<std
 {
     CHECK_AND_RETURN_LOG(buffers[0] == nullptr, "the first buffer is nullptr.");
     CHECK_AND_RETURN_LOG(dataProcess_[streamType] == nullptr, "dataProcess_ is nullptr.");
-    buffers[0]->frameInfo_.offset = DCameraSoftbusLatency::GetInstance().GetTimeSyncInfo(devId_);
+    if (clockEstimator_ != nullptr) {
+        buffers[0]->frameInfo_.offset = static_cast<int32_t>(clockEstimator_->GetOffsetUs(GetNowTimeStampUs()));
+    }
+    if (streamType == CONTINUOUS_FRAME && lossDetector_.OnFrameReceived(buffers[0]->frameInfo_, GetNowTimeStampUs())) {
+        RequestKeyFrame();
+    }
     int32_t ret = dataProcess_[streamType]->FeedStream(buffers);
     if (ret != DCAMERA_OK) {
         DHLOGE("OnDataReceived FeedStream %{public}d stream failed ret: %{public}d, devId: %{public}s, "
@@ -436,6 +488,7 @@ int32_t DCameraSourceInput::ReleaseAllStreams()
             ret, GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
         return ret;
     }
+    DCameraMemoryAccountant::GetInstance().Unreserve(GetAnonyString(devId_) + "/" + GetAnonyString(dhId_));
     return DCAMERA_OK;
 }
 
@@ -467,6 +520,26 @@ int32_t DCameraSourceInput::StopAllCapture()
     return DCAMERA_OK;
 }
 
+void DCameraSourceInput::OnDecodeFrameLost()
+{
+    if (lossDetector_.OnFrameLost(GetNowTimeStampUs())) {
+        RequestKeyFrame();
+    }
+}
+
+void DCameraSourceInput::RequestKeyFrame()
+{
+    std::shared_ptr<DCameraSourceDev> camDev = camDev_.lock();
+    if (camDev == nullptr) {
+        DHLOGE("DCameraSourceInput RequestKeyFrame camDev is nullptr");
+        return;
+    }
+    DHLOGI("RequestKeyFrame devId %{public}s dhId %{public}s, lost frames %{public}" PRIu64 ", requests %{public}"
+        PRIu64, GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), lossDetector_.GetLostFrameNum(),
+        lossDetector_.GetRequestNum());
+    camDev->RequestKeyFrame();
+}
+
 void DCameraSourceInput::PostChannelDisconnectedEvent()
 {
     std::shared_ptr<DCameraSourceDev> camDev = camDev_.lock();
@@ -479,6 +552,8 @@ void DCameraSourceInput::PostChannelDisconnectedEvent()
 
 int32_t DCameraSourceInput::EstablishContinuousFrameSession(std::vector<DCameraIndex>& indexs)
 {
+    // The sink numbers the frames per session
+    lossDetector_.Reset();
     DcameraStartAsyncTrace(DCAMERA_OPEN_DATA_CONTINUE, DCAMERA_OPEN_DATA_CONTINUE_TASKID);
     int32_t ret = channels_[CONTINUOUS_FRAME]->CreateSession(indexs, CONTINUE_SESSION_FLAG, DCAMERA_SESSION_MODE_VIDEO,
         listeners_[CONTINUOUS_FRAME]);
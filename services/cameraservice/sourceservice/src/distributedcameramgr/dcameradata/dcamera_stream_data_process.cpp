@@ -239,6 +239,14 @@ void DCameraStreamDataProcess::OnProcessedVideoBuffer(const std::shared_ptr<Data
 void DCameraStreamDataProcess::OnError(const DataProcessErrorType errorType)
 {
     DHLOGE("DCameraStreamDataProcess OnError pipeline errorType: %{public}d", errorType);
+    if (errorType == ERROR_PIPELINE_DECODER_FRAME_LOST && frameLostCallback_ != nullptr) {
+        frameLostCallback_();
+    }
+}
+
+void DCameraStreamDataProcess::SetFrameLostCallback(ICameraSourceDataProcess::FrameLostCallback callback)
+{
+    frameLostCallback_ = callback;
 }
 
 void DCameraStreamDataProcess::CreatePipeline()
@@ -251,7 +259,9 @@ void DCameraStreamDataProcess::CreatePipeline()
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
         return;
     }
-    pipeline_ = std::make_shared<DCameraPipelineSource>();
+    auto pipelineSource = std::make_shared<DCameraPipelineSource>();
+    pipelineSource->SetStatsName(GetAnonyString(devId_) + "/" + GetAnonyString(dhId_));
+    pipeline_ = pipelineSource;
     auto process = std::shared_ptr<DCameraStreamDataProcess>(shared_from_this());
     listener_ = std::make_shared<DCameraStreamDataProcessPipelineListener>(process);
     VideoConfigParams srcParams(GetPipelineCodecType(srcConfig_->encodeType_), GetPipelineFormat(srcConfig_->format_),
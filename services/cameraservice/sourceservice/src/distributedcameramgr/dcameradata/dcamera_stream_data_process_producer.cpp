@@ -15,12 +15,14 @@
 
 #include "dcamera_stream_data_process_producer.h"
 
+#include <algorithm>
 #include <chrono>
 #include <securec.h>
 
 #include "anonymous_string.h"
 #include "dcamera_buffer_handle.h"
 #include "dcamera_hidumper.h"
+#include "dcamera_thread_policy.h"
 #include "dcamera_utils_tools.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
@@ -32,7 +34,7 @@ namespace OHOS {
 namespace DistributedHardware {
 DCameraStreamDataProcessProducer::DCameraStreamDataProcessProducer(std::string devId, std::string dhId,
     int32_t streamId, DCStreamType streamType)
-    : devId_(devId), dhId_(dhId), streamId_(streamId), streamType_(streamType), eventHandler_(nullptr),
+    : devId_(devId), dhId_(dhId), streamId_(streamId), streamType_(streamType), feedStrand_(nullptr),
     camHdiProvider_(nullptr), workModeParam_(-1, 0, 0, false)
 {
     DHLOGI("DCameraStreamDataProcessProducer Constructor devId %{public}s dhId %{public}s streamType: %{public}d "
@@ -42,6 +44,13 @@ DCameraStreamDataProcessProducer::DCameraStreamDataProcessProducer(std::string d
     photoCount_ = COUNT_INIT_NUM;
     syncRunning_.store(false);
     isFirstFrame_.store(true);
+    statsName_ = GetAnonyString(devId_) + "/" + GetAnonyString(dhId_) + "/" + std::to_string(streamId_);
+    nodeStats_ = DCameraStatsManager::GetInstance().Register(statsName_, "producer", { "buffers", "sync" });
+    std::string memoryOwner = GetAnonyString(devId_) + "/" + GetAnonyString(dhId_);
+    buffersMemory_ = DCameraMemoryAccountant::GetInstance().RegisterQueue(memoryOwner,
+        std::to_string(streamId_) + "/buffers");
+    syncMemory_ = DCameraMemoryAccountant::GetInstance().RegisterQueue(memoryOwner,
+        std::to_string(streamId_) + "/sync");
 }
 
 DCameraStreamDataProcessProducer::~DCameraStreamDataProcessProducer()
@@ -64,12 +73,12 @@ void DCameraStreamDataProcessProducer::Start()
     }
     state_ = DCAMERA_PRODUCER_STATE_START;
     if (streamType_ == CONTINUOUS_FRAME) {
-        eventThread_ = std::thread([this]() { this->StartEvent(); });
-        std::unique_lock<std::mutex> lock(eventMutex_);
-        eventCon_.wait(lock, [this] {
-            return eventHandler_ != nullptr;
-        });
+        {
+            std::lock_guard<std::mutex> lock(eventMutex_);
+            feedStrand_ = DCameraExecutor::GetInstance().CreateStrand(statsName_ + "/feed");
+        }
         smoother_ = std::make_unique<DCameraFeedingSmoother>();
+        smoother_->SetNodeStats(DCameraStatsManager::GetInstance().Register(statsName_, "smoother", { "smooth" }));
         smootherListener_ = std::make_shared<FeedingSmootherListener>(shared_from_this());
         smoother_->RegisterListener(smootherListener_);
         smoother_->StartSmooth();
@@ -99,11 +108,10 @@ void DCameraStreamDataProcessProducer::Stop()
         smootherListener_ = nullptr;
         {
             std::lock_guard<std::mutex> lock(eventMutex_);
-            if ((eventHandler_ != nullptr) && (eventHandler_->GetEventRunner() != nullptr)) {
-                eventHandler_->GetEventRunner()->Stop();
+            if (feedStrand_ != nullptr) {
+                feedStrand_->Stop();
+                feedStrand_ = nullptr;
             }
-            eventThread_.join();
-            eventHandler_ = nullptr;
         }
         // Stop the audio and video synchronization thread
         if (syncMem_ != nullptr) {
@@ -130,21 +138,42 @@ void DCameraStreamDataProcessProducer::FeedStream(const std::shared_ptr<DataBuff
 {
     CHECK_AND_RETURN_LOG(buffer == nullptr, "buffer is nullptr.");
     buffer->frameInfo_.timePonit.startSmooth = GetNowTimeStampUs();
+    nodeStats_->AddInput(buffer->Size());
     {
         std::lock_guard<std::mutex> lock(bufferMutex_);
         uint64_t buffersSize = static_cast<uint64_t>(buffer->Size());
         DHLOGD("DCameraStreamDataProcessProducer FeedStream devId %{public}s dhId %{public}s streamId: %{public}d "
             "streamType: %{public}d streamSize: %{public}" PRIu64, GetAnonyString(devId_).c_str(),
             GetAnonyString(dhId_).c_str(), streamId_, streamType_, buffersSize);
-        if (buffers_.size() >= DCAMERA_PRODUCER_MAX_BUFFER_SIZE) {
+        uint32_t maxSize = (streamType_ == SNAPSHOT_FRAME) ? DCAMERA_PRODUCER_MAX_SNAPSHOT_SIZE :
+            DCAMERA_PRODUCER_MAX_BUFFER_SIZE;
+        if (!buffersMemory_->CanQueue(buffers_.size(), buffer->Size(), maxSize)) {
             buffersSize = static_cast<uint64_t>(buffer->Size());
             DHLOGD("DCameraStreamDataProcessProducer FeedStream OverSize devId %{public}s dhId %{public}s streamType: "
                 "%{public}d streamSize: %{public}" PRIu64, GetAnonyString(devId_).c_str(),
                 GetAnonyString(dhId_).c_str(), streamType_, buffersSize);
-            buffers_.pop_front();
+            if (streamType_ == SNAPSHOT_FRAME && snapshotInFlight_) {
+                // The front photo is being handed to the driver, drop the oldest one behind it
+                buffersMemory_->Sub((*(buffers_.begin() + 1))->Size());
+                buffers_.erase(buffers_.begin() + 1);
+            } else {
+                buffersMemory_->Sub(buffers_.front()->Size());
+                buffers_.pop_front();
+            }
+            nodeStats_->AddDrop(DCAMERA_DROP_BUSY);
+            if (streamType_ == SNAPSHOT_FRAME) {
+                burstDropped_++;
+                DHLOGE("FeedStream snapshot queue full, drop oldest photo, streamId: %{public}d dropped: %{public}u",
+                    streamId_, burstDropped_);
+            }
         }
         if (streamType_ == SNAPSHOT_FRAME) {
+            if (burstStartUs_ == 0) {
+                burstStartUs_ = GetNowTimeStampUs();
+            }
             buffers_.push_back(buffer);
+            buffersMemory_->Add(buffer->Size());
+            nodeStats_->SetQueueDepth(STATS_QUEUE_BUFFERS, buffers_.size());
             producerCon_.notify_one();
         }
     }
@@ -154,18 +183,6 @@ void DCameraStreamDataProcessProducer::FeedStream(const std::shared_ptr<DataBuff
     }
 }
 
-void DCameraStreamDataProcessProducer::StartEvent()
-{
-    prctl(PR_SET_NAME, SOURCE_START_EVENT.c_str());
-    auto runner = AppExecFwk::EventRunner::Create(false);
-    {
-        std::lock_guard<std::mutex> lock(eventMutex_);
-        eventHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
-    }
-    eventCon_.notify_one();
-    runner->Run();
-}
-
 void DCameraStreamDataProcessProducer::LooperSnapShot()
 {
     std::string name = PRODUCER + std::to_string(streamType_);
@@ -173,29 +190,8 @@ void DCameraStreamDataProcessProducer::LooperSnapShot()
     DHBase dhBase;
     dhBase.deviceId_ = devId_;
     dhBase.dhId_ = dhId_;
-    while (state_ == DCAMERA_PRODUCER_STATE_START) {
-        std::shared_ptr<DataBuffer> buffer = nullptr;
-        {
-            std::unique_lock<std::mutex> lock(bufferMutex_);
-            producerCon_.wait(lock, [this] {
-                return (!buffers_.empty() || state_ == DCAMERA_PRODUCER_STATE_STOP);
-            });
-            if (state_ == DCAMERA_PRODUCER_STATE_STOP) {
-                continue;
-            }
-            if (!buffers_.empty()) {
-                DHLOGI("LooperSnapShot producer get buffer devId: %{public}s dhId: %{public}s streamType: %{public}d "
-                    "streamId: %{public}d state: %{public}d",
-                    GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_, state_);
-                buffer = buffers_.front();
-            }
-        }
-        if (buffer == nullptr) {
-            DHLOGI("LooperSnapShot producer get buffer failed devId: %{public}s dhId: %{public}s streamType:"
-                " %{public}d streamId: %{public}d state: %{public}d",
-                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_, state_);
-            continue;
-        }
+    std::shared_ptr<DataBuffer> buffer = nullptr;
+    while (WaitSnapShot(buffer)) {
 #ifdef DUMP_DCAMERA_FILE
     std::string name =
         "SourceCapture_streamId(" + std::to_string(streamId_) + ")_" + std::to_string(photoCount_++) + ".jpg";
@@ -203,18 +199,81 @@ void DCameraStreamDataProcessProducer::LooperSnapShot()
         DumpBufferToFile(DUMP_PHOTO_PATH, name, buffer->Data(), buffer->Size());
     }
 #endif
+        FeedSnapShotToDriver(dhBase, buffer);
+        buffer = nullptr;
+    }
+}
+
+bool DCameraStreamDataProcessProducer::WaitSnapShot(std::shared_ptr<DataBuffer>& buffer)
+{
+    std::unique_lock<std::mutex> lock(bufferMutex_);
+    producerCon_.wait(lock, [this] {
+        return (!buffers_.empty() || state_ == DCAMERA_PRODUCER_STATE_STOP);
+    });
+    if (state_ == DCAMERA_PRODUCER_STATE_STOP) {
+        return false;
+    }
+    buffer = buffers_.front();
+    snapshotInFlight_ = true;
+    DHLOGI("LooperSnapShot producer get buffer devId: %{public}s dhId: %{public}s streamType: %{public}d "
+        "streamId: %{public}d queued: %{public}zu", GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(),
+        streamType_, streamId_, buffers_.size());
+    return true;
+}
+
+int32_t DCameraStreamDataProcessProducer::FeedSnapShotToDriver(const DHBase& dhBase,
+    const std::shared_ptr<DataBuffer>& buffer)
+{
+    uint32_t retries = 0;
+    uint32_t retryMs = DCAMERA_PRODUCER_RETRY_MIN_MS;
+    while (true) {
         int32_t ret = FeedStreamToDriver(dhBase, buffer);
-        if (ret != DCAMERA_OK) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(DCAMERA_PRODUCER_RETRY_SLEEP_MS));
-            continue;
+        if (ret == DCAMERA_OK) {
+            OnSnapShotDelivered(buffer, retries);
+            return DCAMERA_OK;
         }
-        {
-            std::lock_guard<std::mutex> lock(bufferMutex_);
-            buffers_.pop_front();
+        // No driver buffer yet, back off but wake up at once on Stop
+        std::unique_lock<std::mutex> lock(bufferMutex_);
+        bool stopped = producerCon_.wait_for(lock, std::chrono::milliseconds(retryMs), [this] {
+            return state_ == DCAMERA_PRODUCER_STATE_STOP;
+        });
+        if (stopped) {
+            snapshotInFlight_ = false;
+            DHLOGE("FeedSnapShotToDriver stopped before delivery, streamId: %{public}d retries: %{public}u",
+                streamId_, retries);
+            return ret;
         }
+        retries++;
+        burstRetries_++;
+        retryMs = std::min(retryMs * 2, DCAMERA_PRODUCER_RETRY_SLEEP_MS);
     }
-    DHLOGI("LooperSnapShot producer end devId: %s dhId: %s streamType: %{public}d streamId: %{public}d state: "
-        "%{public}d", GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_, state_);
+}
+
+void DCameraStreamDataProcessProducer::OnSnapShotDelivered(const std::shared_ptr<DataBuffer>& buffer,
+    uint32_t retries)
+{
+    int64_t nowUs = GetNowTimeStampUs();
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    buffers_.pop_front();
+    buffersMemory_->Sub(buffer->Size());
+    nodeStats_->SetQueueDepth(STATS_QUEUE_BUFFERS, buffers_.size());
+    snapshotInFlight_ = false;
+    burstShots_++;
+    DHLOGI("LooperSnapShot photo delivered streamId: %{public}d size: %{public}zu wait: %{public}" PRId64" ms "
+        "retries: %{public}u queued: %{public}zu", streamId_, buffer->Size(),
+        (nowUs - buffer->frameInfo_.timePonit.startSmooth) / DCAMERA_US_TO_MS, retries, buffers_.size());
+    if (!buffers_.empty()) {
+        return;
+    }
+    int64_t durationUs = std::max<int64_t>(nowUs - burstStartUs_, 1);
+    DHLOGI("LooperSnapShot burst end streamId: %{public}d shots: %{public}u duration: %{public}" PRId64" ms "
+        "shots/s: %{public}.2f retries: %{public}u dropped: %{public}u", streamId_, burstShots_,
+        durationUs / DCAMERA_US_TO_MS, burstShots_ * static_cast<double>(DCAMERA_US_TO_S) / durationUs,
+        burstRetries_, burstDropped_);
+    burstShots_ = 0;
+    burstRetries_ = 0;
+    burstDropped_ = 0;
+    burstStartUs_ = 0;
 }
 
 int32_t DCameraStreamDataProcessProducer::FeedStreamToDriver(const DHBase& dhBase,
@@ -229,6 +288,9 @@ int32_t DCameraStreamDataProcessProducer::FeedStreamToDriver(const DHBase& dhBas
     if (ret != SUCCESS) {
         DHLOGE("AcquireBuffer devId: %{public}s dhId: %{public}s streamId: %{public}d ret: %{public}d",
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, ret);
+        if (streamType_ == CONTINUOUS_FRAME) {
+            nodeStats_->AddDrop(DCAMERA_DROP_BUSY);
+        }
         return DCAMERA_BAD_OPERATE;
     }
     do {
@@ -264,6 +326,7 @@ int32_t DCameraStreamDataProcessProducer::FeedStreamToDriver(const DHBase& dhBas
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, ret);
         return DCAMERA_BAD_OPERATE;
     }
+    nodeStats_->AddOutput(buffer->Size());
     return ret;
 }
 
@@ -314,8 +377,8 @@ void DCameraStreamDataProcessProducer::OnSmoothFinished(const std::shared_ptr<IF
         FeedStreamToDriver(dhBase, buffer);
     };
     std::lock_guard<std::mutex> lock(eventMutex_);
-    if (eventHandler_ != nullptr) {
-        eventHandler_->PostTask(feedFunc);
+    if (feedStrand_ != nullptr) {
+        feedStrand_->Post(feedFunc);
     }
 }
 
@@ -349,11 +412,15 @@ void DCameraStreamDataProcessProducer::WritePtsAndAddBuffer(const std::shared_pt
     ret = syncMem_->WriteToAshmem(static_cast<void *>(readSyncSharedData), sizeof(SyncSharedData), 0);
     CHECK_AND_RETURN_LOG(!ret, "write sync data failed!");
     std::lock_guard<std::mutex> lock(syncBufferMutex_);
-    if (syncBufferQueue_.size() >= DCAMERA_MAX_SYNC_BUFFER_SIZE) {
+    if (!syncMemory_->CanQueue(syncBufferQueue_.size(), buffer->Size(), DCAMERA_MAX_SYNC_BUFFER_SIZE)) {
         DHLOGI("Sync buffer full, drop oldest frame, streamId: %{public}d", streamId_);
+        syncMemory_->Sub(syncBufferQueue_.front()->Size());
         syncBufferQueue_.pop_front();
+        nodeStats_->AddDrop(DCAMERA_DROP_BUSY);
     }
     syncBufferQueue_.push_back(buffer);
+    syncMemory_->Add(buffer->Size());
+    nodeStats_->SetQueueDepth(STATS_QUEUE_SYNC, syncBufferQueue_.size());
     syncBufferCond_.notify_one(); // Notify the synchronization thread to process
     return;
 }
@@ -361,6 +428,7 @@ void DCameraStreamDataProcessProducer::WritePtsAndAddBuffer(const std::shared_pt
 void DCameraStreamDataProcessProducer::SyncVideoThread()
 {
     DHLOGI("SyncVideoThread started for streamId: %{public}d", streamId_);
+    DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_SYNC_VIDEO);
     const std::chrono::milliseconds FRAME_INTERVAL(DCAMERA_SYNC_TIME_INTERVAL); // 33ms per frame
     std::chrono::steady_clock::time_point nextScheduleTime;
 
@@ -406,6 +474,7 @@ void DCameraStreamDataProcessProducer::SyncVideoThread()
             {
                 std::lock_guard<std::mutex> lock(syncBufferMutex_);
                 syncBufferQueue_.push_front(buffer);
+                syncMemory_->Add(buffer->Size());
             }
 
             // Perform timed scheduling after successful transmission
@@ -413,6 +482,7 @@ void DCameraStreamDataProcessProducer::SyncVideoThread()
             std::this_thread::sleep_until(nextScheduleTime);
         } else {
             // Video frame is too late, discard directly and process next frame immediately
+            nodeStats_->AddDrop(DCAMERA_DROP_EXPIRED);
             continue;
         }
     }
@@ -434,6 +504,8 @@ bool DCameraStreamDataProcessProducer::WaitForVideoFrame(std::shared_ptr<DataBuf
     if (!syncBufferQueue_.empty() && syncBufferQueue_.size() >= DCAMERA_SYNC_WATERMARK) {
         buffer = syncBufferQueue_.front();
         syncBufferQueue_.pop_front();
+        syncMemory_->Sub(buffer->Size());
+        nodeStats_->SetQueueDepth(STATS_QUEUE_SYNC, syncBufferQueue_.size());
     }
     
     return false; // don't exit
@@ -36,12 +36,19 @@ void IFeedingSmoother::PushData(const std::shared_ptr<IFeedableData>& data)
         std::lock_guard<std::mutex> lock(stateMutex_);
         if (state_ == SMOOTH_STOP) {
             DHLOGD("Smoother stop, push data failed.");
+            if (nodeStats_ != nullptr) {
+                nodeStats_->AddDrop(DCAMERA_DROP_SMOOTHER);
+            }
             return;
         }
     }
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
         dataQueue_.push(data);
+        if (nodeStats_ != nullptr) {
+            nodeStats_->AddInput(0);
+            nodeStats_->SetQueueDepth(STATS_QUEUE_SMOOTH, dataQueue_.size());
+        }
     }
     if (statistician_ != nullptr) {
         statistician_->CalProcessTime(data);
@@ -89,6 +96,10 @@ void IFeedingSmoother::LooperSmooth()
         {
             std::lock_guard<std::mutex> lock(queueMutex_);
             dataQueue_.pop();
+            if (nodeStats_ != nullptr) {
+                nodeStats_->AddOutput(0);
+                nodeStats_->SetQueueDepth(STATS_QUEUE_SMOOTH, dataQueue_.size());
+            }
         }
     }
 }
@@ -246,6 +257,10 @@ int32_t IFeedingSmoother::StopSmooth()
     statistician_ = nullptr;
     UnregisterListener();
 
+    if (nodeStats_ != nullptr) {
+        nodeStats_->AddDrop(DCAMERA_DROP_SMOOTHER, dataQueue_.size());
+        nodeStats_->SetQueueDepth(STATS_QUEUE_SMOOTH, 0);
+    }
     std::queue<std::shared_ptr<IFeedableData>>().swap(dataQueue_);
     DHLOGD("Stop smooth success.");
     return SMOOTH_SUCCESS;
@@ -333,5 +348,10 @@ void IFeedingSmoother::SetTrackClockFactor(const float factor)
 {
     trackClockFactor_ = factor;
 }
+
+void IFeedingSmoother::SetNodeStats(const std::shared_ptr<DCameraNodeStats>& nodeStats)
+{
+    nodeStats_ = nodeStats;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
@@ -67,11 +67,15 @@ void DCameraTimeStatistician::CalWholeProcessTime(const std::shared_ptr<DataBuff
 void DCameraTimeStatistician::SetFrameIndex(const int32_t index)
 {
     frameIndex_ = index;
+    if (index != FRAME_HEAD) {
+        recvFrameNum_++;
+    }
 }
 
 int64_t DCameraTimeStatistician::CalAverValue(int64_t& value, int64_t& valueSum)
 {
-    if (frameIndex_ == FRAME_HEAD) {
+    // The sink sheds temporal layers under pressure, so the frame index is not the number of frames received
+    if (frameIndex_ == FRAME_HEAD || recvFrameNum_ <= 0) {
         return 0;
     }
     if (INT64_MAX - valueSum < value) {
@@ -79,7 +83,7 @@ int64_t DCameraTimeStatistician::CalAverValue(int64_t& value, int64_t& valueSum)
         return 0;
     }
     valueSum += value;
-    return valueSum / frameIndex_;
+    return valueSum / recvFrameNum_;
 }
 
 int64_t DCameraTimeStatistician::GetAverEncodeTime()
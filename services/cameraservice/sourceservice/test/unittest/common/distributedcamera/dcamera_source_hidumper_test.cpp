@@ -185,5 +185,40 @@ HWTEST_F(DcameraSourceHidumperTest, dcamera_source_hidumper_test_008, TestSize.L
     bool ret = DcameraSourceHidumper::GetInstance().Dump(args, result);
     EXPECT_EQ(true, ret);
 }
+
+/**
+ * @tc.name: dcamera_source_hidumper_test_009
+ * @tc.desc: Verify the Dump function.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DcameraSourceHidumperTest, dcamera_source_hidumper_test_009, TestSize.Level1)
+{
+    DHLOGI("DcameraSourceHidumperTest::dcamera_source_hidumper_test_009");
+    std::vector<std::string> args;
+    std::string str1 = "--stoprecord";
+    args.push_back(str1);
+    std::string result;
+    bool ret = DcameraSourceHidumper::GetInstance().Dump(args, result);
+    EXPECT_EQ(true, ret);
+}
+
+/**
+ * @tc.name: dcamera_source_hidumper_test_010
+ * @tc.desc: Verify the Dump function prints the settings queue stats.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DcameraSourceHidumperTest, dcamera_source_hidumper_test_010, TestSize.Level1)
+{
+    DHLOGI("DcameraSourceHidumperTest::dcamera_source_hidumper_test_010");
+    std::vector<std::string> args;
+    std::string str1 = "--settings";
+    args.push_back(str1);
+    std::string result;
+    bool ret = DcameraSourceHidumper::GetInstance().Dump(args, result);
+    EXPECT_EQ(true, ret);
+    EXPECT_NE(std::string::npos, result.find("CoalescingRatio"));
+}
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dcamera_frame_loss_detector.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraFrameLossDetectorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    std::shared_ptr<DCameraFrameLossDetector> detector_;
+};
+
+namespace {
+const int8_t TEST_FRAME_TYPE_KEY = 2;
+const int8_t TEST_FRAME_TYPE_NONE = 0;
+const int64_t TEST_START_US = 1000000;
+const int64_t TEST_FRAME_INTERVAL_US = 33000;
+const int64_t TEST_RETRY_US = 500000;
+
+DCameraFrameInfo MakeFrame(int32_t seq, int32_t index, int8_t type)
+{
+    DCameraFrameInfo frameInfo;
+    frameInfo.seq = seq;
+    frameInfo.index = index;
+    frameInfo.type = type;
+    return frameInfo;
+}
+}
+
+void DCameraFrameLossDetectorTest::SetUpTestCase(void)
+{
+}
+
+void DCameraFrameLossDetectorTest::TearDownTestCase(void)
+{
+}
+
+void DCameraFrameLossDetectorTest::SetUp(void)
+{
+    detector_ = std::make_shared<DCameraFrameLossDetector>();
+}
+
+void DCameraFrameLossDetectorTest::TearDown(void)
+{
+    detector_ = nullptr;
+}
+
+/**
+ * @tc.name: dcamera_frame_loss_detector_test_001
+ * @tc.desc: Verify in order frames never request a key frame.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraFrameLossDetectorTest, dcamera_frame_loss_detector_test_001, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    EXPECT_FALSE(detector_->OnFrameReceived(MakeFrame(0, 0, TEST_FRAME_TYPE_KEY), nowUs));
+    for (int32_t seq = 1; seq < 10; seq++) {
+        nowUs += TEST_FRAME_INTERVAL_US;
+        EXPECT_FALSE(detector_->OnFrameReceived(MakeFrame(seq, seq, TEST_FRAME_TYPE_NONE), nowUs));
+    }
+    EXPECT_EQ(0u, detector_->GetLostFrameNum());
+    EXPECT_EQ(0u, detector_->GetRequestNum());
+}
+
+/**
+ * @tc.name: dcamera_frame_loss_detector_test_002
+ * @tc.desc: Verify a gap requests once and retries only after the retry interval.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraFrameLossDetectorTest, dcamera_frame_loss_detector_test_002, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    detector_->OnFrameReceived(MakeFrame(0, 0, TEST_FRAME_TYPE_KEY), nowUs);
+    detector_->OnFrameReceived(MakeFrame(1, 1, TEST_FRAME_TYPE_NONE), nowUs);
+    EXPECT_TRUE(detector_->OnFrameReceived(MakeFrame(4, 4, TEST_FRAME_TYPE_NONE), nowUs));
+    EXPECT_EQ(2u, detector_->GetLostFrameNum());
+
+    nowUs += TEST_FRAME_INTERVAL_US;
+    EXPECT_FALSE(detector_->OnFrameReceived(MakeFrame(5, 5, TEST_FRAME_TYPE_NONE), nowUs));
+    EXPECT_FALSE(detector_->OnFrameReceived(MakeFrame(7, 7, TEST_FRAME_TYPE_NONE), nowUs));
+    EXPECT_EQ(1u, detector_->GetRequestNum());
+
+    nowUs = TEST_START_US + TEST_RETRY_US;
+    EXPECT_TRUE(detector_->OnFrameReceived(MakeFrame(8, 8, TEST_FRAME_TYPE_NONE), nowUs));
+    EXPECT_EQ(2u, detector_->GetRequestNum());
+}
+
+/**
+ * @tc.name: dcamera_frame_loss_detector_test_003
+ * @tc.desc: Verify a sync frame ends the recovery.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraFrameLossDetectorTest, dcamera_frame_loss_detector_test_003, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    detector_->OnFrameReceived(MakeFrame(0, 0, TEST_FRAME_TYPE_KEY), nowUs);
+    EXPECT_TRUE(detector_->OnFrameReceived(MakeFrame(3, 3, TEST_FRAME_TYPE_NONE), nowUs));
+    nowUs += TEST_FRAME_INTERVAL_US;
+    EXPECT_FALSE(detector_->OnFrameReceived(MakeFrame(4, 4, TEST_FRAME_TYPE_KEY), nowUs));
+    nowUs += TEST_RETRY_US;
+    EXPECT_FALSE(detector_->OnFrameReceived(MakeFrame(5, 5, TEST_FRAME_TYPE_NONE), nowUs));
+    EXPECT_EQ(1u, detector_->GetRequestNum());
+}
+
+/**
+ * @tc.name: dcamera_frame_loss_detector_test_004
+ * @tc.desc: Verify the encoder index is used when the sink does not send the sequence.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraFrameLossDetectorTest, dcamera_frame_loss_detector_test_004, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    detector_->OnFrameReceived(MakeFrame(-1, 10, TEST_FRAME_TYPE_KEY), nowUs);
+    EXPECT_FALSE(detector_->OnFrameReceived(MakeFrame(-1, 11, TEST_FRAME_TYPE_NONE), nowUs));
+    EXPECT_TRUE(detector_->OnFrameReceived(MakeFrame(-1, 13, TEST_FRAME_TYPE_NONE), nowUs));
+    EXPECT_EQ(1u, detector_->GetLostFrameNum());
+
+    // The encoder index skips frames the sink shed, the send sequence does not
+    detector_->Reset();
+    detector_->OnFrameReceived(MakeFrame(0, 20, TEST_FRAME_TYPE_KEY), nowUs);
+    EXPECT_FALSE(detector_->OnFrameReceived(MakeFrame(1, 24, TEST_FRAME_TYPE_NONE), nowUs));
+    EXPECT_EQ(1u, detector_->GetLostFrameNum());
+}
+
+/**
+ * @tc.name: dcamera_frame_loss_detector_test_005
+ * @tc.desc: Verify frames dropped before decoding are rate limited with the gaps.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraFrameLossDetectorTest, dcamera_frame_loss_detector_test_005, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    EXPECT_TRUE(detector_->OnFrameLost(nowUs));
+    EXPECT_FALSE(detector_->OnFrameLost(nowUs + TEST_FRAME_INTERVAL_US));
+    EXPECT_EQ(2u, detector_->GetLostFrameNum());
+    EXPECT_TRUE(detector_->OnFrameLost(nowUs + TEST_RETRY_US));
+    EXPECT_EQ(2u, detector_->GetRequestNum());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dcamera_settings_coalescer.h"
+#include "dcamera_utils_tools.h"
+#include "metadata_utils.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraSettingsCoalescerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    std::shared_ptr<DCameraSettingsCoalescer> coalescer_;
+};
+
+namespace {
+const size_t TEST_ITEM_CAPACITY = 10;
+const size_t TEST_DATA_CAPACITY = 100;
+const int32_t TEST_EXPOSURE = 2;
+
+std::shared_ptr<DCameraSettings> MakeMetadataSetting(float zoom, const int32_t *exposure)
+{
+    auto metadata = std::make_shared<Camera::CameraMetadata>(TEST_ITEM_CAPACITY, TEST_DATA_CAPACITY);
+    metadata->addEntry(OHOS_CONTROL_ZOOM_RATIO, &zoom, 1);
+    if (exposure != nullptr) {
+        metadata->addEntry(OHOS_CONTROL_AE_EXPOSURE_COMPENSATION, exposure, 1);
+    }
+    std::string metadataStr = Camera::MetadataUtils::EncodeToString(metadata);
+    auto setting = std::make_shared<DCameraSettings>();
+    setting->type_ = DCSettingsType::UPDATE_METADATA;
+    setting->value_ = Base64Encode(reinterpret_cast<const unsigned char *>(metadataStr.c_str()),
+        metadataStr.length());
+    return setting;
+}
+
+std::shared_ptr<DCameraSettings> MakeSetting(DCSettingsType type, const std::string& value)
+{
+    auto setting = std::make_shared<DCameraSettings>();
+    setting->type_ = type;
+    setting->value_ = value;
+    return setting;
+}
+}
+
+void DCameraSettingsCoalescerTest::SetUpTestCase(void)
+{
+}
+
+void DCameraSettingsCoalescerTest::TearDownTestCase(void)
+{
+}
+
+void DCameraSettingsCoalescerTest::SetUp(void)
+{
+    coalescer_ = std::make_shared<DCameraSettingsCoalescer>();
+}
+
+void DCameraSettingsCoalescerTest::TearDown(void)
+{
+    coalescer_ = nullptr;
+}
+
+/**
+ * @tc.name: dcamera_settings_coalescer_test_001
+ * @tc.desc: Verify metadata updates are merged per tag and the latest value wins.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSettingsCoalescerTest, dcamera_settings_coalescer_test_001, TestSize.Level1)
+{
+    int32_t exposure = TEST_EXPOSURE;
+    uint64_t batchId = 0;
+    uint64_t mergedId = 0;
+    EXPECT_TRUE(coalescer_->Submit({ MakeMetadataSetting(1.0f, &exposure) }, batchId));
+    EXPECT_FALSE(coalescer_->Submit({ MakeMetadataSetting(2.0f, nullptr) }, mergedId));
+    EXPECT_EQ(batchId, mergedId);
+    EXPECT_FALSE(coalescer_->Submit({ MakeMetadataSetting(3.0f, nullptr) }, mergedId));
+
+    std::vector<std::shared_ptr<DCameraSettings>> settings = coalescer_->Take(batchId);
+    ASSERT_EQ(1u, settings.size());
+    EXPECT_EQ(DCSettingsType::UPDATE_METADATA, settings[0]->type_);
+    std::shared_ptr<Camera::CameraMetadata> metadata =
+        Camera::MetadataUtils::DecodeFromString(Base64Decode(settings[0]->value_));
+    ASSERT_NE(nullptr, metadata);
+    camera_metadata_item_t item;
+    ASSERT_EQ(CAM_META_SUCCESS, Camera::FindCameraMetadataItem(metadata->get(), OHOS_CONTROL_ZOOM_RATIO, &item));
+    EXPECT_FLOAT_EQ(3.0f, item.data.f[0]);
+    ASSERT_EQ(CAM_META_SUCCESS,
+        Camera::FindCameraMetadataItem(metadata->get(), OHOS_CONTROL_AE_EXPOSURE_COMPENSATION, &item));
+    EXPECT_EQ(TEST_EXPOSURE, item.data.i32[0]);
+
+    DCameraSettingsStats stats = coalescer_->GetStats();
+    EXPECT_EQ(3u, stats.requestNum);
+    EXPECT_EQ(1u, stats.dispatchNum);
+    EXPECT_EQ(0u, stats.pendingDepth);
+    EXPECT_EQ(2u, stats.maxPendingDepth);
+}
+
+/**
+ * @tc.name: dcamera_settings_coalescer_test_002
+ * @tc.desc: Verify other settings keep the latest value per type in arrival order.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSettingsCoalescerTest, dcamera_settings_coalescer_test_002, TestSize.Level1)
+{
+    uint64_t batchId = 0;
+    uint64_t mergedId = 0;
+    EXPECT_TRUE(coalescer_->Submit({ MakeSetting(DCSettingsType::DISABLE_METADATA, "a") }, batchId));
+    EXPECT_FALSE(coalescer_->Submit({ MakeSetting(DCSettingsType::ENABLE_METADATA, "b") }, mergedId));
+    EXPECT_FALSE(coalescer_->Submit({ MakeSetting(DCSettingsType::DISABLE_METADATA, "c") }, mergedId));
+
+    std::vector<std::shared_ptr<DCameraSettings>> settings = coalescer_->Take(batchId);
+    ASSERT_EQ(2u, settings.size());
+    EXPECT_EQ(DCSettingsType::ENABLE_METADATA, settings[0]->type_);
+    EXPECT_EQ("b", settings[0]->value_);
+    EXPECT_EQ(DCSettingsType::DISABLE_METADATA, settings[1]->type_);
+    EXPECT_EQ("c", settings[1]->value_);
+
+    EXPECT_TRUE(coalescer_->Submit({ MakeSetting(DCSettingsType::FPS_RANGE, "d") }, batchId));
+    EXPECT_EQ(1u, coalescer_->Take(batchId).size());
+}
+
+/**
+ * @tc.name: dcamera_settings_coalescer_test_003
+ * @tc.desc: Verify dropped settings are never dispatched.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSettingsCoalescerTest, dcamera_settings_coalescer_test_003, TestSize.Level1)
+{
+    uint64_t droppedId = 0;
+    EXPECT_TRUE(coalescer_->Submit({ MakeMetadataSetting(1.0f, nullptr),
+        MakeSetting(DCSettingsType::SET_FLASH_LIGHT, "1") }, droppedId));
+    coalescer_->Drop();
+
+    // The dispatch queued for the dropped batch must not pick up settings submitted after the drop
+    uint64_t batchId = 0;
+    EXPECT_TRUE(coalescer_->Submit({ MakeSetting(DCSettingsType::FPS_RANGE, "2") }, batchId));
+    EXPECT_NE(droppedId, batchId);
+    EXPECT_TRUE(coalescer_->Take(droppedId).empty());
+    EXPECT_EQ(1u, coalescer_->Take(batchId).size());
+
+    DCameraSettingsStats stats = coalescer_->GetStats();
+    EXPECT_EQ(2u, stats.dropNum);
+    EXPECT_EQ(1u, stats.dispatchNum);
+}
+
+/**
+ * @tc.name: dcamera_settings_coalescer_test_004
+ * @tc.desc: Verify a sealed batch takes no more settings and batches are dispatched in order.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSettingsCoalescerTest, dcamera_settings_coalescer_test_004, TestSize.Level1)
+{
+    uint64_t firstId = 0;
+    uint64_t secondId = 0;
+    uint64_t mergedId = 0;
+    EXPECT_TRUE(coalescer_->Submit({ MakeMetadataSetting(1.0f, nullptr) }, firstId));
+    coalescer_->Seal();
+    EXPECT_TRUE(coalescer_->Submit({ MakeMetadataSetting(2.0f, nullptr) }, secondId));
+    EXPECT_FALSE(coalescer_->Submit({ MakeMetadataSetting(3.0f, nullptr) }, mergedId));
+    EXPECT_EQ(secondId, mergedId);
+    EXPECT_EQ(2u, coalescer_->GetStats().pendingDepth);
+
+    std::vector<std::shared_ptr<DCameraSettings>> settings = coalescer_->Take(firstId);
+    ASSERT_EQ(1u, settings.size());
+    std::shared_ptr<Camera::CameraMetadata> metadata =
+        Camera::MetadataUtils::DecodeFromString(Base64Decode(settings[0]->value_));
+    ASSERT_NE(nullptr, metadata);
+    camera_metadata_item_t item;
+    ASSERT_EQ(CAM_META_SUCCESS, Camera::FindCameraMetadataItem(metadata->get(), OHOS_CONTROL_ZOOM_RATIO, &item));
+    EXPECT_FLOAT_EQ(1.0f, item.data.f[0]);
+
+    settings = coalescer_->Take(secondId);
+    ASSERT_EQ(1u, settings.size());
+    metadata = Camera::MetadataUtils::DecodeFromString(Base64Decode(settings[0]->value_));
+    ASSERT_NE(nullptr, metadata);
+    ASSERT_EQ(CAM_META_SUCCESS, Camera::FindCameraMetadataItem(metadata->get(), OHOS_CONTROL_ZOOM_RATIO, &item));
+    EXPECT_FLOAT_EQ(3.0f, item.data.f[0]);
+
+    // Nothing is queued any more, the next submit has to post a new dispatch
+    EXPECT_TRUE(coalescer_->Submit({ MakeMetadataSetting(4.0f, nullptr) }, mergedId));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
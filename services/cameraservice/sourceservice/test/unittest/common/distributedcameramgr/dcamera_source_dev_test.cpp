@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <future>
 #include <gtest/gtest.h>
 
 #define private public
@@ -58,12 +59,44 @@ const std::string TEST_SRC_ATTRS = "";
 const int32_t TEST_WIDTH = 1920;
 const int32_t TEST_HEIGTH = 1080;
 const int32_t TEST_SLEEP_SEC = 200000;
+const int32_t TEST_EVENT_WAIT_MS = 2000;
 std::string TEST_EVENT_CMD_JSON = R"({
     "Type": "MESSAGE",
     "dhId": "camrea_0",
     "Command": "STATE_NOTIFY",
     "Value": {"EventType": 1, "EventResult": 1, "EventContent": "TestContent"}
 })";
+
+std::shared_ptr<DCameraSettings> MakeSetting(DCSettingsType type, const std::string& value)
+{
+    auto setting = std::make_shared<DCameraSettings>();
+    setting->type_ = type;
+    setting->value_ = value;
+    return setting;
+}
+
+// Holds the source dev event handler until the returned promise is set
+std::shared_ptr<std::promise<void>> BlockEventHandler(std::shared_ptr<DCameraSourceDev>& camDev)
+{
+    auto release = std::make_shared<std::promise<void>>();
+    std::shared_future<void> released = release->get_future().share();
+    auto started = std::make_shared<std::promise<void>>();
+    std::future<void> isStarted = started->get_future();
+    camDev->srcDevEventHandler_->PostTask([started, released]() {
+        started->set_value();
+        released.wait();
+    });
+    isStarted.wait();
+    return release;
+}
+
+bool WaitEventHandlerIdle(std::shared_ptr<DCameraSourceDev>& camDev)
+{
+    auto idle = std::make_shared<std::promise<void>>();
+    std::future<void> isIdle = idle->get_future();
+    camDev->srcDevEventHandler_->PostTask([idle]() { idle->set_value(); });
+    return isIdle.wait_for(std::chrono::milliseconds(TEST_EVENT_WAIT_MS)) == std::future_status::ready;
+}
 }
 
 void DCameraSourceDevTest::SetTokenID()
@@ -791,5 +824,63 @@ HWTEST_F(DCameraSourceDevTest, processHDFEvent_001, TestSize.Level1) {
     int32_t rotate = DCameraSystemSwitchInfo::GetInstance().GetSystemSwitchRotation(TEST_DEVICE_ID);
     EXPECT_EQ(rotate, 90);
 }
+
+/**
+ * @tc.name: UpdateCameraSettings_001
+ * @tc.desc: Verify stop capture flushes the settings queued ahead of it.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraSourceDevTest, UpdateCameraSettings_001, TestSize.Level1)
+{
+    camDev_->InitDCameraSourceDev();
+    std::shared_ptr<std::promise<void>> release = BlockEventHandler(camDev_);
+    std::vector<std::shared_ptr<DCameraSettings>> settings = {
+        MakeSetting(DCSettingsType::DISABLE_METADATA, "UpdateSettingsTest") };
+    EXPECT_EQ(DCAMERA_OK, camDev_->UpdateCameraSettings(settings));
+    EXPECT_EQ(1u, camDev_->GetSettingsStats().pendingDepth);
+
+    std::vector<int> streamIds = { 1 };
+    EXPECT_EQ(DCAMERA_OK, camDev_->StopCameraCapture(streamIds));
+    release->set_value();
+    EXPECT_TRUE(WaitEventHandlerIdle(camDev_));
+
+    DCameraSettingsStats stats = camDev_->GetSettingsStats();
+    EXPECT_EQ(1u, stats.requestNum);
+    EXPECT_EQ(0u, stats.dispatchNum);
+    EXPECT_EQ(1u, stats.dropNum);
+    EXPECT_EQ(0u, stats.pendingDepth);
+}
+
+/**
+ * @tc.name: UpdateCameraSettings_002
+ * @tc.desc: Verify settings are not merged across a start capture queued between them.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraSourceDevTest, UpdateCameraSettings_002, TestSize.Level1)
+{
+    camDev_->InitDCameraSourceDev();
+    std::shared_ptr<std::promise<void>> release = BlockEventHandler(camDev_);
+    std::vector<std::shared_ptr<DCameraSettings>> settings = {
+        MakeSetting(DCSettingsType::DISABLE_METADATA, "before") };
+    EXPECT_EQ(DCAMERA_OK, camDev_->UpdateCameraSettings(settings));
+    settings = { MakeSetting(DCSettingsType::DISABLE_METADATA, "merged") };
+    EXPECT_EQ(DCAMERA_OK, camDev_->UpdateCameraSettings(settings));
+    EXPECT_EQ(1u, camDev_->GetSettingsStats().pendingDepth);
+
+    std::vector<std::shared_ptr<DCCaptureInfo>> captureInfos;
+    EXPECT_EQ(DCAMERA_OK, camDev_->StartCameraCapture(captureInfos));
+    settings = { MakeSetting(DCSettingsType::DISABLE_METADATA, "after") };
+    EXPECT_EQ(DCAMERA_OK, camDev_->UpdateCameraSettings(settings));
+    EXPECT_EQ(2u, camDev_->GetSettingsStats().pendingDepth);
+    release->set_value();
+    EXPECT_TRUE(WaitEventHandlerIdle(camDev_));
+
+    DCameraSettingsStats stats = camDev_->GetSettingsStats();
+    EXPECT_EQ(3u, stats.requestNum);
+    EXPECT_EQ(2u, stats.dispatchNum);
+    EXPECT_EQ(0u, stats.dropNum);
+}
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -365,7 +365,7 @@ HWTEST_F(DCameraStreamDataProcessProducerTest, FeedStream_003, TestSize.Level1)
     producer_->streamType_ = SNAPSHOT_FRAME;
     producer_->Start();
 
-    for (uint32_t i = 0; i <= producer_->DCAMERA_PRODUCER_MAX_BUFFER_SIZE; i++) {
+    for (uint32_t i = 0; i <= producer_->DCAMERA_PRODUCER_MAX_SNAPSHOT_SIZE; i++) {
         auto buffer = std::make_shared<DataBuffer>(100);
         buffer->frameInfo_.rawTime = 1000000 + i * 1000; // Incremental timestamps
         producer_->FeedStream(buffer);
@@ -373,7 +373,8 @@ HWTEST_F(DCameraStreamDataProcessProducerTest, FeedStream_003, TestSize.Level1)
 
     {
         std::lock_guard<std::mutex> lock(producer_->bufferMutex_);
-        EXPECT_EQ(producer_->buffers_.size(), producer_->DCAMERA_PRODUCER_MAX_BUFFER_SIZE);
+        EXPECT_EQ(producer_->buffers_.size(), producer_->DCAMERA_PRODUCER_MAX_SNAPSHOT_SIZE);
+        EXPECT_EQ(producer_->burstDropped_, 1u);
     }
     producer_->Stop();
 }
@@ -53,6 +53,10 @@ public:
     {
         return DCAMERA_OK;
     }
+    int32_t RequestKeyFrame()
+    {
+        return DCAMERA_OK;
+    }
     int32_t GetCameraInfo(std::shared_ptr<DCameraInfo>& camInfo)
     {
         return DCAMERA_OK;
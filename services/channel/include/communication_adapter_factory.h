@@ -28,6 +28,7 @@ namespace DistributedHardware {
 enum CommunicationMode {
     COMM_MODE_TCP = 0,
     COMM_MODE_PIPE = 1,
+    COMM_MODE_UNIX = 2,
 };
 
 class CommunicationAdapterFactory {
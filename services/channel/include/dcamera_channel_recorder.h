@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_CHANNEL_RECORDER_H
+#define OHOS_DCAMERA_CHANNEL_RECORDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "data_buffer.h"
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraSoftbusSession;
+
+typedef enum {
+    DCAMERA_RECORD_TYPE_BYTES = 0,
+    DCAMERA_RECORD_TYPE_STREAM = 1,
+} DCameraRecordType;
+
+typedef enum {
+    DCAMERA_REPLAY_PACING_ORIGINAL = 0,
+    DCAMERA_REPLAY_PACING_FAST = 1,
+} DCameraReplayPacing;
+
+/*
+ * On-disk layout. The record file starts with a DCameraRecordFileHeader and is followed by
+ * DCameraRecordHeader + payload + ext for every received packet. The index file is a flat
+ * array of DCameraRecordIndex entries pointing into the record file. Both files are only
+ * ever appended to, so a recording that is cut short stays readable up to the last index.
+ */
+struct DCameraRecordFileHeader {
+    uint32_t magic;
+    uint32_t version;
+};
+
+struct DCameraRecordHeader {
+    uint32_t type;
+    int32_t socket;
+    int64_t recvTimeUs;
+    uint32_t dataLen;
+    uint32_t extLen;
+};
+
+struct DCameraRecordIndex {
+    uint64_t offset;
+    int64_t recvTimeUs;
+};
+
+struct DCameraChannelRecord {
+    DCameraRecordType type = DCAMERA_RECORD_TYPE_BYTES;
+    int32_t socket = -1;
+    int64_t recvTimeUs = 0;
+    std::shared_ptr<DataBuffer> data = nullptr;
+    std::string ext;
+};
+
+/*
+ * Record only copies the packet into a queue, the files are written and flushed by a writer thread
+ * so the softbus receive callbacks never wait on storage.
+ */
+class DCameraChannelRecorder {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraChannelRecorder);
+public:
+    int32_t StartRecord(const std::string& recordFile, const std::string& indexFile);
+    int32_t StopRecord();
+    bool IsRecording();
+    void Record(DCameraRecordType type, int32_t socket, int64_t recvTimeUs, const void *data, uint32_t dataLen,
+        const void *ext, uint32_t extLen);
+    uint64_t GetRecordCount();
+    uint64_t GetDropCount();
+
+private:
+    DCameraChannelRecorder() = default;
+    ~DCameraChannelRecorder();
+    void WriteLoop();
+    bool WriteRecord(const DCameraChannelRecord& record);
+    void CloseFiles();
+
+private:
+    // Records queued beyond this are dropped rather than growing memory while storage stalls
+    constexpr static size_t MAX_PENDING_BYTES = 32 * 1024 * 1024;
+
+    std::mutex recordLock_;
+    std::condition_variable recordCond_;
+    std::atomic<bool> isRecording_ = false;
+    bool isStopping_ = false;
+    std::thread writeThread_;
+    std::deque<DCameraChannelRecord> pendingRecords_;
+    size_t pendingBytes_ = 0;
+    FILE *recordFile_ = nullptr;
+    FILE *indexFile_ = nullptr;
+    uint64_t offset_ = 0;
+    uint64_t recordCount_ = 0;
+    uint64_t dropCount_ = 0;
+};
+
+class DCameraChannelReplayer {
+public:
+    DCameraChannelReplayer() = default;
+    ~DCameraChannelReplayer();
+
+    int32_t Open(const std::string& recordFile, const std::string& indexFile);
+    void Close();
+    size_t GetRecordCount();
+    int32_t ReadRecord(size_t index, DCameraChannelRecord& record);
+    int32_t Replay(std::shared_ptr<DCameraSoftbusSession>& session, int32_t socket, DCameraReplayPacing pacing);
+    // Records of the last replay that were skipped because their frame info could not be parsed
+    size_t GetErrorCount();
+
+private:
+    int32_t BuildReplayBuffer(DCameraChannelRecord& record, int64_t recvTimeUs);
+
+private:
+    FILE *recordFile_ = nullptr;
+    std::vector<DCameraRecordIndex> index_;
+    size_t errorCount_ = 0;
+};
+
+constexpr uint32_t DCAMERA_RECORD_MAGIC = 0x44435243;
+constexpr uint32_t DCAMERA_RECORD_VERSION = 1;
+const std::string DCAMERA_RECORD_FILE = "SourceChannelRecord.dcrec";
+const std::string DCAMERA_RECORD_INDEX_FILE = "SourceChannelRecord.dcidx";
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_CHANNEL_RECORDER_H
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_CHANNEL_SINK_FANOUT_H
+#define OHOS_DCAMERA_CHANNEL_SINK_FANOUT_H
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "dcamera_executor.h"
+#include "icamera_channel.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Sends one encoded stream to several source devices. Every encoded buffer is shared by
+ * reference between the subscribers, each subscriber owns a bounded send queue drained by its
+ * own executor strand, so a slow viewer only drops its own frames. Video viewers share the
+ * executor pool, paced photo sends run on dedicated strands. On overflow a subscriber first sheds the
+ * temporal enhancement layers, and only restarts on a key frame requested from the encoder
+ * through the requester when the base layer alone still does not fit. The viewer created by
+ * CreateSession is the primary one and stays until ReleaseSession.
+ */
+class DCameraChannelSinkFanout : public ICameraChannel,
+    public std::enable_shared_from_this<DCameraChannelSinkFanout> {
+public:
+    using KeyFrameRequester = std::function<int32_t()>;
+
+    DCameraChannelSinkFanout() = default;
+    ~DCameraChannelSinkFanout() override;
+
+    int32_t CloseSession() override;
+    int32_t CreateSession(std::vector<DCameraIndex>& camIndexs, std::string sessionFlag, DCameraSessionMode sessionMode,
+        std::shared_ptr<ICameraChannelListener>& listener) override;
+    int32_t ReleaseSession() override;
+    int32_t SendData(std::shared_ptr<DataBuffer>& buffer) override;
+    bool IsSendBusy() override;
+
+    int32_t AddSubscriberSession(std::vector<DCameraIndex>& camIndexs, std::string sessionFlag);
+    int32_t AddSubscriber(const std::string& devId, const std::shared_ptr<ICameraChannel>& channel);
+    int32_t RemoveSubscriber(const std::string& devId);
+    void OnSubscriberState(const std::string& devId, int32_t state);
+    void SetKeyFrameRequester(KeyFrameRequester requester);
+    size_t GetSubscriberCount();
+
+private:
+    struct Subscriber {
+        std::string devId;
+        std::shared_ptr<ICameraChannel> channel;
+        std::mutex queueMutex;
+        std::deque<std::shared_ptr<DataBuffer>> queue;
+        std::shared_ptr<DCameraStrand> sendStrand;
+        // Set while a send task is posted to the strand, one task is in flight at a time
+        bool sendPosted = false;
+        bool connected = false;
+        bool primary = false;
+        bool waitKeyFrame = true;
+        bool shedUntilBase = false;
+        uint64_t sent = 0;
+        uint64_t sendFailed = 0;
+        uint64_t dropped = 0;
+        uint64_t skipped = 0;
+    };
+
+    int32_t CreateSubscriberSession(std::vector<DCameraIndex>& camIndexs, std::string sessionFlag,
+        const std::shared_ptr<ICameraChannelListener>& forward);
+    std::shared_ptr<Subscriber> RegisterSubscriber(const std::string& devId,
+        const std::shared_ptr<ICameraChannel>& channel, bool primary);
+    void UnregisterSubscriber(const std::shared_ptr<Subscriber>& sub);
+    bool EnqueueFrame(const std::shared_ptr<Subscriber>& sub, const std::shared_ptr<DataBuffer>& buffer,
+        bool isKeyFrame, bool isCodecData, bool& needKeyFrame);
+    void PostSend(const std::shared_ptr<Subscriber>& sub);
+    void SendPending(const std::shared_ptr<Subscriber>& sub);
+    void StopSubscriber(const std::shared_ptr<Subscriber>& sub);
+    void RequestKeyFrame(bool force);
+    void ShedEnhancementLayers(const std::shared_ptr<Subscriber>& sub);
+    int32_t GetTemporalLayer(const std::shared_ptr<DataBuffer>& buffer);
+    bool IsKeyFrame(const std::shared_ptr<DataBuffer>& buffer);
+    bool IsCodecData(const std::shared_ptr<DataBuffer>& buffer);
+
+    static constexpr size_t DCAMERA_FANOUT_QUEUE_SIZE = 8;
+    static constexpr int64_t DCAMERA_FANOUT_KEYFRAME_INTERVAL_US = 500000;
+    // Same value as AVCODEC_BUFFER_FLAG_NONE, any other frame type is treated as a sync point
+    static constexpr int32_t DCAMERA_FANOUT_FRAME_TYPE_NONE = 0;
+    // Same value as AVCODEC_BUFFER_FLAG_CODEC_DATA, the parameter sets the encoder emits once at start
+    static constexpr uint32_t DCAMERA_FANOUT_FRAME_TYPE_CODEC_DATA = 1 << 3;
+
+    std::mutex subscriberMutex_;
+    std::map<std::string, std::shared_ptr<Subscriber>> subscribers_;
+    DCameraSessionMode mode_ = DCAMERA_SESSION_MODE_VIDEO;
+    // Latest parameter sets, replayed to every viewer before its first key frame
+    std::shared_ptr<DataBuffer> codecData_;
+
+    std::mutex requesterMutex_;
+    KeyFrameRequester keyFrameRequester_;
+    int64_t lastKeyFrameRequestUs_ = 0;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_CHANNEL_SINK_FANOUT_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_CLOCK_ESTIMATOR_H
+#define OHOS_DCAMERA_CLOCK_ESTIMATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Tracks the clock of a remote device as offset(t) = offset + skew * (t - ref), where t is the
+ * local time and offset is remote minus local. Each ping gives the local send and receive times
+ * t1, t4 and the remote receive and send times t2, t3. Only the ping with the shortest round trip
+ * of every block is kept, since queueing only ever adds delay, and the model is a least squares
+ * line through the kept points. Samples are added under a lock by the control channel, readers
+ * on the frame path go through a sequence lock and never block.
+ */
+class DCameraClockEstimator {
+public:
+    void AddSample(int64_t t1, int64_t t2, int64_t t3, int64_t t4);
+    void SetCoarseOffsetUs(int64_t offsetUs);
+    int64_t GetOffsetUs(int64_t localUs) const;
+    bool IsSynced() const;
+    int64_t GetSkewPpb() const;
+    int64_t GetMinRttUs() const;
+    void Reset();
+
+private:
+    struct ClockPoint {
+        int64_t localUs = 0;
+        int64_t offsetNs = 0;
+        int64_t rttUs = 0;
+    };
+    struct ClockModel {
+        int64_t refUs = 0;
+        int64_t offsetNs = 0;
+        int64_t skewPpb = 0;
+    };
+
+    bool FitModel(ClockModel& model);
+    void Publish(const ClockModel& model);
+    bool ReadModel(ClockModel& model) const;
+
+    static constexpr uint32_t BLOCK_SAMPLE_NUM = 4;
+    static constexpr size_t MAX_POINT_NUM = 32;
+    static constexpr size_t MIN_SKEW_POINT_NUM = 4;
+    static constexpr int64_t MIN_SKEW_SPAN_US = 30000000;
+    static constexpr int64_t MAX_SKEW_PPB = 500000;
+    static constexpr int64_t MAX_RTT_US = 1000000;
+    static constexpr int64_t NS_PER_US = 1000;
+    static constexpr int64_t PPB_PER_UNIT = 1000000000;
+
+    std::mutex sampleMutex_;
+    std::deque<ClockPoint> points_;
+    ClockPoint blockBest_;
+    uint32_t blockSampleNum_ = 0;
+
+    // Sequence lock, odd while a new model is written
+    std::atomic<uint32_t> version_ { 0 };
+    std::atomic<int64_t> refUs_ { 0 };
+    std::atomic<int64_t> offsetNs_ { 0 };
+    std::atomic<int64_t> skewPpb_ { 0 };
+    std::atomic<bool> isSynced_ { false };
+    std::atomic<int64_t> coarseOffsetUs_ { 0 };
+    std::atomic<int64_t> minRttUs_ { 0 };
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_CLOCK_ESTIMATOR_H
@@ -24,7 +24,9 @@
 #include <thread>
 #include <condition_variable>
 
+#include "dcamera_sink_frame_info.h"
 #include "dcamera_softbus_session.h"
+#include "dcamera_stream_fec.h"
 #include "icamera_channel.h"
 #include "single_instance.h"
 #include "socket.h"
@@ -70,6 +72,7 @@ public:
         const StreamFrameInfo *param);
 
     int32_t HandleSourceStreamExt(std::shared_ptr<DataBuffer>& buffer, const StreamData *ext);
+    bool DecodeFecStream(int32_t socket, std::shared_ptr<DataBuffer>& buffer, std::shared_ptr<DataBuffer>& frame);
     void RecordSourceSocketSession(int32_t socket, std::shared_ptr<DCameraSoftbusSession> session);
 
     void CloseSessionWithNetWorkId(const std::string &networkId);
@@ -96,6 +99,11 @@ private:
     int32_t HandleConflictSession(int32_t socket, std::shared_ptr<DCameraSoftbusSession> session,
         const std::string& networkId);
     void ExecuteConflictCleanupAsync(int32_t socket, std::shared_ptr<DCameraSoftbusSession> session);
+    int32_t GetNextStreamSeq(int32_t socket);
+    void ResetStreamState(int32_t socket);
+    int32_t SendStreamData(int32_t socket, StreamData& streamData, const std::string& jsonStr, int32_t frameType,
+        int32_t index);
+    int32_t SendFecStream(int32_t socket, std::shared_ptr<DataBuffer>& buffer, DCameraSinkFrameInfo& sinkFrameInfo);
 private:
     std::mutex optLock_;
     const std::string PKG_NAME = "ohos.dhardware.dcamera";
@@ -127,6 +135,13 @@ private:
     std::map<int32_t, std::shared_ptr<DCameraSoftbusSession>> sinkSocketSessionMap_;
     std::mutex sourceSocketLock_;
     std::map<int32_t, std::shared_ptr<DCameraSoftbusSession>> sourceSocketSessionMap_;
+    // Numbers the frames actually handed to each stream socket, frames dropped on purpose leave no gap
+    std::mutex streamSeqLock_;
+    std::map<int32_t, int32_t> streamSeqMap_;
+    // FEC state of each stream socket, the encoder on the sink side and the decoder on the source side
+    std::mutex streamFecLock_;
+    std::map<int32_t, DCameraStreamFecEncoder> fecEncoderMap_;
+    std::map<int32_t, DCameraStreamFecDecoder> fecDecoderMap_;
 
     // Authorization mechanism members
     std::mutex authRequestMutex_;
@@ -18,8 +18,10 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <mutex>
 
+#include "dcamera_clock_estimator.h"
 #include "single_instance.h"
 
 namespace OHOS {
@@ -31,6 +33,8 @@ public:
     int32_t StopSoftbusTimeSync(const std::string& devId);
     void SetTimeSyncInfo(const int32_t microsecond, const std::string& devId);
     int32_t GetTimeSyncInfo(const std::string& devId);
+    void AddTimeSyncSample(const std::string& devId, int64_t t1, int64_t t2, int64_t t3, int64_t t4);
+    std::shared_ptr<DCameraClockEstimator> GetClockEstimator(const std::string& devId);
 private:
     DCameraSoftbusLatency() = default;
     ~DCameraSoftbusLatency() = default;
@@ -40,7 +44,8 @@ private:
     constexpr static int32_t REF_NORMAL = 1;
     std::mutex offsetLock_;
     std::mutex micLock_;
-    std::map<std::string, int32_t> offsets_;
+    // Kept for the life of the service, so the frame path can hold on to them across sessions
+    std::map<std::string, std::shared_ptr<DCameraClockEstimator>> estimators_;
     std::map<std::string, int32_t> refCount_;
 };
 } // namespace DistributedHardware
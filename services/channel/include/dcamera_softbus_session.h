@@ -17,7 +17,12 @@
 #define OHOS_DCAMERA_SOFTBUS_SESSION_H
 
 #include "event_handler.h"
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "icamera_channel.h"
 #include "icamera_channel_listener.h"
@@ -64,6 +69,27 @@ private:
         uint32_t dataLen;
     };
 
+    // A fragmented payload kept by the sender until the retransmit window has passed
+    struct RetransmitEntry {
+        std::shared_ptr<DataBuffer> payload;
+        uint32_t fragLen;
+        int64_t sendUs;
+    };
+
+    // A fragmented payload being reassembled, fragments may arrive in any order
+    struct FragReassembly {
+        std::shared_ptr<DataBuffer> buffer;
+        std::vector<bool> received;
+        uint32_t totalLen = 0;
+        uint32_t fragLen = 0;
+        uint32_t fragNum = 0;
+        uint32_t recvNum = 0;
+        uint32_t maxSubSeq = 0;
+        uint32_t nackNum = 0;
+        int64_t startUs = 0;
+        int64_t lastRecvUs = 0;
+    };
+
     using DCameraSendFuc = int32_t (DCameraSoftbusSession::*)(std::shared_ptr<DataBuffer>& buffer);
     int32_t SendBytes(std::shared_ptr<DataBuffer>& buffer);
     int32_t SendStream(std::shared_ptr<DataBuffer>& buffer);
@@ -80,6 +106,25 @@ private:
     uint32_t U32Get(const uint8_t *ptr);
     void ResetAssembleFrag();
     void SetHeadParaDataLen(SessionDataHeader& headPara, const uint32_t totalLen, const uint32_t offset);
+    void PaceSendData(int64_t startUs, uint64_t sentBytes);
+    int32_t PackFragData(const std::shared_ptr<DataBuffer>& payload, const SessionDataHeader& headPara,
+        uint32_t offset, std::shared_ptr<DataBuffer>& fragData);
+    int32_t LendFragData(const std::shared_ptr<DataBuffer>& payload, const SessionDataHeader& headPara,
+        uint32_t offset, std::shared_ptr<DataBuffer>& fragData);
+    int32_t SendFragData(const std::shared_ptr<DataBuffer>& payload, const SessionDataHeader& headPara,
+        uint32_t offset, std::shared_ptr<DataBuffer>& scratch);
+    void CacheSendData(uint32_t seq, const std::shared_ptr<DataBuffer>& payload, uint32_t fragLen);
+    void ReleaseSendCache(int64_t nowUs);
+    int32_t RetransmitFrag(uint32_t seq, uint16_t subSeq, std::shared_ptr<DataBuffer>& fragData);
+    void HandleNack(std::shared_ptr<DataBuffer>& buffer, SessionDataHeader& headerPara);
+    void AssembleSelectiveFrag(std::shared_ptr<DataBuffer>& buffer, SessionDataHeader& headerPara);
+    int32_t PlaceFrag(FragReassembly& frag, std::shared_ptr<DataBuffer>& buffer, SessionDataHeader& headerPara);
+    uint32_t GetFragNum(uint32_t totalLen, uint32_t fragLen);
+    void CheckReassembly(uint32_t seq);
+    void GetMissingSubSeqs(const FragReassembly& frag, bool withTail, std::vector<uint16_t>& missing);
+    int32_t SendNack(uint32_t seq, const std::vector<uint16_t>& subSeqs);
+    void FinishReassembly(uint32_t seq);
+    void ResetReassembly();
 
     enum {
         FRAG_NULL = 0,
@@ -87,13 +132,29 @@ private:
         FRAG_MID,
         FRAG_END,
         FRAG_START_END,
+        FRAG_NACK,
     };
 
     static const uint32_t BINARY_DATA_MAX_TOTAL_LEN = 100 * 1024 * 1024;
     static const uint32_t BINARY_DATA_MAX_LEN = 4 * 1024 * 1024;
     static const uint32_t BINARY_DATA_PACKET_MAX_LEN = 4 * 1024 * 1024;
     static const uint32_t BINARY_DATA_PACKET_RESERVED_BUFFER = 512;
-    static const uint16_t PROTOCOL_VERSION = 1;
+    // Photos are sent in small paced fragments so they interleave with the video stream on the link
+    static const uint32_t JPEG_DATA_PACKET_MAX_LEN = 256 * 1024;
+    static const uint64_t JPEG_SEND_BYTES_PER_SECOND = 16 * 1024 * 1024;
+    static const uint64_t US_PER_SECOND = 1000000;
+    static const int64_t US_PER_MS = 1000;
+    // Version 1 senders number no payload and ignore NACKs, their fragments are assembled strictly in order
+    static const uint16_t PROTOCOL_VERSION = 2;
+    static const uint16_t NACK_PROTOCOL_VERSION = 2;
+    static const uint16_t NACK_SUBSEQ_LEN = 2;
+    static const uint32_t NACK_MAX_SUBSEQ_NUM = 256;
+    static const int64_t NACK_INTERVAL_MS = 100;
+    static const int64_t REASSEMBLY_TIMEOUT_US = 1000000;
+    static const size_t REASSEMBLY_MAX_NUM = 2;
+    static const size_t FINISHED_SEQ_NUM = 8;
+    static const size_t RETRANSMIT_CACHE_NUM = 4;
+    static const int64_t RETRANSMIT_CACHE_HOLD_US = 2000000;
     static const uint16_t HEADER_UINT8_NUM = 1;
     static const uint16_t HEADER_UINT16_NUM = 2;
     static const uint16_t HEADER_UINT32_NUM = 4;
@@ -112,6 +173,13 @@ private:
     uint32_t nowSubSeq_;
     uint32_t offset_;
     uint32_t totalLen_;
+    uint32_t packetMaxLen_ = BINARY_DATA_PACKET_MAX_LEN;
+    uint64_t sendBytesPerSecond_ = 0;
+    std::atomic<uint32_t> sendSeq_ = 0;
+    std::mutex retransmitMutex_;
+    std::map<uint32_t, RetransmitEntry> retransmitCache_;
+    std::map<uint32_t, FragReassembly> reassemblies_;
+    std::deque<uint32_t> finishedSeqs_;
 
 private:
     std::string myDhId_;
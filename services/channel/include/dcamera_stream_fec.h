@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_STREAM_FEC_H
+#define OHOS_DCAMERA_STREAM_FEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "data_buffer.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Erasure code over equally sized shards. One parity shard is the XOR of the data shards, more
+ * parity shards use a systematic Reed-Solomon code over GF(256) built from a Cauchy matrix, so any
+ * k of the k + m shards give back the data.
+ */
+class DCameraFecCodec {
+public:
+    static int32_t Encode(const std::vector<const uint8_t *>& data, size_t shardLen,
+        std::vector<std::vector<uint8_t>>& parity);
+    static int32_t Reconstruct(std::vector<std::vector<uint8_t>>& shards, const std::vector<bool>& present,
+        uint32_t dataNum, size_t shardLen);
+
+    static constexpr uint32_t MAX_SHARD_NUM = 255;
+
+private:
+    static uint8_t GetCoefficient(uint32_t parityIdx, uint32_t dataIdx, uint32_t parityNum);
+    static int32_t Invert(std::vector<uint8_t>& matrix, uint32_t size);
+};
+
+/*
+ * Splits encoded frames into shards for the stream socket. Redundancy follows the loss rate
+ * reported by the receiver, FEC stays off until a receiver reports, so peers without FEC support
+ * keep getting whole frames.
+ */
+class DCameraStreamFecEncoder {
+public:
+    void UpdateLoss(uint32_t lossPermille);
+    bool GetScheme(size_t frameLen, uint32_t& dataNum, uint32_t& parityNum);
+    static size_t GetShardLen(size_t frameLen, uint32_t dataNum);
+    static int32_t Encode(const uint8_t *frame, size_t frameLen, uint32_t dataNum, uint32_t parityNum,
+        std::vector<std::vector<uint8_t>>& parity);
+
+private:
+    static constexpr uint32_t FEC_ENABLE_PERMILLE = 5;
+    static constexpr uint32_t MIN_REDUNDANCY_PERMILLE = 100;
+    static constexpr uint32_t MAX_REDUNDANCY_PERMILLE = 500;
+    static constexpr uint32_t REDUNDANCY_PER_LOSS = 3;
+    static constexpr uint32_t PERMILLE = 1000;
+    static constexpr size_t MIN_SHARD_LEN = 1024;
+    static constexpr uint32_t MAX_DATA_SHARD_NUM = 8;
+
+    uint32_t lossPermille_ = 0;
+};
+
+/*
+ * Collects the shards of the last few frames and rebuilds a frame as soon as any k of its shards
+ * arrived. Also counts the shards and frames that never arrived, before recovery, for the loss
+ * report sent back to the sender.
+ */
+class DCameraStreamFecDecoder {
+public:
+    bool Feed(const std::shared_ptr<DataBuffer>& buffer, std::shared_ptr<DataBuffer>& frame);
+    bool PollLossReport(int64_t nowUs, uint32_t& lossPermille);
+    uint64_t GetRecoveredNum() const;
+    uint64_t GetUnrecoverableNum() const;
+
+    static std::string MarshalLossReport(uint32_t lossPermille);
+    static bool UnmarshalLossReport(const std::string& jsonStr, uint32_t& lossPermille);
+
+private:
+    struct FecGroup {
+        uint32_t dataNum = 0;
+        uint32_t parityNum = 0;
+        uint32_t frameLen = 0;
+        size_t shardLen = 0;
+        uint32_t recvNum = 0;
+        bool isDelivered = false;
+        DCameraFrameInfo frameInfo;
+        std::vector<std::vector<uint8_t>> shards;
+        std::vector<bool> present;
+    };
+
+    bool AddShard(const std::shared_ptr<DataBuffer>& buffer, std::shared_ptr<DataBuffer>& frame);
+    std::shared_ptr<DataBuffer> RebuildFrame(FecGroup& group);
+    void CountSeq(int32_t seq, uint32_t shardNum);
+    void EvictGroups(int32_t newestSeq);
+    void CloseGroup(int32_t seq, const FecGroup& group);
+
+    static constexpr int32_t GROUP_WINDOW = 4;
+    static constexpr int32_t SEQ_RESTART_GAP = 1000;
+    static constexpr int64_t REPORT_INTERVAL_US = 1000000;
+    static constexpr uint32_t PERMILLE = 1000;
+
+    std::map<int32_t, FecGroup> groups_;
+    int32_t lastSeq_ = -1;
+    uint32_t lastShardNum_ = 1;
+    uint64_t expectedNum_ = 0;
+    uint64_t lostNum_ = 0;
+    int64_t lastReportUs_ = 0;
+    uint64_t recoveredNum_ = 0;
+    uint64_t unrecoverableNum_ = 0;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_STREAM_FEC_H
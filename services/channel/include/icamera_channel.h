@@ -37,6 +37,11 @@ public:
         DCameraSessionMode sessionMode, std::shared_ptr<ICameraChannelListener>& listener) = 0;
     virtual int32_t ReleaseSession();
     virtual int32_t SendData(std::shared_ptr<DataBuffer>& buffer) = 0;
+    // True when queued data has not been sent yet, the producer should back off
+    virtual bool IsSendBusy()
+    {
+        return false;
+    }
 };
 } // namespace DistributedHardware
 } // namespace OHOS
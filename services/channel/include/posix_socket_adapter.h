@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef DCAMERA_TEST_ENABLE
+#ifndef _WIN32
+
+#ifndef OHOS_POSIX_SOCKET_ADAPTER_H
+#define OHOS_POSIX_SOCKET_ADAPTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+
+#include "i_communication_adapter.h"
+#include "icamera_channel_listener.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+typedef enum {
+    SOCKET_FAMILY_TCP = 0,
+    SOCKET_FAMILY_UNIX = 1,
+} SocketFamily;
+
+struct PosixSocketConfig {
+    SocketFamily family = SOCKET_FAMILY_TCP;
+    std::string host = "127.0.0.1";
+    // Servers listen on basePort plus a hash of the session name below portRange. When that port is
+    // taken by another session the next ones are probed, clients check the name the server sends back
+    uint16_t basePort = 50000;
+    uint16_t portRange = 1000;
+    std::string unixDir = "/tmp";
+    // Zero keeps the kernel default
+    int32_t sendBufSize = 0;
+    int32_t recvBufSize = 0;
+    size_t maxStreamQueueNum = 4;
+    size_t maxQueuedBytes = 64 * 1024 * 1024;
+    std::string localNetworkId = "LOCAL_TEST_DEVICE_001";
+};
+
+/*
+ * Loopback transport over TCP or Unix domain sockets for DCAMERA_TEST_ENABLE builds. It is only
+ * reached through CommunicationAdapterFactory and DCameraTcpAdapter, the source and sink services
+ * still talk through DCameraSoftbusAdapter. Every message goes out as a length prefixed frame. Bytes are reliable and
+ * never dropped, stream frames behave like softbus streams: when the peer falls behind the oldest
+ * queued frame is dropped instead of blocking the sender. All sockets are non-blocking and served
+ * by one epoll thread, which is also the thread the listeners are called on.
+ */
+class PosixSocketAdapter : public ICommunicationAdapter {
+public:
+    PosixSocketAdapter();
+    explicit PosixSocketAdapter(const PosixSocketConfig& config);
+    ~PosixSocketAdapter() override;
+
+    int32_t CreateSinkSocketServer(std::string mySessionName, DCAMERA_CHANNEL_ROLE role,
+        DCameraSessionMode sessionMode, std::string peerDevId, std::string peerSessionName) override;
+    int32_t CreateSourceSocketClient(std::string myDhId, std::string myDevId, std::string peerSessionName,
+        std::string peerDevId, DCameraSessionMode sessionMode, DCAMERA_CHANNEL_ROLE role) override;
+
+    int32_t DestroySessionServer(std::string sessionName) override;
+    int32_t CloseSession(int32_t socket) override;
+    int32_t SendBytes(int32_t socket, std::shared_ptr<DataBuffer> &buffer) override;
+    int32_t SendStream(int32_t socket, std::shared_ptr<DataBuffer> &buffer) override;
+    int32_t GetLocalNetworkId(std::string &myDevId) override;
+
+    void RegisterSourceListener(ICameraChannelListener* listener) override;
+    void RegisterSinkListener(ICameraChannelListener* listener) override;
+
+    uint64_t GetDroppedStreamNum(int32_t socket);
+
+private:
+    struct OutFrame {
+        uint8_t type = 0;
+        std::vector<uint8_t> data;
+        size_t sent = 0;
+    };
+
+    static constexpr size_t FRAME_HEADER_LEN = 12;
+
+    struct Connection {
+        uint64_t id = 0;
+        int32_t fd = -1;
+        DCAMERA_CHANNEL_ROLE role = DCAMERA_CHANNLE_ROLE_SOURCE;
+        std::string peerDevId;
+
+        // Receive state, only touched by the event thread
+        bool isOpened = false;
+        uint8_t header[FRAME_HEADER_LEN] = { 0 };
+        size_t headerLen = 0;
+        uint8_t type = 0;
+        std::shared_ptr<DataBuffer> body;
+        size_t bodyLen = 0;
+
+        // Send state
+        std::mutex sendMutex;
+        std::deque<OutFrame> outQueue;
+        size_t queuedBytes = 0;
+        size_t queuedStreamNum = 0;
+        bool isWriteWatched = false;
+        uint64_t droppedStreamNum = 0;
+        std::atomic<bool> isClosed { false };
+    };
+
+    struct ServerEntry {
+        uint64_t id = 0;
+        int32_t fd = -1;
+        DCAMERA_CHANNEL_ROLE role = DCAMERA_CHANNLE_ROLE_SINK;
+        std::string path;
+        std::string sessionName;
+    };
+
+    int32_t Init();
+    void Stop();
+    void EventLoop();
+    void Wakeup();
+    void ClosePendingFds();
+
+    int32_t CreateSocket();
+    int32_t BuildAddress(const std::string& sessionName, uint32_t probe, sockaddr_storage& addr,
+        socklen_t& addrLen, std::string& path);
+    int32_t BindServer(int32_t fd, const std::string& sessionName, std::string& path);
+    int32_t ConnectServer(const std::string& peerSessionName);
+    bool CheckSessionName(int32_t fd, const std::string& peerSessionName);
+    void ApplySocketOptions(int32_t fd);
+    std::shared_ptr<Connection> AddConnection(int32_t fd, DCAMERA_CHANNEL_ROLE role, const std::string& peerDevId,
+        const std::string& sessionName);
+    std::shared_ptr<Connection> FindConnection(int32_t socket);
+    void CloseConnection(const std::shared_ptr<Connection>& conn, bool isNotify);
+
+    void HandleAccept(const std::shared_ptr<ServerEntry>& server);
+    void HandleRead(const std::shared_ptr<Connection>& conn);
+    void HandleWrite(const std::shared_ptr<Connection>& conn);
+    bool OnHeader(const std::shared_ptr<Connection>& conn);
+    void OnFrame(const std::shared_ptr<Connection>& conn, uint8_t type, std::shared_ptr<DataBuffer>& body);
+
+    int32_t SendFrame(int32_t socket, uint8_t type, const uint8_t *data, size_t len);
+    bool DropQueuedStream(Connection& conn);
+    void WatchWrite(Connection& conn, bool isEnable);
+    ICameraChannelListener* GetListener(DCAMERA_CHANNEL_ROLE role);
+
+    static constexpr uint32_t FRAME_MAGIC = 0x4443534b;
+    static constexpr uint8_t FRAME_HELLO = 1;
+    static constexpr uint8_t FRAME_BYTES = 2;
+    static constexpr uint8_t FRAME_STREAM = 3;
+    // Sent by a server ahead of its hello so the client can tell it reached the session it asked for
+    static constexpr uint8_t FRAME_SESSION = 4;
+    static constexpr uint32_t MAX_PORT_PROBES = 8;
+    static constexpr int32_t SESSION_CHECK_TIMEOUT_MS = 1000;
+    static constexpr uint64_t WAKEUP_ID = 0;
+    static constexpr int32_t MAX_EPOLL_EVENTS = 32;
+    static constexpr int32_t MAX_READ_PER_EVENT = 64;
+
+    PosixSocketConfig config_;
+    bool isInitialized_ = false;
+    int32_t epollFd_ = -1;
+    int32_t wakeupFd_ = -1;
+    std::atomic<bool> isStopping_ { false };
+    std::thread loopThread_;
+
+    std::mutex connMutex_;
+    uint64_t nextId_ = WAKEUP_ID + 1;
+    std::map<uint64_t, std::shared_ptr<Connection>> connections_;
+    std::map<int32_t, uint64_t> socketIds_;
+    std::map<uint64_t, std::shared_ptr<ServerEntry>> servers_;
+    std::map<std::string, uint64_t> serverIds_;
+
+    // Descriptors are closed by the event thread once it no longer holds them
+    std::mutex pendingMutex_;
+    std::vector<int32_t> pendingCloseFds_;
+
+    std::atomic<ICameraChannelListener*> sourceListener_ { nullptr };
+    std::atomic<ICameraChannelListener*> sinkListener_ { nullptr };
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // OHOS_POSIX_SOCKET_ADAPTER_H
+
+#endif // _WIN32
+#endif // DCAMERA_TEST_ENABLE
@@ -16,21 +16,62 @@
 #ifdef DCAMERA_TEST_ENABLE
 
 #include "communication_adapter_factory.h"
+#ifdef _WIN32
 #include "local_tcp_adapter.h"
+#else
+#include "posix_socket_adapter.h"
+#endif
 #include <cstdlib>
 #include <string>
 
 namespace OHOS {
 namespace DistributedHardware {
+#ifndef _WIN32
+namespace {
+int32_t GetEnvInt(const char *name, int32_t defaultValue)
+{
+    const char *value = std::getenv(name);
+    if (value == nullptr) {
+        return defaultValue;
+    }
+    char *end = nullptr;
+    long result = std::strtol(value, &end, 10);
+    return (end == value || result < 0) ? defaultValue : static_cast<int32_t>(result);
+}
 
-std::unique_ptr<ICommunicationAdapter> CommunicationAdapterFactory::CreateAdapter(CommunicationMode mode) {
-    switch (mode) {
-        case COMM_MODE_TCP:
-            return std::make_unique<LocalTcpAdapter>();
-        default:
-            // Default to TCP for Windows local testing
-            return std::make_unique<LocalTcpAdapter>();
+PosixSocketConfig GetSocketConfigFromEnvironment(CommunicationMode mode)
+{
+    PosixSocketConfig config;
+    config.family = (mode == COMM_MODE_UNIX) ? SOCKET_FAMILY_UNIX : SOCKET_FAMILY_TCP;
+    const char *host = std::getenv("DCAMERA_SOCKET_HOST");
+    if (host != nullptr) {
+        config.host = host;
+    }
+    const char *dir = std::getenv("DCAMERA_SOCKET_DIR");
+    if (dir != nullptr) {
+        config.unixDir = dir;
+    }
+    const char *networkId = std::getenv("DCAMERA_LOCAL_NETWORK_ID");
+    if (networkId != nullptr) {
+        config.localNetworkId = networkId;
     }
+    config.basePort = static_cast<uint16_t>(GetEnvInt("DCAMERA_SOCKET_BASE_PORT", config.basePort));
+    config.sendBufSize = GetEnvInt("DCAMERA_SOCKET_SNDBUF", config.sendBufSize);
+    config.recvBufSize = GetEnvInt("DCAMERA_SOCKET_RCVBUF", config.recvBufSize);
+    config.maxStreamQueueNum = static_cast<size_t>(GetEnvInt("DCAMERA_SOCKET_STREAM_QUEUE",
+        static_cast<int32_t>(config.maxStreamQueueNum)));
+    return config;
+}
+}
+#endif
+
+std::unique_ptr<ICommunicationAdapter> CommunicationAdapterFactory::CreateAdapter(CommunicationMode mode) {
+#ifdef _WIN32
+    // Winsock only offers TCP here
+    return std::make_unique<LocalTcpAdapter>();
+#else
+    return std::make_unique<PosixSocketAdapter>(GetSocketConfigFromEnvironment(mode));
+#endif
 }
 
 std::unique_ptr<ICommunicationAdapter> CommunicationAdapterFactory::CreateAdapterFromConfig() {
@@ -45,6 +86,9 @@ CommunicationMode CommunicationAdapterFactory::GetModeFromEnvironment() {
         if (modeString == "tcp") {
             return COMM_MODE_TCP;
         }
+        if (modeString == "unix") {
+            return COMM_MODE_UNIX;
+        }
     }
     // Default to TCP
     return COMM_MODE_TCP;
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_channel_recorder.h"
+
+#include <chrono>
+#include <map>
+#include <sys/prctl.h>
+#include <thread>
+
+#include "securec.h"
+
+#include "dcamera_softbus_adapter.h"
+#include "dcamera_softbus_session.h"
+#include "dcamera_stream_fec.h"
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+IMPLEMENT_SINGLE_INSTANCE(DCameraChannelRecorder);
+namespace {
+const std::string CHANNEL_RECORD_THREAD = "DCamChannelRec";
+}
+
+DCameraChannelRecorder::~DCameraChannelRecorder()
+{
+    StopRecord();
+}
+
+int32_t DCameraChannelRecorder::StartRecord(const std::string& recordFile, const std::string& indexFile)
+{
+    std::unique_lock<std::mutex> lock(recordLock_);
+    if (isRecording_.load()) {
+        DHLOGI("channel recorder is already running.");
+        return DCAMERA_OK;
+    }
+    if (writeThread_.joinable()) {
+        // The writer stopped itself after a write error, reap it before starting again
+        lock.unlock();
+        StopRecord();
+        lock.lock();
+    }
+    recordFile_ = fopen(recordFile.c_str(), "wb");
+    CHECK_AND_RETURN_RET_LOG(recordFile_ == nullptr, DCAMERA_INIT_ERR, "open channel record file failed.");
+    indexFile_ = fopen(indexFile.c_str(), "wb");
+    if (indexFile_ == nullptr) {
+        DHLOGE("open channel record index file failed.");
+        CloseFiles();
+        return DCAMERA_INIT_ERR;
+    }
+    DCameraRecordFileHeader fileHeader = { DCAMERA_RECORD_MAGIC, DCAMERA_RECORD_VERSION };
+    if (fwrite(&fileHeader, sizeof(fileHeader), 1, recordFile_) != 1) {
+        DHLOGE("write channel record file header failed.");
+        CloseFiles();
+        return DCAMERA_INIT_ERR;
+    }
+    offset_ = sizeof(fileHeader);
+    recordCount_ = 0;
+    dropCount_ = 0;
+    pendingBytes_ = 0;
+    isStopping_ = false;
+    isRecording_.store(true);
+    writeThread_ = std::thread([this]() { WriteLoop(); });
+    DHLOGI("channel recorder start.");
+    return DCAMERA_OK;
+}
+
+int32_t DCameraChannelRecorder::StopRecord()
+{
+    {
+        std::lock_guard<std::mutex> lock(recordLock_);
+        if (!writeThread_.joinable()) {
+            return DCAMERA_OK;
+        }
+        isRecording_.store(false);
+        isStopping_ = true;
+    }
+    recordCond_.notify_one();
+    writeThread_.join();
+    std::lock_guard<std::mutex> lock(recordLock_);
+    CloseFiles();
+    std::deque<DCameraChannelRecord>().swap(pendingRecords_);
+    pendingBytes_ = 0;
+    DHLOGI("channel recorder stop, record count: %{public}" PRIu64 ", drop count: %{public}" PRIu64,
+        recordCount_, dropCount_);
+    return DCAMERA_OK;
+}
+
+bool DCameraChannelRecorder::IsRecording()
+{
+    return isRecording_.load();
+}
+
+uint64_t DCameraChannelRecorder::GetRecordCount()
+{
+    std::lock_guard<std::mutex> lock(recordLock_);
+    return recordCount_;
+}
+
+uint64_t DCameraChannelRecorder::GetDropCount()
+{
+    std::lock_guard<std::mutex> lock(recordLock_);
+    return dropCount_;
+}
+
+void DCameraChannelRecorder::Record(DCameraRecordType type, int32_t socket, int64_t recvTimeUs, const void *data,
+    uint32_t dataLen, const void *ext, uint32_t extLen)
+{
+    if (!isRecording_.load() || data == nullptr || dataLen == 0) {
+        return;
+    }
+    if (ext == nullptr) {
+        extLen = 0;
+    }
+    std::lock_guard<std::mutex> lock(recordLock_);
+    if (!isRecording_.load()) {
+        return;
+    }
+    if (pendingBytes_ + dataLen + extLen > MAX_PENDING_BYTES) {
+        dropCount_++;
+        return;
+    }
+    DCameraChannelRecord record;
+    record.type = type;
+    record.socket = socket;
+    record.recvTimeUs = recvTimeUs;
+    record.data = std::make_shared<DataBuffer>(dataLen);
+    if (memcpy_s(record.data->Data(), record.data->Capacity(), data, dataLen) != EOK) {
+        dropCount_++;
+        return;
+    }
+    record.ext.assign(static_cast<const char *>(ext), extLen);
+    pendingBytes_ += dataLen + extLen;
+    pendingRecords_.push_back(std::move(record));
+    recordCount_++;
+    recordCond_.notify_one();
+}
+
+void DCameraChannelRecorder::WriteLoop()
+{
+    prctl(PR_SET_NAME, CHANNEL_RECORD_THREAD.c_str());
+    std::deque<DCameraChannelRecord> records;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(recordLock_);
+            recordCond_.wait(lock, [this] { return !pendingRecords_.empty() || isStopping_; });
+            if (pendingRecords_.empty()) {
+                return;
+            }
+            records.swap(pendingRecords_);
+            pendingBytes_ = 0;
+        }
+        bool isWriteOk = true;
+        for (const auto& record : records) {
+            isWriteOk = WriteRecord(record);
+            if (!isWriteOk) {
+                break;
+            }
+        }
+        records.clear();
+        if (isWriteOk && fflush(recordFile_) == 0 && fflush(indexFile_) == 0) {
+            continue;
+        }
+        DHLOGE("write channel record failed, stop recording.");
+        std::lock_guard<std::mutex> lock(recordLock_);
+        isRecording_.store(false);
+        CloseFiles();
+        std::deque<DCameraChannelRecord>().swap(pendingRecords_);
+        pendingBytes_ = 0;
+        return;
+    }
+}
+
+bool DCameraChannelRecorder::WriteRecord(const DCameraChannelRecord& record)
+{
+    uint32_t dataLen = static_cast<uint32_t>(record.data->Size());
+    uint32_t extLen = static_cast<uint32_t>(record.ext.size());
+    DCameraRecordHeader header = { static_cast<uint32_t>(record.type), record.socket, record.recvTimeUs, dataLen,
+        extLen };
+    bool isWriteOk = fwrite(&header, sizeof(header), 1, recordFile_) == 1 &&
+        fwrite(record.data->Data(), 1, dataLen, recordFile_) == dataLen &&
+        (extLen == 0 || fwrite(record.ext.data(), 1, extLen, recordFile_) == extLen);
+    CHECK_AND_RETURN_RET_LOG(!isWriteOk, false, "%{public}s", "write channel record failed.");
+    DCameraRecordIndex index = { offset_, record.recvTimeUs };
+    CHECK_AND_RETURN_RET_LOG(fwrite(&index, sizeof(index), 1, indexFile_) != 1, false, "%{public}s",
+        "write channel record index failed.");
+    offset_ += sizeof(header) + dataLen + extLen;
+    return true;
+}
+
+void DCameraChannelRecorder::CloseFiles()
+{
+    if (recordFile_ != nullptr) {
+        fclose(recordFile_);
+        recordFile_ = nullptr;
+    }
+    if (indexFile_ != nullptr) {
+        fclose(indexFile_);
+        indexFile_ = nullptr;
+    }
+}
+
+DCameraChannelReplayer::~DCameraChannelReplayer()
+{
+    Close();
+}
+
+int32_t DCameraChannelReplayer::Open(const std::string& recordFile, const std::string& indexFile)
+{
+    Close();
+    FILE *idxFile = fopen(indexFile.c_str(), "rb");
+    CHECK_AND_RETURN_RET_LOG(idxFile == nullptr, DCAMERA_INIT_ERR, "open channel record index file failed.");
+    DCameraRecordIndex entry;
+    while (fread(&entry, sizeof(entry), 1, idxFile) == 1) {
+        index_.push_back(entry);
+    }
+    fclose(idxFile);
+
+    recordFile_ = fopen(recordFile.c_str(), "rb");
+    if (recordFile_ == nullptr) {
+        DHLOGE("open channel record file failed.");
+        index_.clear();
+        return DCAMERA_INIT_ERR;
+    }
+    DCameraRecordFileHeader fileHeader;
+    if (fread(&fileHeader, sizeof(fileHeader), 1, recordFile_) != 1 || fileHeader.magic != DCAMERA_RECORD_MAGIC ||
+        fileHeader.version != DCAMERA_RECORD_VERSION) {
+        DHLOGE("channel record file header is invalid.");
+        Close();
+        return DCAMERA_BAD_VALUE;
+    }
+    DHLOGI("channel replayer open, record count: %{public}zu", index_.size());
+    return DCAMERA_OK;
+}
+
+void DCameraChannelReplayer::Close()
+{
+    if (recordFile_ != nullptr) {
+        fclose(recordFile_);
+        recordFile_ = nullptr;
+    }
+    index_.clear();
+}
+
+size_t DCameraChannelReplayer::GetRecordCount()
+{
+    return index_.size();
+}
+
+int32_t DCameraChannelReplayer::ReadRecord(size_t index, DCameraChannelRecord& record)
+{
+    CHECK_AND_RETURN_RET_LOG(recordFile_ == nullptr, DCAMERA_WRONG_STATE, "channel replayer is not opened.");
+    CHECK_AND_RETURN_RET_LOG(index >= index_.size(), DCAMERA_BAD_VALUE, "record index out of range.");
+    if (fseeko(recordFile_, static_cast<off_t>(index_[index].offset), SEEK_SET) != 0) {
+        DHLOGE("seek channel record failed, index: %{public}zu", index);
+        return DCAMERA_BAD_OPERATE;
+    }
+    DCameraRecordHeader header;
+    if (fread(&header, sizeof(header), 1, recordFile_) != 1 || header.dataLen == 0 ||
+        header.dataLen > DCAMERA_MAX_RECV_DATA_LEN || header.extLen > DCAMERA_MAX_RECV_EXT_LEN) {
+        DHLOGE("channel record header is invalid, index: %{public}zu", index);
+        return DCAMERA_BAD_VALUE;
+    }
+    record.type = static_cast<DCameraRecordType>(header.type);
+    record.socket = header.socket;
+    record.recvTimeUs = header.recvTimeUs;
+    record.data = std::make_shared<DataBuffer>(header.dataLen);
+    if (fread(record.data->Data(), 1, header.dataLen, recordFile_) != header.dataLen) {
+        DHLOGE("read channel record payload failed, index: %{public}zu", index);
+        return DCAMERA_BAD_VALUE;
+    }
+    record.ext.assign(header.extLen, '\0');
+    if (header.extLen > 0 && fread(&record.ext[0], 1, header.extLen, recordFile_) != header.extLen) {
+        DHLOGE("read channel record ext failed, index: %{public}zu", index);
+        return DCAMERA_BAD_VALUE;
+    }
+    return DCAMERA_OK;
+}
+
+int32_t DCameraChannelReplayer::BuildReplayBuffer(DCameraChannelRecord& record, int64_t recvTimeUs)
+{
+    if (record.type != DCAMERA_RECORD_TYPE_STREAM) {
+        return DCAMERA_OK;
+    }
+    record.data->SetInt64(RECV_TIME_US, recvTimeUs);
+    StreamData ext = { const_cast<char *>(record.ext.data()), static_cast<int32_t>(record.ext.size()) };
+    return DCameraSoftbusAdapter::GetInstance().HandleSourceStreamExt(record.data, &ext);
+}
+
+int32_t DCameraChannelReplayer::Replay(std::shared_ptr<DCameraSoftbusSession>& session, int32_t socket,
+    DCameraReplayPacing pacing)
+{
+    CHECK_AND_RETURN_RET_LOG(session == nullptr, DCAMERA_BAD_VALUE, "replay session is null.");
+    CHECK_AND_RETURN_RET_LOG(index_.empty(), DCAMERA_NOT_FOUND, "no channel record to replay.");
+    DHLOGI("channel replay start, socket: %{public}d, pacing: %{public}d", socket, pacing);
+    auto replayStart = std::chrono::steady_clock::now();
+    int64_t firstRecvTimeUs = index_.front().recvTimeUs;
+    size_t replayCount = 0;
+    errorCount_ = 0;
+    // The replay keeps its own decoders, the adapter ones belong to the live sockets
+    std::map<int32_t, DCameraStreamFecDecoder> fecDecoders;
+    for (size_t i = 0; i < index_.size(); i++) {
+        DCameraChannelRecord record;
+        int32_t ret = ReadRecord(i, record);
+        CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "read channel record failed, index: %{public}zu", i);
+        if (socket >= 0 && record.socket != socket) {
+            continue;
+        }
+        int64_t recvTimeUs = record.recvTimeUs;
+        if (pacing == DCAMERA_REPLAY_PACING_ORIGINAL) {
+            std::this_thread::sleep_until(replayStart +
+                std::chrono::microseconds(record.recvTimeUs - firstRecvTimeUs));
+            recvTimeUs = GetNowTimeStampUs();
+        }
+        std::shared_ptr<DataBuffer> frame = record.data;
+        if (BuildReplayBuffer(record, recvTimeUs) != DCAMERA_OK) {
+            // A frame without valid frame info would reach the sink pipeline as if it were valid
+            DHLOGE("channel replay stream ext is invalid, skip index: %{public}zu", i);
+            errorCount_++;
+            continue;
+        }
+        if (record.type == DCAMERA_RECORD_TYPE_STREAM) {
+            // Shards are rebuilt into frames as on the live path, no loss report goes back to a recorded socket
+            if (!fecDecoders[record.socket].Feed(record.data, frame)) {
+                continue;
+            }
+        }
+        session->OnDataReceived(frame);
+        replayCount++;
+    }
+    DHLOGI("channel replay end, replay count: %{public}zu, error count: %{public}zu", replayCount, errorCount_);
+    return DCAMERA_OK;
+}
+
+size_t DCameraChannelReplayer::GetErrorCount()
+{
+    return errorCount_;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_channel_sink_fanout.h"
+
+#include "anonymous_string.h"
+#include "dcamera_channel_sink_impl.h"
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+class FanoutSubscriberListener : public ICameraChannelListener {
+public:
+    FanoutSubscriberListener(const std::shared_ptr<DCameraChannelSinkFanout>& fanout, const std::string& devId,
+        const std::shared_ptr<ICameraChannelListener>& forward)
+        : fanout_(fanout), devId_(devId), forward_(forward)
+    {
+    }
+
+    void OnSessionState(int32_t state, std::string networkId) override
+    {
+        std::shared_ptr<DCameraChannelSinkFanout> fanout = fanout_.lock();
+        if (fanout != nullptr) {
+            fanout->OnSubscriberState(devId_, state);
+        }
+        if (forward_ != nullptr) {
+            forward_->OnSessionState(state, networkId);
+        }
+    }
+
+    void OnSessionError(int32_t eventType, int32_t eventReason, std::string detail) override
+    {
+        if (forward_ != nullptr) {
+            forward_->OnSessionError(eventType, eventReason, detail);
+        }
+    }
+
+    void OnDataReceived(std::vector<std::shared_ptr<DataBuffer>>& buffers) override
+    {
+        if (forward_ != nullptr) {
+            forward_->OnDataReceived(buffers);
+        }
+    }
+
+private:
+    std::weak_ptr<DCameraChannelSinkFanout> fanout_;
+    std::string devId_;
+    std::shared_ptr<ICameraChannelListener> forward_;
+};
+}
+
+DCameraChannelSinkFanout::~DCameraChannelSinkFanout()
+{
+    ReleaseSession();
+}
+
+int32_t DCameraChannelSinkFanout::CloseSession()
+{
+    std::lock_guard<std::mutex> lock(subscriberMutex_);
+    int32_t result = DCAMERA_OK;
+    for (auto& iter : subscribers_) {
+        int32_t ret = iter.second->channel->CloseSession();
+        if (ret != DCAMERA_OK) {
+            DHLOGE("DCameraChannelSinkFanout CloseSession devId: %{public}s ret: %{public}d",
+                GetAnonyString(iter.first).c_str(), ret);
+            result = ret;
+        }
+    }
+    return result;
+}
+
+int32_t DCameraChannelSinkFanout::CreateSession(std::vector<DCameraIndex>& camIndexs, std::string sessionFlag,
+    DCameraSessionMode sessionMode, std::shared_ptr<ICameraChannelListener>& listener)
+{
+    if (camIndexs.empty() || listener == nullptr) {
+        return DCAMERA_BAD_VALUE;
+    }
+    mode_ = sessionMode;
+    return CreateSubscriberSession(camIndexs, sessionFlag, listener);
+}
+
+int32_t DCameraChannelSinkFanout::AddSubscriberSession(std::vector<DCameraIndex>& camIndexs, std::string sessionFlag)
+{
+    if (camIndexs.empty()) {
+        return DCAMERA_BAD_VALUE;
+    }
+    // Session state of extra viewers is kept inside the fan-out, only the primary one reaches the output
+    return CreateSubscriberSession(camIndexs, sessionFlag, nullptr);
+}
+
+int32_t DCameraChannelSinkFanout::CreateSubscriberSession(std::vector<DCameraIndex>& camIndexs,
+    std::string sessionFlag, const std::shared_ptr<ICameraChannelListener>& forward)
+{
+    std::string devId = camIndexs[0].devId_;
+    std::shared_ptr<ICameraChannel> channel = std::make_shared<DCameraChannelSinkImpl>();
+    // Register before the session is created, it may report CONNECTED before CreateSession returns
+    std::shared_ptr<Subscriber> sub = RegisterSubscriber(devId, channel, forward != nullptr);
+    if (sub == nullptr) {
+        return DCAMERA_BAD_OPERATE;
+    }
+    std::shared_ptr<ICameraChannelListener> listener =
+        std::make_shared<FanoutSubscriberListener>(shared_from_this(), devId, forward);
+    int32_t ret = channel->CreateSession(camIndexs, sessionFlag, mode_, listener);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraChannelSinkFanout create session failed, devId: %{public}s, ret: %{public}d",
+            GetAnonyString(devId).c_str(), ret);
+        UnregisterSubscriber(sub);
+        return ret;
+    }
+    return DCAMERA_OK;
+}
+
+int32_t DCameraChannelSinkFanout::AddSubscriber(const std::string& devId,
+    const std::shared_ptr<ICameraChannel>& channel)
+{
+    CHECK_AND_RETURN_RET_LOG(channel == nullptr, DCAMERA_BAD_VALUE, "AddSubscriber channel is null");
+    return (RegisterSubscriber(devId, channel, false) == nullptr) ? DCAMERA_BAD_OPERATE : DCAMERA_OK;
+}
+
+std::shared_ptr<DCameraChannelSinkFanout::Subscriber> DCameraChannelSinkFanout::RegisterSubscriber(
+    const std::string& devId, const std::shared_ptr<ICameraChannel>& channel, bool primary)
+{
+    std::shared_ptr<Subscriber> old = nullptr;
+    auto sub = std::make_shared<Subscriber>();
+    sub->devId = devId;
+    sub->channel = channel;
+    sub->primary = primary;
+    {
+        std::lock_guard<std::mutex> lock(subscriberMutex_);
+        auto iter = subscribers_.find(devId);
+        if (iter != subscribers_.end()) {
+            if (iter->second->primary && !primary) {
+                DHLOGE("DCameraChannelSinkFanout devId: %{public}s is the primary viewer",
+                    GetAnonyString(devId).c_str());
+                return nullptr;
+            }
+            old = iter->second;
+        }
+        // Photo sends are paced by sleeping, they would hold a shared worker for the whole picture
+        sub->sendStrand = DCameraExecutor::GetInstance().CreateStrand(GetAnonyString(devId) + "/fanout",
+            mode_ == DCAMERA_SESSION_MODE_JPEG);
+        subscribers_[devId] = sub;
+        DHLOGI("DCameraChannelSinkFanout add subscriber devId: %{public}s, count: %{public}zu",
+            GetAnonyString(devId).c_str(), subscribers_.size());
+    }
+    if (old != nullptr) {
+        StopSubscriber(old);
+        old->channel->ReleaseSession();
+    }
+    return sub;
+}
+
+void DCameraChannelSinkFanout::UnregisterSubscriber(const std::shared_ptr<Subscriber>& sub)
+{
+    {
+        std::lock_guard<std::mutex> lock(subscriberMutex_);
+        auto iter = subscribers_.find(sub->devId);
+        if (iter != subscribers_.end() && iter->second == sub) {
+            subscribers_.erase(iter);
+        }
+    }
+    StopSubscriber(sub);
+}
+
+int32_t DCameraChannelSinkFanout::RemoveSubscriber(const std::string& devId)
+{
+    std::shared_ptr<Subscriber> sub = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(subscriberMutex_);
+        auto iter = subscribers_.find(devId);
+        if (iter == subscribers_.end()) {
+            return DCAMERA_NOT_FOUND;
+        }
+        // The primary viewer owns the output session state, it only goes away with ReleaseSession
+        CHECK_AND_RETURN_RET_LOG(iter->second->primary, DCAMERA_BAD_OPERATE,
+            "RemoveSubscriber devId: %{public}s is the primary viewer", GetAnonyString(devId).c_str());
+        sub = iter->second;
+        subscribers_.erase(iter);
+    }
+    StopSubscriber(sub);
+    sub->channel->ReleaseSession();
+    return DCAMERA_OK;
+}
+
+int32_t DCameraChannelSinkFanout::ReleaseSession()
+{
+    std::map<std::string, std::shared_ptr<Subscriber>> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(subscriberMutex_);
+        subscribers.swap(subscribers_);
+        codecData_ = nullptr;
+    }
+    for (auto& iter : subscribers) {
+        StopSubscriber(iter.second);
+        iter.second->channel->ReleaseSession();
+    }
+    return DCAMERA_OK;
+}
+
+void DCameraChannelSinkFanout::OnSubscriberState(const std::string& devId, int32_t state)
+{
+    std::shared_ptr<Subscriber> sub = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(subscriberMutex_);
+        auto iter = subscribers_.find(devId);
+        if (iter == subscribers_.end()) {
+            return;
+        }
+        sub = iter->second;
+    }
+    bool connected = (state == DCAMERA_CHANNEL_STATE_CONNECTED);
+    {
+        std::lock_guard<std::mutex> lock(sub->queueMutex);
+        sub->connected = connected;
+        sub->waitKeyFrame = true;
+        sub->queue.clear();
+    }
+    DHLOGI("DCameraChannelSinkFanout subscriber devId: %{public}s state: %{public}d",
+        GetAnonyString(devId).c_str(), state);
+    if (connected) {
+        RequestKeyFrame(true);
+    }
+}
+
+void DCameraChannelSinkFanout::SetKeyFrameRequester(KeyFrameRequester requester)
+{
+    std::lock_guard<std::mutex> lock(requesterMutex_);
+    keyFrameRequester_ = requester;
+}
+
+size_t DCameraChannelSinkFanout::GetSubscriberCount()
+{
+    std::lock_guard<std::mutex> lock(subscriberMutex_);
+    return subscribers_.size();
+}
+
+int32_t DCameraChannelSinkFanout::SendData(std::shared_ptr<DataBuffer>& buffer)
+{
+    CHECK_AND_RETURN_RET_LOG(buffer == nullptr, DCAMERA_BAD_VALUE, "SendData buffer is null");
+    bool isCodecData = IsCodecData(buffer);
+    bool isKeyFrame = !isCodecData && IsKeyFrame(buffer);
+    bool needKeyFrame = false;
+    size_t accepted = 0;
+    {
+        std::lock_guard<std::mutex> lock(subscriberMutex_);
+        if (isCodecData) {
+            codecData_ = buffer;
+        }
+        for (auto& iter : subscribers_) {
+            if (EnqueueFrame(iter.second, buffer, isKeyFrame, isCodecData, needKeyFrame)) {
+                accepted++;
+            }
+        }
+    }
+    if (needKeyFrame) {
+        RequestKeyFrame(false);
+    }
+    return (accepted > 0) ? DCAMERA_OK : DCAMERA_TRANS_BUSY;
+}
+
+bool DCameraChannelSinkFanout::EnqueueFrame(const std::shared_ptr<Subscriber>& sub,
+    const std::shared_ptr<DataBuffer>& buffer, bool isKeyFrame, bool isCodecData, bool& needKeyFrame)
+{
+    {
+        std::lock_guard<std::mutex> lock(sub->queueMutex);
+        if (!sub->connected) {
+            return false;
+        }
+        if (isCodecData && sub->waitKeyFrame) {
+            // Cached, it is queued right before the key frame this viewer starts on
+            return false;
+        }
+        int32_t layer = GetTemporalLayer(buffer);
+        if (layer == TEMPORAL_BASE_LAYER) {
+            sub->shedUntilBase = false;
+        }
+        if (sub->queue.size() >= DCAMERA_FANOUT_QUEUE_SIZE) {
+            // Lower the frame rate first, the base layer still decodes without the enhancement layers
+            ShedEnhancementLayers(sub);
+            sub->shedUntilBase = true;
+        }
+        if (sub->queue.size() >= DCAMERA_FANOUT_QUEUE_SIZE) {
+            // The viewer cannot keep up, restart it from the next key frame instead of sending stale frames
+            sub->dropped += sub->queue.size();
+            sub->queue.clear();
+            sub->waitKeyFrame = true;
+            needKeyFrame = true;
+            DHLOGI("DCameraChannelSinkFanout subscriber devId: %{public}s overflow, dropped: %{public}" PRIu64,
+                GetAnonyString(sub->devId).c_str(), sub->dropped);
+        }
+        if (sub->waitKeyFrame) {
+            if (!isKeyFrame) {
+                sub->skipped++;
+                return false;
+            }
+            sub->waitKeyFrame = false;
+            // A late joiner cannot decode anything without the parameter sets sent at encoder start
+            if (codecData_ != nullptr && codecData_ != buffer) {
+                sub->queue.push_back(codecData_);
+            }
+        }
+        if (sub->shedUntilBase && layer != TEMPORAL_BASE_LAYER) {
+            sub->dropped++;
+            return false;
+        }
+        sub->queue.push_back(buffer);
+        if (sub->sendPosted) {
+            return true;
+        }
+        sub->sendPosted = true;
+    }
+    PostSend(sub);
+    return true;
+}
+
+bool DCameraChannelSinkFanout::IsSendBusy()
+{
+    std::lock_guard<std::mutex> lock(subscriberMutex_);
+    bool hasActive = false;
+    for (auto& iter : subscribers_) {
+        std::lock_guard<std::mutex> queueLock(iter.second->queueMutex);
+        if (!iter.second->connected || iter.second->waitKeyFrame) {
+            continue;
+        }
+        // The encoder only backs off when every viewer is behind, slower ones drop to key frames
+        if (iter.second->queue.empty()) {
+            return false;
+        }
+        hasActive = true;
+    }
+    return hasActive;
+}
+
+void DCameraChannelSinkFanout::PostSend(const std::shared_ptr<Subscriber>& sub)
+{
+    int32_t ret = sub->sendStrand->Post([this, sub]() { this->SendPending(sub); });
+    if (ret != DCAMERA_OK) {
+        DHLOGD("DCameraChannelSinkFanout subscriber devId: %{public}s stopped", GetAnonyString(sub->devId).c_str());
+    }
+}
+
+void DCameraChannelSinkFanout::SendPending(const std::shared_ptr<Subscriber>& sub)
+{
+    std::shared_ptr<DataBuffer> buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(sub->queueMutex);
+        if (sub->queue.empty()) {
+            sub->sendPosted = false;
+            return;
+        }
+        buffer = sub->queue.front();
+        sub->queue.pop_front();
+    }
+    int32_t ret = sub->channel->SendData(buffer);
+    bool hasMore = false;
+    {
+        std::lock_guard<std::mutex> lock(sub->queueMutex);
+        if (ret == DCAMERA_OK) {
+            sub->sent++;
+        } else {
+            sub->sendFailed++;
+        }
+        hasMore = !sub->queue.empty();
+        sub->sendPosted = hasMore;
+    }
+    // One frame per task, a busy viewer goes back behind the other strands of the pool
+    if (hasMore) {
+        PostSend(sub);
+    }
+}
+
+void DCameraChannelSinkFanout::StopSubscriber(const std::shared_ptr<Subscriber>& sub)
+{
+    {
+        std::lock_guard<std::mutex> lock(sub->queueMutex);
+        sub->connected = false;
+        sub->queue.clear();
+    }
+    sub->sendStrand->Stop();
+    std::lock_guard<std::mutex> lock(sub->queueMutex);
+    DHLOGI("DCameraChannelSinkFanout subscriber stopped, devId: %{public}s, sent: %{public}" PRIu64", failed: "
+        "%{public}" PRIu64", dropped: %{public}" PRIu64", skipped: %{public}" PRIu64, GetAnonyString(sub->devId).c_str(),
+        sub->sent, sub->sendFailed, sub->dropped, sub->skipped);
+}
+
+void DCameraChannelSinkFanout::RequestKeyFrame(bool force)
+{
+    KeyFrameRequester requester = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(requesterMutex_);
+        int64_t nowUs = GetNowTimeStampUs();
+        if (!force && nowUs - lastKeyFrameRequestUs_ < DCAMERA_FANOUT_KEYFRAME_INTERVAL_US) {
+            return;
+        }
+        lastKeyFrameRequestUs_ = nowUs;
+        requester = keyFrameRequester_;
+    }
+    if (requester == nullptr) {
+        DHLOGD("DCameraChannelSinkFanout no key frame requester, wait for the next sync frame");
+        return;
+    }
+    int32_t ret = requester();
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraChannelSinkFanout request key frame failed, ret: %{public}d", ret);
+    }
+}
+
+void DCameraChannelSinkFanout::ShedEnhancementLayers(const std::shared_ptr<Subscriber>& sub)
+{
+    size_t queueSize = sub->queue.size();
+    for (auto iter = sub->queue.begin(); iter != sub->queue.end();) {
+        if (!IsCodecData(*iter) && GetTemporalLayer(*iter) != TEMPORAL_BASE_LAYER) {
+            iter = sub->queue.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+    sub->dropped += queueSize - sub->queue.size();
+}
+
+int32_t DCameraChannelSinkFanout::GetTemporalLayer(const std::shared_ptr<DataBuffer>& buffer)
+{
+    int32_t layer = TEMPORAL_BASE_LAYER;
+    if (!buffer->FindInt32(TEMPORAL_LAYER, layer)) {
+        return TEMPORAL_BASE_LAYER;
+    }
+    return layer;
+}
+
+bool DCameraChannelSinkFanout::IsKeyFrame(const std::shared_ptr<DataBuffer>& buffer)
+{
+    int32_t frameType = DCAMERA_FANOUT_FRAME_TYPE_NONE;
+    if (!buffer->FindInt32(FRAME_TYPE, frameType)) {
+        // Buffers without a frame type are not encoded video, every one of them is self-contained
+        return true;
+    }
+    return frameType != DCAMERA_FANOUT_FRAME_TYPE_NONE;
+}
+
+bool DCameraChannelSinkFanout::IsCodecData(const std::shared_ptr<DataBuffer>& buffer)
+{
+    int32_t frameType = DCAMERA_FANOUT_FRAME_TYPE_NONE;
+    if (!buffer->FindInt32(FRAME_TYPE, frameType)) {
+        return false;
+    }
+    return (static_cast<uint32_t>(frameType) & DCAMERA_FANOUT_FRAME_TYPE_CODEC_DATA) != 0;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
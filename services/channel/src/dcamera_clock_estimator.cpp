@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_clock_estimator.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <vector>
+
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+// Points whose round trip is far above the best one carry up to half of it as error
+constexpr int64_t RTT_MARGIN_US = 500;
+}
+
+void DCameraClockEstimator::AddSample(int64_t t1, int64_t t2, int64_t t3, int64_t t4)
+{
+    int64_t rttUs = (t4 - t1) - (t3 - t2);
+    if (t4 < t1 || t3 < t2 || rttUs < 0 || rttUs > MAX_RTT_US) {
+        DHLOGD("drop clock sample, rtt %{public}" PRId64 " us", rttUs);
+        return;
+    }
+    ClockPoint point;
+    point.localUs = t1 + (t4 - t1) / 2;
+    point.offsetNs = ((t2 - t1) + (t3 - t4)) * NS_PER_US / 2;
+    point.rttUs = rttUs;
+
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    if (blockSampleNum_ == 0 || point.rttUs < blockBest_.rttUs) {
+        blockBest_ = point;
+    }
+    blockSampleNum_++;
+    // Until the first block is complete the best sample so far gives a quick first estimate
+    if (blockSampleNum_ < BLOCK_SAMPLE_NUM && !points_.empty()) {
+        return;
+    }
+    if (blockSampleNum_ >= BLOCK_SAMPLE_NUM) {
+        points_.push_back(blockBest_);
+        if (points_.size() > MAX_POINT_NUM) {
+            points_.pop_front();
+        }
+        blockSampleNum_ = 0;
+    }
+    ClockModel model;
+    if (points_.empty()) {
+        model.refUs = blockBest_.localUs;
+        model.offsetNs = blockBest_.offsetNs;
+        model.skewPpb = 0;
+    } else if (!FitModel(model)) {
+        return;
+    }
+    Publish(model);
+}
+
+bool DCameraClockEstimator::FitModel(ClockModel& model)
+{
+    int64_t minRttUs = points_.front().rttUs;
+    for (const auto& point : points_) {
+        minRttUs = std::min(minRttUs, point.rttUs);
+    }
+    minRttUs_.store(minRttUs, std::memory_order_relaxed);
+    int64_t maxRttUs = minRttUs * 2 + RTT_MARGIN_US;
+    std::vector<const ClockPoint *> used;
+    for (const auto& point : points_) {
+        if (point.rttUs <= maxRttUs) {
+            used.push_back(&point);
+        }
+    }
+    if (used.empty()) {
+        return false;
+    }
+    const ClockPoint& newest = *used.back();
+    model.refUs = newest.localUs;
+    model.offsetNs = newest.offsetNs;
+    model.skewPpb = 0;
+    if (used.size() < MIN_SKEW_POINT_NUM || newest.localUs - used.front()->localUs < MIN_SKEW_SPAN_US) {
+        return true;
+    }
+    // Least squares line through the points, x in us relative to the newest point, y in ns
+    double meanX = 0.0;
+    double meanY = 0.0;
+    for (const auto *point : used) {
+        meanX += static_cast<double>(point->localUs - model.refUs);
+        meanY += static_cast<double>(point->offsetNs);
+    }
+    meanX /= used.size();
+    meanY /= used.size();
+    double sxy = 0.0;
+    double sxx = 0.0;
+    for (const auto *point : used) {
+        double dx = static_cast<double>(point->localUs - model.refUs) - meanX;
+        sxy += dx * (static_cast<double>(point->offsetNs) - meanY);
+        sxx += dx * dx;
+    }
+    if (sxx <= 0.0) {
+        return true;
+    }
+    double slope = sxy / sxx;
+    // ns per us to parts per billion
+    double skewPpb = slope * (PPB_PER_UNIT / NS_PER_US);
+    skewPpb = std::max(std::min(skewPpb, static_cast<double>(MAX_SKEW_PPB)), -static_cast<double>(MAX_SKEW_PPB));
+    model.skewPpb = static_cast<int64_t>(std::llround(skewPpb));
+    model.offsetNs = static_cast<int64_t>(std::llround(meanY - slope * meanX));
+    return true;
+}
+
+void DCameraClockEstimator::Publish(const ClockModel& model)
+{
+    uint32_t version = version_.load(std::memory_order_relaxed);
+    version_.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    refUs_.store(model.refUs, std::memory_order_relaxed);
+    offsetNs_.store(model.offsetNs, std::memory_order_relaxed);
+    skewPpb_.store(model.skewPpb, std::memory_order_relaxed);
+    version_.store(version + 2, std::memory_order_release);
+    if (!isSynced_.exchange(true)) {
+        DHLOGI("clock synced, offset %{public}" PRId64 " ns", model.offsetNs);
+    }
+}
+
+bool DCameraClockEstimator::ReadModel(ClockModel& model) const
+{
+    if (!isSynced_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    uint32_t before = 0;
+    uint32_t after = 0;
+    do {
+        before = version_.load(std::memory_order_acquire);
+        model.refUs = refUs_.load(std::memory_order_relaxed);
+        model.offsetNs = offsetNs_.load(std::memory_order_relaxed);
+        model.skewPpb = skewPpb_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = version_.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+    return true;
+}
+
+void DCameraClockEstimator::SetCoarseOffsetUs(int64_t offsetUs)
+{
+    coarseOffsetUs_.store(offsetUs, std::memory_order_relaxed);
+}
+
+int64_t DCameraClockEstimator::GetOffsetUs(int64_t localUs) const
+{
+    ClockModel model;
+    if (!ReadModel(model)) {
+        return coarseOffsetUs_.load(std::memory_order_relaxed);
+    }
+    int64_t offsetNs = model.offsetNs + model.skewPpb * (localUs - model.refUs) / (PPB_PER_UNIT / NS_PER_US);
+    return (offsetNs >= 0) ? (offsetNs + NS_PER_US / 2) / NS_PER_US : (offsetNs - NS_PER_US / 2) / NS_PER_US;
+}
+
+bool DCameraClockEstimator::IsSynced() const
+{
+    return isSynced_.load(std::memory_order_acquire);
+}
+
+int64_t DCameraClockEstimator::GetSkewPpb() const
+{
+    ClockModel model;
+    return ReadModel(model) ? model.skewPpb : 0;
+}
+
+int64_t DCameraClockEstimator::GetMinRttUs() const
+{
+    return minRttUs_.load(std::memory_order_relaxed);
+}
+
+void DCameraClockEstimator::Reset()
+{
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    points_.clear();
+    blockSampleNum_ = 0;
+    isSynced_.store(false, std::memory_order_release);
+    minRttUs_.store(0, std::memory_order_relaxed);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -15,8 +15,11 @@
 
 #include "anonymous_string.h"
 #include "dcamera_hisysevent_adapter.h"
+#include "dcamera_channel_recorder.h"
 #include "dcamera_sink_frame_info.h"
 #include "dcamera_softbus_adapter.h"
+#include "dcamera_stream_fec.h"
+#include "dcamera_thread_policy.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -31,6 +34,8 @@
 #include "dcamera_protocol.h"
 #include "cJSON.h"
 #include "dcamera_utils_tools.h"
+#include <algorithm>
+#include <climits>
 #include <random>
 #include <sstream>
 #include <iomanip>
@@ -85,6 +90,7 @@ static void DCameraSourceOnShutDown(int32_t socket, ShutdownReason reason)
 
 static void DCameraSourceOnBytes(int32_t socket, const void *data, uint32_t dataLen)
 {
+    DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_SOFTBUS_CALLBACK);
     DCameraSoftbusAdapter::GetInstance().SourceOnBytes(socket, data, dataLen);
     return;
 }
@@ -98,6 +104,7 @@ static void DCameraSourceOnMessage(int32_t socket, const void *data, uint32_t da
 static void DCameraSourceOnStream(int32_t socket, const StreamData *data, const StreamData *ext,
     const StreamFrameInfo *param)
 {
+    DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_SOFTBUS_CALLBACK);
     DCameraSoftbusAdapter::GetInstance().SourceOnStream(socket, data, ext, param);
     return;
 }
@@ -117,6 +124,7 @@ static void DCameraSinkOnShutDown(int32_t socket, ShutdownReason reason)
 
 static void DCameraSinkOnBytes(int32_t socket, const void *data, uint32_t dataLen)
 {
+    DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_SOFTBUS_CALLBACK);
     DCameraSoftbusAdapter::GetInstance().SinkOnBytes(socket, data, dataLen);
     return;
 }
@@ -130,6 +138,7 @@ static void DCameraSinkOnMessage(int32_t socket, const void *data, uint32_t data
 static void DCameraSinkOnStream(int32_t socket, const StreamData *data, const StreamData *ext,
     const StreamFrameInfo *param)
 {
+    DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_SOFTBUS_CALLBACK);
     DCameraSoftbusAdapter::GetInstance().SinkOnStream(socket, data, ext, param);
     return;
 }
@@ -311,10 +320,31 @@ int32_t DCameraSoftbusAdapter::CloseSoftbusSession(int32_t socket)
         std::lock_guard<std::mutex> autoLock(sourceSocketLock_);
         sourceSocketSessionMap_.erase(socket);
     }
+    ResetStreamState(socket);
     DHLOGI("Shutdown softbus socket: %{public}d end", socket);
     return DCAMERA_OK;
 }
 
+int32_t DCameraSoftbusAdapter::GetNextStreamSeq(int32_t socket)
+{
+    std::lock_guard<std::mutex> autoLock(streamSeqLock_);
+    int32_t& seq = streamSeqMap_[socket];
+    int32_t curSeq = seq;
+    seq = (seq == INT32_MAX) ? 0 : seq + 1;
+    return curSeq;
+}
+
+void DCameraSoftbusAdapter::ResetStreamState(int32_t socket)
+{
+    {
+        std::lock_guard<std::mutex> autoLock(streamSeqLock_);
+        streamSeqMap_.erase(socket);
+    }
+    std::lock_guard<std::mutex> autoLock(streamFecLock_);
+    fecEncoderMap_.erase(socket);
+    fecDecoderMap_.erase(socket);
+}
+
 int32_t DCameraSoftbusAdapter::SendSofbusBytes(int32_t socket, std::shared_ptr<DataBuffer>& buffer)
 {
     CHECK_AND_RETURN_RET_LOG(buffer == nullptr, DCAMERA_BAD_VALUE, "Data buffer is null");
@@ -337,6 +367,16 @@ int32_t DCameraSoftbusAdapter::SendSofbusStream(int32_t socket, std::shared_ptr<
     if (!buffer->FindInt32(INDEX, index)) {
         DHLOGD("SendSofbusStream find %{public}s failed.", INDEX.c_str());
     }
+    int32_t layer = TEMPORAL_BASE_LAYER;
+    if (!buffer->FindInt32(TEMPORAL_LAYER, layer)) {
+        DHLOGD("SendSofbusStream find %{public}s failed.", TEMPORAL_LAYER.c_str());
+    }
+    int32_t width = 0;
+    int32_t height = 0;
+    if (!buffer->FindInt32(ENCODE_WIDTH, width) || !buffer->FindInt32(ENCODE_HEIGHT, height)) {
+        width = 0;
+        height = 0;
+    }
     int64_t startEncodeT;
     if (!buffer->FindInt64(START_ENCODE_TIME_US, startEncodeT)) {
         DHLOGD("SendSofbusStream find %{public}s failed.", START_ENCODE_TIME_US.c_str());
@@ -350,12 +390,31 @@ int32_t DCameraSoftbusAdapter::SendSofbusStream(int32_t socket, std::shared_ptr<
     sinkFrameInfo.pts_ = timeStamp;
     sinkFrameInfo.type_ = frameType;
     sinkFrameInfo.index_ = index;
+    sinkFrameInfo.seq_ = GetNextStreamSeq(socket);
+    sinkFrameInfo.layer_ = layer;
+    sinkFrameInfo.width_ = width;
+    sinkFrameInfo.height_ = height;
     sinkFrameInfo.startEncodeT_ = startEncodeT;
     sinkFrameInfo.finishEncodeT_ = finishEncodeT;
     sinkFrameInfo.sendT_ = GetNowTimeStampUs();
     sinkFrameInfo.rawTime_ = std::to_string(timeStamp);
-    sinkFrameInfo.Marshal(jsonStr);
     DHLOGI("send videoPts=%{public}s to softbus,frameType:%{public}d", sinkFrameInfo.rawTime_.c_str(), frameType);
+    int32_t ret = SendFecStream(socket, buffer, sinkFrameInfo);
+    if (ret == DCAMERA_NOT_FOUND) {
+        sinkFrameInfo.Marshal(jsonStr);
+        ret = SendStreamData(socket, streamData, jsonStr, frameType, index);
+    }
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+    DHLOGI("send videoPts=%{public}s success,frameType:%{public}d,seqNum:%{public}d",
+        sinkFrameInfo.rawTime_.c_str(), frameType, index);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraSoftbusAdapter::SendStreamData(int32_t socket, StreamData& streamData, const std::string& jsonStr,
+    int32_t frameType, int32_t index)
+{
     StreamData ext = { const_cast<char *>(jsonStr.c_str()), jsonStr.length() };
     StreamFrameInfo param = { 0 };
     param.frameType = (frameType == AVCODEC_BUFFER_FLAG_NONE) ? SOFTBUS_VIDEO_P_FRAME : SOFTBUS_VIDEO_I_FRAME;
@@ -365,11 +424,52 @@ int32_t DCameraSoftbusAdapter::SendSofbusStream(int32_t socket, std::shared_ptr<
         DHLOGD("SendSofbusStream failed, ret is %{public}d", ret);
         return DCAMERA_BAD_VALUE;
     }
-    DHLOGI("send videoPts=%{public}s success,frameType:%{public}d,seqNum:%{public}d",
-        sinkFrameInfo.rawTime_.c_str(), frameType, index);
     return DCAMERA_OK;
 }
 
+int32_t DCameraSoftbusAdapter::SendFecStream(int32_t socket, std::shared_ptr<DataBuffer>& buffer,
+    DCameraSinkFrameInfo& sinkFrameInfo)
+{
+    uint32_t dataNum = 0;
+    uint32_t parityNum = 0;
+    {
+        std::lock_guard<std::mutex> autoLock(streamFecLock_);
+        auto iter = fecEncoderMap_.find(socket);
+        if (iter == fecEncoderMap_.end() || !iter->second.GetScheme(buffer->Size(), dataNum, parityNum)) {
+            return DCAMERA_NOT_FOUND;
+        }
+    }
+    std::vector<std::vector<uint8_t>> parity;
+    int32_t ret = DCameraStreamFecEncoder::Encode(buffer->Data(), buffer->Size(), dataNum, parityNum, parity);
+    CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "encode fec parity failed, ret: %{public}d", ret);
+    size_t shardLen = DCameraStreamFecEncoder::GetShardLen(buffer->Size(), dataNum);
+    sinkFrameInfo.fecDataNum_ = static_cast<int32_t>(dataNum);
+    sinkFrameInfo.fecParityNum_ = static_cast<int32_t>(parityNum);
+    sinkFrameInfo.fecLen_ = static_cast<int32_t>(buffer->Size());
+    int32_t sentNum = 0;
+    for (uint32_t i = 0; i < dataNum + parityNum; i++) {
+        StreamData streamData = { nullptr, 0 };
+        if (i < dataNum) {
+            size_t offset = std::min(i * shardLen, buffer->Size());
+            streamData = { reinterpret_cast<char *>(buffer->Data() + offset),
+                static_cast<int>(std::min(shardLen, buffer->Size() - offset)) };
+        } else {
+            streamData = { reinterpret_cast<char *>(parity[i - dataNum].data()), static_cast<int>(shardLen) };
+        }
+        if (streamData.bufLen == 0) {
+            continue;
+        }
+        std::string jsonStr = "";
+        sinkFrameInfo.fecIndex_ = static_cast<int32_t>(i);
+        sinkFrameInfo.Marshal(jsonStr);
+        if (SendStreamData(socket, streamData, jsonStr, sinkFrameInfo.type_, sinkFrameInfo.index_) == DCAMERA_OK) {
+            sentNum++;
+        }
+    }
+    // A shard that did not go out is recovered like a lost one, the frame only fails without k shards
+    return (sentNum >= static_cast<int32_t>(dataNum)) ? DCAMERA_OK : DCAMERA_BAD_VALUE;
+}
+
 int32_t DCameraSoftbusAdapter::DCameraSoftbusSourceGetSession(int32_t socket,
     std::shared_ptr<DCameraSoftbusSession>& session)
 {
@@ -435,6 +535,10 @@ void DCameraSoftbusAdapter::SourceOnBytes(int32_t socket, const void *data, uint
         return;
     }
     DHLOGI("source callback send bytes start, socket: %{public}d", socket);
+    if (DCameraChannelRecorder::GetInstance().IsRecording()) {
+        DCameraChannelRecorder::GetInstance().Record(DCAMERA_RECORD_TYPE_BYTES, socket, GetNowTimeStampUs(), data,
+            dataLen, nullptr, 0);
+    }
     std::shared_ptr<DCameraSoftbusSession> session = nullptr;
     int32_t ret = DCameraSoftbusSourceGetSession(socket, session);
     if (ret != DCAMERA_OK || session == nullptr) {
@@ -474,6 +578,11 @@ void DCameraSoftbusAdapter::SourceOnStream(int32_t socket, const StreamData *dat
         DHLOGE("SourceOnStream Error, dataLen: %{public}d, socket: %{public}d", dataLen, socket);
         return;
     }
+    if (DCameraChannelRecorder::GetInstance().IsRecording()) {
+        bool hasExt = ext != nullptr && ext->buf != nullptr && ext->bufLen > 0;
+        DCameraChannelRecorder::GetInstance().Record(DCAMERA_RECORD_TYPE_STREAM, socket, recvT, data->buf,
+            static_cast<uint32_t>(dataLen), hasExt ? ext->buf : nullptr, hasExt ? ext->bufLen : 0);
+    }
     std::shared_ptr<DCameraSoftbusSession> session = nullptr;
     int32_t ret = DCameraSoftbusSourceGetSession(socket, session);
     if (ret != DCAMERA_OK || session == nullptr) {
@@ -492,7 +601,37 @@ void DCameraSoftbusAdapter::SourceOnStream(int32_t socket, const StreamData *dat
     if (ret != DCAMERA_OK) {
         DHLOGE("Handle source stream ext failed, ret is: %{public}d", ret);
     }
-    session->OnDataReceived(buffer);
+    std::shared_ptr<DataBuffer> frame = buffer;
+    if (ret == DCAMERA_OK && !DecodeFecStream(socket, buffer, frame)) {
+        return;
+    }
+    session->OnDataReceived(frame);
+}
+
+bool DCameraSoftbusAdapter::DecodeFecStream(int32_t socket, std::shared_ptr<DataBuffer>& buffer,
+    std::shared_ptr<DataBuffer>& frame)
+{
+    uint32_t lossPermille = 0;
+    bool hasReport = false;
+    bool hasFrame = false;
+    {
+        std::lock_guard<std::mutex> autoLock(streamFecLock_);
+        DCameraStreamFecDecoder& decoder = fecDecoderMap_[socket];
+        hasFrame = decoder.Feed(buffer, frame);
+        hasReport = decoder.PollLossReport(GetNowTimeStampUs(), lossPermille);
+    }
+    if (hasReport) {
+        // Back on the same stream socket, sinks without FEC support drop stream data from the source
+        std::string jsonStr = DCameraStreamFecDecoder::MarshalLossReport(lossPermille);
+        char reportData = 0;
+        StreamData streamData = { &reportData, sizeof(reportData) };
+        StreamData ext = { const_cast<char *>(jsonStr.c_str()), jsonStr.length() };
+        StreamFrameInfo param = { 0 };
+        int32_t ret = SendStream(socket, &streamData, &ext, &param);
+        DHLOGD("send stream loss %{public}u permille, socket: %{public}d, ret: %{public}d", lossPermille, socket,
+            ret);
+    }
+    return hasFrame;
 }
 
 int32_t DCameraSoftbusAdapter::HandleSourceStreamExt(std::shared_ptr<DataBuffer>& buffer, const StreamData *ext)
@@ -523,7 +662,15 @@ int32_t DCameraSoftbusAdapter::HandleSourceStreamExt(std::shared_ptr<DataBuffer>
     frameInfo.type = sinkFrameInfo.type_;
     frameInfo.pts = sinkFrameInfo.pts_;
     frameInfo.index = sinkFrameInfo.index_;
+    frameInfo.seq = sinkFrameInfo.seq_;
+    frameInfo.layer = sinkFrameInfo.layer_;
+    frameInfo.width = sinkFrameInfo.width_;
+    frameInfo.height = sinkFrameInfo.height_;
     frameInfo.ver = sinkFrameInfo.ver_;
+    frameInfo.fecIndex = sinkFrameInfo.fecIndex_;
+    frameInfo.fecDataNum = sinkFrameInfo.fecDataNum_;
+    frameInfo.fecParityNum = sinkFrameInfo.fecParityNum_;
+    frameInfo.fecLen = sinkFrameInfo.fecLen_;
     if (sinkFrameInfo.rawTime_.empty()) {
         frameInfo.rawTime = 0;
     } else {
@@ -786,6 +933,7 @@ void DCameraSoftbusAdapter::SinkOnShutDown(int32_t socket, ShutdownReason reason
         DHLOGE("sink on shutdown socket can not find socket %{public}d", socket);
         return;
     }
+    ResetStreamState(socket);
     {
         std::lock_guard<std::mutex> autoLock(trustSessionIdLock_);
         if (trustSessionId_.controlSessionId_ == socket) {
@@ -870,6 +1018,13 @@ void DCameraSoftbusAdapter::SinkOnStream(int32_t socket, const StreamData *data,
         DHLOGE("SinkOnStream error, dataLen: %{public}d socket: %{public}d", dataLen, socket);
         return;
     }
+    uint32_t lossPermille = 0;
+    if (ext != nullptr && ext->buf != nullptr && ext->bufLen > 0 && ext->bufLen <= DCAMERA_MAX_RECV_EXT_LEN &&
+        DCameraStreamFecDecoder::UnmarshalLossReport(std::string(ext->buf, ext->bufLen), lossPermille)) {
+        std::lock_guard<std::mutex> autoLock(streamFecLock_);
+        fecEncoderMap_[socket].UpdateLoss(lossPermille);
+        return;
+    }
     std::shared_ptr<DCameraSoftbusSession> session = nullptr;
     int32_t ret = DCameraSoftbusSinkGetSession(socket, session);
     if (ret != DCAMERA_OK || session == nullptr) {
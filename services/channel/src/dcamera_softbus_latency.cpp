@@ -20,6 +20,7 @@
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 #include "dcamera_softbus_adapter.h"
+#include "dcamera_utils_tools.h"
 #include "softbus_bus_center.h"
 #include "softbus_common.h"
 
@@ -63,8 +64,8 @@ int32_t DCameraSoftbusLatency::StartSoftbusTimeSync(const std::string& devId)
     {
         std::lock_guard<std::mutex> lock(micLock_);
         refCount_[devId]++;
-        offsets_.emplace(devId, 0);
     }
+    GetClockEstimator(devId)->Reset();
     DHLOGI("DCameraSoftbusLatency:: StartSoftbusTimeSync success ");
     return DCAMERA_OK;
 }
@@ -91,26 +92,38 @@ int32_t DCameraSoftbusLatency::StopSoftbusTimeSync(const std::string& devId)
     {
         std::lock_guard<std::mutex> lock(micLock_);
         refCount_[devId]--;
-        offsets_.erase(devId);
         refCount_.erase(devId);
     }
+    std::shared_ptr<DCameraClockEstimator> estimator = GetClockEstimator(devId);
+    estimator->Reset();
+    estimator->SetCoarseOffsetUs(0);
     return DCAMERA_OK;
 }
 
 void DCameraSoftbusLatency::SetTimeSyncInfo(const int32_t microsecond, const std::string& devId)
 {
-    std::lock_guard<std::mutex> lock(offsetLock_);
-    offsets_[devId] = microsecond;
+    GetClockEstimator(devId)->SetCoarseOffsetUs(microsecond);
 }
 
 int32_t DCameraSoftbusLatency::GetTimeSyncInfo(const std::string& devId)
+{
+    return static_cast<int32_t>(GetClockEstimator(devId)->GetOffsetUs(GetNowTimeStampUs()));
+}
+
+void DCameraSoftbusLatency::AddTimeSyncSample(const std::string& devId, int64_t t1, int64_t t2, int64_t t3,
+    int64_t t4)
+{
+    GetClockEstimator(devId)->AddSample(t1, t2, t3, t4);
+}
+
+std::shared_ptr<DCameraClockEstimator> DCameraSoftbusLatency::GetClockEstimator(const std::string& devId)
 {
     std::lock_guard<std::mutex> lock(offsetLock_);
-    auto dev = offsets_.find(devId);
-    if (dev == offsets_.end()) {
-        return DCAMERA_OK;
+    std::shared_ptr<DCameraClockEstimator>& estimator = estimators_[devId];
+    if (estimator == nullptr) {
+        estimator = std::make_shared<DCameraClockEstimator>();
     }
-    return offsets_[devId];
+    return estimator;
 }
 } // namespace DistributedHardware
 }
\ No newline at end of file
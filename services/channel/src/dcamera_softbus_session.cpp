@@ -15,10 +15,15 @@
 
 #include "dcamera_softbus_session.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <securec.h>
+#include <thread>
 
 #include "anonymous_string.h"
 #include "dcamera_softbus_adapter.h"
+#include "dcamera_thread_policy.h"
 #include "dcamera_utils_tools.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
@@ -45,8 +50,15 @@ DCameraSoftbusSession::DCameraSoftbusSession(std::string myDhId, std::string myD
     sendFuncMap_[DCAMERA_SESSION_MODE_CTRL] = &DCameraSoftbusSession::SendBytes;
     sendFuncMap_[DCAMERA_SESSION_MODE_VIDEO] = &DCameraSoftbusSession::SendStream;
     sendFuncMap_[DCAMERA_SESSION_MODE_JPEG] = &DCameraSoftbusSession::SendBytes;
+    if (mode_ == DCAMERA_SESSION_MODE_JPEG) {
+        packetMaxLen_ = JPEG_DATA_PACKET_MAX_LEN;
+        sendBytesPerSecond_ = JPEG_SEND_BYTES_PER_SECOND;
+    }
     auto runner = AppExecFwk::EventRunner::Create(mySessionName);
     eventHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    eventHandler_->PostTask([]() {
+        DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_SESSION_EVENT);
+    });
     ResetAssembleFrag();
 }
 
@@ -90,6 +102,9 @@ int32_t DCameraSoftbusSession::OnSessionOpened(int32_t socket, std::string netwo
     DHLOGI("open current session start, socket: %{public}d", socket);
     sessionId_ = socket;
     state_ = DCAMERA_SOFTBUS_STATE_OPENED;
+    if (eventHandler_ != nullptr) {
+        eventHandler_->PostTask([this]() { ResetReassembly(); });
+    }
     CHECK_AND_RETURN_RET_LOG(listener_ == nullptr, DCAMERA_BAD_VALUE, "listener_ is null.");
     if (isConflict_) {
         DHLOGI("OnSessionOpened session is in conflict state, not notify connected event, socket: %{public}d", socket);
@@ -163,8 +178,12 @@ void DCameraSoftbusSession::PackRecvData(std::shared_ptr<DataBuffer>& buffer)
     bufferSize = static_cast<uint64_t>(buffer->Size());
     DHLOGD("pack recv data Assemble, size: %{public}" PRIu64", dataLen: %{public}d, totalLen: %{public}d, nowTime: "
         "%{public}" PRId64" start", bufferSize, headerPara.dataLen, headerPara.totalLen, GetNowTimeStampUs());
-    if (headerPara.fragFlag == FRAG_START_END) {
+    if (headerPara.fragFlag == FRAG_NACK) {
+        HandleNack(buffer, headerPara);
+    } else if (headerPara.fragFlag == FRAG_START_END) {
         AssembleNoFrag(buffer, headerPara);
+    } else if (headerPara.version >= NACK_PROTOCOL_VERSION) {
+        AssembleSelectiveFrag(buffer, headerPara);
     } else {
         AssembleFrag(buffer, headerPara);
     }
@@ -288,6 +307,242 @@ void DCameraSoftbusSession::ResetAssembleFrag()
     packBuffer_ = nullptr;
 }
 
+void DCameraSoftbusSession::AssembleSelectiveFrag(std::shared_ptr<DataBuffer>& buffer, SessionDataHeader& headerPara)
+{
+    uint32_t seq = headerPara.seqNum;
+    auto iter = reassemblies_.find(seq);
+    if (iter == reassemblies_.end()) {
+        if (std::find(finishedSeqs_.begin(), finishedSeqs_.end(), seq) != finishedSeqs_.end()) {
+            DHLOGD("AssembleSelectiveFrag drop late fragment seq: %{public}u subSeq: %{public}u", seq,
+                headerPara.subSeq);
+            return;
+        }
+        if (reassemblies_.size() >= REASSEMBLY_MAX_NUM) {
+            DHLOGE("AssembleSelectiveFrag give up seq: %{public}u for seq: %{public}u, sess: %{public}s peerSess: "
+                "%{public}s", reassemblies_.begin()->first, seq, GetAnonyString(mySessionName_).c_str(),
+                GetAnonyString(peerSessionName_).c_str());
+            FinishReassembly(reassemblies_.begin()->first);
+        }
+        FragReassembly frag;
+        frag.buffer = std::make_shared<DataBuffer>(headerPara.totalLen);
+        frag.totalLen = headerPara.totalLen;
+        frag.startUs = GetNowTimeStampUs();
+        iter = reassemblies_.emplace(seq, std::move(frag)).first;
+        if (eventHandler_ != nullptr) {
+            eventHandler_->PostTask([this, seq]() { CheckReassembly(seq); }, "", NACK_INTERVAL_MS);
+        }
+    }
+    FragReassembly& frag = iter->second;
+    uint32_t lastMaxSubSeq = frag.maxSubSeq;
+    bool isFirst = (frag.recvNum == 0);
+    if (PlaceFrag(frag, buffer, headerPara) != DCAMERA_OK) {
+        FinishReassembly(seq);
+        return;
+    }
+    if (frag.fragNum != 0 && frag.recvNum == frag.fragNum) {
+        int64_t costUs = GetNowTimeStampUs() - frag.startUs;
+        DHLOGI("AssembleSelectiveFrag seq: %{public}u len: %{public}u frags: %{public}u nacks: %{public}u cost: "
+            "%{public}" PRId64 " us", seq, frag.totalLen, frag.fragNum, frag.nackNum, costUs);
+        std::shared_ptr<DataBuffer> postData = frag.buffer;
+        FinishReassembly(seq);
+        PostData(postData);
+        return;
+    }
+    // Fragments are sent in order, a jump means the ones in between were lost
+    uint32_t expectSubSeq = isFirst ? 0 : lastMaxSubSeq + 1;
+    if (headerPara.subSeq > expectSubSeq) {
+        std::vector<uint16_t> missing;
+        for (uint32_t subSeq = expectSubSeq; subSeq < headerPara.subSeq && missing.size() < NACK_MAX_SUBSEQ_NUM;
+            subSeq++) {
+            if (!frag.received[subSeq]) {
+                missing.push_back(static_cast<uint16_t>(subSeq));
+            }
+        }
+        frag.nackNum++;
+        SendNack(seq, missing);
+    }
+}
+
+int32_t DCameraSoftbusSession::PlaceFrag(FragReassembly& frag, std::shared_ptr<DataBuffer>& buffer,
+    SessionDataHeader& headerPara)
+{
+    if (headerPara.totalLen != frag.totalLen || headerPara.dataLen == 0) {
+        DHLOGE("PlaceFrag len error totalLen: %{public}u expect: %{public}u dataLen: %{public}u", headerPara.totalLen,
+            frag.totalLen, headerPara.dataLen);
+        return DCAMERA_BAD_VALUE;
+    }
+    uint64_t offset = 0;
+    uint32_t fragNum = frag.fragNum;
+    if (headerPara.fragFlag == FRAG_END) {
+        offset = frag.totalLen - headerPara.dataLen;
+        fragNum = static_cast<uint32_t>(headerPara.subSeq) + 1;
+    } else {
+        if (frag.fragLen == 0) {
+            frag.fragLen = headerPara.dataLen;
+            fragNum = GetFragNum(frag.totalLen, frag.fragLen);
+        }
+        offset = static_cast<uint64_t>(headerPara.subSeq) * frag.fragLen;
+    }
+    // Every fragment except the last one carries the same length
+    bool isValid = (headerPara.fragFlag == FRAG_END || headerPara.dataLen == frag.fragLen) &&
+        (offset + headerPara.dataLen <= frag.totalLen) && (headerPara.subSeq < fragNum) &&
+        (frag.fragNum == 0 || frag.fragNum == fragNum);
+    if (!isValid) {
+        DHLOGE("PlaceFrag frag error subSeq: %{public}u dataLen: %{public}u fragLen: %{public}u fragNum: %{public}u",
+            headerPara.subSeq, headerPara.dataLen, frag.fragLen, frag.fragNum);
+        return DCAMERA_BAD_VALUE;
+    }
+    if (frag.received.size() <= headerPara.subSeq) {
+        frag.received.resize(headerPara.subSeq + 1, false);
+    }
+    frag.lastRecvUs = GetNowTimeStampUs();
+    if (frag.received[headerPara.subSeq]) {
+        return DCAMERA_OK;
+    }
+    int32_t ret = memcpy_s(frag.buffer->Data() + offset, frag.buffer->Size() - offset,
+        buffer->Data() + BINARY_HEADER_FRAG_LEN, headerPara.dataLen);
+    if (ret != EOK) {
+        DHLOGE("PlaceFrag memcpy_s failed, ret: %{public}d", ret);
+        return DCAMERA_BAD_VALUE;
+    }
+    frag.fragNum = fragNum;
+    frag.received[headerPara.subSeq] = true;
+    frag.recvNum++;
+    frag.maxSubSeq = std::max(frag.maxSubSeq, static_cast<uint32_t>(headerPara.subSeq));
+    return DCAMERA_OK;
+}
+
+uint32_t DCameraSoftbusSession::GetFragNum(uint32_t totalLen, uint32_t fragLen)
+{
+    // The last fragment may carry up to the reserved bytes more than the others, see SetHeadParaDataLen
+    uint64_t maxLastLen = static_cast<uint64_t>(fragLen) + BINARY_DATA_PACKET_RESERVED_BUFFER;
+    if (totalLen <= maxLastLen) {
+        return 1;
+    }
+    return static_cast<uint32_t>((totalLen - maxLastLen + fragLen - 1) / fragLen + 1);
+}
+
+void DCameraSoftbusSession::CheckReassembly(uint32_t seq)
+{
+    auto iter = reassemblies_.find(seq);
+    if (iter == reassemblies_.end()) {
+        return;
+    }
+    FragReassembly& frag = iter->second;
+    int64_t nowUs = GetNowTimeStampUs();
+    if (nowUs - frag.lastRecvUs >= REASSEMBLY_TIMEOUT_US) {
+        DHLOGE("CheckReassembly give up seq: %{public}u, received %{public}u of %{public}u, nacks: %{public}u, "
+            "sess: %{public}s peerSess: %{public}s", seq, frag.recvNum, frag.fragNum, frag.nackNum,
+            GetAnonyString(mySessionName_).c_str(), GetAnonyString(peerSessionName_).c_str());
+        FinishReassembly(seq);
+        return;
+    }
+    // The tail is only asked for once the sender has gone quiet
+    bool withTail = (nowUs - frag.lastRecvUs >= NACK_INTERVAL_MS * US_PER_MS);
+    std::vector<uint16_t> missing;
+    GetMissingSubSeqs(frag, withTail, missing);
+    if (!missing.empty()) {
+        frag.nackNum++;
+        SendNack(seq, missing);
+    }
+    if (eventHandler_ != nullptr) {
+        eventHandler_->PostTask([this, seq]() { CheckReassembly(seq); }, "", NACK_INTERVAL_MS);
+    }
+}
+
+void DCameraSoftbusSession::GetMissingSubSeqs(const FragReassembly& frag, bool withTail,
+    std::vector<uint16_t>& missing)
+{
+    uint32_t endSubSeq = withTail ? frag.fragNum : frag.maxSubSeq;
+    for (uint32_t subSeq = 0; subSeq < endSubSeq && missing.size() < NACK_MAX_SUBSEQ_NUM; subSeq++) {
+        if (subSeq >= frag.received.size() || !frag.received[subSeq]) {
+            missing.push_back(static_cast<uint16_t>(subSeq));
+        }
+    }
+}
+
+int32_t DCameraSoftbusSession::SendNack(uint32_t seq, const std::vector<uint16_t>& subSeqs)
+{
+    if (subSeqs.empty()) {
+        return DCAMERA_OK;
+    }
+    uint32_t dataLen = static_cast<uint32_t>(subSeqs.size()) * NACK_SUBSEQ_LEN;
+    SessionDataHeader headPara = { PROTOCOL_VERSION, FRAG_NACK, mode_, seq, dataLen, 0, dataLen };
+    std::shared_ptr<DataBuffer> nackData = std::make_shared<DataBuffer>(dataLen + BINARY_HEADER_FRAG_LEN);
+    MakeFragDataHeader(headPara, nackData->Data(), BINARY_HEADER_FRAG_LEN);
+    uint8_t *ptr = nackData->Data() + BINARY_HEADER_FRAG_LEN;
+    for (uint16_t subSeq : subSeqs) {
+        *ptr++ = subSeq >> DCAMERA_SHIFT_8;
+        *ptr++ = subSeq & UINT16_SHIFT_MASK_0;
+    }
+    DHLOGI("SendNack seq: %{public}u missing: %{public}zu first: %{public}u", seq, subSeqs.size(), subSeqs[0]);
+    return SendBytes(nackData);
+}
+
+void DCameraSoftbusSession::HandleNack(std::shared_ptr<DataBuffer>& buffer, SessionDataHeader& headerPara)
+{
+    if (headerPara.dataLen % NACK_SUBSEQ_LEN != 0) {
+        DHLOGE("HandleNack invalid dataLen: %{public}u", headerPara.dataLen);
+        return;
+    }
+    uint8_t *ptr = buffer->Data() + BINARY_HEADER_FRAG_LEN;
+    uint32_t subSeqNum = headerPara.dataLen / NACK_SUBSEQ_LEN;
+    std::shared_ptr<DataBuffer> fragData = nullptr;
+    uint32_t sentNum = 0;
+    for (uint32_t i = 0; i < subSeqNum; i++) {
+        uint16_t subSeq = U16Get(ptr + i * NACK_SUBSEQ_LEN);
+        if (RetransmitFrag(headerPara.seqNum, subSeq, fragData) != DCAMERA_OK || SendBytes(fragData) != DCAMERA_OK) {
+            break;
+        }
+        sentNum++;
+    }
+    DHLOGI("HandleNack seq: %{public}u retransmit %{public}u of %{public}u fragments", headerPara.seqNum, sentNum,
+        subSeqNum);
+}
+
+int32_t DCameraSoftbusSession::RetransmitFrag(uint32_t seq, uint16_t subSeq, std::shared_ptr<DataBuffer>& fragData)
+{
+    std::lock_guard<std::mutex> autoLock(retransmitMutex_);
+    auto iter = retransmitCache_.find(seq);
+    if (iter == retransmitCache_.end()) {
+        DHLOGE("RetransmitFrag seq: %{public}u is no longer cached, sess: %{public}s peerSess: %{public}s", seq,
+            GetAnonyString(mySessionName_).c_str(), GetAnonyString(peerSessionName_).c_str());
+        return DCAMERA_NOT_FOUND;
+    }
+    const RetransmitEntry& entry = iter->second;
+    uint32_t totalLen = static_cast<uint32_t>(entry.payload->Size());
+    uint64_t offset = static_cast<uint64_t>(subSeq) * entry.fragLen;
+    if (offset >= totalLen) {
+        DHLOGE("RetransmitFrag seq: %{public}u subSeq: %{public}u out of range", seq, subSeq);
+        return DCAMERA_BAD_VALUE;
+    }
+    SessionDataHeader headPara = { PROTOCOL_VERSION, FRAG_MID, mode_, seq, totalLen, subSeq };
+    SetHeadParaDataLen(headPara, totalLen, static_cast<uint32_t>(offset));
+    if (headPara.fragFlag != FRAG_END) {
+        headPara.dataLen = entry.fragLen;
+        headPara.fragFlag = (subSeq == 0) ? FRAG_START : FRAG_MID;
+    }
+    if (fragData == nullptr) {
+        fragData = std::make_shared<DataBuffer>(packetMaxLen_ + BINARY_HEADER_FRAG_LEN);
+    }
+    return PackFragData(entry.payload, headPara, static_cast<uint32_t>(offset), fragData);
+}
+
+void DCameraSoftbusSession::FinishReassembly(uint32_t seq)
+{
+    reassemblies_.erase(seq);
+    finishedSeqs_.push_back(seq);
+    if (finishedSeqs_.size() > FINISHED_SEQ_NUM) {
+        finishedSeqs_.pop_front();
+    }
+}
+
+void DCameraSoftbusSession::ResetReassembly()
+{
+    reassemblies_.clear();
+    finishedSeqs_.clear();
+}
+
 void DCameraSoftbusSession::PostData(std::shared_ptr<DataBuffer>& buffer)
 {
     std::vector<std::shared_ptr<DataBuffer>> buffers;
@@ -369,10 +624,10 @@ int32_t DCameraSoftbusSession::UnPackSendData(std::shared_ptr<DataBuffer>& buffe
 {
     CHECK_AND_RETURN_RET_LOG(buffer == nullptr, DCAMERA_BAD_VALUE, "Data buffer is null");
     uint16_t subSeq = 0;
-    uint32_t seq = 0;
+    uint32_t seq = sendSeq_++;
     uint32_t totalLen = buffer->Size();
     SessionDataHeader headPara = { PROTOCOL_VERSION, FRAG_START, mode_, seq, totalLen, subSeq };
-    if (buffer->Size() <= BINARY_DATA_PACKET_MAX_LEN) {
+    if (buffer->Size() <= packetMaxLen_) {
         headPara.fragFlag = FRAG_START_END;
         headPara.dataLen = buffer->Size();
         std::shared_ptr<DataBuffer> unpackData = std::make_shared<DataBuffer>(buffer->Size() + BINARY_HEADER_FRAG_LEN);
@@ -387,42 +642,153 @@ int32_t DCameraSoftbusSession::UnPackSendData(std::shared_ptr<DataBuffer>& buffe
         return SendBytes(unpackData);
     }
     uint32_t offset = 0;
+    // Only the first fragment is copied here, the rest go out as slices lent from the payload itself
+    std::shared_ptr<DataBuffer> unpackData = std::make_shared<DataBuffer>(packetMaxLen_ + BINARY_HEADER_FRAG_LEN);
+    int64_t startUs = GetNowTimeStampUs();
+    CacheSendData(seq, buffer, packetMaxLen_ - BINARY_DATA_PACKET_RESERVED_BUFFER);
+    int32_t ret = DCAMERA_OK;
     while (totalLen > offset) {
         SetHeadParaDataLen(headPara, totalLen, offset);
         uint64_t bufferSize = static_cast<uint64_t>(buffer->Size());
         DHLOGD("DCameraSoftbusSession UnPackSendData, size: %" PRIu64", dataLen: %{public}d, totalLen: %{public}d, "
             "nowTime: %{public}" PRId64" start:", bufferSize, headPara.dataLen, headPara.totalLen, GetNowTimeStampUs());
-        std::shared_ptr<DataBuffer> unpackData =
-            std::make_shared<DataBuffer>(headPara.dataLen + BINARY_HEADER_FRAG_LEN);
-        MakeFragDataHeader(headPara, unpackData->Data(), BINARY_HEADER_FRAG_LEN);
-        int ret = memcpy_s(unpackData->Data() + BINARY_HEADER_FRAG_LEN, unpackData->Size() - BINARY_HEADER_FRAG_LEN,
-            buffer->Data() + offset, headPara.dataLen);
-        if (ret != EOK) {
-            DHLOGE("DCameraSoftbusSession UnPackSendData memcpy_s failed, ret: %{public}d, sess: %{public}s peerSess: "
-                "%{public}s", ret, GetAnonyString(mySessionName_).c_str(), GetAnonyString(peerSessionName_).c_str());
-            return ret;
-        }
-        ret = SendBytes(unpackData);
+        ret = SendFragData(buffer, headPara, offset, unpackData);
         if (ret != DCAMERA_OK) {
             DHLOGE("DCameraSoftbusSession sendData failed, ret: %{public}d, sess: %{public}s peerSess: %{public}s",
                 ret, GetAnonyString(mySessionName_).c_str(), GetAnonyString(peerSessionName_).c_str());
-            return ret;
+            break;
         }
         DHLOGD("DCameraSoftbusSession UnPackSendData, size: %" PRIu64", dataLen: %{public}d, totalLen: %{public}d, "
             "nowTime: %{public}" PRId64" end:", bufferSize, headPara.dataLen, headPara.totalLen, GetNowTimeStampUs());
         headPara.subSeq++;
         headPara.fragFlag = FRAG_MID;
         offset += headPara.dataLen;
+        if (totalLen > offset) {
+            PaceSendData(startUs, offset);
+        }
+    }
+    DHLOGI("DCameraSoftbusSession UnPackSendData seq: %{public}u, %{public}u bytes in %{public}u fragments took "
+        "%{public}" PRId64" us", seq, totalLen, headPara.subSeq, GetNowTimeStampUs() - startUs);
+    // The retransmit window starts once the last fragment is out
+    {
+        std::lock_guard<std::mutex> autoLock(retransmitMutex_);
+        auto iter = retransmitCache_.find(seq);
+        if (iter != retransmitCache_.end()) {
+            iter->second.sendUs = GetNowTimeStampUs();
+        }
+    }
+    // Borrowed photo buffers go back to the surface only once the cache lets them go
+    if (eventHandler_ != nullptr) {
+        eventHandler_->PostTask([this]() { ReleaseSendCache(GetNowTimeStampUs()); }, "",
+            RETRANSMIT_CACHE_HOLD_US / US_PER_MS);
+    }
+    return ret;
+}
+
+int32_t DCameraSoftbusSession::PackFragData(const std::shared_ptr<DataBuffer>& payload,
+    const SessionDataHeader& headPara, uint32_t offset, std::shared_ptr<DataBuffer>& fragData)
+{
+    if (fragData->SetRange(0, headPara.dataLen + BINARY_HEADER_FRAG_LEN) != DCAMERA_OK) {
+        DHLOGE("DCameraSoftbusSession PackFragData invalid dataLen: %{public}d", headPara.dataLen);
+        return DCAMERA_BAD_VALUE;
+    }
+    MakeFragDataHeader(headPara, fragData->Data(), BINARY_HEADER_FRAG_LEN);
+    int32_t ret = memcpy_s(fragData->Data() + BINARY_HEADER_FRAG_LEN, fragData->Size() - BINARY_HEADER_FRAG_LEN,
+        payload->Data() + offset, headPara.dataLen);
+    if (ret != EOK) {
+        DHLOGE("DCameraSoftbusSession PackFragData memcpy_s failed, ret: %{public}d, sess: %{public}s peerSess: "
+            "%{public}s", ret, GetAnonyString(mySessionName_).c_str(), GetAnonyString(peerSessionName_).c_str());
+        return ret;
     }
     return DCAMERA_OK;
 }
 
+int32_t DCameraSoftbusSession::LendFragData(const std::shared_ptr<DataBuffer>& payload,
+    const SessionDataHeader& headPara, uint32_t offset, std::shared_ptr<DataBuffer>& fragData)
+{
+    if (offset < BINARY_HEADER_FRAG_LEN || static_cast<uint64_t>(offset) + headPara.dataLen > payload->Size()) {
+        DHLOGE("DCameraSoftbusSession LendFragData invalid offset: %{public}u, dataLen: %{public}u", offset,
+            headPara.dataLen);
+        return DCAMERA_BAD_VALUE;
+    }
+    // The header goes over the tail of the previous fragment, which is put back once the slice is released.
+    // This needs the payload to be writable, which holds for the CPU mapped photo surface buffers.
+    uint8_t *header = payload->Data() + offset - BINARY_HEADER_FRAG_LEN;
+    auto saved = std::make_shared<std::array<uint8_t, BINARY_HEADER_FRAG_LEN>>();
+    std::copy(header, header + BINARY_HEADER_FRAG_LEN, saved->begin());
+    MakeFragDataHeader(headPara, header, BINARY_HEADER_FRAG_LEN);
+    fragData = std::make_shared<DataBuffer>(header, headPara.dataLen + BINARY_HEADER_FRAG_LEN,
+        [header, saved]() { std::copy(saved->begin(), saved->end(), header); });
+    return DCAMERA_OK;
+}
+
+int32_t DCameraSoftbusSession::SendFragData(const std::shared_ptr<DataBuffer>& payload,
+    const SessionDataHeader& headPara, uint32_t offset, std::shared_ptr<DataBuffer>& scratch)
+{
+    if (offset < BINARY_HEADER_FRAG_LEN) {
+        int32_t ret = PackFragData(payload, headPara, offset, scratch);
+        if (ret != DCAMERA_OK) {
+            return ret;
+        }
+        return SendBytes(scratch);
+    }
+    // RetransmitFrag copies out of the same payload under this lock, so it never sees a lent header
+    std::lock_guard<std::mutex> autoLock(retransmitMutex_);
+    std::shared_ptr<DataBuffer> fragData = nullptr;
+    int32_t ret = LendFragData(payload, headPara, offset, fragData);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+    ret = SendBytes(fragData);
+    fragData = nullptr;
+    return ret;
+}
+
+void DCameraSoftbusSession::CacheSendData(uint32_t seq, const std::shared_ptr<DataBuffer>& payload,
+    uint32_t fragLen)
+{
+    int64_t nowUs = GetNowTimeStampUs();
+    ReleaseSendCache(nowUs);
+    {
+        std::lock_guard<std::mutex> autoLock(retransmitMutex_);
+        if (retransmitCache_.size() >= RETRANSMIT_CACHE_NUM) {
+            retransmitCache_.erase(retransmitCache_.begin());
+        }
+        // sendUs stays 0 while the payload is still being sent
+        retransmitCache_[seq] = { payload, fragLen, 0 };
+    }
+}
+
+void DCameraSoftbusSession::ReleaseSendCache(int64_t nowUs)
+{
+    std::lock_guard<std::mutex> autoLock(retransmitMutex_);
+    for (auto iter = retransmitCache_.begin(); iter != retransmitCache_.end();) {
+        if (iter->second.sendUs != 0 && nowUs - iter->second.sendUs >= RETRANSMIT_CACHE_HOLD_US) {
+            iter = retransmitCache_.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+}
+
+void DCameraSoftbusSession::PaceSendData(int64_t startUs, uint64_t sentBytes)
+{
+    if (sendBytesPerSecond_ == 0) {
+        return;
+    }
+    int64_t targetUs = startUs + static_cast<int64_t>(sentBytes * US_PER_SECOND / sendBytesPerSecond_);
+    int64_t waitUs = targetUs - GetNowTimeStampUs();
+    if (waitUs > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+    }
+}
+
 void DCameraSoftbusSession::SetHeadParaDataLen(SessionDataHeader& headPara, const uint32_t totalLen,
     const uint32_t offset)
 {
     if (totalLen >= offset) {
-        if (totalLen - offset > BINARY_DATA_PACKET_MAX_LEN) {
-            headPara.dataLen = BINARY_DATA_PACKET_MAX_LEN - BINARY_DATA_PACKET_RESERVED_BUFFER;
+        if (totalLen - offset > packetMaxLen_) {
+            headPara.dataLen = packetMaxLen_ - BINARY_DATA_PACKET_RESERVED_BUFFER;
         } else {
             headPara.fragFlag = FRAG_END;
             headPara.dataLen = totalLen - offset;
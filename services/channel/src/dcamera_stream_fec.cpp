@@ -0,0 +1,460 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_stream_fec.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "cJSON.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+constexpr uint32_t GF_SIZE = 256;
+constexpr uint32_t GF_ORDER = 255;
+// x^8 + x^4 + x^3 + x^2 + 1, the usual Reed-Solomon polynomial, 2 is a generator
+constexpr uint32_t GF_POLYNOMIAL = 0x11d;
+const std::string FEC_LOSS_KEY = "fecLoss";
+
+struct GaloisTables {
+    uint8_t exp[GF_ORDER * 2];
+    uint8_t log[GF_SIZE];
+
+    GaloisTables()
+    {
+        uint32_t value = 1;
+        for (uint32_t i = 0; i < GF_ORDER; i++) {
+            exp[i] = static_cast<uint8_t>(value);
+            exp[i + GF_ORDER] = static_cast<uint8_t>(value);
+            log[value] = static_cast<uint8_t>(i);
+            value <<= 1;
+            if (value >= GF_SIZE) {
+                value ^= GF_POLYNOMIAL;
+            }
+        }
+        log[0] = 0;
+    }
+};
+
+const GaloisTables& GetTables()
+{
+    static const GaloisTables tables;
+    return tables;
+}
+
+uint8_t GfMul(uint8_t a, uint8_t b)
+{
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+    const GaloisTables& tables = GetTables();
+    return tables.exp[tables.log[a] + tables.log[b]];
+}
+
+uint8_t GfInv(uint8_t a)
+{
+    const GaloisTables& tables = GetTables();
+    return tables.exp[GF_ORDER - tables.log[a]];
+}
+
+// dst ^= coef * src
+void GfMulAdd(uint8_t *dst, const uint8_t *src, uint8_t coef, size_t len)
+{
+    if (coef == 0) {
+        return;
+    }
+    if (coef == 1) {
+        for (size_t i = 0; i < len; i++) {
+            dst[i] ^= src[i];
+        }
+        return;
+    }
+    const GaloisTables& tables = GetTables();
+    uint32_t logCoef = tables.log[coef];
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] != 0) {
+            dst[i] ^= tables.exp[tables.log[src[i]] + logCoef];
+        }
+    }
+}
+}
+
+uint8_t DCameraFecCodec::GetCoefficient(uint32_t parityIdx, uint32_t dataIdx, uint32_t parityNum)
+{
+    if (parityNum == 1) {
+        return 1;
+    }
+    // Cauchy matrix 1 / (x_i + y_j) with x_i = i and y_j = m + j, every square sub-matrix is invertible
+    return GfInv(static_cast<uint8_t>(parityIdx ^ (parityNum + dataIdx)));
+}
+
+int32_t DCameraFecCodec::Encode(const std::vector<const uint8_t *>& data, size_t shardLen,
+    std::vector<std::vector<uint8_t>>& parity)
+{
+    uint32_t dataNum = static_cast<uint32_t>(data.size());
+    uint32_t parityNum = static_cast<uint32_t>(parity.size());
+    CHECK_AND_RETURN_RET_LOG(dataNum == 0 || parityNum == 0 || dataNum + parityNum > MAX_SHARD_NUM,
+        DCAMERA_BAD_VALUE, "invalid fec shard num %{public}u + %{public}u", dataNum, parityNum);
+    for (uint32_t i = 0; i < parityNum; i++) {
+        parity[i].assign(shardLen, 0);
+        for (uint32_t j = 0; j < dataNum; j++) {
+            GfMulAdd(parity[i].data(), data[j], GetCoefficient(i, j, parityNum), shardLen);
+        }
+    }
+    return DCAMERA_OK;
+}
+
+int32_t DCameraFecCodec::Invert(std::vector<uint8_t>& matrix, uint32_t size)
+{
+    std::vector<uint8_t> inverse(size * size, 0);
+    for (uint32_t i = 0; i < size; i++) {
+        inverse[i * size + i] = 1;
+    }
+    for (uint32_t col = 0; col < size; col++) {
+        uint32_t pivot = col;
+        while (pivot < size && matrix[pivot * size + col] == 0) {
+            pivot++;
+        }
+        CHECK_AND_RETURN_RET_LOG(pivot == size, DCAMERA_BAD_VALUE, "fec matrix is singular");
+        if (pivot != col) {
+            std::swap_ranges(matrix.begin() + pivot * size, matrix.begin() + (pivot + 1) * size,
+                matrix.begin() + col * size);
+            std::swap_ranges(inverse.begin() + pivot * size, inverse.begin() + (pivot + 1) * size,
+                inverse.begin() + col * size);
+        }
+        uint8_t scale = GfInv(matrix[col * size + col]);
+        for (uint32_t j = 0; j < size; j++) {
+            matrix[col * size + j] = GfMul(matrix[col * size + j], scale);
+            inverse[col * size + j] = GfMul(inverse[col * size + j], scale);
+        }
+        for (uint32_t row = 0; row < size; row++) {
+            uint8_t factor = matrix[row * size + col];
+            if (row == col || factor == 0) {
+                continue;
+            }
+            GfMulAdd(&matrix[row * size], &matrix[col * size], factor, size);
+            GfMulAdd(&inverse[row * size], &inverse[col * size], factor, size);
+        }
+    }
+    matrix.swap(inverse);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraFecCodec::Reconstruct(std::vector<std::vector<uint8_t>>& shards, const std::vector<bool>& present,
+    uint32_t dataNum, size_t shardLen)
+{
+    uint32_t totalNum = static_cast<uint32_t>(shards.size());
+    CHECK_AND_RETURN_RET_LOG(dataNum == 0 || dataNum >= totalNum || totalNum > MAX_SHARD_NUM ||
+        present.size() != totalNum, DCAMERA_BAD_VALUE, "invalid fec shard num %{public}u of %{public}u",
+        dataNum, totalNum);
+    uint32_t parityNum = totalNum - dataNum;
+    // Prefer the data shards, their rows of the generator matrix are unit rows
+    std::vector<uint32_t> rows;
+    for (uint32_t i = 0; i < totalNum && rows.size() < dataNum; i++) {
+        if (present[i]) {
+            rows.push_back(i);
+        }
+    }
+    CHECK_AND_RETURN_RET_LOG(rows.size() < dataNum, DCAMERA_BAD_VALUE, "not enough fec shards %{public}zu",
+        rows.size());
+    if (rows.back() < dataNum) {
+        return DCAMERA_OK;
+    }
+    std::vector<uint8_t> matrix(dataNum * dataNum, 0);
+    for (uint32_t r = 0; r < dataNum; r++) {
+        if (rows[r] < dataNum) {
+            matrix[r * dataNum + rows[r]] = 1;
+            continue;
+        }
+        for (uint32_t j = 0; j < dataNum; j++) {
+            matrix[r * dataNum + j] = GetCoefficient(rows[r] - dataNum, j, parityNum);
+        }
+    }
+    int32_t ret = Invert(matrix, dataNum);
+    CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "invert fec matrix failed");
+    for (uint32_t j = 0; j < dataNum; j++) {
+        if (present[j]) {
+            continue;
+        }
+        std::vector<uint8_t> shard(shardLen, 0);
+        for (uint32_t r = 0; r < dataNum; r++) {
+            GfMulAdd(shard.data(), shards[rows[r]].data(), matrix[j * dataNum + r], shardLen);
+        }
+        shards[j].swap(shard);
+    }
+    return DCAMERA_OK;
+}
+
+void DCameraStreamFecEncoder::UpdateLoss(uint32_t lossPermille)
+{
+    // Follow a loss burst at once, but back off over a few reports so a short calm does not drop the parity
+    uint32_t decayed = lossPermille_ - lossPermille_ / 4;
+    uint32_t newLoss = std::max(std::min(lossPermille, PERMILLE), decayed);
+    if ((newLoss >= FEC_ENABLE_PERMILLE) != (lossPermille_ >= FEC_ENABLE_PERMILLE)) {
+        DHLOGI("stream fec %{public}s, loss %{public}u permille", (newLoss >= FEC_ENABLE_PERMILLE) ? "on" : "off",
+            newLoss);
+    }
+    lossPermille_ = newLoss;
+}
+
+bool DCameraStreamFecEncoder::GetScheme(size_t frameLen, uint32_t& dataNum, uint32_t& parityNum)
+{
+    if (lossPermille_ < FEC_ENABLE_PERMILLE || frameLen == 0) {
+        return false;
+    }
+    dataNum = static_cast<uint32_t>(std::min(std::max(frameLen / MIN_SHARD_LEN, static_cast<size_t>(1)),
+        static_cast<size_t>(MAX_DATA_SHARD_NUM)));
+    uint32_t redundancy = std::min(std::max(lossPermille_ * REDUNDANCY_PER_LOSS, MIN_REDUNDANCY_PERMILLE),
+        MAX_REDUNDANCY_PERMILLE);
+    parityNum = std::max((dataNum * redundancy + PERMILLE - 1) / PERMILLE, 1u);
+    return true;
+}
+
+size_t DCameraStreamFecEncoder::GetShardLen(size_t frameLen, uint32_t dataNum)
+{
+    return (dataNum == 0) ? 0 : (frameLen + dataNum - 1) / dataNum;
+}
+
+int32_t DCameraStreamFecEncoder::Encode(const uint8_t *frame, size_t frameLen, uint32_t dataNum,
+    uint32_t parityNum, std::vector<std::vector<uint8_t>>& parity)
+{
+    CHECK_AND_RETURN_RET_LOG(frame == nullptr || frameLen == 0 || dataNum == 0, DCAMERA_BAD_VALUE,
+        "invalid fec frame");
+    size_t shardLen = GetShardLen(frameLen, dataNum);
+    // Only the last data shard can be short, it is zero padded to the shard length
+    std::vector<uint8_t> lastShard(shardLen, 0);
+    std::vector<const uint8_t *> data;
+    for (uint32_t i = 0; i < dataNum; i++) {
+        size_t offset = i * shardLen;
+        if (offset + shardLen <= frameLen) {
+            data.push_back(frame + offset);
+            continue;
+        }
+        if (offset < frameLen) {
+            int32_t ret = memcpy_s(lastShard.data(), lastShard.size(), frame + offset, frameLen - offset);
+            CHECK_AND_RETURN_RET_LOG(ret != EOK, DCAMERA_MEMORY_OPT_ERROR, "copy fec shard failed %{public}d", ret);
+        }
+        data.push_back(lastShard.data());
+    }
+    parity.resize(parityNum);
+    return DCameraFecCodec::Encode(data, shardLen, parity);
+}
+
+bool DCameraStreamFecDecoder::Feed(const std::shared_ptr<DataBuffer>& buffer, std::shared_ptr<DataBuffer>& frame)
+{
+    if (buffer == nullptr) {
+        return false;
+    }
+    const DCameraFrameInfo& info = buffer->frameInfo_;
+    if (info.fecParityNum > 0) {
+        return AddShard(buffer, frame);
+    }
+    if (info.seq >= 0) {
+        CountSeq(info.seq, 1);
+        expectedNum_++;
+        EvictGroups(lastSeq_);
+    }
+    frame = buffer;
+    return true;
+}
+
+bool DCameraStreamFecDecoder::AddShard(const std::shared_ptr<DataBuffer>& buffer, std::shared_ptr<DataBuffer>& frame)
+{
+    const DCameraFrameInfo& info = buffer->frameInfo_;
+    uint32_t dataNum = static_cast<uint32_t>(std::max(info.fecDataNum, 0));
+    uint32_t parityNum = static_cast<uint32_t>(info.fecParityNum);
+    uint32_t totalNum = dataNum + parityNum;
+    size_t shardLen = DCameraStreamFecEncoder::GetShardLen(static_cast<size_t>(std::max(info.fecLen, 0)), dataNum);
+    if (info.seq < 0 || dataNum == 0 || totalNum > DCameraFecCodec::MAX_SHARD_NUM || shardLen == 0 ||
+        info.fecIndex < 0 || static_cast<uint32_t>(info.fecIndex) >= totalNum) {
+        DHLOGE("invalid fec shard seq %{public}d index %{public}d of %{public}d + %{public}d", info.seq,
+            info.fecIndex, info.fecDataNum, info.fecParityNum);
+        return false;
+    }
+    uint32_t index = static_cast<uint32_t>(info.fecIndex);
+    auto iter = groups_.find(info.seq);
+    if (iter == groups_.end()) {
+        if (lastSeq_ >= 0 && info.seq <= lastSeq_ && lastSeq_ - info.seq < SEQ_RESTART_GAP) {
+            // The group was already closed or counted as lost
+            return false;
+        }
+        CountSeq(info.seq, totalNum);
+        FecGroup group;
+        group.dataNum = dataNum;
+        group.parityNum = parityNum;
+        group.frameLen = static_cast<uint32_t>(info.fecLen);
+        group.shardLen = shardLen;
+        group.frameInfo = info;
+        group.shards.resize(totalNum);
+        group.present.assign(totalNum, false);
+        iter = groups_.emplace(info.seq, std::move(group)).first;
+        EvictGroups(info.seq);
+    }
+    FecGroup& group = iter->second;
+    size_t expectLen = shardLen;
+    if (index < dataNum) {
+        size_t offset = index * shardLen;
+        expectLen = (offset < group.frameLen) ? std::min(shardLen, group.frameLen - offset) : 0;
+    }
+    if (group.dataNum != dataNum || group.parityNum != parityNum || group.present[index] ||
+        buffer->Size() != expectLen) {
+        DHLOGE("mismatched fec shard seq %{public}d index %{public}u size %{public}zu", info.seq, index,
+            buffer->Size());
+        return false;
+    }
+    group.shards[index].assign(shardLen, 0);
+    if (expectLen > 0) {
+        int32_t ret = memcpy_s(group.shards[index].data(), shardLen, buffer->Data(), expectLen);
+        CHECK_AND_RETURN_RET_LOG(ret != EOK, false, "copy fec shard failed %{public}d", ret);
+    }
+    group.present[index] = true;
+    group.recvNum++;
+    if (group.isDelivered || group.recvNum < group.dataNum) {
+        return false;
+    }
+    group.isDelivered = true;
+    frame = RebuildFrame(group);
+    return frame != nullptr;
+}
+
+std::shared_ptr<DataBuffer> DCameraStreamFecDecoder::RebuildFrame(FecGroup& group)
+{
+    bool isRecovered = false;
+    for (uint32_t i = 0; i < group.dataNum; i++) {
+        isRecovered = isRecovered || !group.present[i];
+    }
+    if (isRecovered) {
+        int32_t ret = DCameraFecCodec::Reconstruct(group.shards, group.present, group.dataNum, group.shardLen);
+        CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, nullptr, "fec reconstruct seq %{public}d failed",
+            group.frameInfo.seq);
+        recoveredNum_++;
+    }
+    std::shared_ptr<DataBuffer> frame = std::make_shared<DataBuffer>(group.frameLen);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < group.dataNum && offset < group.frameLen; i++) {
+        size_t len = std::min(group.shardLen, group.frameLen - offset);
+        int32_t ret = memcpy_s(frame->Data() + offset, frame->Capacity() - offset, group.shards[i].data(), len);
+        CHECK_AND_RETURN_RET_LOG(ret != EOK, nullptr, "copy fec frame failed %{public}d", ret);
+        offset += len;
+    }
+    frame->frameInfo_ = group.frameInfo;
+    return frame;
+}
+
+void DCameraStreamFecDecoder::CountSeq(int32_t seq, uint32_t shardNum)
+{
+    if (lastSeq_ >= 0 && seq < lastSeq_ - SEQ_RESTART_GAP) {
+        DHLOGI("stream seq restarts from %{public}d to %{public}d", lastSeq_, seq);
+        for (const auto& iter : groups_) {
+            CloseGroup(iter.first, iter.second);
+        }
+        groups_.clear();
+        lastSeq_ = -1;
+    }
+    if (lastSeq_ >= 0 && seq > lastSeq_ + 1) {
+        // Frames missing as a whole, assume they were split like the last one
+        uint64_t missing = static_cast<uint64_t>(seq - lastSeq_ - 1) * lastShardNum_;
+        expectedNum_ += missing;
+        lostNum_ += missing;
+    }
+    if (seq > lastSeq_) {
+        lastSeq_ = seq;
+        lastShardNum_ = shardNum;
+    }
+}
+
+void DCameraStreamFecDecoder::EvictGroups(int32_t newestSeq)
+{
+    while (!groups_.empty() && groups_.begin()->first <= newestSeq - GROUP_WINDOW) {
+        CloseGroup(groups_.begin()->first, groups_.begin()->second);
+        groups_.erase(groups_.begin());
+    }
+}
+
+void DCameraStreamFecDecoder::CloseGroup(int32_t seq, const FecGroup& group)
+{
+    uint32_t totalNum = group.dataNum + group.parityNum;
+    expectedNum_ += totalNum;
+    lostNum_ += totalNum - group.recvNum;
+    if (!group.isDelivered) {
+        unrecoverableNum_++;
+        DHLOGD("fec group seq %{public}d lost, %{public}u of %{public}u shards", seq, group.recvNum,
+            group.dataNum);
+    }
+}
+
+bool DCameraStreamFecDecoder::PollLossReport(int64_t nowUs, uint32_t& lossPermille)
+{
+    if (lastReportUs_ == 0 || nowUs < lastReportUs_) {
+        lastReportUs_ = nowUs;
+        return false;
+    }
+    if (nowUs - lastReportUs_ < REPORT_INTERVAL_US || expectedNum_ == 0) {
+        return false;
+    }
+    lossPermille = static_cast<uint32_t>(std::min(lostNum_, expectedNum_) * PERMILLE / expectedNum_);
+    lastReportUs_ = nowUs;
+    expectedNum_ = 0;
+    lostNum_ = 0;
+    return true;
+}
+
+uint64_t DCameraStreamFecDecoder::GetRecoveredNum() const
+{
+    return recoveredNum_;
+}
+
+uint64_t DCameraStreamFecDecoder::GetUnrecoverableNum() const
+{
+    return unrecoverableNum_;
+}
+
+std::string DCameraStreamFecDecoder::MarshalLossReport(uint32_t lossPermille)
+{
+    cJSON *rootValue = cJSON_CreateObject();
+    if (rootValue == nullptr) {
+        return "";
+    }
+    cJSON_AddNumberToObject(rootValue, FEC_LOSS_KEY.c_str(), lossPermille);
+    char *data = cJSON_PrintUnformatted(rootValue);
+    cJSON_Delete(rootValue);
+    if (data == nullptr) {
+        return "";
+    }
+    std::string jsonStr(data);
+    cJSON_free(data);
+    return jsonStr;
+}
+
+bool DCameraStreamFecDecoder::UnmarshalLossReport(const std::string& jsonStr, uint32_t& lossPermille)
+{
+    cJSON *rootValue = cJSON_Parse(jsonStr.c_str());
+    if (rootValue == nullptr) {
+        return false;
+    }
+    cJSON *loss = cJSON_GetObjectItemCaseSensitive(rootValue, FEC_LOSS_KEY.c_str());
+    bool isReport = loss != nullptr && cJSON_IsNumber(loss) && loss->valueint >= 0;
+    if (isReport) {
+        lossPermille = std::min(static_cast<uint32_t>(loss->valueint), PERMILLE);
+    }
+    cJSON_Delete(rootValue);
+    return isReport;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -17,7 +17,6 @@
 
 #include "dcamera_tcp_adapter.h"
 #include "communication_adapter_factory.h"
-#include "local_tcp_adapter.h"
 #include "distributed_hardware_log.h"
 
 namespace OHOS {
@@ -28,7 +27,7 @@ DCameraTcpAdapter::DCameraTcpAdapter() {
     tcpAdapter_ = CommunicationAdapterFactory::CreateAdapterFromConfig();
     if (!tcpAdapter_) {
         DHLOGE("Failed to create TCP adapter");
-        tcpAdapter_ = std::make_unique<LocalTcpAdapter>();
+        tcpAdapter_ = CommunicationAdapterFactory::CreateAdapter(COMM_MODE_TCP);
     }
 }
 
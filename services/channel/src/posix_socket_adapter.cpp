@@ -0,0 +1,830 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef DCAMERA_TEST_ENABLE
+#ifndef _WIN32
+
+#include "posix_socket_adapter.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+constexpr uint32_t FNV_OFFSET_BASIS = 2166136261u;
+constexpr uint32_t FNV_PRIME = 16777619u;
+constexpr size_t MAGIC_POS = 0;
+constexpr size_t TYPE_POS = 4;
+constexpr size_t LEN_POS = 8;
+constexpr uint32_t BYTE_BITS = 8;
+constexpr uint32_t BYTE_MASK = 0xff;
+constexpr size_t UINT32_LEN = 4;
+constexpr int32_t MS_PER_SECOND = 1000;
+constexpr int32_t US_PER_MS = 1000;
+
+void PutUint32(uint8_t *dst, uint32_t value)
+{
+    for (size_t i = 0; i < UINT32_LEN; i++) {
+        dst[i] = static_cast<uint8_t>((value >> (BYTE_BITS * (UINT32_LEN - 1 - i))) & BYTE_MASK);
+    }
+}
+
+uint32_t GetUint32(const uint8_t *src)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < UINT32_LEN; i++) {
+        value = (value << BYTE_BITS) | src[i];
+    }
+    return value;
+}
+
+uint32_t HashSessionName(const std::string& sessionName)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (char c : sessionName) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+int32_t SetNonBlock(int32_t fd)
+{
+    int32_t flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        return -1;
+    }
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+}
+
+PosixSocketAdapter::PosixSocketAdapter() : PosixSocketAdapter(PosixSocketConfig())
+{
+}
+
+PosixSocketAdapter::PosixSocketAdapter(const PosixSocketConfig& config) : config_(config)
+{
+    isInitialized_ = (Init() == DCAMERA_OK);
+}
+
+PosixSocketAdapter::~PosixSocketAdapter()
+{
+    Stop();
+    std::lock_guard<std::mutex> lock(connMutex_);
+    for (auto& iter : connections_) {
+        close(iter.second->fd);
+    }
+    connections_.clear();
+    socketIds_.clear();
+    for (auto& iter : servers_) {
+        close(iter.second->fd);
+        if (!iter.second->path.empty()) {
+            unlink(iter.second->path.c_str());
+        }
+    }
+    servers_.clear();
+    serverIds_.clear();
+    ClosePendingFds();
+    if (wakeupFd_ >= 0) {
+        close(wakeupFd_);
+    }
+    if (epollFd_ >= 0) {
+        close(epollFd_);
+    }
+}
+
+int32_t PosixSocketAdapter::Init()
+{
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd_ < 0) {
+        DHLOGE("create epoll failed, errno %{public}d", errno);
+        return DCAMERA_INIT_ERR;
+    }
+    wakeupFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeupFd_ < 0) {
+        DHLOGE("create eventfd failed, errno %{public}d", errno);
+        return DCAMERA_INIT_ERR;
+    }
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKEUP_ID;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeupFd_, &event) != 0) {
+        DHLOGE("watch eventfd failed, errno %{public}d", errno);
+        return DCAMERA_INIT_ERR;
+    }
+    loopThread_ = std::thread([this]() { EventLoop(); });
+    return DCAMERA_OK;
+}
+
+void PosixSocketAdapter::Stop()
+{
+    if (!loopThread_.joinable()) {
+        return;
+    }
+    isStopping_.store(true);
+    Wakeup();
+    loopThread_.join();
+}
+
+void PosixSocketAdapter::Wakeup()
+{
+    uint64_t value = 1;
+    ssize_t ret = write(wakeupFd_, &value, sizeof(value));
+    if (ret < 0 && errno != EAGAIN) {
+        DHLOGE("wake up event loop failed, errno %{public}d", errno);
+    }
+}
+
+void PosixSocketAdapter::ClosePendingFds()
+{
+    std::vector<int32_t> fds;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        fds.swap(pendingCloseFds_);
+    }
+    for (int32_t fd : fds) {
+        close(fd);
+    }
+}
+
+void PosixSocketAdapter::EventLoop()
+{
+    epoll_event events[MAX_EPOLL_EVENTS];
+    while (!isStopping_.load()) {
+        int32_t num = epoll_wait(epollFd_, events, MAX_EPOLL_EVENTS, -1);
+        if (num < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            DHLOGE("epoll wait failed, errno %{public}d", errno);
+            break;
+        }
+        for (int32_t i = 0; i < num; i++) {
+            uint64_t id = events[i].data.u64;
+            if (id == WAKEUP_ID) {
+                uint64_t value = 0;
+                while (read(wakeupFd_, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+            std::shared_ptr<ServerEntry> server = nullptr;
+            std::shared_ptr<Connection> conn = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(connMutex_);
+                auto serverIter = servers_.find(id);
+                if (serverIter != servers_.end()) {
+                    server = serverIter->second;
+                }
+                auto connIter = connections_.find(id);
+                if (connIter != connections_.end()) {
+                    conn = connIter->second;
+                }
+            }
+            if (server != nullptr) {
+                HandleAccept(server);
+                continue;
+            }
+            if (conn == nullptr) {
+                continue;
+            }
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0) {
+                HandleRead(conn);
+            }
+            if ((events[i].events & EPOLLOUT) != 0 && !conn->isClosed.load()) {
+                HandleWrite(conn);
+            }
+        }
+        ClosePendingFds();
+    }
+}
+
+int32_t PosixSocketAdapter::CreateSocket()
+{
+    int32_t domain = (config_.family == SOCKET_FAMILY_UNIX) ? AF_UNIX : AF_INET;
+    int32_t fd = socket(domain, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        DHLOGE("create socket failed, errno %{public}d", errno);
+        return -1;
+    }
+    ApplySocketOptions(fd);
+    return fd;
+}
+
+int32_t PosixSocketAdapter::BuildAddress(const std::string& sessionName, uint32_t probe, sockaddr_storage& addr,
+    socklen_t& addrLen, std::string& path)
+{
+    addr = {};
+    uint32_t hash = HashSessionName(sessionName);
+    if (config_.family == SOCKET_FAMILY_UNIX) {
+        // The session name can be longer than sun_path, its hash is not
+        char name[UINT32_LEN * 2 + 1] = { 0 };
+        (void)snprintf(name, sizeof(name), "%08x", hash);
+        path = config_.unixDir + "/dcamera_" + name + ".sock";
+        sockaddr_un *unAddr = reinterpret_cast<sockaddr_un *>(&addr);
+        if (path.length() >= sizeof(unAddr->sun_path)) {
+            DHLOGE("socket path too long: %{public}s", path.c_str());
+            return DCAMERA_BAD_VALUE;
+        }
+        unAddr->sun_family = AF_UNIX;
+        (void)memcpy(unAddr->sun_path, path.c_str(), path.length());
+        addrLen = static_cast<socklen_t>(sizeof(sockaddr_un));
+        return DCAMERA_OK;
+    }
+    sockaddr_in *inAddr = reinterpret_cast<sockaddr_in *>(&addr);
+    inAddr->sin_family = AF_INET;
+    uint16_t range = (config_.portRange == 0) ? 1 : config_.portRange;
+    inAddr->sin_port = htons(static_cast<uint16_t>(config_.basePort + (hash % range + probe) % range));
+    if (inet_pton(AF_INET, config_.host.c_str(), &inAddr->sin_addr) != 1) {
+        DHLOGE("invalid host: %{public}s", config_.host.c_str());
+        return DCAMERA_BAD_VALUE;
+    }
+    addrLen = static_cast<socklen_t>(sizeof(sockaddr_in));
+    return DCAMERA_OK;
+}
+
+void PosixSocketAdapter::ApplySocketOptions(int32_t fd)
+{
+    if (config_.sendBufSize > 0 &&
+        setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &config_.sendBufSize, sizeof(config_.sendBufSize)) != 0) {
+        DHLOGW("set send buffer size failed, errno %{public}d", errno);
+    }
+    if (config_.recvBufSize > 0 &&
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &config_.recvBufSize, sizeof(config_.recvBufSize)) != 0) {
+        DHLOGW("set receive buffer size failed, errno %{public}d", errno);
+    }
+    if (config_.family == SOCKET_FAMILY_TCP) {
+        int32_t enable = 1;
+        (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+}
+
+int32_t PosixSocketAdapter::CreateSinkSocketServer(std::string mySessionName, DCAMERA_CHANNEL_ROLE role,
+    DCameraSessionMode sessionMode, std::string peerDevId, std::string peerSessionName)
+{
+    CHECK_AND_RETURN_RET_LOG(!isInitialized_, DCAMERA_INIT_ERR, "posix socket adapter not initialized");
+    {
+        std::lock_guard<std::mutex> lock(connMutex_);
+        if (serverIds_.find(mySessionName) != serverIds_.end()) {
+            DHLOGI("session server %{public}s already exists", mySessionName.c_str());
+            return DCAMERA_OK;
+        }
+    }
+    int32_t fd = CreateSocket();
+    CHECK_AND_RETURN_RET_LOG(fd < 0, DCAMERA_BAD_VALUE, "create server socket failed");
+    std::string path;
+    if (BindServer(fd, mySessionName, path) != DCAMERA_OK || listen(fd, SOMAXCONN) != 0 || SetNonBlock(fd) != 0) {
+        DHLOGE("listen on session %{public}s failed, errno %{public}d", mySessionName.c_str(), errno);
+        close(fd);
+        return DCAMERA_BAD_VALUE;
+    }
+    auto server = std::make_shared<ServerEntry>();
+    server->fd = fd;
+    server->role = role;
+    server->path = path;
+    server->sessionName = mySessionName;
+    {
+        std::lock_guard<std::mutex> lock(connMutex_);
+        server->id = nextId_++;
+        servers_[server->id] = server;
+        serverIds_[mySessionName] = server->id;
+    }
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = server->id;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+        DHLOGE("watch server socket failed, errno %{public}d", errno);
+        DestroySessionServer(mySessionName);
+        return DCAMERA_BAD_VALUE;
+    }
+    DHLOGI("session server %{public}s listening, mode %{public}d", mySessionName.c_str(), sessionMode);
+    return DCAMERA_OK;
+}
+
+int32_t PosixSocketAdapter::CreateSourceSocketClient(std::string myDhId, std::string myDevId,
+    std::string peerSessionName, std::string peerDevId, DCameraSessionMode sessionMode, DCAMERA_CHANNEL_ROLE role)
+{
+    CHECK_AND_RETURN_RET_LOG(!isInitialized_, DCAMERA_INIT_ERR, "posix socket adapter not initialized");
+    int32_t fd = ConnectServer(peerSessionName);
+    CHECK_AND_RETURN_RET_LOG(fd < 0, DCAMERA_BAD_VALUE, "connect to session %{public}s failed",
+        peerSessionName.c_str());
+    if (SetNonBlock(fd) != 0) {
+        DHLOGE("set session %{public}s non-blocking failed, errno %{public}d", peerSessionName.c_str(), errno);
+        close(fd);
+        return DCAMERA_BAD_VALUE;
+    }
+    std::shared_ptr<Connection> conn = AddConnection(fd, role, peerDevId, "");
+    if (conn == nullptr) {
+        return DCAMERA_BAD_VALUE;
+    }
+    DHLOGI("connected to session %{public}s, socket %{public}d, mode %{public}d", peerSessionName.c_str(), fd,
+        sessionMode);
+    return fd;
+}
+
+int32_t PosixSocketAdapter::BindServer(int32_t fd, const std::string& sessionName, std::string& path)
+{
+    sockaddr_storage addr;
+    socklen_t addrLen = 0;
+    if (config_.family == SOCKET_FAMILY_UNIX) {
+        CHECK_AND_RETURN_RET_LOG(BuildAddress(sessionName, 0, addr, addrLen, path) != DCAMERA_OK,
+            DCAMERA_BAD_VALUE, "build server address failed");
+        unlink(path.c_str());
+        return (bind(fd, reinterpret_cast<sockaddr *>(&addr), addrLen) == 0) ? DCAMERA_OK : DCAMERA_BAD_VALUE;
+    }
+    int32_t enable = 1;
+    (void)setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    uint32_t probeNum = std::min<uint32_t>(MAX_PORT_PROBES, std::max<uint16_t>(config_.portRange, 1));
+    for (uint32_t probe = 0; probe < probeNum; probe++) {
+        CHECK_AND_RETURN_RET_LOG(BuildAddress(sessionName, probe, addr, addrLen, path) != DCAMERA_OK,
+            DCAMERA_BAD_VALUE, "build server address failed");
+        if (bind(fd, reinterpret_cast<sockaddr *>(&addr), addrLen) == 0) {
+            return DCAMERA_OK;
+        }
+        if (errno != EADDRINUSE) {
+            return DCAMERA_BAD_VALUE;
+        }
+        DHLOGW("session %{public}s port %{public}u is in use, probing the next one", sessionName.c_str(),
+            ntohs(reinterpret_cast<sockaddr_in *>(&addr)->sin_port));
+    }
+    return DCAMERA_BAD_VALUE;
+}
+
+int32_t PosixSocketAdapter::ConnectServer(const std::string& peerSessionName)
+{
+    uint32_t probeNum = (config_.family == SOCKET_FAMILY_UNIX) ? 1 :
+        std::min<uint32_t>(MAX_PORT_PROBES, std::max<uint16_t>(config_.portRange, 1));
+    for (uint32_t probe = 0; probe < probeNum; probe++) {
+        sockaddr_storage addr;
+        socklen_t addrLen = 0;
+        std::string path;
+        CHECK_AND_RETURN_RET_LOG(BuildAddress(peerSessionName, probe, addr, addrLen, path) != DCAMERA_OK, -1,
+            "build peer address failed");
+        int32_t fd = CreateSocket();
+        CHECK_AND_RETURN_RET_LOG(fd < 0, -1, "create client socket failed");
+        int32_t ret = 0;
+        do {
+            ret = connect(fd, reinterpret_cast<sockaddr *>(&addr), addrLen);
+        } while (ret != 0 && errno == EINTR);
+        // The server probed past a port that was taken then, its owner may be gone by now
+        if (ret == 0 && CheckSessionName(fd, peerSessionName)) {
+            return fd;
+        }
+        DHLOGW("session %{public}s is not at probe %{public}u, errno %{public}d", peerSessionName.c_str(), probe,
+            errno);
+        close(fd);
+    }
+    return -1;
+}
+
+bool PosixSocketAdapter::CheckSessionName(int32_t fd, const std::string& peerSessionName)
+{
+    // Only the session frame is read here, the hello behind it is left to the event thread
+    timeval timeout = { SESSION_CHECK_TIMEOUT_MS / MS_PER_SECOND,
+        (SESSION_CHECK_TIMEOUT_MS % MS_PER_SECOND) * US_PER_MS };
+    (void)setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    uint8_t header[FRAME_HEADER_LEN] = { 0 };
+    if (recv(fd, header, FRAME_HEADER_LEN, MSG_WAITALL) != static_cast<ssize_t>(FRAME_HEADER_LEN) ||
+        GetUint32(header + MAGIC_POS) != FRAME_MAGIC || header[TYPE_POS] != FRAME_SESSION) {
+        return false;
+    }
+    uint32_t len = GetUint32(header + LEN_POS);
+    if (len != peerSessionName.length()) {
+        return false;
+    }
+    std::string sessionName(len, '\0');
+    if (len > 0 && recv(fd, &sessionName[0], len, MSG_WAITALL) != static_cast<ssize_t>(len)) {
+        return false;
+    }
+    timeout = { 0, 0 };
+    (void)setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return sessionName == peerSessionName;
+}
+
+std::shared_ptr<PosixSocketAdapter::Connection> PosixSocketAdapter::AddConnection(int32_t fd,
+    DCAMERA_CHANNEL_ROLE role, const std::string& peerDevId, const std::string& sessionName)
+{
+    auto conn = std::make_shared<Connection>();
+    conn->fd = fd;
+    conn->role = role;
+    conn->peerDevId = peerDevId;
+    {
+        std::lock_guard<std::mutex> lock(connMutex_);
+        conn->id = nextId_++;
+        connections_[conn->id] = conn;
+        socketIds_[fd] = conn->id;
+    }
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = conn->id;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+        DHLOGE("watch socket %{public}d failed, errno %{public}d", fd, errno);
+        CloseConnection(conn, false);
+        return nullptr;
+    }
+    if (!sessionName.empty() && SendFrame(fd, FRAME_SESSION, reinterpret_cast<const uint8_t *>(sessionName.c_str()),
+        sessionName.length()) != DCAMERA_OK) {
+        CloseConnection(conn, false);
+        return nullptr;
+    }
+    // Each side announces itself, the session counts as open once the peer has done the same
+    std::string localNetworkId = config_.localNetworkId;
+    if (SendFrame(fd, FRAME_HELLO, reinterpret_cast<const uint8_t *>(localNetworkId.c_str()),
+        localNetworkId.length()) != DCAMERA_OK) {
+        CloseConnection(conn, false);
+        return nullptr;
+    }
+    return conn;
+}
+
+std::shared_ptr<PosixSocketAdapter::Connection> PosixSocketAdapter::FindConnection(int32_t socket)
+{
+    std::lock_guard<std::mutex> lock(connMutex_);
+    auto idIter = socketIds_.find(socket);
+    if (idIter == socketIds_.end()) {
+        return nullptr;
+    }
+    auto connIter = connections_.find(idIter->second);
+    return (connIter == connections_.end()) ? nullptr : connIter->second;
+}
+
+void PosixSocketAdapter::CloseConnection(const std::shared_ptr<Connection>& conn, bool isNotify)
+{
+    {
+        std::lock_guard<std::mutex> lock(connMutex_);
+        if (connections_.erase(conn->id) == 0) {
+            return;
+        }
+        socketIds_.erase(conn->fd);
+    }
+    {
+        // Senders check the flag under this lock, so no one writes to the descriptor after it
+        std::lock_guard<std::mutex> lock(conn->sendMutex);
+        conn->isClosed.store(true);
+        conn->outQueue.clear();
+    }
+    (void)epoll_ctl(epollFd_, EPOLL_CTL_DEL, conn->fd, nullptr);
+    (void)shutdown(conn->fd, SHUT_RDWR);
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingCloseFds_.push_back(conn->fd);
+    }
+    Wakeup();
+    DHLOGI("socket %{public}d closed", conn->fd);
+    if (!isNotify || !conn->isOpened) {
+        return;
+    }
+    ICameraChannelListener *listener = GetListener(conn->role);
+    if (listener != nullptr) {
+        listener->OnSessionState(DCAMERA_CHANNEL_STATE_DISCONNECTED, conn->peerDevId);
+    }
+}
+
+int32_t PosixSocketAdapter::DestroySessionServer(std::string sessionName)
+{
+    std::shared_ptr<ServerEntry> server = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(connMutex_);
+        auto idIter = serverIds_.find(sessionName);
+        if (idIter == serverIds_.end()) {
+            return DCAMERA_OK;
+        }
+        server = servers_[idIter->second];
+        servers_.erase(idIter->second);
+        serverIds_.erase(idIter);
+    }
+    (void)epoll_ctl(epollFd_, EPOLL_CTL_DEL, server->fd, nullptr);
+    if (!server->path.empty()) {
+        unlink(server->path.c_str());
+    }
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingCloseFds_.push_back(server->fd);
+    }
+    Wakeup();
+    DHLOGI("session server %{public}s destroyed", sessionName.c_str());
+    return DCAMERA_OK;
+}
+
+int32_t PosixSocketAdapter::CloseSession(int32_t socket)
+{
+    std::shared_ptr<Connection> conn = FindConnection(socket);
+    if (conn == nullptr) {
+        DHLOGE("close unknown socket %{public}d", socket);
+        return DCAMERA_NOT_FOUND;
+    }
+    CloseConnection(conn, false);
+    return DCAMERA_OK;
+}
+
+void PosixSocketAdapter::HandleAccept(const std::shared_ptr<ServerEntry>& server)
+{
+    while (true) {
+        int32_t fd = accept4(server->fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                DHLOGE("accept failed, errno %{public}d", errno);
+            }
+            return;
+        }
+        ApplySocketOptions(fd);
+        // The peer network id arrives with its hello frame
+        if (AddConnection(fd, server->role, "", server->sessionName) != nullptr) {
+            DHLOGI("accepted socket %{public}d", fd);
+        }
+    }
+}
+
+void PosixSocketAdapter::HandleRead(const std::shared_ptr<Connection>& conn)
+{
+    for (int32_t i = 0; i < MAX_READ_PER_EVENT && !conn->isClosed.load(); i++) {
+        ssize_t ret = 0;
+        bool isHeader = conn->headerLen < FRAME_HEADER_LEN;
+        if (isHeader) {
+            ret = read(conn->fd, conn->header + conn->headerLen, FRAME_HEADER_LEN - conn->headerLen);
+        } else {
+            ret = read(conn->fd, conn->body->Data() + conn->bodyLen, conn->body->Size() - conn->bodyLen);
+        }
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (ret <= 0) {
+            DHLOGI("socket %{public}d peer closed, ret %{public}zd errno %{public}d", conn->fd, ret, errno);
+            CloseConnection(conn, true);
+            return;
+        }
+        if (isHeader) {
+            conn->headerLen += static_cast<size_t>(ret);
+            if (conn->headerLen == FRAME_HEADER_LEN && !OnHeader(conn)) {
+                CloseConnection(conn, true);
+                return;
+            }
+            continue;
+        }
+        conn->bodyLen += static_cast<size_t>(ret);
+        if (conn->bodyLen == conn->body->Size()) {
+            std::shared_ptr<DataBuffer> body = std::move(conn->body);
+            conn->headerLen = 0;
+            conn->bodyLen = 0;
+            OnFrame(conn, conn->type, body);
+        }
+    }
+}
+
+bool PosixSocketAdapter::OnHeader(const std::shared_ptr<Connection>& conn)
+{
+    uint32_t magic = GetUint32(conn->header + MAGIC_POS);
+    uint32_t len = GetUint32(conn->header + LEN_POS);
+    conn->type = conn->header[TYPE_POS];
+    if (magic != FRAME_MAGIC || len > DCAMERA_MAX_RECV_DATA_LEN) {
+        DHLOGE("socket %{public}d bad frame header, magic %{public}x len %{public}u", conn->fd, magic, len);
+        return false;
+    }
+    if (len == 0) {
+        conn->headerLen = 0;
+        std::shared_ptr<DataBuffer> body = nullptr;
+        OnFrame(conn, conn->type, body);
+        return true;
+    }
+    conn->body = std::make_shared<DataBuffer>(len);
+    conn->bodyLen = 0;
+    if (conn->body->Data() == nullptr) {
+        DHLOGE("socket %{public}d alloc frame of %{public}u bytes failed", conn->fd, len);
+        return false;
+    }
+    return true;
+}
+
+void PosixSocketAdapter::OnFrame(const std::shared_ptr<Connection>& conn, uint8_t type,
+    std::shared_ptr<DataBuffer>& body)
+{
+    ICameraChannelListener *listener = GetListener(conn->role);
+    if (type == FRAME_HELLO) {
+        if (body != nullptr) {
+            conn->peerDevId.assign(reinterpret_cast<const char *>(body->Data()), body->Size());
+        }
+        if (!conn->isOpened) {
+            conn->isOpened = true;
+            if (listener != nullptr) {
+                listener->OnSessionState(DCAMERA_CHANNEL_STATE_CONNECTED, conn->peerDevId);
+            }
+        }
+        return;
+    }
+    if ((type != FRAME_BYTES && type != FRAME_STREAM) || body == nullptr) {
+        DHLOGE("socket %{public}d drop frame of type %{public}d", conn->fd, type);
+        return;
+    }
+    if (listener != nullptr) {
+        std::vector<std::shared_ptr<DataBuffer>> buffers;
+        buffers.push_back(body);
+        listener->OnDataReceived(buffers);
+    }
+}
+
+void PosixSocketAdapter::HandleWrite(const std::shared_ptr<Connection>& conn)
+{
+    bool isBroken = false;
+    {
+        std::lock_guard<std::mutex> lock(conn->sendMutex);
+        if (conn->isClosed.load()) {
+            return;
+        }
+        while (!conn->outQueue.empty()) {
+            OutFrame& frame = conn->outQueue.front();
+            ssize_t ret = send(conn->fd, frame.data.data() + frame.sent, frame.data.size() - frame.sent,
+                MSG_NOSIGNAL);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            if (ret < 0) {
+                DHLOGE("socket %{public}d send failed, errno %{public}d", conn->fd, errno);
+                isBroken = true;
+                break;
+            }
+            frame.sent += static_cast<size_t>(ret);
+            conn->queuedBytes -= static_cast<size_t>(ret);
+            if (frame.sent == frame.data.size()) {
+                if (frame.type == FRAME_STREAM) {
+                    conn->queuedStreamNum--;
+                }
+                conn->outQueue.pop_front();
+            }
+        }
+        if (!isBroken && conn->outQueue.empty() && conn->isWriteWatched) {
+            WatchWrite(*conn, false);
+        }
+    }
+    if (isBroken) {
+        CloseConnection(conn, true);
+    }
+}
+
+int32_t PosixSocketAdapter::SendBytes(int32_t socket, std::shared_ptr<DataBuffer> &buffer)
+{
+    CHECK_AND_RETURN_RET_LOG(buffer == nullptr || buffer->Size() == 0, DCAMERA_BAD_VALUE, "send empty bytes");
+    return SendFrame(socket, FRAME_BYTES, buffer->Data(), buffer->Size());
+}
+
+int32_t PosixSocketAdapter::SendStream(int32_t socket, std::shared_ptr<DataBuffer> &buffer)
+{
+    CHECK_AND_RETURN_RET_LOG(buffer == nullptr || buffer->Size() == 0, DCAMERA_BAD_VALUE, "send empty stream");
+    return SendFrame(socket, FRAME_STREAM, buffer->Data(), buffer->Size());
+}
+
+int32_t PosixSocketAdapter::SendFrame(int32_t socket, uint8_t type, const uint8_t *data, size_t len)
+{
+    CHECK_AND_RETURN_RET_LOG(len > DCAMERA_MAX_RECV_DATA_LEN, DCAMERA_BAD_VALUE, "frame too long: %{public}zu", len);
+    std::shared_ptr<Connection> conn = FindConnection(socket);
+    CHECK_AND_RETURN_RET_LOG(conn == nullptr, DCAMERA_NOT_FOUND, "send on unknown socket %{public}d", socket);
+    uint8_t header[FRAME_HEADER_LEN] = { 0 };
+    PutUint32(header + MAGIC_POS, FRAME_MAGIC);
+    header[TYPE_POS] = type;
+    PutUint32(header + LEN_POS, static_cast<uint32_t>(len));
+
+    std::lock_guard<std::mutex> lock(conn->sendMutex);
+    CHECK_AND_RETURN_RET_LOG(conn->isClosed.load(), DCAMERA_WRONG_STATE, "socket %{public}d closed", socket);
+    if (type == FRAME_STREAM && conn->queuedStreamNum >= config_.maxStreamQueueNum && !DropQueuedStream(*conn)) {
+        // Only a partly sent frame is queued, it has to finish so the new one goes instead
+        conn->droppedStreamNum++;
+        return DCAMERA_OK;
+    }
+    if (type != FRAME_STREAM && conn->queuedBytes + len > config_.maxQueuedBytes) {
+        DHLOGE("socket %{public}d send queue full, queued %{public}zu", socket, conn->queuedBytes);
+        return DCAMERA_TRANS_BUSY;
+    }
+    size_t sent = 0;
+    if (conn->outQueue.empty()) {
+        iovec iov[] = {
+            { header, FRAME_HEADER_LEN },
+            { const_cast<uint8_t *>(data), len },
+        };
+        msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (len == 0) ? 1 : sizeof(iov) / sizeof(iov[0]);
+        ssize_t ret = 0;
+        do {
+            ret = sendmsg(conn->fd, &msg, MSG_NOSIGNAL);
+        } while (ret < 0 && errno == EINTR);
+        if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            DHLOGE("socket %{public}d send failed, errno %{public}d", socket, errno);
+            return DCAMERA_BAD_OPERATE;
+        }
+        sent = (ret < 0) ? 0 : static_cast<size_t>(ret);
+        if (sent == FRAME_HEADER_LEN + len) {
+            return DCAMERA_OK;
+        }
+    }
+    // The caller keeps its buffer, so whatever the socket did not take is copied
+    OutFrame frame;
+    frame.type = type;
+    frame.data.reserve(FRAME_HEADER_LEN + len);
+    frame.data.insert(frame.data.end(), header, header + FRAME_HEADER_LEN);
+    frame.data.insert(frame.data.end(), data, data + len);
+    frame.sent = sent;
+    conn->queuedBytes += frame.data.size() - sent;
+    if (type == FRAME_STREAM) {
+        conn->queuedStreamNum++;
+    }
+    conn->outQueue.push_back(std::move(frame));
+    if (!conn->isWriteWatched) {
+        WatchWrite(*conn, true);
+    }
+    return DCAMERA_OK;
+}
+
+bool PosixSocketAdapter::DropQueuedStream(Connection& conn)
+{
+    for (auto iter = conn.outQueue.begin(); iter != conn.outQueue.end(); ++iter) {
+        if (iter->type == FRAME_STREAM && iter->sent == 0) {
+            conn.queuedBytes -= iter->data.size();
+            conn.queuedStreamNum--;
+            conn.droppedStreamNum++;
+            conn.outQueue.erase(iter);
+            return true;
+        }
+    }
+    return false;
+}
+
+void PosixSocketAdapter::WatchWrite(Connection& conn, bool isEnable)
+{
+    epoll_event event = {};
+    event.events = isEnable ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    event.data.u64 = conn.id;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_MOD, conn.fd, &event) != 0) {
+        DHLOGE("socket %{public}d update events failed, errno %{public}d", conn.fd, errno);
+        return;
+    }
+    conn.isWriteWatched = isEnable;
+}
+
+uint64_t PosixSocketAdapter::GetDroppedStreamNum(int32_t socket)
+{
+    std::shared_ptr<Connection> conn = FindConnection(socket);
+    if (conn == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(conn->sendMutex);
+    return conn->droppedStreamNum;
+}
+
+int32_t PosixSocketAdapter::GetLocalNetworkId(std::string &myDevId)
+{
+    myDevId = config_.localNetworkId;
+    return DCAMERA_OK;
+}
+
+void PosixSocketAdapter::RegisterSourceListener(ICameraChannelListener* listener)
+{
+    sourceListener_.store(listener);
+}
+
+void PosixSocketAdapter::RegisterSinkListener(ICameraChannelListener* listener)
+{
+    sinkListener_.store(listener);
+}
+
+ICameraChannelListener* PosixSocketAdapter::GetListener(DCAMERA_CHANNEL_ROLE role)
+{
+    return (role == DCAMERA_CHANNLE_ROLE_SOURCE) ? sourceListener_.load() : sinkListener_.load();
+}
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // _WIN32
+#endif // DCAMERA_TEST_ENABLE
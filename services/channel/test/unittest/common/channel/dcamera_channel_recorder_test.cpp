@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dcamera_channel_recorder.h"
+#include "dcamera_sink_frame_info.h"
+#include "dcamera_softbus_session.h"
+#include "dcamera_stream_fec.h"
+
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraChannelRecorderTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_RECORD_FILE = "/data/test_channel_record.dcrec";
+const std::string TEST_INDEX_FILE = "/data/test_channel_record.dcidx";
+const std::string TEST_BYTES = "test channel bytes";
+const std::string TEST_STREAM = "test channel stream";
+const std::string TEST_EXT = "{\"type\":0}";
+const std::string TEST_CORRUPT_EXT = "{\"type\":";
+const int32_t TEST_SOCKET = 1;
+const int64_t TEST_RECV_TIME_US = 1000;
+// Every write to it fails with ENOSPC once the stdio buffer is flushed
+const std::string TEST_FULL_FILE = "/dev/full";
+const int32_t TEST_WAIT_STEP_MS = 10;
+const int32_t TEST_WAIT_STEPS = 200;
+const size_t TEST_FEC_FRAME_LEN = 8 * 1024 + 17;
+const uint32_t TEST_FEC_DATA_NUM = 4;
+const uint32_t TEST_FEC_PARITY_NUM = 2;
+const int32_t TEST_FEC_SEQ = 7;
+
+class TestReplayListener : public ICameraChannelListener {
+public:
+    void OnSessionState(int32_t state, std::string networkId) override
+    {
+    }
+
+    void OnSessionError(int32_t eventType, int32_t eventReason, std::string detail) override
+    {
+    }
+
+    void OnDataReceived(std::vector<std::shared_ptr<DataBuffer>>& buffers) override
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        received_.insert(received_.end(), buffers.begin(), buffers.end());
+    }
+
+    std::vector<std::shared_ptr<DataBuffer>> GetReceived()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return received_;
+    }
+
+private:
+    std::mutex lock_;
+    std::vector<std::shared_ptr<DataBuffer>> received_;
+};
+
+// Records the shards of one FEC protected frame the way SendFecStream puts them on the wire
+void RecordFecFrame(const std::vector<uint8_t>& frame, uint32_t lostIndex)
+{
+    std::vector<std::vector<uint8_t>> parity;
+    ASSERT_EQ(DCAMERA_OK, DCameraStreamFecEncoder::Encode(frame.data(), frame.size(), TEST_FEC_DATA_NUM,
+        TEST_FEC_PARITY_NUM, parity));
+    size_t shardLen = DCameraStreamFecEncoder::GetShardLen(frame.size(), TEST_FEC_DATA_NUM);
+    DCameraSinkFrameInfo sinkFrameInfo;
+    sinkFrameInfo.seq_ = TEST_FEC_SEQ;
+    sinkFrameInfo.fecDataNum_ = static_cast<int32_t>(TEST_FEC_DATA_NUM);
+    sinkFrameInfo.fecParityNum_ = static_cast<int32_t>(TEST_FEC_PARITY_NUM);
+    sinkFrameInfo.fecLen_ = static_cast<int32_t>(frame.size());
+    for (uint32_t i = 0; i < TEST_FEC_DATA_NUM + TEST_FEC_PARITY_NUM; i++) {
+        if (i == lostIndex) {
+            continue;
+        }
+        const uint8_t *shard = nullptr;
+        size_t len = shardLen;
+        if (i < TEST_FEC_DATA_NUM) {
+            size_t offset = std::min(i * shardLen, frame.size());
+            shard = frame.data() + offset;
+            len = std::min(shardLen, frame.size() - offset);
+        } else {
+            shard = parity[i - TEST_FEC_DATA_NUM].data();
+        }
+        std::string jsonStr;
+        sinkFrameInfo.fecIndex_ = static_cast<int32_t>(i);
+        sinkFrameInfo.Marshal(jsonStr);
+        DCameraChannelRecorder::GetInstance().Record(DCAMERA_RECORD_TYPE_STREAM, TEST_SOCKET,
+            TEST_RECV_TIME_US + i, shard, static_cast<uint32_t>(len), jsonStr.data(), jsonStr.size());
+    }
+}
+}
+
+void DCameraChannelRecorderTest::SetUpTestCase(void)
+{
+}
+
+void DCameraChannelRecorderTest::TearDownTestCase(void)
+{
+}
+
+void DCameraChannelRecorderTest::SetUp(void)
+{
+}
+
+void DCameraChannelRecorderTest::TearDown(void)
+{
+    DCameraChannelRecorder::GetInstance().StopRecord();
+    remove(TEST_RECORD_FILE.c_str());
+    remove(TEST_INDEX_FILE.c_str());
+}
+
+/**
+ * @tc.name: dcamera_channel_recorder_test_001
+ * @tc.desc: Verify the StartRecord and StopRecord function.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelRecorderTest, dcamera_channel_recorder_test_001, TestSize.Level1)
+{
+    int32_t ret = DCameraChannelRecorder::GetInstance().StartRecord(TEST_RECORD_FILE, TEST_INDEX_FILE);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_TRUE(DCameraChannelRecorder::GetInstance().IsRecording());
+
+    ret = DCameraChannelRecorder::GetInstance().StopRecord();
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_FALSE(DCameraChannelRecorder::GetInstance().IsRecording());
+}
+
+/**
+ * @tc.name: dcamera_channel_recorder_test_002
+ * @tc.desc: Verify the Record and ReadRecord function.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelRecorderTest, dcamera_channel_recorder_test_002, TestSize.Level1)
+{
+    DCameraChannelRecorder& recorder = DCameraChannelRecorder::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, recorder.StartRecord(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    recorder.Record(DCAMERA_RECORD_TYPE_BYTES, TEST_SOCKET, TEST_RECV_TIME_US, TEST_BYTES.data(),
+        TEST_BYTES.size(), nullptr, 0);
+    recorder.Record(DCAMERA_RECORD_TYPE_STREAM, TEST_SOCKET, TEST_RECV_TIME_US + 1, TEST_STREAM.data(),
+        TEST_STREAM.size(), TEST_EXT.data(), TEST_EXT.size());
+    EXPECT_EQ(2, recorder.GetRecordCount());
+    EXPECT_EQ(DCAMERA_OK, recorder.StopRecord());
+
+    DCameraChannelReplayer replayer;
+    EXPECT_EQ(DCAMERA_OK, replayer.Open(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    EXPECT_EQ(2, replayer.GetRecordCount());
+
+    DCameraChannelRecord record;
+    EXPECT_EQ(DCAMERA_OK, replayer.ReadRecord(1, record));
+    EXPECT_EQ(DCAMERA_RECORD_TYPE_STREAM, record.type);
+    EXPECT_EQ(TEST_SOCKET, record.socket);
+    EXPECT_EQ(TEST_RECV_TIME_US + 1, record.recvTimeUs);
+    EXPECT_EQ(TEST_STREAM.size(), record.data->Size());
+    EXPECT_EQ(0, memcmp(record.data->Data(), TEST_STREAM.data(), TEST_STREAM.size()));
+    EXPECT_EQ(TEST_EXT, record.ext);
+
+    EXPECT_EQ(DCAMERA_OK, replayer.ReadRecord(0, record));
+    EXPECT_EQ(DCAMERA_RECORD_TYPE_BYTES, record.type);
+    EXPECT_TRUE(record.ext.empty());
+    EXPECT_EQ(DCAMERA_BAD_VALUE, replayer.ReadRecord(2, record));
+}
+
+/**
+ * @tc.name: dcamera_channel_recorder_test_003
+ * @tc.desc: Verify the Replay function.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelRecorderTest, dcamera_channel_recorder_test_003, TestSize.Level1)
+{
+    DCameraChannelReplayer replayer;
+    std::shared_ptr<DCameraSoftbusSession> session = nullptr;
+    EXPECT_EQ(DCAMERA_INIT_ERR, replayer.Open(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    EXPECT_EQ(DCAMERA_BAD_VALUE, replayer.Replay(session, -1, DCAMERA_REPLAY_PACING_FAST));
+
+    DCameraChannelRecorder& recorder = DCameraChannelRecorder::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, recorder.StartRecord(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    recorder.Record(DCAMERA_RECORD_TYPE_BYTES, TEST_SOCKET, TEST_RECV_TIME_US, TEST_BYTES.data(),
+        TEST_BYTES.size(), nullptr, 0);
+    EXPECT_EQ(DCAMERA_OK, recorder.StopRecord());
+
+    session = std::make_shared<DCameraSoftbusSession>();
+    EXPECT_EQ(DCAMERA_NOT_FOUND, replayer.Replay(session, -1, DCAMERA_REPLAY_PACING_FAST));
+    EXPECT_EQ(DCAMERA_OK, replayer.Open(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    EXPECT_EQ(DCAMERA_OK, replayer.Replay(session, TEST_SOCKET, DCAMERA_REPLAY_PACING_ORIGINAL));
+}
+
+/**
+ * @tc.name: dcamera_channel_recorder_test_004
+ * @tc.desc: Verify a write error stops recording and a new recording can start afterwards.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelRecorderTest, dcamera_channel_recorder_test_004, TestSize.Level1)
+{
+    DCameraChannelRecorder& recorder = DCameraChannelRecorder::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, recorder.StartRecord(TEST_FULL_FILE, TEST_INDEX_FILE));
+    recorder.Record(DCAMERA_RECORD_TYPE_BYTES, TEST_SOCKET, TEST_RECV_TIME_US, TEST_BYTES.data(),
+        TEST_BYTES.size(), nullptr, 0);
+    for (int32_t i = 0; i < TEST_WAIT_STEPS && recorder.IsRecording(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_WAIT_STEP_MS));
+    }
+    EXPECT_FALSE(recorder.IsRecording());
+    recorder.Record(DCAMERA_RECORD_TYPE_BYTES, TEST_SOCKET, TEST_RECV_TIME_US, TEST_BYTES.data(),
+        TEST_BYTES.size(), nullptr, 0);
+    EXPECT_EQ(1, recorder.GetRecordCount());
+    EXPECT_EQ(DCAMERA_OK, recorder.StopRecord());
+
+    EXPECT_EQ(DCAMERA_OK, recorder.StartRecord(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    recorder.Record(DCAMERA_RECORD_TYPE_BYTES, TEST_SOCKET, TEST_RECV_TIME_US, TEST_BYTES.data(),
+        TEST_BYTES.size(), nullptr, 0);
+    EXPECT_EQ(DCAMERA_OK, recorder.StopRecord());
+    DCameraChannelReplayer replayer;
+    EXPECT_EQ(DCAMERA_OK, replayer.Open(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    EXPECT_EQ(1, replayer.GetRecordCount());
+}
+
+/**
+ * @tc.name: dcamera_channel_recorder_test_005
+ * @tc.desc: Verify replayed FEC shards are rebuilt into the frame before they reach the session.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelRecorderTest, dcamera_channel_recorder_test_005, TestSize.Level1)
+{
+    std::vector<uint8_t> frame(TEST_FEC_FRAME_LEN);
+    for (size_t i = 0; i < frame.size(); i++) {
+        frame[i] = static_cast<uint8_t>(i * 13 + 5);
+    }
+    DCameraChannelRecorder& recorder = DCameraChannelRecorder::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, recorder.StartRecord(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    RecordFecFrame(frame, 1);
+    EXPECT_EQ(DCAMERA_OK, recorder.StopRecord());
+
+    auto listener = std::make_shared<TestReplayListener>();
+    std::shared_ptr<DCameraSoftbusSession> session = std::make_shared<DCameraSoftbusSession>("dhId", "myDevId",
+        "testmysession", "peerDevId", "testpeersession", listener, DCAMERA_SESSION_MODE_VIDEO);
+    DCameraChannelReplayer replayer;
+    EXPECT_EQ(DCAMERA_OK, replayer.Open(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    EXPECT_EQ(TEST_FEC_DATA_NUM + TEST_FEC_PARITY_NUM - 1, replayer.GetRecordCount());
+    // Replaying twice must not hit a decoder left over from the first run
+    for (int32_t round = 1; round <= 2; round++) {
+        EXPECT_EQ(DCAMERA_OK, replayer.Replay(session, TEST_SOCKET, DCAMERA_REPLAY_PACING_FAST));
+        for (int32_t i = 0; i < TEST_WAIT_STEPS && listener->GetReceived().size() < static_cast<size_t>(round);
+            i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(TEST_WAIT_STEP_MS));
+        }
+        std::vector<std::shared_ptr<DataBuffer>> received = listener->GetReceived();
+        ASSERT_EQ(static_cast<size_t>(round), received.size());
+        std::shared_ptr<DataBuffer> rebuilt = received.back();
+        ASSERT_EQ(frame.size(), rebuilt->Size());
+        EXPECT_EQ(0, memcmp(rebuilt->Data(), frame.data(), frame.size()));
+        EXPECT_EQ(TEST_FEC_SEQ, rebuilt->frameInfo_.seq);
+    }
+}
+
+/**
+ * @tc.name: dcamera_channel_recorder_test_006
+ * @tc.desc: Verify a replayed stream whose ext does not parse is counted as an error and skipped.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelRecorderTest, dcamera_channel_recorder_test_006, TestSize.Level1)
+{
+    DCameraSinkFrameInfo sinkFrameInfo;
+    std::string jsonStr;
+    sinkFrameInfo.Marshal(jsonStr);
+    DCameraChannelRecorder& recorder = DCameraChannelRecorder::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, recorder.StartRecord(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    recorder.Record(DCAMERA_RECORD_TYPE_STREAM, TEST_SOCKET, TEST_RECV_TIME_US, TEST_STREAM.data(),
+        TEST_STREAM.size(), TEST_CORRUPT_EXT.data(), TEST_CORRUPT_EXT.size());
+    recorder.Record(DCAMERA_RECORD_TYPE_STREAM, TEST_SOCKET, TEST_RECV_TIME_US + 1, TEST_STREAM.data(),
+        TEST_STREAM.size(), jsonStr.data(), jsonStr.size());
+    EXPECT_EQ(DCAMERA_OK, recorder.StopRecord());
+
+    auto listener = std::make_shared<TestReplayListener>();
+    std::shared_ptr<DCameraSoftbusSession> session = std::make_shared<DCameraSoftbusSession>("dhId", "myDevId",
+        "testmysession", "peerDevId", "testpeersession", listener, DCAMERA_SESSION_MODE_VIDEO);
+    DCameraChannelReplayer replayer;
+    EXPECT_EQ(DCAMERA_OK, replayer.Open(TEST_RECORD_FILE, TEST_INDEX_FILE));
+    EXPECT_EQ(DCAMERA_OK, replayer.Replay(session, TEST_SOCKET, DCAMERA_REPLAY_PACING_FAST));
+    EXPECT_EQ(1, replayer.GetErrorCount());
+    for (int32_t i = 0; i < TEST_WAIT_STEPS && listener->GetReceived().empty(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_WAIT_STEP_MS));
+    }
+    std::vector<std::shared_ptr<DataBuffer>> received = listener->GetReceived();
+    ASSERT_EQ(1, received.size());
+    ASSERT_EQ(TEST_STREAM.size(), received[0]->Size());
+    EXPECT_EQ(0, memcmp(received[0]->Data(), TEST_STREAM.data(), TEST_STREAM.size()));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
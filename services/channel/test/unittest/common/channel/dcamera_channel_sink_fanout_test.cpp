@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "dcamera_channel_sink_fanout.h"
+
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraChannelSinkFanoutTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    std::shared_ptr<DCameraChannelSinkFanout> fanout_;
+};
+
+namespace {
+const std::string TEST_DEVICE_ID_1 = "bb536a637105409e904d4da83790a4a7";
+const std::string TEST_DEVICE_ID_2 = "bb536a637105409e904d4da83790a4a8";
+const int32_t TEST_FRAME_TYPE_KEY = 2;
+const int32_t TEST_FRAME_TYPE_NONE = 0;
+const int32_t TEST_FRAME_TYPE_CODEC_DATA = 8;
+const int32_t TEST_FRAME_NUM = 20;
+const int32_t TEST_WAIT_MS = 1000;
+const std::string TEST_CAMERA_DH_ID = "camera_0";
+const std::string TEST_SESSION_FLAG = "dataContinue";
+const int32_t TEST_TEMPORAL_GOP_NUM = 3;
+const std::vector<int32_t> TEST_TEMPORAL_LAYERS = { 2, 1, 2, 0 };
+// More viewers than the executor has workers
+const int32_t TEST_MANY_SUBSCRIBER_NUM = 40;
+
+class TestSubscriberChannel : public ICameraChannel {
+public:
+    int32_t CloseSession() override
+    {
+        return DCAMERA_OK;
+    }
+
+    int32_t CreateSession(std::vector<DCameraIndex>& camIndexs, std::string sessionFlag,
+        DCameraSessionMode sessionMode, std::shared_ptr<ICameraChannelListener>& listener) override
+    {
+        return DCAMERA_OK;
+    }
+
+    int32_t ReleaseSession() override
+    {
+        Unblock();
+        return DCAMERA_OK;
+    }
+
+    int32_t SendData(std::shared_ptr<DataBuffer>& buffer) override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entered_++;
+        cond_.notify_all();
+        cond_.wait(lock, [this] { return !blocked_; });
+        buffers_.push_back(buffer);
+        sent_++;
+        cond_.notify_all();
+        return DCAMERA_OK;
+    }
+
+    void Block()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        blocked_ = true;
+    }
+
+    void Unblock()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocked_ = false;
+        }
+        cond_.notify_all();
+    }
+
+    // Waits until the send strand has taken count buffers, a blocked channel holds the last one
+    bool WaitEntered(int32_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(TEST_WAIT_MS),
+            [this, count] { return entered_ >= count; });
+    }
+
+    bool WaitSent(int32_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(TEST_WAIT_MS),
+            [this, count] { return sent_.load() >= count; });
+    }
+
+    std::shared_ptr<DataBuffer> GetLastBuffer()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return buffers_.empty() ? nullptr : buffers_.back();
+    }
+
+    std::vector<std::shared_ptr<DataBuffer>> GetBuffers()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return buffers_;
+    }
+
+    std::atomic<int32_t> sent_ { 0 };
+
+private:
+    std::vector<std::shared_ptr<DataBuffer>> buffers_;
+    int32_t entered_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool blocked_ = false;
+};
+
+class TestChannelListener : public ICameraChannelListener {
+public:
+    void OnSessionState(int32_t state, std::string networkId) override {}
+    void OnSessionError(int32_t eventType, int32_t eventReason, std::string detail) override {}
+    void OnDataReceived(std::vector<std::shared_ptr<DataBuffer>>& buffers) override {}
+};
+
+std::shared_ptr<DataBuffer> MakeFrame(int32_t frameType)
+{
+    std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(1);
+    buffer->SetInt32(FRAME_TYPE, frameType);
+    return buffer;
+}
+
+std::shared_ptr<DataBuffer> MakeLayerFrame(int32_t frameType, int32_t layer)
+{
+    std::shared_ptr<DataBuffer> buffer = MakeFrame(frameType);
+    buffer->SetInt32(TEMPORAL_LAYER, layer);
+    return buffer;
+}
+}
+
+void DCameraChannelSinkFanoutTest::SetUpTestCase(void)
+{
+}
+
+void DCameraChannelSinkFanoutTest::TearDownTestCase(void)
+{
+}
+
+void DCameraChannelSinkFanoutTest::SetUp(void)
+{
+    fanout_ = std::make_shared<DCameraChannelSinkFanout>();
+}
+
+void DCameraChannelSinkFanoutTest::TearDown(void)
+{
+    fanout_ = nullptr;
+}
+
+/**
+ * @tc.name: dcamera_channel_sink_fanout_test_001
+ * @tc.desc: Verify a new subscriber requests and starts on a key frame.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelSinkFanoutTest, dcamera_channel_sink_fanout_test_001, TestSize.Level1)
+{
+    int32_t requests = 0;
+    fanout_->SetKeyFrameRequester([&requests]() {
+        requests++;
+        return DCAMERA_OK;
+    });
+    auto channel = std::make_shared<TestSubscriberChannel>();
+    EXPECT_EQ(DCAMERA_OK, fanout_->AddSubscriber(TEST_DEVICE_ID_1, channel));
+    EXPECT_EQ(1u, fanout_->GetSubscriberCount());
+
+    std::shared_ptr<DataBuffer> frame = MakeFrame(TEST_FRAME_TYPE_KEY);
+    EXPECT_EQ(DCAMERA_TRANS_BUSY, fanout_->SendData(frame));
+
+    fanout_->OnSubscriberState(TEST_DEVICE_ID_1, DCAMERA_CHANNEL_STATE_CONNECTED);
+    EXPECT_EQ(1, requests);
+    frame = MakeFrame(TEST_FRAME_TYPE_NONE);
+    EXPECT_EQ(DCAMERA_TRANS_BUSY, fanout_->SendData(frame));
+    frame = MakeFrame(TEST_FRAME_TYPE_KEY);
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(frame));
+    frame = MakeFrame(TEST_FRAME_TYPE_NONE);
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(frame));
+    EXPECT_TRUE(channel->WaitSent(2));
+    EXPECT_EQ(2, channel->sent_.load());
+}
+
+/**
+ * @tc.name: dcamera_channel_sink_fanout_test_002
+ * @tc.desc: Verify a slow subscriber drops to the next key frame without affecting the others.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelSinkFanoutTest, dcamera_channel_sink_fanout_test_002, TestSize.Level1)
+{
+    int32_t requests = 0;
+    fanout_->SetKeyFrameRequester([&requests]() {
+        requests++;
+        return DCAMERA_OK;
+    });
+    auto fast = std::make_shared<TestSubscriberChannel>();
+    auto slow = std::make_shared<TestSubscriberChannel>();
+    fanout_->AddSubscriber(TEST_DEVICE_ID_1, fast);
+    fanout_->AddSubscriber(TEST_DEVICE_ID_2, slow);
+    fanout_->OnSubscriberState(TEST_DEVICE_ID_1, DCAMERA_CHANNEL_STATE_CONNECTED);
+    fanout_->OnSubscriberState(TEST_DEVICE_ID_2, DCAMERA_CHANNEL_STATE_CONNECTED);
+    slow->Block();
+
+    std::shared_ptr<DataBuffer> key = MakeFrame(TEST_FRAME_TYPE_KEY);
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(key));
+    EXPECT_TRUE(slow->WaitEntered(1));
+    for (int32_t i = 0; i < TEST_FRAME_NUM; i++) {
+        EXPECT_TRUE(fast->WaitSent(i + 1));
+        std::shared_ptr<DataBuffer> frame = MakeFrame(TEST_FRAME_TYPE_NONE);
+        EXPECT_EQ(DCAMERA_OK, fanout_->SendData(frame));
+    }
+    EXPECT_TRUE(fast->WaitSent(TEST_FRAME_NUM + 1));
+    EXPECT_EQ(TEST_FRAME_NUM + 1, fast->sent_.load());
+    EXPECT_FALSE(fanout_->IsSendBusy());
+
+    slow->Unblock();
+    EXPECT_TRUE(slow->WaitSent(1));
+    EXPECT_EQ(1, slow->sent_.load());
+    // Overflow requests are rate limited, the one sent on connect is still pending
+    EXPECT_EQ(2, requests);
+
+    key = MakeFrame(TEST_FRAME_TYPE_KEY);
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(key));
+    EXPECT_TRUE(slow->WaitSent(2));
+    EXPECT_TRUE(fast->WaitSent(TEST_FRAME_NUM + 2));
+    EXPECT_EQ(key, slow->GetLastBuffer());
+    EXPECT_EQ(key, fast->GetLastBuffer());
+}
+
+/**
+ * @tc.name: dcamera_channel_sink_fanout_test_003
+ * @tc.desc: Verify the RemoveSubscriber and ReleaseSession function.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelSinkFanoutTest, dcamera_channel_sink_fanout_test_003, TestSize.Level1)
+{
+    auto channel1 = std::make_shared<TestSubscriberChannel>();
+    auto channel2 = std::make_shared<TestSubscriberChannel>();
+    fanout_->AddSubscriber(TEST_DEVICE_ID_1, channel1);
+    fanout_->AddSubscriber(TEST_DEVICE_ID_2, channel2);
+    EXPECT_EQ(2u, fanout_->GetSubscriberCount());
+
+    EXPECT_EQ(DCAMERA_OK, fanout_->RemoveSubscriber(TEST_DEVICE_ID_1));
+    EXPECT_EQ(DCAMERA_NOT_FOUND, fanout_->RemoveSubscriber(TEST_DEVICE_ID_1));
+    EXPECT_EQ(1u, fanout_->GetSubscriberCount());
+
+    EXPECT_EQ(DCAMERA_OK, fanout_->ReleaseSession());
+    EXPECT_EQ(0u, fanout_->GetSubscriberCount());
+}
+
+/**
+ * @tc.name: dcamera_channel_sink_fanout_test_004
+ * @tc.desc: Verify a slow subscriber sheds the enhancement layers before waiting for a key frame.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelSinkFanoutTest, dcamera_channel_sink_fanout_test_004, TestSize.Level1)
+{
+    int32_t requests = 0;
+    fanout_->SetKeyFrameRequester([&requests]() {
+        requests++;
+        return DCAMERA_OK;
+    });
+    auto channel = std::make_shared<TestSubscriberChannel>();
+    fanout_->AddSubscriber(TEST_DEVICE_ID_1, channel);
+    fanout_->OnSubscriberState(TEST_DEVICE_ID_1, DCAMERA_CHANNEL_STATE_CONNECTED);
+    channel->Block();
+
+    std::shared_ptr<DataBuffer> frame = MakeLayerFrame(TEST_FRAME_TYPE_KEY, 0);
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(frame));
+    EXPECT_TRUE(channel->WaitEntered(1));
+    for (int32_t i = 0; i < TEST_TEMPORAL_GOP_NUM; i++) {
+        for (int32_t layer : TEST_TEMPORAL_LAYERS) {
+            frame = MakeLayerFrame(TEST_FRAME_TYPE_NONE, layer);
+            fanout_->SendData(frame);
+        }
+    }
+    channel->Unblock();
+    EXPECT_TRUE(channel->WaitSent(1 + TEST_TEMPORAL_GOP_NUM));
+    // The key frame and one base layer frame of every temporal group
+    EXPECT_EQ(1 + TEST_TEMPORAL_GOP_NUM, channel->sent_.load());
+    EXPECT_EQ(frame, channel->GetLastBuffer());
+    EXPECT_EQ(1, requests);
+}
+
+/**
+ * @tc.name: dcamera_channel_sink_fanout_test_005
+ * @tc.desc: Verify a late subscriber gets the cached codec data right before its first key frame.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelSinkFanoutTest, dcamera_channel_sink_fanout_test_005, TestSize.Level1)
+{
+    auto first = std::make_shared<TestSubscriberChannel>();
+    fanout_->AddSubscriber(TEST_DEVICE_ID_1, first);
+    fanout_->OnSubscriberState(TEST_DEVICE_ID_1, DCAMERA_CHANNEL_STATE_CONNECTED);
+    std::shared_ptr<DataBuffer> codecData = MakeFrame(TEST_FRAME_TYPE_CODEC_DATA);
+    std::shared_ptr<DataBuffer> key = MakeFrame(TEST_FRAME_TYPE_KEY);
+    std::shared_ptr<DataBuffer> frame = MakeFrame(TEST_FRAME_TYPE_NONE);
+    // The codec data alone must not start a viewer that waits for a key frame
+    EXPECT_EQ(DCAMERA_TRANS_BUSY, fanout_->SendData(codecData));
+    EXPECT_EQ(DCAMERA_TRANS_BUSY, fanout_->SendData(frame));
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(key));
+    EXPECT_TRUE(first->WaitSent(2));
+
+    auto late = std::make_shared<TestSubscriberChannel>();
+    fanout_->AddSubscriber(TEST_DEVICE_ID_2, late);
+    fanout_->OnSubscriberState(TEST_DEVICE_ID_2, DCAMERA_CHANNEL_STATE_CONNECTED);
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(frame));
+    key = MakeFrame(TEST_FRAME_TYPE_KEY);
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(key));
+    EXPECT_TRUE(late->WaitSent(2));
+    std::vector<std::shared_ptr<DataBuffer>> buffers = late->GetBuffers();
+    ASSERT_EQ(2u, buffers.size());
+    EXPECT_EQ(codecData, buffers[0]);
+    EXPECT_EQ(key, buffers[1]);
+    EXPECT_TRUE(first->WaitSent(4));
+    EXPECT_EQ(codecData, first->GetBuffers()[0]);
+}
+
+/**
+ * @tc.name: dcamera_channel_sink_fanout_test_006
+ * @tc.desc: Verify the primary subscriber can only be released with the session.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelSinkFanoutTest, dcamera_channel_sink_fanout_test_006, TestSize.Level1)
+{
+    std::vector<DCameraIndex> camIndexs;
+    camIndexs.push_back(DCameraIndex(TEST_DEVICE_ID_1, TEST_CAMERA_DH_ID));
+    std::shared_ptr<ICameraChannelListener> listener = std::make_shared<TestChannelListener>();
+    EXPECT_EQ(DCAMERA_OK, fanout_->CreateSession(camIndexs, TEST_SESSION_FLAG, DCAMERA_SESSION_MODE_VIDEO, listener));
+    EXPECT_EQ(1u, fanout_->GetSubscriberCount());
+
+    EXPECT_EQ(DCAMERA_BAD_OPERATE, fanout_->RemoveSubscriber(TEST_DEVICE_ID_1));
+    auto channel = std::make_shared<TestSubscriberChannel>();
+    EXPECT_EQ(DCAMERA_BAD_OPERATE, fanout_->AddSubscriber(TEST_DEVICE_ID_1, channel));
+    EXPECT_EQ(DCAMERA_OK, fanout_->AddSubscriber(TEST_DEVICE_ID_2, channel));
+    EXPECT_EQ(DCAMERA_OK, fanout_->RemoveSubscriber(TEST_DEVICE_ID_2));
+    EXPECT_EQ(1u, fanout_->GetSubscriberCount());
+
+    EXPECT_EQ(DCAMERA_OK, fanout_->ReleaseSession());
+    EXPECT_EQ(0u, fanout_->GetSubscriberCount());
+}
+
+/**
+ * @tc.name: dcamera_channel_sink_fanout_test_007
+ * @tc.desc: Verify more viewers than executor workers all get every frame while one of them is blocked.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraChannelSinkFanoutTest, dcamera_channel_sink_fanout_test_007, TestSize.Level1)
+{
+    auto blocked = std::make_shared<TestSubscriberChannel>();
+    blocked->Block();
+    EXPECT_EQ(DCAMERA_OK, fanout_->AddSubscriber(TEST_DEVICE_ID_1, blocked));
+    fanout_->OnSubscriberState(TEST_DEVICE_ID_1, DCAMERA_CHANNEL_STATE_CONNECTED);
+    std::vector<std::shared_ptr<TestSubscriberChannel>> channels;
+    for (int32_t i = 0; i < TEST_MANY_SUBSCRIBER_NUM; i++) {
+        auto channel = std::make_shared<TestSubscriberChannel>();
+        std::string devId = TEST_DEVICE_ID_2 + std::to_string(i);
+        EXPECT_EQ(DCAMERA_OK, fanout_->AddSubscriber(devId, channel));
+        fanout_->OnSubscriberState(devId, DCAMERA_CHANNEL_STATE_CONNECTED);
+        channels.push_back(channel);
+    }
+    EXPECT_EQ(static_cast<size_t>(TEST_MANY_SUBSCRIBER_NUM + 1), fanout_->GetSubscriberCount());
+
+    std::shared_ptr<DataBuffer> key = MakeFrame(TEST_FRAME_TYPE_KEY);
+    EXPECT_EQ(DCAMERA_OK, fanout_->SendData(key));
+    EXPECT_TRUE(blocked->WaitEntered(1));
+    // Paced like a camera, every viewer that keeps up gets every frame
+    for (int32_t i = 1; i <= TEST_FRAME_NUM; i++) {
+        for (auto& channel : channels) {
+            ASSERT_TRUE(channel->WaitSent(i));
+        }
+        std::shared_ptr<DataBuffer> frame = MakeFrame(TEST_FRAME_TYPE_NONE);
+        EXPECT_EQ(DCAMERA_OK, fanout_->SendData(frame));
+    }
+    EXPECT_EQ(0, blocked->sent_.load());
+
+    blocked->Unblock();
+    EXPECT_EQ(DCAMERA_OK, fanout_->ReleaseSession());
+    EXPECT_EQ(0u, fanout_->GetSubscriberCount());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
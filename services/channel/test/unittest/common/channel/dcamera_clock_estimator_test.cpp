@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <random>
+
+#include "dcamera_clock_estimator.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraClockEstimatorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const int64_t TEST_START_US = 1790000000000000;
+const int64_t TEST_OFFSET_US = 123456;
+const double TEST_SKEW = 40e-6;
+const int64_t TEST_SKEW_PPB = 40000;
+const int64_t TEST_PING_INTERVAL_US = 1000000;
+const int64_t TEST_BASE_DELAY_US = 2000;
+const int64_t TEST_SINK_HOLD_US = 100;
+const int64_t TEST_COARSE_OFFSET_US = 120000;
+const int64_t TEST_MAX_ERROR_US = 300;
+
+// Remote clock runs TEST_SKEW faster and starts TEST_OFFSET_US ahead
+int64_t RemoteUs(int64_t localUs)
+{
+    return localUs + TEST_OFFSET_US + static_cast<int64_t>((localUs - TEST_START_US) * TEST_SKEW);
+}
+
+int64_t TrueOffsetUs(int64_t localUs)
+{
+    return RemoteUs(localUs) - localUs;
+}
+
+// Pings over a link whose queueing delay is heavier upstream than downstream
+void RunPings(DCameraClockEstimator& estimator, int64_t startUs, int32_t pingNum)
+{
+    std::mt19937 gen(20260101);
+    std::exponential_distribution<double> upJitter(1.0 / 3000);
+    std::exponential_distribution<double> downJitter(1.0 / 800);
+    int64_t localUs = startUs;
+    for (int32_t i = 0; i < pingNum; i++) {
+        int64_t t1 = localUs;
+        int64_t arriveUs = t1 + TEST_BASE_DELAY_US + static_cast<int64_t>(upJitter(gen));
+        int64_t leaveUs = arriveUs + TEST_SINK_HOLD_US;
+        int64_t t4 = leaveUs + TEST_BASE_DELAY_US + static_cast<int64_t>(downJitter(gen));
+        estimator.AddSample(t1, RemoteUs(arriveUs), RemoteUs(leaveUs), t4);
+        localUs += TEST_PING_INTERVAL_US;
+    }
+}
+}
+
+void DCameraClockEstimatorTest::SetUpTestCase(void)
+{
+}
+
+void DCameraClockEstimatorTest::TearDownTestCase(void)
+{
+}
+
+void DCameraClockEstimatorTest::SetUp(void)
+{
+}
+
+void DCameraClockEstimatorTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: dcamera_clock_estimator_test_001
+ * @tc.desc: Verify the coarse offset is used until the first ping returns.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraClockEstimatorTest, dcamera_clock_estimator_test_001, TestSize.Level1)
+{
+    DCameraClockEstimator estimator;
+    estimator.SetCoarseOffsetUs(TEST_COARSE_OFFSET_US);
+    EXPECT_FALSE(estimator.IsSynced());
+    EXPECT_EQ(TEST_COARSE_OFFSET_US, estimator.GetOffsetUs(TEST_START_US));
+
+    RunPings(estimator, TEST_START_US, 1);
+    EXPECT_TRUE(estimator.IsSynced());
+    EXPECT_LT(std::abs(estimator.GetOffsetUs(TEST_START_US) - TrueOffsetUs(TEST_START_US)), TEST_MAX_ERROR_US * 10);
+
+    estimator.Reset();
+    EXPECT_FALSE(estimator.IsSynced());
+    EXPECT_EQ(TEST_COARSE_OFFSET_US, estimator.GetOffsetUs(TEST_START_US));
+}
+
+/**
+ * @tc.name: dcamera_clock_estimator_test_002
+ * @tc.desc: Verify offset and skew converge under asymmetric jitter and drift over hours.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraClockEstimatorTest, dcamera_clock_estimator_test_002, TestSize.Level1)
+{
+    DCameraClockEstimator estimator;
+    const int32_t pingNum = 3 * 3600;
+    RunPings(estimator, TEST_START_US, pingNum);
+    EXPECT_TRUE(estimator.IsSynced());
+    EXPECT_LT(std::abs(estimator.GetSkewPpb() - TEST_SKEW_PPB), TEST_SKEW_PPB / 10);
+    EXPECT_GE(estimator.GetMinRttUs(), TEST_BASE_DELAY_US * 2);
+
+    int64_t endUs = TEST_START_US + pingNum * TEST_PING_INTERVAL_US;
+    for (int64_t localUs = endUs; localUs < endUs + 10 * TEST_PING_INTERVAL_US; localUs += TEST_PING_INTERVAL_US) {
+        EXPECT_LT(std::abs(estimator.GetOffsetUs(localUs) - TrueOffsetUs(localUs)), TEST_MAX_ERROR_US);
+    }
+}
+
+/**
+ * @tc.name: dcamera_clock_estimator_test_003
+ * @tc.desc: Verify samples with impossible timestamps are dropped.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DCameraClockEstimatorTest, dcamera_clock_estimator_test_003, TestSize.Level1)
+{
+    DCameraClockEstimator estimator;
+    estimator.AddSample(TEST_START_US, TEST_START_US + 10, TEST_START_US + 20, TEST_START_US - 1);
+    estimator.AddSample(TEST_START_US, TEST_START_US + 20, TEST_START_US + 10, TEST_START_US + 100);
+    estimator.AddSample(TEST_START_US, TEST_START_US, TEST_START_US, TEST_START_US + 2000000);
+    EXPECT_FALSE(estimator.IsSynced());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
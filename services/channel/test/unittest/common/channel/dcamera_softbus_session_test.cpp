@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cinttypes>
 #include <securec.h>
 #define private public
 #include "dcamera_softbus_session.h"
@@ -24,14 +25,19 @@
 #include "dcamera_softbus_adapter.h"
 #include "dcamera_sink_output.h"
 #include "dcamera_sink_output_channel_listener.h"
+#include "dcamera_utils_tools.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
 #include "icamera_channel.h"
 #include "mock_camera_operator.h"
 #include "session_bus_center.h"
 
 using namespace testing::ext;
 
+extern bool g_recordSentBytes;
+extern std::vector<std::vector<uint8_t>> g_sentBytes;
+
 namespace OHOS {
 namespace DistributedHardware {
 class DCameraSoftbusSessionTest : public testing::Test {
@@ -52,6 +58,56 @@ const std::string TEST_MYDEVICE_ID = "bb536a637105409e904d4da83790a4a7";
 const std::string TEST_PEERDEVICE_ID = "bb536a637105409e904d4da83790a4a9";
 const std::string TEST_CAMERA_DH_ID_0 = "camera_0";
 const int32_t TEST_SLEEP_SEC = 200000;
+const uint32_t TEST_PAYLOAD_LEN = 2 * 1024 * 1024 + 123;
+const uint32_t TEST_MAX_NACK_ROUNDS = 16;
+const uint32_t TEST_LOSS_PERCENT[] = { 0, 5, 20 };
+const uint32_t TEST_PERCENT = 100;
+const uint32_t TEST_PHOTO_LEN = 12 * 1024 * 1024 + 45;
+
+class TestRecvListener : public ICameraChannelListener {
+public:
+    void OnSessionState(int32_t state, std::string networkId) override
+    {
+    }
+
+    void OnSessionError(int32_t eventType, int32_t eventReason, std::string detail) override
+    {
+    }
+
+    void OnDataReceived(std::vector<std::shared_ptr<DataBuffer>>& buffers) override
+    {
+        received_.insert(received_.end(), buffers.begin(), buffers.end());
+    }
+
+    std::vector<std::shared_ptr<DataBuffer>> received_;
+};
+
+std::shared_ptr<DataBuffer> MakePayload(uint32_t len)
+{
+    std::shared_ptr<DataBuffer> payload = std::make_shared<DataBuffer>(len);
+    for (uint32_t i = 0; i < len; i++) {
+        payload->Data()[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    return payload;
+}
+
+std::vector<std::shared_ptr<DataBuffer>> TakeSentBytes()
+{
+    std::vector<std::shared_ptr<DataBuffer>> packets;
+    for (const auto& bytes : g_sentBytes) {
+        std::shared_ptr<DataBuffer> packet = std::make_shared<DataBuffer>(bytes.size());
+        if (memcpy_s(packet->Data(), packet->Size(), bytes.data(), bytes.size()) == EOK) {
+            packets.push_back(packet);
+        }
+    }
+    g_sentBytes.clear();
+    return packets;
+}
+
+bool IsSamePayload(const std::shared_ptr<DataBuffer>& lhs, const std::shared_ptr<DataBuffer>& rhs)
+{
+    return lhs->Size() == rhs->Size() && memcmp(lhs->Data(), rhs->Data(), lhs->Size()) == 0;
+}
 }
 
 void DCameraSoftbusSessionTest::SetUpTestCase(void)
@@ -660,5 +716,200 @@ HWTEST_F(DCameraSoftbusSessionTest, dcamera_softbus_session_test_029, TestSize.L
     EXPECT_EQ(DCAMERA_OK, ret);
 }
 
+/**
+ * @tc.name: dcamera_softbus_session_test_030
+ * @tc.desc: Verify fragments arriving out of order after a retransmission are assembled.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSoftbusSessionTest, dcamera_softbus_session_test_030, TestSize.Level1)
+{
+    auto recvListener = std::make_shared<TestRecvListener>();
+    auto sender = std::make_shared<DCameraSoftbusSession>("dhId", TEST_MYDEVICE_ID, "testsender",
+        TEST_PEERDEVICE_ID, "testreceiver", listener_, DCAMERA_SESSION_MODE_JPEG);
+    auto receiver = std::make_shared<DCameraSoftbusSession>("dhId", TEST_PEERDEVICE_ID, "testreceiver",
+        TEST_MYDEVICE_ID, "testsender", recvListener, DCAMERA_SESSION_MODE_JPEG);
+    receiver->eventHandler_ = nullptr;
+    std::shared_ptr<DataBuffer> payload = MakePayload(TEST_PAYLOAD_LEN);
+    uint32_t fragLen = sender->packetMaxLen_ - DCameraSoftbusSession::BINARY_DATA_PACKET_RESERVED_BUFFER;
+    uint32_t seq = 1;
+    sender->CacheSendData(seq, payload, fragLen);
+    uint32_t fragNum = receiver->GetFragNum(TEST_PAYLOAD_LEN, fragLen);
+
+    std::shared_ptr<DataBuffer> fragData = nullptr;
+    for (uint32_t subSeq = 0; subSeq < fragNum; subSeq++) {
+        if (subSeq == 1) {
+            continue;
+        }
+        EXPECT_EQ(DCAMERA_OK, sender->RetransmitFrag(seq, subSeq, fragData));
+        receiver->PackRecvData(fragData);
+    }
+    EXPECT_TRUE(recvListener->received_.empty());
+    std::vector<uint16_t> missing;
+    receiver->GetMissingSubSeqs(receiver->reassemblies_[seq], true, missing);
+    ASSERT_EQ(1u, missing.size());
+    EXPECT_EQ(1u, missing[0]);
+
+    EXPECT_EQ(DCAMERA_OK, sender->RetransmitFrag(seq, missing[0], fragData));
+    receiver->PackRecvData(fragData);
+    ASSERT_EQ(1u, recvListener->received_.size());
+    EXPECT_TRUE(IsSamePayload(payload, recvListener->received_[0]));
+    EXPECT_TRUE(receiver->reassemblies_.empty());
+
+    // A late duplicate of a finished payload is dropped
+    receiver->PackRecvData(fragData);
+    EXPECT_TRUE(receiver->reassemblies_.empty());
+    EXPECT_EQ(DCAMERA_NOT_FOUND, sender->RetransmitFrag(seq + 1, 0, fragData));
+}
+
+/**
+ * @tc.name: dcamera_softbus_session_test_031
+ * @tc.desc: Verify the goodput of a fragmented payload under loss with NACK retransmission.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSoftbusSessionTest, dcamera_softbus_session_test_031, TestSize.Level1)
+{
+    for (uint32_t lossPercent : TEST_LOSS_PERCENT) {
+        auto recvListener = std::make_shared<TestRecvListener>();
+        auto sender = std::make_shared<DCameraSoftbusSession>("dhId", TEST_MYDEVICE_ID, "testsender",
+            TEST_PEERDEVICE_ID, "testreceiver", listener_, DCAMERA_SESSION_MODE_JPEG);
+        auto receiver = std::make_shared<DCameraSoftbusSession>("dhId", TEST_PEERDEVICE_ID, "testreceiver",
+            TEST_MYDEVICE_ID, "testsender", recvListener, DCAMERA_SESSION_MODE_JPEG);
+        receiver->eventHandler_ = nullptr;
+        std::shared_ptr<DataBuffer> payload = MakePayload(TEST_PAYLOAD_LEN);
+        uint32_t fragLen = sender->packetMaxLen_ - DCameraSoftbusSession::BINARY_DATA_PACKET_RESERVED_BUFFER;
+        uint32_t seq = 0;
+        sender->CacheSendData(seq, payload, fragLen);
+
+        std::vector<uint16_t> toSend;
+        for (uint32_t subSeq = 0; subSeq < receiver->GetFragNum(TEST_PAYLOAD_LEN, fragLen); subSeq++) {
+            toSend.push_back(static_cast<uint16_t>(subSeq));
+        }
+        uint64_t sentBytes = 0;
+        uint32_t rounds = 0;
+        uint32_t lossSeed = 1;
+        std::shared_ptr<DataBuffer> fragData = nullptr;
+        while (!toSend.empty() && rounds < TEST_MAX_NACK_ROUNDS) {
+            for (uint16_t subSeq : toSend) {
+                ASSERT_EQ(DCAMERA_OK, sender->RetransmitFrag(seq, subSeq, fragData));
+                sentBytes += fragData->Size();
+                lossSeed = lossSeed * 1103515245 + 12345;
+                if ((lossSeed >> 16) % TEST_PERCENT < lossPercent) {
+                    continue;
+                }
+                receiver->PackRecvData(fragData);
+            }
+            toSend.clear();
+            auto iter = receiver->reassemblies_.find(seq);
+            if (iter != receiver->reassemblies_.end()) {
+                receiver->GetMissingSubSeqs(iter->second, true, toSend);
+            }
+            rounds++;
+        }
+        ASSERT_EQ(1u, recvListener->received_.size());
+        EXPECT_TRUE(IsSamePayload(payload, recvListener->received_[0]));
+        uint64_t goodputPercent = static_cast<uint64_t>(TEST_PAYLOAD_LEN) * TEST_PERCENT / sentBytes;
+        DHLOGI("loss %{public}u%%, rounds %{public}u, goodput %{public}" PRIu64 "%%", lossPercent, rounds,
+            goodputPercent);
+        // Only the lost fragments are sent again, not the whole payload
+        EXPECT_GE(goodputPercent + lossPercent * 2, TEST_PERCENT - 1);
+    }
+}
+
+/**
+ * @tc.name: dcamera_softbus_session_test_032
+ * @tc.desc: Verify a NACK sent by the receiver brings the lost fragments back over the wire.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSoftbusSessionTest, dcamera_softbus_session_test_032, TestSize.Level1)
+{
+    auto recvListener = std::make_shared<TestRecvListener>();
+    auto sender = std::make_shared<DCameraSoftbusSession>("dhId", TEST_MYDEVICE_ID, "testsender",
+        TEST_PEERDEVICE_ID, "testreceiver", listener_, DCAMERA_SESSION_MODE_JPEG);
+    auto receiver = std::make_shared<DCameraSoftbusSession>("dhId", TEST_PEERDEVICE_ID, "testreceiver",
+        TEST_MYDEVICE_ID, "testsender", recvListener, DCAMERA_SESSION_MODE_JPEG);
+    receiver->eventHandler_ = nullptr;
+    sender->state_ = DCAMERA_SOFTBUS_STATE_OPENED;
+    receiver->state_ = DCAMERA_SOFTBUS_STATE_OPENED;
+    std::shared_ptr<DataBuffer> payload = MakePayload(TEST_PAYLOAD_LEN);
+    uint32_t fragLen = sender->packetMaxLen_ - DCameraSoftbusSession::BINARY_DATA_PACKET_RESERVED_BUFFER;
+    uint32_t seq = 1;
+    sender->CacheSendData(seq, payload, fragLen);
+    uint32_t fragNum = receiver->GetFragNum(TEST_PAYLOAD_LEN, fragLen);
+    ASSERT_GT(fragNum, 3u);
+
+    g_sentBytes.clear();
+    g_recordSentBytes = true;
+    std::shared_ptr<DataBuffer> fragData = nullptr;
+    for (uint32_t subSeq = 0; subSeq < fragNum; subSeq++) {
+        EXPECT_EQ(DCAMERA_OK, sender->RetransmitFrag(seq, subSeq, fragData));
+        if (subSeq == 1 || subSeq == 2) {
+            continue;
+        }
+        receiver->PackRecvData(fragData);
+    }
+    // The jump from 0 to 3 makes the receiver ask for 1 and 2
+    std::vector<std::shared_ptr<DataBuffer>> nacks = TakeSentBytes();
+    ASSERT_EQ(1u, nacks.size());
+    EXPECT_TRUE(recvListener->received_.empty());
+
+    sender->PackRecvData(nacks[0]);
+    std::vector<std::shared_ptr<DataBuffer>> frags = TakeSentBytes();
+    g_recordSentBytes = false;
+    ASSERT_EQ(2u, frags.size());
+    for (auto& frag : frags) {
+        receiver->PackRecvData(frag);
+    }
+    ASSERT_EQ(1u, recvListener->received_.size());
+    EXPECT_TRUE(IsSamePayload(payload, recvListener->received_[0]));
+    EXPECT_TRUE(receiver->reassemblies_.empty());
 }
-}
\ No newline at end of file
+
+/**
+ * @tc.name: dcamera_softbus_session_test_033
+ * @tc.desc: Verify a photo sent as lent fragment slices arrives intact and leaves the payload untouched.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraSoftbusSessionTest, dcamera_softbus_session_test_033, TestSize.Level1)
+{
+    auto recvListener = std::make_shared<TestRecvListener>();
+    auto sender = std::make_shared<DCameraSoftbusSession>("dhId", TEST_MYDEVICE_ID, "testsender",
+        TEST_PEERDEVICE_ID, "testreceiver", listener_, DCAMERA_SESSION_MODE_JPEG);
+    auto receiver = std::make_shared<DCameraSoftbusSession>("dhId", TEST_PEERDEVICE_ID, "testreceiver",
+        TEST_MYDEVICE_ID, "testsender", recvListener, DCAMERA_SESSION_MODE_JPEG);
+    sender->eventHandler_ = nullptr;
+    receiver->eventHandler_ = nullptr;
+    sender->state_ = DCAMERA_SOFTBUS_STATE_OPENED;
+    // Pacing off, so the time below is what packing the fragments costs
+    sender->sendBytesPerSecond_ = 0;
+    std::shared_ptr<DataBuffer> payload = MakePayload(TEST_PHOTO_LEN);
+    std::shared_ptr<DataBuffer> expected = MakePayload(TEST_PHOTO_LEN);
+
+    g_sentBytes.clear();
+    g_recordSentBytes = true;
+    int64_t startUs = GetNowTimeStampUs();
+    EXPECT_EQ(DCAMERA_OK, sender->UnPackSendData(payload, sender->sendFuncMap_[DCAMERA_SESSION_MODE_JPEG]));
+    int64_t sendUs = GetNowTimeStampUs() - startUs;
+    std::vector<std::shared_ptr<DataBuffer>> frags = TakeSentBytes();
+    g_recordSentBytes = false;
+    DHLOGI("photo of %{public}u bytes sent in %{public}zu fragments took %{public}" PRId64 " us", TEST_PHOTO_LEN,
+        frags.size(), sendUs);
+    EXPECT_TRUE(IsSamePayload(expected, payload));
+
+    ASSERT_GT(frags.size(), 1u);
+    for (auto& frag : frags) {
+        receiver->PackRecvData(frag);
+    }
+    ASSERT_EQ(1u, recvListener->received_.size());
+    EXPECT_TRUE(IsSamePayload(expected, recvListener->received_[0]));
+
+    // A retransmission copies out of the same payload and must not see a lent header either
+    std::shared_ptr<DataBuffer> fragData = nullptr;
+    EXPECT_EQ(DCAMERA_OK, sender->RetransmitFrag(0, 1, fragData));
+    EXPECT_EQ(0, memcmp(frags[1]->Data(), fragData->Data(), fragData->Size()));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "dcamera_network_emulator.h"
+#include "dcamera_stream_fec.h"
+
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraStreamFecTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const size_t TEST_SHARD_LEN = 100;
+const size_t TEST_FRAME_LEN = 10000;
+const int32_t TEST_FRAME_NUM = 300;
+const uint32_t TEST_LOSS_PERMILLE = 50;
+const int64_t TEST_REPORT_INTERVAL_US = 1000000;
+
+std::vector<uint8_t> MakeData(size_t len, uint32_t salt)
+{
+    std::vector<uint8_t> data(len);
+    for (size_t i = 0; i < len; i++) {
+        data[i] = static_cast<uint8_t>((i * 31 + salt * 17 + (i >> 8)) & 0xff);
+    }
+    return data;
+}
+
+std::vector<std::vector<uint8_t>> EncodeShards(uint32_t dataNum, uint32_t parityNum)
+{
+    std::vector<std::vector<uint8_t>> shards;
+    std::vector<const uint8_t *> data;
+    for (uint32_t i = 0; i < dataNum; i++) {
+        shards.push_back(MakeData(TEST_SHARD_LEN, i));
+    }
+    for (uint32_t i = 0; i < dataNum; i++) {
+        data.push_back(shards[i].data());
+    }
+    std::vector<std::vector<uint8_t>> parity(parityNum);
+    EXPECT_EQ(DCAMERA_OK, DCameraFecCodec::Encode(data, TEST_SHARD_LEN, parity));
+    shards.insert(shards.end(), parity.begin(), parity.end());
+    return shards;
+}
+
+std::vector<std::shared_ptr<DataBuffer>> SplitFrame(const std::vector<uint8_t>& frame, int32_t seq,
+    uint32_t dataNum, uint32_t parityNum)
+{
+    std::vector<std::vector<uint8_t>> parity;
+    EXPECT_EQ(DCAMERA_OK, DCameraStreamFecEncoder::Encode(frame.data(), frame.size(), dataNum, parityNum, parity));
+    size_t shardLen = DCameraStreamFecEncoder::GetShardLen(frame.size(), dataNum);
+    std::vector<std::shared_ptr<DataBuffer>> shards;
+    for (uint32_t i = 0; i < dataNum + parityNum; i++) {
+        const uint8_t *src = (i < dataNum) ? frame.data() + i * shardLen : parity[i - dataNum].data();
+        size_t len = (i < dataNum) ? std::min(shardLen, frame.size() - i * shardLen) : shardLen;
+        auto shard = std::make_shared<DataBuffer>(len);
+        std::copy(src, src + len, shard->Data());
+        shard->frameInfo_.seq = seq;
+        shard->frameInfo_.fecIndex = static_cast<int32_t>(i);
+        shard->frameInfo_.fecDataNum = static_cast<int32_t>(dataNum);
+        shard->frameInfo_.fecParityNum = static_cast<int32_t>(parityNum);
+        shard->frameInfo_.fecLen = static_cast<int32_t>(frame.size());
+        shards.push_back(shard);
+    }
+    return shards;
+}
+
+bool IsSameFrame(const std::shared_ptr<DataBuffer>& buffer, const std::vector<uint8_t>& frame)
+{
+    return buffer != nullptr && buffer->Size() == frame.size() &&
+        std::equal(frame.begin(), frame.end(), buffer->Data());
+}
+}
+
+void DCameraStreamFecTest::SetUpTestCase(void)
+{
+}
+
+void DCameraStreamFecTest::TearDownTestCase(void)
+{
+}
+
+void DCameraStreamFecTest::SetUp(void)
+{
+}
+
+void DCameraStreamFecTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: dcamera_stream_fec_test_001
+ * @tc.desc: Verify a single XOR parity shard rebuilds any one lost data shard.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraStreamFecTest, dcamera_stream_fec_test_001, TestSize.Level1)
+{
+    const uint32_t dataNum = 4;
+    std::vector<std::vector<uint8_t>> origin = EncodeShards(dataNum, 1);
+    for (uint32_t lost = 0; lost < dataNum; lost++) {
+        std::vector<std::vector<uint8_t>> shards = origin;
+        std::vector<bool> present(dataNum + 1, true);
+        shards[lost].clear();
+        present[lost] = false;
+        EXPECT_EQ(DCAMERA_OK, DCameraFecCodec::Reconstruct(shards, present, dataNum, TEST_SHARD_LEN));
+        EXPECT_EQ(origin[lost], shards[lost]);
+    }
+}
+
+/**
+ * @tc.name: dcamera_stream_fec_test_002
+ * @tc.desc: Verify Reed-Solomon parity rebuilds the data from any k shards and fails below k.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraStreamFecTest, dcamera_stream_fec_test_002, TestSize.Level1)
+{
+    const uint32_t dataNum = 8;
+    const uint32_t parityNum = 4;
+    std::vector<std::vector<uint8_t>> origin = EncodeShards(dataNum, parityNum);
+    const std::vector<std::vector<uint32_t>> lostSets = { { 0, 1, 2, 3 }, { 7, 8, 9, 10 }, { 1, 4, 6, 11 },
+        { 2, 5 }, { 3 } };
+    for (const auto& lostSet : lostSets) {
+        std::vector<std::vector<uint8_t>> shards = origin;
+        std::vector<bool> present(dataNum + parityNum, true);
+        for (uint32_t lost : lostSet) {
+            shards[lost].clear();
+            present[lost] = false;
+        }
+        EXPECT_EQ(DCAMERA_OK, DCameraFecCodec::Reconstruct(shards, present, dataNum, TEST_SHARD_LEN));
+        for (uint32_t i = 0; i < dataNum; i++) {
+            EXPECT_EQ(origin[i], shards[i]);
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> shards = origin;
+    std::vector<bool> present(dataNum + parityNum, true);
+    for (uint32_t i = 0; i <= parityNum; i++) {
+        present[i] = false;
+    }
+    EXPECT_NE(DCAMERA_OK, DCameraFecCodec::Reconstruct(shards, present, dataNum, TEST_SHARD_LEN));
+}
+
+/**
+ * @tc.name: dcamera_stream_fec_test_003
+ * @tc.desc: Verify the redundancy follows the reported loss and FEC stays off without reports.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraStreamFecTest, dcamera_stream_fec_test_003, TestSize.Level1)
+{
+    DCameraStreamFecEncoder encoder;
+    uint32_t dataNum = 0;
+    uint32_t parityNum = 0;
+    EXPECT_FALSE(encoder.GetScheme(TEST_FRAME_LEN, dataNum, parityNum));
+
+    encoder.UpdateLoss(10);
+    EXPECT_TRUE(encoder.GetScheme(TEST_FRAME_LEN, dataNum, parityNum));
+    EXPECT_EQ(8u, dataNum);
+    EXPECT_EQ(1u, parityNum);
+    EXPECT_TRUE(encoder.GetScheme(TEST_SHARD_LEN, dataNum, parityNum));
+    EXPECT_EQ(1u, dataNum);
+    EXPECT_EQ(1u, parityNum);
+
+    encoder.UpdateLoss(100);
+    EXPECT_TRUE(encoder.GetScheme(TEST_FRAME_LEN, dataNum, parityNum));
+    EXPECT_EQ(3u, parityNum);
+    // A calm report lowers the redundancy step by step
+    encoder.UpdateLoss(0);
+    EXPECT_TRUE(encoder.GetScheme(TEST_FRAME_LEN, dataNum, parityNum));
+    EXPECT_EQ(2u, parityNum);
+    for (int32_t i = 0; i < 20; i++) {
+        encoder.UpdateLoss(0);
+    }
+    EXPECT_FALSE(encoder.GetScheme(TEST_FRAME_LEN, dataNum, parityNum));
+}
+
+/**
+ * @tc.name: dcamera_stream_fec_test_004
+ * @tc.desc: Verify the decoder rebuilds out of order shards and passes frames without FEC through.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraStreamFecTest, dcamera_stream_fec_test_004, TestSize.Level1)
+{
+    DCameraStreamFecDecoder decoder;
+    std::vector<uint8_t> frame = MakeData(TEST_FRAME_LEN + 1, 0);
+    std::vector<std::shared_ptr<DataBuffer>> shards = SplitFrame(frame, 0, 4, 2);
+    std::shared_ptr<DataBuffer> out = nullptr;
+    EXPECT_FALSE(decoder.Feed(shards[5], out));
+    EXPECT_FALSE(decoder.Feed(shards[3], out));
+    EXPECT_FALSE(decoder.Feed(shards[0], out));
+    EXPECT_TRUE(decoder.Feed(shards[4], out));
+    EXPECT_TRUE(IsSameFrame(out, frame));
+    EXPECT_EQ(0, out->frameInfo_.seq);
+    EXPECT_FALSE(decoder.Feed(shards[1], out));
+    EXPECT_EQ(1u, decoder.GetRecoveredNum());
+
+    auto plain = std::make_shared<DataBuffer>(TEST_SHARD_LEN);
+    plain->frameInfo_.seq = 1;
+    EXPECT_TRUE(decoder.Feed(plain, out));
+    EXPECT_EQ(plain, out);
+
+    // A late shard of a delivered frame is not delivered again
+    EXPECT_FALSE(decoder.Feed(shards[2], out));
+    auto invalid = SplitFrame(frame, 2, 4, 2)[0];
+    invalid->frameInfo_.fecIndex = 6;
+    EXPECT_FALSE(decoder.Feed(invalid, out));
+}
+
+/**
+ * @tc.name: dcamera_stream_fec_test_005
+ * @tc.desc: Verify frames are recovered from shards dropped by a bursty Gilbert-Elliott link.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraStreamFecTest, dcamera_stream_fec_test_005, TestSize.Level1)
+{
+    NetworkEmulationProfile profile;
+    profile.enabled = true;
+    profile.goodToBadProbability = 0.02f;
+    profile.badToGoodProbability = 0.5f;
+    profile.goodLossProbability = 0.01f;
+    profile.badLossProbability = 0.5f;
+    DCameraNetworkEmulator emulator;
+    emulator.SetProfile(profile);
+
+    DCameraStreamFecEncoder encoder;
+    encoder.UpdateLoss(TEST_LOSS_PERMILLE);
+    DCameraStreamFecDecoder decoder;
+    int64_t nowUs = TEST_REPORT_INTERVAL_US;
+    uint32_t lossPermille = 0;
+    EXPECT_FALSE(decoder.PollLossReport(nowUs, lossPermille));
+    int32_t completeNum = 0;
+    int32_t decodedNum = 0;
+    for (int32_t seq = 0; seq < TEST_FRAME_NUM; seq++) {
+        std::vector<uint8_t> frame = MakeData(TEST_FRAME_LEN, static_cast<uint32_t>(seq));
+        uint32_t dataNum = 0;
+        uint32_t parityNum = 0;
+        ASSERT_TRUE(encoder.GetScheme(frame.size(), dataNum, parityNum));
+        bool isComplete = true;
+        for (const auto& shard : SplitFrame(frame, seq, dataNum, parityNum)) {
+            PacketFate fate = PacketFate::DELIVERED;
+            ASSERT_TRUE(emulator.Submit(static_cast<uint32_t>(shard->Size()), []() {}, fate));
+            bool isLost = fate == PacketFate::LOST || fate == PacketFate::QUEUE_DROPPED;
+            isComplete = isComplete && (isLost ? shard->frameInfo_.fecIndex >= static_cast<int32_t>(dataNum) : true);
+            std::shared_ptr<DataBuffer> out = nullptr;
+            if (!isLost && decoder.Feed(shard, out)) {
+                EXPECT_TRUE(IsSameFrame(out, frame));
+                decodedNum++;
+            }
+        }
+        completeNum += isComplete ? 1 : 0;
+    }
+    emulator.Stop();
+    EXPECT_GT(decodedNum, completeNum);
+    EXPECT_GT(decoder.GetRecoveredNum(), 0u);
+    EXPECT_GE(decodedNum, TEST_FRAME_NUM * 9 / 10);
+    EXPECT_TRUE(decoder.PollLossReport(nowUs + TEST_REPORT_INTERVAL_US, lossPermille));
+    EXPECT_GT(lossPermille, 0u);
+}
+
+/**
+ * @tc.name: dcamera_stream_fec_test_006
+ * @tc.desc: Verify the loss report counts whole missing frames and round trips through json.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraStreamFecTest, dcamera_stream_fec_test_006, TestSize.Level1)
+{
+    DCameraStreamFecDecoder decoder;
+    std::shared_ptr<DataBuffer> out = nullptr;
+    uint32_t lossPermille = 0;
+    EXPECT_FALSE(decoder.PollLossReport(TEST_REPORT_INTERVAL_US, lossPermille));
+    for (int32_t seq : { 0, 1, 3, 4, 5, 6, 7, 8, 9, 10 }) {
+        auto buffer = std::make_shared<DataBuffer>(TEST_SHARD_LEN);
+        buffer->frameInfo_.seq = seq;
+        EXPECT_TRUE(decoder.Feed(buffer, out));
+    }
+    EXPECT_FALSE(decoder.PollLossReport(TEST_REPORT_INTERVAL_US + 1, lossPermille));
+    EXPECT_TRUE(decoder.PollLossReport(TEST_REPORT_INTERVAL_US * 2, lossPermille));
+    EXPECT_EQ(1000u / 11, lossPermille);
+
+    std::string jsonStr = DCameraStreamFecDecoder::MarshalLossReport(lossPermille);
+    uint32_t parsed = 0;
+    EXPECT_TRUE(DCameraStreamFecDecoder::UnmarshalLossReport(jsonStr, parsed));
+    EXPECT_EQ(lossPermille, parsed);
+    EXPECT_FALSE(DCameraStreamFecDecoder::UnmarshalLossReport("{\"type\":0}", parsed));
+    EXPECT_FALSE(DCameraStreamFecDecoder::UnmarshalLossReport("fecLoss", parsed));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+#include "posix_socket_adapter.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class PosixSocketAdapterTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_SESSION_NAME = "ohos.dhardware.dcamera_camera_0_test";
+// Both hash to the port of TEST_SESSION_NAME plus 0 and 1 with the default port range
+const std::string TEST_COLLIDE_SESSION_NAME = "ohos.dhardware.dcamera_camera_215_test";
+const std::string TEST_NEXT_SESSION_NAME = "ohos.dhardware.dcamera_camera_36_test";
+const std::string TEST_SINK_NETWORK_ID = "sinkNetworkId";
+const std::string TEST_SOURCE_NETWORK_ID = "sourceNetworkId";
+const uint16_t TEST_BASE_PORT = 52000;
+const size_t TEST_LARGE_LEN = 8 * 1024 * 1024;
+const size_t TEST_STREAM_LEN = 1024 * 1024;
+const int32_t TEST_STREAM_NUM = 40;
+const int32_t TEST_SOCKET_BUF_SIZE = 64 * 1024;
+const std::chrono::seconds TEST_WAIT_TIME = std::chrono::seconds(5);
+const size_t TEST_BENCH_FRAME_LEN = 1024 * 1024;
+const int32_t TEST_BENCH_FRAME_NUM = 256;
+const size_t TEST_BENCH_MESSAGE_LEN = 64;
+const int32_t TEST_BENCH_MESSAGE_NUM = 2000;
+const uint64_t TEST_US_PER_SECOND = 1000000;
+const uint64_t TEST_BYTES_PER_MB = 1024 * 1024;
+const uint32_t TEST_PERCENT = 100;
+const uint32_t TEST_P99 = 99;
+
+class TestChannelListener : public ICameraChannelListener {
+public:
+    void OnSessionState(int32_t state, std::string networkId) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        states_.push_back(state);
+        networkId_ = networkId;
+        cond_.notify_all();
+    }
+
+    void OnSessionError(int32_t eventType, int32_t eventReason, std::string detail) override
+    {
+    }
+
+    void OnDataReceived(std::vector<std::shared_ptr<DataBuffer>>& buffers) override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]() { return !isBlocked_; });
+        for (auto& buffer : buffers) {
+            receivedNum_++;
+            if (isKeeping_) {
+                buffers_.push_back(buffer);
+            }
+        }
+        cond_.notify_all();
+    }
+
+    bool WaitState(int32_t state)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, TEST_WAIT_TIME, [this, state]() {
+            return std::find(states_.begin(), states_.end(), state) != states_.end();
+        });
+    }
+
+    bool WaitBuffers(size_t num)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, TEST_WAIT_TIME, [this, num]() { return buffers_.size() >= num; });
+    }
+
+    bool WaitReceived(size_t num)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, TEST_WAIT_TIME, [this, num]() { return receivedNum_ >= num; });
+    }
+
+    void SetBlocked(bool isBlocked)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isBlocked_ = isBlocked;
+        cond_.notify_all();
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<int32_t> states_;
+    std::string networkId_;
+    std::vector<std::shared_ptr<DataBuffer>> buffers_;
+    bool isBlocked_ = false;
+    // Benchmarks only count what arrives instead of holding on to it
+    bool isKeeping_ = true;
+    size_t receivedNum_ = 0;
+};
+
+PosixSocketConfig MakeConfig(SocketFamily family, const std::string& networkId)
+{
+    PosixSocketConfig config;
+    config.family = family;
+    config.basePort = TEST_BASE_PORT;
+    config.localNetworkId = networkId;
+    return config;
+}
+
+std::shared_ptr<DataBuffer> MakeBuffer(size_t len, uint8_t salt)
+{
+    auto buffer = std::make_shared<DataBuffer>(len);
+    for (size_t i = 0; i < len; i++) {
+        buffer->Data()[i] = static_cast<uint8_t>(i * 7 + salt);
+    }
+    return buffer;
+}
+
+bool IsSameBuffer(const std::shared_ptr<DataBuffer>& lhs, const std::shared_ptr<DataBuffer>& rhs)
+{
+    return lhs->Size() == rhs->Size() && memcmp(lhs->Data(), rhs->Data(), lhs->Size()) == 0;
+}
+
+int64_t GetElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RunLoopbackBenchmark(SocketFamily family, const char *familyName)
+{
+    TestChannelListener sinkListener;
+    TestChannelListener sourceListener;
+    sinkListener.isKeeping_ = false;
+    PosixSocketAdapter sinkAdapter(MakeConfig(family, TEST_SINK_NETWORK_ID));
+    PosixSocketAdapter sourceAdapter(MakeConfig(family, TEST_SOURCE_NETWORK_ID));
+    sinkAdapter.RegisterSinkListener(&sinkListener);
+    sourceAdapter.RegisterSourceListener(&sourceListener);
+    ASSERT_EQ(DCAMERA_OK, sinkAdapter.CreateSinkSocketServer(TEST_SESSION_NAME, DCAMERA_CHANNLE_ROLE_SINK,
+        DCAMERA_SESSION_MODE_BYTES, TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME));
+    int32_t socket = sourceAdapter.CreateSourceSocketClient("camera_0", TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME,
+        TEST_SINK_NETWORK_ID, DCAMERA_SESSION_MODE_BYTES, DCAMERA_CHANNLE_ROLE_SOURCE);
+    ASSERT_GE(socket, 0);
+    ASSERT_TRUE(sinkListener.WaitState(DCAMERA_CHANNEL_STATE_CONNECTED));
+
+    // Latency: one small message in flight at a time, from SendBytes until the sink listener has it
+    std::shared_ptr<DataBuffer> message = MakeBuffer(TEST_BENCH_MESSAGE_LEN, 8);
+    std::vector<int64_t> latencies;
+    for (int32_t i = 0; i < TEST_BENCH_MESSAGE_NUM; i++) {
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_EQ(DCAMERA_OK, sourceAdapter.SendBytes(socket, message));
+        ASSERT_TRUE(sinkListener.WaitReceived(static_cast<size_t>(i) + 1));
+        latencies.push_back(GetElapsedUs(start));
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    // Throughput: frame sized messages back to back, bytes are never dropped so every one must arrive
+    std::shared_ptr<DataBuffer> frame = MakeBuffer(TEST_BENCH_FRAME_LEN, 9);
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < TEST_BENCH_FRAME_NUM; i++) {
+        int32_t ret = sourceAdapter.SendBytes(socket, frame);
+        while (ret == DCAMERA_TRANS_BUSY) {
+            std::this_thread::yield();
+            ret = sourceAdapter.SendBytes(socket, frame);
+        }
+        ASSERT_EQ(DCAMERA_OK, ret);
+    }
+    ASSERT_TRUE(sinkListener.WaitReceived(static_cast<size_t>(TEST_BENCH_MESSAGE_NUM + TEST_BENCH_FRAME_NUM)));
+    int64_t elapsedUs = std::max<int64_t>(GetElapsedUs(start), 1);
+    uint64_t mbPerSecond = TEST_BENCH_FRAME_LEN * TEST_BENCH_FRAME_NUM * TEST_US_PER_SECOND /
+        static_cast<uint64_t>(elapsedUs) / TEST_BYTES_PER_MB;
+    DHLOGI("%{public}s loopback: %{public}zu byte message p50 %{public}" PRId64 " us, p99 %{public}" PRId64 " us; "
+        "%{public}zu byte frames %{public}" PRIu64 " MB/s", familyName, TEST_BENCH_MESSAGE_LEN,
+        latencies[latencies.size() / 2], latencies[latencies.size() * TEST_P99 / TEST_PERCENT],
+        TEST_BENCH_FRAME_LEN, mbPerSecond);
+    EXPECT_GT(mbPerSecond, 0);
+    EXPECT_EQ(DCAMERA_OK, sourceAdapter.CloseSession(socket));
+    EXPECT_EQ(DCAMERA_OK, sinkAdapter.DestroySessionServer(TEST_SESSION_NAME));
+}
+}
+
+void PosixSocketAdapterTest::SetUpTestCase(void)
+{
+}
+
+void PosixSocketAdapterTest::TearDownTestCase(void)
+{
+}
+
+void PosixSocketAdapterTest::SetUp(void)
+{
+}
+
+void PosixSocketAdapterTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: posix_socket_adapter_test_001
+ * @tc.desc: Verify messages keep their boundaries over a unix domain socket.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(PosixSocketAdapterTest, posix_socket_adapter_test_001, TestSize.Level1)
+{
+    TestChannelListener sinkListener;
+    TestChannelListener sourceListener;
+    PosixSocketAdapter sinkAdapter(MakeConfig(SOCKET_FAMILY_UNIX, TEST_SINK_NETWORK_ID));
+    PosixSocketAdapter sourceAdapter(MakeConfig(SOCKET_FAMILY_UNIX, TEST_SOURCE_NETWORK_ID));
+    sinkAdapter.RegisterSinkListener(&sinkListener);
+    sourceAdapter.RegisterSourceListener(&sourceListener);
+
+    int32_t ret = sinkAdapter.CreateSinkSocketServer(TEST_SESSION_NAME, DCAMERA_CHANNLE_ROLE_SINK,
+        DCAMERA_SESSION_MODE_BYTES, TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    int32_t socket = sourceAdapter.CreateSourceSocketClient("camera_0", TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME,
+        TEST_SINK_NETWORK_ID, DCAMERA_SESSION_MODE_BYTES, DCAMERA_CHANNLE_ROLE_SOURCE);
+    ASSERT_GE(socket, 0);
+    EXPECT_TRUE(sourceListener.WaitState(DCAMERA_CHANNEL_STATE_CONNECTED));
+    EXPECT_TRUE(sinkListener.WaitState(DCAMERA_CHANNEL_STATE_CONNECTED));
+    EXPECT_EQ(TEST_SOURCE_NETWORK_ID, sinkListener.networkId_);
+    EXPECT_EQ(TEST_SINK_NETWORK_ID, sourceListener.networkId_);
+
+    std::vector<std::shared_ptr<DataBuffer>> sent = { MakeBuffer(1, 1), MakeBuffer(TEST_LARGE_LEN, 2),
+        MakeBuffer(100, 3) };
+    for (auto& buffer : sent) {
+        EXPECT_EQ(DCAMERA_OK, sourceAdapter.SendBytes(socket, buffer));
+    }
+    ASSERT_TRUE(sinkListener.WaitBuffers(sent.size()));
+    std::lock_guard<std::mutex> lock(sinkListener.mutex_);
+    ASSERT_EQ(sent.size(), sinkListener.buffers_.size());
+    for (size_t i = 0; i < sent.size(); i++) {
+        EXPECT_TRUE(IsSameBuffer(sent[i], sinkListener.buffers_[i]));
+    }
+}
+
+/**
+ * @tc.name: posix_socket_adapter_test_002
+ * @tc.desc: Verify closing a session over tcp reports the disconnect to the peer.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(PosixSocketAdapterTest, posix_socket_adapter_test_002, TestSize.Level1)
+{
+    TestChannelListener sinkListener;
+    TestChannelListener sourceListener;
+    PosixSocketAdapter sinkAdapter(MakeConfig(SOCKET_FAMILY_TCP, TEST_SINK_NETWORK_ID));
+    PosixSocketAdapter sourceAdapter(MakeConfig(SOCKET_FAMILY_TCP, TEST_SOURCE_NETWORK_ID));
+    sinkAdapter.RegisterSinkListener(&sinkListener);
+    sourceAdapter.RegisterSourceListener(&sourceListener);
+
+    EXPECT_EQ(DCAMERA_OK, sinkAdapter.CreateSinkSocketServer(TEST_SESSION_NAME, DCAMERA_CHANNLE_ROLE_SINK,
+        DCAMERA_SESSION_MODE_STREAM, TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME));
+    int32_t socket = sourceAdapter.CreateSourceSocketClient("camera_0", TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME,
+        TEST_SINK_NETWORK_ID, DCAMERA_SESSION_MODE_STREAM, DCAMERA_CHANNLE_ROLE_SOURCE);
+    ASSERT_GE(socket, 0);
+    EXPECT_TRUE(sinkListener.WaitState(DCAMERA_CHANNEL_STATE_CONNECTED));
+
+    std::shared_ptr<DataBuffer> frame = MakeBuffer(TEST_STREAM_LEN, 4);
+    EXPECT_EQ(DCAMERA_OK, sourceAdapter.SendStream(socket, frame));
+    EXPECT_TRUE(sinkListener.WaitBuffers(1));
+
+    EXPECT_EQ(DCAMERA_OK, sourceAdapter.CloseSession(socket));
+    EXPECT_TRUE(sinkListener.WaitState(DCAMERA_CHANNEL_STATE_DISCONNECTED));
+    EXPECT_NE(DCAMERA_OK, sourceAdapter.SendStream(socket, frame));
+    EXPECT_EQ(DCAMERA_NOT_FOUND, sourceAdapter.CloseSession(socket));
+    EXPECT_EQ(DCAMERA_OK, sinkAdapter.DestroySessionServer(TEST_SESSION_NAME));
+}
+
+/**
+ * @tc.name: posix_socket_adapter_test_003
+ * @tc.desc: Verify a slow receiver makes stream frames drop while bytes are all delivered.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(PosixSocketAdapterTest, posix_socket_adapter_test_003, TestSize.Level1)
+{
+    TestChannelListener sinkListener;
+    TestChannelListener sourceListener;
+    PosixSocketConfig sinkConfig = MakeConfig(SOCKET_FAMILY_UNIX, TEST_SINK_NETWORK_ID);
+    sinkConfig.recvBufSize = TEST_SOCKET_BUF_SIZE;
+    PosixSocketConfig sourceConfig = MakeConfig(SOCKET_FAMILY_UNIX, TEST_SOURCE_NETWORK_ID);
+    sourceConfig.sendBufSize = TEST_SOCKET_BUF_SIZE;
+    PosixSocketAdapter sinkAdapter(sinkConfig);
+    PosixSocketAdapter sourceAdapter(sourceConfig);
+    sinkAdapter.RegisterSinkListener(&sinkListener);
+    sourceAdapter.RegisterSourceListener(&sourceListener);
+
+    EXPECT_EQ(DCAMERA_OK, sinkAdapter.CreateSinkSocketServer(TEST_SESSION_NAME, DCAMERA_CHANNLE_ROLE_SINK,
+        DCAMERA_SESSION_MODE_STREAM, TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME));
+    int32_t socket = sourceAdapter.CreateSourceSocketClient("camera_0", TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME,
+        TEST_SINK_NETWORK_ID, DCAMERA_SESSION_MODE_STREAM, DCAMERA_CHANNLE_ROLE_SOURCE);
+    ASSERT_GE(socket, 0);
+    EXPECT_TRUE(sinkListener.WaitState(DCAMERA_CHANNEL_STATE_CONNECTED));
+
+    sinkListener.SetBlocked(true);
+    std::shared_ptr<DataBuffer> frame = MakeBuffer(TEST_STREAM_LEN, 5);
+    for (int32_t i = 0; i < TEST_STREAM_NUM; i++) {
+        EXPECT_EQ(DCAMERA_OK, sourceAdapter.SendStream(socket, frame));
+    }
+    std::shared_ptr<DataBuffer> message = MakeBuffer(100, 6);
+    EXPECT_EQ(DCAMERA_OK, sourceAdapter.SendBytes(socket, message));
+    uint64_t droppedNum = sourceAdapter.GetDroppedStreamNum(socket);
+    EXPECT_GT(droppedNum, 0);
+    sinkListener.SetBlocked(false);
+
+    size_t expectNum = TEST_STREAM_NUM - droppedNum + 1;
+    ASSERT_TRUE(sinkListener.WaitBuffers(expectNum));
+    std::lock_guard<std::mutex> lock(sinkListener.mutex_);
+    EXPECT_EQ(expectNum, sinkListener.buffers_.size());
+    EXPECT_TRUE(IsSameBuffer(message, sinkListener.buffers_.back()));
+}
+
+/**
+ * @tc.name: posix_socket_adapter_test_004
+ * @tc.desc: Verify sessions whose ports collide over tcp still reach the right server.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(PosixSocketAdapterTest, posix_socket_adapter_test_004, TestSize.Level1)
+{
+    TestChannelListener sinkListener;
+    TestChannelListener sourceListener;
+    PosixSocketAdapter sinkAdapter(MakeConfig(SOCKET_FAMILY_TCP, TEST_SINK_NETWORK_ID));
+    PosixSocketAdapter sourceAdapter(MakeConfig(SOCKET_FAMILY_TCP, TEST_SOURCE_NETWORK_ID));
+    sinkAdapter.RegisterSinkListener(&sinkListener);
+    sourceAdapter.RegisterSourceListener(&sourceListener);
+
+    EXPECT_EQ(DCAMERA_OK, sinkAdapter.CreateSinkSocketServer(TEST_SESSION_NAME, DCAMERA_CHANNLE_ROLE_SINK,
+        DCAMERA_SESSION_MODE_BYTES, TEST_SOURCE_NETWORK_ID, TEST_SESSION_NAME));
+    EXPECT_EQ(DCAMERA_OK, sinkAdapter.CreateSinkSocketServer(TEST_COLLIDE_SESSION_NAME, DCAMERA_CHANNLE_ROLE_SINK,
+        DCAMERA_SESSION_MODE_BYTES, TEST_SOURCE_NETWORK_ID, TEST_COLLIDE_SESSION_NAME));
+
+    // The second server moved on to the next port, the one its hash gives belongs to the first
+    int32_t socket = sourceAdapter.CreateSourceSocketClient("camera_215", TEST_SOURCE_NETWORK_ID,
+        TEST_COLLIDE_SESSION_NAME, TEST_SINK_NETWORK_ID, DCAMERA_SESSION_MODE_BYTES, DCAMERA_CHANNLE_ROLE_SOURCE);
+    ASSERT_GE(socket, 0);
+    EXPECT_TRUE(sourceListener.WaitState(DCAMERA_CHANNEL_STATE_CONNECTED));
+    EXPECT_TRUE(sinkListener.WaitState(DCAMERA_CHANNEL_STATE_CONNECTED));
+    std::shared_ptr<DataBuffer> message = MakeBuffer(100, 7);
+    EXPECT_EQ(DCAMERA_OK, sourceAdapter.SendBytes(socket, message));
+    ASSERT_TRUE(sinkListener.WaitBuffers(1));
+
+    // A session without a server is not taken for the one sitting on its port
+    EXPECT_EQ(DCAMERA_BAD_VALUE, sourceAdapter.CreateSourceSocketClient("camera_36", TEST_SOURCE_NETWORK_ID,
+        TEST_NEXT_SESSION_NAME, TEST_SINK_NETWORK_ID, DCAMERA_SESSION_MODE_BYTES, DCAMERA_CHANNLE_ROLE_SOURCE));
+
+    EXPECT_EQ(DCAMERA_OK, sourceAdapter.CloseSession(socket));
+    EXPECT_EQ(DCAMERA_OK, sinkAdapter.DestroySessionServer(TEST_COLLIDE_SESSION_NAME));
+    EXPECT_EQ(DCAMERA_OK, sinkAdapter.DestroySessionServer(TEST_SESSION_NAME));
+}
+
+/**
+ * @tc.name: posix_socket_adapter_test_005
+ * @tc.desc: Measure loopback message latency and frame throughput over tcp and unix domain sockets.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(PosixSocketAdapterTest, posix_socket_adapter_test_005, TestSize.Level1)
+{
+    RunLoopbackBenchmark(SOCKET_FAMILY_TCP, "tcp");
+    RunLoopbackBenchmark(SOCKET_FAMILY_UNIX, "unix");
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -16,11 +16,16 @@
 #include <iostream>
 #include <cstring>
 #include <thread>
+#include <vector>
 #include <securec.h>
 
 #include "socket.h"
 
 constexpr int32_t DH_SUCCESS = 0;
+// Tests that check what goes on the wire turn this on and read the packets back from g_sentBytes
+bool g_recordSentBytes = false;
+std::vector<std::vector<uint8_t>> g_sentBytes;
+
 int Socket(SocketInfo info)
 {
     (void)info;
@@ -53,8 +58,10 @@ void Shutdown(int32_t socket)
 int SendBytes(int32_t socket, const void *data, uint32_t len)
 {
     (void)socket;
-    (void)data;
-    (void)len;
+    if (g_recordSentBytes && data != nullptr) {
+        const uint8_t *ptr = static_cast<const uint8_t *>(data);
+        g_sentBytes.emplace_back(ptr, ptr + len);
+    }
     return DH_SUCCESS;
 }
 
@@ -25,6 +25,8 @@ enum DataProcessErrorType : int32_t {
     ERROR_PIPELINE_DECODER = -1,
     ERROR_PIPELINE_EVENTBUS = -2,
     ERROR_DISABLE_PROCESS = -3,
+    // Not fatal, a frame was dropped before decoding and the stream needs a new sync frame
+    ERROR_PIPELINE_DECODER_FRAME_LOST = -4,
 };
 
 class DataProcessListener {
@@ -39,6 +39,7 @@ public:
     virtual void DestroyDataProcessPipeline() = 0;
     virtual int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) = 0;
     virtual int32_t UpdateSettings(const std::shared_ptr<Camera::CameraMetadata> settings) = 0;
+    virtual int32_t RequestKeyFrame() = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -45,6 +45,7 @@ public:
     int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) override;
 
     int32_t UpdateSettings(const std::shared_ptr<Camera::CameraMetadata> settings) override;
+    int32_t RequestKeyFrame() override;
 
 private:
     bool IsInRange(const VideoConfigParams& curConfig);
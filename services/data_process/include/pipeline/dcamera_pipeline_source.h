@@ -23,7 +23,9 @@
 #include "data_buffer.h"
 #include "image_common_type.h"
 #include "distributed_camera_errno.h"
+#include "dcamera_memory_accountant.h"
 #include "dcamera_pipeline_event.h"
+#include "dcamera_stats_manager.h"
 #include "idata_process_pipeline.h"
 #include "abstract_data_process.h"
 #include "data_process_listener.h"
@@ -47,6 +49,13 @@ public:
     int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) override;
 
     int32_t UpdateSettings(const std::shared_ptr<Camera::CameraMetadata> settings) override;
+    int32_t RequestKeyFrame() override;
+
+    // Set before CreateDataProcessPipeline, names the stream node stats and queue memory are reported under
+    void SetStatsName(const std::string& statsName);
+    std::shared_ptr<DCameraNodeStats> RegisterNodeStats(const std::string& nodeName,
+        const std::vector<std::string>& queueNames = {});
+    std::shared_ptr<DCameraQueueMemory> RegisterQueueMemory(const std::string& queueName);
 
 private:
     bool IsInRange(const VideoConfigParams& curConfig);
@@ -68,6 +77,7 @@ private:
     std::shared_ptr<AbstractDataProcess> pipelineHead_ = nullptr;
 
     bool isProcess_ = false;
+    std::string statsName_;
     PipelineType piplineType_ = PipelineType::VIDEO;
     std::vector<std::shared_ptr<AbstractDataProcess>> pipNodeRanks_;
 
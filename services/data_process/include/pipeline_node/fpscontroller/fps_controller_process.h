@@ -60,6 +60,7 @@ private:
     constexpr static int32_t DOUBLE_MULTIPLE = 2;
 
     std::weak_ptr<DCameraPipelineSource> callbackPipelineSource_;
+    std::shared_ptr<DCameraNodeStats> nodeStats_ = nullptr;
     std::mutex mtx;
     VideoConfigParams sourceConfig_;
     VideoConfigParams targetConfig_;
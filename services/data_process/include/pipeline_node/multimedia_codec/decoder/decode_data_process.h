@@ -38,10 +38,12 @@
 #include "data_buffer.h"
 #include "dcamera_codec_event.h"
 #include "dcamera_pipeline_source.h"
+#include "dcamera_stats_manager.h"
 #include "distributed_camera_errno.h"
 #include "image_common_type.h"
 #include "dcamera_utils_tools.h"
 #include "image_converter.h"
+#include "software_video_decoder.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -72,6 +74,7 @@ public:
     void ReleaseProcessNode() override;
 
     void OnError();
+    void OnFrameLost();
     void OnInputBufferAvailable(uint32_t index, std::shared_ptr<Media::AVSharedMemory> buffer);
     void OnOutputFormatChanged(const Media::Format &format);
     void OnOutputBufferAvailable(uint32_t index, const MediaAVCodec::AVCodecBufferInfo& info,
@@ -91,6 +94,8 @@ private:
     bool IsConvertible(const VideoConfigParams& sourceConfig, const VideoConfigParams& targetConfig);
     void InitCodecEvent();
     int32_t InitDecoder();
+    int32_t InitHardwareDecoder();
+    int32_t InitSoftwareDecoder();
     int32_t ConfigureVideoDecoder();
     int32_t InitDecoderMetadataFormat();
     int32_t SetDecoderOutputSurface();
@@ -99,6 +104,8 @@ private:
     void ReleaseVideoDecoder();
     void ReleaseDecoderSurface();
     void ReleaseCodecEvent();
+    bool IsResolutionChanged(const DCameraFrameInfo& frameInfo);
+    int32_t RestartVideoDecoder(int32_t width, int32_t height);
     void BeforeDecodeDump(uint8_t *buffer, size_t bufSize);
     int32_t FeedDecoderInputBuffer();
     int64_t GetDecoderTimeStamp();
@@ -106,7 +113,12 @@ private:
     void ReduceWaitDecodeCnt();
     void CopyDecodedImage(const sptr<SurfaceBuffer>& surBuf, int32_t alignedWidth, int32_t alignedHeight);
     bool IsCorrectSurfaceBuffer(const sptr<SurfaceBuffer>& surBuf, int32_t alignedWidth, int32_t alignedHeight);
+    void SetDecodedImageInfo(std::shared_ptr<DataBuffer>& bufferOutput);
     void PostOutputDataBuffers(std::shared_ptr<DataBuffer>& outputBuffer);
+    int32_t ProcessSoftwareData(const std::shared_ptr<DataBuffer>& buffer);
+    void DecodeSoftwareFrame(const std::shared_ptr<DataBuffer>& buffer, uint32_t generation);
+    void OutputSoftwareImage(std::shared_ptr<DataBuffer>& image);
+    bool TakeFrameInfo(int64_t pts, DCameraFrameInfo& frameInfo);
     int32_t DecodeDone(std::vector<std::shared_ptr<DataBuffer>>& outputBuffers);
     void StartEventHandler();
     bool UniversalRotateCropAndPadNv12ToI420(ImageDataInfo srcInfo, ImageDataInfo dstInfo, int angleDegrees);
@@ -121,6 +133,7 @@ private:
     bool CheckParameters(ImageDataInfo srcInfo, ImageDataInfo dstInfo);
     OpenSourceLibyuv::RotationMode ParseAngle(int angleDegrees);
     bool FreeYUVBuffer(uint8_t*& dataY, uint8_t*& dataU, uint8_t*& dataV);
+    void InitNodeStats();
 
 private:
     constexpr static int32_t VIDEO_DECODER_QUEUE_MAX = 1000;
@@ -144,12 +157,15 @@ private:
     constexpr static uint32_t OFFSET_Y_0 = 0;
     constexpr static uint32_t BLACK_COLOR_PEXEL = 0;
     constexpr static uint32_t WHITE_COLOR_PEXEL = 128;
+    constexpr static size_t STATS_QUEUE_INPUT = 0;
+    constexpr static size_t STATS_QUEUE_CODEC_INPUT = 1;
     std::shared_ptr<AppExecFwk::EventHandler> pipeSrcEventHandler_;
     std::weak_ptr<DCameraPipelineSource> callbackPipelineSource_;
     std::mutex mtxDecoderLock_;
     std::mutex mtxDecoderState_;
     std::mutex mtxHoldCount_;
     std::mutex mtxDequeLock_;
+    std::mutex mtxResolution_;
     VideoConfigParams sourceConfig_;
     VideoConfigParams targetConfig_;
     VideoConfigParams processedConfig_;
@@ -158,6 +174,13 @@ private:
     sptr<IConsumerSurface> decodeConsumerSurface_ = nullptr;
     sptr<Surface> decodeProducerSurface_ = nullptr;
     sptr<IBufferConsumerListener> decodeSurfaceListener_ = nullptr;
+    // Set instead of videoDecoder_ when the stream fell back to software decoding
+    std::unique_ptr<SoftwareVideoDecoder> softwareDecoder_ = nullptr;
+    bool isHardwareReserved_ = false;
+    int64_t softwareLoad_ = -1;
+    std::atomic<int32_t> softwarePendingCount_ = 0;
+    // Bumped when the decoder is released, inputs posted before that are dropped without decoding
+    std::atomic<uint32_t> softwareGeneration_ = 0;
 
     std::atomic<bool> isDecoderProcess_ = false;
     int32_t waitDecoderOutputCount_ = 0;
@@ -175,6 +198,8 @@ private:
     FILE *dumpDecBeforeFile_ = nullptr;
     FILE *dumpDecAfterFile_ = nullptr;
     int32_t rotate_ = 0;
+    std::shared_ptr<DCameraNodeStats> nodeStats_ = nullptr;
+    std::shared_ptr<DCameraQueueMemory> inputMemory_ = nullptr;
 
     std::mutex eventMutex_;
     std::thread eventThread_;
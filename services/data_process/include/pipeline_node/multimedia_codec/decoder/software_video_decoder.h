@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SOFTWARE_VIDEO_DECODER_H
+#define OHOS_SOFTWARE_VIDEO_DECODER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "data_buffer.h"
+#include "image_common_type.h"
+
+struct AVCodecContext;
+struct AVFrame;
+struct AVPacket;
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * FFmpeg decoder used when no platform decoder is available. Decoding is synchronous on the calling
+ * thread and the codec spreads each picture over its own threads, slice threading by default since
+ * frame threading delays every output by threads - 1 frames.
+ */
+class SoftwareVideoDecoder {
+public:
+    SoftwareVideoDecoder() = default;
+    ~SoftwareVideoDecoder();
+
+    int32_t Init(VideoCodecType codecType, int32_t width, int32_t height, Videoformat outputFormat);
+    // Every picture the packet completes is written straight into a new packed buffer of the output format
+    // carrying the pts of its packet, DCAMERA_BAD_VALUE means the packet was not taken and will not produce a picture
+    int32_t Decode(const std::shared_ptr<DataBuffer>& input, std::vector<std::shared_ptr<DataBuffer>>& outputs);
+    void Release();
+    int32_t GetThreadNum() const;
+
+private:
+    int32_t ReceiveFrames(std::vector<std::shared_ptr<DataBuffer>>& outputs);
+    int32_t CopyFrame(std::shared_ptr<DataBuffer>& output);
+    int32_t CopyPlane(const uint8_t *src, int32_t srcStride, uint8_t *dst, int32_t width, int32_t height);
+    int32_t InterleavePlanes(const uint8_t *first, int32_t firstStride, const uint8_t *second,
+        int32_t secondStride, uint8_t *dst);
+
+    constexpr static int32_t YUV_BYTES_PER_PIXEL = 3;
+    constexpr static int32_t Y2UV_RATIO = 2;
+
+    AVCodecContext *codecCtx_ = nullptr;
+    AVPacket *packet_ = nullptr;
+    AVFrame *frame_ = nullptr;
+    std::string mime_;
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    int32_t threadNum_ = 0;
+    bool frameThreading_ = false;
+    Videoformat outputFormat_ = Videoformat::YUVI420;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_SOFTWARE_VIDEO_DECODER_H
@@ -34,6 +34,7 @@
 #include "distributed_camera_errno.h"
 #include "image_common_type.h"
 #include "distributed_camera_constants.h"
+#include "encode_resolution_policy.h"
 
 #include "v1_0/display_composer_type.h"
 
@@ -65,6 +66,8 @@ public:
     int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) override;
 
     int32_t UpdateSettings(const std::shared_ptr<Camera::CameraMetadata> settings) override;
+    int32_t RequestKeyFrame();
+    int32_t SwitchResolution(int32_t width, int32_t height);
 
 private:
     bool IsInEncoderRange(const VideoConfigParams& curConfig);
@@ -72,11 +75,19 @@ private:
     int32_t InitEncoder();
     int32_t ConfigureVideoEncoder();
     int32_t InitEncoderMetadataFormat();
+    bool IsTemporalScalableSupported(const std::string& mimeType);
     int32_t InitEncoderBitrateFormat();
     int32_t StartVideoEncoder();
     int32_t StopVideoEncoder();
     void ReleaseVideoEncoder();
     int32_t FeedEncoderInputBuffer(std::shared_ptr<DataBuffer>& inputBuffer);
+    int32_t ScaleEncoderInputBuffer(const std::shared_ptr<DataBuffer>& inputBuffer,
+        const sptr<SurfaceBuffer>& surfacebuffer);
+    bool IsEncodeScaled();
+    int32_t ApplyPendingResolution();
+    void InitResolutionPolicy();
+    void AdaptResolution(size_t sentBytes, bool isBusy);
+    int64_t GetMatchedBitrate(int64_t pixelformat);
     sptr<SurfaceBuffer> GetEncoderInputSurfaceBuffer();
     int64_t GetEncoderTimeStamp();
     void IncreaseWaitEncodeCnt();
@@ -91,6 +102,11 @@ private:
     int32_t OnProcessedEncodeVideoBuffer(std::shared_ptr<DataBuffer>& encodeBuffer, bool isKeyFrame);
     void SyncVideoFrameSuccess(bool isKeyFrame);
     void SyncVideoFrameFailure(std::shared_ptr<DataBuffer>& encodeBuffer);
+    int32_t GetTemporalLayer(MediaAVCodec::AVCodecBufferFlag flag);
+    void CheckSurfaceInUse(MediaAVCodec::AVCodecBufferFlag flag);
+    int32_t GetBufferLayer(const std::shared_ptr<DataBuffer>& buffer);
+    bool IsLayerSendable(int32_t layer);
+    void ShedEnhancementLayers();
     int32_t CreateSyncEncodeBufferThread();
 
 private:
@@ -138,6 +154,20 @@ private:
     const uint32_t BITRATE_INCREASE_STANDARD = 5;
     const int32_t SYNCQUEUE_DIVIDE_TWO = 2;
     const int32_t SYNCQUEUE_DIVIDE_FOUR = 4;
+    constexpr static int32_t TEMPORAL_GOP_SIZE = 4;
+    constexpr static int32_t TEMPORAL_TOP_LAYER = 2;
+    constexpr static int32_t TEMPORAL_LAYER_RATIO = 2;
+    // Same value as UNIFORMLY_SCALED_REFERENCE, a frame only references the layers below it
+    constexpr static int32_t TEMPORAL_GOP_REFERENCE_MODE = 2;
+    const uint32_t TEMPORAL_LAYER_RECOVER_FRAMES = 30;
+    // Resolution steps are 4/4, 3/4 and 2/4 of the captured resolution
+    constexpr static int32_t RESOLUTION_STEP_NUM = 3;
+    constexpr static int32_t RESOLUTION_STEP_DENOMINATOR = 4;
+    constexpr static int32_t RESOLUTION_STEP_ALIGNMENT = 2;
+    constexpr static int32_t YUV_BYTES_PER_PIXEL = 3;
+    constexpr static int32_t Y2UV_RATIO = 2;
+    // Requests from every viewer are folded into one sync frame while it is on its way
+    constexpr static int64_t KEY_FRAME_REQUEST_PENDING_US = 300000;
     constexpr static std::chrono::seconds TIMEOUT_3_SEC = std::chrono::seconds(3);
 
     std::weak_ptr<DCameraPipelineSink> callbackPipelineSink_;
@@ -146,6 +176,7 @@ private:
     VideoConfigParams sourceConfig_;
     VideoConfigParams targetConfig_;
     VideoConfigParams processedConfig_;
+    VideoConfigParams encodeConfig_;
     std::shared_ptr<MediaAVCodec::AVCodecVideoEncoder> videoEncoder_ = nullptr;
     std::shared_ptr<MediaAVCodec::AVCodecCallback> encodeVideoCallback_ = nullptr;
     sptr<Surface> encodeProducerSurface_ = nullptr;
@@ -178,6 +209,24 @@ private:
     int64_t minBitrate_ = BITRATE_3400000;
     int64_t dynamicBitrateStep_ = 0;
     std::mutex bitrateMutex_;
+
+    bool isTemporalScalable_ = false;
+    int32_t temporalGopPos_ = 0;
+    std::atomic<int32_t> maxSendLayer_ = TEMPORAL_TOP_LAYER;
+    int32_t gopSendLayer_ = TEMPORAL_TOP_LAYER;
+    uint32_t layerSuccNum_ = 0;
+    uint64_t shedFrameNum_ = 0;
+
+    // Set by the raw buffer path, and once an encoded frame shows the camera writes the encoder surface itself
+    std::atomic<bool> isRawInputFed_ = false;
+    std::atomic<bool> isSurfaceInUse_ = false;
+    std::mutex resolutionMutex_;
+    int32_t pendingWidth_ = 0;
+    int32_t pendingHeight_ = 0;
+    bool isResolutionSwitched_ = false;
+    EncodeResolutionPolicy resolutionPolicy_;
+    std::vector<uint8_t> scaleBuffer_;
+    std::atomic<int64_t> keyFrameRequestUs_ = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
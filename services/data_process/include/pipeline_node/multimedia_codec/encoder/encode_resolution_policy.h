@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ENCODE_RESOLUTION_POLICY_H
+#define OHOS_ENCODE_RESOLUTION_POLICY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace DistributedHardware {
+struct ResolutionStep {
+    int32_t width = 0;
+    int32_t height = 0;
+    // Lowest bitrate the encoder is allowed to reach at this resolution
+    int64_t minBitrate = 0;
+};
+
+/*
+ * Picks the encode resolution from the throughput measured on the sending side. Steps are ordered
+ * from the full resolution down. The policy steps down when the channel is congested and carries
+ * less than the lowest bitrate of the current step, so the bitrate control alone cannot catch up,
+ * and steps up again after several clean windows that already carried the lowest bitrate of the
+ * larger step. Not thread safe, it is driven by the encoder sync thread only.
+ */
+class EncodeResolutionPolicy {
+public:
+    EncodeResolutionPolicy() = default;
+    ~EncodeResolutionPolicy() = default;
+
+    void Init(const std::vector<ResolutionStep>& steps, int64_t nowUs);
+    void OnFrameSent(size_t bytes, int64_t nowUs);
+    void OnFrameBusy(int64_t nowUs);
+    bool PollStep(ResolutionStep& step);
+    bool IsEnabled() const;
+    void Disable();
+    int64_t GetThroughputBps() const;
+
+private:
+    void UpdateWindow(int64_t nowUs);
+    void CloseWindow(int64_t nowUs);
+
+    constexpr static int64_t THROUGHPUT_WINDOW_US = 1000000;
+    constexpr static int64_t US_PER_SECOND = 1000000;
+    constexpr static int64_t BITS_PER_BYTE = 8;
+    constexpr static int32_t STEP_HOLD_WINDOWS = 3;
+    constexpr static int32_t STEP_UP_CLEAN_WINDOWS = 5;
+    constexpr static int32_t NO_PENDING_STEP = -1;
+
+    std::vector<ResolutionStep> steps_;
+    int32_t curStep_ = 0;
+    int32_t pendingStep_ = NO_PENDING_STEP;
+    int64_t windowStartUs_ = 0;
+    int64_t windowBytes_ = 0;
+    uint32_t windowBusyNum_ = 0;
+    int32_t cleanWindows_ = 0;
+    int32_t holdWindows_ = 0;
+    int64_t throughputBps_ = 0;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_ENCODE_RESOLUTION_POLICY_H
@@ -57,6 +57,7 @@ public:
 
 private:
     bool IsConvertible(const VideoConfigParams& sourceConfig, const VideoConfigParams& targetConfig);
+    int32_t UpdateSourceResolution(const std::shared_ptr<DataBuffer>& imgBuf);
     bool IsCorrectImageUnitInfo(const ImageUnitInfo& imgInfo);
     bool CheckScaleProcessInputInfo(const ImageUnitInfo& srcImgInfo);
     bool CheckScaleConvertInfo(const ImageUnitInfo& srcImgInfo, const ImageUnitInfo& dstImgInfo);
@@ -106,6 +107,7 @@ private:
     VideoConfigParams targetConfig_;
     VideoConfigParams processedConfig_;
     std::weak_ptr<DCameraPipelineSource> callbackPipelineSource_;
+    std::shared_ptr<DCameraNodeStats> nodeStats_ = nullptr;
     std::atomic<bool> isScaleConvert_ = false;
     FILE *dumpFile_ = nullptr;
 };
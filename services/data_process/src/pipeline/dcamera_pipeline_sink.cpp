@@ -207,5 +207,20 @@ int32_t DCameraPipelineSink::UpdateSettings(const std::shared_ptr<Camera::Camera
 {
     return DCAMERA_OK;
 }
+
+int32_t DCameraPipelineSink::RequestKeyFrame()
+{
+    if (isProcess_.load() == false) {
+        DHLOGE("RequestKeyFrame: pipeline is not running.");
+        return DCAMERA_BAD_OPERATE;
+    }
+    for (const auto& node : pipNodeRanks_) {
+        std::shared_ptr<EncodeDataProcess> encodeNode = std::dynamic_pointer_cast<EncodeDataProcess>(node);
+        if (encodeNode != nullptr) {
+            return encodeNode->RequestKeyFrame();
+        }
+    }
+    return DCAMERA_NOT_FOUND;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
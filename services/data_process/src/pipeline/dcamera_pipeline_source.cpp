@@ -234,8 +234,12 @@ void DCameraPipelineSource::DestroyDataProcessPipeline()
 
 void DCameraPipelineSource::OnError(DataProcessErrorType errorType)
 {
-    DHLOGE("A runtime error occurred in the source pipeline.");
-    isProcess_ = false;
+    if (errorType == ERROR_PIPELINE_DECODER_FRAME_LOST) {
+        DHLOGW("The source pipeline dropped a frame before decoding.");
+    } else {
+        DHLOGE("A runtime error occurred in the source pipeline.");
+        isProcess_ = false;
+    }
     std::unique_lock<std::mutex> lock(listenerMutex_);
     if (processListener_ == nullptr) {
         DHLOGE("The process listener of source pipeline is empty.");
@@ -269,5 +273,27 @@ int32_t DCameraPipelineSource::UpdateSettings(const std::shared_ptr<Camera::Came
     }
     return DCAMERA_OK;
 }
+
+int32_t DCameraPipelineSource::RequestKeyFrame()
+{
+    DHLOGD("DCameraPipelineSource has no encoder, ignore key frame request.");
+    return DCAMERA_NOT_FOUND;
+}
+
+void DCameraPipelineSource::SetStatsName(const std::string& statsName)
+{
+    statsName_ = statsName;
+}
+
+std::shared_ptr<DCameraNodeStats> DCameraPipelineSource::RegisterNodeStats(const std::string& nodeName,
+    const std::vector<std::string>& queueNames)
+{
+    return DCameraStatsManager::GetInstance().Register(statsName_, nodeName, queueNames);
+}
+
+std::shared_ptr<DCameraQueueMemory> DCameraPipelineSource::RegisterQueueMemory(const std::string& queueName)
+{
+    return DCameraMemoryAccountant::GetInstance().RegisterQueue(statsName_, queueName);
+}
 } // namespace DistributedHardware
 } // namespace OHOS
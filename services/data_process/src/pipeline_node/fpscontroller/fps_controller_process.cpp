@@ -40,6 +40,10 @@ int32_t FpsControllerProcess::InitNode(const VideoConfigParams& sourceConfig, co
     sourceConfig_ = sourceConfig;
     targetConfig_ = targetConfig;
     targetFrameRate_ = targetConfig_.GetFrameRate();
+    std::shared_ptr<DCameraPipelineSource> pipelineSource = callbackPipelineSource_.lock();
+    if (pipelineSource != nullptr) {
+        nodeStats_ = pipelineSource->RegisterNodeStats("fps");
+    }
 
     processedConfig_ = sourceConfig;
     processedConfig = processedConfig_;
@@ -88,6 +92,9 @@ int32_t FpsControllerProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer
     }
 
     std::lock_guard<std::mutex> lck (mtx);
+    if (nodeStats_ != nullptr) {
+        nodeStats_->AddInput(inputBuffers[0]->Size());
+    }
     int64_t nowTimeMs = GetNowTimeStampMs();
     UpdateFPSControllerInfo(nowTimeMs);
 
@@ -95,6 +102,9 @@ int32_t FpsControllerProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer
     if (IsDropFrame(curFrameRate)) {
         DHLOGD("frame control, currect frameRate %{public}f, targetRate %{public}d, drop it",
             curFrameRate, targetFrameRate_);
+        if (nodeStats_ != nullptr) {
+            nodeStats_->AddDrop(DCAMERA_DROP_FPS_CONTROL);
+        }
         return DCAMERA_OK;
     }
 
@@ -330,6 +340,9 @@ int32_t FpsControllerProcess::FpsControllerDone(std::vector<std::shared_ptr<Data
         DHLOGE("The received data buffers is empty.");
         return DCAMERA_BAD_VALUE;
     }
+    if (nodeStats_ != nullptr && outputBuffers[0] != nullptr) {
+        nodeStats_->AddOutput(outputBuffers[0]->Size());
+    }
 
     if (nextDataProcess_ != nullptr) {
         DHLOGD("Send to the next node of the FpsController for processing.");
@@ -17,11 +17,14 @@
 
 #include "distributed_camera_constants.h"
 #include "distributed_hardware_log.h"
+#include "dcamera_decoder_budget.h"
 #include "dcamera_hisysevent_adapter.h"
 #include "dcamera_hidumper.h"
+#include "dcamera_thread_policy.h"
 #include "decode_surface_listener.h"
 #include "decode_video_callback.h"
 #include "graphic_common_c.h"
+#include <algorithm>
 #include <sys/prctl.h>
 
 namespace OHOS {
@@ -57,6 +60,7 @@ int32_t DecodeDataProcess::InitNode(const VideoConfigParams& sourceConfig, const
 
     sourceConfig_ = sourceConfig;
     targetConfig_ = targetConfig;
+    InitNodeStats();
     if (sourceConfig_.GetVideoCodecType() == targetConfig_.GetVideoCodecType()) {
         DHLOGD("Disable DecodeNode. The target video codec type %{public}d is the same as the source video codec "
             "type %{public}d.", targetConfig_.GetVideoCodecType(), sourceConfig_.GetVideoCodecType());
@@ -79,6 +83,15 @@ int32_t DecodeDataProcess::InitNode(const VideoConfigParams& sourceConfig, const
     return DCAMERA_OK;
 }
 
+void DecodeDataProcess::InitNodeStats()
+{
+    std::shared_ptr<DCameraPipelineSource> pipelineSource = callbackPipelineSource_.lock();
+    if (pipelineSource != nullptr) {
+        nodeStats_ = pipelineSource->RegisterNodeStats("decode", { "input", "codecInput" });
+        inputMemory_ = pipelineSource->RegisterQueueMemory("decode/input");
+    }
+}
+
 bool DecodeDataProcess::IsInDecoderRange(const VideoConfigParams& curConfig)
 {
     bool isWidthValid = (curConfig.GetWidth() >= MIN_VIDEO_WIDTH && curConfig.GetWidth() <= MAX_VIDEO_WIDTH);
@@ -122,6 +135,25 @@ void DecodeDataProcess::StartEventHandler()
 int32_t DecodeDataProcess::InitDecoder()
 {
     DHLOGD("Init video decoder.");
+    DCameraDecoderBackend backend = DCameraDecoderBudget::GetInstance().GetConfig().backend;
+    if (backend != DCAMERA_DECODER_SOFTWARE) {
+        int32_t ret = InitHardwareDecoder();
+        if (ret == DCAMERA_OK || backend == DCAMERA_DECODER_HARDWARE) {
+            return ret;
+        }
+        DHLOGI("Fall back to the software decoder, hardware decoder ret %{public}d.", ret);
+        ReleaseVideoDecoder();
+        ReleaseDecoderSurface();
+    }
+    return InitSoftwareDecoder();
+}
+
+int32_t DecodeDataProcess::InitHardwareDecoder()
+{
+    if (!DCameraDecoderBudget::GetInstance().AcquireHardware()) {
+        return DCAMERA_DEVICE_BUSY;
+    }
+    isHardwareReserved_ = true;
     int32_t ret = ConfigureVideoDecoder();
     if (ret != DCAMERA_OK) {
         DHLOGE("Init video decoder metadata format failed.");
@@ -140,6 +172,29 @@ int32_t DecodeDataProcess::InitDecoder()
     return DCAMERA_OK;
 }
 
+int32_t DecodeDataProcess::InitSoftwareDecoder()
+{
+    int32_t ret = InitDecoderMetadataFormat();
+    CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "Init software decoder format failed. ret %{public}d.", ret);
+    int64_t load = DCameraDecoderBudget::GetInstance().AcquireSoftware(processType_, sourceConfig_.GetWidth(),
+        sourceConfig_.GetHeight(), sourceConfig_.GetFrameRate());
+    CHECK_AND_RETURN_RET_LOG(load < 0, DCAMERA_DEVICE_BUSY, "%{public}s", "No software decode budget left.");
+    std::unique_ptr<SoftwareVideoDecoder> decoder = std::make_unique<SoftwareVideoDecoder>();
+    ret = decoder->Init(sourceConfig_.GetVideoCodecType(), sourceConfig_.GetWidth(), sourceConfig_.GetHeight(),
+        processedConfig_.GetVideoformat());
+    if (ret != DCAMERA_OK) {
+        DHLOGE("Init software decoder failed. ret %{public}d.", ret);
+        DCameraDecoderBudget::GetInstance().ReleaseSoftware(load);
+        return ret;
+    }
+    std::lock_guard<std::mutex> inputLock(mtxDecoderLock_);
+    softwareDecoder_ = std::move(decoder);
+    softwareLoad_ = load;
+    DHLOGI("Software decoder started, %{public}dx%{public}d, load %{public}" PRId64 " us/s.",
+        sourceConfig_.GetWidth(), sourceConfig_.GetHeight(), load);
+    return DCAMERA_OK;
+}
+
 int32_t DecodeDataProcess::ConfigureVideoDecoder()
 {
     int32_t ret = InitDecoderMetadataFormat();
@@ -321,6 +376,16 @@ void DecodeDataProcess::ReleaseVideoDecoder()
     DHLOGD("Start release videoDecoder.");
     std::lock_guard<std::mutex> inputLock(mtxDecoderLock_);
     std::lock_guard<std::mutex> outputLock(mtxDecoderState_);
+    softwareGeneration_++;
+    softwareDecoder_ = nullptr;
+    if (softwareLoad_ >= 0) {
+        DCameraDecoderBudget::GetInstance().ReleaseSoftware(softwareLoad_);
+        softwareLoad_ = -1;
+    }
+    if (isHardwareReserved_) {
+        DCameraDecoderBudget::GetInstance().ReleaseHardware();
+        isHardwareReserved_ = false;
+    }
     if (videoDecoder_ == nullptr) {
         DHLOGE("The video decoder does not exist before ReleaseVideoDecoder.");
         decodeVideoCallback_ = nullptr;
@@ -377,6 +442,9 @@ void DecodeDataProcess::ReleaseProcessNode()
 
     processType_ = "";
     std::queue<std::shared_ptr<DataBuffer>>().swap(inputBuffersQueue_);
+    if (inputMemory_ != nullptr) {
+        inputMemory_->Clear();
+    }
     std::queue<uint32_t>().swap(availableInputIndexsQueue_);
     std::queue<std::shared_ptr<Media::AVSharedMemory>>().swap(availableInputBufferQueue_);
     {
@@ -384,6 +452,7 @@ void DecodeDataProcess::ReleaseProcessNode()
         std::deque<DCameraFrameInfo>().swap(frameInfoDeque_);
     }
     waitDecoderOutputCount_ = 0;
+    softwarePendingCount_ = 0;
     lastFeedDecoderInputBufferTimeUs_ = 0;
     outputTimeStampUs_ = 0;
     alignedHeight_ = 0;
@@ -402,6 +471,9 @@ int32_t DecodeDataProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>&
         DHLOGE("The input data buffers is empty.");
         return DCAMERA_BAD_VALUE;
     }
+    if (nodeStats_ != nullptr) {
+        nodeStats_->AddInput(inputBuffers[0]->Size());
+    }
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, DUMP_DCAMERA_BEFORE_DEC_FILENAME, &dumpDecBeforeFile_);
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, DUMP_DCAMERA_AFTER_DEC_FILENAME, &dumpDecAfterFile_);
     if (sourceConfig_.GetVideoCodecType() == processedConfig_.GetVideoCodecType()) {
@@ -410,25 +482,57 @@ int32_t DecodeDataProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>&
         return DecodeDone(inputBuffers);
     }
 
-    if (videoDecoder_ == nullptr) {
+    if (videoDecoder_ == nullptr && softwareDecoder_ == nullptr) {
         DHLOGE("The video decoder does not exist before decoding data.");
         return DCAMERA_INIT_ERR;
     }
-    if (inputBuffersQueue_.size() > VIDEO_DECODER_QUEUE_MAX) {
+    size_t queueDepth = (softwareDecoder_ != nullptr) ? static_cast<size_t>(softwarePendingCount_.load()) :
+        inputBuffersQueue_.size();
+    // Compressed input is only counted, dropping it under memory pressure would break the reference chain;
+    // the budget is applied to the decoded frames queued in the producer instead
+    if (queueDepth > VIDEO_DECODER_QUEUE_MAX) {
         DHLOGE("video decoder input buffers queue over flow.");
+        if (nodeStats_ != nullptr) {
+            nodeStats_->AddDrop(DCAMERA_DROP_BUSY);
+        }
+        OnFrameLost();
         return DCAMERA_INDEX_OVERFLOW;
     }
     if (inputBuffers[0]->Size() > MAX_BUFFER_SIZE) {
         DHLOGE("DecodeNode input buffer size %{public}zu error.", inputBuffers[0]->Size());
+        OnFrameLost();
         return DCAMERA_MEMORY_OPT_ERROR;
     }
     if (!isDecoderProcess_.load()) {
         DHLOGE("Decoder node occurred error or start release.");
         return DCAMERA_DISABLE_PROCESS;
     }
+    DCameraFrameInfo& frameInfo = inputBuffers[0]->frameInfo_;
+    if (IsResolutionChanged(frameInfo)) {
+        // The decoder restarts on the first sync frame at the new resolution, nothing before it is decodable
+        if (frameInfo.type == MediaAVCodec::AVCODEC_BUFFER_FLAG_NONE) {
+            DHLOGD("Drop frame %{public}d, wait for the sync frame at %{public}dx%{public}d.", frameInfo.index,
+                frameInfo.width, frameInfo.height);
+            return DCAMERA_OK;
+        }
+        int32_t ret = RestartVideoDecoder(frameInfo.width, frameInfo.height);
+        if (ret != DCAMERA_OK) {
+            OnError();
+            return ret;
+        }
+    }
+    if (softwareDecoder_ != nullptr) {
+        return ProcessSoftwareData(inputBuffers[0]);
+    }
     inputBuffersQueue_.push(inputBuffers[0]);
+    if (inputMemory_ != nullptr) {
+        inputMemory_->Add(inputBuffers[0]->Size());
+    }
     DHLOGD("Push inputBuf sucess. BufSize %{public}zu, QueueSize %{public}zu.", inputBuffers[0]->Size(),
         inputBuffersQueue_.size());
+    if (nodeStats_ != nullptr) {
+        nodeStats_->SetQueueDepth(STATS_QUEUE_INPUT, inputBuffersQueue_.size());
+    }
     int32_t err = FeedDecoderInputBuffer();
     if (err != DCAMERA_OK) {
         int32_t sleepTimeUs = 5000;
@@ -445,6 +549,48 @@ int32_t DecodeDataProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>&
     return DCAMERA_OK;
 }
 
+bool DecodeDataProcess::IsResolutionChanged(const DCameraFrameInfo& frameInfo)
+{
+    return frameInfo.width > 0 && frameInfo.height > 0 &&
+        (frameInfo.width != sourceConfig_.GetWidth() || frameInfo.height != sourceConfig_.GetHeight());
+}
+
+int32_t DecodeDataProcess::RestartVideoDecoder(int32_t width, int32_t height)
+{
+    VideoConfigParams newConfig = sourceConfig_;
+    newConfig.SetWidthAndHeight(width, height);
+    CHECK_AND_RETURN_RET_LOG(!IsInDecoderRange(newConfig), DCAMERA_BAD_VALUE,
+        "Invalid decode resolution %{public}dx%{public}d.", width, height);
+    DHLOGI("Restart video decoder, resolution %{public}dx%{public}d -> %{public}dx%{public}d.",
+        sourceConfig_.GetWidth(), sourceConfig_.GetHeight(), width, height);
+    std::lock_guard<std::mutex> lock(mtxResolution_);
+    ReleaseVideoDecoder();
+    ReleaseDecoderSurface();
+    std::queue<std::shared_ptr<DataBuffer>>().swap(inputBuffersQueue_);
+    if (inputMemory_ != nullptr) {
+        inputMemory_->Clear();
+    }
+    softwarePendingCount_ = 0;
+    {
+        std::lock_guard<std::mutex> lck(mtxHoldCount_);
+        std::queue<uint32_t>().swap(availableInputIndexsQueue_);
+        std::queue<std::shared_ptr<Media::AVSharedMemory>>().swap(availableInputBufferQueue_);
+        waitDecoderOutputCount_ = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lck(mtxDequeLock_);
+        std::deque<DCameraFrameInfo>().swap(frameInfoDeque_);
+    }
+    lastFeedDecoderInputBufferTimeUs_ = 0;
+    outputTimeStampUs_ = 0;
+    sourceConfig_ = newConfig;
+    alignedHeight_ = GetAlignedHeight(sourceConfig_.GetHeight());
+    metadataFormat_ = Media::Format();
+    int32_t ret = InitDecoder();
+    CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "Restart video decoder failed. ret %{public}d.", ret);
+    return DCAMERA_OK;
+}
+
 void DecodeDataProcess::BeforeDecodeDump(uint8_t *buffer, size_t bufSize)
 {
 #ifdef DUMP_DCAMERA_FILE
@@ -502,7 +648,13 @@ int32_t DecodeDataProcess::FeedDecoderInputBuffer()
         }
 
         inputBuffersQueue_.pop();
+        if (inputMemory_ != nullptr) {
+            inputMemory_->Sub(buffer->Size());
+        }
         DHLOGD("Push inputBuffer sucess. inputBuffersQueue size is %{public}zu.", inputBuffersQueue_.size());
+        if (nodeStats_ != nullptr) {
+            nodeStats_->SetQueueDepth(STATS_QUEUE_INPUT, inputBuffersQueue_.size());
+        }
 
         IncreaseWaitDecodeCnt();
     }
@@ -529,6 +681,10 @@ void DecodeDataProcess::IncreaseWaitDecodeCnt()
     availableInputBufferQueue_.pop();
     waitDecoderOutputCount_++;
     DHLOGD("Wait decoder output frames number is %{public}d.", waitDecoderOutputCount_);
+    if (nodeStats_ != nullptr) {
+        nodeStats_->SetQueueDepth(STATS_QUEUE_CODEC_INPUT, availableInputBufferQueue_.size());
+        nodeStats_->SetInFlight(waitDecoderOutputCount_);
+    }
 }
 
 void DecodeDataProcess::ReduceWaitDecodeCnt()
@@ -543,6 +699,9 @@ void DecodeDataProcess::ReduceWaitDecodeCnt()
         waitDecoderOutputCount_--;
     }
     DHLOGD("Wait decoder output frames number is %{public}d.", waitDecoderOutputCount_);
+    if (nodeStats_ != nullptr) {
+        nodeStats_->SetInFlight(waitDecoderOutputCount_);
+    }
 }
 
 void DecodeDataProcess::OnSurfaceOutputBufferAvailable(const sptr<IConsumerSurface>& surface)
@@ -560,10 +719,17 @@ void DecodeDataProcess::OnSurfaceOutputBufferAvailable(const sptr<IConsumerSurfa
 void DecodeDataProcess::GetDecoderOutputBuffer(const sptr<IConsumerSurface>& surface)
 {
     DHLOGD("Get decoder output buffer.");
+    // Runs on the decEventHandler_ runner, which does the copy out of the decoder surface
+    DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_DECODE_OUTPUT);
     if (surface == nullptr) {
         DHLOGE("Get decode consumer surface failed.");
         return;
     }
+    std::lock_guard<std::mutex> lock(mtxResolution_);
+    if (surface != decodeConsumerSurface_) {
+        DHLOGD("Drop the output of the decoder released by the resolution switch.");
+        return;
+    }
     Rect damage = {0, 0, 0, 0};
     int32_t acquireFence = 0;
     int64_t timeStamp = 0;
@@ -611,10 +777,17 @@ void DecodeDataProcess::CopyDecodedImage(const sptr<SurfaceBuffer>& surBuf, int3
         return;
     }
     {
+        // The platform decoder hands pictures out in input order
         std::lock_guard<std::mutex> lock(mtxDequeLock_);
         bufferOutput->frameInfo_ = frameInfoDeque_.front();
         frameInfoDeque_.pop_front();
     }
+    SetDecodedImageInfo(bufferOutput);
+    PostOutputDataBuffers(bufferOutput);
+}
+
+void DecodeDataProcess::SetDecodedImageInfo(std::shared_ptr<DataBuffer>& bufferOutput)
+{
     bufferOutput->SetInt32("Videoformat", static_cast<int32_t>(processedConfig_.GetVideoformat()));
     bufferOutput->SetInt32("alignedWidth", processedConfig_.GetWidth());
     bufferOutput->SetInt32("alignedHeight", processedConfig_.GetHeight());
@@ -628,7 +801,6 @@ void DecodeDataProcess::CopyDecodedImage(const sptr<SurfaceBuffer>& surBuf, int3
     }
 #endif
     DumpFileUtil::WriteDumpFile(dumpDecAfterFile_, static_cast<void *>(bufferOutput->Data()), bufferOutput->Size());
-    PostOutputDataBuffers(bufferOutput);
 }
 
 bool DecodeDataProcess::IsCorrectSurfaceBuffer(const sptr<SurfaceBuffer>& surBuf, int32_t alignedWidth,
@@ -682,6 +854,104 @@ void DecodeDataProcess::PostOutputDataBuffers(std::shared_ptr<DataBuffer>& outpu
     DHLOGD("Send video decoder output asynchronous DCameraCodecEvents success.");
 }
 
+int32_t DecodeDataProcess::ProcessSoftwareData(const std::shared_ptr<DataBuffer>& buffer)
+{
+    std::lock_guard<std::mutex> lock(eventMutex_);
+    CHECK_AND_RETURN_RET_LOG(decEventHandler_ == nullptr, DCAMERA_BAD_VALUE, "%{public}s",
+        "decEventHandler_ is nullptr.");
+    softwarePendingCount_++;
+    if (inputMemory_ != nullptr) {
+        inputMemory_->Add(buffer->Size());
+    }
+    if (nodeStats_ != nullptr) {
+        nodeStats_->SetQueueDepth(STATS_QUEUE_INPUT, softwarePendingCount_.load());
+    }
+    uint32_t generation = softwareGeneration_.load();
+    auto decodeFunc = [this, buffer, generation]() mutable {
+        DecodeSoftwareFrame(buffer, generation);
+    };
+    decEventHandler_->PostTask(decodeFunc);
+    return DCAMERA_OK;
+}
+
+void DecodeDataProcess::DecodeSoftwareFrame(const std::shared_ptr<DataBuffer>& buffer, uint32_t generation)
+{
+    DCameraThreadPolicy::GetInstance().ApplyToCurrentThread(DCAMERA_THREAD_DECODE_OUTPUT);
+    std::vector<std::shared_ptr<DataBuffer>> outputs;
+    {
+        std::lock_guard<std::mutex> inputLock(mtxDecoderLock_);
+        // The queue accounting was reset with the decoder these inputs were posted for
+        if (generation != softwareGeneration_.load() || softwareDecoder_ == nullptr) {
+            DHLOGD("Drop the input of the released software decoder.");
+            return;
+        }
+        softwarePendingCount_--;
+        if (inputMemory_ != nullptr) {
+            inputMemory_->Sub(buffer->Size());
+        }
+        if (nodeStats_ != nullptr) {
+            nodeStats_->SetQueueDepth(STATS_QUEUE_INPUT, softwarePendingCount_.load());
+        }
+        if (!isDecoderProcess_.load()) {
+            DHLOGE("Decoder node occurred error or start release.");
+            return;
+        }
+        BeforeDecodeDump(buffer->Data(), buffer->Size());
+        DumpFileUtil::WriteDumpFile(dumpDecBeforeFile_, static_cast<void *>(buffer->Data()), buffer->Size());
+        buffer->frameInfo_.timePonit.startDecode = GetNowTimeStampUs();
+        {
+            // Queued before decoding, the packet may complete its own picture
+            std::lock_guard<std::mutex> lock(mtxDequeLock_);
+            frameInfoDeque_.push_back(buffer->frameInfo_);
+        }
+        int32_t ret = softwareDecoder_->Decode(buffer, outputs);
+        if (ret == DCAMERA_BAD_VALUE) {
+            std::lock_guard<std::mutex> lock(mtxDequeLock_);
+            frameInfoDeque_.pop_back();
+        }
+        if (ret != DCAMERA_OK) {
+            DHLOGE("Software decode frame %{public}d failed. ret %{public}d.", buffer->frameInfo_.index, ret);
+        }
+    }
+    for (auto& output : outputs) {
+        OutputSoftwareImage(output);
+    }
+}
+
+void DecodeDataProcess::OutputSoftwareImage(std::shared_ptr<DataBuffer>& image)
+{
+    int64_t finishDecodeT = GetNowTimeStampUs();
+    DCameraFrameInfo frameInfo;
+    {
+        std::lock_guard<std::mutex> lock(mtxDequeLock_);
+        AlignFirstFrameTime();
+        CHECK_AND_RETURN_LOG(!TakeFrameInfo(image->frameInfo_.pts, frameInfo),
+            "No frame info for the software decoded image, pts %{public}" PRId64 ".", image->frameInfo_.pts);
+    }
+    frameInfo.timePonit.finishDecode = finishDecodeT;
+    image->frameInfo_ = frameInfo;
+    SetDecodedImageInfo(image);
+    // Already on the codec event thread, so the image goes on without another post
+    std::vector<std::shared_ptr<DataBuffer>> multiDataBuffers;
+    multiDataBuffers.push_back(image);
+    int32_t ret = DecodeDone(multiDataBuffers);
+    DHLOGD("excute DecodeDone ret %{public}d.", ret);
+}
+
+bool DecodeDataProcess::TakeFrameInfo(int64_t pts, DCameraFrameInfo& frameInfo)
+{
+    auto match = std::find_if(frameInfoDeque_.begin(), frameInfoDeque_.end(),
+        [pts](const DCameraFrameInfo& info) { return info.pts == pts; });
+    if (match == frameInfoDeque_.end()) {
+        return false;
+    }
+    frameInfo = *match;
+    // Pictures come out in pts order, so inputs with an older pts will not complete a picture any more
+    frameInfoDeque_.erase(std::remove_if(frameInfoDeque_.begin(), frameInfoDeque_.end(),
+        [pts](const DCameraFrameInfo& info) { return info.pts <= pts; }), frameInfoDeque_.end());
+    return true;
+}
+
 int32_t DecodeDataProcess::DecodeDone(std::vector<std::shared_ptr<DataBuffer>>& outputBuffers)
 {
     DHLOGD("Decoder Done.");
@@ -689,6 +959,9 @@ int32_t DecodeDataProcess::DecodeDone(std::vector<std::shared_ptr<DataBuffer>>&
         DHLOGE("The received data buffers is empty.");
         return DCAMERA_BAD_VALUE;
     }
+    if (nodeStats_ != nullptr && outputBuffers[0] != nullptr) {
+        nodeStats_->AddOutput(outputBuffers[0]->Size());
+    }
 
     if (nextDataProcess_ != nullptr) {
         DHLOGD("Send to the next node of the decoder for processing.");
@@ -723,6 +996,16 @@ void DecodeDataProcess::OnError()
     targetPipelineSource->OnError(DataProcessErrorType::ERROR_PIPELINE_DECODER);
 }
 
+void DecodeDataProcess::OnFrameLost()
+{
+    std::shared_ptr<DCameraPipelineSource> targetPipelineSource = callbackPipelineSource_.lock();
+    if (targetPipelineSource == nullptr) {
+        DHLOGE("callbackPipelineSource_ is nullptr.");
+        return;
+    }
+    targetPipelineSource->OnError(DataProcessErrorType::ERROR_PIPELINE_DECODER_FRAME_LOST);
+}
+
 void DecodeDataProcess::OnInputBufferAvailable(uint32_t index, std::shared_ptr<Media::AVSharedMemory> buffer)
 {
     DHLOGD("DecodeDataProcess::OnInputBufferAvailable");
@@ -734,6 +1017,9 @@ void DecodeDataProcess::OnInputBufferAvailable(uint32_t index, std::shared_ptr<M
     DHLOGD("Video decoder available indexs queue push index [%{public}u].", index);
     availableInputIndexsQueue_.push(index);
     availableInputBufferQueue_.push(buffer);
+    if (nodeStats_ != nullptr) {
+        nodeStats_->SetQueueDepth(STATS_QUEUE_CODEC_INPUT, availableInputBufferQueue_.size());
+    }
 }
 
 void DecodeDataProcess::OnOutputFormatChanged(const Media::Format &format)
@@ -803,7 +1089,8 @@ void DecodeDataProcess::AlignFirstFrameTime()
         return;
     }
     DCameraFrameInfo frameInfo = frameInfoDeque_.front();
-    if (frameInfo.index != FRAME_HEAD || frameInfo.type != MediaAVCodec::AVCODEC_BUFFER_FLAG_CODEC_DATA) {
+    // The codec data is queued on its own at every decoder start, it shares the output of the next frame
+    if (frameInfo.type != MediaAVCodec::AVCODEC_BUFFER_FLAG_CODEC_DATA) {
         return;
     }
     frameInfoDeque_.pop_front();
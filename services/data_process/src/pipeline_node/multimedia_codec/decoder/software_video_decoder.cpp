@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "software_video_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <libavcodec/avcodec.h>
+#include <libavutil/error.h>
+#ifdef __cplusplus
+};
+#endif
+
+#include <securec.h>
+
+#include "dcamera_decoder_budget.h"
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const std::string MIME_AVC = "video/avc";
+const std::string MIME_HEVC = "video/hevc";
+}
+
+SoftwareVideoDecoder::~SoftwareVideoDecoder()
+{
+    Release();
+}
+
+int32_t SoftwareVideoDecoder::Init(VideoCodecType codecType, int32_t width, int32_t height, Videoformat outputFormat)
+{
+    CHECK_AND_RETURN_RET_LOG(codecCtx_ != nullptr, DCAMERA_WRONG_STATE, "%{public}s",
+        "The software decoder is already initialized.");
+    bool isFormatValid = (outputFormat == Videoformat::YUVI420 || outputFormat == Videoformat::NV12 ||
+        outputFormat == Videoformat::NV21);
+    // The packed 4:2:0 layouts need even dimensions
+    if (!isFormatValid || width <= 0 || height <= 0 || width % Y2UV_RATIO != 0 || height % Y2UV_RATIO != 0) {
+        DHLOGE("Software decoder does not support format %{public}d, %{public}dx%{public}d.", outputFormat,
+            width, height);
+        return DCAMERA_BAD_VALUE;
+    }
+    AVCodecID codecId = AV_CODEC_ID_NONE;
+    switch (codecType) {
+        case VideoCodecType::CODEC_H264:
+            codecId = AV_CODEC_ID_H264;
+            mime_ = MIME_AVC;
+            break;
+        case VideoCodecType::CODEC_H265:
+            codecId = AV_CODEC_ID_HEVC;
+            mime_ = MIME_HEVC;
+            break;
+        default:
+            DHLOGE("The software decoder does not support codec type %{public}d.", codecType);
+            return DCAMERA_NOT_FOUND;
+    }
+    const AVCodec *codec = avcodec_find_decoder(codecId);
+    CHECK_AND_RETURN_RET_LOG(codec == nullptr, DCAMERA_NOT_FOUND, "Find software decoder %{public}s failed.",
+        mime_.c_str());
+    codecCtx_ = avcodec_alloc_context3(codec);
+    packet_ = av_packet_alloc();
+    frame_ = av_frame_alloc();
+    if (codecCtx_ == nullptr || packet_ == nullptr || frame_ == nullptr) {
+        DHLOGE("Alloc software decoder context failed.");
+        Release();
+        return DCAMERA_ALLOC_ERROR;
+    }
+
+    DCameraDecoderConfig config = DCameraDecoderBudget::GetInstance().GetConfig();
+    codecCtx_->width = width;
+    codecCtx_->height = height;
+    codecCtx_->thread_count = config.softwareThreads;
+    if (config.frameThreading) {
+        codecCtx_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    } else {
+        codecCtx_->thread_type = FF_THREAD_SLICE;
+        codecCtx_->flags |= AV_CODEC_FLAG_LOW_DELAY;
+    }
+    int32_t ret = avcodec_open2(codecCtx_, codec, nullptr);
+    if (ret < 0) {
+        DHLOGE("Open software decoder %{public}s failed. ret %{public}d.", mime_.c_str(), ret);
+        Release();
+        return DCAMERA_INIT_ERR;
+    }
+    width_ = width;
+    height_ = height;
+    outputFormat_ = outputFormat;
+    threadNum_ = codecCtx_->thread_count;
+    frameThreading_ = (codecCtx_->active_thread_type & FF_THREAD_FRAME) != 0;
+    DHLOGI("Software decoder %{public}s %{public}dx%{public}d opened, threads %{public}d, active thread type "
+        "%{public}d.", mime_.c_str(), width_, height_, threadNum_, codecCtx_->active_thread_type);
+    return DCAMERA_OK;
+}
+
+int32_t SoftwareVideoDecoder::Decode(const std::shared_ptr<DataBuffer>& input,
+    std::vector<std::shared_ptr<DataBuffer>>& outputs)
+{
+    CHECK_AND_RETURN_RET_LOG(codecCtx_ == nullptr, DCAMERA_INIT_ERR, "%{public}s",
+        "The software decoder is not initialized.");
+    CHECK_AND_RETURN_RET_LOG(input == nullptr || input->Size() == 0 || input->Size() > INT32_MAX,
+        DCAMERA_BAD_VALUE, "%{public}s", "Software decoder input is invalid.");
+    int64_t startUs = GetNowTimeStampUs();
+    // Not reference counted, so the codec copies the data into its own padded buffer
+    packet_->data = input->Data();
+    packet_->size = static_cast<int32_t>(input->Size());
+    packet_->pts = input->frameInfo_.pts;
+    int32_t ret = avcodec_send_packet(codecCtx_, packet_);
+    av_packet_unref(packet_);
+    if (ret < 0) {
+        DHLOGE("Software decoder send packet failed. ret %{public}d.", ret);
+        return DCAMERA_BAD_VALUE;
+    }
+    size_t outputNum = outputs.size();
+    int32_t err = ReceiveFrames(outputs);
+    size_t frameNum = outputs.size() - outputNum;
+    // With frame threading the call returns before the work is done, so it says nothing about the cost
+    if (frameNum > 0 && !frameThreading_) {
+        int64_t wallUs = (GetNowTimeStampUs() - startUs) / static_cast<int64_t>(frameNum);
+        for (size_t i = 0; i < frameNum; i++) {
+            DCameraDecoderBudget::GetInstance().AddSoftwareSample(mime_, width_, height_, wallUs,
+                wallUs * threadNum_);
+        }
+    }
+    return err;
+}
+
+int32_t SoftwareVideoDecoder::ReceiveFrames(std::vector<std::shared_ptr<DataBuffer>>& outputs)
+{
+    while (true) {
+        int32_t ret = avcodec_receive_frame(codecCtx_, frame_);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
+            return DCAMERA_OK;
+        }
+        if (ret < 0) {
+            DHLOGE("Software decoder receive frame failed. ret %{public}d.", ret);
+            return DCAMERA_BAD_OPERATE;
+        }
+        std::shared_ptr<DataBuffer> output = nullptr;
+        ret = CopyFrame(output);
+        if (ret == DCAMERA_OK) {
+            // The caller pairs the picture with its input by pts, output order need not be input order
+            output->frameInfo_.pts = frame_->pts;
+            outputs.push_back(output);
+        }
+        av_frame_unref(frame_);
+    }
+}
+
+int32_t SoftwareVideoDecoder::CopyFrame(std::shared_ptr<DataBuffer>& output)
+{
+    bool isYuv420 = (frame_->format == AV_PIX_FMT_YUV420P || frame_->format == AV_PIX_FMT_YUVJ420P);
+    if (!isYuv420 || frame_->width != width_ || frame_->height != height_) {
+        DHLOGE("Drop software decoded frame, format %{public}d, %{public}dx%{public}d.", frame_->format,
+            frame_->width, frame_->height);
+        return DCAMERA_BAD_VALUE;
+    }
+    int32_t sizeY = width_ * height_;
+    int32_t widthUV = width_ / Y2UV_RATIO;
+    int32_t heightUV = height_ / Y2UV_RATIO;
+    output = std::make_shared<DataBuffer>(static_cast<size_t>(sizeY * YUV_BYTES_PER_PIXEL / Y2UV_RATIO));
+    uint8_t *dstY = output->Data();
+    uint8_t *dstUV = output->Data() + sizeY;
+    int32_t ret = CopyPlane(frame_->data[0], frame_->linesize[0], dstY, width_, height_);
+    CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "%{public}s", "Copy Y plane failed.");
+    switch (outputFormat_) {
+        case Videoformat::NV12:
+            return InterleavePlanes(frame_->data[1], frame_->linesize[1], frame_->data[2], frame_->linesize[2], dstUV);
+        case Videoformat::NV21:
+            return InterleavePlanes(frame_->data[2], frame_->linesize[2], frame_->data[1], frame_->linesize[1], dstUV);
+        default:
+            ret = CopyPlane(frame_->data[1], frame_->linesize[1], dstUV, widthUV, heightUV);
+            CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, ret, "%{public}s", "Copy U plane failed.");
+            return CopyPlane(frame_->data[2], frame_->linesize[2], dstUV + widthUV * heightUV, widthUV, heightUV);
+    }
+}
+
+int32_t SoftwareVideoDecoder::CopyPlane(const uint8_t *src, int32_t srcStride, uint8_t *dst, int32_t width,
+    int32_t height)
+{
+    for (int32_t row = 0; row < height; row++) {
+        errno_t err = memcpy_s(dst + row * width, width, src + row * srcStride, width);
+        CHECK_AND_RETURN_RET_LOG(err != EOK, DCAMERA_MEMORY_OPT_ERROR, "%{public}s", "memcpy_s plane failed.");
+    }
+    return DCAMERA_OK;
+}
+
+int32_t SoftwareVideoDecoder::InterleavePlanes(const uint8_t *first, int32_t firstStride, const uint8_t *second,
+    int32_t secondStride, uint8_t *dst)
+{
+    int32_t widthUV = width_ / Y2UV_RATIO;
+    int32_t heightUV = height_ / Y2UV_RATIO;
+    for (int32_t row = 0; row < heightUV; row++) {
+        const uint8_t *firstRow = first + row * firstStride;
+        const uint8_t *secondRow = second + row * secondStride;
+        uint8_t *dstRow = dst + row * width_;
+        for (int32_t col = 0; col < widthUV; col++) {
+            dstRow[Y2UV_RATIO * col] = firstRow[col];
+            dstRow[Y2UV_RATIO * col + 1] = secondRow[col];
+        }
+    }
+    return DCAMERA_OK;
+}
+
+void SoftwareVideoDecoder::Release()
+{
+    if (codecCtx_ != nullptr) {
+        avcodec_free_context(&codecCtx_);
+    }
+    if (packet_ != nullptr) {
+        av_packet_free(&packet_);
+    }
+    if (frame_ != nullptr) {
+        av_frame_free(&frame_);
+    }
+    width_ = 0;
+    height_ = 0;
+    threadNum_ = 0;
+}
+
+int32_t SoftwareVideoDecoder::GetThreadNum() const
+{
+    return threadNum_;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
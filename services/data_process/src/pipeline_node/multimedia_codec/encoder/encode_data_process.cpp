@@ -14,6 +14,7 @@
  */
 
 #include <cmath>
+#include "avcodec_list.h"
 #include "dcamera_hisysevent_adapter.h"
 #include "dcamera_radar.h"
 #include "dcamera_utils_tools.h"
@@ -69,6 +70,7 @@ int32_t EncodeDataProcess::InitNode(const VideoConfigParams& sourceConfig, const
 
     sourceConfig_ = sourceConfig;
     targetConfig_ = targetConfig;
+    encodeConfig_ = sourceConfig;
     int32_t tempFrameRate = sourceConfig_.GetFrameRate();
     maxFrameRate_ = tempFrameRate == 0 ? DCAMERA_PRODUCER_FPS_DEFAULT : tempFrameRate;
     if (sourceConfig_.GetVideoCodecType() == targetConfig_.GetVideoCodecType()) {
@@ -91,6 +93,7 @@ int32_t EncodeDataProcess::InitNode(const VideoConfigParams& sourceConfig, const
         return err;
     }
     processedConfig = processedConfig_;
+    InitResolutionPolicy();
     {
         std::unique_lock<std::mutex> lock(isEncoderProcessMtx_);
         isEncoderProcess_.store(true);
@@ -141,8 +144,8 @@ int32_t EncodeDataProcess::InitEncoder()
         DHLOGE("Start Video encoder failed.");
         ReportDcamerOptFail(DCAMERA_OPT_FAIL, DCAMERA_ENCODE_ERROR,
             CreateMsg("start video encoder failed, width: %d, height: %d, format: %s",
-            sourceConfig_.GetWidth(), sourceConfig_.GetHeight(),
-            ENUM_VIDEOFORMAT_STRINGS[static_cast<int32_t>(sourceConfig_.GetVideoformat())].c_str()));
+            encodeConfig_.GetWidth(), encodeConfig_.GetHeight(),
+            ENUM_VIDEOFORMAT_STRINGS[static_cast<int32_t>(encodeConfig_.GetVideoformat())].c_str()));
         return ret;
     }
 
@@ -183,16 +186,19 @@ int32_t EncodeDataProcess::ConfigureVideoEncoder()
 int32_t EncodeDataProcess::InitEncoderMetadataFormat()
 {
     processedConfig_ = sourceConfig_;
+    bool isLayeredCodec = false;
     switch (targetConfig_.GetVideoCodecType()) {
         case VideoCodecType::CODEC_H264:
             processType_ = "video/avc";
             metadataFormat_.PutIntValue("codec_profile", MediaAVCodec::AVCProfile::AVC_PROFILE_BASELINE);
             processedConfig_.SetVideoCodecType(VideoCodecType::CODEC_H264);
+            isLayeredCodec = true;
             break;
         case VideoCodecType::CODEC_H265:
             processType_ = "video/hevc";
             metadataFormat_.PutIntValue("codec_profile", MediaAVCodec::HEVCProfile::HEVC_PROFILE_MAIN);
             processedConfig_.SetVideoCodecType(VideoCodecType::CODEC_H265);
+            isLayeredCodec = true;
             break;
         case VideoCodecType::CODEC_MPEG4_ES:
             processType_ = "video/mp4v-es";
@@ -204,7 +210,7 @@ int32_t EncodeDataProcess::InitEncoderMetadataFormat()
             DHLOGE("The current codec type does not support encoding.");
             return DCAMERA_NOT_FOUND;
     }
-    switch (sourceConfig_.GetVideoformat()) {
+    switch (encodeConfig_.GetVideoformat()) {
         case Videoformat::YUVI420:
             metadataFormat_.PutIntValue("pixel_format", static_cast<int32_t>(MediaAVCodec::VideoPixelFormat::YUVI420));
             metadataFormat_.PutLongValue("max_input_size", NORM_YUV420_BUFFER_SIZE);
@@ -226,12 +232,33 @@ int32_t EncodeDataProcess::InitEncoderMetadataFormat()
             return DCAMERA_NOT_FOUND;
     }
     metadataFormat_.PutStringValue("codec_mime", processType_);
-    metadataFormat_.PutIntValue("width", static_cast<int32_t>(sourceConfig_.GetWidth()));
-    metadataFormat_.PutIntValue("height", static_cast<int32_t>(sourceConfig_.GetHeight()));
+    metadataFormat_.PutIntValue("width", static_cast<int32_t>(encodeConfig_.GetWidth()));
+    metadataFormat_.PutIntValue("height", static_cast<int32_t>(encodeConfig_.GetHeight()));
     metadataFormat_.PutDoubleValue("frame_rate", MAX_FRAME_RATE);
+    // Layer ids are derived from the frame position, so they are only valid when the encoder applies the structure
+    isTemporalScalable_ = isLayeredCodec && IsTemporalScalableSupported(processType_);
+    temporalGopPos_ = 0;
+    DHLOGI("encoder %{public}s temporal scalable: %{public}d", processType_.c_str(), isTemporalScalable_);
+    if (isTemporalScalable_) {
+        metadataFormat_.PutIntValue("video_encoder_enable_temporal_scalability", 1);
+        metadataFormat_.PutIntValue("video_encoder_temporal_gop_size", TEMPORAL_GOP_SIZE);
+        metadataFormat_.PutIntValue("video_encoder_temporal_gop_reference_mode", TEMPORAL_GOP_REFERENCE_MODE);
+    }
     return DCAMERA_OK;
 }
 
+bool EncodeDataProcess::IsTemporalScalableSupported(const std::string& mimeType)
+{
+    std::shared_ptr<MediaAVCodec::AVCodecList> avCodecList = MediaAVCodec::AVCodecListFactory::CreateAVCodecList();
+    CHECK_AND_RETURN_RET_LOG(avCodecList == nullptr, false, "Create avCodecList failed.");
+    MediaAVCodec::CapabilityData *capData = avCodecList->GetCapability(mimeType, true,
+        MediaAVCodec::AVCodecCategory::AVCODEC_HARDWARE);
+    CHECK_AND_RETURN_RET_LOG(capData == nullptr, false, "Get %{public}s encoder capability failed.",
+        mimeType.c_str());
+    int32_t feature = static_cast<int32_t>(MediaAVCodec::AVCapabilityFeature::VIDEO_ENCODER_TEMPORAL_SCALABILITY);
+    return capData->featuresMap.find(feature) != capData->featuresMap.end();
+}
+
 int32_t EncodeDataProcess::InitEncoderBitrateFormat()
 {
     DHLOGD("Init video encoder bitrate format.");
@@ -242,7 +269,20 @@ int32_t EncodeDataProcess::InitEncoderBitrateFormat()
 
     CHECK_AND_RETURN_RET_LOG(ENCODER_BITRATE_TABLE.empty(), DCAMERA_OK, "%{public}s",
         "ENCODER_BITRATE_TABLE is null, use the default bitrate of the encoder.");
-    int64_t pixelformat = static_cast<int64_t>(sourceConfig_.GetWidth() * sourceConfig_.GetHeight());
+    int64_t matchedBitrate =
+        GetMatchedBitrate(static_cast<int64_t>(encodeConfig_.GetWidth() * encodeConfig_.GetHeight()));
+    DHLOGD("Encode config: width : %{public}d, height : %{public}d, matched bitrate %{public}" PRId64,
+        encodeConfig_.GetWidth(), encodeConfig_.GetHeight(), matchedBitrate);
+    maxBitrate_ = matchedBitrate;
+    minBitrate_ = static_cast<int64_t> (matchedBitrate / MINIMUM_BITRATE_FACTOR);
+    currentBitrate_ = matchedBitrate - minBitrate_;
+    dynamicBitrateStep_ = maxBitrate_ - minBitrate_;
+    metadataFormat_.PutLongValue("bitrate", currentBitrate_);
+    return DCAMERA_OK;
+}
+
+int64_t EncodeDataProcess::GetMatchedBitrate(int64_t pixelformat)
+{
     int64_t matchedBitrate = BITRATE_6000000;
     int64_t minPixelformatDiff = WIDTH_1920_HEIGHT_1080 - pixelformat;
     for (auto it = ENCODER_BITRATE_TABLE.begin(); it != ENCODER_BITRATE_TABLE.end(); it++) {
@@ -256,14 +296,7 @@ int32_t EncodeDataProcess::InitEncoderBitrateFormat()
             matchedBitrate = it->second;
         }
     }
-    DHLOGD("Source config: width : %{public}d, height : %{public}d, matched bitrate %{public}" PRId64,
-        sourceConfig_.GetWidth(), sourceConfig_.GetHeight(), matchedBitrate);
-    maxBitrate_ = matchedBitrate;
-    minBitrate_ = static_cast<int64_t> (matchedBitrate / MINIMUM_BITRATE_FACTOR);
-    currentBitrate_ = matchedBitrate - minBitrate_;
-    dynamicBitrateStep_ = maxBitrate_ - minBitrate_;
-    metadataFormat_.PutLongValue("bitrate", currentBitrate_);
-    return DCAMERA_OK;
+    return matchedBitrate;
 }
 
 int32_t EncodeDataProcess::StartVideoEncoder()
@@ -352,6 +385,15 @@ void EncodeDataProcess::ReleaseProcessNode()
     lastFeedEncoderInputBufferTimeUs_ = 0;
     inputTimeStampUs_ = 0;
     processType_ = "";
+    isRawInputFed_.store(false);
+    isSurfaceInUse_.store(false);
+    {
+        std::lock_guard<std::mutex> lck(resolutionMutex_);
+        pendingWidth_ = 0;
+        pendingHeight_ = 0;
+        isResolutionSwitched_ = false;
+    }
+    std::vector<uint8_t>().swap(scaleBuffer_);
 
     if (nextDataProcess_ != nullptr) {
         nextDataProcess_->ReleaseProcessNode();
@@ -382,7 +424,9 @@ int32_t EncodeDataProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>&
     }
     CHECK_AND_RETURN_RET_LOG(!isEncoderProcess_.load(), DCAMERA_DISABLE_PROCESS, "%{public}s",
         "EncodeNode occurred error or start release.");
-    int32_t err = FeedEncoderInputBuffer(inputBuffers[0]);
+    int32_t err = ApplyPendingResolution();
+    CHECK_AND_RETURN_RET_LOG(err != DCAMERA_OK, err, "%{public}s", "Apply pending encode resolution failed.");
+    err = FeedEncoderInputBuffer(inputBuffers[0]);
     CHECK_AND_RETURN_RET_LOG(err != DCAMERA_OK, err, "%{public}s", "Feed encoder input Buffer failed.");
     return DCAMERA_OK;
 }
@@ -393,6 +437,7 @@ int32_t EncodeDataProcess::FeedEncoderInputBuffer(std::shared_ptr<DataBuffer>& i
     DHLOGD("Feed encoder input buffer, buffer size %{public}zu.", inputBuffer->Size());
     CHECK_AND_RETURN_RET_LOG(encodeProducerSurface_ == nullptr, DCAMERA_INIT_ERR, "%{public}s",
         "Get encoder input producer surface failed.");
+    isRawInputFed_.store(true);
     sptr<SurfaceBuffer> surfacebuffer = GetEncoderInputSurfaceBuffer();
     CHECK_AND_RETURN_RET_LOG(surfacebuffer == nullptr, DCAMERA_BAD_OPERATE, "%{public}s",
         "Get encoder input producer surface buffer failed.");
@@ -402,10 +447,18 @@ int32_t EncodeDataProcess::FeedEncoderInputBuffer(std::shared_ptr<DataBuffer>& i
         encodeProducerSurface_->CancelBuffer(surfacebuffer);
         return DCAMERA_BAD_OPERATE;
     }
-    size_t size = static_cast<size_t>(surfacebuffer->GetSize());
-    errno_t err = memcpy_s(addr, size, inputBuffer->Data(), inputBuffer->Size());
-    CHECK_AND_RETURN_RET_LOG(err != EOK, DCAMERA_MEMORY_OPT_ERROR,
-        "memcpy_s encoder input producer surfacebuffer failed, surBufSize %{public}zu.", size);
+    if (IsEncodeScaled()) {
+        int32_t ret = ScaleEncoderInputBuffer(inputBuffer, surfacebuffer);
+        if (ret != DCAMERA_OK) {
+            encodeProducerSurface_->CancelBuffer(surfacebuffer);
+            return ret;
+        }
+    } else {
+        size_t size = static_cast<size_t>(surfacebuffer->GetSize());
+        errno_t err = memcpy_s(addr, size, inputBuffer->Data(), inputBuffer->Size());
+        CHECK_AND_RETURN_RET_LOG(err != EOK, DCAMERA_MEMORY_OPT_ERROR,
+            "memcpy_s encoder input producer surfacebuffer failed, surBufSize %{public}zu.", size);
+    }
 
     inputTimeStampUs_ = GetEncoderTimeStamp();
     DHLOGD("Encoder input buffer size %{public}zu, timeStamp %{public}lld.", inputBuffer->Size(),
@@ -416,7 +469,7 @@ int32_t EncodeDataProcess::FeedEncoderInputBuffer(std::shared_ptr<DataBuffer>& i
     }
     surfacebuffer->GetExtraData()->ExtraSet("timeStamp", inputTimeStampUs_);
 
-    BufferFlushConfig flushConfig = { {0, 0, sourceConfig_.GetWidth(), sourceConfig_.GetHeight()}, 0};
+    BufferFlushConfig flushConfig = { {0, 0, encodeConfig_.GetWidth(), encodeConfig_.GetHeight()}, 0};
     SurfaceError ret = encodeProducerSurface_->FlushBuffer(surfacebuffer, -1, flushConfig);
     CHECK_AND_RETURN_RET_LOG(ret != SURFACE_ERROR_OK, DCAMERA_BAD_OPERATE, "%s",
         "Flush encoder input producer surface buffer failed.");
@@ -426,12 +479,12 @@ int32_t EncodeDataProcess::FeedEncoderInputBuffer(std::shared_ptr<DataBuffer>& i
 sptr<SurfaceBuffer> EncodeDataProcess::GetEncoderInputSurfaceBuffer()
 {
     BufferRequestConfig requestConfig;
-    requestConfig.width = sourceConfig_.GetWidth();
-    requestConfig.height = sourceConfig_.GetHeight();
+    requestConfig.width = encodeConfig_.GetWidth();
+    requestConfig.height = encodeConfig_.GetHeight();
     requestConfig.usage = BUFFER_USAGE_CPU_READ | BUFFER_USAGE_CPU_WRITE | BUFFER_USAGE_MEM_DMA;
     requestConfig.timeout = 0;
     requestConfig.strideAlignment = ENCODER_STRIDE_ALIGNMENT;
-    switch (sourceConfig_.GetVideoformat()) {
+    switch (encodeConfig_.GetVideoformat()) {
         case Videoformat::YUVI420:
             requestConfig.format = PixelFormat::PIXEL_FMT_YCBCR_420_P;
             break;
@@ -538,7 +591,21 @@ int32_t EncodeDataProcess::GetEncoderOutputBuffer(uint32_t index, MediaAVCodec::
     bufferOutput->SetInt64(FINISH_ENCODE_TIME_US, finishEncodeT);
     bufferOutput->SetInt64(TIME_STAMP_US, timeStamp);
     bufferOutput->SetInt32(FRAME_TYPE, flag);
+    CheckSurfaceInUse(flag);
+    if (flag != MediaAVCodec::AVCODEC_BUFFER_FLAG_NONE &&
+        (static_cast<uint32_t>(flag) & MediaAVCodec::AVCODEC_BUFFER_FLAG_CODEC_DATA) == 0) {
+        keyFrameRequestUs_.store(0);
+    }
     bufferOutput->SetInt32(INDEX, index_);
+    bufferOutput->SetInt32(TEMPORAL_LAYER, GetTemporalLayer(flag));
+    {
+        // Only tagged after a switch, so a source that never sees one keeps its configured resolution
+        std::lock_guard<std::mutex> lck(resolutionMutex_);
+        if (isResolutionSwitched_) {
+            bufferOutput->SetInt32(ENCODE_WIDTH, encodeConfig_.GetWidth());
+            bufferOutput->SetInt32(ENCODE_HEIGHT, encodeConfig_.GetHeight());
+        }
+    }
     index_++;
     std::vector<std::shared_ptr<DataBuffer>> nextInputBuffers;
     nextInputBuffers.push_back(bufferOutput);
@@ -658,6 +725,20 @@ int32_t EncodeDataProcess::GetProperty(const std::string& propertyName, Property
     return propertyCarrier.CarrySurfaceProperty(encodeProducerSurface_);
 }
 
+void EncodeDataProcess::CheckSurfaceInUse(MediaAVCodec::AVCodecBufferFlag flag)
+{
+    // GetProperty always hands out the surface, only a frame the raw path did not feed shows the camera writes it
+    if (isSurfaceInUse_.load() || isRawInputFed_.load() ||
+        (static_cast<uint32_t>(flag) & MediaAVCodec::AVCODEC_BUFFER_FLAG_CODEC_DATA) != 0) {
+        return;
+    }
+    isSurfaceInUse_.store(true);
+    std::lock_guard<std::mutex> lck(resolutionMutex_);
+    pendingWidth_ = 0;
+    pendingHeight_ = 0;
+    DHLOGI("%{public}s", "The camera writes the encoder surface, encode resolution switching is disabled.");
+}
+
 int32_t EncodeDataProcess::AdjustBitrateBasedOnNetworkConditions(bool isUp)
 {
     DHLOGI("adjust bitrate enter,current bitrate: %{public}" PRId64, currentBitrate_);
@@ -729,6 +810,10 @@ void EncodeDataProcess::SyncEncodeBufferThread()
         } else if (isKeyFrame && isSkipState_.load() && lastKeyFrameIndex_.load() != curKeyFrameIndex_.load()) {
             isSkipState_.store(false);
         }
+        if (!IsLayerSendable(GetBufferLayer(buffer))) {
+            shedFrameNum_++;
+            continue;
+        }
         int32_t ret = OnProcessedEncodeVideoBuffer(buffer, isKeyFrame);
         if (ret == DCAMERA_OK) {
             std::unique_lock<std::mutex> lock(encodeBuffersMutex_);
@@ -773,17 +858,27 @@ int32_t EncodeDataProcess::OnProcessedEncodeVideoBuffer(std::shared_ptr<DataBuff
         DHLOGE("targetPipelineSink is nullptr");
         return DCAMERA_BAD_OPERATE;
     }
+    size_t encodeSize = encodeBuffer->Size();
     int32_t ret = targetPipelineSink->OnProcessedVideoBuffer(encodeBuffer);
     if (ret == DCAMERA_OK) {
         SyncVideoFrameSuccess(isKeyFrame);
+        AdaptResolution(encodeSize, false);
     } else if (ret == DCAMERA_TRANS_BUSY) {
         SyncVideoFrameFailure(encodeBuffer);
+        AdaptResolution(0, true);
     }
     return ret;
 }
 
 void EncodeDataProcess::SyncVideoFrameSuccess(bool isKeyFrame)
 {
+    layerSuccNum_++;
+    if (layerSuccNum_ >= TEMPORAL_LAYER_RECOVER_FRAMES && maxSendLayer_.load() < TEMPORAL_TOP_LAYER) {
+        // Takes effect from the next base layer frame, so no frame misses its reference
+        maxSendLayer_++;
+        layerSuccNum_ = 0;
+        DHLOGI("raise send layer to %{public}d, shed frames %{public}" PRIu64, maxSendLayer_.load(), shedFrameNum_);
+    }
     if (isKeyFrame) {
         syncKeyFrameSuccNum_++;
         DHLOGI("sync keyFrame num_ %{public}d.", syncKeyFrameSuccNum_);
@@ -799,6 +894,19 @@ void EncodeDataProcess::SyncVideoFrameSuccess(bool isKeyFrame)
 void EncodeDataProcess::SyncVideoFrameFailure(std::shared_ptr<DataBuffer>& encodeBuffer)
 {
     syncKeyFrameSuccNum_ = 0;
+    layerSuccNum_ = 0;
+    int32_t layer = GetBufferLayer(encodeBuffer);
+    if (layer > TEMPORAL_BASE_LAYER) {
+        // Drop the enhancement frame, and every frame of this temporal group that may reference it
+        gopSendLayer_ = layer - 1;
+        if (maxSendLayer_.load() > gopSendLayer_) {
+            maxSendLayer_.store(gopSendLayer_);
+            DHLOGI("reduce send layer to %{public}d.", gopSendLayer_);
+        }
+        shedFrameNum_++;
+        return;
+    }
+    maxSendLayer_.store(TEMPORAL_BASE_LAYER);
     int32_t currentSize = 0;
     {
         std::unique_lock<std::mutex> lock(encodeBuffersMutex_);
@@ -816,6 +924,12 @@ void EncodeDataProcess::SyncVideoFrameFailure(std::shared_ptr<DataBuffer>& encod
 
     {
         std::unique_lock<std::mutex> lock(encodeBuffersMutex_);
+        ShedEnhancementLayers();
+        currentSize = static_cast<int32_t>(encodeBuffers_.size());
+        if (currentSize < (maxFrameRate_ / SYNCQUEUE_DIVIDE_TWO)) {
+            DHLOGI("shed enhancement layers, current encodebuffer size %{public}d.", currentSize);
+            return;
+        }
         std::deque<std::shared_ptr<DataBuffer>> tempQueue;
         for (const auto& dataBuffer : encodeBuffers_) {
             if (dataBuffer && IsKeyFrame(dataBuffer)) {
@@ -828,6 +942,54 @@ void EncodeDataProcess::SyncVideoFrameFailure(std::shared_ptr<DataBuffer>& encod
     }
 }
 
+void EncodeDataProcess::ShedEnhancementLayers()
+{
+    std::deque<std::shared_ptr<DataBuffer>> tempQueue;
+    for (const auto& dataBuffer : encodeBuffers_) {
+        if (dataBuffer != nullptr && GetBufferLayer(dataBuffer) == TEMPORAL_BASE_LAYER) {
+            tempQueue.push_back(dataBuffer);
+        }
+    }
+    shedFrameNum_ += encodeBuffers_.size() - tempQueue.size();
+    encodeBuffers_ = std::move(tempQueue);
+}
+
+int32_t EncodeDataProcess::GetTemporalLayer(MediaAVCodec::AVCodecBufferFlag flag)
+{
+    uint32_t flagBits = static_cast<uint32_t>(flag);
+    if (!isTemporalScalable_ || (flagBits & MediaAVCodec::AVCODEC_BUFFER_FLAG_CODEC_DATA) != 0) {
+        return TEMPORAL_BASE_LAYER;
+    }
+    if (flag != MediaAVCodec::AVCODEC_BUFFER_FLAG_NONE) {
+        temporalGopPos_ = 0;
+    }
+    // Uniformly scaled structure: position 0 is the base layer, each halving of the step adds a layer
+    int32_t layer = TEMPORAL_BASE_LAYER;
+    for (int32_t step = TEMPORAL_GOP_SIZE; step > 1 && temporalGopPos_ % step != 0; step /= TEMPORAL_LAYER_RATIO) {
+        layer++;
+    }
+    temporalGopPos_ = (temporalGopPos_ + 1) % TEMPORAL_GOP_SIZE;
+    return layer;
+}
+
+int32_t EncodeDataProcess::GetBufferLayer(const std::shared_ptr<DataBuffer>& buffer)
+{
+    int32_t layer = TEMPORAL_BASE_LAYER;
+    if (!buffer->FindInt32(TEMPORAL_LAYER, layer)) {
+        return TEMPORAL_BASE_LAYER;
+    }
+    return layer;
+}
+
+bool EncodeDataProcess::IsLayerSendable(int32_t layer)
+{
+    if (layer == TEMPORAL_BASE_LAYER) {
+        gopSendLayer_ = maxSendLayer_.load();
+        return true;
+    }
+    return layer <= gopSendLayer_;
+}
+
 int64_t EncodeDataProcess::RoundBitrates(int64_t tempBitrate)
 {
     if (tempBitrate < minBitrate_) {
@@ -843,5 +1005,202 @@ int32_t EncodeDataProcess::UpdateSettings(const std::shared_ptr<Camera::CameraMe
 {
     return DCAMERA_OK;
 }
+
+int32_t EncodeDataProcess::RequestKeyFrame()
+{
+    CHECK_AND_RETURN_RET_LOG(videoEncoder_ == nullptr, DCAMERA_BAD_OPERATE, "RequestKeyFrame videoEncoder is null.");
+    int64_t nowUs = GetNowTimeStampUs();
+    int64_t requestUs = keyFrameRequestUs_.load();
+    if (requestUs != 0 && nowUs - requestUs < KEY_FRAME_REQUEST_PENDING_US) {
+        DHLOGD("Key frame already requested, wait for it.");
+        return DCAMERA_OK;
+    }
+    Media::Format format{};
+    format.PutIntValue("req-i-frame", 1);
+    int32_t ret = videoEncoder_->SetParameter(format);
+    if (ret != MediaAVCodec::AVCodecServiceErrCode::AVCS_ERR_OK) {
+        DHLOGE("Request key frame from video encoder failed. Error code: %{public}d", ret);
+        return DCAMERA_BAD_OPERATE;
+    }
+    keyFrameRequestUs_.store(nowUs);
+    DHLOGI("Request key frame from video encoder success.");
+    return DCAMERA_OK;
+}
+
+int32_t EncodeDataProcess::SwitchResolution(int32_t width, int32_t height)
+{
+    CHECK_AND_RETURN_RET_LOG(videoEncoder_ == nullptr, DCAMERA_BAD_OPERATE, "%{public}s",
+        "SwitchResolution videoEncoder is null.");
+    // The camera writes the encoder surface directly at the configured resolution
+    CHECK_AND_RETURN_RET_LOG(isSurfaceInUse_.load(), DCAMERA_BAD_OPERATE, "%{public}s",
+        "The encoder surface is owned by the camera, can not switch resolution.");
+#ifdef DCAMERA_MMAP_RESERVE
+    CHECK_AND_RETURN_RET_LOG(sourceConfig_.GetVideoformat() == Videoformat::RGBA_8888, DCAMERA_BAD_TYPE,
+        "%{public}s", "Switch resolution does not support RGBA input.");
+    bool isValid = width >= MIN_VIDEO_WIDTH && width <= sourceConfig_.GetWidth() && height >= MIN_VIDEO_HEIGHT &&
+        height <= sourceConfig_.GetHeight() && width % RESOLUTION_STEP_ALIGNMENT == 0 &&
+        height % RESOLUTION_STEP_ALIGNMENT == 0;
+    CHECK_AND_RETURN_RET_LOG(!isValid, DCAMERA_BAD_VALUE, "Invalid encode resolution %{public}dx%{public}d.",
+        width, height);
+    std::lock_guard<std::mutex> lck(resolutionMutex_);
+    pendingWidth_ = width;
+    pendingHeight_ = height;
+    DHLOGI("Switch encode resolution to %{public}dx%{public}d from the next input frame.", width, height);
+    return DCAMERA_OK;
+#else
+    DHLOGE("Switch resolution to %{public}dx%{public}d is not supported without the image converter.", width, height);
+    return DCAMERA_BAD_OPERATE;
+#endif
+}
+
+bool EncodeDataProcess::IsEncodeScaled()
+{
+    return encodeConfig_.GetWidth() != sourceConfig_.GetWidth() ||
+        encodeConfig_.GetHeight() != sourceConfig_.GetHeight();
+}
+
+int32_t EncodeDataProcess::ApplyPendingResolution()
+{
+    int32_t width = 0;
+    int32_t height = 0;
+    {
+        std::lock_guard<std::mutex> lck(resolutionMutex_);
+        width = pendingWidth_;
+        height = pendingHeight_;
+        pendingWidth_ = 0;
+        pendingHeight_ = 0;
+    }
+    if (width == 0 || (width == encodeConfig_.GetWidth() && height == encodeConfig_.GetHeight())) {
+        return DCAMERA_OK;
+    }
+    DHLOGI("Restart video encoder, resolution %{public}dx%{public}d -> %{public}dx%{public}d.",
+        encodeConfig_.GetWidth(), encodeConfig_.GetHeight(), width, height);
+    VideoConfigParams lastConfig = encodeConfig_;
+    ReleaseVideoEncoder();
+    {
+        std::lock_guard<std::mutex> lck(resolutionMutex_);
+        encodeConfig_.SetWidthAndHeight(width, height);
+        // Scaled frames are converted to I420 before they are fed to the encoder
+        encodeConfig_.SetVideoformat(IsEncodeScaled() ? Videoformat::YUVI420 : sourceConfig_.GetVideoformat());
+        isResolutionSwitched_ = true;
+    }
+    metadataFormat_ = Media::Format();
+    isMinBitrate_.store(false);
+    isMaxBitrate_.store(false);
+    int32_t ret = InitEncoder();
+    if (ret == DCAMERA_OK) {
+        return DCAMERA_OK;
+    }
+    DHLOGE("Init video encoder at %{public}dx%{public}d failed, restore %{public}dx%{public}d.", width, height,
+        lastConfig.GetWidth(), lastConfig.GetHeight());
+    ReleaseVideoEncoder();
+    {
+        std::lock_guard<std::mutex> lck(resolutionMutex_);
+        encodeConfig_ = lastConfig;
+    }
+    metadataFormat_ = Media::Format();
+    return InitEncoder();
+}
+
+int32_t EncodeDataProcess::ScaleEncoderInputBuffer(const std::shared_ptr<DataBuffer>& inputBuffer,
+    const sptr<SurfaceBuffer>& surfacebuffer)
+{
+#ifdef DCAMERA_MMAP_RESERVE
+    int32_t srcWidth = sourceConfig_.GetWidth();
+    int32_t srcHeight = sourceConfig_.GetHeight();
+    int32_t srcStrideUV = srcWidth / Y2UV_RATIO;
+    size_t srcSizeY = static_cast<size_t>(srcWidth * srcHeight);
+    size_t srcSizeUV = static_cast<size_t>(srcStrideUV * (srcHeight / Y2UV_RATIO));
+    CHECK_AND_RETURN_RET_LOG(inputBuffer->Size() < srcSizeY * YUV_BYTES_PER_PIXEL / Y2UV_RATIO, DCAMERA_BAD_VALUE,
+        "Encoder input buffer size %{public}zu error.", inputBuffer->Size());
+    int32_t dstWidth = encodeConfig_.GetWidth();
+    int32_t dstHeight = encodeConfig_.GetHeight();
+    int32_t dstStrideY = surfacebuffer->GetStride();
+    int32_t dstStrideUV = dstStrideY / Y2UV_RATIO;
+    size_t dstSizeY = static_cast<size_t>(dstStrideY * dstHeight);
+    size_t dstSizeUV = static_cast<size_t>(dstStrideUV * (dstHeight / Y2UV_RATIO));
+    CHECK_AND_RETURN_RET_LOG(dstStrideY < dstWidth ||
+        static_cast<size_t>(surfacebuffer->GetSize()) < dstSizeY + dstSizeUV * Y2UV_RATIO, DCAMERA_BAD_VALUE,
+        "Encoder surface buffer stride %{public}d size %{public}u error.", dstStrideY, surfacebuffer->GetSize());
+    auto converter = ConverterHandle::GetInstance().GetHandle();
+    CHECK_AND_RETURN_RET_LOG(converter.NV12ToI420 == nullptr || converter.I420Scale == nullptr, DCAMERA_BAD_OPERATE,
+        "%{public}s", "converter is invalid.");
+
+    uint8_t *srcDataY = inputBuffer->Data();
+    uint8_t *srcDataU = srcDataY + srcSizeY;
+    uint8_t *srcDataV = srcDataU + srcSizeUV;
+    if (sourceConfig_.GetVideoformat() != Videoformat::YUVI420) {
+        scaleBuffer_.resize(srcSizeY + srcSizeUV * Y2UV_RATIO);
+        uint8_t *dataY = scaleBuffer_.data();
+        uint8_t *dataU = dataY + srcSizeY;
+        uint8_t *dataV = dataU + srcSizeUV;
+        // NV21 interleaves V before U, swapping the output planes gives I420
+        bool isNV21 = sourceConfig_.GetVideoformat() == Videoformat::NV21;
+        int32_t ret = converter.NV12ToI420(srcDataY, srcWidth, srcDataY + srcSizeY, srcWidth, dataY, srcWidth,
+            isNV21 ? dataV : dataU, srcStrideUV, isNV21 ? dataU : dataV, srcStrideUV, srcWidth, srcHeight);
+        CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, DCAMERA_BAD_OPERATE,
+            "Convert encoder input to I420 failed. ret %{public}d.", ret);
+        srcDataY = dataY;
+        srcDataU = dataU;
+        srcDataV = dataV;
+    }
+    uint8_t *dstDataY = static_cast<uint8_t *>(surfacebuffer->GetVirAddr());
+    uint8_t *dstDataU = dstDataY + dstSizeY;
+    uint8_t *dstDataV = dstDataU + dstSizeUV;
+    int32_t ret = converter.I420Scale(srcDataY, srcWidth, srcDataU, srcStrideUV, srcDataV, srcStrideUV,
+        srcWidth, srcHeight, dstDataY, dstStrideY, dstDataU, dstStrideUV, dstDataV, dstStrideUV,
+        dstWidth, dstHeight, OpenSourceLibyuv::FilterMode::kFilterBilinear);
+    CHECK_AND_RETURN_RET_LOG(ret != DCAMERA_OK, DCAMERA_BAD_OPERATE,
+        "Scale encoder input failed. ret %{public}d.", ret);
+    return DCAMERA_OK;
+#else
+    return DCAMERA_BAD_OPERATE;
+#endif
+}
+
+void EncodeDataProcess::InitResolutionPolicy()
+{
+    std::vector<ResolutionStep> steps;
+#ifdef DCAMERA_MMAP_RESERVE
+    if (sourceConfig_.GetVideoformat() != Videoformat::RGBA_8888) {
+        for (int32_t i = 0; i < RESOLUTION_STEP_NUM; i++) {
+            int32_t scale = RESOLUTION_STEP_DENOMINATOR - i;
+            ResolutionStep step;
+            step.width = sourceConfig_.GetWidth() * scale / RESOLUTION_STEP_DENOMINATOR;
+            step.height = sourceConfig_.GetHeight() * scale / RESOLUTION_STEP_DENOMINATOR;
+            step.width -= step.width % RESOLUTION_STEP_ALIGNMENT;
+            step.height -= step.height % RESOLUTION_STEP_ALIGNMENT;
+            if (step.width < MIN_VIDEO_WIDTH || step.height < MIN_VIDEO_HEIGHT) {
+                break;
+            }
+            step.minBitrate = GetMatchedBitrate(static_cast<int64_t>(step.width * step.height)) /
+                MINIMUM_BITRATE_FACTOR;
+            steps.push_back(step);
+        }
+    }
+#endif
+    resolutionPolicy_.Init(steps, GetNowTimeStampUs());
+}
+
+void EncodeDataProcess::AdaptResolution(size_t sentBytes, bool isBusy)
+{
+    if (isSurfaceInUse_.load() || !resolutionPolicy_.IsEnabled()) {
+        return;
+    }
+    int64_t nowUs = GetNowTimeStampUs();
+    if (isBusy) {
+        resolutionPolicy_.OnFrameBusy(nowUs);
+    } else {
+        resolutionPolicy_.OnFrameSent(sentBytes, nowUs);
+    }
+    ResolutionStep step;
+    if (!resolutionPolicy_.PollStep(step)) {
+        return;
+    }
+    if (SwitchResolution(step.width, step.height) != DCAMERA_OK) {
+        DHLOGE("Switch resolution failed, disable resolution adaptation.");
+        resolutionPolicy_.Disable();
+    }
+}
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "encode_resolution_policy.h"
+
+#include <cinttypes>
+
+#include "distributed_hardware_log.h"
+
+#ifndef DH_LOG_TAG
+#define DH_LOG_TAG "DCDP_NODE_ENCODEC"
+#endif
+
+namespace OHOS {
+namespace DistributedHardware {
+void EncodeResolutionPolicy::Init(const std::vector<ResolutionStep>& steps, int64_t nowUs)
+{
+    steps_ = steps;
+    curStep_ = 0;
+    pendingStep_ = NO_PENDING_STEP;
+    windowStartUs_ = nowUs;
+    windowBytes_ = 0;
+    windowBusyNum_ = 0;
+    cleanWindows_ = 0;
+    holdWindows_ = 0;
+    throughputBps_ = 0;
+}
+
+void EncodeResolutionPolicy::OnFrameSent(size_t bytes, int64_t nowUs)
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    windowBytes_ += static_cast<int64_t>(bytes);
+    UpdateWindow(nowUs);
+}
+
+void EncodeResolutionPolicy::OnFrameBusy(int64_t nowUs)
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    windowBusyNum_++;
+    UpdateWindow(nowUs);
+}
+
+bool EncodeResolutionPolicy::PollStep(ResolutionStep& step)
+{
+    if (pendingStep_ == NO_PENDING_STEP) {
+        return false;
+    }
+    curStep_ = pendingStep_;
+    pendingStep_ = NO_PENDING_STEP;
+    cleanWindows_ = 0;
+    holdWindows_ = STEP_HOLD_WINDOWS;
+    step = steps_[curStep_];
+    return true;
+}
+
+bool EncodeResolutionPolicy::IsEnabled() const
+{
+    return steps_.size() > 1;
+}
+
+void EncodeResolutionPolicy::Disable()
+{
+    steps_.clear();
+    pendingStep_ = NO_PENDING_STEP;
+}
+
+int64_t EncodeResolutionPolicy::GetThroughputBps() const
+{
+    return throughputBps_;
+}
+
+void EncodeResolutionPolicy::UpdateWindow(int64_t nowUs)
+{
+    if (windowStartUs_ == 0 || nowUs < windowStartUs_) {
+        windowStartUs_ = nowUs;
+        return;
+    }
+    if (nowUs - windowStartUs_ >= THROUGHPUT_WINDOW_US) {
+        CloseWindow(nowUs);
+    }
+}
+
+void EncodeResolutionPolicy::CloseWindow(int64_t nowUs)
+{
+    int64_t elapsedUs = nowUs - windowStartUs_;
+    throughputBps_ = windowBytes_ * BITS_PER_BYTE * US_PER_SECOND / elapsedUs;
+    bool isCongested = windowBusyNum_ > 0;
+    windowStartUs_ = nowUs;
+    windowBytes_ = 0;
+    windowBusyNum_ = 0;
+    // Let the encoder and the bitrate control settle after a switch before judging again
+    if (holdWindows_ > 0 || pendingStep_ != NO_PENDING_STEP) {
+        holdWindows_ = (holdWindows_ > 0) ? holdWindows_ - 1 : 0;
+        return;
+    }
+    int32_t lastStep = static_cast<int32_t>(steps_.size()) - 1;
+    if (isCongested) {
+        cleanWindows_ = 0;
+        if (curStep_ < lastStep && throughputBps_ < steps_[curStep_].minBitrate) {
+            pendingStep_ = curStep_ + 1;
+            DHLOGI("throughput %{public}" PRId64 " below %{public}" PRId64 ", step down to %{public}dx%{public}d.",
+                throughputBps_, steps_[curStep_].minBitrate, steps_[pendingStep_].width,
+                steps_[pendingStep_].height);
+        }
+        return;
+    }
+    cleanWindows_++;
+    if (curStep_ > 0 && cleanWindows_ >= STEP_UP_CLEAN_WINDOWS &&
+        throughputBps_ >= steps_[curStep_ - 1].minBitrate) {
+        pendingStep_ = curStep_ - 1;
+        DHLOGI("throughput %{public}" PRId64 " reaches %{public}" PRId64 ", step up to %{public}dx%{public}d.",
+            throughputBps_, steps_[pendingStep_].minBitrate, steps_[pendingStep_].width,
+            steps_[pendingStep_].height);
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -38,6 +38,10 @@ int32_t ScaleConvertProcess::InitNode(const VideoConfigParams& sourceConfig, con
     DHLOGI("ScaleConvertProcess : InitNode.");
     sourceConfig_ = sourceConfig;
     targetConfig_ = targetConfig;
+    std::shared_ptr<DCameraPipelineSource> pipelineSource = callbackPipelineSource_.lock();
+    if (pipelineSource != nullptr) {
+        nodeStats_ = pipelineSource->RegisterNodeStats("scale");
+    }
     processedConfig_ = sourceConfig;
     processedConfig_.SetWidthAndHeight(targetConfig.GetWidth(), targetConfig.GetHeight());
     processedConfig_.SetVideoformat(targetConfig.GetVideoformat());
@@ -72,6 +76,38 @@ bool ScaleConvertProcess::IsConvertible(const VideoConfigParams& sourceConfig, c
         (sourceConfig_.GetVideoformat() != targetConfig.GetVideoformat());
 }
 
+int32_t ScaleConvertProcess::UpdateSourceResolution(const std::shared_ptr<DataBuffer>& imgBuf)
+{
+    int32_t width = 0;
+    int32_t height = 0;
+    if (!imgBuf->FindInt32("width", width) || !imgBuf->FindInt32("height", height) ||
+        (width == sourceConfig_.GetWidth() && height == sourceConfig_.GetHeight())) {
+        return DCAMERA_OK;
+    }
+    CHECK_AND_RETURN_RET_LOG(width <= 0 || height <= 0, DCAMERA_BAD_VALUE,
+        "Invalid source resolution %{public}dx%{public}d.", width, height);
+    // The decoder switched resolution on a key frame, the output stays at the size the HDI configured
+    DHLOGI("Source resolution %{public}dx%{public}d -> %{public}dx%{public}d, target %{public}dx%{public}d.",
+        sourceConfig_.GetWidth(), sourceConfig_.GetHeight(), width, height, processedConfig_.GetWidth(),
+        processedConfig_.GetHeight());
+    std::lock_guard<std::mutex> autoLock(scaleMutex_);
+    sourceConfig_.SetWidthAndHeight(width, height);
+    if (targetConfig_.GetVideoformat() != Videoformat::P010) {
+        return DCAMERA_OK;
+    }
+    if (swsContext_ != nullptr) {
+        sws_freeContext(swsContext_);
+        swsContext_ = nullptr;
+    }
+    swsContext_ = sws_getContext(sourceConfig_.GetWidth(), sourceConfig_.GetHeight(),
+        GetAVPixelFormat(sourceConfig_.GetVideoformat()), processedConfig_.GetWidth(), processedConfig_.GetHeight(),
+        GetAVPixelFormat(targetConfig_.GetVideoformat()), SWS_FAST_BILINEAR | SWS_FULL_CHR_H_INT, nullptr, nullptr,
+        nullptr);
+    CHECK_AND_RETURN_RET_LOG(swsContext_ == nullptr, DCAMERA_MEMORY_OPT_ERROR,
+        "Failed to create sws context for P010 conversion");
+    return DCAMERA_OK;
+}
+
 void ScaleConvertProcess::ReleaseProcessNode()
 {
     DHLOGI("Start release [%{public}zu] node : ScaleConvertNode.", nodeRank_);
@@ -188,8 +224,15 @@ int ScaleConvertProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>& i
         DHLOGE("The input data buffers is empty.");
         return DCAMERA_BAD_VALUE;
     }
+    if (nodeStats_ != nullptr) {
+        nodeStats_->AddInput(inputBuffers[0]->Size());
+    }
     inputBuffers[0]->frameInfo_.timePonit.startScale = startScaleTime;
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, DUMP_DCAMERA_AFTER_SCALE_FILENAME, &dumpFile_);
+    if (UpdateSourceResolution(inputBuffers[0]) != DCAMERA_OK) {
+        DHLOGE("ScaleConvertProcess : update source resolution failed.");
+        return DCAMERA_BAD_VALUE;
+    }
 
     if (!IsConvertible(sourceConfig_, processedConfig_)) {
         DHLOGD("The target resolution: %{public}dx%{public}d format: %{public}d is the same as the source "
@@ -545,6 +588,9 @@ int32_t ScaleConvertProcess::ConvertDone(std::vector<std::shared_ptr<DataBuffer>
         return DCAMERA_BAD_VALUE;
     }
     outputBuffers[0]->frameInfo_.timePonit.finishScale = finishScaleTime;
+    if (nodeStats_ != nullptr) {
+        nodeStats_->AddOutput(outputBuffers[0]->Size());
+    }
 
     if (nextDataProcess_ != nullptr) {
         DHLOGD("Send to the next node of the scale convert for processing.");
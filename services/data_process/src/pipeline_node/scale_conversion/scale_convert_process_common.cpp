@@ -38,6 +38,10 @@ int32_t ScaleConvertProcess::InitNode(const VideoConfigParams& sourceConfig, con
     DHLOGI("ScaleConvertProcess : InitNode.");
     sourceConfig_ = sourceConfig;
     targetConfig_ = targetConfig;
+    std::shared_ptr<DCameraPipelineSource> pipelineSource = callbackPipelineSource_.lock();
+    if (pipelineSource != nullptr) {
+        nodeStats_ = pipelineSource->RegisterNodeStats("scale");
+    }
     processedConfig_ = sourceConfig;
     processedConfig_.SetWidthAndHeight(targetConfig.GetWidth(), targetConfig.GetHeight());
     processedConfig_.SetVideoformat(targetConfig.GetVideoformat());
@@ -85,6 +89,53 @@ bool ScaleConvertProcess::IsConvertible(const VideoConfigParams& sourceConfig, c
         (sourceConfig_.GetVideoformat() != targetConfig.GetVideoformat());
 }
 
+int32_t ScaleConvertProcess::UpdateSourceResolution(const std::shared_ptr<DataBuffer>& imgBuf)
+{
+    int32_t width = 0;
+    int32_t height = 0;
+    if (!imgBuf->FindInt32("width", width) || !imgBuf->FindInt32("height", height) ||
+        (width == sourceConfig_.GetWidth() && height == sourceConfig_.GetHeight())) {
+        return DCAMERA_OK;
+    }
+    CHECK_AND_RETURN_RET_LOG(width <= 0 || height <= 0 || width > MAX_IMG_SIZE || height > MAX_IMG_SIZE,
+        DCAMERA_BAD_VALUE, "Invalid source resolution %{public}dx%{public}d.", width, height);
+    // The decoder switched resolution on a key frame, the output stays at the size the HDI configured
+    DHLOGI("Source resolution %{public}dx%{public}d -> %{public}dx%{public}d, target %{public}dx%{public}d.",
+        sourceConfig_.GetWidth(), sourceConfig_.GetHeight(), width, height, processedConfig_.GetWidth(),
+        processedConfig_.GetHeight());
+    std::lock_guard<std::mutex> autoLock(scaleMutex_);
+    if (swsContext_ != nullptr) {
+        av_freep(&srcData_[0]);
+        av_freep(&dstData_[0]);
+        sws_freeContext(swsContext_);
+        swsContext_ = nullptr;
+    }
+    sourceConfig_.SetWidthAndHeight(width, height);
+    if (!IsConvertible(sourceConfig_, processedConfig_)) {
+        return DCAMERA_OK;
+    }
+    int32_t ret = av_image_alloc(srcData_, srcLineSize_, sourceConfig_.GetWidth(), sourceConfig_.GetHeight(),
+        GetAVPixelFormat(sourceConfig_.GetVideoformat()), SOURCE_ALIGN);
+    CHECK_AND_RETURN_RET_LOG(ret < DCAMERA_OK, DCAMERA_BAD_VALUE, "%{public}s", "Could not allocate source image.");
+    dstBuffSize_ = av_image_alloc(dstData_, dstLineSize_, processedConfig_.GetWidth(), processedConfig_.GetHeight(),
+        GetAVPixelFormat(processedConfig_.GetVideoformat()), TARGET_ALIGN);
+    if (dstBuffSize_ < DCAMERA_OK) {
+        DHLOGE("Could not allocate destination image.");
+        av_freep(&srcData_[0]);
+        return DCAMERA_BAD_VALUE;
+    }
+    swsContext_ = sws_getContext(sourceConfig_.GetWidth(), sourceConfig_.GetHeight(),
+        GetAVPixelFormat(sourceConfig_.GetVideoformat()), processedConfig_.GetWidth(), processedConfig_.GetHeight(),
+        GetAVPixelFormat(processedConfig_.GetVideoformat()), SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+    if (swsContext_ == nullptr) {
+        DHLOGE("Create SwsContext failed.");
+        av_freep(&srcData_[0]);
+        av_freep(&dstData_[0]);
+        return DCAMERA_BAD_VALUE;
+    }
+    return DCAMERA_OK;
+}
+
 void ScaleConvertProcess::ReleaseProcessNode()
 {
     DHLOGI("Start release [%{public}zu] node : ScaleConvertNode.", nodeRank_);
@@ -120,8 +171,15 @@ int ScaleConvertProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>& i
         DHLOGE("The input data buffers is empty.");
         return DCAMERA_BAD_VALUE;
     }
+    if (nodeStats_ != nullptr) {
+        nodeStats_->AddInput(inputBuffers[0]->Size());
+    }
     inputBuffers[0]->frameInfo_.timePonit.startScale = startScaleTime;
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, DUMP_DCAMERA_AFTER_SCALE_FILENAME, &dumpFile_);
+    if (UpdateSourceResolution(inputBuffers[0]) != DCAMERA_OK) {
+        DHLOGE("ScaleConvertProcess : update source resolution failed.");
+        return DCAMERA_BAD_VALUE;
+    }
 
     if (!IsConvertible(sourceConfig_, processedConfig_)) {
         DHLOGD("The target resolution: %{public}dx%{public}d format: %{public}d is the same as the source "
@@ -386,6 +444,9 @@ int32_t ScaleConvertProcess::ConvertDone(std::vector<std::shared_ptr<DataBuffer>
         return DCAMERA_BAD_VALUE;
     }
     outputBuffers[0]->frameInfo_.timePonit.finishScale = finishScaleTime;
+    if (nodeStats_ != nullptr) {
+        nodeStats_->AddOutput(outputBuffers[0]->Size());
+    }
 
     if (nextDataProcess_ != nullptr) {
         DHLOGD("Send to the next node of the scale convert for processing.");
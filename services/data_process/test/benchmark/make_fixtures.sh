@@ -0,0 +1,39 @@
+#!/bin/bash
+# Copyright (c) 2026 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Writes the clips dcamera_sw_decoder_benchmark reads: 10 s of testsrc2 at 30 fps per resolution, coded the
+# way the sink encoder streams them, no B frames, one I frame per second, the bitrate of ENCODER_BITRATE_TABLE.
+# Needs an ffmpeg built with libx264 and libx265. Push the directory to the device and pass it to the benchmark.
+set -e
+
+OUT_DIR=${1:-dcamera_bench}
+FRAMES=300
+mkdir -p "${OUT_DIR}"
+
+make_clip() {
+    local width=$1
+    local height=$2
+    local bitrate=$3
+    local src="testsrc2=size=${width}x${height}:rate=30"
+    ffmpeg -loglevel error -y -f lavfi -i "${src}" -frames:v ${FRAMES} -pix_fmt yuv420p \
+        -c:v libx264 -profile:v main -preset veryfast -tune zerolatency -bf 0 -g 30 -b:v "${bitrate}" \
+        -f h264 "${OUT_DIR}/h264_${width}x${height}.h264"
+    ffmpeg -loglevel error -y -f lavfi -i "${src}" -frames:v ${FRAMES} -pix_fmt yuv420p \
+        -c:v libx265 -preset veryfast -tune zerolatency -x265-params "bframes=0:keyint=30" -b:v "${bitrate}" \
+        -f hevc "${OUT_DIR}/h265_${width}x${height}.h265"
+}
+
+make_clip 640 480 1800k
+make_clip 1280 720 3400k
+make_clip 1920 1080 6000k
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Drives SoftwareVideoDecoder over the Annex B clips make_fixtures.sh writes and prints the decode rate and the
+ * per access unit latency for each of them:
+ *
+ *     dcamera_sw_decoder_benchmark <fixture dir> [rounds] [threads] [frame]
+ *
+ * rounds replays every clip that many times, threads and frame override the codec threads and threading the
+ * persist.dcamera.decoder.sw.* parameters would give. Clips that are missing are skipped.
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "data_buffer.h"
+#include "dcamera_decoder_budget.h"
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+#include "securec.h"
+#include "software_video_decoder.h"
+
+using namespace OHOS::DistributedHardware;
+
+namespace {
+struct Fixture {
+    const char *codecName;
+    VideoCodecType codecType;
+    int32_t width;
+    int32_t height;
+};
+
+const Fixture FIXTURES[] = {
+    { "h264", VideoCodecType::CODEC_H264, 640, 480 },
+    { "h264", VideoCodecType::CODEC_H264, 1280, 720 },
+    { "h264", VideoCodecType::CODEC_H264, 1920, 1080 },
+    { "h265", VideoCodecType::CODEC_H265, 640, 480 },
+    { "h265", VideoCodecType::CODEC_H265, 1280, 720 },
+    { "h265", VideoCodecType::CODEC_H265, 1920, 1080 },
+};
+
+constexpr int32_t DEFAULT_ROUNDS = 5;
+constexpr size_t START_CODE_LEN = 3;
+constexpr uint8_t H264_NAL_TYPE_MASK = 0x1f;
+constexpr uint8_t H264_NAL_SLICE = 1;
+constexpr uint8_t H264_NAL_IDR = 5;
+constexpr uint8_t H264_NAL_SEI = 6;
+constexpr uint8_t H264_NAL_AUD = 9;
+constexpr uint8_t HEVC_NAL_TYPE_SHIFT = 1;
+constexpr uint8_t HEVC_NAL_TYPE_MASK = 0x3f;
+constexpr uint8_t HEVC_NAL_VCL_END = 32;
+constexpr uint8_t HEVC_NAL_AUD = 35;
+constexpr uint8_t HEVC_NAL_PREFIX_SEI = 39;
+constexpr size_t HEVC_NAL_HEADER_LEN = 2;
+// first_mb_in_slice == 0 and first_slice_segment_in_pic_flag are both the top bit right after the header
+constexpr uint8_t FIRST_SLICE_BIT = 0x80;
+constexpr int32_t PERCENT = 100;
+constexpr int32_t P99 = 99;
+constexpr double US_PER_SECOND = 1000000.0;
+
+bool ReadFile(const std::string& path, std::vector<uint8_t>& data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !data.empty();
+}
+
+size_t FindStartCode(const std::vector<uint8_t>& data, size_t from)
+{
+    for (size_t i = from; i + START_CODE_LEN <= data.size(); i++) {
+        if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+            return i;
+        }
+    }
+    return data.size();
+}
+
+// A VCL unit opens a new picture when it is its first slice, parameter sets, AUD and prefix SEI open one
+// only once the current access unit already holds a slice
+void ClassifyNal(VideoCodecType codecType, const uint8_t *nal, size_t len, bool& isVcl, bool& isPrefix,
+    bool& isFirstSlice)
+{
+    if (codecType == VideoCodecType::CODEC_H264) {
+        uint8_t type = nal[0] & H264_NAL_TYPE_MASK;
+        isVcl = (type >= H264_NAL_SLICE && type <= H264_NAL_IDR);
+        isPrefix = (type >= H264_NAL_SEI && type <= H264_NAL_AUD);
+        isFirstSlice = isVcl && len > 1 && (nal[1] & FIRST_SLICE_BIT) != 0;
+        return;
+    }
+    uint8_t type = (nal[0] >> HEVC_NAL_TYPE_SHIFT) & HEVC_NAL_TYPE_MASK;
+    isVcl = type < HEVC_NAL_VCL_END;
+    isPrefix = (type >= HEVC_NAL_VCL_END && type <= HEVC_NAL_AUD) || type == HEVC_NAL_PREFIX_SEI;
+    isFirstSlice = isVcl && len > HEVC_NAL_HEADER_LEN && (nal[HEVC_NAL_HEADER_LEN] & FIRST_SLICE_BIT) != 0;
+}
+
+// Splits an Annex B stream into the access units the encoder node hands to the channel, one per picture
+std::vector<std::shared_ptr<DataBuffer>> SplitAccessUnits(VideoCodecType codecType, const std::vector<uint8_t>& data)
+{
+    std::vector<std::shared_ptr<DataBuffer>> units;
+    size_t unitStart = FindStartCode(data, 0);
+    bool hasVcl = false;
+    size_t pos = unitStart;
+    while (pos < data.size()) {
+        size_t nalStart = pos + START_CODE_LEN;
+        size_t next = FindStartCode(data, nalStart);
+        // A four byte start code leaves its leading zero at the end of the previous unit
+        size_t nalEnd = (next < data.size() && next > nalStart && data[next - 1] == 0) ? next - 1 : next;
+        size_t codeStart = (pos > 0 && data[pos - 1] == 0) ? pos - 1 : pos;
+        bool isVcl = false;
+        bool isPrefix = false;
+        bool isFirstSlice = false;
+        if (nalEnd > nalStart) {
+            ClassifyNal(codecType, data.data() + nalStart, nalEnd - nalStart, isVcl, isPrefix, isFirstSlice);
+        }
+        if (hasVcl && (isPrefix || isFirstSlice) && codeStart > unitStart) {
+            auto unit = std::make_shared<DataBuffer>(codeStart - unitStart);
+            if (memcpy_s(unit->Data(), unit->Size(), data.data() + unitStart, codeStart - unitStart) == EOK) {
+                units.push_back(unit);
+            }
+            unitStart = codeStart;
+            hasVcl = false;
+        }
+        hasVcl = hasVcl || isVcl;
+        pos = next;
+    }
+    if (hasVcl && data.size() > unitStart) {
+        auto unit = std::make_shared<DataBuffer>(data.size() - unitStart);
+        if (memcpy_s(unit->Data(), unit->Size(), data.data() + unitStart, data.size() - unitStart) == EOK) {
+            units.push_back(unit);
+        }
+    }
+    return units;
+}
+
+void RunFixture(const std::string& dir, const Fixture& fixture, int32_t rounds)
+{
+    std::string name = std::string(fixture.codecName) + "_" + std::to_string(fixture.width) + "x" +
+        std::to_string(fixture.height) + "." + fixture.codecName;
+    std::vector<uint8_t> data;
+    if (!ReadFile(dir + "/" + name, data)) {
+        printf("%-22s skipped, not found\n", name.c_str());
+        return;
+    }
+    std::vector<std::shared_ptr<DataBuffer>> units = SplitAccessUnits(fixture.codecType, data);
+    SoftwareVideoDecoder decoder;
+    int32_t ret = decoder.Init(fixture.codecType, fixture.width, fixture.height, Videoformat::NV12);
+    if (ret != DCAMERA_OK || units.empty()) {
+        printf("%-22s skipped, init ret %d, %zu access units\n", name.c_str(), ret, units.size());
+        return;
+    }
+    std::vector<int64_t> latencies;
+    std::vector<std::shared_ptr<DataBuffer>> outputs;
+    int64_t pts = 0;
+    size_t pictures = 0;
+    int64_t totalUs = 0;
+    for (int32_t round = 0; round < rounds; round++) {
+        for (auto& unit : units) {
+            unit->frameInfo_.pts = pts++;
+            outputs.clear();
+            int64_t startUs = GetNowTimeStampUs();
+            ret = decoder.Decode(unit, outputs);
+            int64_t costUs = GetNowTimeStampUs() - startUs;
+            if (ret != DCAMERA_OK) {
+                DHLOGE("Benchmark decode %{public}s failed, ret %{public}d.", name.c_str(), ret);
+                continue;
+            }
+            latencies.push_back(costUs);
+            totalUs += costUs;
+            pictures += outputs.size();
+        }
+    }
+    if (latencies.empty() || totalUs <= 0) {
+        printf("%-22s no access unit was decoded\n", name.c_str());
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    printf("%-22s %6zu pictures  %2d threads  %8.1f fps  p50 %6" PRId64 " us  p99 %6" PRId64 " us\n",
+        name.c_str(), pictures, decoder.GetThreadNum(), pictures * US_PER_SECOND / totalUs,
+        latencies[latencies.size() / 2], latencies[latencies.size() * P99 / PERCENT]);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        printf("usage: %s <fixture dir> [rounds] [threads] [frame]\n", argv[0]);
+        return -1;
+    }
+    std::string dir = argv[1];
+    int32_t rounds = (argc > 2) ? std::max(atoi(argv[2]), 1) : DEFAULT_ROUNDS;
+    DCameraDecoderConfig config = DCameraDecoderBudget::GetInstance().GetConfig();
+    if (argc > 3) {
+        config.softwareThreads = std::max(atoi(argv[3]), 1);
+    }
+    if (argc > 4) {
+        config.frameThreading = (std::string(argv[4]) == "frame");
+    }
+    DCameraDecoderBudget::GetInstance().SetConfig(config);
+    for (const auto& fixture : FIXTURES) {
+        RunFixture(dir, fixture, rounds);
+    }
+    return 0;
+}
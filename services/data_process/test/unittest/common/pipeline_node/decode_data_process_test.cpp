@@ -18,6 +18,7 @@
 #define private public
 #include "decode_data_process.h"
 #undef private
+#include "dcamera_decoder_budget.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -43,6 +44,47 @@ const int32_t TEST_HEIGTH = 1080;
 const int32_t TEST_WIDTH2 = 640;
 const int32_t TEST_HEIGTH2 = 480;
 const int32_t SLEEP_TIME = 200000;
+const int32_t TEST_WIDTH3 = 320;
+const int32_t TEST_HEIGTH3 = 240;
+const int32_t TEST_FRAME_NUM = 2;
+const int64_t TEST_PTS = 1000;
+// One 320x240 IDR picture with its SPS and PPS, every pixel Y 200, U 64, V 160
+const uint8_t TEST_H264_IDR[] = {
+    0x00, 0x00, 0x00, 0x01, 0x67, 0x4d, 0x40, 0x0d, 0xdc, 0x14, 0x1f, 0xa1, 0x00, 0x00, 0x03, 0x00,
+    0x01, 0x00, 0x00, 0x03, 0x00, 0x3c, 0x8f, 0x14, 0x2b, 0x80, 0x00, 0x00, 0x00, 0x01, 0x68, 0xee,
+    0x06, 0xcb, 0x20, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x3f, 0xfe, 0xbd, 0x67, 0xe6, 0x59, 0x1c,
+    0xfd, 0xf4, 0xaf, 0x04, 0xc9, 0x79, 0xee, 0x18, 0x6f, 0x09, 0x5f, 0xf4, 0xba, 0x4c, 0x23, 0x14,
+    0x9f, 0x75, 0x93, 0xb6, 0xd5, 0x60, 0x00, 0x04, 0xe7, 0x8e, 0x6d, 0x09, 0xa6, 0x8d, 0x08, 0xe0,
+    0xce, 0x01, 0xc6, 0x00, 0x00, 0x54, 0x45, 0x7c, 0x0c, 0xae, 0x0b, 0x29, 0x04, 0x04, 0x0b, 0xd2,
+    0xba, 0x81
+};
+const uint8_t TEST_IDR_Y = 200;
+const uint8_t TEST_IDR_U = 64;
+
+class DecodeOutputNode : public AbstractDataProcess {
+public:
+    int32_t InitNode(const VideoConfigParams& sourceConfig, const VideoConfigParams& targetConfig,
+        VideoConfigParams& processedConfig) override
+    {
+        return DCAMERA_OK;
+    }
+    int32_t ProcessData(std::vector<std::shared_ptr<DataBuffer>>& inputBuffers) override
+    {
+        outputs_.insert(outputs_.end(), inputBuffers.begin(), inputBuffers.end());
+        return DCAMERA_OK;
+    }
+    void ReleaseProcessNode() override {}
+    int32_t GetProperty(const std::string& propertyName, PropertyCarrier& propertyCarrier) override
+    {
+        return DCAMERA_OK;
+    }
+    int32_t UpdateSettings(const std::shared_ptr<Camera::CameraMetadata> settings) override
+    {
+        return DCAMERA_OK;
+    }
+
+    std::vector<std::shared_ptr<DataBuffer>> outputs_;
+};
 }
 
 void DecodeDataProcessTest::SetUpTestCase(void)
@@ -1045,5 +1087,104 @@ HWTEST_F(DecodeDataProcessTest, decode_data_process_test_030, TestSize.Level1)
     EXPECT_EQ(rc, DCAMERA_OK);
 }
 #endif
+
+/**
+ * @tc.name: decode_data_process_test_031
+ * @tc.desc: Verify the decode node uses the software decoder when the backend is forced to software.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DecodeDataProcessTest, decode_data_process_test_031, TestSize.Level1)
+{
+    DHLOGI("DecodeDataProcessTest decode_data_process_test_031");
+    DCameraDecoderBudget& budget = DCameraDecoderBudget::GetInstance();
+    DCameraDecoderConfig oldConfig = budget.GetConfig();
+    DCameraDecoderConfig config = oldConfig;
+    config.backend = DCAMERA_DECODER_SOFTWARE;
+    budget.SetConfig(config);
+    VideoConfigParams srcParams(VideoCodecType::CODEC_H264, Videoformat::NV12, DCAMERA_PRODUCER_FPS_DEFAULT,
+        TEST_WIDTH2, TEST_HEIGTH2);
+    VideoConfigParams destParams(VideoCodecType::NO_CODEC, Videoformat::YUVI420, DCAMERA_PRODUCER_FPS_DEFAULT,
+        TEST_WIDTH2, TEST_HEIGTH2);
+    VideoConfigParams procConfig;
+    int32_t rc = testDecodeDataProcess_->InitNode(srcParams, destParams, procConfig);
+    EXPECT_EQ(rc, DCAMERA_OK);
+    EXPECT_EQ(testDecodeDataProcess_->videoDecoder_, nullptr);
+    EXPECT_NE(testDecodeDataProcess_->softwareDecoder_, nullptr);
+    EXPECT_GT(testDecodeDataProcess_->softwareLoad_, 0);
+
+    std::shared_ptr<SoftwareVideoDecoder> decoder = std::make_shared<SoftwareVideoDecoder>();
+    rc = decoder->Init(VideoCodecType::CODEC_H264, TEST_WIDTH2 + 1, TEST_HEIGTH2, Videoformat::YUVI420);
+    EXPECT_EQ(rc, DCAMERA_BAD_VALUE);
+    rc = decoder->Init(VideoCodecType::CODEC_H264, TEST_WIDTH2, TEST_HEIGTH2, Videoformat::RGBA_8888);
+    EXPECT_EQ(rc, DCAMERA_BAD_VALUE);
+
+    testDecodeDataProcess_->ReleaseProcessNode();
+    EXPECT_EQ(testDecodeDataProcess_->softwareDecoder_, nullptr);
+    EXPECT_EQ(testDecodeDataProcess_->softwareLoad_, -1);
+    budget.SetConfig(oldConfig);
+}
+
+/**
+ * @tc.name: decode_data_process_test_032
+ * @tc.desc: Verify a real H.264 access unit is decoded by DecodeSoftwareFrame and paired with its input by pts.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(DecodeDataProcessTest, decode_data_process_test_032, TestSize.Level1)
+{
+    DHLOGI("DecodeDataProcessTest decode_data_process_test_032");
+    DCameraDecoderBudget& budget = DCameraDecoderBudget::GetInstance();
+    DCameraDecoderConfig oldConfig = budget.GetConfig();
+    DCameraDecoderConfig config = oldConfig;
+    config.backend = DCAMERA_DECODER_SOFTWARE;
+    budget.SetConfig(config);
+    VideoConfigParams srcParams(VideoCodecType::CODEC_H264, Videoformat::NV12, DCAMERA_PRODUCER_FPS_DEFAULT,
+        TEST_WIDTH3, TEST_HEIGTH3);
+    VideoConfigParams destParams(VideoCodecType::NO_CODEC, Videoformat::YUVI420, DCAMERA_PRODUCER_FPS_DEFAULT,
+        TEST_WIDTH3, TEST_HEIGTH3);
+    VideoConfigParams procConfig;
+    int32_t rc = testDecodeDataProcess_->InitNode(srcParams, destParams, procConfig);
+    ASSERT_EQ(rc, DCAMERA_OK);
+    ASSERT_NE(testDecodeDataProcess_->softwareDecoder_, nullptr);
+    std::shared_ptr<DecodeOutputNode> outputNode = std::make_shared<DecodeOutputNode>();
+    testDecodeDataProcess_->nextDataProcess_ = outputNode;
+
+    // An input that completed no picture is dropped once a newer pts comes out
+    DCameraFrameInfo staleInfo;
+    staleInfo.pts = TEST_PTS - 1;
+    testDecodeDataProcess_->frameInfoDeque_.push_back(staleInfo);
+    uint32_t generation = testDecodeDataProcess_->softwareGeneration_.load();
+    for (int32_t i = 0; i < TEST_FRAME_NUM; i++) {
+        std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(sizeof(TEST_H264_IDR));
+        ASSERT_EQ(memcpy_s(buffer->Data(), buffer->Size(), TEST_H264_IDR, sizeof(TEST_H264_IDR)), EOK);
+        buffer->frameInfo_.index = i;
+        buffer->frameInfo_.pts = TEST_PTS + i;
+        // Accounted as ProcessSoftwareData does before it posts the frame
+        testDecodeDataProcess_->softwarePendingCount_++;
+        if (testDecodeDataProcess_->inputMemory_ != nullptr) {
+            testDecodeDataProcess_->inputMemory_->Add(buffer->Size());
+        }
+        testDecodeDataProcess_->DecodeSoftwareFrame(buffer, generation);
+    }
+
+    ASSERT_EQ(outputNode->outputs_.size(), static_cast<size_t>(TEST_FRAME_NUM));
+    size_t sizeY = static_cast<size_t>(TEST_WIDTH3 * TEST_HEIGTH3);
+    for (int32_t i = 0; i < TEST_FRAME_NUM; i++) {
+        std::shared_ptr<DataBuffer> output = outputNode->outputs_[i];
+        ASSERT_EQ(output->Size(), sizeY * DecodeDataProcess::YUV_BYTES_PER_PIXEL / DecodeDataProcess::Y2UV_RATIO);
+        EXPECT_EQ(output->Data()[0], TEST_IDR_Y);
+        EXPECT_EQ(output->Data()[sizeY - 1], TEST_IDR_Y);
+        EXPECT_EQ(output->Data()[sizeY], TEST_IDR_U);
+        EXPECT_EQ(output->frameInfo_.index, i);
+        EXPECT_EQ(output->frameInfo_.pts, TEST_PTS + i);
+        EXPECT_GE(output->frameInfo_.timePonit.finishDecode, output->frameInfo_.timePonit.startDecode);
+    }
+    EXPECT_TRUE(testDecodeDataProcess_->frameInfoDeque_.empty());
+    EXPECT_EQ(testDecodeDataProcess_->softwarePendingCount_.load(), 0);
+
+    testDecodeDataProcess_->ReleaseProcessNode();
+    budget.SetConfig(oldConfig);
+}
 } // namespace DistributedHardware
 } // namespace OHOS
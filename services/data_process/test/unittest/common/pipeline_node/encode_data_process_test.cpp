@@ -586,5 +586,97 @@ HWTEST_F(EncodeDataProcessTest, encode_data_process_test_019, TestSize.Level1)
     testEncodeDataProcess_->AdjustBitrateBasedOnNetworkConditions(true);
     EXPECT_EQ(testEncodeDataProcess_->currentBitrate_, 1800000);
 }
+/**
+ * @tc.name: encode_data_process_test_020
+ * @tc.desc: Verify the temporal layer labelling of the encoded frames.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(EncodeDataProcessTest, encode_data_process_test_020, TestSize.Level1)
+{
+    ASSERT_NE(testEncodeDataProcess_, nullptr);
+    testEncodeDataProcess_->isTemporalScalable_ = true;
+    testEncodeDataProcess_->temporalGopPos_ = 0;
+    EXPECT_EQ(TEMPORAL_BASE_LAYER,
+        testEncodeDataProcess_->GetTemporalLayer(MediaAVCodec::AVCODEC_BUFFER_FLAG_CODEC_DATA));
+    const std::vector<int32_t> layers = { 0, 2, 1, 2, 0, 2, 1 };
+    EXPECT_EQ(layers[0], testEncodeDataProcess_->GetTemporalLayer(MediaAVCodec::AVCODEC_BUFFER_FLAG_SYNC_FRAME));
+    for (size_t i = 1; i < layers.size(); i++) {
+        EXPECT_EQ(layers[i], testEncodeDataProcess_->GetTemporalLayer(MediaAVCodec::AVCODEC_BUFFER_FLAG_NONE));
+    }
+    // A key frame restarts the temporal group wherever it lands
+    EXPECT_EQ(TEMPORAL_BASE_LAYER,
+        testEncodeDataProcess_->GetTemporalLayer(MediaAVCodec::AVCODEC_BUFFER_FLAG_SYNC_FRAME));
+    EXPECT_EQ(layers[1], testEncodeDataProcess_->GetTemporalLayer(MediaAVCodec::AVCODEC_BUFFER_FLAG_NONE));
+
+    testEncodeDataProcess_->isTemporalScalable_ = false;
+    for (size_t i = 0; i < layers.size(); i++) {
+        EXPECT_EQ(TEMPORAL_BASE_LAYER,
+            testEncodeDataProcess_->GetTemporalLayer(MediaAVCodec::AVCODEC_BUFFER_FLAG_NONE));
+    }
+}
+
+/**
+ * @tc.name: encode_data_process_test_021
+ * @tc.desc: Verify a failed enhancement frame sheds its layer until the next base layer frame.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(EncodeDataProcessTest, encode_data_process_test_021, TestSize.Level1)
+{
+    ASSERT_NE(testEncodeDataProcess_, nullptr);
+    const int32_t topLayer = 2;
+    EXPECT_TRUE(testEncodeDataProcess_->IsLayerSendable(TEMPORAL_BASE_LAYER));
+    EXPECT_TRUE(testEncodeDataProcess_->IsLayerSendable(topLayer));
+
+    std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(1);
+    buffer->SetInt32(TEMPORAL_LAYER, topLayer);
+    testEncodeDataProcess_->SyncVideoFrameFailure(buffer);
+    EXPECT_EQ(topLayer - 1, testEncodeDataProcess_->maxSendLayer_.load());
+    EXPECT_TRUE(testEncodeDataProcess_->IsLayerSendable(topLayer - 1));
+    EXPECT_FALSE(testEncodeDataProcess_->IsLayerSendable(topLayer));
+
+    buffer->SetInt32(TEMPORAL_LAYER, topLayer - 1);
+    testEncodeDataProcess_->SyncVideoFrameFailure(buffer);
+    EXPECT_EQ(TEMPORAL_BASE_LAYER, testEncodeDataProcess_->maxSendLayer_.load());
+    EXPECT_FALSE(testEncodeDataProcess_->IsLayerSendable(topLayer - 1));
+    EXPECT_TRUE(testEncodeDataProcess_->IsLayerSendable(TEMPORAL_BASE_LAYER));
+
+    for (uint32_t i = 0; i < testEncodeDataProcess_->TEMPORAL_LAYER_RECOVER_FRAMES; i++) {
+        testEncodeDataProcess_->SyncVideoFrameSuccess(false);
+    }
+    EXPECT_EQ(topLayer - 1, testEncodeDataProcess_->maxSendLayer_.load());
+    // The raised layer only applies from the next base layer frame
+    EXPECT_FALSE(testEncodeDataProcess_->IsLayerSendable(topLayer - 1));
+    EXPECT_TRUE(testEncodeDataProcess_->IsLayerSendable(TEMPORAL_BASE_LAYER));
+    EXPECT_TRUE(testEncodeDataProcess_->IsLayerSendable(topLayer - 1));
+}
+/**
+ * @tc.name: encode_data_process_test_022
+ * @tc.desc: Verify the encoder surface only counts as used when the camera feeds it.
+ * @tc.type: FUNC
+ * @tc.require: Issue Number
+ */
+HWTEST_F(EncodeDataProcessTest, encode_data_process_test_022, TestSize.Level1)
+{
+    ASSERT_NE(testEncodeDataProcess_, nullptr);
+    const int32_t pendingWidth = 640;
+    testEncodeDataProcess_->CheckSurfaceInUse(MediaAVCodec::AVCODEC_BUFFER_FLAG_CODEC_DATA);
+    EXPECT_FALSE(testEncodeDataProcess_->isSurfaceInUse_.load());
+
+    testEncodeDataProcess_->isRawInputFed_.store(true);
+    testEncodeDataProcess_->CheckSurfaceInUse(MediaAVCodec::AVCODEC_BUFFER_FLAG_SYNC_FRAME);
+    EXPECT_FALSE(testEncodeDataProcess_->isSurfaceInUse_.load());
+
+    testEncodeDataProcess_->isRawInputFed_.store(false);
+    testEncodeDataProcess_->pendingWidth_ = pendingWidth;
+    testEncodeDataProcess_->CheckSurfaceInUse(MediaAVCodec::AVCODEC_BUFFER_FLAG_SYNC_FRAME);
+    EXPECT_TRUE(testEncodeDataProcess_->isSurfaceInUse_.load());
+    EXPECT_EQ(0, testEncodeDataProcess_->pendingWidth_);
+
+    testEncodeDataProcess_->ReleaseProcessNode();
+    EXPECT_FALSE(testEncodeDataProcess_->isSurfaceInUse_.load());
+    EXPECT_FALSE(testEncodeDataProcess_->isRawInputFed_.load());
+}
 } // namespace DistributedHardware
 } // namespace OHOS
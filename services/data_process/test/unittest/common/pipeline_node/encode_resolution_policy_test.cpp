@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "encode_resolution_policy.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class EncodeResolutionPolicyTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    EncodeResolutionPolicy policy_;
+};
+
+namespace {
+const int64_t TEST_START_US = 1000000;
+const int64_t TEST_FRAME_INTERVAL_US = 100000;
+const int32_t TEST_FRAMES_PER_WINDOW = 10;
+const int32_t TEST_HOLD_WINDOWS = 3;
+const int32_t TEST_STEP_UP_WINDOWS = 5;
+// 10 frames of 10000 bytes per second carry 800 kbps
+const size_t TEST_LOW_FRAME_BYTES = 10000;
+// 10 frames of 100000 bytes per second carry 8 Mbps
+const size_t TEST_HIGH_FRAME_BYTES = 100000;
+const std::vector<ResolutionStep> TEST_STEPS = {
+    { 1920, 1080, 2000000 },
+    { 1440, 810, 1500000 },
+    { 960, 540, 1000000 },
+};
+
+void RunWindow(EncodeResolutionPolicy& policy, int64_t& nowUs, size_t bytes, bool busy)
+{
+    for (int32_t i = 0; i < TEST_FRAMES_PER_WINDOW; i++) {
+        nowUs += TEST_FRAME_INTERVAL_US;
+        if (busy) {
+            policy.OnFrameBusy(nowUs);
+        }
+        policy.OnFrameSent(bytes, nowUs);
+    }
+}
+}
+
+void EncodeResolutionPolicyTest::SetUpTestCase(void)
+{
+}
+
+void EncodeResolutionPolicyTest::TearDownTestCase(void)
+{
+}
+
+void EncodeResolutionPolicyTest::SetUp(void)
+{
+    policy_.Init(TEST_STEPS, TEST_START_US);
+}
+
+void EncodeResolutionPolicyTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: encode_resolution_policy_test_001
+ * @tc.desc: Verify the policy steps down one step at a time under congestion.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(EncodeResolutionPolicyTest, encode_resolution_policy_test_001, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    ResolutionStep step;
+    RunWindow(policy_, nowUs, TEST_LOW_FRAME_BYTES, false);
+    EXPECT_FALSE(policy_.PollStep(step));
+
+    RunWindow(policy_, nowUs, TEST_LOW_FRAME_BYTES, true);
+    EXPECT_TRUE(policy_.PollStep(step));
+    EXPECT_EQ(TEST_STEPS[1].width, step.width);
+    EXPECT_EQ(TEST_STEPS[1].height, step.height);
+    EXPECT_FALSE(policy_.PollStep(step));
+
+    for (int32_t i = 0; i < TEST_HOLD_WINDOWS; i++) {
+        RunWindow(policy_, nowUs, TEST_LOW_FRAME_BYTES, true);
+        EXPECT_FALSE(policy_.PollStep(step));
+    }
+    RunWindow(policy_, nowUs, TEST_LOW_FRAME_BYTES, true);
+    EXPECT_TRUE(policy_.PollStep(step));
+    EXPECT_EQ(TEST_STEPS[2].width, step.width);
+
+    for (int32_t i = 0; i <= TEST_HOLD_WINDOWS; i++) {
+        RunWindow(policy_, nowUs, TEST_LOW_FRAME_BYTES, true);
+    }
+    EXPECT_FALSE(policy_.PollStep(step));
+}
+
+/**
+ * @tc.name: encode_resolution_policy_test_002
+ * @tc.desc: Verify the policy keeps the resolution while the throughput covers the current step.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(EncodeResolutionPolicyTest, encode_resolution_policy_test_002, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    ResolutionStep step;
+    RunWindow(policy_, nowUs, TEST_HIGH_FRAME_BYTES, true);
+    EXPECT_FALSE(policy_.PollStep(step));
+    EXPECT_GE(policy_.GetThroughputBps(), TEST_STEPS[0].minBitrate);
+}
+
+/**
+ * @tc.name: encode_resolution_policy_test_003
+ * @tc.desc: Verify the policy steps up after enough clean windows.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(EncodeResolutionPolicyTest, encode_resolution_policy_test_003, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    ResolutionStep step;
+    RunWindow(policy_, nowUs, TEST_LOW_FRAME_BYTES, true);
+    EXPECT_TRUE(policy_.PollStep(step));
+
+    for (int32_t i = 0; i < TEST_HOLD_WINDOWS + TEST_STEP_UP_WINDOWS - 1; i++) {
+        RunWindow(policy_, nowUs, TEST_HIGH_FRAME_BYTES, false);
+        EXPECT_FALSE(policy_.PollStep(step));
+    }
+    RunWindow(policy_, nowUs, TEST_HIGH_FRAME_BYTES, false);
+    EXPECT_TRUE(policy_.PollStep(step));
+    EXPECT_EQ(TEST_STEPS[0].width, step.width);
+    EXPECT_EQ(TEST_STEPS[0].height, step.height);
+}
+
+/**
+ * @tc.name: encode_resolution_policy_test_004
+ * @tc.desc: Verify a disabled policy or a single step never switches.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(EncodeResolutionPolicyTest, encode_resolution_policy_test_004, TestSize.Level1)
+{
+    int64_t nowUs = TEST_START_US;
+    ResolutionStep step;
+    policy_.Disable();
+    EXPECT_FALSE(policy_.IsEnabled());
+    RunWindow(policy_, nowUs, TEST_LOW_FRAME_BYTES, true);
+    EXPECT_FALSE(policy_.PollStep(step));
+
+    policy_.Init({ TEST_STEPS[0] }, nowUs);
+    EXPECT_FALSE(policy_.IsEnabled());
+    RunWindow(policy_, nowUs, TEST_LOW_FRAME_BYTES, true);
+    EXPECT_FALSE(policy_.PollStep(step));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
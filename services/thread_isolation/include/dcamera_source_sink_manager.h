@@ -44,13 +44,13 @@ public:
     // 釋放Sink端
     int32_t ReleaseSink();
 
-    // 在Source線程中執行任務
-    void PostSourceTask(std::function<void()> task);
+    // 在Source線程中執行任務，幀處理任務使用 TaskLane::FRAME
+    bool PostSourceTask(DCameraTask task, TaskLane lane = TaskLane::CONTROL);
 
-    // 在Sink線程中執行任務
-    void PostSinkTask(std::function<void()> task);
+    // 在Sink線程中執行任務，幀處理任務使用 TaskLane::FRAME
+    bool PostSinkTask(DCameraTask task, TaskLane lane = TaskLane::CONTROL);
 
-    // 發送數據到對端
+    // 發送數據到對端，控制命令走 CONTROL 通道，視頻和照片走 FRAME 通道
     int32_t SendData(DCameraSessionMode mode, std::shared_ptr<DataBuffer>& buffer);
 
     // 設置通道監聽器
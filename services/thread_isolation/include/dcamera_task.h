@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_TASK_H
+#define OHOS_DCAMERA_TASK_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace OHOS {
+namespace DistributedHardware {
+
+/**
+ * 只可移動的任務容器
+ * 可調用對象不超過 INLINE_SIZE 且可無異常移動時直接存放在對象內部，不產生堆分配；
+ * 較大的對象退回到堆上。與 std::function 不同，允許捕獲 unique_ptr 等只可移動的對象。
+ */
+class DCameraTask {
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+    DCameraTask() noexcept = default;
+
+    template <typename F, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type, DCameraTask>::value>::type>
+    DCameraTask(F&& func)
+    {
+        using Func = typename std::decay<F>::type;
+        Construct<Func>(std::forward<F>(func), std::integral_constant<bool, IsInline<Func>()>());
+    }
+
+    DCameraTask(DCameraTask&& other) noexcept
+    {
+        MoveFrom(other);
+    }
+
+    DCameraTask& operator=(DCameraTask&& other) noexcept
+    {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    DCameraTask(const DCameraTask&) = delete;
+    DCameraTask& operator=(const DCameraTask&) = delete;
+
+    ~DCameraTask()
+    {
+        Reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ops_ != nullptr;
+    }
+
+    void operator()()
+    {
+        ops_->invoke(storage_);
+    }
+
+    void Reset() noexcept
+    {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Func>
+    static constexpr bool IsInline()
+    {
+        return sizeof(Func) <= INLINE_SIZE && alignof(Func) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible<Func>::value;
+    }
+
+    template <typename Func>
+    struct InlineOps {
+        static void Invoke(void* storage)
+        {
+            (*static_cast<Func*>(storage))();
+        }
+        static void Move(void* dst, void* src) noexcept
+        {
+            new (dst) Func(std::move(*static_cast<Func*>(src)));
+            static_cast<Func*>(src)->~Func();
+        }
+        static void Destroy(void* storage) noexcept
+        {
+            static_cast<Func*>(storage)->~Func();
+        }
+        static constexpr Ops OPS = { Invoke, Move, Destroy };
+    };
+
+    template <typename Func>
+    struct HeapOps {
+        static void Invoke(void* storage)
+        {
+            (**static_cast<Func**>(storage))();
+        }
+        static void Move(void* dst, void* src) noexcept
+        {
+            *static_cast<Func**>(dst) = *static_cast<Func**>(src);
+        }
+        static void Destroy(void* storage) noexcept
+        {
+            delete *static_cast<Func**>(storage);
+        }
+        static constexpr Ops OPS = { Invoke, Move, Destroy };
+    };
+
+    template <typename Func, typename F>
+    void Construct(F&& func, std::true_type)
+    {
+        new (storage_) Func(std::forward<F>(func));
+        ops_ = &InlineOps<Func>::OPS;
+    }
+
+    template <typename Func, typename F>
+    void Construct(F&& func, std::false_type)
+    {
+        *reinterpret_cast<Func**>(storage_) = new Func(std::forward<F>(func));
+        ops_ = &HeapOps<Func>::OPS;
+    }
+
+    void MoveFrom(DCameraTask& other) noexcept
+    {
+        ops_ = other.ops_;
+        if (ops_ != nullptr) {
+            ops_->move(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    const Ops* ops_ = nullptr;
+};
+
+template <typename Func>
+constexpr DCameraTask::Ops DCameraTask::InlineOps<Func>::OPS;
+
+template <typename Func>
+constexpr DCameraTask::Ops DCameraTask::HeapOps<Func>::OPS;
+
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // OHOS_DCAMERA_TASK_H
@@ -16,13 +16,17 @@
 #ifndef OHOS_DCAMERA_THREAD_ISOLATION_H
 #define OHOS_DCAMERA_THREAD_ISOLATION_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <thread>
-#include <condition_variable>
-#include <queue>
-#include <functional>
-#include <atomic>
+#include <vector>
+
+#include "dcamera_task.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -32,42 +36,112 @@ enum class ThreadRole {
     SINK
 };
 
+// 任務通道：控制命令不排在幀處理之後
+enum class TaskLane : uint32_t {
+    CONTROL = 0,    // 高優先級，單一 worker 按提交順序執行
+    FRAME = 1,      // 每個 worker 一個隊列，空閒時竊取其他隊列的任務
+    LANE_COUNT
+};
+
+constexpr size_t TASK_LANE_NUM = static_cast<size_t>(TaskLane::LANE_COUNT);
+
+// CONTROL 通道固定一個 worker 以保證命令順序，只有幀 worker 數可配置
+struct ThreadIsolationConfig {
+    uint32_t frameWorkers = 1;
+};
+
+// 通道排隊時延統計（從提交到開始執行）
+struct LaneLatencyStats {
+    uint64_t posted = 0;
+    uint64_t executed = 0;
+    uint64_t stolen = 0;
+    int64_t avgQueueUs = 0;
+    int64_t p99QueueUs = 0;     // 按 2 的冪分桶估算的上界
+    int64_t maxQueueUs = 0;
+};
+
 class DCameraThreadIsolation {
 public:
     explicit DCameraThreadIsolation(ThreadRole role);
+    DCameraThreadIsolation(ThreadRole role, const ThreadIsolationConfig& config);
     ~DCameraThreadIsolation();
 
+    // 各角色的默認配置
+    static ThreadIsolationConfig GetDefaultConfig(ThreadRole role);
+
     // 啟動隔離線程
     int32_t Start();
 
-    // 停止隔離線程
+    // 停止隔離線程，未執行的任務被丟棄
     int32_t Stop();
 
-    // 提交任務到指定線程
-    void PostTask(std::function<void()> task);
+    // 提交任務到指定通道，線程未啟動時返回 false
+    bool PostTask(DCameraTask task, TaskLane lane = TaskLane::CONTROL);
 
     // 獲取當前線程角色
     ThreadRole GetRole() const { return role_; }
 
-    // 檢查是否在正確的線程中執行
+    // 檢查是否在本角色的 worker 線程中執行
     bool IsInCorrectThread() const;
 
-    // 等待所有任務完成
+    // 等待所有已提交的任務完成，不能在 worker 線程中調用
     void WaitForTasksCompletion();
 
+    // 獲取通道統計
+    LaneLatencyStats GetLaneStats(TaskLane lane) const;
+
 private:
-    void ThreadMain();
+    static constexpr size_t LATENCY_BUCKET_NUM = 32;
+
+    struct QueuedTask {
+        DCameraTask task;
+        int64_t enqueueUs = 0;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<QueuedTask> tasks;
+    };
+
+    struct LaneMetrics {
+        std::atomic<uint64_t> posted{0};
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+        std::atomic<uint64_t> totalQueueUs{0};
+        std::atomic<int64_t> maxQueueUs{0};
+        std::array<std::atomic<uint64_t>, LATENCY_BUCKET_NUM> histogram{};
+    };
+
+    void ControlThreadMain();
+    void FrameThreadMain(size_t index);
+    bool PopControlTask(QueuedTask& queued);
+    bool PopFrameTask(size_t index, QueuedTask& queued);
+    void RunTask(QueuedTask& queued, TaskLane lane);
+    void RecordQueueLatency(TaskLane lane, int64_t queueUs);
+    size_t DiscardQueuedTasks();
+    const char* RoleName() const;
 
     ThreadRole role_;
-    std::unique_ptr<std::thread> thread_;
-    mutable std::mutex queueMutex_;
-    std::queue<std::function<void()>> taskQueue_;
-    std::condition_variable condition_;
+    ThreadIsolationConfig config_;
+    std::vector<std::thread> threads_;
     std::atomic<bool> running_{false};
-    std::atomic<bool> tasksCompleted_{true};
-    std::atomic<int32_t> pendingTasks_{0};
-    mutable std::mutex completionMutex_;
+
+    WorkQueue controlQueue_;
+    std::vector<std::unique_ptr<WorkQueue>> frameQueues_;
+    std::atomic<uint64_t> nextFrameQueue_{0};
+
+    // 隊列中尚未取出的任務數，在 wakeMutex_ 下增加，用於喚醒判斷
+    std::array<std::atomic<int64_t>, TASK_LANE_NUM> queued_{};
+    std::mutex wakeMutex_;
+    std::condition_variable controlCondition_;
+    std::condition_variable frameCondition_;
+
+    // 已提交但尚未執行完成的任務數，由 completionMutex_ 保護
+    uint64_t unfinishedTasks_ = 0;
+    std::mutex completionMutex_;
     std::condition_variable completionCondition_;
+
+    std::array<LaneMetrics, TASK_LANE_NUM> metrics_;
 };
 
 } // namespace DistributedHardware
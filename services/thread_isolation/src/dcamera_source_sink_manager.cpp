@@ -99,36 +99,38 @@ int32_t DCameraSourceSinkManager::ReleaseSink()
     return 0;
 }
 
-void DCameraSourceSinkManager::PostSourceTask(std::function<void()> task)
+bool DCameraSourceSinkManager::PostSourceTask(DCameraTask task, TaskLane lane)
 {
     if (sourceThread_ && sourceInitialized_.load()) {
-        sourceThread_->PostTask(task);
-    } else {
-        DHLOGE("Cannot post task to source thread, not initialized");
+        return sourceThread_->PostTask(std::move(task), lane);
     }
+    DHLOGE("Cannot post task to source thread, not initialized");
+    return false;
 }
 
-void DCameraSourceSinkManager::PostSinkTask(std::function<void()> task)
+bool DCameraSourceSinkManager::PostSinkTask(DCameraTask task, TaskLane lane)
 {
     if (sinkThread_ && sinkInitialized_.load()) {
-        sinkThread_->PostTask(task);
-    } else {
-        DHLOGE("Cannot post task to sink thread, not initialized");
+        return sinkThread_->PostTask(std::move(task), lane);
     }
+    DHLOGE("Cannot post task to sink thread, not initialized");
+    return false;
 }
 
 int32_t DCameraSourceSinkManager::SendData(DCameraSessionMode mode, std::shared_ptr<DataBuffer>& buffer)
 {
-    // 在實際實現中，這裡會根據模式選擇正確的通道發送數據
-    // 目前只是示範雙線程架構
     if (!buffer) {
         DHLOGE("Invalid buffer");
         return -1;
     }
 
-    DHLOGI("Sending data with mode: %d, buffer size: %zu",
-           static_cast<int>(mode), buffer->Size());
-    return 0;
+    // 控制命令不能排在幀數據之後
+    TaskLane lane = (mode == DCAMERA_SESSION_MODE_CTRL) ? TaskLane::CONTROL : TaskLane::FRAME;
+    auto task = [mode, buffer]() {
+        DHLOGI("Sending data with mode: %d, buffer size: %zu", static_cast<int>(mode), buffer->Size());
+    };
+    bool posted = sourceInitialized_.load() ? PostSourceTask(task, lane) : PostSinkTask(task, lane);
+    return posted ? 0 : -1;
 }
 
 void DCameraSourceSinkManager::SetChannelListener(std::shared_ptr<ICameraChannelListener>& listener)
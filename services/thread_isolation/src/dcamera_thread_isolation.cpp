@@ -16,11 +16,49 @@
 #include "dcamera_thread_isolation.h"
 #include "distributed_hardware_log.h"
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
 namespace OHOS {
 namespace DistributedHardware {
 
-DCameraThreadIsolation::DCameraThreadIsolation(ThreadRole role) : role_(role)
+namespace {
+constexpr size_t NO_FRAME_WORKER = static_cast<size_t>(-1);
+constexpr uint32_t SOURCE_FRAME_WORKERS = 2;
+constexpr uint32_t SINK_FRAME_WORKERS = 1;
+constexpr uint64_t PERCENT = 100;
+constexpr uint64_t P99 = 99;
+
+thread_local const DCameraThreadIsolation* g_currentIsolation = nullptr;
+thread_local size_t g_currentFrameWorker = NO_FRAME_WORKER;
+
+int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* LaneName(TaskLane lane)
+{
+    return (lane == TaskLane::CONTROL) ? "CONTROL" : "FRAME";
+}
+}
+
+DCameraThreadIsolation::DCameraThreadIsolation(ThreadRole role)
+    : DCameraThreadIsolation(role, GetDefaultConfig(role))
+{
+}
+
+DCameraThreadIsolation::DCameraThreadIsolation(ThreadRole role, const ThreadIsolationConfig& config)
+    : role_(role), config_(config)
 {
+    if (config_.frameWorkers == 0) {
+        config_.frameWorkers = 1;
+    }
+    for (uint32_t i = 0; i < config_.frameWorkers; i++) {
+        frameQueues_.push_back(std::make_unique<WorkQueue>());
+    }
 }
 
 DCameraThreadIsolation::~DCameraThreadIsolation()
@@ -28,120 +66,314 @@ DCameraThreadIsolation::~DCameraThreadIsolation()
     Stop();
 }
 
+ThreadIsolationConfig DCameraThreadIsolation::GetDefaultConfig(ThreadRole role)
+{
+    // Source 端同時解碼多路遠端相機的幀，Sink 端只有本機一路編碼輸出
+    ThreadIsolationConfig config;
+    config.frameWorkers = (role == ThreadRole::SOURCE) ? SOURCE_FRAME_WORKERS : SINK_FRAME_WORKERS;
+    return config;
+}
+
+const char* DCameraThreadIsolation::RoleName() const
+{
+    return (role_ == ThreadRole::SOURCE) ? "SOURCE" : "SINK";
+}
+
 int32_t DCameraThreadIsolation::Start()
 {
-    if (running_.load()) {
-        DHLOGE("Thread already running for role: %d", static_cast<int>(role_));
-        return -1;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        if (running_.load()) {
+            DHLOGE("Thread already running for role: %d", static_cast<int>(role_));
+            return -1;
+        }
+        running_.store(true);
     }
 
-    running_.store(true);
-    tasksCompleted_.store(false);
-    thread_ = std::make_unique<std::thread>(&DCameraThreadIsolation::ThreadMain, this);
+    threads_.emplace_back(&DCameraThreadIsolation::ControlThreadMain, this);
+    for (uint32_t i = 0; i < config_.frameWorkers; i++) {
+        threads_.emplace_back(&DCameraThreadIsolation::FrameThreadMain, this, static_cast<size_t>(i));
+    }
 
-    DHLOGI("Started %s thread isolation",
-           (role_ == ThreadRole::SOURCE) ? "SOURCE" : "SINK");
+    DHLOGI("Started %s thread isolation, frame workers: %u", RoleName(), config_.frameWorkers);
     return 0;
 }
 
 int32_t DCameraThreadIsolation::Stop()
 {
-    if (!running_.load()) {
-        return 0;
+    if (IsInCorrectThread()) {
+        DHLOGE("Cannot stop %s thread isolation from its own worker", RoleName());
+        return -1;
     }
-
     {
-        std::lock_guard<std::mutex> lock(queueMutex_);
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        if (!running_.load()) {
+            return 0;
+        }
         running_.store(false);
-        condition_.notify_all();
     }
+    controlCondition_.notify_all();
+    frameCondition_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
 
-    if (thread_ && thread_->joinable()) {
-        thread_->join();
-        thread_.reset();
+    size_t discarded = DiscardQueuedTasks();
+    {
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        unfinishedTasks_ = 0;
     }
+    completionCondition_.notify_all();
 
-    DHLOGI("Stopped %s thread isolation",
-           (role_ == ThreadRole::SOURCE) ? "SOURCE" : "SINK");
+    DHLOGI("Stopped %s thread isolation, discarded %zu tasks", RoleName(), discarded);
     return 0;
 }
 
-void DCameraThreadIsolation::PostTask(std::function<void()> task)
+bool DCameraThreadIsolation::PostTask(DCameraTask task, TaskLane lane)
 {
-    if (!running_.load()) {
-        DHLOGE("Cannot post task, thread not running for role: %d", static_cast<int>(role_));
-        return;
+    if (!task) {
+        DHLOGE("Cannot post empty task to %s thread", RoleName());
+        return false;
     }
 
+    size_t laneIndex = static_cast<size_t>(lane);
     {
-        std::lock_guard<std::mutex> lock(queueMutex_);
-        taskQueue_.push(task);
-        pendingTasks_.fetch_add(1);
-        tasksCompleted_.store(false);
+        // 在 wakeMutex_ 下檢查並入隊，Stop 之後不會再有任務進入隊列
+        std::lock_guard<std::mutex> wakeLock(wakeMutex_);
+        if (!running_.load()) {
+            DHLOGE("Cannot post task, thread not running for role: %d", static_cast<int>(role_));
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(completionMutex_);
+            unfinishedTasks_++;
+        }
+        metrics_[laneIndex].posted.fetch_add(1, std::memory_order_relaxed);
+        QueuedTask queued;
+        queued.task = std::move(task);
+        queued.enqueueUs = NowUs();
+        if (lane == TaskLane::CONTROL) {
+            std::lock_guard<std::mutex> lock(controlQueue_.mutex);
+            controlQueue_.tasks.push_back(std::move(queued));
+        } else {
+            // 幀 worker 提交的後續任務留在自己的隊列，其餘輪流分配
+            size_t index = (g_currentIsolation == this && g_currentFrameWorker != NO_FRAME_WORKER) ?
+                g_currentFrameWorker : static_cast<size_t>(nextFrameQueue_.fetch_add(1) % frameQueues_.size());
+            std::lock_guard<std::mutex> lock(frameQueues_[index]->mutex);
+            frameQueues_[index]->tasks.push_back(std::move(queued));
+        }
+        queued_[laneIndex].fetch_add(1);
     }
-    condition_.notify_one();
+
+    if (lane == TaskLane::CONTROL) {
+        controlCondition_.notify_one();
+    } else {
+        frameCondition_.notify_one();
+    }
+    return true;
 }
 
 bool DCameraThreadIsolation::IsInCorrectThread() const
 {
-    // 在實際實現中，可能需要存儲線程ID並進行比較
-    // 這裡簡化實現，假設調用此方法時已經在正確的線程上下文中
-    return true;
+    return g_currentIsolation == this;
 }
 
 void DCameraThreadIsolation::WaitForTasksCompletion()
 {
+    if (IsInCorrectThread()) {
+        DHLOGE("Cannot wait for %s tasks from its own worker", RoleName());
+        return;
+    }
     std::unique_lock<std::mutex> lock(completionMutex_);
     completionCondition_.wait(lock, [this]() {
-        return tasksCompleted_.load() || !running_.load();
+        return unfinishedTasks_ == 0 || !running_.load();
     });
 }
 
-void DCameraThreadIsolation::ThreadMain()
+LaneLatencyStats DCameraThreadIsolation::GetLaneStats(TaskLane lane) const
 {
-    DHLOGI("Starting %s thread main loop",
-           (role_ == ThreadRole::SOURCE) ? "SOURCE" : "SINK");
+    const LaneMetrics& metrics = metrics_[static_cast<size_t>(lane)];
+    LaneLatencyStats stats;
+    stats.posted = metrics.posted.load(std::memory_order_relaxed);
+    stats.executed = metrics.executed.load(std::memory_order_relaxed);
+    stats.stolen = metrics.stolen.load(std::memory_order_relaxed);
+    stats.maxQueueUs = metrics.maxQueueUs.load(std::memory_order_relaxed);
+    if (stats.executed == 0) {
+        return stats;
+    }
+    stats.avgQueueUs = static_cast<int64_t>(metrics.totalQueueUs.load(std::memory_order_relaxed) / stats.executed);
 
-    while (running_.load()) {
-        std::function<void()> task;
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            condition_.wait(lock, [this]() {
-                return !taskQueue_.empty() || !running_.load();
-            });
-
-            if (!running_.load()) {
-                break;
-            }
-
-            if (!taskQueue_.empty()) {
-                task = std::move(taskQueue_.front());
-                taskQueue_.pop();
-            }
+    uint64_t total = 0;
+    for (const auto& bucket : metrics.histogram) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    uint64_t target = (total * P99 + PERCENT - 1) / PERCENT;
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < LATENCY_BUCKET_NUM; i++) {
+        accumulated += metrics.histogram[i].load(std::memory_order_relaxed);
+        if (accumulated >= target) {
+            stats.p99QueueUs = std::min(static_cast<int64_t>(1) << (i + 1), stats.maxQueueUs);
+            break;
         }
+    }
+    return stats;
+}
+
+void DCameraThreadIsolation::ControlThreadMain()
+{
+    g_currentIsolation = this;
+    DHLOGI("Starting %s control thread main loop", RoleName());
+    while (true) {
+        QueuedTask queued;
+        if (PopControlTask(queued)) {
+            RunTask(queued, TaskLane::CONTROL);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        controlCondition_.wait(lock, [this]() {
+            return !running_.load() || queued_[static_cast<size_t>(TaskLane::CONTROL)].load() > 0;
+        });
+        if (!running_.load()) {
+            break;
+        }
+    }
+    DHLOGI("Exiting %s control thread main loop", RoleName());
+    g_currentIsolation = nullptr;
+}
+
+void DCameraThreadIsolation::FrameThreadMain(size_t index)
+{
+    g_currentIsolation = this;
+    g_currentFrameWorker = index;
+    DHLOGI("Starting %s frame thread %zu main loop", RoleName(), index);
+    while (true) {
+        QueuedTask queued;
+        if (PopFrameTask(index, queued)) {
+            RunTask(queued, TaskLane::FRAME);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        frameCondition_.wait(lock, [this]() {
+            return !running_.load() || queued_[static_cast<size_t>(TaskLane::FRAME)].load() > 0;
+        });
+        if (!running_.load()) {
+            break;
+        }
+    }
+    DHLOGI("Exiting %s frame thread %zu main loop", RoleName(), index);
+    g_currentFrameWorker = NO_FRAME_WORKER;
+    g_currentIsolation = nullptr;
+}
+
+bool DCameraThreadIsolation::PopControlTask(QueuedTask& queued)
+{
+    if (!running_.load()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(controlQueue_.mutex);
+    if (controlQueue_.tasks.empty()) {
+        return false;
+    }
+    queued = std::move(controlQueue_.tasks.front());
+    controlQueue_.tasks.pop_front();
+    queued_[static_cast<size_t>(TaskLane::CONTROL)].fetch_sub(1);
+    return true;
+}
+
+bool DCameraThreadIsolation::PopFrameTask(size_t index, QueuedTask& queued)
+{
+    if (!running_.load()) {
+        return false;
+    }
+    {
+        WorkQueue& own = *frameQueues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            queued = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            queued_[static_cast<size_t>(TaskLane::FRAME)].fetch_sub(1);
+            return true;
+        }
+    }
+    // 自己的隊列為空時，從其他 worker 隊列的尾部竊取
+    for (size_t offset = 1; offset < frameQueues_.size(); offset++) {
+        WorkQueue& victim = *frameQueues_[(index + offset) % frameQueues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            queued = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            queued_[static_cast<size_t>(TaskLane::FRAME)].fetch_sub(1);
+            metrics_[static_cast<size_t>(TaskLane::FRAME)].stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void DCameraThreadIsolation::RunTask(QueuedTask& queued, TaskLane lane)
+{
+    RecordQueueLatency(lane, NowUs() - queued.enqueueUs);
+    try {
+        queued.task();
+    } catch (const std::exception& e) {
+        DHLOGE("Exception in %s thread %s task: %s", RoleName(), LaneName(lane), e.what());
+    }
+    queued.task.Reset();
+    metrics_[static_cast<size_t>(lane)].executed.fetch_add(1, std::memory_order_relaxed);
 
-        if (task) {
-            try {
-                task();
-            } catch (const std::exception& e) {
-                DHLOGE("Exception in %s thread task: %s",
-                       (role_ == ThreadRole::SOURCE) ? "SOURCE" : "SINK", e.what());
-            }
-
-            int32_t remainingTasks = pendingTasks_.fetch_sub(1) - 1;
-            if (remainingTasks <= 0 && running_.load()) {
-                {
-                    std::lock_guard<std::mutex> lock(completionMutex_);
-                    tasksCompleted_.store(true);
-                }
-                completionCondition_.notify_all();
-            }
+    bool completed = false;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        if (unfinishedTasks_ > 0) {
+            unfinishedTasks_--;
         }
+        completed = (unfinishedTasks_ == 0);
+    }
+    if (completed) {
+        completionCondition_.notify_all();
     }
+}
+
+void DCameraThreadIsolation::RecordQueueLatency(TaskLane lane, int64_t queueUs)
+{
+    LaneMetrics& metrics = metrics_[static_cast<size_t>(lane)];
+    if (queueUs < 0) {
+        queueUs = 0;
+    }
+    metrics.totalQueueUs.fetch_add(static_cast<uint64_t>(queueUs), std::memory_order_relaxed);
+    int64_t maxQueueUs = metrics.maxQueueUs.load(std::memory_order_relaxed);
+    while (queueUs > maxQueueUs &&
+        !metrics.maxQueueUs.compare_exchange_weak(maxQueueUs, queueUs, std::memory_order_relaxed)) {
+    }
+    size_t bucket = 0;
+    while (bucket + 1 < LATENCY_BUCKET_NUM && (queueUs >> (bucket + 1)) > 0) {
+        bucket++;
+    }
+    metrics.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
 
-    DHLOGI("Exiting %s thread main loop",
-           (role_ == ThreadRole::SOURCE) ? "SOURCE" : "SINK");
+size_t DCameraThreadIsolation::DiscardQueuedTasks()
+{
+    size_t discarded = 0;
+    {
+        std::lock_guard<std::mutex> lock(controlQueue_.mutex);
+        discarded += controlQueue_.tasks.size();
+        controlQueue_.tasks.clear();
+    }
+    for (auto& queue : frameQueues_) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        discarded += queue->tasks.size();
+        queue->tasks.clear();
+    }
+    for (auto& count : queued_) {
+        count.store(0);
+    }
+    return discarded;
 }
 
 } // namespace DistributedHardware
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dcamera_thread_isolation.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraThreadIsolationTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+constexpr std::chrono::seconds WAIT_TIMEOUT(5);
+constexpr int32_t TEST_TASK_NUM = 64;
+constexpr int32_t TEST_FOLLOW_UP_NUM = 4;
+constexpr size_t TEST_LARGE_CAPTURE = 128;
+
+// 測試用的單次閘門，讓任務阻塞直到測試放行
+class TestGate {
+public:
+    void Open()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            opened_ = true;
+        }
+        condition_.notify_all();
+    }
+
+    bool Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return condition_.wait_for(lock, WAIT_TIMEOUT, [this]() { return opened_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool opened_ = false;
+};
+}
+
+void DCameraThreadIsolationTest::SetUpTestCase(void)
+{
+}
+
+void DCameraThreadIsolationTest::TearDownTestCase(void)
+{
+}
+
+void DCameraThreadIsolationTest::SetUp(void)
+{
+}
+
+void DCameraThreadIsolationTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: dcamera_thread_isolation_test_001
+ * @tc.desc: Verify PostTask fails before Start and the tasks posted after it all run.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadIsolationTest, dcamera_thread_isolation_test_001, TestSize.Level1)
+{
+    DCameraThreadIsolation isolation(ThreadRole::SOURCE);
+    EXPECT_FALSE(isolation.PostTask([]() {}));
+    EXPECT_EQ(0, isolation.Start());
+    EXPECT_EQ(-1, isolation.Start());
+
+    std::atomic<int32_t> executed{0};
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_TRUE(isolation.PostTask([&executed]() { executed++; }, TaskLane::CONTROL));
+        EXPECT_TRUE(isolation.PostTask([&executed]() { executed++; }, TaskLane::FRAME));
+    }
+    isolation.WaitForTasksCompletion();
+    EXPECT_EQ(TEST_TASK_NUM * 2, executed.load());
+
+    LaneLatencyStats control = isolation.GetLaneStats(TaskLane::CONTROL);
+    LaneLatencyStats frame = isolation.GetLaneStats(TaskLane::FRAME);
+    EXPECT_EQ(static_cast<uint64_t>(TEST_TASK_NUM), control.posted);
+    EXPECT_EQ(static_cast<uint64_t>(TEST_TASK_NUM), control.executed);
+    EXPECT_EQ(static_cast<uint64_t>(TEST_TASK_NUM), frame.posted);
+    EXPECT_EQ(static_cast<uint64_t>(TEST_TASK_NUM), frame.executed);
+    EXPECT_LE(control.avgQueueUs, control.maxQueueUs);
+    EXPECT_LE(control.p99QueueUs, control.maxQueueUs);
+    EXPECT_EQ(0, isolation.Stop());
+}
+
+/**
+ * @tc.name: dcamera_thread_isolation_test_002
+ * @tc.desc: Verify a control task runs while every frame worker is blocked and frames are queued.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadIsolationTest, dcamera_thread_isolation_test_002, TestSize.Level1)
+{
+    ThreadIsolationConfig config;
+    config.frameWorkers = 1;
+    DCameraThreadIsolation isolation(ThreadRole::SINK, config);
+    EXPECT_EQ(0, isolation.Start());
+
+    TestGate frameGate;
+    std::atomic<int32_t> framesDone{0};
+    EXPECT_TRUE(isolation.PostTask([&frameGate, &framesDone]() {
+        frameGate.Wait();
+        framesDone++;
+    }, TaskLane::FRAME));
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_TRUE(isolation.PostTask([&framesDone]() { framesDone++; }, TaskLane::FRAME));
+    }
+
+    TestGate controlGate;
+    int32_t framesDoneAtControl = -1;
+    EXPECT_TRUE(isolation.PostTask([&controlGate, &framesDone, &framesDoneAtControl]() {
+        framesDoneAtControl = framesDone.load();
+        controlGate.Open();
+    }, TaskLane::CONTROL));
+    EXPECT_TRUE(controlGate.Wait());
+    EXPECT_EQ(0, framesDoneAtControl);
+
+    frameGate.Open();
+    isolation.WaitForTasksCompletion();
+    EXPECT_EQ(TEST_TASK_NUM + 1, framesDone.load());
+    EXPECT_EQ(0, isolation.Stop());
+}
+
+/**
+ * @tc.name: dcamera_thread_isolation_test_003
+ * @tc.desc: Verify an idle frame worker steals the follow-ups a blocked frame worker queued to itself.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadIsolationTest, dcamera_thread_isolation_test_003, TestSize.Level1)
+{
+    ThreadIsolationConfig config;
+    config.frameWorkers = 2;
+    DCameraThreadIsolation isolation(ThreadRole::SOURCE, config);
+    EXPECT_EQ(0, isolation.Start());
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    int32_t followUpsDone = 0;
+    bool sameThread = false;
+    bool allDone = false;
+    EXPECT_TRUE(isolation.PostTask([&]() {
+        std::thread::id owner = std::this_thread::get_id();
+        for (int32_t i = 0; i < TEST_FOLLOW_UP_NUM; i++) {
+            isolation.PostTask([&, owner]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                sameThread = sameThread || (std::this_thread::get_id() == owner);
+                followUpsDone++;
+                condition.notify_all();
+            }, TaskLane::FRAME);
+        }
+        // 不放手自己的隊列，後續任務只能被另一個 worker 竊取
+        std::unique_lock<std::mutex> lock(mutex);
+        allDone = condition.wait_for(lock, WAIT_TIMEOUT, [&]() { return followUpsDone == TEST_FOLLOW_UP_NUM; });
+    }, TaskLane::FRAME));
+    isolation.WaitForTasksCompletion();
+
+    EXPECT_TRUE(allDone);
+    EXPECT_FALSE(sameThread);
+    EXPECT_EQ(static_cast<uint64_t>(TEST_FOLLOW_UP_NUM), isolation.GetLaneStats(TaskLane::FRAME).stolen);
+    EXPECT_EQ(0u, isolation.GetLaneStats(TaskLane::CONTROL).stolen);
+    EXPECT_EQ(0, isolation.Stop());
+}
+
+/**
+ * @tc.name: dcamera_thread_isolation_test_004
+ * @tc.desc: Verify the control lane keeps submission order and tasks can capture move-only or large objects.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadIsolationTest, dcamera_thread_isolation_test_004, TestSize.Level1)
+{
+    DCameraThreadIsolation isolation(ThreadRole::SINK);
+    EXPECT_EQ(0, isolation.Start());
+
+    std::vector<int32_t> order;
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        auto value = std::make_unique<int32_t>(i);
+        EXPECT_TRUE(isolation.PostTask([&order, value = std::move(value)]() { order.push_back(*value); }));
+    }
+    std::array<uint8_t, TEST_LARGE_CAPTURE> large;
+    large.fill(1);
+    size_t largeSum = 0;
+    EXPECT_TRUE(isolation.PostTask([&largeSum, large]() {
+        for (auto byte : large) {
+            largeSum += byte;
+        }
+    }));
+    isolation.WaitForTasksCompletion();
+
+    ASSERT_EQ(static_cast<size_t>(TEST_TASK_NUM), order.size());
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_EQ(i, order[i]);
+    }
+    EXPECT_EQ(TEST_LARGE_CAPTURE, largeSum);
+    EXPECT_EQ(0, isolation.Stop());
+}
+
+/**
+ * @tc.name: dcamera_thread_isolation_test_005
+ * @tc.desc: Verify IsInCorrectThread and that Stop is refused from a worker.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadIsolationTest, dcamera_thread_isolation_test_005, TestSize.Level1)
+{
+    DCameraThreadIsolation isolation(ThreadRole::SOURCE);
+    EXPECT_EQ(0, isolation.Start());
+    EXPECT_FALSE(isolation.IsInCorrectThread());
+
+    bool inControl = false;
+    bool inFrame = false;
+    int32_t stopRet = 0;
+    EXPECT_TRUE(isolation.PostTask([&]() {
+        inControl = isolation.IsInCorrectThread();
+        stopRet = isolation.Stop();
+    }, TaskLane::CONTROL));
+    EXPECT_TRUE(isolation.PostTask([&]() { inFrame = isolation.IsInCorrectThread(); }, TaskLane::FRAME));
+    isolation.WaitForTasksCompletion();
+
+    EXPECT_TRUE(inControl);
+    EXPECT_TRUE(inFrame);
+    EXPECT_EQ(-1, stopRet);
+    EXPECT_EQ(0, isolation.Stop());
+}
+
+/**
+ * @tc.name: dcamera_thread_isolation_test_006
+ * @tc.desc: Verify Stop drops the queued tasks, wakes the waiters and rejects later posts.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DCameraThreadIsolationTest, dcamera_thread_isolation_test_006, TestSize.Level1)
+{
+    ThreadIsolationConfig config;
+    config.frameWorkers = 1;
+    DCameraThreadIsolation isolation(ThreadRole::SINK, config);
+    EXPECT_EQ(0, isolation.Start());
+
+    TestGate started;
+    TestGate release;
+    std::atomic<int32_t> executed{0};
+    EXPECT_TRUE(isolation.PostTask([&]() {
+        started.Open();
+        release.Wait();
+    }, TaskLane::FRAME));
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_TRUE(isolation.PostTask([&executed]() { executed++; }, TaskLane::FRAME));
+    }
+    EXPECT_TRUE(started.Wait());
+
+    std::thread waiter([&isolation]() { isolation.WaitForTasksCompletion(); });
+    std::thread stopper([&isolation]() { isolation.Stop(); });
+    // 確認 Stop 已拒絕新任務後再放行，隊列中的幀不會再被執行
+    while (isolation.PostTask([]() {}, TaskLane::CONTROL)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    release.Open();
+    stopper.join();
+    waiter.join();
+
+    EXPECT_EQ(0, executed.load());
+    EXPECT_FALSE(isolation.PostTask([&executed]() { executed++; }, TaskLane::FRAME));
+
+    EXPECT_EQ(0, isolation.Start());
+    EXPECT_TRUE(isolation.PostTask([&executed]() { executed++; }, TaskLane::FRAME));
+    isolation.WaitForTasksCompletion();
+    EXPECT_EQ(1, executed.load());
+    EXPECT_EQ(0, isolation.Stop());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -16,14 +16,32 @@
 #include "ffmpeg_encoder_wrapper.h"
 #include "distributed_hardware_log.h"
 
+#include <cstring>
+
+namespace {
+// 时间基固定为 90kHz，帧率变化时只改变 pts 步长，不需要重新打开编码器
+constexpr int PTS_CLOCK_RATE = 90000;
+
+// 输入缓冲区归调用者所有，引用计数归零时不释放
+void NoopBufferFree(void* opaque, uint8_t* data) {
+    (void)opaque;
+    (void)data;
+}
+}
+
 FFmpegEncoderWrapper::FFmpegEncoderWrapper()
     : codecContext_(nullptr), codec_(nullptr),
       frame_(nullptr), packet_(nullptr),
       width_(0), height_(0), frameSize_(0),
-      frameCount_(0), initialized_(false) {
+      frameCount_(0), initialized_(false), nextPts_(0),
+      pendingBitRate_(0), pendingFps_(0), keyFrameRequested_(false) {
 }
 
 FFmpegEncoderWrapper::~FFmpegEncoderWrapper() {
+    ReleaseCodec();
+}
+
+void FFmpegEncoderWrapper::ReleaseCodec() {
     if (packet_) {
         av_packet_free(&packet_);
     }
@@ -33,11 +51,25 @@ FFmpegEncoderWrapper::~FFmpegEncoderWrapper() {
     if (codecContext_) {
         avcodec_free_context(&codecContext_);
     }
+    initialized_ = false;
 }
 
 int32_t FFmpegEncoderWrapper::Initialize(int width, int height) {
-    DHLOGI("[FFMPEG_ENC] Initialize, resolution: %{public}dx%{public}d", width, height);
+    return Initialize(width, height, EncoderConfig());
+}
+
+int32_t FFmpegEncoderWrapper::Initialize(int width, int height, const EncoderConfig& config) {
+    DHLOGI("[FFMPEG_ENC] Initialize, resolution: %{public}dx%{public}d, fps: %{public}d, bitRate: %{public}lld, "
+            "lowLatency: %{public}d, intraRefresh: %{public}d", width, height, config.fps,
+            static_cast<long long>(config.bitRate), config.lowLatency ? 1 : 0, config.intraRefresh ? 1 : 0);
 
+    if (width <= 0 || height <= 0 || config.fps <= 0 || config.bitRate <= 0) {
+        DHLOGE("[FFMPEG_ENC] Invalid encoder config");
+        return -1;
+    }
+    // 重新初始化时先释放旧的编码器，pts 继续递增
+    ReleaseCodec();
+    config_ = config;
     width_ = width;
     height_ = height;
     frameSize_ = width * height * 3 / 2;  // NV12
@@ -87,37 +119,46 @@ int32_t FFmpegEncoderWrapper::Initialize(int width, int height) {
     // 配置编码器参数
     codecContext_->width = width;
     codecContext_->height = height;
-    codecContext_->time_base = AVRational{1, 30};
-    codecContext_->framerate = AVRational{30, 1};
-    codecContext_->gop_size = 30;
+    codecContext_->time_base = AVRational{1, PTS_CLOCK_RATE};
+    codecContext_->framerate = AVRational{config_.fps, 1};
+    codecContext_->gop_size = config_.gopSize;
     codecContext_->max_b_frames = 0;
     codecContext_->pix_fmt = AV_PIX_FMT_NV12;
 
-    // 设置比特率
-    codecContext_->bit_rate = 5000000;  // 5 Mbps
+    // 设置比特率，VBV 缓冲区取一帧的码率，限制单帧峰值
+    codecContext_->bit_rate = config_.bitRate;
+    codecContext_->rc_max_rate = config_.bitRate;
+    codecContext_->rc_buffer_size = static_cast<int>(config_.bitRate / config_.fps);
+
+    if (config_.lowLatency) {
+        // 片级多线程不引入帧级延迟
+        codecContext_->thread_type = FF_THREAD_SLICE;
+        codecContext_->thread_count = config_.threads;
+    }
 
     // 打开编码器
-    if (avcodec_open2(codecContext_, codec_, nullptr) < 0) {
+    AVDictionary* options = nullptr;
+    BuildCodecOptions(&options);
+    int ret = avcodec_open2(codecContext_, codec_, &options);
+    // 编码器不认识的选项会留在字典中
+    AVDictionaryEntry* entry = nullptr;
+    while ((entry = av_dict_get(options, "", entry, AV_DICT_IGNORE_SUFFIX)) != nullptr) {
+        DHLOGW("[FFMPEG_ENC] Option not supported by %{public}s: %{public}s=%{public}s",
+                codec_->name, entry->key, entry->value);
+    }
+    av_dict_free(&options);
+    if (ret < 0) {
         DHLOGE("[FFMPEG_ENC] Could not open codec");
         return -1;
     }
 
-    // 创建帧
+    // 创建帧，数据平面在 Encode 时直接指向调用者的缓冲区
     frame_ = av_frame_alloc();
     if (!frame_) {
         DHLOGE("[FFMPEG_ENC] Could not allocate frame");
         return -1;
     }
 
-    frame_->format = codecContext_->pix_fmt;
-    frame_->width = codecContext_->width;
-    frame_->height = codecContext_->height;
-
-    if (av_frame_get_buffer(frame_, 0) < 0) {
-        DHLOGE("[FFMPEG_ENC] Could not allocate frame data");
-        return -1;
-    }
-
     // 创建数据包
     packet_ = av_packet_alloc();
     if (!packet_) {
@@ -132,29 +173,31 @@ int32_t FFmpegEncoderWrapper::Initialize(int width, int height) {
 
 int32_t FFmpegEncoderWrapper::Encode(const std::vector<uint8_t>& yuvData,
                                      std::vector<uint8_t>& encodedData) {
+    return Encode(yuvData.data(), yuvData.size(), encodedData);
+}
+
+int32_t FFmpegEncoderWrapper::Encode(const uint8_t* yuvData, size_t yuvSize,
+                                     std::vector<uint8_t>& encodedData) {
     if (!initialized_) {
         DHLOGE("[FFMPEG_ENC] Not initialized");
         return -1;
     }
 
-    if (yuvData.size() < static_cast<size_t>(frameSize_)) {
+    if (yuvData == nullptr || yuvSize < static_cast<size_t>(frameSize_)) {
         DHLOGE("[FFMPEG_ENC] Invalid YUV data size");
         return -1;
     }
 
-    // 准备帧数据
-    av_frame_make_writable(frame_);
-
-    // Y 平面
-    memcpy(frame_->data[0], yuvData.data(), width_ * height_);
+    ApplyPendingChanges();
 
-    // UV 平面 (NV12 是交错存储的)
-    memcpy(frame_->data[1], yuvData.data() + width_ * height_, width_ * height_ / 2);
-
-    frame_->pts = frameCount_++;
+    if (WrapInputFrame(yuvData) != 0) {
+        return -1;
+    }
+    frameCount_++;
 
-    // 发送帧到编码器
+    // 发送帧到编码器，编码器对输入只增加引用，不拷贝
     int32_t ret = SendFrame(frame_);
+    av_frame_unref(frame_);
     if (ret < 0) {
         DHLOGE("[FFMPEG_ENC] Error sending frame to encoder");
         return -1;
@@ -170,6 +213,108 @@ int32_t FFmpegEncoderWrapper::Encode(const std::vector<uint8_t>& yuvData,
     return 0;
 }
 
+int32_t FFmpegEncoderWrapper::SetBitRate(int64_t bitRate) {
+    if (bitRate <= 0) {
+        DHLOGE("[FFMPEG_ENC] Invalid bit rate: %{public}lld", static_cast<long long>(bitRate));
+        return -1;
+    }
+    pendingBitRate_ = bitRate;
+    return 0;
+}
+
+int32_t FFmpegEncoderWrapper::SetFrameRate(int fps) {
+    if (fps <= 0) {
+        DHLOGE("[FFMPEG_ENC] Invalid frame rate: %{public}d", fps);
+        return -1;
+    }
+    pendingFps_ = fps;
+    return 0;
+}
+
+void FFmpegEncoderWrapper::RequestKeyFrame() {
+    keyFrameRequested_ = true;
+}
+
+void FFmpegEncoderWrapper::BuildCodecOptions(AVDictionary** options) const {
+    std::string name = codec_->name;
+    bool isX264 = (name == "libx264");
+    bool isX265 = (name == "libx265");
+    if (!isX264 && !isX265) {
+        return;
+    }
+
+    av_dict_set(options, "preset", config_.preset.c_str(), 0);
+    // 强制关键帧时输出 IDR，接收端可以从该帧开始解码
+    av_dict_set(options, "forced-idr", "1", 0);
+    if (config_.lowLatency) {
+        // 关闭前瞻和 B 帧，每输入一帧立即输出一帧
+        av_dict_set(options, "tune", "zerolatency", 0);
+    }
+    if (config_.intraRefresh) {
+        if (isX264) {
+            av_dict_set(options, "intra-refresh", "1", 0);
+        } else {
+            av_dict_set(options, "x265-params", "intra-refresh=1", 0);
+        }
+    }
+}
+
+int32_t FFmpegEncoderWrapper::WrapInputFrame(const uint8_t* yuvData) {
+    int ySize = width_ * height_;
+
+    // 用引用计数缓冲区包装调用者的内存，避免 avcodec_send_frame 对非引用计数帧做整帧拷贝
+    frame_->buf[0] = av_buffer_create(const_cast<uint8_t*>(yuvData), static_cast<size_t>(frameSize_),
+        NoopBufferFree, nullptr, AV_BUFFER_FLAG_READONLY);
+    if (frame_->buf[0] == nullptr) {
+        DHLOGE("[FFMPEG_ENC] Could not wrap input buffer");
+        return -1;
+    }
+
+    frame_->format = codecContext_->pix_fmt;
+    frame_->width = width_;
+    frame_->height = height_;
+    // Y 平面
+    frame_->data[0] = const_cast<uint8_t*>(yuvData);
+    frame_->linesize[0] = width_;
+    // UV 平面 (NV12 是交错存储的)
+    frame_->data[1] = const_cast<uint8_t*>(yuvData) + ySize;
+    frame_->linesize[1] = width_;
+
+    frame_->pts = nextPts_;
+    nextPts_ += PTS_CLOCK_RATE / config_.fps;
+
+    frame_->pict_type = AV_PICTURE_TYPE_NONE;
+    if (keyFrameRequested_.exchange(false)) {
+        frame_->pict_type = AV_PICTURE_TYPE_I;
+        DHLOGI("[FFMPEG_ENC] Forcing key frame at frame %{public}d", frameCount_);
+    }
+    return 0;
+}
+
+void FFmpegEncoderWrapper::ApplyPendingChanges() {
+    int64_t bitRate = pendingBitRate_.exchange(0);
+    if (bitRate > 0 && bitRate != config_.bitRate) {
+        // libx264 在下一帧比较这些字段并调用 x264_encoder_reconfig；其他编码器可能忽略
+        config_.bitRate = bitRate;
+        codecContext_->bit_rate = bitRate;
+        codecContext_->rc_max_rate = bitRate;
+        codecContext_->rc_buffer_size = static_cast<int>(bitRate / config_.fps);
+        DHLOGI("[FFMPEG_ENC] Bit rate changed to %{public}lld", static_cast<long long>(bitRate));
+        if (std::strcmp(codec_->name, "libx264") != 0) {
+            DHLOGW("[FFMPEG_ENC] %{public}s may not support runtime bit rate change", codec_->name);
+        }
+    }
+
+    int fps = pendingFps_.exchange(0);
+    if (fps > 0 && fps != config_.fps) {
+        // 时间基不变，只调整 pts 步长，码控按时间戳计算每帧预算
+        config_.fps = fps;
+        codecContext_->framerate = AVRational{fps, 1};
+        codecContext_->rc_buffer_size = static_cast<int>(config_.bitRate / fps);
+        DHLOGI("[FFMPEG_ENC] Frame rate changed to %{public}d", fps);
+    }
+}
+
 int32_t FFmpegEncoderWrapper::Flush() {
     DHLOGI("[FFMPEG_ENC] Flushing encoder");
 
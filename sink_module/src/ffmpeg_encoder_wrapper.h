@@ -16,6 +16,7 @@
 #ifndef FFMPEG_ENCODER_WRAPPER_H
 #define FFMPEG_ENCODER_WRAPPER_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
@@ -26,9 +27,22 @@ extern "C" {
 #include <libavutil/imgutils.h>
 }
 
+// 编码器配置
+struct EncoderConfig {
+    int fps = 30;
+    int64_t bitRate = 5000000;      // 5 Mbps
+    int gopSize = 30;               // 关键帧间隔；启用帧内刷新时为刷新周期
+    bool lowLatency = true;         // zerolatency 调优、无 B 帧、片级多线程
+    bool intraRefresh = false;      // 用周期性帧内刷新代替大的 IDR 帧（仅 libx264/libx265）
+    int threads = 0;                // 0 表示自动
+    std::string preset = "veryfast";
+};
+
 /**
  * FFmpeg编码器封装
  * 用于编码 YUV 数据为 H.265
+ * 输入帧直接引用调用者的缓冲区，不做拷贝；码率、帧率和关键帧请求可在运行中修改，
+ * 在下一次 Encode 时生效，不需要重新打开编码器。
  *
  * 对应原始代码中的 AVCodec VideoEncoder
  */
@@ -37,16 +51,27 @@ public:
     FFmpegEncoderWrapper();
     ~FFmpegEncoderWrapper();
 
-    // 初始化编码器
+    // 初始化编码器，可重复调用以切换分辨率，切换后第一帧为关键帧
     int32_t Initialize(int width, int height);
+    int32_t Initialize(int width, int height, const EncoderConfig& config);
 
     // 编码一帧 YUV 数据
+    // yuvData 在编码器输出对应数据包之前须保持不变；低延迟配置下编码器不缓存输入帧
     int32_t Encode(const std::vector<uint8_t>& yuvData,
                    std::vector<uint8_t>& encodedData);
+    int32_t Encode(const uint8_t* yuvData, size_t yuvSize,
+                   std::vector<uint8_t>& encodedData);
 
     // 刷新编码器
     int32_t Flush();
 
+    // 运行中调整，可在任意线程调用
+    int32_t SetBitRate(int64_t bitRate);
+    int32_t SetFrameRate(int fps);
+    void RequestKeyFrame();
+
+    const EncoderConfig& GetConfig() const { return config_; }
+
     // 获取编码器信息
     void GetResolution(int& width, int& height) const {
         width = width_;
@@ -54,8 +79,12 @@ public:
     }
 
 private:
+    void ReleaseCodec();
     int32_t SendFrame(AVFrame* frame);
     int32_t ReceivePacket(std::vector<uint8_t>& encodedData);
+    void BuildCodecOptions(AVDictionary** options) const;
+    int32_t WrapInputFrame(const uint8_t* yuvData);
+    void ApplyPendingChanges();
 
     AVCodecContext* codecContext_;
     const AVCodec* codec_;
@@ -67,6 +96,12 @@ private:
     int frameSize_;
     int frameCount_;
     bool initialized_;
+
+    EncoderConfig config_;
+    int64_t nextPts_;
+    std::atomic<int64_t> pendingBitRate_;
+    std::atomic<int> pendingFps_;
+    std::atomic<bool> keyFrameRequested_;
 };
 
 #endif // FFMPEG_ENCODER_WRAPPER_H
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_pacer.h"
+
+#include <thread>
+
+FramePacer::FramePacer(int fps)
+    : fps_(fps), started_(false), frameIndex_(0) {
+}
+
+void FramePacer::SetFrameRate(int fps) {
+    fps_ = fps;
+    Reset();
+}
+
+void FramePacer::Reset() {
+    started_ = false;
+    frameIndex_ = 0;
+}
+
+FramePacer::Clock::time_point FramePacer::Deadline(uint64_t frameIndex) const {
+    // 以纳秒计算 n * 1e9 / fps，避免帧间隔取整后误差累积
+    auto offsetNs = std::chrono::nanoseconds(static_cast<int64_t>(frameIndex * 1000000000ULL / fps_));
+    return start_ + std::chrono::duration_cast<Clock::duration>(offsetNs);
+}
+
+int64_t FramePacer::WaitNextFrame() {
+    if (fps_ <= 0) {
+        stats_.emitted++;
+        return 0;
+    }
+
+    if (!started_) {
+        start_ = Clock::now();
+        frameIndex_ = 0;
+        started_ = true;
+    }
+
+    Clock::time_point deadline = Deadline(frameIndex_);
+    Clock::time_point now = Clock::now();
+    if (now < deadline) {
+        // 睡眠的唤醒误差不会累积，下一帧仍按绝对截止时间计算
+        std::this_thread::sleep_until(deadline);
+    }
+
+    now = Clock::now();
+    int64_t lateUs = std::chrono::duration_cast<std::chrono::microseconds>(now - deadline).count();
+    int64_t frameIntervalUs = 1000000 / fps_;
+    if (lateUs <= frameIntervalUs / 10) {
+        // 截止时间后 10% 帧间隔内视为准时
+        lateUs = 0;
+    } else {
+        stats_.late++;
+        if (lateUs > stats_.maxLateUs) {
+            stats_.maxLateUs = lateUs;
+        }
+    }
+
+    frameIndex_++;
+    // 落后太多时跳过错过的节拍，重新与时钟对齐
+    if (lateUs > frameIntervalUs * MAX_CATCH_UP_FRAMES) {
+        uint64_t missed = static_cast<uint64_t>(lateUs / frameIntervalUs);
+        frameIndex_ += missed;
+        stats_.skipped += missed;
+    }
+    stats_.emitted++;
+    return lateUs;
+}
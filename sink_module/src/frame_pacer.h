@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+#include <cstdint>
+
+// 帧节拍统计
+struct FramePacerStats {
+    uint64_t emitted = 0;       // 已输出的帧数
+    uint64_t late = 0;          // 错过截止时间的帧数
+    uint64_t skipped = 0;       // 严重落后时跳过的节拍数
+    int64_t maxLateUs = 0;
+};
+
+/**
+ * 帧节拍器
+ * 基于单调时钟，第 n 帧的截止时间为 起点 + n * 帧间隔，用 sleep_until 等待到截止时间，
+ * 按绝对时间计算，不累积睡眠误差。
+ * 落后超过 MAX_CATCH_UP_FRAMES 帧时重新对齐节拍，避免恢复后突发输出。
+ */
+class FramePacer {
+public:
+    explicit FramePacer(int fps = 30);
+
+    // fps <= 0 表示不限速
+    void SetFrameRate(int fps);
+    int GetFrameRate() const { return fps_; }
+
+    // 重置起点，下一次 WaitNextFrame 立即返回
+    void Reset();
+
+    // 等待到下一帧的截止时间，返回本帧的落后时间(us)，按时到达时为 0
+    int64_t WaitNextFrame();
+
+    FramePacerStats GetStats() const { return stats_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int64_t MAX_CATCH_UP_FRAMES = 2;
+
+    Clock::time_point Deadline(uint64_t frameIndex) const;
+
+    int fps_;
+    bool started_;
+    Clock::time_point start_;
+    uint64_t frameIndex_;
+    FramePacerStats stats_;
+};
+
+#endif // FRAME_PACER_H
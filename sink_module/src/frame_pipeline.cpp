@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_pipeline.h"
+
+#include <utility>
+
+FramePool::FramePool(size_t maxCached) : maxCached_(maxCached) {
+    cached_.reserve(maxCached);
+}
+
+PipelineFramePtr FramePool::Acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!cached_.empty()) {
+            PipelineFramePtr frame = std::move(cached_.back());
+            cached_.pop_back();
+            return frame;
+        }
+    }
+    allocated_++;
+    return std::make_unique<PipelineFrame>();
+}
+
+void FramePool::Release(PipelineFramePtr frame) {
+    if (!frame) {
+        return;
+    }
+    // 只清空内容，保留 vector 容量
+    frame->data.clear();
+    frame->view = nullptr;
+    frame->viewSize = 0;
+    frame->width = 0;
+    frame->height = 0;
+    frame->index = 0;
+    frame->captureUs = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cached_.size() < maxCached_) {
+        cached_.push_back(std::move(frame));
+    } else {
+        allocated_--;
+    }
+}
+
+size_t FramePool::Allocated() const {
+    return allocated_.load();
+}
+
+BoundedFrameQueue::BoundedFrameQueue(size_t depth, FrameDropPolicy policy)
+    : depth_(depth == 0 ? 1 : depth), policy_(policy) {
+}
+
+bool BoundedFrameQueue::Push(PipelineFramePtr& frame, PipelineFramePtr& dropped) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (policy_ == FrameDropPolicy::BLOCK) {
+        notFull_.wait(lock, [this] { return closed_ || frames_.size() < depth_; });
+    }
+    if (closed_) {
+        return false;
+    }
+
+    if (frames_.size() >= depth_) {
+        if (policy_ == FrameDropPolicy::DROP_NEWEST) {
+            dropped = std::move(frame);
+            return true;
+        }
+        dropped = std::move(frames_.front());
+        frames_.pop_front();
+    }
+    frames_.push_back(std::move(frame));
+    lock.unlock();
+    notEmpty_.notify_one();
+    return true;
+}
+
+bool BoundedFrameQueue::Pop(PipelineFramePtr& frame) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return closed_ || !frames_.empty(); });
+    if (frames_.empty()) {
+        return false;
+    }
+    frame = std::move(frames_.front());
+    frames_.pop_front();
+    lock.unlock();
+    notFull_.notify_one();
+    return true;
+}
+
+void BoundedFrameQueue::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+}
+
+void BoundedFrameQueue::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = false;
+}
+
+void BoundedFrameQueue::Drain(std::vector<PipelineFramePtr>& frames) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!frames_.empty()) {
+        frames.push_back(std::move(frames_.front()));
+        frames_.pop_front();
+    }
+}
+
+void PipelineStageStats::RecordBusy(uint64_t us) {
+    frames++;
+    busyUs += us;
+    uint64_t prev = maxBusyUs.load(std::memory_order_relaxed);
+    while (us > prev && !maxBusyUs.compare_exchange_weak(prev, us, std::memory_order_relaxed)) {
+    }
+}
+
+void PipelineStageStats::Reset() {
+    frames = 0;
+    dropped = 0;
+    busyUs = 0;
+    waitUs = 0;
+    maxBusyUs = 0;
+}
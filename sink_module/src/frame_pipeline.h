@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// 流水线中传递的帧，data 的容量在回收后保留，稳定运行时不再分配内存
+// view 非空时帧内容为外部只读内存（如映射的YUV文件），data 不使用
+struct PipelineFrame {
+    std::vector<uint8_t> data;
+    const uint8_t* view = nullptr;
+    size_t viewSize = 0;
+    int width = 0;
+    int height = 0;
+    uint64_t index = 0;
+    int64_t captureUs = 0;
+
+    const uint8_t* Data() const {
+        return (view != nullptr) ? view : data.data();
+    }
+    size_t Size() const {
+        return (view != nullptr) ? viewSize : data.size();
+    }
+};
+
+using PipelineFramePtr = std::unique_ptr<PipelineFrame>;
+
+// 队列满时的处理策略
+enum class FrameDropPolicy {
+    BLOCK,          // 上游等待，不丢帧
+    DROP_OLDEST,    // 丢弃队首最旧的帧，保证实时性
+    DROP_NEWEST     // 丢弃新到的帧
+};
+
+// 帧缓冲池，线程安全
+class FramePool {
+public:
+    explicit FramePool(size_t maxCached);
+
+    // 优先复用缓存的帧，没有时新建
+    PipelineFramePtr Acquire();
+    void Release(PipelineFramePtr frame);
+    size_t Allocated() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<PipelineFramePtr> cached_;
+    size_t maxCached_;
+    std::atomic<size_t> allocated_{0};
+};
+
+// 有界帧队列，连接相邻的两个阶段
+class BoundedFrameQueue {
+public:
+    BoundedFrameQueue(size_t depth, FrameDropPolicy policy);
+
+    // 入队成功返回 true；因策略被丢弃的帧通过 dropped 返回给调用者回收
+    // 返回 false 表示队列已关闭，frame 保持不变
+    bool Push(PipelineFramePtr& frame, PipelineFramePtr& dropped);
+
+    // 阻塞直到有帧或队列关闭，关闭且为空时返回 false
+    bool Pop(PipelineFramePtr& frame);
+
+    // 唤醒所有等待者，之后的 Push 失败，Pop 取完剩余帧后失败
+    void Close();
+    void Reset();
+
+    // 取出剩余的帧用于回收
+    void Drain(std::vector<PipelineFramePtr>& frames);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<PipelineFramePtr> frames_;
+    size_t depth_;
+    FrameDropPolicy policy_;
+    bool closed_ = false;
+};
+
+// 单个阶段的计时计数
+struct PipelineStageStats {
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> busyUs{0};     // 实际处理耗时
+    std::atomic<uint64_t> waitUs{0};     // 等待输入或等待下游队列的耗时
+    std::atomic<uint64_t> maxBusyUs{0};
+
+    void RecordBusy(uint64_t us);
+    void Reset();
+};
+
+#endif // FRAME_PIPELINE_H
@@ -14,12 +14,25 @@
  */
 
 #include "sink_service_impl.h"
-#include "yuv_file_camera.h"
 #include "ffmpeg_encoder_wrapper.h"
 #include "socket_sender.h"
 
+#include <chrono>
+
 #include "distributed_hardware_log.h"
 
+namespace {
+// 每发送多少帧输出一次流水线统计
+constexpr uint64_t STATS_LOG_INTERVAL = 300;
+// 队列之外各阶段同时持有的帧数上限：采集 1 帧，编码 2 帧（输入与输出），发送 1 帧
+constexpr size_t STAGE_IN_FLIGHT_FRAMES = 4;
+
+int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
 SinkServiceImpl::SinkServiceImpl()
     : callback_(nullptr), running_(false), initialized_(false) {
     DHLOGI("[SINK_IMPL] SinkServiceImpl created");
@@ -52,8 +65,11 @@ int32_t SinkServiceImpl::InitSink(const std::string& params, ISinkCallback* call
         return -1;
     }
 
-    // 初始化FFmpeg编码器
-    if (encoder_->Initialize(1920, 1080) != 0) {
+    // 初始化FFmpeg编码器，播放列表切换分辨率时在编码阶段重新初始化
+    int width = 0;
+    int height = 0;
+    yuvCamera_->GetResolution(width, height);
+    if (encoder_->Initialize(width, height) != 0) {
         DHLOGE("[SINK_IMPL] Failed to initialize encoder, will send raw YUV data");
         // 不返回错误，继续运行但发送原始数据
         encoder_.reset();
@@ -130,11 +146,56 @@ int32_t SinkServiceImpl::OnStopCaptureMessage(const std::string& dhId) {
     return 0;
 }
 
+void SinkServiceImpl::SetPipelineConfig(const SinkPipelineConfig& config) {
+    pipelineConfig_ = config;
+    DHLOGI("[SINK_IMPL] Pipeline config: rawQueueDepth=%{public}zu, sendQueueDepth=%{public}zu, dropPolicy=%{public}d, "
+            "fps=%{public}d, clips=%{public}zu", config.rawQueueDepth, config.sendQueueDepth,
+            static_cast<int>(config.dropPolicy), config.fps, config.clips.size());
+}
+
+void SinkServiceImpl::ApplyCaptureConfig() {
+    yuvCamera_->SetFrameRate(pipelineConfig_.fps);
+    if (encoder_ && pipelineConfig_.fps > 0) {
+        encoder_->SetFrameRate(pipelineConfig_.fps);
+    }
+    if (pipelineConfig_.clips.empty()) {
+        return;
+    }
+
+    yuvCamera_->SetPreload(pipelineConfig_.preloadClips, pipelineConfig_.preloadClips);
+    const YUVClipInfo& first = pipelineConfig_.clips.front();
+    yuvCamera_->OpenFile(first.filePath, first.width, first.height);
+    for (size_t i = 1; i < pipelineConfig_.clips.size(); i++) {
+        const YUVClipInfo& clip = pipelineConfig_.clips[i];
+        if (yuvCamera_->AddClip(clip.filePath, clip.width, clip.height) != 0) {
+            DHLOGW("[SINK_IMPL] Skip clip: %{public}s", clip.filePath.c_str());
+        }
+    }
+}
+
+int32_t SinkServiceImpl::MatchEncoderResolution(int width, int height) {
+    int encoderWidth = 0;
+    int encoderHeight = 0;
+    encoder_->GetResolution(encoderWidth, encoderHeight);
+    if (width == encoderWidth && height == encoderHeight) {
+        return 0;
+    }
+
+    // 低延迟配置下编码器不缓存帧，直接按新分辨率重新打开，接收端从新的关键帧开始解码
+    DHLOGI("[SINK_IMPL] Encoder resolution %{public}dx%{public}d -> %{public}dx%{public}d",
+            encoderWidth, encoderHeight, width, height);
+    EncoderConfig config = encoder_->GetConfig();
+    return encoder_->Initialize(width, height, config);
+}
+
 void SinkServiceImpl::StartSinkThread() {
     if (running_) {
         DHLOGW("[SINK_IMPL] Sink thread already running");
         return;
     }
+    // 上一次流水线因错误自行退出时，先回收线程
+    StopSinkThread();
+    ApplyCaptureConfig();
 
     DHLOGI("[SINK_IMPL] Attempting to connect to Source at 127.0.0.1:8888...");
 
@@ -158,55 +219,226 @@ void SinkServiceImpl::StartSinkThread() {
         DHLOGW("[SINK_IMPL] Not connected, but will try to send data anyway");
     }
 
+    // 启用编码器时丢弃已编码帧会破坏参考关系，发送队列只能阻塞
+    FrameDropPolicy sendPolicy = encoder_ ? FrameDropPolicy::BLOCK : pipelineConfig_.dropPolicy;
+    framePool_ = std::make_unique<FramePool>(
+        pipelineConfig_.rawQueueDepth + pipelineConfig_.sendQueueDepth + STAGE_IN_FLIGHT_FRAMES);
+    rawQueue_ = std::make_unique<BoundedFrameQueue>(pipelineConfig_.rawQueueDepth, pipelineConfig_.dropPolicy);
+    sendQueue_ = std::make_unique<BoundedFrameQueue>(pipelineConfig_.sendQueueDepth, sendPolicy);
+    captureStats_.Reset();
+    encodeStats_.Reset();
+    sendStats_.Reset();
+
+    if (!encoder_) {
+        DHLOGI("[SINK_IMPL] Encoder disabled, sending raw YUV data");
+    }
+
     running_ = true;
-    sinkThread_ = std::thread(&SinkServiceImpl::SinkThreadProc, this);
-    DHLOGI("[SINK_IMPL] Sink thread started");
+    sendThread_ = std::thread(&SinkServiceImpl::SendStageProc, this);
+    encodeThread_ = std::thread(&SinkServiceImpl::EncodeStageProc, this);
+    captureThread_ = std::thread(&SinkServiceImpl::CaptureStageProc, this);
+    DHLOGI("[SINK_IMPL] Sink pipeline started");
 }
 
 void SinkServiceImpl::StopSinkThread() {
-    if (!running_) {
+    if (!captureThread_.joinable() && !encodeThread_.joinable() && !sendThread_.joinable()) {
+        running_ = false;
         return;
     }
 
     running_ = false;
-    if (sinkThread_.joinable()) {
-        sinkThread_.join();
+    rawQueue_->Close();
+    sendQueue_->Close();
+    if (captureThread_.joinable()) {
+        captureThread_.join();
     }
-    DHLOGI("[SINK_IMPL] Sink thread stopped");
+    if (encodeThread_.joinable()) {
+        encodeThread_.join();
+    }
+    if (sendThread_.joinable()) {
+        sendThread_.join();
+    }
+    LogPipelineStats();
+
+    rawQueue_.reset();
+    sendQueue_.reset();
+    framePool_.reset();
+    DHLOGI("[SINK_IMPL] Sink pipeline stopped");
 }
 
-void SinkServiceImpl::SinkThreadProc() {
-    DHLOGI("[SINK_IMPL] Sink thread proc started");
+bool SinkServiceImpl::PushFrame(BoundedFrameQueue& queue, PipelineFramePtr& frame, PipelineStageStats& stats) {
+    PipelineFramePtr dropped;
+    int64_t waitStart = NowUs();
+    bool ret = queue.Push(frame, dropped);
+    stats.waitUs += static_cast<uint64_t>(NowUs() - waitStart);
+    if (dropped) {
+        stats.dropped++;
+        framePool_->Release(std::move(dropped));
+    }
+    return ret;
+}
+
+void SinkServiceImpl::AbortPipeline() {
+    // 任一阶段出错时停止整条流水线，线程由 StopSinkThread 回收
+    running_ = false;
+    rawQueue_->Close();
+    sendQueue_->Close();
+}
+
+void SinkServiceImpl::CaptureStageProc() {
+    DHLOGI("[SINK_IMPL] Capture stage started");
 
     while (running_.load()) {
-        // 从YUV文件读取帧
-        std::vector<uint8_t> yuvData;
-        if (yuvCamera_->ReadFrame(yuvData) != 0) {
+        // 按目标帧率等待节拍，等待时间计入 waitUs
+        int64_t waitStart = NowUs();
+        YUVFrameView view;
+        if (yuvCamera_->AcquireFrame(view) != 0) {
             DHLOGE("[SINK_IMPL] Failed to read YUV frame");
+            AbortPipeline();
+            break;
+        }
+        int64_t start = NowUs();
+        captureStats_.waitUs += static_cast<uint64_t>(start - waitStart);
+
+        // 映射内存中的帧直接以视图传递，不做拷贝
+        PipelineFramePtr frame = framePool_->Acquire();
+        frame->view = view.data;
+        frame->viewSize = view.size;
+        frame->width = view.width;
+        frame->height = view.height;
+        frame->index = view.index;
+        frame->captureUs = start;
+        captureStats_.RecordBusy(static_cast<uint64_t>(NowUs() - start));
+
+        if (!PushFrame(*rawQueue_, frame, captureStats_)) {
+            framePool_->Release(std::move(frame));
             break;
         }
+    }
+    // 通知下游不再有新帧
+    rawQueue_->Close();
+
+    DHLOGI("[SINK_IMPL] Capture stage ended");
+}
+
+void SinkServiceImpl::EncodeStageProc() {
+    DHLOGI("[SINK_IMPL] Encode stage started");
 
-        // 编码为H.265 (如果编码器可用)
-        std::vector<uint8_t> encodedData;
+    PipelineFramePtr rawFrame;
+    while (true) {
+        int64_t waitStart = NowUs();
+        if (!rawQueue_->Pop(rawFrame)) {
+            break;
+        }
+        encodeStats_.waitUs += static_cast<uint64_t>(NowUs() - waitStart);
+
+        PipelineFramePtr outFrame;
         if (encoder_) {
-            if (encoder_->Encode(yuvData, encodedData) != 0) {
+            // 编码为H.265
+            int64_t start = NowUs();
+            outFrame = framePool_->Acquire();
+            int32_t ret = MatchEncoderResolution(rawFrame->width, rawFrame->height);
+            if (ret == 0) {
+                ret = encoder_->Encode(rawFrame->Data(), rawFrame->Size(), outFrame->data);
+            }
+            outFrame->index = rawFrame->index;
+            outFrame->captureUs = rawFrame->captureUs;
+            framePool_->Release(std::move(rawFrame));
+            encodeStats_.RecordBusy(static_cast<uint64_t>(NowUs() - start));
+            if (ret != 0) {
                 DHLOGE("[SINK_IMPL] Failed to encode frame");
+                framePool_->Release(std::move(outFrame));
+                AbortPipeline();
                 break;
             }
+            if (outFrame->data.empty()) {
+                // 编码器仍在缓冲，暂无输出
+                framePool_->Release(std::move(outFrame));
+                continue;
+            }
         } else {
-            // 编码器被禁用，直接发送原始YUV数据
-            DHLOGI("[SINK_IMPL] Encoder disabled, sending raw YUV data");
-            encodedData = yuvData;
+            // 编码器被禁用，原始YUV帧直接转交发送阶段，不做拷贝
+            outFrame = std::move(rawFrame);
+            encodeStats_.RecordBusy(0);
         }
 
+        if (!PushFrame(*sendQueue_, outFrame, encodeStats_)) {
+            framePool_->Release(std::move(outFrame));
+            break;
+        }
+    }
+    sendQueue_->Close();
+
+    DHLOGI("[SINK_IMPL] Encode stage ended");
+}
+
+void SinkServiceImpl::SendStageProc() {
+    DHLOGI("[SINK_IMPL] Send stage started");
+
+    PipelineFramePtr frame;
+    while (true) {
+        int64_t waitStart = NowUs();
+        if (!sendQueue_->Pop(frame)) {
+            break;
+        }
+        sendStats_.waitUs += static_cast<uint64_t>(NowUs() - waitStart);
+
         // 发送给Source端
-        if (socketSender_->SendData(encodedData) != 0) {
+        int64_t start = NowUs();
+        int32_t ret = socketSender_->SendData(frame->Data(), frame->Size());
+        sendStats_.RecordBusy(static_cast<uint64_t>(NowUs() - start));
+        framePool_->Release(std::move(frame));
+        if (ret != 0) {
             DHLOGE("[SINK_IMPL] Failed to send encoded data");
+            AbortPipeline();
             break;
         }
+        if (sendStats_.frames.load() % STATS_LOG_INTERVAL == 0) {
+            LogPipelineStats();
+        }
     }
 
-    DHLOGI("[SINK_IMPL] Sink thread proc ended");
+    DHLOGI("[SINK_IMPL] Send stage ended");
+}
+
+void SinkServiceImpl::LogPipelineStats() {
+    struct StageEntry {
+        const char* name;
+        const PipelineStageStats* stats;
+    };
+    const StageEntry stages[] = {
+        { "capture", &captureStats_ },
+        { "encode", &encodeStats_ },
+        { "send", &sendStats_ },
+    };
+
+    // 处理耗时最多的阶段决定整条流水线的吞吐上限
+    const char* bottleneck = stages[0].name;
+    uint64_t maxAvgUs = 0;
+    for (const auto& stage : stages) {
+        uint64_t frames = stage.stats->frames.load();
+        uint64_t avgUs = (frames == 0) ? 0 : stage.stats->busyUs.load() / frames;
+        if (avgUs > maxAvgUs) {
+            maxAvgUs = avgUs;
+            bottleneck = stage.name;
+        }
+        DHLOGI("[SINK_IMPL] Stage %{public}s: frames=%{public}llu, avgUs=%{public}llu, maxUs=%{public}llu, "
+                "waitUs=%{public}llu, dropped=%{public}llu", stage.name,
+                static_cast<unsigned long long>(frames), static_cast<unsigned long long>(avgUs),
+                static_cast<unsigned long long>(stage.stats->maxBusyUs.load()),
+                static_cast<unsigned long long>(stage.stats->waitUs.load()),
+                static_cast<unsigned long long>(stage.stats->dropped.load()));
+    }
+    DHLOGI("[SINK_IMPL] Pipeline bottleneck: %{public}s (avg %{public}llu us/frame), buffers allocated: %{public}zu",
+            bottleneck, static_cast<unsigned long long>(maxAvgUs), framePool_ ? framePool_->Allocated() : 0);
+
+    if (socketSender_) {
+        SocketSenderStats senderStats = socketSender_->GetStats();
+        DHLOGI("[SINK_IMPL] Socket: frames=%{public}llu, bytes=%{public}llu, sendCalls=%{public}llu",
+                static_cast<unsigned long long>(senderStats.framesSent),
+                static_cast<unsigned long long>(senderStats.bytesSent),
+                static_cast<unsigned long long>(senderStats.sendCalls));
+    }
 }
 
 // ===== 导出工厂函数 =====
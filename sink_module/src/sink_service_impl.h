@@ -17,17 +17,31 @@
 #define SINK_SERVICE_IMPL_H
 
 #include "distributed_camera_sink.h"
+#include "frame_pipeline.h"
+#include "yuv_file_camera.h"
 #include <memory>
 #include <string>
+#include <vector>
 #include <thread>
 #include <mutex>
 #include <atomic>
 
 // 前向声明
-class YUVFileCamera;
 class FFmpegEncoderWrapper;
 class SocketSender;
 
+// 采集 -> 编码 -> 发送 三级流水线配置
+struct SinkPipelineConfig {
+    size_t rawQueueDepth = 2;       // 采集到编码之间的队列深度
+    size_t sendQueueDepth = 4;      // 编码到发送之间的队列深度
+    // 采集队列满时的策略；启用编码器时发送队列固定为 BLOCK，避免丢掉参考帧
+    FrameDropPolicy dropPolicy = FrameDropPolicy::DROP_OLDEST;
+    int fps = 30;                   // 采集节拍，<= 0 表示不限速
+    // 循环播放的片段，可以是不同分辨率；为空时使用生成的测试图案
+    std::vector<YUVClipInfo> clips;
+    bool preloadClips = false;      // 映射时预读并锁定片段内存
+};
+
 class SinkServiceImpl : public IDistributedCameraSink {
 public:
     SinkServiceImpl();
@@ -43,17 +57,37 @@ public:
     int32_t OnStartCaptureMessage(const std::string& dhId, int width, int height);
     int32_t OnStopCaptureMessage(const std::string& dhId);
 
+    // 【内部方法】在 StartCapture 之前调用，运行中修改在下次启动时生效
+    void SetPipelineConfig(const SinkPipelineConfig& config);
+
 private:
     void StartSinkThread();
     void StopSinkThread();
-    void SinkThreadProc();
+    void ApplyCaptureConfig();
+    int32_t MatchEncoderResolution(int width, int height);
+    void CaptureStageProc();
+    void EncodeStageProc();
+    void SendStageProc();
+    bool PushFrame(BoundedFrameQueue& queue, PipelineFramePtr& frame, PipelineStageStats& stats);
+    void AbortPipeline();
+    void LogPipelineStats();
 
     ISinkCallback* callback_;
     std::unique_ptr<YUVFileCamera> yuvCamera_;
     std::unique_ptr<FFmpegEncoderWrapper> encoder_;
     std::unique_ptr<SocketSender> socketSender_;
 
-    std::thread sinkThread_;
+    SinkPipelineConfig pipelineConfig_;
+    std::unique_ptr<FramePool> framePool_;
+    std::unique_ptr<BoundedFrameQueue> rawQueue_;
+    std::unique_ptr<BoundedFrameQueue> sendQueue_;
+    PipelineStageStats captureStats_;
+    PipelineStageStats encodeStats_;
+    PipelineStageStats sendStats_;
+
+    std::thread captureThread_;
+    std::thread encodeThread_;
+    std::thread sendThread_;
     std::mutex mutex_;
     std::atomic<bool> running_;
     std::atomic<bool> initialized_;
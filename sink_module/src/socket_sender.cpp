@@ -21,16 +21,75 @@
 #include <ws2tcpip.h>
 #pragma comment(lib, "ws2_32.lib")
 typedef int socklen_t;
+typedef WSABUF IoBuffer;
 #else
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #define SOCKET int
 #define INVALID_SOCKET -1
 #define SOCKET_ERROR -1
 #define closesocket close
+typedef struct iovec IoBuffer;
 #endif
 
+#include <cstring>
+
+namespace {
+#ifdef _WIN32
+void SetIoBuffer(IoBuffer& buf, const void* data, size_t size) {
+    buf.buf = static_cast<char*>(const_cast<void*>(data));
+    buf.len = static_cast<ULONG>(size);
+}
+
+size_t IoBufferSize(const IoBuffer& buf) {
+    return buf.len;
+}
+
+void AdvanceIoBuffer(IoBuffer& buf, size_t size) {
+    buf.buf += size;
+    buf.len -= static_cast<ULONG>(size);
+}
+
+int64_t SendIoBuffers(SOCKET sockfd, IoBuffer* bufs, size_t count) {
+    DWORD sent = 0;
+    if (WSASend(sockfd, bufs, static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) == SOCKET_ERROR) {
+        return -1;
+    }
+    return static_cast<int64_t>(sent);
+}
+#else
+void SetIoBuffer(IoBuffer& buf, const void* data, size_t size) {
+    buf.iov_base = const_cast<void*>(data);
+    buf.iov_len = size;
+}
+
+size_t IoBufferSize(const IoBuffer& buf) {
+    return buf.iov_len;
+}
+
+void AdvanceIoBuffer(IoBuffer& buf, size_t size) {
+    buf.iov_base = static_cast<char*>(buf.iov_base) + size;
+    buf.iov_len -= size;
+}
+
+int64_t SendIoBuffers(SOCKET sockfd, IoBuffer* bufs, size_t count) {
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = bufs;
+    msg.msg_iovlen = count;
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    flags |= MSG_NOSIGNAL;
+#endif
+    return static_cast<int64_t>(sendmsg(sockfd, &msg, flags));
+}
+#endif
+}
+
 SocketSender::SocketSender()
     : sockfd_(INVALID_SOCKET), connected_(false), initialized_(false) {
 }
@@ -89,27 +148,37 @@ int32_t SocketSender::ConnectToSource(const std::string& host, int port) {
         return -1;
     }
 
+    // 长度头和数据已合并为一次写入，关闭 Nagle 避免小包等待 ACK
+    int noDelay = 1;
+    if (setsockopt(sockfd_, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay),
+        sizeof(noDelay)) == SOCKET_ERROR) {
+        DHLOGW("[SOCKET_SENDER] Failed to set TCP_NODELAY");
+    }
+
     connected_= true;
     DHLOGI("[SOCKET_SENDER] Connected successfully");
     return 0;
 }
 
 int32_t SocketSender::SendData(const std::vector<uint8_t>& data) {
+    return SendData(data.data(), data.size());
+}
+
+int32_t SocketSender::SendData(const uint8_t* data, size_t size) {
     if (!connected_) {
         DHLOGE("[SOCKET_SENDER] Not connected");
         return -1;
     }
 
-    // 先发送数据长度（与Source端的ReceiveData协议匹配）
-    uint32_t dataLen = static_cast<uint32_t>(data.size());
-    int32_t ret = SendDataInternal(&dataLen, sizeof(dataLen));
+    // 长度头 + 数据内容（与Source端的ReceiveData协议匹配）
+    int32_t ret = SendFramed(data, size);
     if (ret < 0) {
-        DHLOGE("[SOCKET_SENDER] Failed to send data length");
+        DHLOGE("[SOCKET_SENDER] Failed to send data");
         return ret;
     }
-
-    // 再发送数据内容
-    return SendDataInternal(data.data(), static_cast<int>(data.size()));
+    framesSent_++;
+    bytesSent_ += size;
+    return 0;
 }
 
 int32_t SocketSender::SendControlMessage(const std::string& message) {
@@ -118,33 +187,47 @@ int32_t SocketSender::SendControlMessage(const std::string& message) {
         return -1;
     }
 
-    // 发送消息长度
-    uint32_t msgLen = static_cast<uint32_t>(message.size());
-    int32_t ret = SendDataInternal(&msgLen, sizeof(msgLen));
-    if (ret < 0) {
-        return ret;
-    }
-
-    // 发送消息内容
-    return SendDataInternal(message.data(), static_cast<int>(message.size()));
+    // 发送消息长度和内容
+    return SendFramed(message.data(), message.size());
 }
 
-int32_t SocketSender::SendDataInternal(const void* data, int size) {
-    int totalSent = 0;
-    const char* ptr = static_cast<const char*>(data);
-
-    while (totalSent < size) {
-        int sent = send(sockfd_, ptr + totalSent, size - totalSent, 0);
-        if (sent == SOCKET_ERROR) {
+int32_t SocketSender::SendFramed(const void* data, size_t size) {
+    uint32_t dataLen = static_cast<uint32_t>(size);
+    IoBuffer bufs[2];
+    SetIoBuffer(bufs[0], &dataLen, sizeof(dataLen));
+    SetIoBuffer(bufs[1], data, size);
+
+    size_t index = 0;
+    size_t count = (size == 0) ? 1 : 2;
+    while (index < count) {
+        int64_t sent = SendIoBuffers(sockfd_, bufs + index, count - index);
+        sendCalls_++;
+        if (sent < 0) {
             DHLOGE("[SOCKET_SENDER] Send failed");
             return -1;
         }
-        totalSent += sent;
+        // 跳过已完整发出的分段，剩余部分从断点继续
+        size_t remain = static_cast<size_t>(sent);
+        while (index < count && remain >= IoBufferSize(bufs[index])) {
+            remain -= IoBufferSize(bufs[index]);
+            index++;
+        }
+        if (index < count) {
+            AdvanceIoBuffer(bufs[index], remain);
+        }
     }
 
     return 0;
 }
 
+SocketSenderStats SocketSender::GetStats() const {
+    SocketSenderStats stats;
+    stats.framesSent = framesSent_.load();
+    stats.bytesSent = bytesSent_.load();
+    stats.sendCalls = sendCalls_.load();
+    return stats;
+}
+
 void SocketSender::Close() {
     if (sockfd_ != INVALID_SOCKET) {
         closesocket(sockfd_);
@@ -17,6 +17,7 @@
 #define SOCKET_SENDER_H
 
 #include "distributed_camera_source.h"
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
@@ -25,6 +26,13 @@
 // 前向声明
 struct sockaddr_in;
 
+// 发送统计，用于评估每帧的系统调用次数
+struct SocketSenderStats {
+    uint64_t framesSent = 0;
+    uint64_t bytesSent = 0;
+    uint64_t sendCalls = 0;     // 实际发生的发送系统调用次数
+};
+
 /**
  * Socket发送端
  * 用于Sink端发送编码数据给Source端
@@ -43,6 +51,7 @@ public:
 
     // 发送编码数据 (Continuous通道)
     int32_t SendData(const std::vector<uint8_t>& data);
+    int32_t SendData(const uint8_t* data, size_t size);
 
     // 发送控制消息 (Control通道)
     int32_t SendControlMessage(const std::string& message);
@@ -53,12 +62,19 @@ public:
     // 是否已连接
     bool IsConnected() const { return connected_; }
 
+    SocketSenderStats GetStats() const;
+
 private:
-    int32_t SendDataInternal(const void* data, int size);
+    // 长度头与数据通过一次聚合写发出，部分写入时继续发送剩余部分
+    int32_t SendFramed(const void* data, size_t size);
 
     int sockfd_;
     bool connected_;
     bool initialized_;
+
+    std::atomic<uint64_t> framesSent_{0};
+    std::atomic<uint64_t> bytesSent_{0};
+    std::atomic<uint64_t> sendCalls_{0};
 };
 
 #endif // SOCKET_SENDER_H
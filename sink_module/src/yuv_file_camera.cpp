@@ -18,9 +18,26 @@
 
 #include <cstring>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr int DEFAULT_FPS = 30;
+constexpr size_t PAGE_STRIDE = 4096;
+// 落后帧日志的输出间隔，避免持续过载时刷屏
+constexpr uint64_t LATE_LOG_INTERVAL = 100;
+}
+
 YUVFileCamera::YUVFileCamera()
-    : width_(1920), height_(1080), frameSize_(0),
-      initialized_(false), fileOpened_(false) {
+    : currentClip_(0), currentFrame_(0), frameIndex_(0), loopCount_(0),
+      preload_(false), lockMemory_(false), pacer_(DEFAULT_FPS),
+      width_(1920), height_(1080), frameSize_(0), initialized_(false) {
     // NV12 格式: Y + UV/2
     frameSize_ = width_ * height_ * 3 / 2;
 }
@@ -39,6 +56,8 @@ int32_t YUVFileCamera::Initialize() {
     }
 
     // 默认使用生成的测试数据
+    frameIndex_ = 0;
+    pacer_.Reset();
     initialized_ = true;
     DHLOGI("[YUV_CAMERA] Initialize success");
     return 0;
@@ -48,57 +67,244 @@ int32_t YUVFileCamera::OpenFile(const std::string& filePath, int width, int heig
     DHLOGI("[YUV_CAMERA] Opening file: %{public}s, resolution: %{public}dx%{public}d",
             filePath.c_str(), width, height);
 
+    UnmapAllClips();
     width_ = width;
     height_ = height;
     frameSize_ = width * height * 3 / 2;
 
-    file_.open(filePath, std::ios::binary);
-    if (!file_.is_open()) {
+    if (AddClip(filePath, width, height) != 0) {
         DHLOGW("[YUV_CAMERA] Failed to open file, will use generated test data");
         // 不返回错误，使用生成的测试数据
-        fileOpened_ = false;
         return 0;
     }
 
-    fileOpened_ = true;
     DHLOGI("[YUV_CAMERA] File opened successfully");
     return 0;
 }
 
-int32_t YUVFileCamera::ReadFrame(std::vector<uint8_t>& frameData) {
+int32_t YUVFileCamera::AddClip(const std::string& filePath, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        DHLOGE("[YUV_CAMERA] Invalid clip resolution: %{public}dx%{public}d", width, height);
+        return -1;
+    }
+
+    YUVClipInfo info;
+    info.filePath = filePath;
+    info.width = width;
+    info.height = height;
+
+    MappedClip clip;
+    if (MapClip(info, clip) != 0) {
+        return -1;
+    }
+    clips_.push_back(clip);
+    if (clips_.size() == 1) {
+        SelectClip(0);
+    }
+
+    DHLOGI("[YUV_CAMERA] Clip added: %{public}s, %{public}dx%{public}d, frames: %{public}zu, locked: %{public}d",
+            filePath.c_str(), width, height, clip.frameCount, clip.locked ? 1 : 0);
+    return 0;
+}
+
+void YUVFileCamera::SetPreload(bool preload, bool lockMemory) {
+    preload_ = preload;
+    lockMemory_ = lockMemory;
+}
+
+void YUVFileCamera::SetFrameRate(int fps) {
+    DHLOGI("[YUV_CAMERA] Frame rate: %{public}d", fps);
+    pacer_.SetFrameRate(fps);
+}
+
+int32_t YUVFileCamera::AcquireFrame(YUVFrameView& view) {
     if (!initialized_) {
         DHLOGE("[YUV_CAMERA] Not initialized");
         return -1;
     }
 
-    frameData.resize(frameSize_);
+    int64_t lateUs = pacer_.WaitNextFrame();
 
-    if (fileOpened_ && file_.is_open()) {
-        // 从文件读取
-        file_.read(reinterpret_cast<char*>(frameData.data()), frameSize_);
-        if (file_.gcount() < static_cast<std::streamsize>(frameSize_)) {
-            // 文件读取完毕，循环播放
-            file_.clear();
-            file_.seekg(0, std::ios::beg);
-            file_.read(reinterpret_cast<char*>(frameData.data()), frameSize_);
+    if (clips_.empty()) {
+        // 生成测试数据
+        if (testFrame_.size() != static_cast<size_t>(frameSize_)) {
+            testFrame_.resize(frameSize_);
+            GenerateTestYUV(testFrame_);
         }
+        view.data = testFrame_.data();
+        view.size = testFrame_.size();
+        view.width = width_;
+        view.height = height_;
     } else {
-        // 生成测试数据
-        GenerateTestYUV(frameData);
+        const MappedClip& clip = clips_[currentClip_];
+        view.data = clip.base + currentFrame_ * clip.frameSize;
+        view.size = clip.frameSize;
+        view.width = clip.info.width;
+        view.height = clip.info.height;
+
+        // 片段播放完毕切换到下一个，整个列表播放完毕后循环
+        if (++currentFrame_ >= clip.frameCount) {
+            currentFrame_ = 0;
+            size_t nextClip = (currentClip_ + 1) % clips_.size();
+            if (nextClip == 0) {
+                loopCount_++;
+            }
+            SelectClip(nextClip);
+        }
+    }
+    view.index = frameIndex_++;
+    view.lateUs = lateUs;
+
+    if (lateUs > 0) {
+        FramePacerStats stats = pacer_.GetStats();
+        if (stats.late % LATE_LOG_INTERVAL == 1) {
+            DHLOGW("[YUV_CAMERA] Frame %{public}llu late by %{public}lld us (late: %{public}llu, skipped: %{public}llu)",
+                    static_cast<unsigned long long>(view.index), static_cast<long long>(lateUs),
+                    static_cast<unsigned long long>(stats.late), static_cast<unsigned long long>(stats.skipped));
+        }
     }
+    return 0;
+}
 
+int32_t YUVFileCamera::ReadFrame(std::vector<uint8_t>& frameData) {
+    YUVFrameView view;
+    int32_t ret = AcquireFrame(view);
+    if (ret != 0) {
+        return ret;
+    }
+    frameData.assign(view.data, view.data + view.size);
     return 0;
 }
 
 void YUVFileCamera::Close() {
-    if (file_.is_open()) {
-        file_.close();
-        fileOpened_ = false;
-    }
+    UnmapAllClips();
     initialized_ = false;
     DHLOGI("[YUV_CAMERA] Closed");
 }
 
+void YUVFileCamera::SelectClip(size_t clipIndex) {
+    currentClip_ = clipIndex;
+    const YUVClipInfo& info = clips_[clipIndex].info;
+    if (info.width != width_ || info.height != height_) {
+        DHLOGI("[YUV_CAMERA] Resolution switched to %{public}dx%{public}d", info.width, info.height);
+    }
+    width_ = info.width;
+    height_ = info.height;
+    frameSize_ = width_ * height_ * 3 / 2;
+}
+
+int32_t YUVFileCamera::MapClip(const YUVClipInfo& info, MappedClip& clip) {
+    clip.info = info;
+    clip.frameSize = static_cast<size_t>(info.width) * info.height * 3 / 2;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(info.filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        DHLOGE("[YUV_CAMERA] Failed to open clip: %{public}s", info.filePath.c_str());
+        return -1;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || static_cast<uint64_t>(fileSize.QuadPart) < clip.frameSize) {
+        DHLOGE("[YUV_CAMERA] Clip smaller than one frame: %{public}s", info.filePath.c_str());
+        CloseHandle(file);
+        return -1;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* base = (mapping == nullptr) ? nullptr : MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (base == nullptr) {
+        DHLOGE("[YUV_CAMERA] Failed to map clip: %{public}s, error: %{public}lu", info.filePath.c_str(),
+                static_cast<unsigned long>(GetLastError()));
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return -1;
+    }
+    clip.fileHandle = file;
+    clip.mappingHandle = mapping;
+    clip.mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(info.filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        DHLOGE("[YUV_CAMERA] Failed to open clip: %{public}s", info.filePath.c_str());
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < clip.frameSize) {
+        DHLOGE("[YUV_CAMERA] Clip smaller than one frame: %{public}s", info.filePath.c_str());
+        close(fd);
+        return -1;
+    }
+    void* base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后文件描述符不再需要
+    close(fd);
+    if (base == MAP_FAILED) {
+        DHLOGE("[YUV_CAMERA] Failed to map clip: %{public}s", info.filePath.c_str());
+        return -1;
+    }
+    clip.mappedSize = static_cast<size_t>(st.st_size);
+    madvise(base, clip.mappedSize, preload_ ? MADV_WILLNEED : MADV_SEQUENTIAL);
+#endif
+    clip.base = static_cast<const uint8_t*>(base);
+    clip.frameCount = clip.mappedSize / clip.frameSize;
+
+    if (preload_) {
+        // 逐页访问，把整个片段读入内存，避免播放时缺页阻塞节拍
+        volatile uint8_t sink = 0;
+        for (size_t offset = 0; offset < clip.mappedSize; offset += PAGE_STRIDE) {
+            sink ^= clip.base[offset];
+        }
+        (void)sink;
+    }
+    if (lockMemory_) {
+#ifdef _WIN32
+        clip.locked = VirtualLock(base, clip.mappedSize) != 0;
+#else
+        clip.locked = mlock(base, clip.mappedSize) == 0;
+#endif
+        if (!clip.locked) {
+            DHLOGW("[YUV_CAMERA] Failed to lock clip in memory: %{public}s", info.filePath.c_str());
+        }
+    }
+    return 0;
+}
+
+void YUVFileCamera::UnmapClip(MappedClip& clip) {
+    if (clip.base == nullptr) {
+        return;
+    }
+    void* base = const_cast<uint8_t*>(clip.base);
+#ifdef _WIN32
+    if (clip.locked) {
+        VirtualUnlock(base, clip.mappedSize);
+    }
+    UnmapViewOfFile(base);
+    CloseHandle(static_cast<HANDLE>(clip.mappingHandle));
+    CloseHandle(static_cast<HANDLE>(clip.fileHandle));
+    clip.mappingHandle = nullptr;
+    clip.fileHandle = nullptr;
+#else
+    if (clip.locked) {
+        munlock(base, clip.mappedSize);
+    }
+    munmap(base, clip.mappedSize);
+#endif
+    clip.base = nullptr;
+    clip.mappedSize = 0;
+    clip.locked = false;
+}
+
+void YUVFileCamera::UnmapAllClips() {
+    for (auto& clip : clips_) {
+        UnmapClip(clip);
+    }
+    clips_.clear();
+    currentClip_ = 0;
+    currentFrame_ = 0;
+    loopCount_ = 0;
+}
+
 void YUVFileCamera::GenerateTestYUV(std::vector<uint8_t>& yuvData) {
     // NV12 格式生成测试图案
     int ySize = width_ * height_;
@@ -18,12 +18,33 @@
 
 #include <string>
 #include <vector>
-#include <fstream>
+#include <cstddef>
 #include <cstdint>
 
+#include "frame_pacer.h"
+
+// 指向映射内存的只读帧，不持有数据；在 Close 之前一直有效
+struct YUVFrameView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    int width = 0;
+    int height = 0;
+    uint64_t index = 0;
+    int64_t lateUs = 0;     // 相对节拍截止时间的落后量，0 表示准时
+};
+
+// 播放列表中的一个片段
+struct YUVClipInfo {
+    std::string filePath;
+    int width = 0;
+    int height = 0;
+};
+
 /**
  * YUV文件模拟相机
  * 用于替代 Camera Framework，从YUV文件读取帧数据
+ * 文件以内存映射方式打开，帧以零拷贝视图的形式给出，并按目标帧率输出。
+ * 支持多个片段（可以是不同分辨率）组成播放列表循环播放，用于长时间压测。
  *
  * 对应原始代码中的 Camera Framework 获取 YUV 数据的部分
  */
@@ -35,10 +56,22 @@ public:
     // 初始化相机
     int32_t Initialize();
 
-    // 打开YUV文件
+    // 打开YUV文件，替换当前播放列表
     int32_t OpenFile(const std::string& filePath, int width, int height);
 
-    // 读取一帧
+    // 向播放列表追加一个片段
+    int32_t AddClip(const std::string& filePath, int width, int height);
+
+    // 映射时预读全部页面，lockMemory 为 true 时同时锁定在物理内存中，在 OpenFile/AddClip 之前调用
+    void SetPreload(bool preload, bool lockMemory);
+
+    // 目标帧率，<= 0 表示不限速
+    void SetFrameRate(int fps);
+
+    // 等待下一帧的节拍并返回零拷贝视图
+    int32_t AcquireFrame(YUVFrameView& view);
+
+    // 读取一帧（拷贝到 frameData）
     int32_t ReadFrame(std::vector<uint8_t>& frameData);
 
     // 关闭文件
@@ -53,14 +86,46 @@ public:
         height = height_;
     }
 
+    FramePacerStats GetPacerStats() const { return pacer_.GetStats(); }
+
+    // 播放列表完整循环的次数
+    uint64_t GetLoopCount() const { return loopCount_; }
+
 private:
-    std::ifstream file_;
-    std::string filePath_;
+    struct MappedClip {
+        YUVClipInfo info;
+        const uint8_t* base = nullptr;
+        size_t mappedSize = 0;
+        size_t frameSize = 0;
+        size_t frameCount = 0;
+        bool locked = false;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+    int32_t MapClip(const YUVClipInfo& info, MappedClip& clip);
+    void UnmapClip(MappedClip& clip);
+    void UnmapAllClips();
+    void SelectClip(size_t clipIndex);
+
+    std::vector<MappedClip> clips_;
+    size_t currentClip_;
+    size_t currentFrame_;
+    uint64_t frameIndex_;
+    uint64_t loopCount_;
+    bool preload_;
+    bool lockMemory_;
+    FramePacer pacer_;
+
     int width_;
     int height_;
     int frameSize_;
     bool initialized_;
-    bool fileOpened_;
+
+    // 没有文件时使用的测试帧，只生成一次
+    std::vector<uint8_t> testFrame_;
 
     // 生成默认测试YUV数据（如果没有文件）
     void GenerateTestYUV(std::vector<uint8_t>& yuvData);
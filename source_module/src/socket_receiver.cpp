@@ -31,10 +31,22 @@ typedef int socklen_t;
 #define closesocket close
 #endif
 
+#include <cstring>
+
+namespace {
+// 接收环大小，编码帧通常远小于该值，一次读取可包含多帧
+constexpr size_t RECV_BUFFER_SIZE = 4 * 1024 * 1024;
+// 接收环尾部剩余空间低于该值时把未解析数据移到开头
+constexpr size_t RECV_MIN_FREE = 64 * 1024;
+constexpr size_t FRAME_HEADER_SIZE = sizeof(uint32_t);
+// 每接收多少帧输出一次统计
+constexpr uint64_t STATS_LOG_INTERVAL = 300;
+}
+
 SocketReceiver::SocketReceiver()
     : listenSockfd_(INVALID_SOCKET), connSockfd_(INVALID_SOCKET),
       receiving_(false), initialized_(false), serverStarted_(false),
-      callback_(nullptr) {
+      callback_(nullptr), readPos_(0), writePos_(0) {
 }
 
 SocketReceiver::~SocketReceiver() {
@@ -173,6 +185,13 @@ void SocketReceiver::ReceiveThreadProc() {
     inet_ntop(AF_INET, &clientAddr.sin_addr, clientIP, INET_ADDRSTRLEN);
     DHLOGI("[SOCKET_RECEIVER] Client connected: %{public}s", clientIP);
 
+    if (recvBuffer_.size() != RECV_BUFFER_SIZE) {
+        recvBuffer_.resize(RECV_BUFFER_SIZE);
+        allocations_++;
+    }
+    readPos_ = 0;
+    writePos_ = 0;
+
     // 接收数据循环
     while (receiving_) {
         if (ReceiveData() != 0) {
@@ -184,10 +203,8 @@ void SocketReceiver::ReceiveThreadProc() {
 }
 
 int32_t SocketReceiver::ReceiveData() {
-    // 首先接收数据长度
-    uint32_t dataLen = 0;
-    int received = recv(connSockfd_, (char*)&dataLen, sizeof(dataLen), 0);
-
+    // 一次读取尽可能多的数据到接收环，再解析出其中所有完整的帧
+    int received = RecvCounted(recvBuffer_.data() + writePos_, recvBuffer_.size() - writePos_);
     if (received <= 0) {
         if (received == 0) {
             DHLOGI("[SOCKET_RECEIVER] Client disconnected");
@@ -196,29 +213,112 @@ int32_t SocketReceiver::ReceiveData() {
         }
         return -1;
     }
+    writePos_ += static_cast<size_t>(received);
+
+    return ParseFrames();
+}
+
+int32_t SocketReceiver::ParseFrames() {
+    while (writePos_ - readPos_ >= FRAME_HEADER_SIZE) {
+        uint32_t dataLen = 0;
+        memcpy(&dataLen, recvBuffer_.data() + readPos_, sizeof(dataLen));
+
+        if (FRAME_HEADER_SIZE + dataLen > recvBuffer_.size()) {
+            // 接收环放不下整帧，改为在帧缓冲区中拼接
+            if (ReceiveLargeFrame(dataLen) != 0) {
+                return -1;
+            }
+            continue;
+        }
+        if (writePos_ - readPos_ < FRAME_HEADER_SIZE + dataLen) {
+            break;
+        }
+
+        DeliverFrame(recvBuffer_.data() + readPos_ + FRAME_HEADER_SIZE, dataLen);
+        readPos_ += FRAME_HEADER_SIZE + dataLen;
+    }
 
-    // 接收数据内容
-    std::vector<uint8_t> data(dataLen);
-    int totalReceived = 0;
+    CompactRecvBuffer();
+    return 0;
+}
 
-    while (totalReceived < static_cast<int>(dataLen)) {
-        int ret = recv(connSockfd_, (char*)(data.data() + totalReceived),
-                      dataLen - totalReceived, 0);
+int32_t SocketReceiver::ReceiveLargeFrame(uint32_t dataLen) {
+    if (frameBuffer_.capacity() < dataLen) {
+        allocations_++;
+    }
+    frameBuffer_.resize(dataLen);
+    largeFrames_++;
+
+    // 先取出接收环中已有的部分，剩余部分直接读入帧缓冲区
+    size_t buffered = writePos_ - readPos_ - FRAME_HEADER_SIZE;
+    memcpy(frameBuffer_.data(), recvBuffer_.data() + readPos_ + FRAME_HEADER_SIZE, buffered);
+    readPos_ = 0;
+    writePos_ = 0;
+
+    size_t totalReceived = buffered;
+    while (totalReceived < dataLen) {
+        int ret = RecvCounted(frameBuffer_.data() + totalReceived, dataLen - totalReceived);
         if (ret <= 0) {
             DHLOGE("[SOCKET_RECEIVER] recv data failed");
             return -1;
         }
-        totalReceived += ret;
+        totalReceived += static_cast<size_t>(ret);
     }
 
-    DHLOGI("[SOCKET_RECEIVER] Received %{public}u bytes", dataLen);
+    DeliverFrame(frameBuffer_.data(), dataLen);
+    return 0;
+}
+
+void SocketReceiver::CompactRecvBuffer() {
+    if (readPos_ == writePos_) {
+        readPos_ = 0;
+        writePos_ = 0;
+        return;
+    }
+
+    // 未解析的帧在尾部放不下，或尾部空间太小时，把剩余数据移到开头
+    bool needCompact = recvBuffer_.size() - writePos_ < RECV_MIN_FREE;
+    if (writePos_ - readPos_ >= FRAME_HEADER_SIZE) {
+        uint32_t dataLen = 0;
+        memcpy(&dataLen, recvBuffer_.data() + readPos_, sizeof(dataLen));
+        needCompact = needCompact || (readPos_ + FRAME_HEADER_SIZE + dataLen > recvBuffer_.size());
+    }
+    if (needCompact && readPos_ > 0) {
+        memmove(recvBuffer_.data(), recvBuffer_.data() + readPos_, writePos_ - readPos_);
+        writePos_ -= readPos_;
+        readPos_ = 0;
+    }
+}
+
+void SocketReceiver::DeliverFrame(const uint8_t* data, uint32_t dataLen) {
+    uint64_t frames = ++framesReceived_;
+    bytesReceived_ += dataLen;
+    if (frames % STATS_LOG_INTERVAL == 0) {
+        DHLOGI("[SOCKET_RECEIVER] Received %{public}llu frames, recvCalls: %{public}llu, allocations: %{public}llu",
+                static_cast<unsigned long long>(frames), static_cast<unsigned long long>(recvCalls_.load()),
+                static_cast<unsigned long long>(allocations_.load()));
+    }
 
     // 通知回调 (这里简化处理，直接传递编码数据)
     // 实际应该解码后传递YUV数据
+    // data 只在回调期间有效，回调返回后所在缓冲区会被复用
     if (callback_) {
         // 暂时直接传递编码数据（实际应用中需要解码）
-        callback_->OnDecodedFrameAvailable(data.data(), 1920, 1080);
+        callback_->OnDecodedFrameAvailable(data, 1920, 1080);
     }
+}
 
-    return 0;
+int SocketReceiver::RecvCounted(uint8_t* buffer, size_t size) {
+    recvCalls_++;
+    return recv(connSockfd_, reinterpret_cast<char*>(buffer), static_cast<int>(size), 0);
+}
+
+SocketReceiverStats SocketReceiver::GetStats() const {
+    SocketReceiverStats stats;
+    stats.framesReceived = framesReceived_.load();
+    stats.bytesReceived = bytesReceived_.load();
+    stats.recvCalls = recvCalls_.load();
+    stats.allocations = allocations_.load();
+    stats.largeFrames = largeFrames_.load();
+    return stats;
 }
@@ -17,14 +17,26 @@
 #define SOCKET_RECEIVER_H
 
 #include "distributed_camera_source.h"
+#include <atomic>
 #include <string>
 #include <vector>
 #include <thread>
 #include <mutex>
 
+// 接收统计，用于评估每帧的系统调用次数和内存分配次数
+struct SocketReceiverStats {
+    uint64_t framesReceived = 0;
+    uint64_t bytesReceived = 0;
+    uint64_t recvCalls = 0;         // 实际发生的接收系统调用次数
+    uint64_t allocations = 0;       // 接收缓冲区扩容次数
+    uint64_t largeFrames = 0;       // 超过接收环大小、走独立缓冲区的帧数
+};
+
 /**
  * Socket接收端
  * 用于Source端接收Sink端发送的编码数据
+ * 数据先读入可复用的接收环，一次读取可解析出多帧；帧完整落在接收环内时直接交给回调，不做拷贝，
+ * 超过接收环大小的帧在复用的帧缓冲区中拼接。
  */
 class SocketReceiver {
 public:
@@ -43,11 +55,18 @@ public:
     // 是否正在接收
     bool IsReceiving() const { return receiving_; }
 
+    SocketReceiverStats GetStats() const;
+
 private:
     void ReceiveThreadProc();
     int32_t StartServer();
     void StopServer();
     int32_t ReceiveData();
+    int32_t ParseFrames();
+    int32_t ReceiveLargeFrame(uint32_t dataLen);
+    void CompactRecvBuffer();
+    void DeliverFrame(const uint8_t* data, uint32_t dataLen);
+    int RecvCounted(uint8_t* buffer, size_t size);
 
     int listenSockfd_;
     int connSockfd_;
@@ -60,6 +79,19 @@ private:
 
     ISourceCallback* callback_;
 
+    // 接收环：[readPos_, writePos_) 为已收到但尚未解析的数据
+    std::vector<uint8_t> recvBuffer_;
+    size_t readPos_;
+    size_t writePos_;
+    // 大帧拼接缓冲区，容量只增不减
+    std::vector<uint8_t> frameBuffer_;
+
+    std::atomic<uint64_t> framesReceived_{0};
+    std::atomic<uint64_t> bytesReceived_{0};
+    std::atomic<uint64_t> recvCalls_{0};
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> largeFrames_{0};
+
     static const int DEFAULT_PORT = 8888;
 };
 